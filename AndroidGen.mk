@@ -32,6 +32,7 @@ LOCAL_SRC_FILES := \
 	external/vulkancts/framework/vulkan/vkBufferWithMemory.cpp \
 	external/vulkancts/framework/vulkan/vkBuilderUtil.cpp \
 	external/vulkancts/framework/vulkan/vkCmdUtil.cpp \
+	external/vulkancts/framework/vulkan/vkCompileServer.cpp \
 	external/vulkancts/framework/vulkan/vkDebugReportUtil.cpp \
 	external/vulkancts/framework/vulkan/vkDefs.cpp \
 	external/vulkancts/framework/vulkan/vkDeviceUtil.cpp \
@@ -40,9 +41,12 @@ LOCAL_SRC_FILES := \
 	external/vulkancts/framework/vulkan/vkMemUtil.cpp \
 	external/vulkancts/framework/vulkan/vkNullDriver.cpp \
 	external/vulkancts/framework/vulkan/vkObjUtil.cpp \
+	external/vulkancts/framework/vulkan/vkPipelineCacheUtil.cpp \
 	external/vulkancts/framework/vulkan/vkPlatform.cpp \
+	external/vulkancts/framework/vulkan/vkProgramBinaryCache.cpp \
 	external/vulkancts/framework/vulkan/vkPrograms.cpp \
 	external/vulkancts/framework/vulkan/vkQueryUtil.cpp \
+	external/vulkancts/framework/vulkan/vkReadbackQueue.cpp \
 	external/vulkancts/framework/vulkan/vkRef.cpp \
 	external/vulkancts/framework/vulkan/vkRefUtil.cpp \
 	external/vulkancts/framework/vulkan/vkShaderProgram.cpp \
@@ -352,6 +356,7 @@ LOCAL_SRC_FILES := \
 	external/vulkancts/modules/vulkan/ubo/vktUniformBlockTests.cpp \
 	external/vulkancts/modules/vulkan/util/vktDrawUtil.cpp \
 	external/vulkancts/modules/vulkan/util/vktExternalMemoryUtil.cpp \
+	external/vulkancts/modules/vulkan/vktDeviceCache.cpp \
 	external/vulkancts/modules/vulkan/vktInfoTests.cpp \
 	external/vulkancts/modules/vulkan/vktShaderLibrary.cpp \
 	external/vulkancts/modules/vulkan/vktTestCase.cpp \
@@ -379,6 +384,7 @@ LOCAL_SRC_FILES := \
 	framework/common/tcuAstcUtil.cpp \
 	framework/common/tcuBilinearImageCompare.cpp \
 	framework/common/tcuCPUWarmup.cpp \
+	framework/common/tcuCaseIndex.cpp \
 	framework/common/tcuCommandLine.cpp \
 	framework/common/tcuCompressedTexture.cpp \
 	framework/common/tcuDefs.cpp \
@@ -393,6 +399,7 @@ LOCAL_SRC_FILES := \
 	framework/common/tcuInterval.cpp \
 	framework/common/tcuMatrix.cpp \
 	framework/common/tcuMaybe.cpp \
+	framework/common/tcuMemPoolUtil.cpp \
 	framework/common/tcuPlatform.cpp \
 	framework/common/tcuRGBA.cpp \
 	framework/common/tcuRandomValueIterator.cpp \
@@ -400,6 +407,7 @@ LOCAL_SRC_FILES := \
 	framework/common/tcuRenderTarget.cpp \
 	framework/common/tcuResource.cpp \
 	framework/common/tcuResultCollector.cpp \
+	framework/common/tcuScopedTimer.cpp \
 	framework/common/tcuSeedBuilder.cpp \
 	framework/common/tcuStringTemplate.cpp \
 	framework/common/tcuSurface.cpp \
@@ -417,6 +425,7 @@ LOCAL_SRC_FILES := \
 	framework/common/tcuTexture.cpp \
 	framework/common/tcuTextureUtil.cpp \
 	framework/common/tcuThreadUtil.cpp \
+	framework/common/tcuWorkerPool.cpp \
 	framework/delibs/debase/deDefs.c \
 	framework/delibs/debase/deFloat16.c \
 	framework/delibs/debase/deFloat16Test.c \
@@ -522,6 +531,7 @@ LOCAL_SRC_FILES := \
 	framework/opengl/gluObjectWrapper.cpp \
 	framework/opengl/gluPixelTransfer.cpp \
 	framework/opengl/gluPlatform.cpp \
+	framework/opengl/gluProgramBinaryCache.cpp \
 	framework/opengl/gluProgramInterfaceQuery.cpp \
 	framework/opengl/gluRenderConfig.cpp \
 	framework/opengl/gluRenderContext.cpp \
@@ -51,6 +51,7 @@ enum MessageType
 	MESSAGETYPE_TEST					= 101,	//!< Debug only
 	MESSAGETYPE_EXECUTE_BINARY			= 111,	//!< Request execution of a test package binary.
 	MESSAGETYPE_STOP_EXECUTION			= 112,	//!< Request cancellation of the currently executing binary.
+	MESSAGETYPE_COMPILE_PROGRAM			= 113,	//!< Request program build from compile server (vk-compile-server).
 
 	// Responses (from ExecServer to Client)
 	MESSAGETYPE_PROCESS_STARTED			= 200,	//!< Requested process has started.
@@ -58,6 +59,7 @@ enum MessageType
 	MESSAGETYPE_PROCESS_FINISHED		= 202,	//!< Requested process has finished (for any reason).
 	MESSAGETYPE_PROCESS_LOG_DATA		= 203,	//!< Unprocessed log data from TestResults.qpa.
 	MESSAGETYPE_INFO					= 204,	//!< Generic info message from ExecServer (for debugging purposes).
+	MESSAGETYPE_COMPILE_RESULT			= 205,	//!< Built program or build failure from compile server.
 
 	MESSAGETYPE_KEEPALIVE				= 102	//!< Keep-alive packet
 };
@@ -30,12 +30,16 @@
 namespace xs
 {
 
-TcpServer::TcpServer (deSocketFamily family, int port)
+TcpServer::TcpServer (deSocketFamily family, int port, const char* host)
 	: m_socket()
 {
 	de::SocketAddress address;
 	address.setFamily(family);
 	address.setPort(port);
+
+	if (host)
+		address.setHost(host);
+
 	address.setType(DE_SOCKETTYPE_STREAM);
 	address.setProtocol(DE_SOCKETPROTOCOL_TCP);
 
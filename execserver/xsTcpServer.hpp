@@ -38,7 +38,7 @@ class ConnectionHandler;
 class TcpServer
 {
 public:
-									TcpServer				(deSocketFamily family, int port);
+									TcpServer				(deSocketFamily family, int port, const char* host = DE_NULL);
 	virtual							~TcpServer				(void);
 
 	virtual ConnectionHandler*		createHandler			(de::Socket* socket, const de::SocketAddress& clientAddress) = DE_NULL;
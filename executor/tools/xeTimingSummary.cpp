@@ -0,0 +1,295 @@
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Test Executor
+ * ------------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Aggregate scoped timings (<Timing> elements) across a log.
+ *//*--------------------------------------------------------------------*/
+
+#include "xeTestLogParser.hpp"
+#include "xeTestResultParser.hpp"
+#include "deString.h"
+
+#include <vector>
+#include <string>
+#include <map>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+using std::vector;
+using std::string;
+using std::map;
+
+struct CommandLine
+{
+	CommandLine (void)
+		: csv(false)
+	{
+	}
+
+	string			filename;
+	bool			csv;
+};
+
+struct TimingTotal
+{
+	TimingTotal (void)
+		: numCases		(0)
+		, count			(0)
+		, durationUs	(0)
+		, maxCaseUs		(0)
+	{
+	}
+
+	int				numCases;		//!< Number of cases that entered the scope
+	deInt64			count;			//!< Total number of entries to the scope
+	deInt64			durationUs;		//!< Total (inclusive) time spent in the scope
+	deInt64			maxCaseUs;		//!< Largest time spent in the scope by a single case
+	string			maxCasePath;
+};
+
+struct TimingSummary
+{
+	TimingSummary (void)
+		: numCases			(0)
+		, testDurationUs	(0)
+	{
+	}
+
+	int								numCases;
+	deInt64							testDurationUs;	//!< Sum of TestDuration values
+	map<string, TimingTotal>		timings;
+};
+
+static deInt64 getInt64 (const xe::ri::NumericValue& value)
+{
+	if (value.getType() == xe::ri::NumericValue::TYPE_INT64)
+		return value.getInt64();
+	else if (value.getType() == xe::ri::NumericValue::TYPE_FLOAT64)
+		return (deInt64)value.getFloat64();
+	else
+		return 0;
+}
+
+static void addCaseTimings (TimingSummary& summary, const string& casePath, const xe::ri::List& items)
+{
+	for (int ndx = 0; ndx < items.getNumItems(); ndx++)
+	{
+		const xe::ri::Item& item = items.getItem(ndx);
+
+		if (item.getType() == xe::ri::TYPE_SECTION)
+			addCaseTimings(summary, casePath, static_cast<const xe::ri::Section&>(item).items);
+		else if (item.getType() == xe::ri::TYPE_NUMBER)
+		{
+			const xe::ri::Number& number = static_cast<const xe::ri::Number&>(item);
+
+			if (number.name == "TestDuration")
+				summary.testDurationUs += getInt64(number.value);
+		}
+		else if (item.getType() == xe::ri::TYPE_TIMING)
+		{
+			const xe::ri::Timing&	timing		= static_cast<const xe::ri::Timing&>(item);
+			const deInt64			durationUs	= getInt64(timing.value);
+			TimingTotal&			total		= summary.timings[timing.name];
+
+			// Timings are written once per scope name at the end of each case.
+			total.numCases		+= 1;
+			total.count			+= timing.count;
+			total.durationUs	+= durationUs;
+
+			if (durationUs > total.maxCaseUs)
+			{
+				total.maxCaseUs		= durationUs;
+				total.maxCasePath	= casePath;
+			}
+		}
+	}
+}
+
+class TimingParser : public xe::TestLogHandler
+{
+public:
+	TimingParser (TimingSummary& summary)
+		: m_summary(summary)
+	{
+	}
+
+	void setSessionInfo (const xe::SessionInfo&)
+	{
+		// Ignored.
+	}
+
+	xe::TestCaseResultPtr startTestCaseResult (const char* casePath)
+	{
+		return xe::TestCaseResultPtr(new xe::TestCaseResultData(casePath));
+	}
+
+	void testCaseResultUpdated (const xe::TestCaseResultPtr&)
+	{
+		// Ignored.
+	}
+
+	void testCaseResultComplete (const xe::TestCaseResultPtr& caseData)
+	{
+		m_summary.numCases += 1;
+
+		if (caseData->getDataSize() > 0)
+		{
+			xe::TestCaseResult					fullResult;
+			xe::TestResultParser::ParseResult	parseResult;
+
+			m_testResultParser.init(&fullResult);
+			parseResult = m_testResultParser.parse(caseData->getData(), caseData->getDataSize());
+
+			// \note <Timing> items are written only when a case finishes, so truncated logs of crashed cases have none.
+			if (parseResult != xe::TestResultParser::PARSERESULT_ERROR)
+				addCaseTimings(m_summary, caseData->getTestCasePath(), fullResult.resultItems);
+		}
+	}
+
+private:
+	TimingSummary&			m_summary;
+	xe::TestResultParser	m_testResultParser;
+};
+
+static void readLogFile (TimingSummary& summary, const char* filename)
+{
+	std::ifstream		in				(filename, std::ifstream::binary|std::ifstream::in);
+	TimingParser		resultHandler	(summary);
+	xe::TestLogParser	parser			(&resultHandler);
+	deUint8				buf				[1024];
+	int					numRead			= 0;
+
+	if (!in.good())
+		throw std::runtime_error(string("Failed to open '") + filename + "'");
+
+	for (;;)
+	{
+		in.read((char*)&buf[0], DE_LENGTH_OF_ARRAY(buf));
+		numRead = (int)in.gcount();
+
+		if (numRead <= 0)
+			break;
+
+		parser.parse(&buf[0], numRead);
+	}
+
+	in.close();
+}
+
+typedef std::pair<string, TimingTotal> NamedTotal;
+
+static bool compareTotalDuration (const NamedTotal& a, const NamedTotal& b)
+{
+	return a.second.durationUs > b.second.durationUs;
+}
+
+static void printSummary (const CommandLine& cmdLine, std::ostream& dst)
+{
+	TimingSummary		summary;
+	vector<NamedTotal>	totals;
+
+	readLogFile(summary, cmdLine.filename.c_str());
+
+	totals.assign(summary.timings.begin(), summary.timings.end());
+	std::sort(totals.begin(), totals.end(), compareTotalDuration);
+
+	if (cmdLine.csv)
+	{
+		dst << "Name,Cases,Count,TotalUs,MaxCaseUs,MaxCasePath\n";
+
+		for (vector<NamedTotal>::const_iterator iter = totals.begin(); iter != totals.end(); ++iter)
+		{
+			const TimingTotal& total = iter->second;
+			dst << iter->first << "," << total.numCases << "," << total.count << "," << total.durationUs << "," << total.maxCaseUs << "," << total.maxCasePath << "\n";
+		}
+	}
+	else
+	{
+		char line[512];
+
+		dst << summary.numCases << " test cases, total test duration " << (summary.testDurationUs / 1000) << " ms\n\n";
+
+		deSprintf(line, sizeof(line), "%-48s %8s %10s %12s %7s %12s\n", "Name", "Cases", "Count", "Total (ms)", "Share", "Max case (ms)");
+		dst << line;
+
+		for (vector<NamedTotal>::const_iterator iter = totals.begin(); iter != totals.end(); ++iter)
+		{
+			const TimingTotal&	total	= iter->second;
+			const double		share	= summary.testDurationUs > 0 ? 100.0 * (double)total.durationUs / (double)summary.testDurationUs : 0.0;
+
+			deSprintf(line, sizeof(line), "%-48s %8d %10lld %12.1f %6.1f%% %12.1f\n",
+					  iter->first.c_str(), total.numCases, (long long)total.count, (double)total.durationUs / 1000.0, share, (double)total.maxCaseUs / 1000.0);
+			dst << line;
+		}
+
+		dst << "\nTimes are inclusive: nested scopes are also counted in enclosing scopes.\n";
+	}
+}
+
+static void printHelp (const char* binName)
+{
+	printf("%s: [filename]\n", binName);
+	printf(" --csv     Print summary as CSV.\n");
+}
+
+static bool parseCommandLine (CommandLine& cmdLine, int argc, const char* const* argv)
+{
+	for (int argNdx = 1; argNdx < argc; argNdx++)
+	{
+		const char* arg = argv[argNdx];
+
+		if (deStringEqual(arg, "--csv"))
+			cmdLine.csv = true;
+		else if (!deStringBeginsWith(arg, "--") && cmdLine.filename.empty())
+			cmdLine.filename = arg;
+		else
+			return false;
+	}
+
+	if (cmdLine.filename.empty())
+		return false;
+
+	return true;
+}
+
+int main (int argc, const char* const* argv)
+{
+	try
+	{
+		CommandLine cmdLine;
+
+		if (!parseCommandLine(cmdLine, argc, argv))
+		{
+			printHelp(argv[0]);
+			return -1;
+		}
+
+		printSummary(cmdLine, std::cout);
+	}
+	catch (const std::exception& e)
+	{
+		printf("FATAL ERROR: %s\n", e.what());
+		return -1;
+	}
+
+	return 0;
+}
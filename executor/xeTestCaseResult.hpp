@@ -79,6 +79,7 @@ class SampleInfo;
 class ValueInfo;
 class Sample;
 class SampleValue;
+class Timing;
 
 // \todo [2014-02-28 pyry] Make List<T> for items that have only specific subitems.
 
@@ -154,6 +155,7 @@ enum Type
 	TYPE_VALUEINFO,
 	TYPE_SAMPLE,
 	TYPE_SAMPLEVALUE,
+	TYPE_TIMING,
 
 	TYPE_LAST
 };
@@ -239,6 +241,18 @@ public:
 	NumericValue		value;
 };
 
+class Timing : public Item
+{
+public:
+						Timing			(void) : Item(TYPE_TIMING), count(0) {}
+						~Timing			(void) {}
+
+	std::string			name;
+	int					count;
+	std::string			unit;
+	NumericValue		value;
+};
+
 class Image : public Item
 {
 public:
@@ -260,6 +260,18 @@ static void writeResultItem (const ri::Item& item, xml::Writer& dst)
 			break;
 		}
 
+		case ri::TYPE_TIMING:
+		{
+			const ri::Timing& timing = static_cast<const ri::Timing&>(item);
+			dst << Writer::BeginElement("Timing")
+				<< Writer::Attribute("Name",	timing.name)
+				<< Writer::Attribute("Count",	de::toString(timing.count))
+				<< Writer::Attribute("Unit",	timing.unit)
+				<< timing.value
+				<< Writer::EndElement;
+			break;
+		}
+
 		case ri::TYPE_IMAGE:
 		{
 			const ri::Image& image = static_cast<const ri::Image&>(item);
@@ -127,6 +127,7 @@ static const EnumMapEntry s_resultItemMap[] =
 	{ 0x2aa6f14e,	"ValueInfo",			ri::TYPE_VALUEINFO		},
 	{ 0xd09429e7,	"Sample",				ri::TYPE_SAMPLE			},
 	{ 0x0e4a4722,	"Value",				ri::TYPE_SAMPLEVALUE	},
+	{ 0xd379f90d,	"Timing",				ri::TYPE_TIMING			},
 };
 
 static const EnumMapEntry s_imageFormatMap[] =
@@ -514,6 +515,18 @@ void TestResultParser::handleElementStart (void)
 				break;
 			}
 
+			case ri::TYPE_TIMING:
+			{
+				ri::Timing* timing = curList->allocItem<ri::Timing>();
+				timing->name	= getAttribute("Name");
+				timing->count	= toInt(getAttribute("Count"));
+				timing->unit	= getAttribute("Unit");
+				item = timing;
+
+				m_curNumValue.clear();
+				break;
+			}
+
 			case ri::TYPE_IMAGESET:
 			{
 				ri::ImageSet* imageSet = curList->allocItem<ri::ImageSet>();
@@ -756,6 +769,12 @@ void TestResultParser::handleElementEnd (void)
 			number->value = getNumericValue(m_curNumValue);
 			m_curNumValue.clear();
 		}
+		else if (itemType == ri::TYPE_TIMING)
+		{
+			ri::Timing*	timing	= static_cast<ri::Timing*>(curItem);
+			timing->value = getNumericValue(m_curNumValue);
+			m_curNumValue.clear();
+		}
 		else if (itemType == ri::TYPE_SAMPLEVALUE)
 		{
 			ri::SampleValue* value = static_cast<ri::SampleValue*>(curItem);
@@ -799,6 +818,7 @@ void TestResultParser::handleData (void)
 			break;
 
 		case ri::TYPE_NUMBER:
+		case ri::TYPE_TIMING:
 		case ri::TYPE_SAMPLEVALUE:
 			m_xmlParser.appendDataStr(m_curNumValue);
 			break;
@@ -23,6 +23,7 @@
 
 #include "xeXMLParser.hpp"
 #include "deInt32.h"
+#include "deString.h"
 
 namespace xe
 {
@@ -357,14 +358,33 @@ void Parser::clear (void)
 {
 	m_tokenizer.clear();
 	m_elementName.clear();
-	m_attributes.clear();
+	clearAttributes();
 	m_attribName.clear();
+	m_attribValue.clear();
 	m_entityValue.clear();
 
 	m_element	= ELEMENT_INCOMPLETE;
 	m_state		= STATE_DATA;
 }
 
+const Parser::Attribute* Parser::findAttribute (const char* name) const
+{
+	for (std::vector<Attribute>::const_iterator attrib = m_attributes.begin(); attrib != m_attributes.end(); ++attrib)
+	{
+		if (deStringEqual(attrib->name, name))
+			return &*attrib;
+	}
+
+	return DE_NULL;
+}
+
+void Parser::clearAttributes (void)
+{
+	// \note Pool pages are kept and reused by the next element.
+	m_attributes.clear();
+	m_attributePool.reset();
+}
+
 void Parser::error (const std::string& what)
 {
 	throw ParseError(what);
@@ -381,7 +401,7 @@ void Parser::feed (const deUint8* bytes, int numBytes)
 void Parser::advance (void)
 {
 	if (m_element == ELEMENT_START)
-		m_attributes.clear();
+		clearAttributes();
 
 	// \note No token is advanced when element end is reported.
 	if (m_state == STATE_YIELD_EMPTY_ELEMENT_END)
@@ -518,7 +538,15 @@ void Parser::advance (void)
 				if (hasAttribute(m_attribName.c_str()))
 					error("Duplicate attribute");
 
-				m_tokenizer.getString(m_attributes[m_attribName]);
+				m_tokenizer.getString(m_attribValue);
+
+				{
+					Attribute attrib;
+					attrib.name		= de::copyToPool(&m_attributePool, m_attribName.c_str());
+					attrib.value	= de::copyToPool(&m_attributePool, m_attribValue.c_str());
+					m_attributes.push_back(attrib);
+				}
+
 				m_state = STATE_ATTRIBUTE_LIST;
 				break;
 
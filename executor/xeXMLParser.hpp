@@ -31,9 +31,10 @@
 
 #include "xeDefs.hpp"
 #include "deRingBuffer.hpp"
+#include "deMemPool.hpp"
 
 #include <string>
-#include <map>
+#include <vector>
 
 namespace xe
 {
@@ -136,8 +137,11 @@ private:
 class Parser
 {
 public:
-	typedef std::map<std::string, std::string>		AttributeMap;
-	typedef AttributeMap::const_iterator			AttributeIter;
+	struct Attribute
+	{
+		const char*		name;
+		const char*		value;
+	};
 
 						Parser				(void);
 						~Parser				(void);
@@ -153,9 +157,11 @@ public:
 	const char*			getElementName		(void) const						{ return m_elementName.c_str();							}
 
 	// For ELEMENT_START.
-	bool				hasAttribute		(const char* name) const			{ return m_attributes.find(name) != m_attributes.end();	}
-	const char*			getAttribute		(const char* name) const			{ return m_attributes.find(name)->second.c_str();		}
-	const AttributeMap&	attributes			(void) const						{ return m_attributes;									}
+	bool				hasAttribute		(const char* name) const			{ return findAttribute(name) != DE_NULL;				}
+	const char*			getAttribute		(const char* name) const;
+
+	//! Allocation statistics of the attribute pool.
+	deMemPoolStats		getAttributeStats	(void) const						{ return m_attributePool.getStats(false);				}
 
 	// For ELEMENT_DATA.
 	int					getDataSize			(void) const;
@@ -168,6 +174,8 @@ private:
 	Parser&				operator=			(const Parser& other);
 
 	void				parseEntityValue	(void);
+	const Attribute*	findAttribute		(const char* name) const;
+	void				clearAttributes		(void);
 
 	void				error				(const std::string& what);
 
@@ -191,10 +199,15 @@ private:
 
 	Element				m_element;
 	std::string			m_elementName;
-	AttributeMap		m_attributes;
+
+	// Attribute strings of the current element are stored in a pool that is reset for each
+	// element, so parsing a whole log reuses the same few pages instead of allocating per attribute.
+	de::MemPool			m_attributePool;
+	std::vector<Attribute>	m_attributes;
 
 	State				m_state;
 	std::string			m_attribName;
+	std::string			m_attribValue;		//!< Scratch buffer for attribute value.
 	std::string			m_entityValue;		//!< Data override, such as entity value.
 };
 
@@ -235,6 +248,13 @@ inline deUint8 Parser::getDataByte (int offset) const
 		return (deUint8)m_entityValue[offset];
 }
 
+inline const char* Parser::getAttribute (const char* name) const
+{
+	const Attribute* const attrib = findAttribute(name);
+	DE_ASSERT(attrib);
+	return attrib->value;
+}
+
 inline void Parser::getDataStr (std::string& dst) const
 {
 	if (m_state != STATE_ENTITY)
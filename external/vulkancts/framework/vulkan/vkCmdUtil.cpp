@@ -25,6 +25,11 @@
 #include "vkDefs.hpp"
 #include "vkRefUtil.hpp"
 #include "vkTypeUtil.hpp"
+#include "tcuScopedTimer.hpp"
+#include "deSTLUtil.hpp"
+#include "deUniquePtr.hpp"
+
+#include <map>
 
 namespace vk
 {
@@ -170,7 +175,10 @@ void submitCommandsAndWait (const DeviceInterface&	vk,
 							const bool				useDeviceGroups,
 							const deUint32			deviceMask)
 {
-	const Unique<VkFence>	fence					(createFence(vk, device));
+	const tcu::ScopedTimer	timer					("vk::submitCommandsAndWait");
+	SubmissionPool* const	pool					= SubmissionPool::findPool(device);
+	const Unique<VkFence>	ownFence				(pool ? Move<VkFence>() : createFence(vk, device));
+	const VkFence			fence					= pool ? pool->acquireFence() : *ownFence;
 
 	VkDeviceGroupSubmitInfo	deviceGroupSubmitInfo	=
 	{
@@ -197,8 +205,331 @@ void submitCommandsAndWait (const DeviceInterface&	vk,
 		DE_NULL,											// const VkSemaphore*			pSignalSemaphores;
 	};
 
-	VK_CHECK(vk.queueSubmit(queue, 1u, &submitInfo, *fence));
-	VK_CHECK(vk.waitForFences(device, 1u, &fence.get(), DE_TRUE, ~0ull));
+	try
+	{
+		VK_CHECK(pool ? pool->queueSubmit(queue, 1u, &submitInfo, fence) : vk.queueSubmit(queue, 1u, &submitInfo, fence));
+		VK_CHECK(vk.waitForFences(device, 1u, &fence, DE_TRUE, ~0ull));
+	}
+	catch (...)
+	{
+		if (pool)
+			pool->discardFence(fence);
+		throw;
+	}
+
+	if (pool)
+		pool->releaseFence(fence);
+}
+
+// SubmissionPool
+
+namespace
+{
+
+typedef std::map<VkDevice, SubmissionPool*> SubmissionPoolMap;
+
+de::Mutex			s_submissionPoolsLock;
+SubmissionPoolMap	s_submissionPools;
+
+} // anonymous
+
+SubmissionPool::SubmissionPool (const DeviceInterface& vk, VkDevice device, VkQueue queue, deUint32 queueFamilyIndex)
+	: m_vk					(vk)
+	, m_device				(device)
+	, m_queue				(queue)
+	, m_queueFamilyIndex	(queueFamilyIndex)
+{
+	const de::ScopedLock lock (s_submissionPoolsLock);
+
+	// Only the first pool of a device is used by submitCommandsAndWait().
+	if (!de::contains(s_submissionPools, device))
+		s_submissionPools[device] = this;
+}
+
+SubmissionPool::~SubmissionPool (void)
+{
+	{
+		const de::ScopedLock lock (s_submissionPoolsLock);
+
+		if (de::lookupDefault(s_submissionPools, m_device, (SubmissionPool*)DE_NULL) == this)
+			s_submissionPools.erase(m_device);
+	}
+
+	for (size_t ndx = 0; ndx < m_freeFences.size(); ndx++)
+		m_vk.destroyFence(m_device, m_freeFences[ndx], DE_NULL);
+
+	// Command buffers are freed with their pools.
+	for (size_t ndx = 0; ndx < m_freeCmdPools.size(); ndx++)
+		destroyCommandPool(m_freeCmdPools[ndx]);
+}
+
+SubmissionPool* SubmissionPool::findPool (VkDevice device)
+{
+	const de::ScopedLock lock (s_submissionPoolsLock);
+
+	return de::lookupDefault(s_submissionPools, device, (SubmissionPool*)DE_NULL);
+}
+
+VkFence SubmissionPool::acquireFence (void)
+{
+	{
+		const de::ScopedLock lock (m_lock);
+
+		if (!m_freeFences.empty())
+		{
+			const VkFence fence = m_freeFences.back();
+
+			m_freeFences.pop_back();
+			return fence;
+		}
+	}
+
+	{
+		Move<VkFence>			fence	= createFence(m_vk, m_device);
+		const de::ScopedLock	lock	(m_lock);
+
+		m_stats.numFences += 1;
+
+		return fence.disown();
+	}
+}
+
+void SubmissionPool::releaseFence (VkFence fence)
+{
+	VK_CHECK(m_vk.resetFences(m_device, 1u, &fence));
+
+	{
+		const de::ScopedLock lock (m_lock);
+		m_freeFences.push_back(fence);
+	}
+}
+
+void SubmissionPool::discardFence (VkFence fence)
+{
+	m_vk.destroyFence(m_device, fence, DE_NULL);
+}
+
+VkResult SubmissionPool::queueSubmit (VkQueue queue, deUint32 submitCount, const VkSubmitInfo* pSubmits, VkFence fence)
+{
+	const de::ScopedLock lock (m_queueLock);
+
+	return m_vk.queueSubmit(queue, submitCount, pSubmits, fence);
+}
+
+SubmissionPool::Statistics SubmissionPool::getStatistics (void) const
+{
+	const de::ScopedLock lock (m_lock);
+
+	return m_stats;
+}
+
+SubmissionPool::CommandPool* SubmissionPool::acquireCommandPool (void)
+{
+	{
+		const de::ScopedLock lock (m_lock);
+
+		if (!m_freeCmdPools.empty())
+		{
+			CommandPool* const cmdPool = m_freeCmdPools.back();
+
+			m_freeCmdPools.pop_back();
+			return cmdPool;
+		}
+	}
+
+	{
+		de::MovePtr<CommandPool>	cmdPool	(new CommandPool());
+
+		cmdPool->pool = createCommandPool(m_vk, m_device, VK_COMMAND_POOL_CREATE_TRANSIENT_BIT, m_queueFamilyIndex).disown();
+
+		{
+			const de::ScopedLock lock (m_lock);
+			m_stats.numCommandPools += 1;
+		}
+
+		return cmdPool.release();
+	}
+}
+
+void SubmissionPool::releaseCommandPool (CommandPool* cmdPool)
+{
+	// Resetting the pool also resets command buffers left in recording state.
+	if (m_vk.resetCommandPool(m_device, cmdPool->pool, 0u) == VK_SUCCESS)
+	{
+		const de::ScopedLock lock (m_lock);
+		m_freeCmdPools.push_back(cmdPool);
+	}
+	else
+		destroyCommandPool(cmdPool);
+}
+
+void SubmissionPool::allocateCommandBuffer (const DeviceInterface& vk, VkDevice device, CommandPool& cmdPool)
+{
+	Move<VkCommandBuffer> cmdBuffer = vk::allocateCommandBuffer(vk, device, cmdPool.pool, VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+
+	cmdPool.cmdBuffers.push_back(*cmdBuffer);
+	cmdBuffer.disown();
+}
+
+void SubmissionPool::countCommandBuffer (void)
+{
+	const de::ScopedLock lock (m_lock);
+	m_stats.numCommandBuffers += 1;
+}
+
+void SubmissionPool::destroyCommandPool (CommandPool* cmdPool)
+{
+	m_vk.destroyCommandPool(m_device, cmdPool->pool, DE_NULL);
+	delete cmdPool;
+}
+
+// SubmissionBatch
+
+SubmissionBatch::SubmissionBatch (const DeviceInterface& vk, VkDevice device, VkQueue queue, deUint32 queueFamilyIndex)
+	: m_vk					(vk)
+	, m_device				(device)
+	, m_queue				(queue)
+	, m_queueFamilyIndex	(queueFamilyIndex)
+	, m_pool				(SubmissionPool::findPool(device))
+	, m_cmdPool				(DE_NULL)
+{
+	if (m_pool && m_pool->getQueue() != queue)
+		m_pool = DE_NULL;
+}
+
+SubmissionBatch::~SubmissionBatch (void)
+{
+	// Command buffers that were not submitted, for example because recording threw, are discarded.
+	reset();
+
+	if (m_ownCmdPool.pool != DE_NULL)
+		m_vk.destroyCommandPool(m_device, m_ownCmdPool.pool, DE_NULL);
+}
+
+VkCommandBuffer SubmissionBatch::record (void)
+{
+	if (!m_cmdBuffers.empty())
+		endCommandBuffer(m_vk, m_cmdBuffers.back());
+
+	if (!m_cmdPool)
+	{
+		if (m_pool)
+			m_cmdPool = m_pool->acquireCommandPool();
+		else
+		{
+			if (m_ownCmdPool.pool == DE_NULL)
+				m_ownCmdPool.pool = createCommandPool(m_vk, m_device, VK_COMMAND_POOL_CREATE_TRANSIENT_BIT, m_queueFamilyIndex).disown();
+
+			m_cmdPool = &m_ownCmdPool;
+		}
+	}
+
+	// Command buffers of the pool are reused in order; more are allocated when a batch grows beyond earlier ones.
+	if (m_cmdBuffers.size() == m_cmdPool->cmdBuffers.size())
+	{
+		SubmissionPool::allocateCommandBuffer(m_vk, m_device, *m_cmdPool);
+
+		if (m_pool)
+			m_pool->countCommandBuffer();
+	}
+
+	{
+		const VkCommandBuffer cmdBuffer = m_cmdPool->cmdBuffers[m_cmdBuffers.size()];
+
+		m_cmdBuffers.push_back(cmdBuffer);
+		beginCommandBuffer(m_vk, cmdBuffer);
+
+		return cmdBuffer;
+	}
+}
+
+void SubmissionBatch::submitAndWait (void)
+{
+	const tcu::ScopedTimer	timer	("vk::SubmissionBatch::submitAndWait");
+
+	if (m_cmdBuffers.empty())
+		return;
+
+	try
+	{
+		endCommandBuffer(m_vk, m_cmdBuffers.back());
+	}
+	catch (...)
+	{
+		reset();
+		throw;
+	}
+
+	{
+		const VkSubmitInfo		submitInfo	=
+		{
+			VK_STRUCTURE_TYPE_SUBMIT_INFO,			// VkStructureType				sType;
+			DE_NULL,								// const void*					pNext;
+			0u,										// deUint32						waitSemaphoreCount;
+			DE_NULL,								// const VkSemaphore*			pWaitSemaphores;
+			(const VkPipelineStageFlags*)DE_NULL,	// const VkPipelineStageFlags*	pWaitDstStageMask;
+			(deUint32)m_cmdBuffers.size(),			// deUint32						commandBufferCount;
+			&m_cmdBuffers[0],						// const VkCommandBuffer*		pCommandBuffers;
+			0u,										// deUint32						signalSemaphoreCount;
+			DE_NULL,								// const VkSemaphore*			pSignalSemaphores;
+		};
+		const Unique<VkFence>	ownFence	(m_pool ? Move<VkFence>() : createFence(m_vk, m_device));
+		const VkFence			fence		= m_pool ? m_pool->acquireFence() : *ownFence;
+
+		try
+		{
+			VK_CHECK(m_pool ? m_pool->queueSubmit(m_queue, 1u, &submitInfo, fence) : m_vk.queueSubmit(m_queue, 1u, &submitInfo, fence));
+			VK_CHECK(m_vk.waitForFences(m_device, 1u, &fence, DE_TRUE, ~0ull));
+		}
+		catch (...)
+		{
+			// Command buffers are reset, so wait until they are no longer executing.
+			m_vk.deviceWaitIdle(m_device);
+
+			if (m_pool)
+				m_pool->discardFence(fence);
+
+			reset();
+			throw;
+		}
+
+		if (m_pool)
+			m_pool->releaseFence(fence);
+	}
+
+	reset();
+}
+
+void SubmissionBatch::reset (void)
+{
+	m_cmdBuffers.clear();
+
+	if (!m_cmdPool)
+		return;
+
+	if (m_pool)
+		m_pool->releaseCommandPool(m_cmdPool);
+	else
+		m_vk.resetCommandPool(m_device, m_cmdPool->pool, 0u);
+
+	m_cmdPool = DE_NULL;
+}
+
+// PooledCommandBuffer
+
+PooledCommandBuffer::PooledCommandBuffer (const DeviceInterface& vk, VkDevice device, VkQueue queue, deUint32 queueFamilyIndex)
+	: m_batch		(vk, device, queue, queueFamilyIndex)
+	, m_cmdBuffer	(m_batch.record())
+{
+}
+
+PooledCommandBuffer::~PooledCommandBuffer (void)
+{
+}
+
+void PooledCommandBuffer::submitAndWait (void)
+{
+	m_batch.submitAndWait();
 }
 
 } // vk
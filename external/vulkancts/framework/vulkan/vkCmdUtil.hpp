@@ -24,7 +24,11 @@
  *//*--------------------------------------------------------------------*/
 
 #include "vkDefs.hpp"
+#include "vkRef.hpp"
 #include "tcuVector.hpp"
+#include "deMutex.hpp"
+
+#include <vector>
 
 namespace vk
 {
@@ -96,6 +100,163 @@ void submitCommandsAndWait	(const DeviceInterface&	vk,
 							 const bool				useDeviceGroups = false,
 							 const deUint32			deviceMask = 1u);
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Recycled fences and command buffers for one device and queue
+ *
+ * While a pool exists for a device, submitCommandsAndWait() on that
+ * device uses recycled fences from the pool instead of creating a fence
+ * per call, and SubmissionBatch and PooledCommandBuffer record into
+ * recycled command buffers from the pool.
+ *
+ * Each batch takes a command pool of its own while it is recording, so
+ * threads can record concurrently. Only taking and returning command
+ * pools and queue submissions are serialized.
+ *//*--------------------------------------------------------------------*/
+class SubmissionPool
+{
+public:
+	struct Statistics
+	{
+		int								numFences;			//!< Fences created
+		int								numCommandPools;	//!< Command pools created
+		int								numCommandBuffers;	//!< Command buffers allocated
+
+		Statistics (void) : numFences(0), numCommandPools(0), numCommandBuffers(0) {}
+	};
+
+										SubmissionPool			(const DeviceInterface& vk, VkDevice device, VkQueue queue, deUint32 queueFamilyIndex);
+										~SubmissionPool			(void);
+
+	VkDevice							getDevice				(void) const { return m_device;	}
+	VkQueue								getQueue				(void) const { return m_queue;	}
+
+	//! Get unsignaled fence.
+	VkFence								acquireFence			(void);
+
+	//! Return signaled fence to pool. Fence must not be in use by any pending submission.
+	void								releaseFence			(VkFence fence);
+
+	//! Destroy fence whose state is unknown, for example after failed wait.
+	void								discardFence			(VkFence fence);
+
+	//! Submit to queue. Submissions through the pool are serialized, as queue access must be externally synchronized.
+	VkResult							queueSubmit				(VkQueue queue, deUint32 submitCount, const VkSubmitInfo* pSubmits, VkFence fence);
+
+	Statistics							getStatistics			(void) const;
+
+	//! Get pool created for device, or DE_NULL if there is none.
+	static SubmissionPool*				findPool				(VkDevice device);
+
+private:
+	friend class SubmissionBatch;
+
+	struct CommandPool
+	{
+		CommandPool (void) : pool(DE_NULL) {}
+
+		VkCommandPool					pool;
+		std::vector<VkCommandBuffer>	cmdBuffers;		//!< Allocated from pool, reused in order after pool reset
+	};
+
+										SubmissionPool			(const SubmissionPool&);
+	SubmissionPool&						operator=				(const SubmissionPool&);
+
+	//! Get command pool for exclusive use by one batch. All of its command buffers are in initial state.
+	CommandPool*						acquireCommandPool		(void);
+
+	//! Reset command pool and return it. None of its command buffers may be pending.
+	void								releaseCommandPool		(CommandPool* cmdPool);
+
+	//! Allocate new primary command buffer into command pool.
+	static void							allocateCommandBuffer	(const DeviceInterface& vk, VkDevice device, CommandPool& cmdPool);
+
+	void								countCommandBuffer		(void);
+
+	void								destroyCommandPool		(CommandPool* cmdPool);
+
+	const DeviceInterface&				m_vk;
+	const VkDevice						m_device;
+	const VkQueue						m_queue;
+	const deUint32						m_queueFamilyIndex;
+
+	mutable de::Mutex					m_lock;				//!< Protects free lists and statistics
+	std::vector<VkFence>				m_freeFences;
+	std::vector<CommandPool*>			m_freeCmdPools;
+	Statistics							m_stats;
+
+	de::Mutex							m_queueLock;
+};
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Primary command buffers submitted and waited for together
+ *
+ * record() begins a new command buffer, ending the previous one.
+ * submitAndWait() submits all command buffers recorded since the last
+ * submission with a single vkQueueSubmit() and fence, and waits for them
+ * once. The batch can then be recorded again.
+ *
+ * If the device has a SubmissionPool for the queue, command buffers and
+ * the fence are recycled through it; otherwise a transient command pool
+ * is created. Batch must only be used by one thread at a time.
+ *//*--------------------------------------------------------------------*/
+class SubmissionBatch
+{
+public:
+									SubmissionBatch			(const DeviceInterface& vk, VkDevice device, VkQueue queue, deUint32 queueFamilyIndex);
+									~SubmissionBatch		(void);
+
+	//! Begin recording a new command buffer into the batch.
+	VkCommandBuffer					record					(void);
+
+	deUint32						getNumCommandBuffers	(void) const { return (deUint32)m_cmdBuffers.size();	}
+
+	//! End recording, submit all command buffers and wait for them to complete.
+	void							submitAndWait			(void);
+
+private:
+									SubmissionBatch			(const SubmissionBatch&);
+	SubmissionBatch&				operator=				(const SubmissionBatch&);
+
+	//! Reset recorded command buffers and return command pool to SubmissionPool, if any.
+	void							reset					(void);
+
+	const DeviceInterface&			m_vk;
+	const VkDevice					m_device;
+	const VkQueue					m_queue;
+	const deUint32					m_queueFamilyIndex;
+
+	SubmissionPool*					m_pool;			//!< DE_NULL if device has no pool for the queue
+	SubmissionPool::CommandPool*	m_cmdPool;		//!< Taken from m_pool while recording, or &m_ownCmdPool
+	SubmissionPool::CommandPool		m_ownCmdPool;
+	std::vector<VkCommandBuffer>	m_cmdBuffers;	//!< Recorded since last submission, last one is in recording state
+};
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Primary command buffer for a single submission
+ *
+ * Command buffer is in recording state after construction. Same as a
+ * SubmissionBatch with a single command buffer.
+ *//*--------------------------------------------------------------------*/
+class PooledCommandBuffer
+{
+public:
+									PooledCommandBuffer		(const DeviceInterface& vk, VkDevice device, VkQueue queue, deUint32 queueFamilyIndex);
+									~PooledCommandBuffer	(void);
+
+	VkCommandBuffer					get						(void) const { return m_cmdBuffer;	}
+	VkCommandBuffer					operator*				(void) const { return m_cmdBuffer;	}
+
+	//! End recording, submit and wait for the command buffer to complete.
+	void							submitAndWait			(void);
+
+private:
+									PooledCommandBuffer		(const PooledCommandBuffer&);
+	PooledCommandBuffer&			operator=				(const PooledCommandBuffer&);
+
+	SubmissionBatch					m_batch;
+	const VkCommandBuffer			m_cmdBuffer;
+};
+
 } // vk
 
 #endif // _VKCMDUTIL_HPP
@@ -0,0 +1,920 @@
+/*-------------------------------------------------------------------------
+ * Vulkan CTS Framework
+ * --------------------
+ *
+ * Copyright (c) 2018 Google Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Client and request processing for local shader compile server.
+ *//*--------------------------------------------------------------------*/
+
+#include "vkCompileServer.hpp"
+#include "xsDefs.hpp"
+#include "qpInfo.h"
+#include "deUniquePtr.hpp"
+#include "deClock.h"
+#include "deThread.h"
+
+#include <string>
+
+namespace vk
+{
+
+using std::string;
+using std::vector;
+
+namespace
+{
+
+enum
+{
+	PROTOCOL_VERSION	= 1
+};
+
+// Hung server must not block the test thread for longer than the watchdog interval (tcu::App).
+static const deUint64	REQUEST_TIMEOUT_US	= 20ull * 1000ull * 1000ull;
+
+enum RequestKind
+{
+	REQUEST_GLSL = 0,
+	REQUEST_HLSL,
+	REQUEST_SPIRV_ASM,
+
+	REQUEST_LAST
+};
+
+enum ResultStatus
+{
+	STATUS_OK = 0,
+	STATUS_BUILD_FAILED,		//!< Build failed; build info and error message are included
+	STATUS_NOT_AVAILABLE,		//!< Server can't build the program; client should build it in-process
+
+	STATUS_LAST
+};
+
+// Serialization. All integers are big-endian, strings and byte arrays are prefixed with size.
+
+class PayloadWriter
+{
+public:
+	PayloadWriter (vector<deUint8>& dst)
+		: m_dst(dst)
+	{
+	}
+
+	void putU32 (deUint32 value)
+	{
+		m_dst.push_back((deUint8)(value >> 24));
+		m_dst.push_back((deUint8)(value >> 16));
+		m_dst.push_back((deUint8)(value >> 8));
+		m_dst.push_back((deUint8)(value >> 0));
+	}
+
+	void putU64 (deUint64 value)
+	{
+		putU32((deUint32)(value >> 32));
+		putU32((deUint32)value);
+	}
+
+	void putBool (bool value)
+	{
+		putU32(value ? 1u : 0u);
+	}
+
+	void putBytes (const deUint8* data, size_t size)
+	{
+		putU32((deUint32)size);
+		m_dst.insert(m_dst.end(), data, data + size);
+	}
+
+	void putString (const string& str)
+	{
+		putBytes((const deUint8*)str.c_str(), str.size());
+	}
+
+private:
+	vector<deUint8>&	m_dst;
+};
+
+class PayloadReader
+{
+public:
+	PayloadReader (const vector<deUint8>& src)
+		: m_src	(src)
+		, m_pos	(0)
+	{
+	}
+
+	deUint32 getU32 (void)
+	{
+		XS_CHECK_MSG(m_pos + 4 <= m_src.size(), "Invalid payload size");
+
+		const deUint32 value = ((deUint32)m_src[m_pos+0] << 24)
+							 | ((deUint32)m_src[m_pos+1] << 16)
+							 | ((deUint32)m_src[m_pos+2] << 8)
+							 | ((deUint32)m_src[m_pos+3] << 0);
+		m_pos += 4;
+		return value;
+	}
+
+	deUint64 getU64 (void)
+	{
+		const deUint64 hi = getU32();
+		return (hi << 32) | (deUint64)getU32();
+	}
+
+	bool getBool (void)
+	{
+		return getU32() != 0;
+	}
+
+	void getBytes (vector<deUint8>& dst)
+	{
+		const size_t size = getU32();
+
+		XS_CHECK_MSG(m_pos + size <= m_src.size(), "Invalid payload size");
+		dst.assign(m_src.begin() + m_pos, m_src.begin() + m_pos + size);
+		m_pos += size;
+	}
+
+	string getString (void)
+	{
+		const size_t size = getU32();
+
+		XS_CHECK_MSG(m_pos + size <= m_src.size(), "Invalid payload size");
+		m_pos += size;
+		return string((const char*)&m_src[0] + m_pos - size, size);
+	}
+
+	void assumeEnd (void)
+	{
+		XS_CHECK_MSG(m_pos == m_src.size(), "Invalid payload size");
+	}
+
+	size_t getNumRemaining (void) const
+	{
+		return m_src.size() - m_pos;
+	}
+
+private:
+	const vector<deUint8>&	m_src;
+	size_t					m_pos;
+};
+
+// Server and client must agree on everything that affects built binaries.
+string getCompileEnvironment (void)
+{
+	string env;
+
+	env += qpGetReleaseName();
+	env += "\n";
+	env += qpGetReleaseGlslName();
+	env += "\n";
+	env += qpGetReleaseSpirvToolsName();
+	env += "\n";
+	env += qpGetReleaseSpirvHeadersName();
+	env += "\n";
+
+	// Debug builds validate binaries (see vkPrograms.cpp); release server must not serve debug clients.
+#if defined(DE_DEBUG)
+	env += "debug";
+#else
+	env += "release";
+#endif
+
+#if defined(DE_DEBUG) && defined(DEQP_HAVE_SPIRV_TOOLS)
+	env += " validated";
+#endif
+
+	return env;
+}
+
+void writeRequestHeader (PayloadWriter& writer, RequestKind kind, int optimizationRecipe)
+{
+	writer.putU32(PROTOCOL_VERSION);
+	writer.putString(getCompileEnvironment());
+	writer.putU32((deUint32)kind);
+	writer.putU32((deUint32)optimizationRecipe);
+}
+
+template<typename Source>
+void writeSource (PayloadWriter& writer, const Source& program)
+{
+	writer.putU32(program.buildOptions.vulkanVersion);
+	writer.putU32((deUint32)program.buildOptions.targetVersion);
+	writer.putU32(program.buildOptions.flags);
+
+	for (int shaderType = 0; shaderType < glu::SHADERTYPE_LAST; shaderType++)
+	{
+		writer.putU32((deUint32)program.sources[shaderType].size());
+
+		for (size_t srcNdx = 0; srcNdx < program.sources[shaderType].size(); srcNdx++)
+			writer.putString(program.sources[shaderType][srcNdx]);
+	}
+}
+
+template<typename Source>
+void readSource (PayloadReader& reader, Source& program)
+{
+	program.buildOptions.vulkanVersion	= reader.getU32();
+	program.buildOptions.targetVersion	= (SpirvVersion)reader.getU32();
+	program.buildOptions.flags			= reader.getU32();
+
+	XS_CHECK_MSG(program.buildOptions.targetVersion < SPIRV_VERSION_LAST, "Invalid SPIR-V version");
+
+	for (int shaderType = 0; shaderType < glu::SHADERTYPE_LAST; shaderType++)
+	{
+		const size_t numSources = reader.getU32();
+
+		for (size_t srcNdx = 0; srcNdx < numSources; srcNdx++)
+			program.sources[shaderType].push_back(reader.getString());
+	}
+}
+
+void writeSource (PayloadWriter& writer, const SpirVAsmSource& program)
+{
+	writer.putU32(program.buildOptions.vulkanVersion);
+	writer.putU32((deUint32)program.buildOptions.targetVersion);
+	writer.putString(program.source);
+}
+
+void readSource (PayloadReader& reader, SpirVAsmSource& program)
+{
+	program.buildOptions.vulkanVersion	= reader.getU32();
+	program.buildOptions.targetVersion	= (SpirvVersion)reader.getU32();
+	program.source						= reader.getString();
+
+	XS_CHECK_MSG(program.buildOptions.targetVersion < SPIRV_VERSION_LAST, "Invalid SPIR-V version");
+}
+
+void writeBuildInfo (PayloadWriter& writer, const glu::ShaderProgramInfo& buildInfo)
+{
+	writer.putString(buildInfo.program.infoLog);
+	writer.putBool(buildInfo.program.linkOk);
+	writer.putU64(buildInfo.program.linkTimeUs);
+	writer.putU32((deUint32)buildInfo.shaders.size());
+
+	for (size_t shaderNdx = 0; shaderNdx < buildInfo.shaders.size(); shaderNdx++)
+	{
+		const glu::ShaderInfo& shader = buildInfo.shaders[shaderNdx];
+
+		writer.putU32((deUint32)shader.type);
+		writer.putString(shader.source);
+		writer.putString(shader.infoLog);
+		writer.putBool(shader.compileOk);
+		writer.putU64(shader.compileTimeUs);
+	}
+}
+
+void readBuildInfo (PayloadReader& reader, glu::ShaderProgramInfo& buildInfo)
+{
+	buildInfo.program.infoLog		= reader.getString();
+	buildInfo.program.linkOk		= reader.getBool();
+	buildInfo.program.linkTimeUs	= reader.getU64();
+
+	{
+		const size_t	numShaders		= reader.getU32();
+		const size_t	minShaderSize	= 4*4 + 8;	// type, two empty strings, compileOk and compileTimeUs
+
+		XS_CHECK_MSG(numShaders <= reader.getNumRemaining() / minShaderSize, "Invalid shader count");
+		buildInfo.shaders.resize(numShaders);
+	}
+
+	for (size_t shaderNdx = 0; shaderNdx < buildInfo.shaders.size(); shaderNdx++)
+	{
+		glu::ShaderInfo& shader = buildInfo.shaders[shaderNdx];
+
+		shader.type				= (glu::ShaderType)reader.getU32();
+		shader.source			= reader.getString();
+		shader.infoLog			= reader.getString();
+		shader.compileOk		= reader.getBool();
+		shader.compileTimeUs	= reader.getU64();
+
+		XS_CHECK_MSG(shader.type < glu::SHADERTYPE_LAST, "Invalid shader type");
+	}
+}
+
+void writeBuildInfo (PayloadWriter& writer, const SpirVProgramInfo& buildInfo)
+{
+	writer.putString(buildInfo.source);
+	writer.putString(buildInfo.infoLog);
+	writer.putU64(buildInfo.compileTimeUs);
+	writer.putBool(buildInfo.compileOk);
+}
+
+void readBuildInfo (PayloadReader& reader, SpirVProgramInfo& buildInfo)
+{
+	buildInfo.source		= reader.getString();
+	buildInfo.infoLog		= reader.getString();
+	buildInfo.compileTimeUs	= reader.getU64();
+	buildInfo.compileOk		= reader.getBool();
+}
+
+void writeNotAvailable (vector<deUint8>& result, const string& message)
+{
+	PayloadWriter writer (result);
+
+	result.clear();
+	writer.putU32(STATUS_NOT_AVAILABLE);
+	writer.putString(message);
+}
+
+ProgramBinary* buildLocal (const GlslSource& program, glu::ShaderProgramInfo* buildInfo, int optimizationRecipe)
+{
+	return buildProgram(program, buildInfo, optimizationRecipe);
+}
+
+ProgramBinary* buildLocal (const HlslSource& program, glu::ShaderProgramInfo* buildInfo, int optimizationRecipe)
+{
+	return buildProgram(program, buildInfo, optimizationRecipe);
+}
+
+ProgramBinary* buildLocal (const SpirVAsmSource& program, SpirVProgramInfo* buildInfo, int optimizationRecipe)
+{
+	return assembleProgram(program, buildInfo, optimizationRecipe);
+}
+
+template<typename Source, typename BuildInfo>
+void processRequest (PayloadReader& reader, int optimizationRecipe, vector<deUint8>& result)
+{
+	PayloadWriter	writer		(result);
+	Source			program;
+	BuildInfo		buildInfo;
+
+	readSource(reader, program);
+	reader.assumeEnd();
+
+	try
+	{
+		const de::UniquePtr<ProgramBinary>	binary	(buildLocal(program, &buildInfo, optimizationRecipe));
+
+		writer.putU32(STATUS_OK);
+		writer.putString("");
+		writeBuildInfo(writer, buildInfo);
+		writer.putBytes(binary->getBinary(), binary->getSize());
+	}
+	catch (const tcu::NotSupportedError& e)
+	{
+		writeNotAvailable(result, e.getMessage());
+	}
+	catch (const tcu::Exception& e)
+	{
+		result.clear();
+		writer.putU32(STATUS_BUILD_FAILED);
+		writer.putString(e.getMessage());
+		writeBuildInfo(writer, buildInfo);
+	}
+}
+
+// Communication
+
+//! Wait before retrying operation on non-blocking socket, or throw if deadline has passed.
+void waitForSocket (deUint64 deadlineUs)
+{
+	if (deadlineUs == 0 || deGetMicroseconds() >= deadlineUs)
+		throw xs::ConnectionError("Compile server connection timed out");
+
+	deSleep(1);
+}
+
+void sendBytes (de::Socket& socket, const deUint8* data, size_t size, deUint64 deadlineUs)
+{
+	size_t numSent = 0;
+
+	while (numSent < size)
+	{
+		size_t					numSentNow	= 0;
+		const deSocketResult	result		= socket.send(data + numSent, size - numSent, &numSentNow);
+
+		if (result == DE_SOCKETRESULT_WOULD_BLOCK)
+			waitForSocket(deadlineUs);
+		else if (result != DE_SOCKETRESULT_SUCCESS)
+			throw xs::ConnectionError("Sending to compile server connection failed");
+
+		numSent += numSentNow;
+	}
+}
+
+//! Receive size bytes. Returns number of bytes received before connection was closed.
+size_t receiveBytes (de::Socket& socket, deUint8* dst, size_t size, deUint64 deadlineUs)
+{
+	size_t numReceived = 0;
+
+	while (numReceived < size)
+	{
+		size_t					numReceivedNow	= 0;
+		const deSocketResult	result			= socket.receive(dst + numReceived, size - numReceived, &numReceivedNow);
+
+		if (result == DE_SOCKETRESULT_CONNECTION_CLOSED || result == DE_SOCKETRESULT_CONNECTION_TERMINATED)
+			break;
+		else if (result == DE_SOCKETRESULT_WOULD_BLOCK)
+			waitForSocket(deadlineUs);
+		else if (result != DE_SOCKETRESULT_SUCCESS)
+			throw xs::ConnectionError("Receiving from compile server connection failed");
+
+		numReceived += numReceivedNow;
+	}
+
+	return numReceived;
+}
+
+class CompileServerClient
+{
+public:
+	CompileServerClient (void)
+		: m_unavailable(false)
+	{
+	}
+
+	//! Send request and receive result. Returns false if server is not available.
+	bool execute (int port, const vector<deUint8>& request, vector<deUint8>& result)
+	{
+		if (m_unavailable)
+			return false;
+
+		try
+		{
+			// \note Localhost connections are cheap compared to builds, so a connection is made per request.
+			//		 That also makes a restarted server visible to long-running clients.
+			de::Socket			socket;
+			de::SocketAddress	address;
+
+			address.setFamily(DE_SOCKETFAMILY_INET4);
+			address.setType(DE_SOCKETTYPE_STREAM);
+			address.setProtocol(DE_SOCKETPROTOCOL_TCP);
+			address.setHost("127.0.0.1");
+			address.setPort(port);
+
+			socket.connect(address);
+			socket.setFlags(DE_SOCKET_NODELAY|DE_SOCKET_CLOSE_ON_EXEC|DE_SOCKET_NONBLOCKING);
+
+			{
+				const deUint64 deadlineUs = deGetMicroseconds() + REQUEST_TIMEOUT_US;
+
+				sendCompileMessage(socket, xs::MESSAGETYPE_COMPILE_PROGRAM, request, deadlineUs);
+
+				if (!receiveCompileMessage(socket, xs::MESSAGETYPE_COMPILE_RESULT, result, deadlineUs))
+					throw xs::ConnectionError("Compile server closed connection");
+			}
+
+			socket.close();
+			return true;
+		}
+		catch (const std::runtime_error&)
+		{
+			// Server is not running, went away or timed out; build remaining programs in-process.
+			m_unavailable = true;
+			return false;
+		}
+	}
+
+	//! Stop using server, for example after it sent a result that can't be used.
+	void setUnavailable (void)
+	{
+		m_unavailable = true;
+	}
+
+private:
+	volatile bool	m_unavailable;
+};
+
+CompileServerClient s_client;
+
+template<typename BuildInfo>
+ProgramBinary* readResult (const vector<deUint8>& result, BuildInfo* buildInfo)
+{
+	PayloadReader		reader			(result);
+	const deUint32		status			= reader.getU32();
+	const string		message			= reader.getString();
+	BuildInfo			resultBuildInfo;
+	vector<deUint8>		binary;
+
+	if (status == STATUS_NOT_AVAILABLE)
+		return DE_NULL;
+
+	XS_CHECK_MSG(status == STATUS_OK || status == STATUS_BUILD_FAILED, "Invalid compile result status");
+
+	readBuildInfo(reader, resultBuildInfo);
+
+	if (status == STATUS_OK)
+		reader.getBytes(binary);
+
+	reader.assumeEnd();
+
+	*buildInfo = resultBuildInfo;
+
+	if (status == STATUS_BUILD_FAILED)
+		throw tcu::InternalError(message);
+
+	XS_CHECK_MSG(!binary.empty(), "Empty program binary");
+
+	return new ProgramBinary(PROGRAM_FORMAT_SPIRV, binary.size(), &binary[0]);
+}
+
+template<typename Source, typename BuildInfo>
+ProgramBinary* buildRemote (int port, RequestKind kind, const Source& program, BuildInfo* buildInfo, int optimizationRecipe)
+{
+	vector<deUint8>	request;
+	vector<deUint8>	result;
+
+	{
+		PayloadWriter	writer	(request);
+
+		writeRequestHeader(writer, kind, optimizationRecipe);
+		writeSource(writer, program);
+	}
+
+	if (!s_client.execute(port, request, result))
+		return DE_NULL;
+
+	try
+	{
+		ProgramBinary* const binary = readResult(result, buildInfo);
+
+		// Server can't build programs for this client, typically because it was built differently.
+		if (!binary)
+			s_client.setUnavailable();
+
+		return binary;
+	}
+	catch (const xs::Error&)
+	{
+		// Malformed result; build this and remaining programs in-process.
+		s_client.setUnavailable();
+		return DE_NULL;
+	}
+}
+
+} // anonymous
+
+ProgramBinary* buildProgramRemote (int port, const GlslSource& program, glu::ShaderProgramInfo* buildInfo, int optimizationRecipe)
+{
+	return buildRemote(port, REQUEST_GLSL, program, buildInfo, optimizationRecipe);
+}
+
+ProgramBinary* buildProgramRemote (int port, const HlslSource& program, glu::ShaderProgramInfo* buildInfo, int optimizationRecipe)
+{
+	return buildRemote(port, REQUEST_HLSL, program, buildInfo, optimizationRecipe);
+}
+
+ProgramBinary* assembleProgramRemote (int port, const SpirVAsmSource& program, SpirVProgramInfo* buildInfo, int optimizationRecipe)
+{
+	return buildRemote(port, REQUEST_SPIRV_ASM, program, buildInfo, optimizationRecipe);
+}
+
+void processCompileRequest (const vector<deUint8>& request, vector<deUint8>& result)
+{
+	PayloadReader	reader	(request);
+
+	result.clear();
+
+	if (reader.getU32() != PROTOCOL_VERSION || reader.getString() != getCompileEnvironment())
+	{
+		writeNotAvailable(result, "Compile server was built from different sources");
+		return;
+	}
+
+	{
+		const deUint32	kind				= reader.getU32();
+		const int		optimizationRecipe	= (int)reader.getU32();
+
+		switch (kind)
+		{
+			case REQUEST_GLSL:		processRequest<GlslSource, glu::ShaderProgramInfo>(reader, optimizationRecipe, result);	break;
+			case REQUEST_HLSL:		processRequest<HlslSource, glu::ShaderProgramInfo>(reader, optimizationRecipe, result);	break;
+			case REQUEST_SPIRV_ASM:	processRequest<SpirVAsmSource, SpirVProgramInfo>(reader, optimizationRecipe, result);		break;
+			default:
+				XS_FAIL("Invalid compile request kind");
+		}
+	}
+}
+
+void sendCompileMessage (de::Socket& socket, xs::MessageType type, const vector<deUint8>& payload, deUint64 deadlineUs)
+{
+	deUint8	header[xs::MESSAGE_HEADER_SIZE];
+
+	xs::Message::writeHeader(type, sizeof(header) + payload.size(), &header[0], sizeof(header));
+
+	sendBytes(socket, &header[0], sizeof(header), deadlineUs);
+
+	if (!payload.empty())
+		sendBytes(socket, &payload[0], payload.size(), deadlineUs);
+}
+
+bool receiveCompileMessage (de::Socket& socket, xs::MessageType expectedType, vector<deUint8>& payload, deUint64 deadlineUs)
+{
+	deUint8				header[xs::MESSAGE_HEADER_SIZE];
+	const size_t		numHeaderBytes	= receiveBytes(socket, &header[0], sizeof(header), deadlineUs);
+	xs::MessageType		type;
+	size_t				messageSize;
+
+	if (numHeaderBytes == 0)
+		return false;
+
+	XS_CHECK_MSG(numHeaderBytes == sizeof(header), "Incomplete message header");
+
+	xs::Message::parseHeader(&header[0], sizeof(header), type, messageSize);
+
+	XS_CHECK_MSG(type == expectedType, "Unexpected message type");
+	XS_CHECK_MSG(messageSize >= sizeof(header), "Invalid message size");
+
+	payload.resize(messageSize - sizeof(header));
+
+	if (!payload.empty())
+		XS_CHECK_MSG(receiveBytes(socket, &payload[0], payload.size(), deadlineUs) == payload.size(), "Incomplete message");
+
+	return true;
+}
+
+namespace
+{
+
+template<typename Func>
+bool throwsProtocolError (Func func)
+{
+	try
+	{
+		func();
+	}
+	catch (const xs::Error&)
+	{
+		return true;
+	}
+
+	return false;
+}
+
+struct ReadGlslResult
+{
+	const vector<deUint8>&	result;
+
+	ReadGlslResult (const vector<deUint8>& result_) : result(result_) {}
+
+	void operator() (void) const
+	{
+		glu::ShaderProgramInfo				buildInfo;
+		const de::UniquePtr<ProgramBinary>	binary		(readResult(result, &buildInfo));
+	}
+};
+
+struct ProcessRequest
+{
+	const vector<deUint8>&	request;
+
+	ProcessRequest (const vector<deUint8>& request_) : request(request_) {}
+
+	void operator() (void) const
+	{
+		vector<deUint8> result;
+		processCompileRequest(request, result);
+	}
+};
+
+vector<deUint8> makeGlslResult (ResultStatus status, const glu::ShaderProgramInfo& buildInfo, const vector<deUint8>& binary)
+{
+	vector<deUint8>	result;
+	PayloadWriter	writer	(result);
+
+	writer.putU32(status);
+	writer.putString(status == STATUS_OK ? "" : "Build failed");
+	writeBuildInfo(writer, buildInfo);
+
+	if (status == STATUS_OK)
+		writer.putBytes(&binary[0], binary.size());
+
+	return result;
+}
+
+} // anonymous
+
+void compileServerSelfTest (void)
+{
+	// Primitive values
+	{
+		const deUint8	bytes[]	= { 0u, 1u, 0xffu };
+		vector<deUint8>	payload;
+		PayloadWriter	writer	(payload);
+
+		writer.putU32(0xdeadbeefu);
+		writer.putU64(0x0123456789abcdefull);
+		writer.putBool(true);
+		writer.putBool(false);
+		writer.putBytes(&bytes[0], DE_LENGTH_OF_ARRAY(bytes));
+		writer.putString("");
+		writer.putString("foo");
+
+		TCU_CHECK(payload.size() == 4+8+4+4+(4+3)+4+(4+3));
+		TCU_CHECK(payload[0] == 0xdeu && payload[3] == 0xefu);
+
+		{
+			PayloadReader	reader	(payload);
+			vector<deUint8>	readBytes;
+
+			TCU_CHECK(reader.getU32() == 0xdeadbeefu);
+			TCU_CHECK(reader.getU64() == 0x0123456789abcdefull);
+			TCU_CHECK(reader.getBool() == true);
+			TCU_CHECK(reader.getBool() == false);
+			reader.getBytes(readBytes);
+			TCU_CHECK(readBytes == vector<deUint8>(&bytes[0], &bytes[0] + DE_LENGTH_OF_ARRAY(bytes)));
+			TCU_CHECK(reader.getString() == "");
+			TCU_CHECK(reader.getString() == "foo");
+			reader.assumeEnd();
+		}
+	}
+
+	// GLSL request
+	{
+		GlslSource		program;
+		GlslSource		readProgram;
+		vector<deUint8>	request;
+		PayloadWriter	writer	(request);
+
+		program.buildOptions = ShaderBuildOptions(VK_API_VERSION_1_1, SPIRV_VERSION_1_3, ShaderBuildOptions::FLAG_USE_STORAGE_BUFFER_STORAGE_CLASS);
+		program << glu::VertexSource("#version 450\nvoid main (void) {}\n")
+				<< glu::FragmentSource("#version 450\nvoid main (void) {}\n");
+
+		writeRequestHeader(writer, REQUEST_GLSL, 2);
+		writeSource(writer, program);
+
+		{
+			PayloadReader reader (request);
+
+			TCU_CHECK(reader.getU32() == PROTOCOL_VERSION);
+			TCU_CHECK(reader.getString() == getCompileEnvironment());
+			TCU_CHECK(reader.getU32() == REQUEST_GLSL);
+			TCU_CHECK(reader.getU32() == 2u);
+
+			readSource(reader, readProgram);
+			reader.assumeEnd();
+		}
+
+		TCU_CHECK(readProgram.buildOptions.vulkanVersion == program.buildOptions.vulkanVersion);
+		TCU_CHECK(readProgram.buildOptions.targetVersion == program.buildOptions.targetVersion);
+		TCU_CHECK(readProgram.buildOptions.flags == program.buildOptions.flags);
+
+		for (int shaderType = 0; shaderType < glu::SHADERTYPE_LAST; shaderType++)
+			TCU_CHECK(readProgram.sources[shaderType] == program.sources[shaderType]);
+
+		// Truncated requests are rejected rather than processed
+		for (size_t size = 0; size < request.size(); size++)
+			TCU_CHECK(throwsProtocolError(ProcessRequest(vector<deUint8>(request.begin(), request.begin() + size))));
+	}
+
+	// Request from differently built client is refused
+	{
+		vector<deUint8>	request;
+		vector<deUint8>	result;
+		PayloadWriter	writer	(request);
+
+		writer.putU32(PROTOCOL_VERSION);
+		writer.putString(getCompileEnvironment() + " other");
+		writer.putU32(REQUEST_GLSL);
+		writer.putU32(0u);
+
+		processCompileRequest(request, result);
+
+		{
+			PayloadReader reader (result);
+
+			TCU_CHECK(reader.getU32() == STATUS_NOT_AVAILABLE);
+			reader.getString();
+			reader.assumeEnd();
+		}
+
+		{
+			glu::ShaderProgramInfo buildInfo;
+			TCU_CHECK(readResult(result, &buildInfo) == DE_NULL);
+		}
+	}
+
+	// Results
+	{
+		glu::ShaderProgramInfo	buildInfo;
+		vector<deUint8>			binary		(16, 0xabu);
+
+		buildInfo.program.infoLog		= "link log";
+		buildInfo.program.linkOk		= true;
+		buildInfo.program.linkTimeUs	= 123u;
+		buildInfo.shaders.resize(2);
+
+		buildInfo.shaders[0].type			= glu::SHADERTYPE_VERTEX;
+		buildInfo.shaders[0].source			= "vertex";
+		buildInfo.shaders[0].compileOk		= true;
+		buildInfo.shaders[0].compileTimeUs	= 4u;
+		buildInfo.shaders[1].type			= glu::SHADERTYPE_FRAGMENT;
+		buildInfo.shaders[1].source			= "fragment";
+		buildInfo.shaders[1].infoLog		= "compile log";
+		buildInfo.shaders[1].compileOk		= true;
+		buildInfo.shaders[1].compileTimeUs	= 5u;
+
+		// Successful build
+		{
+			const vector<deUint8>				result			= makeGlslResult(STATUS_OK, buildInfo, binary);
+			glu::ShaderProgramInfo				readBuildInfo;
+			const de::UniquePtr<ProgramBinary>	readBinary		(readResult(result, &readBuildInfo));
+
+			TCU_CHECK(readBinary && readBinary->getFormat() == PROGRAM_FORMAT_SPIRV);
+			TCU_CHECK(vector<deUint8>(readBinary->getBinary(), readBinary->getBinary() + readBinary->getSize()) == binary);
+			TCU_CHECK(readBuildInfo.program.infoLog == buildInfo.program.infoLog);
+			TCU_CHECK(readBuildInfo.program.linkOk == buildInfo.program.linkOk);
+			TCU_CHECK(readBuildInfo.program.linkTimeUs == buildInfo.program.linkTimeUs);
+			TCU_CHECK(readBuildInfo.shaders.size() == buildInfo.shaders.size());
+
+			for (size_t shaderNdx = 0; shaderNdx < buildInfo.shaders.size(); shaderNdx++)
+			{
+				TCU_CHECK(readBuildInfo.shaders[shaderNdx].type == buildInfo.shaders[shaderNdx].type);
+				TCU_CHECK(readBuildInfo.shaders[shaderNdx].source == buildInfo.shaders[shaderNdx].source);
+				TCU_CHECK(readBuildInfo.shaders[shaderNdx].infoLog == buildInfo.shaders[shaderNdx].infoLog);
+				TCU_CHECK(readBuildInfo.shaders[shaderNdx].compileOk == buildInfo.shaders[shaderNdx].compileOk);
+				TCU_CHECK(readBuildInfo.shaders[shaderNdx].compileTimeUs == buildInfo.shaders[shaderNdx].compileTimeUs);
+			}
+
+			// Truncated and oversized results are rejected
+			for (size_t size = 0; size < result.size(); size++)
+				TCU_CHECK(throwsProtocolError(ReadGlslResult(vector<deUint8>(result.begin(), result.begin() + size))));
+
+			{
+				vector<deUint8> oversized = result;
+				oversized.push_back(0u);
+				TCU_CHECK(throwsProtocolError(ReadGlslResult(oversized)));
+			}
+		}
+
+		// Failed build is reported with build info
+		{
+			const vector<deUint8>	result			= makeGlslResult(STATUS_BUILD_FAILED, buildInfo, binary);
+			glu::ShaderProgramInfo	readBuildInfo;
+			bool					thrown			= false;
+
+			try
+			{
+				delete readResult(result, &readBuildInfo);
+			}
+			catch (const tcu::InternalError& e)
+			{
+				thrown = e.getMessage() == string("Build failed");
+			}
+
+			TCU_CHECK(thrown);
+			TCU_CHECK(readBuildInfo.shaders.size() == buildInfo.shaders.size());
+			TCU_CHECK(readBuildInfo.program.infoLog == buildInfo.program.infoLog);
+		}
+
+		// Unknown status and corrupted build info are rejected
+		{
+			vector<deUint8> result = makeGlslResult(STATUS_OK, buildInfo, binary);
+
+			result[3] = (deUint8)STATUS_LAST;
+			TCU_CHECK(throwsProtocolError(ReadGlslResult(result)));
+		}
+
+		{
+			glu::ShaderProgramInfo	invalidInfo	= buildInfo;
+
+			invalidInfo.shaders[0].type = glu::SHADERTYPE_LAST;
+			TCU_CHECK(throwsProtocolError(ReadGlslResult(makeGlslResult(STATUS_OK, invalidInfo, binary))));
+		}
+	}
+
+	// SPIR-V assembly build info
+	{
+		SpirVProgramInfo	buildInfo;
+		SpirVProgramInfo	readInfo;
+		vector<deUint8>		payload;
+		PayloadWriter		writer		(payload);
+
+		buildInfo.source		= "OpCapability Shader";
+		buildInfo.infoLog		= "assembly log";
+		buildInfo.compileTimeUs	= 0x100000000ull;
+		buildInfo.compileOk		= true;
+
+		writeBuildInfo(writer, buildInfo);
+
+		{
+			PayloadReader reader (payload);
+
+			readBuildInfo(reader, readInfo);
+			reader.assumeEnd();
+		}
+
+		TCU_CHECK(readInfo.source == buildInfo.source);
+		TCU_CHECK(readInfo.infoLog == buildInfo.infoLog);
+		TCU_CHECK(readInfo.compileTimeUs == buildInfo.compileTimeUs);
+		TCU_CHECK(readInfo.compileOk == buildInfo.compileOk);
+	}
+}
+
+} // vk
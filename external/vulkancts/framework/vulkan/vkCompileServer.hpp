@@ -0,0 +1,67 @@
+#ifndef _VKCOMPILESERVER_HPP
+#define _VKCOMPILESERVER_HPP
+/*-------------------------------------------------------------------------
+ * Vulkan CTS Framework
+ * --------------------
+ *
+ * Copyright (c) 2019 Google Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Client and request processing for local shader compile server.
+ *
+ * Compile server (vk-compile-server) builds programs on behalf of test
+ * processes running on the same host, keeping compilers warm and sharing
+ * results between processes. Requests and results are sent over a TCP
+ * connection to localhost using execserver message framing.
+ *//*--------------------------------------------------------------------*/
+
+#include "vkDefs.hpp"
+#include "vkPrograms.hpp"
+#include "xsProtocol.hpp"
+#include "deSocket.hpp"
+
+#include <vector>
+
+namespace vk
+{
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Build program using compile server listening on localhost:port
+ *
+ * Returns DE_NULL if the server is not available, in which case caller
+ * should build the program in-process. Once connecting to the server has
+ * failed or timed out, or the server has sent an unusable result, no
+ * further connections are attempted. Build failures are thrown as
+ * tcu::InternalError with build info filled in, as with buildProgram().
+ *//*--------------------------------------------------------------------*/
+ProgramBinary*	buildProgramRemote		(int port, const GlslSource& program, glu::ShaderProgramInfo* buildInfo, int optimizationRecipe);
+ProgramBinary*	buildProgramRemote		(int port, const HlslSource& program, glu::ShaderProgramInfo* buildInfo, int optimizationRecipe);
+ProgramBinary*	assembleProgramRemote	(int port, const SpirVAsmSource& program, SpirVProgramInfo* buildInfo, int optimizationRecipe);
+
+//! Build program described by serialized request in this process and serialize result.
+void			processCompileRequest	(const std::vector<deUint8>& request, std::vector<deUint8>& result);
+
+//! Send message with given payload. Non-blocking socket throws xs::ConnectionError once deGetMicroseconds() passes non-zero deadlineUs.
+void			sendCompileMessage		(de::Socket& socket, xs::MessageType type, const std::vector<deUint8>& payload, deUint64 deadlineUs = 0);
+
+//! Receive message of expected type. Returns false if connection was closed before message started. Deadline as in sendCompileMessage().
+bool			receiveCompileMessage	(de::Socket& socket, xs::MessageType expectedType, std::vector<deUint8>& payload, deUint64 deadlineUs = 0);
+
+void			compileServerSelfTest	(void);
+
+} // vk
+
+#endif // _VKCOMPILESERVER_HPP
@@ -27,6 +27,7 @@
 #include "vkRefUtil.hpp"
 #include "vkQueryUtil.hpp"
 #include "vkTypeUtil.hpp"
+#include "vkCmdUtil.hpp"
 #include "tcuTextureUtil.hpp"
 
 namespace vk
@@ -2858,6 +2859,15 @@ void copyBufferToImage (const DeviceInterface&					vk,
 						VkImageLayout							destImageLayout,
 						VkPipelineStageFlags					destImageDstStageFlags)
 {
+	if (!waitSemaphore)
+	{
+		PooledCommandBuffer cmdBuffer (vk, device, queue, queueFamilyIndex);
+
+		copyBufferToImage(vk, *cmdBuffer, buffer, bufferSize, copyRegions, imageAspectFlags, mipLevels, arrayLayers, destImage, destImageLayout, destImageDstStageFlags);
+		cmdBuffer.submitAndWait();
+		return;
+	}
+
 	Move<VkCommandPool>		cmdPool		= createCommandPool(vk, device, VK_COMMAND_POOL_CREATE_TRANSIENT_BIT, queueFamilyIndex);
 	Move<VkCommandBuffer>	cmdBuffer	= allocateCommandBuffer(vk, device, *cmdPool, VK_COMMAND_BUFFER_LEVEL_PRIMARY);
 	Move<VkFence>			fence		= createFence(vk, device);
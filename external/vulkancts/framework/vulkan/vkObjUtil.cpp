@@ -25,6 +25,7 @@
 #include "vkRefUtil.hpp"
 #include "vkImageUtil.hpp"
 #include "vkObjUtil.hpp"
+#include "vkPipelineCacheUtil.hpp"
 #include "tcuVector.hpp"
 
 namespace vk
@@ -280,7 +281,7 @@ Move<VkPipeline> makeGraphicsPipeline(const DeviceInterface&						vk,
 		0																										// deInt32                                          basePipelineIndex;
 	};
 
-	return createGraphicsPipeline(vk, device, DE_NULL, &pipelineCreateInfo);
+	return createGraphicsPipeline(vk, device, getDefaultPipelineCache(device), &pipelineCreateInfo);
 }
 
 Move<VkPipeline> makeGraphicsPipeline (const DeviceInterface&							vk,
@@ -373,7 +374,7 @@ Move<VkPipeline> makeGraphicsPipeline (const DeviceInterface&							vk,
 		0													// deInt32                                          basePipelineIndex;
 	};
 
-	return createGraphicsPipeline(vk, device, DE_NULL, &pipelineCreateInfo);
+	return createGraphicsPipeline(vk, device, getDefaultPipelineCache(device), &pipelineCreateInfo);
 }
 
 Move<VkRenderPass> makeRenderPass (const DeviceInterface&				vk,
@@ -0,0 +1,213 @@
+/*-------------------------------------------------------------------------
+ * Vulkan CTS Framework
+ * --------------------
+ *
+ * Copyright (c) 2019 Google Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Default pipeline cache and pipeline cache persistence.
+ *
+ * Pipeline cache file consists of a header followed by the data returned
+ * by vkGetPipelineCacheData():
+ *
+ *   deUint32	magic ('VKPC')
+ *   deUint32	file format version
+ *   deUint32	vendor ID
+ *   deUint32	device ID
+ *   deUint32	driver version
+ *   deUint8[]	pipelineCacheUUID (VK_UUID_SIZE bytes)
+ *   deUint32	data size in bytes
+ *   deUint8[]	data
+ *//*--------------------------------------------------------------------*/
+
+#include "vkPipelineCacheUtil.hpp"
+#include "vkRefUtil.hpp"
+#include "vkQueryUtil.hpp"
+#include "deFilePath.hpp"
+#include "deMemory.h"
+
+#include <cstdio>
+#include <vector>
+
+namespace vk
+{
+
+using std::vector;
+
+namespace
+{
+
+enum
+{
+	FILE_MAGIC		= 0x43504b56u,	//!< 'VKPC' in little-endian byte order
+	FILE_VERSION	= 1u,
+	HEADER_SIZE		= 5 * 4 + VK_UUID_SIZE + 4
+};
+
+vector<deUint8> getFileHeader (const VkPhysicalDeviceProperties& properties, deUint32 dataSize)
+{
+	const deUint32	fields[]	= { FILE_MAGIC, FILE_VERSION, properties.vendorID, properties.deviceID, properties.driverVersion };
+	vector<deUint8>	header		(HEADER_SIZE);
+
+	deMemcpy(&header[0], fields, sizeof(fields));
+	deMemcpy(&header[sizeof(fields)], properties.pipelineCacheUUID, VK_UUID_SIZE);
+	deMemcpy(&header[sizeof(fields) + VK_UUID_SIZE], &dataSize, sizeof(dataSize));
+
+	return header;
+}
+
+//! Read cache data from file. Returns empty data if file doesn't match the device.
+vector<deUint8> readCacheData (const VkPhysicalDeviceProperties& properties, const std::string& filename)
+{
+	FILE* const		file		= fopen(filename.c_str(), "rb");
+	vector<deUint8>	header		(HEADER_SIZE);
+	vector<deUint8>	data;
+	deUint32		dataSize	= 0;
+	bool			ok			= file != DE_NULL;
+
+	if (ok) ok = fread(&header[0], 1, HEADER_SIZE, file)					== HEADER_SIZE;
+	if (ok) deMemcpy(&dataSize, &header[HEADER_SIZE - 4], sizeof(dataSize));
+	if (ok) ok = dataSize > 0 && header == getFileHeader(properties, dataSize);
+	if (ok) data.resize(dataSize);
+	if (ok) ok = fread(&data[0], 1, dataSize, file)							== dataSize;
+
+	if (file)
+		fclose(file);
+
+	if (!ok)
+		data.clear();
+
+	return data;
+}
+
+VkDevice		s_defaultCacheDevice	= DE_NULL;
+VkPipelineCache	s_defaultCache			= DE_NULL;
+
+} // anonymous
+
+Move<VkPipelineCache> createPipelineCacheFromFile (const InstanceInterface&	vki,
+												   VkPhysicalDevice			physicalDevice,
+												   const DeviceInterface&	vkd,
+												   VkDevice					device,
+												   const std::string&		filename)
+{
+	const vector<deUint8>		data		= readCacheData(getPhysicalDeviceProperties(vki, physicalDevice), filename);
+	VkPipelineCacheCreateInfo	createInfo	=
+	{
+		VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,	// VkStructureType				sType;
+		DE_NULL,										// const void*					pNext;
+		0u,												// VkPipelineCacheCreateFlags	flags;
+		data.size(),									// deUintptr					initialDataSize;
+		data.empty() ? DE_NULL : &data[0],				// const void*					pInitialData;
+	};
+
+	if (!data.empty())
+	{
+		try
+		{
+			return createPipelineCache(vkd, device, &createInfo);
+		}
+		catch (const Error&)
+		{
+			// Driver may still refuse data it wrote itself; start with an empty cache instead.
+			createInfo.initialDataSize	= 0;
+			createInfo.pInitialData		= DE_NULL;
+		}
+	}
+
+	return createPipelineCache(vkd, device, &createInfo);
+}
+
+bool savePipelineCacheToFile (const InstanceInterface&	vki,
+							  VkPhysicalDevice			physicalDevice,
+							  const DeviceInterface&	vkd,
+							  VkDevice					device,
+							  VkPipelineCache			pipelineCache,
+							  const std::string&		filename)
+{
+	const de::FilePath	filePath	(filename);
+	const std::string	tmpFilename	= filename + ".tmp";
+	deUintptr			dataSize	= 0;
+	vector<deUint8>		data;
+	FILE*				file		= DE_NULL;
+	bool				ok			= true;
+
+	if (vkd.getPipelineCacheData(device, pipelineCache, &dataSize, DE_NULL) != VK_SUCCESS || dataSize == 0)
+		return false;
+
+	data.resize(dataSize);
+
+	// Cache may have grown since size query; VK_INCOMPLETE still returns a valid prefix.
+	if (vkd.getPipelineCacheData(device, pipelineCache, &dataSize, &data[0]) < VK_SUCCESS || dataSize == 0)
+		return false;
+
+	data.resize(dataSize);
+
+	if (!filePath.getDirName().empty() && !de::FilePath(filePath.getDirName()).exists())
+		de::createDirectoryAndParents(filePath.getDirName().c_str());
+
+	file = fopen(tmpFilename.c_str(), "wb");
+	if (!file)
+		return false;
+
+	{
+		const vector<deUint8> header = getFileHeader(getPhysicalDeviceProperties(vki, physicalDevice), (deUint32)data.size());
+
+		if (ok) ok = fwrite(&header[0], 1, header.size(), file)		== header.size();
+		if (ok) ok = fwrite(&data[0], 1, data.size(), file)			== data.size();
+	}
+
+	if (fclose(file) != 0)
+		ok = false;
+
+	// Previous file is replaced only by a complete one. Rename doesn't replace existing files on all platforms.
+	if (ok && rename(tmpFilename.c_str(), filename.c_str()) != 0)
+	{
+		remove(filename.c_str());
+		ok = rename(tmpFilename.c_str(), filename.c_str()) == 0;
+	}
+
+	if (!ok)
+		remove(tmpFilename.c_str());
+
+	return ok;
+}
+
+deUintptr getPipelineCacheDataSize (const DeviceInterface& vkd, VkDevice device, VkPipelineCache pipelineCache)
+{
+	deUintptr dataSize = 0;
+
+	if (vkd.getPipelineCacheData(device, pipelineCache, &dataSize, DE_NULL) != VK_SUCCESS)
+		return 0;
+
+	return dataSize;
+}
+
+void setDefaultPipelineCache (VkDevice device, VkPipelineCache pipelineCache)
+{
+	s_defaultCacheDevice	= pipelineCache != DE_NULL ? device : DE_NULL;
+	s_defaultCache			= pipelineCache;
+}
+
+VkPipelineCache getDefaultPipelineCache (VkDevice device)
+{
+	if (device != DE_NULL && device == s_defaultCacheDevice)
+		return s_defaultCache;
+	else
+		return DE_NULL;
+}
+
+} // vk
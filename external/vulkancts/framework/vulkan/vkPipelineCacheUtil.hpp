@@ -0,0 +1,78 @@
+#ifndef _VKPIPELINECACHEUTIL_HPP
+#define _VKPIPELINECACHEUTIL_HPP
+/*-------------------------------------------------------------------------
+ * Vulkan CTS Framework
+ * --------------------
+ *
+ * Copyright (c) 2019 Google Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Default pipeline cache and pipeline cache persistence.
+ *//*--------------------------------------------------------------------*/
+
+#include "vkDefs.hpp"
+#include "vkRef.hpp"
+
+#include <string>
+
+namespace vk
+{
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Create pipeline cache, initialized from file if possible
+ *
+ * File is used only if it was saved with savePipelineCacheToFile() on a
+ * device with the same vendor and device ID, pipelineCacheUUID and driver
+ * version. Otherwise, or if the file is missing or corrupted, an empty
+ * cache is created.
+ *//*--------------------------------------------------------------------*/
+Move<VkPipelineCache>	createPipelineCacheFromFile		(const InstanceInterface&	vki,
+														 VkPhysicalDevice			physicalDevice,
+														 const DeviceInterface&		vkd,
+														 VkDevice					device,
+														 const std::string&			filename);
+
+//! Write pipeline cache data to file. Returns false if the file could not be written.
+//! Data is written to a temporary file first and renamed over filename, so an interrupted save never leaves a truncated file.
+bool					savePipelineCacheToFile			(const InstanceInterface&	vki,
+														 VkPhysicalDevice			physicalDevice,
+														 const DeviceInterface&		vkd,
+														 VkDevice					device,
+														 VkPipelineCache			pipelineCache,
+														 const std::string&			filename);
+
+//! Get size of pipeline cache data in bytes, or 0 if it can't be queried.
+deUintptr				getPipelineCacheDataSize		(const DeviceInterface&		vkd,
+														 VkDevice					device,
+														 VkPipelineCache			pipelineCache);
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Set pipeline cache used by object utilities
+ *
+ * Pipeline helpers such as makeGraphicsPipeline() create pipelines with
+ * the default cache when they are called with the same device, and
+ * without a cache otherwise. Pass DE_NULL to remove the default
+ * cache. Default cache must not be changed while pipelines are created
+ * in other threads.
+ *//*--------------------------------------------------------------------*/
+void					setDefaultPipelineCache			(VkDevice device, VkPipelineCache pipelineCache);
+
+//! Get default pipeline cache for device, or DE_NULL if none is set for it.
+VkPipelineCache			getDefaultPipelineCache			(VkDevice device);
+
+} // vk
+
+#endif // _VKPIPELINECACHEUTIL_HPP
@@ -0,0 +1,248 @@
+/*-------------------------------------------------------------------------
+ * Vulkan CTS Framework
+ * --------------------
+ *
+ * Copyright (c) 2019 Google Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief In-memory cache of program binaries built in one session.
+ *//*--------------------------------------------------------------------*/
+
+#include "vkProgramBinaryCache.hpp"
+#include "tcuCommandLine.hpp"
+#include "tcuTestLog.hpp"
+#include "deSha1.hpp"
+#include "deUniquePtr.hpp"
+
+namespace vk
+{
+
+struct ProgramBinaryCache::Entry
+{
+	de::SharedPtr<ProgramBinary>	binary;
+	glu::ShaderProgramInfo			shaderInfo;		//!< Build info of GLSL and HLSL programs
+	SpirVProgramInfo				asmInfo;		//!< Build info of SPIR-V assembly programs
+
+	glu::ShaderProgramInfo&			getInfo			(const glu::ShaderProgramInfo*)	{ return shaderInfo;	}
+	SpirVProgramInfo&				getInfo			(const SpirVProgramInfo*)		{ return asmInfo;		}
+};
+
+namespace
+{
+
+template<typename SourceType>
+std::string getProgramKey (const SourceType& program, int optimizationRecipe)
+{
+	de::Sha1Stream stream;
+
+	stream << (deUint32)SourceType::shaderLanguage
+		   << program.buildOptions.vulkanVersion
+		   << (deUint32)program.buildOptions.targetVersion
+		   << program.buildOptions.flags
+		   << (deInt32)optimizationRecipe;
+
+	for (int shaderType = 0; shaderType < glu::SHADERTYPE_LAST; shaderType++)
+		stream << program.sources[shaderType];
+
+	return stream.finalize().toString();
+}
+
+std::string getProgramKey (const SpirVAsmSource& program, int optimizationRecipe)
+{
+	de::Sha1Stream stream;
+
+	// SPIR-V assembly is keyed as a language of its own.
+	stream << (deUint32)SHADER_LANGUAGE_LAST
+		   << program.buildOptions.vulkanVersion
+		   << (deUint32)program.buildOptions.targetVersion
+		   << (deInt32)optimizationRecipe
+		   << program.source;
+
+	return stream.finalize().toString();
+}
+
+ProgramBinary* compileProgram (const GlslSource& program, glu::ShaderProgramInfo* buildInfo, const tcu::CommandLine& commandLine)
+{
+	return buildProgram(program, buildInfo, commandLine);
+}
+
+ProgramBinary* compileProgram (const HlslSource& program, glu::ShaderProgramInfo* buildInfo, const tcu::CommandLine& commandLine)
+{
+	return buildProgram(program, buildInfo, commandLine);
+}
+
+ProgramBinary* compileProgram (const SpirVAsmSource& program, SpirVProgramInfo* buildInfo, const tcu::CommandLine& commandLine)
+{
+	return assembleProgram(program, buildInfo, commandLine);
+}
+
+const char* const s_reusedBuildNote = "Binary reused from an earlier build in this session, compile and link times are not measured";
+
+void appendLine (std::string& infoLog, const char* line)
+{
+	if (!infoLog.empty() && infoLog[infoLog.size() - 1] != '\n')
+		infoLog += '\n';
+
+	infoLog += line;
+}
+
+//! Reused build did no work, so its timings are zeroed. Note in the info log tells it apart from a fast build.
+void markReused (glu::ShaderProgramInfo& buildInfo)
+{
+	for (size_t shaderNdx = 0; shaderNdx < buildInfo.shaders.size(); shaderNdx++)
+		buildInfo.shaders[shaderNdx].compileTimeUs = 0;
+
+	buildInfo.program.linkTimeUs = 0;
+	appendLine(buildInfo.program.infoLog, s_reusedBuildNote);
+}
+
+void markReused (SpirVProgramInfo& buildInfo)
+{
+	buildInfo.compileTimeUs = 0;
+	appendLine(buildInfo.infoLog, s_reusedBuildNote);
+}
+
+} // anonymous
+
+ProgramBinaryCache::ProgramBinaryCache (size_t maxCacheSize)
+	: m_maxCacheSize	(maxCacheSize)
+	, m_cacheSize		(0)
+{
+}
+
+ProgramBinaryCache::~ProgramBinaryCache (void)
+{
+}
+
+ProgramBinary* ProgramBinaryCache::buildProgram (const GlslSource& program, glu::ShaderProgramInfo* buildInfo, const tcu::CommandLine& commandLine, Statistics* callStats)
+{
+	return getOrBuild(getProgramKey(program, commandLine.getOptimizationRecipe()), program, buildInfo, commandLine, callStats);
+}
+
+ProgramBinary* ProgramBinaryCache::buildProgram (const HlslSource& program, glu::ShaderProgramInfo* buildInfo, const tcu::CommandLine& commandLine, Statistics* callStats)
+{
+	return getOrBuild(getProgramKey(program, commandLine.getOptimizationRecipe()), program, buildInfo, commandLine, callStats);
+}
+
+ProgramBinary* ProgramBinaryCache::assembleProgram (const SpirVAsmSource& program, SpirVProgramInfo* buildInfo, const tcu::CommandLine& commandLine, Statistics* callStats)
+{
+	// Same recipe selection as in vk::assembleProgram().
+	const int optimizationRecipe = commandLine.isSpirvOptimizationEnabled() ? commandLine.getOptimizationRecipe() : 0;
+
+	return getOrBuild(getProgramKey(program, optimizationRecipe), program, buildInfo, commandLine, callStats);
+}
+
+template<typename SourceType, typename InfoType>
+ProgramBinary* ProgramBinaryCache::getOrBuild (const std::string& key, const SourceType& program, InfoType* buildInfo, const tcu::CommandLine& commandLine, Statistics* callStats)
+{
+	de::SharedPtr<ProgramBinary> cached;
+
+	{
+		const de::ScopedLock		lock	(m_lock);
+		const EntryMap::iterator	entry	= m_entries.find(key);
+
+		if (entry != m_entries.end())
+		{
+			cached		= entry->second->binary;
+			*buildInfo	= entry->second->getInfo(buildInfo);
+
+			m_stats.numHits += 1;
+
+			if (callStats)
+				callStats->numHits += 1;
+		}
+		else
+		{
+			m_stats.numMisses += 1;
+
+			if (callStats)
+				callStats->numMisses += 1;
+		}
+	}
+
+	if (cached)
+	{
+		markReused(*buildInfo);
+
+		return new ProgramBinary(cached->getFormat(), cached->getSize(), cached->getBinary());
+	}
+
+	{
+		de::MovePtr<ProgramBinary>	binary	(compileProgram(program, buildInfo, commandLine));
+
+		store(key, *binary, *buildInfo, callStats);
+
+		return binary.release();
+	}
+}
+
+template<typename InfoType>
+void ProgramBinaryCache::store (const std::string& key, const ProgramBinary& binary, const InfoType& buildInfo, Statistics* callStats)
+{
+	if (binary.getSize() > m_maxCacheSize)
+		return;
+
+	const de::SharedPtr<Entry>	entry	(new Entry());
+
+	entry->binary				= de::SharedPtr<ProgramBinary>(new ProgramBinary(binary.getFormat(), binary.getSize(), binary.getBinary()));
+	entry->getInfo(&buildInfo)	= buildInfo;
+
+	{
+		const de::ScopedLock lock (m_lock);
+
+		// Program may have been built concurrently by another thread.
+		if (!m_entries.insert(std::make_pair(key, entry)).second)
+			return;
+
+		m_insertOrder.push_back(key);
+		m_cacheSize += binary.getSize();
+
+		while (m_cacheSize > m_maxCacheSize)
+		{
+			const EntryMap::iterator oldest = m_entries.find(m_insertOrder.front());
+
+			m_cacheSize -= oldest->second->binary->getSize();
+			m_entries.erase(oldest);
+			m_insertOrder.pop_front();
+
+			m_stats.numEvicted += 1;
+
+			if (callStats)
+				callStats->numEvicted += 1;
+		}
+	}
+}
+
+ProgramBinaryCache::Statistics ProgramBinaryCache::getStatistics (void) const
+{
+	const de::ScopedLock lock (m_lock);
+	return m_stats;
+}
+
+void ProgramBinaryCache::logStatistics (tcu::TestLog& log, const Statistics& stats)
+{
+	if (stats.numHits + stats.numMisses == 0)
+		return;
+
+	log << tcu::TestLog::Section("ProgramBinaryCache", "Program binary cache statistics")
+		<< tcu::TestLog::Integer("ProgramBinaryCacheHits",		"Programs reused from earlier builds",	"",		QP_KEY_TAG_NONE, stats.numHits)
+		<< tcu::TestLog::Integer("ProgramBinaryCacheMisses",	"Programs built from source",			"",		QP_KEY_TAG_NONE, stats.numMisses)
+		<< tcu::TestLog::Integer("ProgramBinaryCacheEvicted",	"Binaries evicted from cache",			"",		QP_KEY_TAG_NONE, stats.numEvicted)
+		<< tcu::TestLog::Float("ProgramBinaryCacheHitRate",		"Cache hit rate",						"%",	QP_KEY_TAG_NONE, 100.0f * (float)stats.numHits / (float)(stats.numHits + stats.numMisses))
+		<< tcu::TestLog::EndSection;
+}
+
+} // vk
@@ -0,0 +1,116 @@
+#ifndef _VKPROGRAMBINARYCACHE_HPP
+#define _VKPROGRAMBINARYCACHE_HPP
+/*-------------------------------------------------------------------------
+ * Vulkan CTS Framework
+ * --------------------
+ *
+ * Copyright (c) 2019 Google Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief In-memory cache of program binaries built in one session.
+ *//*--------------------------------------------------------------------*/
+
+#include "vkDefs.hpp"
+#include "vkPrograms.hpp"
+#include "deMutex.hpp"
+#include "deSharedPtr.hpp"
+
+#include <deque>
+#include <map>
+#include <string>
+
+namespace tcu
+{
+class CommandLine;
+class TestLog;
+}
+
+namespace vk
+{
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Program binary cache
+ *
+ * Front-end to buildProgram() and assembleProgram() that keeps binaries
+ * of successfully built programs in memory, so that programs shared by
+ * several test cases are compiled only once per session. Entries are
+ * keyed by a SHA-1 of the source language, build options, optimization
+ * recipe and sources.
+ *
+ * Each call returns a new binary owned by the caller. On a hit the build
+ * info of the original build is returned with timings set to zero and a
+ * note appended to the program info log.
+ * Failed builds are not cached. Oldest entries are evicted once the
+ * total size of cached binaries exceeds maxCacheSize.
+ *
+ * Build calls can additionally count their hits, misses and evictions
+ * into a caller-owned Statistics, e.g. to report them per test case
+ * while other cases are being built concurrently.
+ *
+ * Cache is thread-safe. Concurrent builds of the same program are not
+ * merged; both are compiled and the first one is kept.
+ *//*--------------------------------------------------------------------*/
+class ProgramBinaryCache
+{
+public:
+	struct Statistics
+	{
+		int							numHits;		//!< Programs returned from cache.
+		int							numMisses;		//!< Programs built from source.
+		int							numEvicted;		//!< Entries dropped to stay within size limit.
+
+		Statistics (void) : numHits(0), numMisses(0), numEvicted(0) {}
+	};
+
+									ProgramBinaryCache		(size_t maxCacheSize = 256u*1024u*1024u);
+									~ProgramBinaryCache		(void);
+
+	// \note Counts of the call are also added to callStats, if not null. Updates are made under the cache lock.
+	ProgramBinary*					buildProgram			(const GlslSource& program, glu::ShaderProgramInfo* buildInfo, const tcu::CommandLine& commandLine, Statistics* callStats = DE_NULL);
+	ProgramBinary*					buildProgram			(const HlslSource& program, glu::ShaderProgramInfo* buildInfo, const tcu::CommandLine& commandLine, Statistics* callStats = DE_NULL);
+	ProgramBinary*					assembleProgram			(const SpirVAsmSource& program, SpirVProgramInfo* buildInfo, const tcu::CommandLine& commandLine, Statistics* callStats = DE_NULL);
+
+	//! Session totals.
+	Statistics						getStatistics			(void) const;
+
+	//! Log statistics, if any program was looked up.
+	static void						logStatistics			(tcu::TestLog& log, const Statistics& stats);
+
+private:
+	struct Entry;
+
+	typedef std::map<std::string, de::SharedPtr<Entry> >	EntryMap;
+
+									ProgramBinaryCache		(const ProgramBinaryCache& other);
+	ProgramBinaryCache&				operator=				(const ProgramBinaryCache& other);
+
+	template<typename SourceType, typename InfoType>
+	ProgramBinary*					getOrBuild				(const std::string& key, const SourceType& program, InfoType* buildInfo, const tcu::CommandLine& commandLine, Statistics* callStats);
+	template<typename InfoType>
+	void							store					(const std::string& key, const ProgramBinary& binary, const InfoType& buildInfo, Statistics* callStats);
+
+	const size_t					m_maxCacheSize;
+
+	mutable de::Mutex				m_lock;
+	EntryMap						m_entries;
+	std::deque<std::string>			m_insertOrder;	//!< Keys of m_entries, oldest first.
+	size_t							m_cacheSize;	//!< Total size of cached binaries in bytes.
+	Statistics						m_stats;
+};
+
+} // vk
+
+#endif // _VKPROGRAMBINARYCACHE_HPP
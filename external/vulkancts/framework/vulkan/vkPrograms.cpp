@@ -31,6 +31,7 @@
 #include "vkShaderToSpirV.hpp"
 #include "vkSpirVAsm.hpp"
 #include "vkRefUtil.hpp"
+#include "vkCompileServer.hpp"
 
 #include "deMutex.hpp"
 #include "deFilePath.hpp"
@@ -535,11 +536,36 @@ void getBuildOptions (std::string& shaderstring, const ShaderBuildOptions& build
 	}
 }
 
-ProgramBinary* buildProgram (const GlslSource& program, glu::ShaderProgramInfo* buildInfo, const tcu::CommandLine& commandLine)
+ProgramBinary* buildProgram (const GlslSource& program, glu::ShaderProgramInfo* buildInfo, int optimizationRecipe)
 {
 	const SpirvVersion	spirvVersion		= program.buildOptions.targetVersion;
 	const bool			validateBinary		= VALIDATE_BINARIES;
 	vector<deUint32>	binary;
+
+	{
+		vector<deUint32> nonStrippedBinary;
+
+		if (!compileGlslToSpirV(program, &nonStrippedBinary, buildInfo))
+			TCU_THROW(InternalError, "Compiling GLSL to SPIR-V failed");
+
+		TCU_CHECK_INTERNAL(!nonStrippedBinary.empty());
+		stripSpirVDebugInfo(nonStrippedBinary.size(), &nonStrippedBinary[0], &binary);
+		TCU_CHECK_INTERNAL(!binary.empty());
+	}
+
+	if (validateBinary)
+	{
+		validateCompiledBinary(binary, buildInfo, program.buildOptions.getSpirvValidatorOptions());
+	}
+
+	if (optimizationRecipe != 0)
+		optimizeCompiledBinary(binary, optimizationRecipe, spirvVersion);
+
+	return createProgramBinaryFromSpirV(binary);
+}
+
+ProgramBinary* buildProgram (const GlslSource& program, glu::ShaderProgramInfo* buildInfo, const tcu::CommandLine& commandLine)
+{
 	std::string			cachekey;
 	std::string			shaderstring;
 	vk::ProgramBinary*	res					= 0;
@@ -591,37 +617,48 @@ ProgramBinary* buildProgram (const GlslSource& program, glu::ShaderProgramInfo*
 
 	if (!res)
 	{
-		{
-			vector<deUint32> nonStrippedBinary;
+		if (commandLine.getCompileServerPort() != 0)
+			res = buildProgramRemote(commandLine.getCompileServerPort(), program, buildInfo, optimizationRecipe);
 
-			if (!compileGlslToSpirV(program, &nonStrippedBinary, buildInfo))
-				TCU_THROW(InternalError, "Compiling GLSL to SPIR-V failed");
-
-			TCU_CHECK_INTERNAL(!nonStrippedBinary.empty());
-			stripSpirVDebugInfo(nonStrippedBinary.size(), &nonStrippedBinary[0], &binary);
-			TCU_CHECK_INTERNAL(!binary.empty());
-		}
-
-		if (validateBinary)
-		{
-			validateCompiledBinary(binary, buildInfo, program.buildOptions.getSpirvValidatorOptions());
-		}
+		if (!res)
+			res = buildProgram(program, buildInfo, optimizationRecipe);
 
-		if (optimizationRecipe != 0)
-			optimizeCompiledBinary(binary, optimizationRecipe, spirvVersion);
-
-		res = createProgramBinaryFromSpirV(binary);
 		if (commandLine.isShadercacheEnabled())
 			shadercacheSave(res, cachekey, commandLine.getShaderCacheFilename());
 	}
 	return res;
 }
 
-ProgramBinary* buildProgram (const HlslSource& program, glu::ShaderProgramInfo* buildInfo, const tcu::CommandLine& commandLine)
+ProgramBinary* buildProgram (const HlslSource& program, glu::ShaderProgramInfo* buildInfo, int optimizationRecipe)
 {
 	const SpirvVersion	spirvVersion		= program.buildOptions.targetVersion;
 	const bool			validateBinary		= VALIDATE_BINARIES;
 	vector<deUint32>	binary;
+
+	{
+		vector<deUint32> nonStrippedBinary;
+
+		if (!compileHlslToSpirV(program, &nonStrippedBinary, buildInfo))
+			TCU_THROW(InternalError, "Compiling HLSL to SPIR-V failed");
+
+		TCU_CHECK_INTERNAL(!nonStrippedBinary.empty());
+		stripSpirVDebugInfo(nonStrippedBinary.size(), &nonStrippedBinary[0], &binary);
+		TCU_CHECK_INTERNAL(!binary.empty());
+	}
+
+	if (validateBinary)
+	{
+		validateCompiledBinary(binary, buildInfo, program.buildOptions.getSpirvValidatorOptions());
+	}
+
+	if (optimizationRecipe != 0)
+		optimizeCompiledBinary(binary, optimizationRecipe, spirvVersion);
+
+	return createProgramBinaryFromSpirV(binary);
+}
+
+ProgramBinary* buildProgram (const HlslSource& program, glu::ShaderProgramInfo* buildInfo, const tcu::CommandLine& commandLine)
+{
 	std::string			cachekey;
 	std::string			shaderstring;
 	vk::ProgramBinary*	res					= 0;
@@ -673,37 +710,49 @@ ProgramBinary* buildProgram (const HlslSource& program, glu::ShaderProgramInfo*
 
 	if (!res)
 	{
-		{
-			vector<deUint32> nonStrippedBinary;
-
-			if (!compileHlslToSpirV(program, &nonStrippedBinary, buildInfo))
-				TCU_THROW(InternalError, "Compiling HLSL to SPIR-V failed");
-
-			TCU_CHECK_INTERNAL(!nonStrippedBinary.empty());
-			stripSpirVDebugInfo(nonStrippedBinary.size(), &nonStrippedBinary[0], &binary);
-			TCU_CHECK_INTERNAL(!binary.empty());
-		}
-
-		if (validateBinary)
-		{
-			validateCompiledBinary(binary, buildInfo, program.buildOptions.getSpirvValidatorOptions());
-		}
+		if (commandLine.getCompileServerPort() != 0)
+			res = buildProgramRemote(commandLine.getCompileServerPort(), program, buildInfo, optimizationRecipe);
 
-		if (optimizationRecipe != 0)
-			optimizeCompiledBinary(binary, optimizationRecipe, spirvVersion);
+		if (!res)
+			res = buildProgram(program, buildInfo, optimizationRecipe);
 
-		res = createProgramBinaryFromSpirV(binary);
 		if (commandLine.isShadercacheEnabled())
 			shadercacheSave(res, cachekey, commandLine.getShaderCacheFilename());
 	}
 	return res;
 }
 
-ProgramBinary* assembleProgram (const SpirVAsmSource& program, SpirVProgramInfo* buildInfo, const tcu::CommandLine& commandLine)
+ProgramBinary* assembleProgram (const SpirVAsmSource& program, SpirVProgramInfo* buildInfo, int optimizationRecipe)
 {
 	const SpirvVersion	spirvVersion		= program.buildOptions.targetVersion;
 	const bool			validateBinary		= VALIDATE_BINARIES;
 	vector<deUint32>	binary;
+
+	if (!assembleSpirV(&program, &binary, buildInfo, spirvVersion))
+		TCU_THROW(InternalError, "Failed to assemble SPIR-V");
+
+	if (validateBinary)
+	{
+		std::ostringstream	validationLog;
+
+		if (!validateSpirV(binary.size(), &binary[0], &validationLog, program.buildOptions.getSpirvValidatorOptions()))
+		{
+			buildInfo->compileOk = false;
+			buildInfo->infoLog += "\n" + validationLog.str();
+
+			TCU_THROW(InternalError, "Validation failed for assembled SPIR-V binary");
+		}
+	}
+
+	if (optimizationRecipe != 0)
+		optimizeCompiledBinary(binary, optimizationRecipe, spirvVersion);
+
+	return createProgramBinaryFromSpirV(binary);
+}
+
+ProgramBinary* assembleProgram (const SpirVAsmSource& program, SpirVProgramInfo* buildInfo, const tcu::CommandLine& commandLine)
+{
+	const SpirvVersion	spirvVersion		= program.buildOptions.targetVersion;
 	vk::ProgramBinary*	res					= 0;
 	std::string			cachekey;
 	const int			optimizationRecipe	= commandLine.isSpirvOptimizationEnabled() ? commandLine.getOptimizationRecipe() : 0;
@@ -737,27 +786,12 @@ ProgramBinary* assembleProgram (const SpirVAsmSource& program, SpirVProgramInfo*
 
 	if (!res)
 	{
+		if (commandLine.getCompileServerPort() != 0)
+			res = assembleProgramRemote(commandLine.getCompileServerPort(), program, buildInfo, optimizationRecipe);
 
-		if (!assembleSpirV(&program, &binary, buildInfo, spirvVersion))
-			TCU_THROW(InternalError, "Failed to assemble SPIR-V");
+		if (!res)
+			res = assembleProgram(program, buildInfo, optimizationRecipe);
 
-		if (validateBinary)
-		{
-			std::ostringstream	validationLog;
-
-			if (!validateSpirV(binary.size(), &binary[0], &validationLog, program.buildOptions.getSpirvValidatorOptions()))
-			{
-				buildInfo->compileOk = false;
-				buildInfo->infoLog += "\n" + validationLog.str();
-
-				TCU_THROW(InternalError, "Validation failed for assembled SPIR-V binary");
-			}
-		}
-
-		if (optimizationRecipe != 0)
-			optimizeCompiledBinary(binary, optimizationRecipe, spirvVersion);
-
-		res = createProgramBinaryFromSpirV(binary);
 		if (commandLine.isShadercacheEnabled())
 			shadercacheSave(res, cachekey, commandLine.getShaderCacheFilename());
 	}
@@ -780,6 +814,21 @@ ProgramBinary* assembleProgram (const SpirVAsmSource&, SpirVProgramInfo*, const
 {
 	TCU_THROW(NotSupportedError, "SPIR-V assembly not supported (DEQP_HAVE_SPIRV_TOOLS not defined)");
 }
+
+ProgramBinary* buildProgram (const GlslSource&, glu::ShaderProgramInfo*, int)
+{
+	TCU_THROW(NotSupportedError, "GLSL to SPIR-V compilation not supported (DEQP_HAVE_GLSLANG not defined)");
+}
+
+ProgramBinary* buildProgram (const HlslSource&, glu::ShaderProgramInfo*, int)
+{
+	TCU_THROW(NotSupportedError, "HLSL to SPIR-V compilation not supported (DEQP_HAVE_GLSLANG not defined)");
+}
+
+ProgramBinary* assembleProgram (const SpirVAsmSource&, SpirVProgramInfo*, int)
+{
+	TCU_THROW(NotSupportedError, "SPIR-V assembly not supported (DEQP_HAVE_SPIRV_TOOLS not defined)");
+}
 #endif
 
 void disassembleProgram (const ProgramBinary& program, std::ostream* dst)
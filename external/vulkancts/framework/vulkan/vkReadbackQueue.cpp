@@ -0,0 +1,314 @@
+/*-------------------------------------------------------------------------
+ * Vulkan CTS Framework
+ * --------------------
+ *
+ * Copyright (c) 2019 Google Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Pipelined image readback through persistent staging buffers.
+ *//*--------------------------------------------------------------------*/
+
+#include "vkReadbackQueue.hpp"
+#include "vkRefUtil.hpp"
+#include "vkCmdUtil.hpp"
+#include "vkImageUtil.hpp"
+#include "vkQueryUtil.hpp"
+#include "vkTypeUtil.hpp"
+#include "tcuScopedTimer.hpp"
+
+namespace vk
+{
+
+namespace
+{
+
+tcu::TextureFormat getCopyFormat (VkFormat format, VkImageAspectFlags aspectMask)
+{
+	if (aspectMask == VK_IMAGE_ASPECT_DEPTH_BIT)
+		return getDepthCopyFormat(format);
+	else if (aspectMask == VK_IMAGE_ASPECT_STENCIL_BIT)
+		return getStencilCopyFormat(format);
+	else
+	{
+		DE_ASSERT(aspectMask == VK_IMAGE_ASPECT_COLOR_BIT);
+		return mapVkFormat(format);
+	}
+}
+
+//! Buffer offset in copies must be a multiple of both texel size and 4.
+VkDeviceSize alignCopyOffset (VkDeviceSize offset, VkDeviceSize pixelSize)
+{
+	VkDeviceSize alignment = pixelSize;
+
+	while (alignment % 4u != 0u)
+		alignment += pixelSize;
+
+	return ((offset + alignment - 1u) / alignment) * alignment;
+}
+
+} // anonymous
+
+ReadbackQueue::ReadbackQueue (const DeviceInterface&	vk,
+							  VkDevice					device,
+							  VkQueue					queue,
+							  deUint32					queueFamilyIndex,
+							  Allocator&				allocator,
+							  VkDeviceSize				stagingBufferSize,
+							  deUint32					numStagingBuffers)
+	: m_vk					(vk)
+	, m_device				(device)
+	, m_queue				(queue)
+	, m_allocator			(allocator)
+	, m_stagingBufferSize	(stagingBufferSize)
+	, m_cmdPool				(createCommandPool(vk, device, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT, queueFamilyIndex))
+	, m_currentSlot			(0u)
+	, m_nextSlotId			(1u)
+{
+	DE_ASSERT(numStagingBuffers > 0u);
+
+	for (deUint32 slotNdx = 0; slotNdx < numStagingBuffers; slotNdx++)
+		m_slots.push_back(de::SharedPtr<Slot>(new Slot()));
+
+	// First enqueue() moves to slot 0.
+	m_currentSlot = numStagingBuffers - 1u;
+}
+
+ReadbackQueue::~ReadbackQueue (void)
+{
+	// Staging buffers must not be destroyed while copies into them are still executing.
+	for (size_t slotNdx = 0; slotNdx < m_slots.size(); slotNdx++)
+	{
+		if (m_slots[slotNdx]->state == SLOTSTATE_PENDING)
+			m_vk.waitForFences(m_device, 1u, &m_slots[slotNdx]->fence.get(), VK_TRUE, ~0ull);
+	}
+}
+
+ReadbackQueue::Slot& ReadbackQueue::getSlot (const Request& request) const
+{
+	DE_ASSERT(request.slotNdx < (deUint32)m_slots.size());
+
+	Slot& slot = *m_slots[request.slotNdx];
+
+	if (slot.id != request.slotId)
+		throw tcu::InternalError("Readback staging buffer has already been reused");
+
+	return slot;
+}
+
+void ReadbackQueue::waitSlot (Slot& slot)
+{
+	if (slot.state == SLOTSTATE_PENDING)
+	{
+		VK_CHECK(m_vk.waitForFences(m_device, 1u, &slot.fence.get(), VK_TRUE, ~0ull));
+		invalidateAlloc(m_vk, m_device, *slot.bufferAlloc);
+
+		slot.state = SLOTSTATE_COMPLETE;
+	}
+}
+
+void ReadbackQueue::beginSlot (Slot& slot, VkDeviceSize minSize)
+{
+	DE_ASSERT(slot.state != SLOTSTATE_RECORDING);
+
+	waitSlot(slot);
+
+	// Buffers grown for large copies are shrunk back once they are no longer needed.
+	if (slot.bufferSize < minSize || (slot.bufferSize > m_stagingBufferSize && minSize <= m_stagingBufferSize))
+	{
+		const VkDeviceSize			bufferSize		= de::max(m_stagingBufferSize, minSize);
+		const VkBufferCreateInfo	bufferParams	=
+		{
+			VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,		// VkStructureType		sType;
+			DE_NULL,									// const void*			pNext;
+			0u,											// VkBufferCreateFlags	flags;
+			bufferSize,									// VkDeviceSize			size;
+			VK_BUFFER_USAGE_TRANSFER_DST_BIT,			// VkBufferUsageFlags	usage;
+			VK_SHARING_MODE_EXCLUSIVE,					// VkSharingMode		sharingMode;
+			0u,											// deUint32				queueFamilyIndexCount;
+			DE_NULL										// const deUint32*		pQueueFamilyIndices;
+		};
+
+		slot.buffer			= Move<VkBuffer>();
+		slot.bufferAlloc.clear();
+		slot.bufferSize		= 0u;
+
+		slot.buffer			= createBuffer(m_vk, m_device, &bufferParams);
+		slot.bufferAlloc	= m_allocator.allocate(getBufferMemoryRequirements(m_vk, m_device, *slot.buffer), MemoryRequirement::HostVisible);
+		VK_CHECK(m_vk.bindBufferMemory(m_device, *slot.buffer, slot.bufferAlloc->getMemory(), slot.bufferAlloc->getOffset()));
+		slot.bufferSize		= bufferSize;
+	}
+
+	if (!slot.cmdBuffer)
+	{
+		slot.cmdBuffer	= allocateCommandBuffer(m_vk, m_device, *m_cmdPool, VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+		slot.fence		= createFence(m_vk, m_device);
+	}
+	else if (slot.state == SLOTSTATE_COMPLETE)
+		VK_CHECK(m_vk.resetFences(m_device, 1u, &slot.fence.get()));
+
+	beginCommandBuffer(m_vk, *slot.cmdBuffer);
+
+	slot.used	= 0u;
+	slot.state	= SLOTSTATE_RECORDING;
+	slot.id		= m_nextSlotId++;
+}
+
+ReadbackQueue::Request ReadbackQueue::enqueue (VkImage							image,
+											   VkFormat							format,
+											   const VkExtent3D&				extent,
+											   const VkImageSubresourceLayers&	subresource,
+											   VkImageLayout					oldLayout,
+											   VkAccessFlags					srcAccessMask)
+{
+	DE_ASSERT(!isCompressedFormat(format));
+
+	const tcu::TextureFormat	copyFormat	= getCopyFormat(format, subresource.aspectMask);
+	const VkDeviceSize			pixelSize	= (VkDeviceSize)copyFormat.getPixelSize();
+	const tcu::IVec3			size		((int)extent.width, (int)extent.height, (int)(extent.depth * subresource.layerCount));
+	const VkDeviceSize			dataSize	= pixelSize * (VkDeviceSize)size.x() * (VkDeviceSize)size.y() * (VkDeviceSize)size.z();
+	VkDeviceSize				offset		= alignCopyOffset(m_slots[m_currentSlot]->used, pixelSize);
+
+	if (m_slots[m_currentSlot]->state != SLOTSTATE_RECORDING || offset + dataSize > m_slots[m_currentSlot]->bufferSize)
+	{
+		flush();
+
+		m_currentSlot = (m_currentSlot + 1u) % (deUint32)m_slots.size();
+		beginSlot(*m_slots[m_currentSlot], dataSize);
+		offset = 0u;
+	}
+
+	{
+		Slot&						slot			= *m_slots[m_currentSlot];
+		const VkImageMemoryBarrier	imageBarrier	=
+		{
+			VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,		// VkStructureType			sType;
+			DE_NULL,									// const void*				pNext;
+			srcAccessMask,								// VkAccessFlags			srcAccessMask;
+			VK_ACCESS_TRANSFER_READ_BIT,				// VkAccessFlags			dstAccessMask;
+			oldLayout,									// VkImageLayout			oldLayout;
+			VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,		// VkImageLayout			newLayout;
+			VK_QUEUE_FAMILY_IGNORED,					// deUint32					srcQueueFamilyIndex;
+			VK_QUEUE_FAMILY_IGNORED,					// deUint32					destQueueFamilyIndex;
+			image,										// VkImage					image;
+			makeImageSubresourceRange(subresource.aspectMask, subresource.mipLevel, 1u, subresource.baseArrayLayer, subresource.layerCount)	// VkImageSubresourceRange	subresourceRange;
+		};
+		const VkBufferImageCopy		region			=
+		{
+			offset,										// VkDeviceSize					bufferOffset;
+			0u,											// deUint32						bufferRowLength;
+			0u,											// deUint32						bufferImageHeight;
+			subresource,								// VkImageSubresourceLayers		imageSubresource;
+			makeOffset3D(0, 0, 0),						// VkOffset3D					imageOffset;
+			extent										// VkExtent3D					imageExtent;
+		};
+		Request						request;
+
+		m_vk.cmdPipelineBarrier(*slot.cmdBuffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0u,
+								0u, DE_NULL, 0u, DE_NULL, 1u, &imageBarrier);
+		m_vk.cmdCopyImageToBuffer(*slot.cmdBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, *slot.buffer, 1u, &region);
+
+		slot.used			= offset + dataSize;
+
+		request.slotNdx		= m_currentSlot;
+		request.slotId		= slot.id;
+		request.offset		= offset;
+		request.format		= copyFormat;
+		request.size		= size;
+
+		return request;
+	}
+}
+
+void ReadbackQueue::flush (void)
+{
+	Slot& slot = *m_slots[m_currentSlot];
+
+	if (slot.state != SLOTSTATE_RECORDING)
+		return;
+
+	{
+		const VkBufferMemoryBarrier	bufferBarrier	=
+		{
+			VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,	// VkStructureType	sType;
+			DE_NULL,									// const void*		pNext;
+			VK_ACCESS_TRANSFER_WRITE_BIT,				// VkAccessFlags	srcAccessMask;
+			VK_ACCESS_HOST_READ_BIT,					// VkAccessFlags	dstAccessMask;
+			VK_QUEUE_FAMILY_IGNORED,					// deUint32			srcQueueFamilyIndex;
+			VK_QUEUE_FAMILY_IGNORED,					// deUint32			dstQueueFamilyIndex;
+			*slot.buffer,								// VkBuffer			buffer;
+			0ull,										// VkDeviceSize		offset;
+			VK_WHOLE_SIZE								// VkDeviceSize		size;
+		};
+		const VkSubmitInfo			submitInfo		=
+		{
+			VK_STRUCTURE_TYPE_SUBMIT_INFO,				// VkStructureType				sType;
+			DE_NULL,									// const void*					pNext;
+			0u,											// deUint32						waitSemaphoreCount;
+			DE_NULL,									// const VkSemaphore*			pWaitSemaphores;
+			DE_NULL,									// const VkPipelineStageFlags*	pWaitDstStageMask;
+			1u,											// deUint32						commandBufferCount;
+			&slot.cmdBuffer.get(),						// const VkCommandBuffer*		pCommandBuffers;
+			0u,											// deUint32						signalSemaphoreCount;
+			DE_NULL										// const VkSemaphore*			pSignalSemaphores;
+		};
+
+		m_vk.cmdPipelineBarrier(*slot.cmdBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0u,
+								0u, DE_NULL, 1u, &bufferBarrier, 0u, DE_NULL);
+		endCommandBuffer(m_vk, *slot.cmdBuffer);
+
+		VK_CHECK(m_vk.queueSubmit(m_queue, 1u, &submitInfo, *slot.fence));
+		slot.state = SLOTSTATE_PENDING;
+	}
+}
+
+bool ReadbackQueue::isReady (const Request& request) const
+{
+	const Slot& slot = getSlot(request);
+
+	if (slot.state == SLOTSTATE_PENDING)
+		return m_vk.getFenceStatus(m_device, *slot.fence) == VK_SUCCESS;
+	else
+		return slot.state == SLOTSTATE_COMPLETE;
+}
+
+tcu::ConstPixelBufferAccess ReadbackQueue::wait (const Request& request)
+{
+	const tcu::ScopedTimer	timer	("vk::ReadbackQueue::wait");
+	Slot&					slot	= getSlot(request);
+
+	if (slot.state == SLOTSTATE_RECORDING)
+		flush();
+
+	waitSlot(slot);
+
+	return tcu::ConstPixelBufferAccess(request.format, request.size, (const deUint8*)slot.bufferAlloc->getHostPtr() + request.offset);
+}
+
+void ReadbackQueue::release (void)
+{
+	for (size_t slotNdx = 0; slotNdx < m_slots.size(); slotNdx++)
+	{
+		if (m_slots[slotNdx]->state == SLOTSTATE_PENDING)
+			VK_CHECK(m_vk.waitForFences(m_device, 1u, &m_slots[slotNdx]->fence.get(), VK_TRUE, ~0ull));
+
+		// Slot ids are never reused, so requests to released slots are rejected by getSlot().
+		m_slots[slotNdx] = de::SharedPtr<Slot>(new Slot());
+	}
+
+	m_currentSlot = (deUint32)m_slots.size() - 1u;
+}
+
+} // vk
@@ -0,0 +1,145 @@
+#ifndef _VKREADBACKQUEUE_HPP
+#define _VKREADBACKQUEUE_HPP
+/*-------------------------------------------------------------------------
+ * Vulkan CTS Framework
+ * --------------------
+ *
+ * Copyright (c) 2019 Google Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Pipelined image readback through persistent staging buffers.
+ *//*--------------------------------------------------------------------*/
+
+#include "vkDefs.hpp"
+#include "vkRef.hpp"
+#include "vkMemUtil.hpp"
+#include "tcuTexture.hpp"
+#include "deSharedPtr.hpp"
+
+#include <vector>
+
+namespace vk
+{
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Queue of image to host copies
+ *
+ * Copies are recorded into a ring of host-visible staging buffers. A
+ * staging buffer is submitted once it is full or when flush() or wait()
+ * is called, so copies into other staging buffers can still be in flight
+ * while the host verifies results from the first one.
+ *
+ * wait() returns a view directly into staging memory. The view stays
+ * valid until the same staging buffer is reused, i.e. until
+ * numStagingBuffers further staging buffers have been filled or until
+ * release() is called. Data needed longer must be copied out by the
+ * caller.
+ *
+ * Each copy transitions the source subresource to
+ * VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, and copies are synchronized
+ * against all commands submitted earlier to the same queue. Queue is not
+ * thread-safe.
+ *//*--------------------------------------------------------------------*/
+class ReadbackQueue
+{
+public:
+	struct Request
+	{
+		Request (void) : slotNdx(0u), slotId(0u), offset(0u) {}
+
+		deUint32				slotNdx;
+		deUint64				slotId;
+		VkDeviceSize			offset;
+		tcu::TextureFormat		format;
+		tcu::IVec3				size;			//!< Layers are stacked in depth
+	};
+
+										ReadbackQueue		(const DeviceInterface&				vk,
+															 VkDevice							device,
+															 VkQueue							queue,
+															 deUint32							queueFamilyIndex,
+															 Allocator&							allocator,
+															 VkDeviceSize						stagingBufferSize	= 4u * 1024u * 1024u,
+															 deUint32							numStagingBuffers	= 3u);
+										~ReadbackQueue		(void);
+
+	//! Record copy of image subresource. Format of result is determined by format and aspect as with buffer copies.
+	Request								enqueue				(VkImage							image,
+															 VkFormat							format,
+															 const VkExtent3D&					extent,
+															 const VkImageSubresourceLayers&	subresource,
+															 VkImageLayout						oldLayout		= VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+															 VkAccessFlags						srcAccessMask	= VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT);
+
+	//! Submit copies recorded so far.
+	void								flush				(void);
+
+	//! Check if copy has completed without blocking. Copies that have not been flushed are never ready.
+	bool								isReady				(const Request& request) const;
+
+	//! Wait for copy and return view into staging memory.
+	tcu::ConstPixelBufferAccess			wait				(const Request& request);
+
+	//! Wait for pending copies and free staging buffers. Outstanding requests become invalid.
+	void								release				(void);
+
+private:
+										ReadbackQueue		(const ReadbackQueue&);
+	ReadbackQueue&						operator=			(const ReadbackQueue&);
+
+	enum SlotState
+	{
+		SLOTSTATE_IDLE = 0,
+		SLOTSTATE_RECORDING,
+		SLOTSTATE_PENDING,
+		SLOTSTATE_COMPLETE,
+
+		SLOTSTATE_LAST
+	};
+
+	struct Slot
+	{
+		Slot (void) : bufferSize(0u), used(0u), state(SLOTSTATE_IDLE), id(0u) {}
+
+		Move<VkBuffer>					buffer;
+		de::MovePtr<Allocation>			bufferAlloc;
+		VkDeviceSize					bufferSize;
+		Move<VkCommandBuffer>			cmdBuffer;
+		Move<VkFence>					fence;
+		VkDeviceSize					used;
+		SlotState						state;
+		deUint64						id;
+	};
+
+	Slot&								getSlot				(const Request& request) const;
+	void								beginSlot			(Slot& slot, VkDeviceSize minSize);
+	void								waitSlot			(Slot& slot);
+
+	const DeviceInterface&				m_vk;
+	const VkDevice						m_device;
+	const VkQueue						m_queue;
+	Allocator&							m_allocator;
+	const VkDeviceSize					m_stagingBufferSize;
+	const Unique<VkCommandPool>			m_cmdPool;
+
+	std::vector<de::SharedPtr<Slot> >	m_slots;
+	deUint32							m_currentSlot;
+	deUint64							m_nextSlotId;
+};
+
+} // vk
+
+#endif // _VKREADBACKQUEUE_HPP
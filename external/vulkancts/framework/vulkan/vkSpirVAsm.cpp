@@ -24,8 +24,10 @@
 #include "vkSpirVAsm.hpp"
 #include "vkSpirVProgram.hpp"
 #include "deClock.h"
+#include "deMutex.hpp"
 
 #include <algorithm>
+#include <map>
 
 #if defined(DEQP_HAVE_SPIRV_TOOLS)
 #	include "spirv-tools/libspirv.h"
@@ -69,14 +71,35 @@ static spv_target_env mapTargetSpvEnvironment(SpirvVersion spirvVersion)
 	return result;
 }
 
-bool assembleSpirV (const SpirVAsmSource* program, std::vector<deUint32>* dst, SpirVProgramInfo* buildInfo, SpirvVersion spirvVersion)
+// Contexts are immutable once created, so one context per target environment is shared
+// by all threads. \note Contexts are never destroyed; they live until the process exits.
+static spv_const_context getSpirvToolsContext (spv_target_env targetEnv)
 {
-	const spv_context	context		= spvContextCreate(mapTargetSpvEnvironment(spirvVersion));
-	spv_binary			binary		= DE_NULL;
-	spv_diagnostic		diagnostic	= DE_NULL;
+	static de::Mutex							s_contextLock;
+	static std::map<spv_target_env, spv_context>	s_contexts;
+
+	const de::ScopedLock						lock		(s_contextLock);
+	std::map<spv_target_env, spv_context>::iterator	existing	= s_contexts.find(targetEnv);
+
+	if (existing != s_contexts.end())
+		return existing->second;
+
+	{
+		const spv_context context = spvContextCreate(targetEnv);
+
+		if (!context)
+			throw std::bad_alloc();
 
-	if (!context)
-		throw std::bad_alloc();
+		s_contexts[targetEnv] = context;
+		return context;
+	}
+}
+
+bool assembleSpirV (const SpirVAsmSource* program, std::vector<deUint32>* dst, SpirVProgramInfo* buildInfo, SpirvVersion spirvVersion)
+{
+	const spv_const_context	context		= getSpirvToolsContext(mapTargetSpvEnvironment(spirvVersion));
+	spv_binary				binary		= DE_NULL;
+	spv_diagnostic			diagnostic	= DE_NULL;
 
 	try
 	{
@@ -98,7 +121,6 @@ bool assembleSpirV (const SpirVAsmSource* program, std::vector<deUint32>* dst, S
 
 		spvBinaryDestroy(binary);
 		spvDiagnosticDestroy(diagnostic);
-		spvContextDestroy(context);
 
 		return compileOk == SPV_SUCCESS;
 	}
@@ -106,7 +128,6 @@ bool assembleSpirV (const SpirVAsmSource* program, std::vector<deUint32>* dst, S
 	{
 		spvBinaryDestroy(binary);
 		spvDiagnosticDestroy(diagnostic);
-		spvContextDestroy(context);
 
 		throw;
 	}
@@ -114,12 +135,9 @@ bool assembleSpirV (const SpirVAsmSource* program, std::vector<deUint32>* dst, S
 
 void disassembleSpirV (size_t binarySizeInWords, const deUint32* binary, std::ostream* dst, SpirvVersion spirvVersion)
 {
-	const spv_context	context		= spvContextCreate(mapTargetSpvEnvironment(spirvVersion));
-	spv_text			text		= DE_NULL;
-	spv_diagnostic		diagnostic	= DE_NULL;
-
-	if (!context)
-		throw std::bad_alloc();
+	const spv_const_context	context		= getSpirvToolsContext(mapTargetSpvEnvironment(spirvVersion));
+	spv_text				text		= DE_NULL;
+	spv_diagnostic			diagnostic	= DE_NULL;
 
 	try
 	{
@@ -132,13 +150,11 @@ void disassembleSpirV (size_t binarySizeInWords, const deUint32* binary, std::os
 
 		spvTextDestroy(text);
 		spvDiagnosticDestroy(diagnostic);
-		spvContextDestroy(context);
 	}
 	catch (...)
 	{
 		spvTextDestroy(text);
 		spvDiagnosticDestroy(diagnostic);
-		spvContextDestroy(context);
 
 		throw;
 	}
@@ -146,8 +162,8 @@ void disassembleSpirV (size_t binarySizeInWords, const deUint32* binary, std::os
 
 bool validateSpirV (size_t binarySizeInWords, const deUint32* binary, std::ostream* infoLog, const SpirvValidatorOptions &val_options)
 {
-	const spv_context	context		= spvContextCreate(mapVulkanVersionToSpirvToolsEnv(val_options.vulkanVersion));
-	spv_diagnostic		diagnostic	= DE_NULL;
+	const spv_const_context	context		= getSpirvToolsContext(mapVulkanVersionToSpirvToolsEnv(val_options.vulkanVersion));
+	spv_diagnostic			diagnostic	= DE_NULL;
 
 	try
 	{
@@ -189,14 +205,12 @@ bool validateSpirV (size_t binarySizeInWords, const deUint32* binary, std::ostre
 
 		spvValidatorOptionsDestroy(options);
 		spvDiagnosticDestroy(diagnostic);
-		spvContextDestroy(context);
 
 		return passed;
 	}
 	catch (...)
 	{
 		spvDiagnosticDestroy(diagnostic);
-		spvContextDestroy(context);
 
 		throw;
 	}
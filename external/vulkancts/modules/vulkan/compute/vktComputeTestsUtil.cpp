@@ -24,6 +24,7 @@
 #include "vktComputeTestsUtil.hpp"
 #include "vkQueryUtil.hpp"
 #include "vkTypeUtil.hpp"
+#include "vkPipelineCacheUtil.hpp"
 
 using namespace vk;
 
@@ -158,7 +159,7 @@ Move<VkPipeline> makeComputePipeline (const DeviceInterface&					vk,
 		DE_NULL,											// VkPipeline						basePipelineHandle;
 		0,													// deInt32							basePipelineIndex;
 	};
-	return createComputePipeline(vk, device, DE_NULL , &pipelineCreateInfo);
+	return createComputePipeline(vk, device, getDefaultPipelineCache(device), &pipelineCreateInfo);
 }
 
 Move<VkPipeline> makeComputePipeline (const DeviceInterface&	vk,
@@ -299,7 +299,6 @@ tcu::TestStatus DrawTestInstance::iterate (void)
 			const VkRect2D				renderArea			= makeRect2D(WIDTH, HEIGHT);
 			const VkDeviceSize			vertexBufferOffset	= 0;
 			const VkBuffer				buffer				= vertexBuffer->object();
-			const VkOffset3D			zeroOffset			= { 0, 0, 0 };
 
 			beginCommandBuffer(vk, *cmdBuffer, 0u);
 
@@ -321,11 +320,19 @@ tcu::TestStatus DrawTestInstance::iterate (void)
 			endCommandBuffer(vk, *cmdBuffer);
 
 			submitCommandsAndWait(vk, device, queue, cmdBuffer.get());
-
-			frames[frameIdx] = colorTargetImages[frameIdx]->readSurface(queue, m_context.getDefaultAllocator(), VK_IMAGE_LAYOUT_GENERAL, zeroOffset, WIDTH, HEIGHT, VK_IMAGE_ASPECT_COLOR_BIT);
 		}
 	}
 
+	// Read back both frames with a single submission.
+	{
+		const VkOffset3D							zeroOffset	= { 0, 0, 0 };
+		const vector<de::SharedPtr<Image> >			images		(colorTargetImages, colorTargetImages + DE_LENGTH_OF_ARRAY(colorTargetImages));
+		const vector<tcu::ConstPixelBufferAccess>	results		= Image::readSurfaces(images, m_context.getUniversalQueue(), m_context.getDefaultAllocator(), VK_IMAGE_LAYOUT_GENERAL, zeroOffset, WIDTH, HEIGHT, VK_IMAGE_ASPECT_COLOR_BIT);
+
+		for (deUint32 frameIdx = 0; frameIdx < DE_LENGTH_OF_ARRAY(frames); frameIdx++)
+			frames[frameIdx] = results[frameIdx];
+	}
+
 	qpTestResult res = QP_TEST_RESULT_PASS;
 
 	if (!tcu::intThresholdCompare(log, "Result", "Image comparison result", frames[0], frames[1], tcu::UVec4(0), tcu::COMPARE_LOG_RESULT))
@@ -274,91 +274,161 @@ void Image::readUsingBuffer (vk::VkQueue				queue,
 
 	de::SharedPtr<Buffer> stagingResource;
 
-	bool isCombinedType = isCombinedDepthStencilType(vk::mapVkFormat(m_format).type);
-	vk::VkDeviceSize bufferSize = 0;
+	{
+		vk::PooledCommandBuffer copyCmdBuffer(m_vk, m_device, queue, m_queueFamilyIndex);
+
+		stagingResource = recordCopyToBuffer(*copyCmdBuffer, allocator, layout, offset, width, height, depth, mipLevel, arrayElement, aspect);
+		copyCmdBuffer.submitAndWait();
+	}
+
+	// Validate the results
+	const vk::Allocation& bufAllocation = stagingResource->getBoundMemory();
+	invalidateMappedMemoryRange(m_vk, m_device, bufAllocation.getMemory(), bufAllocation.getOffset(), VK_WHOLE_SIZE);
+
+	deUint8* destPtr = reinterpret_cast<deUint8*>(stagingResource->getBoundMemory().getHostPtr());
+	deMemcpy(data, destPtr, static_cast<size_t>(getBufferCopySize(width, height, depth, aspect)));
+}
+
+std::vector<tcu::ConstPixelBufferAccess> Image::readSurfaces (const std::vector<de::SharedPtr<Image> >&	images,
+															  vk::VkQueue								queue,
+															  vk::Allocator&							allocator,
+															  vk::VkImageLayout							layout,
+															  vk::VkOffset3D							offset,
+															  int										width,
+															  int										height,
+															  vk::VkImageAspectFlagBits					aspect,
+															  unsigned int								mipLevel,
+															  unsigned int								arrayElement)
+{
+	DE_ASSERT(!images.empty());
+	DE_ASSERT(layout == vk::VK_IMAGE_LAYOUT_GENERAL || layout == vk::VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
 
-	if (!isCombinedType)
-		bufferSize = vk::mapVkFormat(m_format).getPixelSize() * width * height * depth;
+	const vk::DeviceInterface&					vk				= images[0]->m_vk;
+	const vk::VkDevice							device			= images[0]->m_device;
+	const bool									isColor			= (aspect == vk::VK_IMAGE_ASPECT_COLOR_BIT);
+	const vk::VkOffset3D						zeroOffset		= { 0, 0, 0 };
+	std::vector<de::SharedPtr<Image> >			stagingImages	(images.size());
+	std::vector<de::SharedPtr<Buffer> >			stagingBuffers	(images.size());
+	std::vector<tcu::ConstPixelBufferAccess>	results;
 
-	if (isCombinedType)
+	// Record one copy per image and wait for all of them at once.
 	{
-		int pixelSize = 0;
-		switch (m_format)
+		vk::SubmissionBatch batch(vk, device, queue, images[0]->m_queueFamilyIndex);
+
+		for (size_t ndx = 0; ndx < images.size(); ++ndx)
 		{
-			case vk::VK_FORMAT_D16_UNORM_S8_UINT:
-				pixelSize = (aspect == vk::VK_IMAGE_ASPECT_DEPTH_BIT) ? 2 : 1;
-				break;
-			case  vk::VK_FORMAT_D32_SFLOAT_S8_UINT:
-				pixelSize = (aspect == vk::VK_IMAGE_ASPECT_DEPTH_BIT) ? 4 : 1;
-				break;
-			case vk::VK_FORMAT_X8_D24_UNORM_PACK32:
-			case vk::VK_FORMAT_D24_UNORM_S8_UINT:
-				pixelSize = (aspect == vk::VK_IMAGE_ASPECT_DEPTH_BIT) ? 3 : 1;
-				break;
-
-			default:
-				DE_FATAL("Not implemented");
+			DE_ASSERT(&images[ndx]->m_vk == &vk && images[ndx]->m_device == device);
+
+			if (isColor)
+				stagingImages[ndx] = images[ndx]->recordCopyToLinearImage(batch.record(), allocator, layout, offset, width, height, 1, mipLevel, arrayElement, aspect, vk::VK_IMAGE_TYPE_2D);
+			else
+				stagingBuffers[ndx] = images[ndx]->recordCopyToBuffer(batch.record(), allocator, layout, offset, width, height, 1, mipLevel, arrayElement, aspect);
 		}
-		bufferSize = pixelSize*width*height*depth;
-	}
 
-	BufferCreateInfo stagingBufferResourceCreateInfo(bufferSize, vk::VK_BUFFER_USAGE_TRANSFER_DST_BIT | vk::VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
-	stagingResource = Buffer::createAndAlloc(m_vk, m_device, stagingBufferResourceCreateInfo, allocator, vk::MemoryRequirement::HostVisible);
+		batch.submitAndWait();
+	}
 
+	for (size_t ndx = 0; ndx < images.size(); ++ndx)
 	{
-		CmdPoolCreateInfo copyCmdPoolCreateInfo(m_queueFamilyIndex);
-		vk::Unique<vk::VkCommandPool> copyCmdPool(vk::createCommandPool(m_vk, m_device, &copyCmdPoolCreateInfo));
-		vk::Unique<vk::VkCommandBuffer> copyCmdBuffer(vk::allocateCommandBuffer(m_vk, m_device, *copyCmdPool, vk::VK_COMMAND_BUFFER_LEVEL_PRIMARY));
+		Image&					image		= *images[ndx];
+		const vk::Allocation&	allocation	= isColor ? stagingImages[ndx]->getBoundMemory() : stagingBuffers[ndx]->getBoundMemory();
 
-		beginCommandBuffer(m_vk, *copyCmdBuffer);
+		image.m_pixelAccessData.resize(width * height * vk::mapVkFormat(image.m_format).getPixelSize());
+		deMemset(image.m_pixelAccessData.data(), 0, image.m_pixelAccessData.size());
 
-		if (layout == vk::VK_IMAGE_LAYOUT_UNDEFINED)
-		{
-			layout = vk::VK_IMAGE_LAYOUT_GENERAL;
+		invalidateMappedMemoryRange(vk, device, allocation.getMemory(), allocation.getOffset(), VK_WHOLE_SIZE);
 
-			vk::VkImageMemoryBarrier barrier;
-			barrier.sType = vk::VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-			barrier.pNext = DE_NULL;
-			barrier.srcAccessMask = 0;
-			barrier.dstAccessMask = 0;
-			barrier.oldLayout = vk::VK_IMAGE_LAYOUT_UNDEFINED;
-			barrier.newLayout = vk::VK_IMAGE_LAYOUT_GENERAL;
-			barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-			barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-			barrier.image = object();
+		if (isColor)
+			stagingImages[ndx]->readLinear(zeroOffset, width, height, 1, 0, 0, aspect, image.m_pixelAccessData.data());
+		else
+			deMemcpy(image.m_pixelAccessData.data(), allocation.getHostPtr(), static_cast<size_t>(image.getBufferCopySize(width, height, 1, aspect)));
 
-			barrier.subresourceRange.aspectMask = aspect;
-			barrier.subresourceRange.baseMipLevel = 0;
-			barrier.subresourceRange.levelCount = m_levelCount;
-			barrier.subresourceRange.baseArrayLayer = 0;
-			barrier.subresourceRange.layerCount = m_layerCount;
+		results.push_back(tcu::ConstPixelBufferAccess(vk::mapVkFormat(image.m_format), width, height, 1, image.m_pixelAccessData.data()));
+	}
 
-			m_vk.cmdPipelineBarrier(*copyCmdBuffer, vk::VK_PIPELINE_STAGE_ALL_GRAPHICS_BIT, vk::VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, (vk::VkDependencyFlags)0,
-									0, (const vk::VkMemoryBarrier*)DE_NULL,
-									0, (const vk::VkBufferMemoryBarrier*)DE_NULL,
-									1, &barrier);
-		}
+	return results;
+}
 
-		vk::VkBufferImageCopy region =
-		{
-			0, 0, 0,
-			{ (vk::VkImageAspectFlags)aspect, mipLevel, arrayElement, 1 },
-			offset,
-			{ (deUint32)width, (deUint32)height, (deUint32)depth }
-		};
+vk::VkDeviceSize Image::getBufferCopySize (int							width,
+										   int							height,
+										   int							depth,
+										   vk::VkImageAspectFlagBits	aspect) const
+{
+	if (!isCombinedDepthStencilType(vk::mapVkFormat(m_format).type))
+		return vk::mapVkFormat(m_format).getPixelSize() * width * height * depth;
+
+	int pixelSize = 0;
+	switch (m_format)
+	{
+		case vk::VK_FORMAT_D16_UNORM_S8_UINT:
+			pixelSize = (aspect == vk::VK_IMAGE_ASPECT_DEPTH_BIT) ? 2 : 1;
+			break;
+		case  vk::VK_FORMAT_D32_SFLOAT_S8_UINT:
+			pixelSize = (aspect == vk::VK_IMAGE_ASPECT_DEPTH_BIT) ? 4 : 1;
+			break;
+		case vk::VK_FORMAT_X8_D24_UNORM_PACK32:
+		case vk::VK_FORMAT_D24_UNORM_S8_UINT:
+			pixelSize = (aspect == vk::VK_IMAGE_ASPECT_DEPTH_BIT) ? 3 : 1;
+			break;
+
+		default:
+			DE_FATAL("Not implemented");
+	}
+	return pixelSize*width*height*depth;
+}
 
-		m_vk.cmdCopyImageToBuffer(*copyCmdBuffer, object(), layout, stagingResource->object(), 1, &region);
-		endCommandBuffer(m_vk, *copyCmdBuffer);
+de::SharedPtr<Buffer> Image::recordCopyToBuffer (vk::VkCommandBuffer			cmdBuffer,
+												 vk::Allocator&					allocator,
+												 vk::VkImageLayout				layout,
+												 vk::VkOffset3D					offset,
+												 int							width,
+												 int							height,
+												 int							depth,
+												 unsigned int					mipLevel,
+												 unsigned int					arrayElement,
+												 vk::VkImageAspectFlagBits		aspect)
+{
+	BufferCreateInfo		stagingBufferResourceCreateInfo	(getBufferCopySize(width, height, depth, aspect), vk::VK_BUFFER_USAGE_TRANSFER_DST_BIT | vk::VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+	de::SharedPtr<Buffer>	stagingResource					= Buffer::createAndAlloc(m_vk, m_device, stagingBufferResourceCreateInfo, allocator, vk::MemoryRequirement::HostVisible);
 
-		submitCommandsAndWait(m_vk, m_device, queue, copyCmdBuffer.get());
+	if (layout == vk::VK_IMAGE_LAYOUT_UNDEFINED)
+	{
+		layout = vk::VK_IMAGE_LAYOUT_GENERAL;
+
+		vk::VkImageMemoryBarrier barrier;
+		barrier.sType = vk::VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+		barrier.pNext = DE_NULL;
+		barrier.srcAccessMask = 0;
+		barrier.dstAccessMask = 0;
+		barrier.oldLayout = vk::VK_IMAGE_LAYOUT_UNDEFINED;
+		barrier.newLayout = vk::VK_IMAGE_LAYOUT_GENERAL;
+		barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.image = object();
+
+		barrier.subresourceRange.aspectMask = aspect;
+		barrier.subresourceRange.baseMipLevel = 0;
+		barrier.subresourceRange.levelCount = m_levelCount;
+		barrier.subresourceRange.baseArrayLayer = 0;
+		barrier.subresourceRange.layerCount = m_layerCount;
+
+		m_vk.cmdPipelineBarrier(cmdBuffer, vk::VK_PIPELINE_STAGE_ALL_GRAPHICS_BIT, vk::VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, (vk::VkDependencyFlags)0,
+								0, (const vk::VkMemoryBarrier*)DE_NULL,
+								0, (const vk::VkBufferMemoryBarrier*)DE_NULL,
+								1, &barrier);
 	}
 
-	// Validate the results
-	const vk::Allocation& bufAllocation = stagingResource->getBoundMemory();
-	invalidateMappedMemoryRange(m_vk, m_device, bufAllocation.getMemory(), bufAllocation.getOffset(), VK_WHOLE_SIZE);
+	vk::VkBufferImageCopy region =
+	{
+		0, 0, 0,
+		{ (vk::VkImageAspectFlags)aspect, mipLevel, arrayElement, 1 },
+		offset,
+		{ (deUint32)width, (deUint32)height, (deUint32)depth }
+	};
 
-	deUint8* destPtr = reinterpret_cast<deUint8*>(stagingResource->getBoundMemory().getHostPtr());
-	deMemcpy(data, destPtr, static_cast<size_t>(bufferSize));
+	m_vk.cmdCopyImageToBuffer(cmdBuffer, object(), layout, stagingResource->object(), 1, &region);
+
+	return stagingResource;
 }
 
 tcu::ConstPixelBufferAccess Image::readSurfaceLinear (vk::VkOffset3D				offset,
@@ -417,34 +487,45 @@ de::SharedPtr<Image> Image::copyToLinearImage (vk::VkQueue					queue,
 {
 	de::SharedPtr<Image> stagingResource;
 	{
-		vk::VkExtent3D stagingExtent = {(deUint32)width, (deUint32)height, (deUint32)depth};
-		ImageCreateInfo stagingResourceCreateInfo(type, m_format, stagingExtent, 1, 1, vk::VK_SAMPLE_COUNT_1_BIT,
-												  vk::VK_IMAGE_TILING_LINEAR, vk::VK_IMAGE_USAGE_TRANSFER_DST_BIT);
+		vk::PooledCommandBuffer copyCmdBuffer(m_vk, m_device, queue, m_queueFamilyIndex);
 
-		stagingResource = Image::createAndAlloc(m_vk, m_device, stagingResourceCreateInfo, allocator, m_queueFamilyIndex,
-												vk::MemoryRequirement::HostVisible);
+		stagingResource = recordCopyToLinearImage(*copyCmdBuffer, allocator, layout, offset, width, height, depth, mipLevel, arrayElement, aspect, type);
+		copyCmdBuffer.submitAndWait();
 
-		CmdPoolCreateInfo copyCmdPoolCreateInfo(m_queueFamilyIndex);
-		vk::Unique<vk::VkCommandPool> copyCmdPool(vk::createCommandPool(m_vk, m_device, &copyCmdPoolCreateInfo));
-		vk::Unique<vk::VkCommandBuffer> copyCmdBuffer(vk::allocateCommandBuffer(m_vk, m_device, *copyCmdPool, vk::VK_COMMAND_BUFFER_LEVEL_PRIMARY));
+		// Validate the results
+		const vk::Allocation& imgAllocation = stagingResource->getBoundMemory();
+		invalidateMappedMemoryRange(m_vk, m_device, imgAllocation.getMemory(), imgAllocation.getOffset(), VK_WHOLE_SIZE);
+	}
+	return stagingResource;
+}
 
-		beginCommandBuffer(m_vk, *copyCmdBuffer);
+de::SharedPtr<Image> Image::recordCopyToLinearImage (vk::VkCommandBuffer			cmdBuffer,
+													 vk::Allocator&					allocator,
+													 vk::VkImageLayout				layout,
+													 vk::VkOffset3D					offset,
+													 int							width,
+													 int							height,
+													 int							depth,
+													 unsigned int					mipLevel,
+													 unsigned int					arrayElement,
+													 vk::VkImageAspectFlagBits		aspect,
+													 vk::VkImageType				type)
+{
+	vk::VkExtent3D stagingExtent = {(deUint32)width, (deUint32)height, (deUint32)depth};
+	ImageCreateInfo stagingResourceCreateInfo(type, m_format, stagingExtent, 1, 1, vk::VK_SAMPLE_COUNT_1_BIT,
+											  vk::VK_IMAGE_TILING_LINEAR, vk::VK_IMAGE_USAGE_TRANSFER_DST_BIT);
 
-		transition2DImage(m_vk, *copyCmdBuffer, stagingResource->object(), aspect, vk::VK_IMAGE_LAYOUT_UNDEFINED, vk::VK_IMAGE_LAYOUT_GENERAL,
-						  0u, vk::VK_ACCESS_TRANSFER_WRITE_BIT, vk::VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, vk::VK_PIPELINE_STAGE_TRANSFER_BIT);
+	de::SharedPtr<Image> stagingResource = Image::createAndAlloc(m_vk, m_device, stagingResourceCreateInfo, allocator, m_queueFamilyIndex,
+																 vk::MemoryRequirement::HostVisible);
 
-		const vk::VkOffset3D zeroOffset = { 0, 0, 0 };
-		vk::VkImageCopy region = { { (vk::VkImageAspectFlags)aspect, mipLevel, arrayElement, 1}, offset, { (vk::VkImageAspectFlags)aspect, 0, 0, 1}, zeroOffset, {(deUint32)width, (deUint32)height, (deUint32)depth} };
+	transition2DImage(m_vk, cmdBuffer, stagingResource->object(), aspect, vk::VK_IMAGE_LAYOUT_UNDEFINED, vk::VK_IMAGE_LAYOUT_GENERAL,
+					  0u, vk::VK_ACCESS_TRANSFER_WRITE_BIT, vk::VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, vk::VK_PIPELINE_STAGE_TRANSFER_BIT);
 
-		m_vk.cmdCopyImage(*copyCmdBuffer, object(), layout, stagingResource->object(), vk::VK_IMAGE_LAYOUT_GENERAL, 1, &region);
-		endCommandBuffer(m_vk, *copyCmdBuffer);
+	const vk::VkOffset3D zeroOffset = { 0, 0, 0 };
+	vk::VkImageCopy region = { { (vk::VkImageAspectFlags)aspect, mipLevel, arrayElement, 1}, offset, { (vk::VkImageAspectFlags)aspect, 0, 0, 1}, zeroOffset, {(deUint32)width, (deUint32)height, (deUint32)depth} };
 
-		submitCommandsAndWait(m_vk, m_device, queue, copyCmdBuffer.get());
+	m_vk.cmdCopyImage(cmdBuffer, object(), layout, stagingResource->object(), vk::VK_IMAGE_LAYOUT_GENERAL, 1, &region);
 
-		// Validate the results
-		const vk::Allocation& imgAllocation = stagingResource->getBoundMemory();
-		invalidateMappedMemoryRange(m_vk, m_device, imgAllocation.getMemory(), imgAllocation.getOffset(), VK_WHOLE_SIZE);
-	}
 	return stagingResource;
 }
 
@@ -554,11 +635,7 @@ void Image::upload (vk::VkQueue					queue,
 	stagingResource->uploadLinear(zeroOffset, width, height, depth, 0, 0, aspect, data);
 
 	{
-		CmdPoolCreateInfo copyCmdPoolCreateInfo(m_queueFamilyIndex);
-		vk::Unique<vk::VkCommandPool> copyCmdPool(vk::createCommandPool(m_vk, m_device, &copyCmdPoolCreateInfo));
-		vk::Unique<vk::VkCommandBuffer> copyCmdBuffer(vk::allocateCommandBuffer(m_vk, m_device, *copyCmdPool, vk::VK_COMMAND_BUFFER_LEVEL_PRIMARY));
-
-		beginCommandBuffer(m_vk, *copyCmdBuffer);
+		vk::PooledCommandBuffer copyCmdBuffer(m_vk, m_device, queue, m_queueFamilyIndex);
 
 		if (layout == vk::VK_IMAGE_LAYOUT_UNDEFINED)
 		{
@@ -598,9 +675,7 @@ void Image::upload (vk::VkQueue					queue,
 
 		m_vk.cmdCopyImage(*copyCmdBuffer, stagingResource->object(),
 								vk::VK_IMAGE_LAYOUT_GENERAL, object(), layout, 1, &region);
-		endCommandBuffer(m_vk, *copyCmdBuffer);
-
-		submitCommandsAndWait(m_vk, m_device, queue, copyCmdBuffer.get());
+		copyCmdBuffer.submitAndWait();
 	}
 }
 
@@ -619,42 +694,14 @@ void Image::uploadUsingBuffer (vk::VkQueue					queue,
 	DE_ASSERT(layout == vk::VK_IMAGE_LAYOUT_GENERAL || layout == vk::VK_IMAGE_LAYOUT_UNDEFINED || layout == vk::VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
 
 	de::SharedPtr<Buffer> stagingResource;
-	bool isCombinedType = isCombinedDepthStencilType(vk::mapVkFormat(m_format).type);
-	vk::VkDeviceSize bufferSize = 0;
-	if (!isCombinedType)
-		bufferSize = vk::mapVkFormat(m_format).getPixelSize() *width*height*depth;
-	if (isCombinedType)
-	{
-		int pixelSize = 0;
-		switch (m_format)
-		{
-			case vk::VK_FORMAT_D16_UNORM_S8_UINT:
-				pixelSize = (aspect == vk::VK_IMAGE_ASPECT_DEPTH_BIT) ? 2 : 1;
-				break;
-			case  vk::VK_FORMAT_D32_SFLOAT_S8_UINT:
-				pixelSize = (aspect == vk::VK_IMAGE_ASPECT_DEPTH_BIT) ? 4 : 1;
-				break;
-			case vk::VK_FORMAT_X8_D24_UNORM_PACK32:
-			case vk::VK_FORMAT_D24_UNORM_S8_UINT:
-				pixelSize = (aspect == vk::VK_IMAGE_ASPECT_DEPTH_BIT) ? 3 : 1;
-				break;
-
-			default:
-				DE_FATAL("Not implemented");
-		}
-		bufferSize = pixelSize*width*height*depth;
-	}
+	const vk::VkDeviceSize bufferSize = getBufferCopySize(width, height, depth, aspect);
 	BufferCreateInfo stagingBufferResourceCreateInfo(bufferSize, vk::VK_BUFFER_USAGE_TRANSFER_DST_BIT | vk::VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
 	stagingResource = Buffer::createAndAlloc(m_vk, m_device, stagingBufferResourceCreateInfo, allocator, vk::MemoryRequirement::HostVisible);
 	deUint8* destPtr = reinterpret_cast<deUint8*>(stagingResource->getBoundMemory().getHostPtr());
 	deMemcpy(destPtr, data, static_cast<size_t>(bufferSize));
 	vk::flushMappedMemoryRange(m_vk, m_device, stagingResource->getBoundMemory().getMemory(), stagingResource->getBoundMemory().getOffset(), bufferSize);
 	{
-		CmdPoolCreateInfo copyCmdPoolCreateInfo(m_queueFamilyIndex);
-		vk::Unique<vk::VkCommandPool> copyCmdPool(vk::createCommandPool(m_vk, m_device, &copyCmdPoolCreateInfo));
-		vk::Unique<vk::VkCommandBuffer> copyCmdBuffer(vk::allocateCommandBuffer(m_vk, m_device, *copyCmdPool, vk::VK_COMMAND_BUFFER_LEVEL_PRIMARY));
-
-		beginCommandBuffer(m_vk, *copyCmdBuffer);
+		vk::PooledCommandBuffer copyCmdBuffer(m_vk, m_device, queue, m_queueFamilyIndex);
 
 		if (layout == vk::VK_IMAGE_LAYOUT_UNDEFINED)
 		{
@@ -692,9 +739,7 @@ void Image::uploadUsingBuffer (vk::VkQueue					queue,
 
 		m_vk.cmdCopyBufferToImage(*copyCmdBuffer, stagingResource->object(),
 			object(), layout, 1, &region);
-		endCommandBuffer(m_vk, *copyCmdBuffer);
-
-		submitCommandsAndWait(m_vk, m_device, queue, copyCmdBuffer.get());
+		copyCmdBuffer.submitAndWait();
 	}
 }
 
@@ -59,6 +59,8 @@ public:
 						 void *					destBuffer);
 };
 
+class Buffer;
+
 class Image
 {
 public:
@@ -81,6 +83,19 @@ public:
 													 unsigned int							mipLevel = 0,
 													 unsigned int							arrayElement = 0);
 
+	//! Read the same region of several images with one queue submission, see readSurface().
+	static std::vector<tcu::ConstPixelBufferAccess> readSurfaces
+													(const std::vector<de::SharedPtr<Image> >&	images,
+													 vk::VkQueue							queue,
+													 vk::Allocator&							allocator,
+													 vk::VkImageLayout						layout,
+													 vk::VkOffset3D							offset,
+													 int									width,
+													 int									height,
+													 vk::VkImageAspectFlagBits				aspect,
+													 unsigned int							mipLevel = 0,
+													 unsigned int							arrayElement = 0);
+
 	tcu::ConstPixelBufferAccess readSurface1D		(vk::VkQueue							queue,
 													 vk::Allocator&							allocator,
 													 vk::VkImageLayout						layout,
@@ -240,6 +255,35 @@ private:
 													 deUint32								layerCount,
 													 vk::Move<vk::VkImage>					object);
 
+	vk::VkDeviceSize			getBufferCopySize	(int									width,
+													 int									height,
+													 int									depth,
+													 vk::VkImageAspectFlagBits				aspect) const;
+
+	de::SharedPtr<Image>		recordCopyToLinearImage
+													(vk::VkCommandBuffer					cmdBuffer,
+													 vk::Allocator&							allocator,
+													 vk::VkImageLayout						layout,
+													 vk::VkOffset3D							offset,
+													 int									width,
+													 int									height,
+													 int									depth,
+													 unsigned int							mipLevel,
+													 unsigned int							arrayElement,
+													 vk::VkImageAspectFlagBits				aspect,
+													 vk::VkImageType						type);
+
+	de::SharedPtr<Buffer>		recordCopyToBuffer	(vk::VkCommandBuffer					cmdBuffer,
+													 vk::Allocator&							allocator,
+													 vk::VkImageLayout						layout,
+													 vk::VkOffset3D							offset,
+													 int									width,
+													 int									height,
+													 int									depth,
+													 unsigned int							mipLevel,
+													 unsigned int							arrayElement,
+													 vk::VkImageAspectFlagBits				aspect);
+
 	Image											(const Image& other);	// Not allowed!
 	Image&						operator=			(const Image& other);	// Not allowed!
 
@@ -26,6 +26,7 @@
 #include "vkPrograms.hpp"
 #include "vkQueryUtil.hpp"
 #include "vkCmdUtil.hpp"
+#include "vkPipelineCacheUtil.hpp"
 #include <vector>
 
 namespace vkt
@@ -171,7 +172,7 @@ Move<VkPipeline> makeComputePipeline (const DeviceInterface&		vk,
 		DE_NULL,											// VkPipeline						basePipelineHandle;
 		0,													// deInt32							basePipelineIndex;
 	};
-	return createComputePipeline(vk, device, DE_NULL , &pipelineInfo);
+	return createComputePipeline(vk, device, getDefaultPipelineCache(device), &pipelineInfo);
 }
 
 Move<VkImageView> makeImageView (const DeviceInterface&			vk,
@@ -26,6 +26,7 @@
 #include "vkTypeUtil.hpp"
 #include "vkCmdUtil.hpp"
 #include "vkObjUtil.hpp"
+#include "vkPipelineCacheUtil.hpp"
 #include "tcuTextureUtil.hpp"
 
 using namespace vk;
@@ -266,7 +267,7 @@ Move<VkPipeline> makeComputePipeline (const DeviceInterface&	vk,
 		DE_NULL,											// VkPipeline						basePipelineHandle;
 		0,													// deInt32							basePipelineIndex;
 	};
-	return createComputePipeline(vk, device, DE_NULL , &pipelineCreateInfo);
+	return createComputePipeline(vk, device, getDefaultPipelineCache(device), &pipelineCreateInfo);
 }
 
 Move<VkPipeline> makeGraphicsPipeline (const DeviceInterface&	vk,
@@ -26,6 +26,7 @@
 #include "vktMultiViewRenderPassUtil.hpp"
 
 #include "vktTestCase.hpp"
+#include "vktDeviceCache.hpp"
 #include "vkBuilderUtil.hpp"
 #include "vkRefUtil.hpp"
 #include "vkQueryUtil.hpp"
@@ -163,14 +164,14 @@ vk::Move<vk::VkRenderPass> makeRenderPassWithDepth (const DeviceInterface&	vk,
 }
 
 template<typename RenderpassSubpass>
-void cmdBeginRenderPass (DeviceInterface& vkd, VkCommandBuffer cmdBuffer, const VkRenderPassBeginInfo* pRenderPassBegin, const VkSubpassContents contents)
+void cmdBeginRenderPass (const DeviceInterface& vkd, VkCommandBuffer cmdBuffer, const VkRenderPassBeginInfo* pRenderPassBegin, const VkSubpassContents contents)
 {
 	const typename RenderpassSubpass::SubpassBeginInfo	subpassBeginInfo	(DE_NULL, contents);
 
 	RenderpassSubpass::cmdBeginRenderPass(vkd, cmdBuffer, pRenderPassBegin, &subpassBeginInfo);
 }
 
-void cmdBeginRenderPass (DeviceInterface& vkd, VkCommandBuffer cmdBuffer, const VkRenderPassBeginInfo* pRenderPassBegin, const VkSubpassContents contents, RenderPassType renderPassType)
+void cmdBeginRenderPass (const DeviceInterface& vkd, VkCommandBuffer cmdBuffer, const VkRenderPassBeginInfo* pRenderPassBegin, const VkSubpassContents contents, RenderPassType renderPassType)
 {
 	switch (renderPassType)
 	{
@@ -181,7 +182,7 @@ void cmdBeginRenderPass (DeviceInterface& vkd, VkCommandBuffer cmdBuffer, const
 }
 
 template<typename RenderpassSubpass>
-void cmdNextSubpass (DeviceInterface& vkd, VkCommandBuffer cmdBuffer, const VkSubpassContents contents)
+void cmdNextSubpass (const DeviceInterface& vkd, VkCommandBuffer cmdBuffer, const VkSubpassContents contents)
 {
 	const typename RenderpassSubpass::SubpassBeginInfo	subpassBeginInfo	(DE_NULL, contents);
 	const typename RenderpassSubpass::SubpassEndInfo	subpassEndInfo		(DE_NULL);
@@ -189,7 +190,7 @@ void cmdNextSubpass (DeviceInterface& vkd, VkCommandBuffer cmdBuffer, const VkSu
 	RenderpassSubpass::cmdNextSubpass(vkd, cmdBuffer, &subpassBeginInfo, &subpassEndInfo);
 }
 
-void cmdNextSubpass (DeviceInterface& vkd, VkCommandBuffer cmdBuffer, const VkSubpassContents contents, RenderPassType renderPassType)
+void cmdNextSubpass (const DeviceInterface& vkd, VkCommandBuffer cmdBuffer, const VkSubpassContents contents, RenderPassType renderPassType)
 {
 	switch (renderPassType)
 	{
@@ -200,14 +201,14 @@ void cmdNextSubpass (DeviceInterface& vkd, VkCommandBuffer cmdBuffer, const VkSu
 }
 
 template<typename RenderpassSubpass>
-void cmdEndRenderPass (DeviceInterface& vkd, VkCommandBuffer cmdBuffer)
+void cmdEndRenderPass (const DeviceInterface& vkd, VkCommandBuffer cmdBuffer)
 {
 	const typename RenderpassSubpass::SubpassEndInfo	subpassEndInfo	(DE_NULL);
 
 	RenderpassSubpass::cmdEndRenderPass(vkd, cmdBuffer, &subpassEndInfo);
 }
 
-void cmdEndRenderPass (DeviceInterface& vkd, VkCommandBuffer cmdBuffer, RenderPassType renderPassType)
+void cmdEndRenderPass (const DeviceInterface& vkd, VkCommandBuffer cmdBuffer, RenderPassType renderPassType)
 {
 	switch (renderPassType)
 	{
@@ -220,7 +221,7 @@ void cmdEndRenderPass (DeviceInterface& vkd, VkCommandBuffer cmdBuffer, RenderPa
 class ImageAttachment
 {
 public:
-				ImageAttachment	(VkDevice logicalDevice, DeviceInterface& device, Allocator& allocator, const VkExtent3D extent, VkFormat colorFormat, const VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT);
+				ImageAttachment	(VkDevice logicalDevice, const DeviceInterface& device, Allocator& allocator, const VkExtent3D extent, VkFormat colorFormat, const VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT);
 	VkImageView	getImageView	(void) const
 	{
 		return *m_imageView;
@@ -235,7 +236,7 @@ private:
 	Move<VkImageView>		m_imageView;
 };
 
-ImageAttachment::ImageAttachment (VkDevice logicalDevice, DeviceInterface& device, Allocator& allocator, const VkExtent3D extent, VkFormat colorFormat, const VkSampleCountFlagBits samples)
+ImageAttachment::ImageAttachment (VkDevice logicalDevice, const DeviceInterface& device, Allocator& allocator, const VkExtent3D extent, VkFormat colorFormat, const VkSampleCountFlagBits samples)
 {
 	const bool						depthStencilFormat			= isDepthStencilFormat(colorFormat);
 	const VkImageAspectFlags		aspectFlags					= depthStencilFormat ? VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT : VK_IMAGE_ASPECT_COLOR_BIT;
@@ -293,8 +294,9 @@ protected:
 	const TestParameters			m_parameters;
 	const int						m_seed;
 	const deUint32					m_squareCount;
-	Move<VkDevice>					m_logicalDevice;
-	MovePtr<DeviceInterface>		m_device;
+	MovePtr<CustomDevice>			m_customDevice;
+	VkDevice						m_logicalDevice;
+	const DeviceInterface*			m_device;
 	MovePtr<Allocator>				m_allocator;
 	deUint32						m_queueFamilyIndex;
 	VkQueue							m_queue;
@@ -320,6 +322,8 @@ MultiViewRenderTestInstance::MultiViewRenderTestInstance (Context& context, cons
 	, m_parameters			(fillMissingParameters(parameters))
 	, m_seed				(context.getTestContext().getCommandLine().getBaseSeed())
 	, m_squareCount			(4u)
+	, m_logicalDevice		(DE_NULL)
+	, m_device				(DE_NULL)
 	, m_queueFamilyIndex	(0u)
 {
 	if (!isDeviceExtensionSupported(context.getUsedApiVersion(), context.getDeviceExtensions(), "VK_KHR_multiview"))
@@ -340,7 +344,7 @@ MultiViewRenderTestInstance::MultiViewRenderTestInstance (Context& context, cons
 	createMultiViewDevices();
 
 	// Color attachment
-	m_colorAttachment = de::SharedPtr<ImageAttachment>(new ImageAttachment(*m_logicalDevice, *m_device, *m_allocator, m_parameters.extent, m_parameters.colorFormat, m_parameters.samples));
+	m_colorAttachment = de::SharedPtr<ImageAttachment>(new ImageAttachment(m_logicalDevice, *m_device, *m_allocator, m_parameters.extent, m_parameters.colorFormat, m_parameters.samples));
 }
 
 tcu::TestStatus MultiViewRenderTestInstance::iterate (void)
@@ -348,14 +352,14 @@ tcu::TestStatus MultiViewRenderTestInstance::iterate (void)
 	const deUint32								subpassCount				= static_cast<deUint32>(m_parameters.viewMasks.size());
 
 	// FrameBuffer & renderPass
-	Unique<VkRenderPass>						renderPass					(makeRenderPass (*m_device, *m_logicalDevice, m_parameters.colorFormat, m_parameters.viewMasks, m_parameters.renderPassType));
+	Unique<VkRenderPass>						renderPass					(makeRenderPass (*m_device, m_logicalDevice, m_parameters.colorFormat, m_parameters.viewMasks, m_parameters.renderPassType));
 
 	vector<VkImageView>							attachments;
 	attachments.push_back(m_colorAttachment->getImageView());
-	Unique<VkFramebuffer>						frameBuffer					(makeFramebuffer(*m_device, *m_logicalDevice, *renderPass, attachments, m_parameters.extent.width, m_parameters.extent.height, 1u));
+	Unique<VkFramebuffer>						frameBuffer					(makeFramebuffer(*m_device, m_logicalDevice, *renderPass, attachments, m_parameters.extent.width, m_parameters.extent.height, 1u));
 
 	// pipelineLayout
-	Unique<VkPipelineLayout>					pipelineLayout				(makePipelineLayout(*m_device, *m_logicalDevice));
+	Unique<VkPipelineLayout>					pipelineLayout				(makePipelineLayout(*m_device, m_logicalDevice));
 
 	// pipelines
 	map<VkShaderStageFlagBits, ShaderModuleSP>	shaderModule;
@@ -478,7 +482,7 @@ void MultiViewRenderTestInstance::draw (const deUint32 subpassCount, VkRenderPas
 	afterDraw();
 
 	VK_CHECK(m_device->endCommandBuffer(*m_cmdBuffer));
-	submitCommandsAndWait(*m_device, *m_logicalDevice, m_queue, *m_cmdBuffer);
+	submitCommandsAndWait(*m_device, m_logicalDevice, m_queue, *m_cmdBuffer);
 }
 
 void MultiViewRenderTestInstance::createVertexData (void)
@@ -582,12 +586,12 @@ void MultiViewRenderTestInstance::createVertexBuffer (void)
 		const VkDeviceSize			bufferDataSize	= static_cast<VkDeviceSize>(deAlignSize(dataSize, nonCoherentAtomSize));
 		const VkBufferCreateInfo	bufferInfo		= makeBufferCreateInfo(bufferDataSize, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
 
-		m_vertexCoordBuffer	= createBuffer(*m_device, *m_logicalDevice, &bufferInfo);
-		m_vertexCoordAlloc	= m_allocator->allocate(getBufferMemoryRequirements(*m_device, *m_logicalDevice, *m_vertexCoordBuffer), MemoryRequirement::HostVisible);
+		m_vertexCoordBuffer	= createBuffer(*m_device, m_logicalDevice, &bufferInfo);
+		m_vertexCoordAlloc	= m_allocator->allocate(getBufferMemoryRequirements(*m_device, m_logicalDevice, *m_vertexCoordBuffer), MemoryRequirement::HostVisible);
 
-		VK_CHECK(m_device->bindBufferMemory(*m_logicalDevice, *m_vertexCoordBuffer, m_vertexCoordAlloc->getMemory(), m_vertexCoordAlloc->getOffset()));
+		VK_CHECK(m_device->bindBufferMemory(m_logicalDevice, *m_vertexCoordBuffer, m_vertexCoordAlloc->getMemory(), m_vertexCoordAlloc->getOffset()));
 		deMemcpy(m_vertexCoordAlloc->getHostPtr(), m_vertexCoord.data(), static_cast<size_t>(dataSize));
-		flushMappedMemoryRange(*m_device, *m_logicalDevice, m_vertexCoordAlloc->getMemory(), m_vertexCoordAlloc->getOffset(), static_cast<size_t>(bufferDataSize));
+		flushMappedMemoryRange(*m_device, m_logicalDevice, m_vertexCoordAlloc->getMemory(), m_vertexCoordAlloc->getOffset(), static_cast<size_t>(bufferDataSize));
 	}
 
 	// Upload vertex colors
@@ -596,12 +600,12 @@ void MultiViewRenderTestInstance::createVertexBuffer (void)
 		const VkDeviceSize			bufferDataSize	= static_cast<VkDeviceSize>(deAlignSize(dataSize, nonCoherentAtomSize));
 		const VkBufferCreateInfo	bufferInfo		= makeBufferCreateInfo(bufferDataSize, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
 
-		m_vertexColorBuffer	= createBuffer(*m_device, *m_logicalDevice, &bufferInfo);
-		m_vertexColorAlloc	= m_allocator->allocate(getBufferMemoryRequirements(*m_device, *m_logicalDevice, *m_vertexColorBuffer), MemoryRequirement::HostVisible);
+		m_vertexColorBuffer	= createBuffer(*m_device, m_logicalDevice, &bufferInfo);
+		m_vertexColorAlloc	= m_allocator->allocate(getBufferMemoryRequirements(*m_device, m_logicalDevice, *m_vertexColorBuffer), MemoryRequirement::HostVisible);
 
-		VK_CHECK(m_device->bindBufferMemory(*m_logicalDevice, *m_vertexColorBuffer, m_vertexColorAlloc->getMemory(), m_vertexColorAlloc->getOffset()));
+		VK_CHECK(m_device->bindBufferMemory(m_logicalDevice, *m_vertexColorBuffer, m_vertexColorAlloc->getMemory(), m_vertexColorAlloc->getOffset()));
 		deMemcpy(m_vertexColorAlloc->getHostPtr(), m_vertexColor.data(), static_cast<size_t>(dataSize));
-		flushMappedMemoryRange(*m_device, *m_logicalDevice, m_vertexColorAlloc->getMemory(), m_vertexColorAlloc->getOffset(), static_cast<size_t>(bufferDataSize));
+		flushMappedMemoryRange(*m_device, m_logicalDevice, m_vertexColorAlloc->getMemory(), m_vertexColorAlloc->getOffset(), static_cast<size_t>(bufferDataSize));
 	}
 
 	// Upload vertex indices
@@ -613,13 +617,13 @@ void MultiViewRenderTestInstance::createVertexBuffer (void)
 
 		DE_ASSERT(m_vertexIndices.size() == m_vertexCoord.size());
 
-		m_vertexIndicesBuffer		= createBuffer(*m_device, *m_logicalDevice, &bufferInfo);
-		m_vertexIndicesAllocation	= m_allocator->allocate(getBufferMemoryRequirements(*m_device, *m_logicalDevice, *m_vertexIndicesBuffer), MemoryRequirement::HostVisible);
+		m_vertexIndicesBuffer		= createBuffer(*m_device, m_logicalDevice, &bufferInfo);
+		m_vertexIndicesAllocation	= m_allocator->allocate(getBufferMemoryRequirements(*m_device, m_logicalDevice, *m_vertexIndicesBuffer), MemoryRequirement::HostVisible);
 
 		// Init host buffer data
-		VK_CHECK(m_device->bindBufferMemory(*m_logicalDevice, *m_vertexIndicesBuffer, m_vertexIndicesAllocation->getMemory(), m_vertexIndicesAllocation->getOffset()));
+		VK_CHECK(m_device->bindBufferMemory(m_logicalDevice, *m_vertexIndicesBuffer, m_vertexIndicesAllocation->getMemory(), m_vertexIndicesAllocation->getOffset()));
 		deMemcpy(m_vertexIndicesAllocation->getHostPtr(), m_vertexIndices.data(), static_cast<size_t>(dataSize));
-		flushMappedMemoryRange(*m_device, *m_logicalDevice, m_vertexIndicesAllocation->getMemory(), m_vertexIndicesAllocation->getOffset(), static_cast<size_t>(bufferDataSize));
+		flushMappedMemoryRange(*m_device, m_logicalDevice, m_vertexIndicesAllocation->getMemory(), m_vertexIndicesAllocation->getOffset(), static_cast<size_t>(bufferDataSize));
 	}
 	else
 		DE_ASSERT(m_vertexIndices.empty());
@@ -725,10 +729,11 @@ void MultiViewRenderTestInstance::createMultiViewDevices (void)
 			DE_NULL															//const VkPhysicalDeviceFeatures*	pEnabledFeatures;
 		};
 
-		m_logicalDevice					= createDevice(m_context.getPlatformInterface(), m_context.getInstance(), instance, physicalDevice, &deviceInfo);
-		m_device						= MovePtr<DeviceDriver>(new DeviceDriver(m_context.getPlatformInterface(), m_context.getInstance(), *m_logicalDevice));
-		m_allocator						= MovePtr<Allocator>(new SimpleAllocator(*m_device, *m_logicalDevice, getPhysicalDeviceMemoryProperties(instance, physicalDevice)));
-		m_device->getDeviceQueue		(*m_logicalDevice, m_queueFamilyIndex, 0u, &m_queue);
+		m_customDevice					= m_context.getDeviceCache().getDevice(physicalDevice, deviceInfo);
+		m_logicalDevice					= m_customDevice->getDevice();
+		m_device						= &m_customDevice->getDeviceInterface();
+		m_allocator						= MovePtr<Allocator>(new SimpleAllocator(*m_device, m_logicalDevice, getPhysicalDeviceMemoryProperties(instance, physicalDevice)));
+		m_device->getDeviceQueue		(m_logicalDevice, m_queueFamilyIndex, 0u, &m_queue);
 	}
 }
 
@@ -743,7 +748,7 @@ void MultiViewRenderTestInstance::createCommandBuffer (void)
 			VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,	// VkCmdPoolCreateFlags	flags;
 			m_queueFamilyIndex,									// deUint32				queueFamilyIndex;
 		};
-		m_cmdPool = createCommandPool(*m_device, *m_logicalDevice, &cmdPoolParams);
+		m_cmdPool = createCommandPool(*m_device, m_logicalDevice, &cmdPoolParams);
 	}
 
 	// cmdBuffer
@@ -756,7 +761,7 @@ void MultiViewRenderTestInstance::createCommandBuffer (void)
 			VK_COMMAND_BUFFER_LEVEL_PRIMARY,					// VkCommandBufferLevel	level;
 			1u,													// deUint32				bufferCount;
 		};
-		m_cmdBuffer	= allocateCommandBuffer(*m_device, *m_logicalDevice, &cmdBufferAllocateInfo);
+		m_cmdBuffer	= allocateCommandBuffer(*m_device, m_logicalDevice, &cmdBufferAllocateInfo);
 	}
 }
 
@@ -783,21 +788,21 @@ void MultiViewRenderTestInstance::madeShaderModule (map<VkShaderStageFlagBits, S
 		case TEST_TYPE_READBACK_WITH_EXPLICIT_CLEAR:
 		case TEST_TYPE_DEPTH:
 		case TEST_TYPE_STENCIL:
-			shaderModule[VK_SHADER_STAGE_VERTEX_BIT]					= (ShaderModuleSP(new Unique<VkShaderModule>(createShaderModule(*m_device, *m_logicalDevice, m_context.getBinaryCollection().get("vertex"), 0))));
-			shaderModule[VK_SHADER_STAGE_FRAGMENT_BIT]					= (ShaderModuleSP(new Unique<VkShaderModule>(createShaderModule(*m_device, *m_logicalDevice, m_context.getBinaryCollection().get("fragment"), 0))));
+			shaderModule[VK_SHADER_STAGE_VERTEX_BIT]					= (ShaderModuleSP(new Unique<VkShaderModule>(createShaderModule(*m_device, m_logicalDevice, m_context.getBinaryCollection().get("vertex"), 0))));
+			shaderModule[VK_SHADER_STAGE_FRAGMENT_BIT]					= (ShaderModuleSP(new Unique<VkShaderModule>(createShaderModule(*m_device, m_logicalDevice, m_context.getBinaryCollection().get("fragment"), 0))));
 			break;
 		case TEST_TYPE_VIEW_INDEX_IN_GEOMETRY:
 		case TEST_TYPE_INPUT_ATTACHMENTS_GEOMETRY:
 		case TEST_TYPE_SECONDARY_CMD_BUFFER_GEOMETRY:
-			shaderModule[VK_SHADER_STAGE_VERTEX_BIT]					= (ShaderModuleSP(new Unique<VkShaderModule>(createShaderModule(*m_device, *m_logicalDevice, m_context.getBinaryCollection().get("vertex"), 0))));
-			shaderModule[VK_SHADER_STAGE_GEOMETRY_BIT]					= (ShaderModuleSP(new Unique<VkShaderModule>(createShaderModule(*m_device, *m_logicalDevice, m_context.getBinaryCollection().get("geometry"), 0))));
-			shaderModule[VK_SHADER_STAGE_FRAGMENT_BIT]					= (ShaderModuleSP(new Unique<VkShaderModule>(createShaderModule(*m_device, *m_logicalDevice, m_context.getBinaryCollection().get("fragment"), 0))));
+			shaderModule[VK_SHADER_STAGE_VERTEX_BIT]					= (ShaderModuleSP(new Unique<VkShaderModule>(createShaderModule(*m_device, m_logicalDevice, m_context.getBinaryCollection().get("vertex"), 0))));
+			shaderModule[VK_SHADER_STAGE_GEOMETRY_BIT]					= (ShaderModuleSP(new Unique<VkShaderModule>(createShaderModule(*m_device, m_logicalDevice, m_context.getBinaryCollection().get("geometry"), 0))));
+			shaderModule[VK_SHADER_STAGE_FRAGMENT_BIT]					= (ShaderModuleSP(new Unique<VkShaderModule>(createShaderModule(*m_device, m_logicalDevice, m_context.getBinaryCollection().get("fragment"), 0))));
 			break;
 		case TEST_TYPE_VIEW_INDEX_IN_TESELLATION:
-			shaderModule[VK_SHADER_STAGE_VERTEX_BIT]					= (ShaderModuleSP(new Unique<VkShaderModule>(createShaderModule(*m_device, *m_logicalDevice, m_context.getBinaryCollection().get("vertex"), 0))));
-			shaderModule[VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT]		= (ShaderModuleSP(new Unique<VkShaderModule>(createShaderModule(*m_device, *m_logicalDevice, m_context.getBinaryCollection().get("tessellation_control"), 0))));
-			shaderModule[VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT]	= (ShaderModuleSP(new Unique<VkShaderModule>(createShaderModule(*m_device, *m_logicalDevice, m_context.getBinaryCollection().get("tessellation_evaluation"), 0))));
-			shaderModule[VK_SHADER_STAGE_FRAGMENT_BIT]					= (ShaderModuleSP(new Unique<VkShaderModule>(createShaderModule(*m_device, *m_logicalDevice, m_context.getBinaryCollection().get("fragment"), 0))));
+			shaderModule[VK_SHADER_STAGE_VERTEX_BIT]					= (ShaderModuleSP(new Unique<VkShaderModule>(createShaderModule(*m_device, m_logicalDevice, m_context.getBinaryCollection().get("vertex"), 0))));
+			shaderModule[VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT]		= (ShaderModuleSP(new Unique<VkShaderModule>(createShaderModule(*m_device, m_logicalDevice, m_context.getBinaryCollection().get("tessellation_control"), 0))));
+			shaderModule[VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT]	= (ShaderModuleSP(new Unique<VkShaderModule>(createShaderModule(*m_device, m_logicalDevice, m_context.getBinaryCollection().get("tessellation_evaluation"), 0))));
+			shaderModule[VK_SHADER_STAGE_FRAGMENT_BIT]					= (ShaderModuleSP(new Unique<VkShaderModule>(createShaderModule(*m_device, m_logicalDevice, m_context.getBinaryCollection().get("fragment"), 0))));
 			break;
 		default:
 			DE_ASSERT(0);
@@ -1024,7 +1029,7 @@ Move<VkPipeline> MultiViewRenderTestInstance::makeGraphicsPipeline (const VkRend
 		0,																								// deInt32											basePipelineIndex;
 	};
 
-	return createGraphicsPipeline(*m_device, *m_logicalDevice, DE_NULL, &graphicsPipelineParams);
+	return createGraphicsPipeline(*m_device, m_logicalDevice, DE_NULL, &graphicsPipelineParams);
 }
 
 void MultiViewRenderTestInstance::readImage (VkImage image, const tcu::PixelBufferAccess& dst)
@@ -1047,12 +1052,12 @@ void MultiViewRenderTestInstance::readImage (VkImage image, const tcu::PixelBuff
 			&m_queueFamilyIndex,					// const deUint32*		pQueueFamilyIndices;
 		};
 
-		buffer		= createBuffer(*m_device, *m_logicalDevice, &bufferParams);
-		bufferAlloc	= m_allocator->allocate(getBufferMemoryRequirements(*m_device, *m_logicalDevice, *buffer), MemoryRequirement::HostVisible);
-		VK_CHECK(m_device->bindBufferMemory(*m_logicalDevice, *buffer, bufferAlloc->getMemory(), bufferAlloc->getOffset()));
+		buffer		= createBuffer(*m_device, m_logicalDevice, &bufferParams);
+		bufferAlloc	= m_allocator->allocate(getBufferMemoryRequirements(*m_device, m_logicalDevice, *buffer), MemoryRequirement::HostVisible);
+		VK_CHECK(m_device->bindBufferMemory(m_logicalDevice, *buffer, bufferAlloc->getMemory(), bufferAlloc->getOffset()));
 
 		deMemset(bufferAlloc->getHostPtr(), 0, static_cast<size_t>(pixelDataSize));
-		flushMappedMemoryRange(*m_device, *m_logicalDevice, bufferAlloc->getMemory(), bufferAlloc->getOffset(), pixelDataSize);
+		flushMappedMemoryRange(*m_device, m_logicalDevice, bufferAlloc->getMemory(), bufferAlloc->getOffset(), pixelDataSize);
 	}
 
 	const VkBufferMemoryBarrier	bufferBarrier	=
@@ -1105,10 +1110,10 @@ void MultiViewRenderTestInstance::readImage (VkImage image, const tcu::PixelBuff
 		m_device->cmdPipelineBarrier(*m_cmdBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, (VkDependencyFlags)0, 0, (const VkMemoryBarrier*)DE_NULL, 1, &bufferBarrier, 0u, DE_NULL);
 	}
 	VK_CHECK(m_device->endCommandBuffer(*m_cmdBuffer));
-	submitCommandsAndWait(*m_device, *m_logicalDevice, m_queue, *m_cmdBuffer);
+	submitCommandsAndWait(*m_device, m_logicalDevice, m_queue, *m_cmdBuffer);
 
 	// Read buffer data
-	invalidateMappedMemoryRange(*m_device, *m_logicalDevice, bufferAlloc->getMemory(), bufferAlloc->getOffset(), pixelDataSize);
+	invalidateMappedMemoryRange(*m_device, m_logicalDevice, bufferAlloc->getMemory(), bufferAlloc->getOffset(), pixelDataSize);
 	tcu::copy(dst, tcu::ConstPixelBufferAccess(dst.getFormat(), dst.getSize(), bufferAlloc->getHostPtr()));
 }
 
@@ -1482,20 +1487,20 @@ tcu::TestStatus MultiViewAttachmentsTestInstance::iterate (void)
 {
 	const deUint32								subpassCount			= static_cast<deUint32>(m_parameters.viewMasks.size());
 	// All color attachment
-	m_colorAttachment	= de::SharedPtr<ImageAttachment>(new ImageAttachment(*m_logicalDevice, *m_device, *m_allocator, m_parameters.extent, m_parameters.colorFormat));
-	m_inputAttachment	= de::SharedPtr<ImageAttachment>(new ImageAttachment(*m_logicalDevice, *m_device, *m_allocator, m_parameters.extent, m_parameters.colorFormat));
+	m_colorAttachment	= de::SharedPtr<ImageAttachment>(new ImageAttachment(m_logicalDevice, *m_device, *m_allocator, m_parameters.extent, m_parameters.colorFormat));
+	m_inputAttachment	= de::SharedPtr<ImageAttachment>(new ImageAttachment(m_logicalDevice, *m_device, *m_allocator, m_parameters.extent, m_parameters.colorFormat));
 
 	// FrameBuffer & renderPass
-	Unique<VkRenderPass>						renderPass				(makeRenderPassWithAttachments(*m_device, *m_logicalDevice, m_parameters.colorFormat, m_parameters.viewMasks, m_parameters.renderPassType));
+	Unique<VkRenderPass>						renderPass				(makeRenderPassWithAttachments(*m_device, m_logicalDevice, m_parameters.colorFormat, m_parameters.viewMasks, m_parameters.renderPassType));
 
 	vector<VkImageView>							attachments;
 	attachments.push_back(m_colorAttachment->getImageView());
 	attachments.push_back(m_inputAttachment->getImageView());
-	Unique<VkFramebuffer>						frameBuffer				(makeFramebuffer(*m_device, *m_logicalDevice, *renderPass, attachments, m_parameters.extent.width, m_parameters.extent.height, 1u));
+	Unique<VkFramebuffer>						frameBuffer				(makeFramebuffer(*m_device, m_logicalDevice, *renderPass, attachments, m_parameters.extent.width, m_parameters.extent.height, 1u));
 
 	// pipelineLayout
-	m_descriptorSetLayout	= makeDescriptorSetLayout(*m_device, *m_logicalDevice);
-	m_pipelineLayout		= makePipelineLayout(*m_device, *m_logicalDevice, &m_descriptorSetLayout.get());
+	m_descriptorSetLayout	= makeDescriptorSetLayout(*m_device, m_logicalDevice);
+	m_pipelineLayout		= makePipelineLayout(*m_device, m_logicalDevice, &m_descriptorSetLayout.get());
 
 	// pipelines
 	map<VkShaderStageFlagBits, ShaderModuleSP>	shaderModule;
@@ -1545,7 +1550,7 @@ void MultiViewAttachmentsTestInstance::beforeDraw (void)
 		&poolSize
 	};
 
-	m_descriptorPool = createDescriptorPool(*m_device, *m_logicalDevice, &createInfo);
+	m_descriptorPool = createDescriptorPool(*m_device, m_logicalDevice, &createInfo);
 
 	const VkDescriptorSetAllocateInfo	allocateInfo =
 	{
@@ -1556,7 +1561,7 @@ void MultiViewAttachmentsTestInstance::beforeDraw (void)
 		&m_descriptorSetLayout.get()
 	};
 
-	m_descriptorSet	= vk::allocateDescriptorSet(*m_device, *m_logicalDevice, &allocateInfo);
+	m_descriptorSet	= vk::allocateDescriptorSet(*m_device, m_logicalDevice, &allocateInfo);
 
 	const VkDescriptorImageInfo	imageInfo =
 	{
@@ -1579,7 +1584,7 @@ void MultiViewAttachmentsTestInstance::beforeDraw (void)
 		DE_NULL,								//const VkBufferView*			pTexelBufferView;
 	};
 
-	m_device->updateDescriptorSets(*m_logicalDevice, (deUint32)1u, &write, 0u, DE_NULL);
+	m_device->updateDescriptorSets(m_logicalDevice, (deUint32)1u, &write, 0u, DE_NULL);
 
 	const VkImageSubresourceRange	subresourceRange	=
 	{
@@ -1626,9 +1631,9 @@ void MultiViewAttachmentsTestInstance::setImageData (VkImage image)
 			&m_queueFamilyIndex,						// const deUint32*		pQueueFamilyIndices;
 		};
 
-		buffer		= createBuffer(*m_device, *m_logicalDevice, &bufferParams);
-		bufferAlloc = m_allocator->allocate(getBufferMemoryRequirements(*m_device, *m_logicalDevice, *buffer), MemoryRequirement::HostVisible);
-		VK_CHECK(m_device->bindBufferMemory(*m_logicalDevice, *buffer, bufferAlloc->getMemory(), bufferAlloc->getOffset()));
+		buffer		= createBuffer(*m_device, m_logicalDevice, &bufferParams);
+		bufferAlloc = m_allocator->allocate(getBufferMemoryRequirements(*m_device, m_logicalDevice, *buffer), MemoryRequirement::HostVisible);
+		VK_CHECK(m_device->bindBufferMemory(m_logicalDevice, *buffer, bufferAlloc->getMemory(), bufferAlloc->getOffset()));
 	}
 
 	// Barriers for copying buffer to image
@@ -1672,7 +1677,7 @@ void MultiViewAttachmentsTestInstance::setImageData (VkImage image)
 
 	// Write buffer data
 	deMemcpy(bufferAlloc->getHostPtr(), data->getLevel(0).getDataPtr(), bufferSize);
-	flushMappedMemoryRange(*m_device, *m_logicalDevice, bufferAlloc->getMemory(), bufferAlloc->getOffset(), bufferSize);
+	flushMappedMemoryRange(*m_device, m_logicalDevice, bufferAlloc->getMemory(), bufferAlloc->getOffset(), bufferSize);
 
 	beginCommandBuffer(*m_device, *m_cmdBuffer);
 
@@ -1688,7 +1693,7 @@ void MultiViewAttachmentsTestInstance::setImageData (VkImage image)
 		VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
 	VK_CHECK(m_device->endCommandBuffer(*m_cmdBuffer));
 
-	submitCommandsAndWait(*m_device, *m_logicalDevice, m_queue, *m_cmdBuffer);
+	submitCommandsAndWait(*m_device, m_logicalDevice, m_queue, *m_cmdBuffer);
 }
 
 class MultiViewInstancedTestInstance : public MultiViewRenderTestInstance
@@ -1759,7 +1764,7 @@ void MultiViewInstancedTestInstance::draw (const deUint32 subpassCount, VkRender
 	afterDraw();
 
 	VK_CHECK(m_device->endCommandBuffer(*m_cmdBuffer));
-	submitCommandsAndWait(*m_device, *m_logicalDevice, m_queue, *m_cmdBuffer);
+	submitCommandsAndWait(*m_device, m_logicalDevice, m_queue, *m_cmdBuffer);
 }
 
 class MultiViewInputRateInstanceTestInstance : public MultiViewRenderTestInstance
@@ -1830,7 +1835,7 @@ void MultiViewInputRateInstanceTestInstance::draw (const deUint32 subpassCount,
 	afterDraw();
 
 	VK_CHECK(m_device->endCommandBuffer(*m_cmdBuffer));
-	submitCommandsAndWait(*m_device, *m_logicalDevice, m_queue, *m_cmdBuffer);
+	submitCommandsAndWait(*m_device, m_logicalDevice, m_queue, *m_cmdBuffer);
 }
 
 class MultiViewDrawIndirectTestInstance : public MultiViewRenderTestInstance
@@ -1910,16 +1915,16 @@ void MultiViewDrawIndirectTestInstance::draw (const deUint32 subpassCount, VkRen
 		const size_t				dataSize			= static_cast<size_t>(drawCommandsLength * strideInBuffer);
 		const VkDeviceSize			bufferDataSize		= static_cast<VkDeviceSize>(deAlignSize(dataSize, nonCoherentAtomSize));
 		const VkBufferCreateInfo	bufferInfo			= makeBufferCreateInfo(bufferDataSize, VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT);
-		Move<VkBuffer>				indirectBuffer		= createBuffer(*m_device, *m_logicalDevice, &bufferInfo);
-		MovePtr<Allocation>			allocationBuffer	= m_allocator->allocate(getBufferMemoryRequirements(*m_device, *m_logicalDevice, *indirectBuffer),  MemoryRequirement::HostVisible);
+		Move<VkBuffer>				indirectBuffer		= createBuffer(*m_device, m_logicalDevice, &bufferInfo);
+		MovePtr<Allocation>			allocationBuffer	= m_allocator->allocate(getBufferMemoryRequirements(*m_device, m_logicalDevice, *indirectBuffer),  MemoryRequirement::HostVisible);
 
 		DE_ASSERT(drawCommandsLength != 0);
 
-		VK_CHECK(m_device->bindBufferMemory(*m_logicalDevice, *indirectBuffer, allocationBuffer->getMemory(), allocationBuffer->getOffset()));
+		VK_CHECK(m_device->bindBufferMemory(m_logicalDevice, *indirectBuffer, allocationBuffer->getMemory(), allocationBuffer->getOffset()));
 
 		deMemcpy(allocationBuffer->getHostPtr(), drawCommandsDataPtr, static_cast<size_t>(dataSize));
 
-		flushMappedMemoryRange(*m_device, *m_logicalDevice, allocationBuffer->getMemory(), allocationBuffer->getOffset(), static_cast<size_t>(bufferDataSize));
+		flushMappedMemoryRange(*m_device, m_logicalDevice, allocationBuffer->getMemory(), allocationBuffer->getOffset(), static_cast<size_t>(bufferDataSize));
 		indirectBuffers[subpassNdx] = (BufferSP(new Unique<VkBuffer>(indirectBuffer)));
 		indirectAllocations[subpassNdx] = (AllocationSP(new UniquePtr<Allocation>(allocationBuffer)));
 	}
@@ -1977,7 +1982,7 @@ void MultiViewDrawIndirectTestInstance::draw (const deUint32 subpassCount, VkRen
 	afterDraw();
 
 	VK_CHECK(m_device->endCommandBuffer(*m_cmdBuffer));
-	submitCommandsAndWait(*m_device, *m_logicalDevice, m_queue, *m_cmdBuffer);
+	submitCommandsAndWait(*m_device, m_logicalDevice, m_queue, *m_cmdBuffer);
 }
 
 class MultiViewClearAttachmentsTestInstance : public MultiViewRenderTestInstance
@@ -2076,7 +2081,7 @@ void MultiViewClearAttachmentsTestInstance::draw (const deUint32 subpassCount, V
 	afterDraw();
 
 	VK_CHECK(m_device->endCommandBuffer(*m_cmdBuffer));
-	submitCommandsAndWait(*m_device, *m_logicalDevice, m_queue, *m_cmdBuffer);
+	submitCommandsAndWait(*m_device, m_logicalDevice, m_queue, *m_cmdBuffer);
 }
 
 class MultiViewSecondaryCommandBufferTestInstance : public MultiViewRenderTestInstance
@@ -2134,7 +2139,7 @@ void MultiViewSecondaryCommandBufferTestInstance::draw (const deUint32 subpassCo
 
 	for (deUint32 subpassNdx = 0u; subpassNdx < subpassCount; subpassNdx++)
 	{
-		cmdBufferSecondary.push_back(VkCommandBufferSp(new Unique<VkCommandBuffer>(allocateCommandBuffer(*m_device, *m_logicalDevice, &cmdBufferAllocateInfo))));
+		cmdBufferSecondary.push_back(VkCommandBufferSp(new Unique<VkCommandBuffer>(allocateCommandBuffer(*m_device, m_logicalDevice, &cmdBufferAllocateInfo))));
 
 		beginSecondaryCommandBuffer(*m_device, cmdBufferSecondary.back().get()->get(), renderPass, subpassNdx, frameBuffer);
 		m_device->cmdBindVertexBuffers(cmdBufferSecondary.back().get()->get(), 0u, DE_LENGTH_OF_ARRAY(vertexBuffers), vertexBuffers, vertexBufferOffsets);
@@ -2155,7 +2160,7 @@ void MultiViewSecondaryCommandBufferTestInstance::draw (const deUint32 subpassCo
 	afterDraw();
 
 	VK_CHECK(m_device->endCommandBuffer(*m_cmdBuffer));
-	submitCommandsAndWait(*m_device, *m_logicalDevice, m_queue, *m_cmdBuffer);
+	submitCommandsAndWait(*m_device, m_logicalDevice, m_queue, *m_cmdBuffer);
 }
 
 class MultiViewPointSizeTestInstance : public MultiViewRenderTestInstance
@@ -2254,7 +2259,7 @@ void MultiViewPointSizeTestInstance::draw (const deUint32 subpassCount, VkRender
 	afterDraw();
 
 	VK_CHECK(m_device->endCommandBuffer(*m_cmdBuffer));
-	submitCommandsAndWait(*m_device, *m_logicalDevice, m_queue, *m_cmdBuffer);
+	submitCommandsAndWait(*m_device, m_logicalDevice, m_queue, *m_cmdBuffer);
 }
 
 class MultiViewMultsampleTestInstance : public MultiViewRenderTestInstance
@@ -2278,7 +2283,7 @@ MultiViewMultsampleTestInstance::MultiViewMultsampleTestInstance (Context& conte
 	: MultiViewRenderTestInstance	(context, parameters)
 {
 	// Color attachment
-	m_resolveAttachment = de::SharedPtr<ImageAttachment>(new ImageAttachment(*m_logicalDevice, *m_device, *m_allocator, m_parameters.extent, m_parameters.colorFormat, VK_SAMPLE_COUNT_1_BIT));
+	m_resolveAttachment = de::SharedPtr<ImageAttachment>(new ImageAttachment(m_logicalDevice, *m_device, *m_allocator, m_parameters.extent, m_parameters.colorFormat, VK_SAMPLE_COUNT_1_BIT));
 }
 
 tcu::TestStatus MultiViewMultsampleTestInstance::iterate (void)
@@ -2286,14 +2291,14 @@ tcu::TestStatus MultiViewMultsampleTestInstance::iterate (void)
 	const deUint32								subpassCount				= static_cast<deUint32>(m_parameters.viewMasks.size());
 
 	// FrameBuffer & renderPass
-	Unique<VkRenderPass>						renderPass					(makeRenderPass (*m_device, *m_logicalDevice, m_parameters.colorFormat, m_parameters.viewMasks, m_parameters.renderPassType, VK_SAMPLE_COUNT_4_BIT));
+	Unique<VkRenderPass>						renderPass					(makeRenderPass (*m_device, m_logicalDevice, m_parameters.colorFormat, m_parameters.viewMasks, m_parameters.renderPassType, VK_SAMPLE_COUNT_4_BIT));
 
 	vector<VkImageView>							attachments;
 	attachments.push_back(m_colorAttachment->getImageView());
-	Unique<VkFramebuffer>						frameBuffer					(makeFramebuffer(*m_device, *m_logicalDevice, *renderPass, attachments, m_parameters.extent.width, m_parameters.extent.height, 1u));
+	Unique<VkFramebuffer>						frameBuffer					(makeFramebuffer(*m_device, m_logicalDevice, *renderPass, attachments, m_parameters.extent.width, m_parameters.extent.height, 1u));
 
 	// pipelineLayout
-	Unique<VkPipelineLayout>					pipelineLayout				(makePipelineLayout(*m_device, *m_logicalDevice));
+	Unique<VkPipelineLayout>					pipelineLayout				(makePipelineLayout(*m_device, m_logicalDevice));
 
 	// pipelines
 	map<VkShaderStageFlagBits, ShaderModuleSP>	shaderModule;
@@ -2412,7 +2417,7 @@ void MultiViewMultsampleTestInstance::draw (const deUint32 subpassCount, VkRende
 	m_device->cmdResolveImage(*m_cmdBuffer, m_colorAttachment->getImage(), VK_IMAGE_LAYOUT_GENERAL, m_resolveAttachment->getImage(), VK_IMAGE_LAYOUT_GENERAL, 1u, &imageResolveRegion);
 
 	VK_CHECK(m_device->endCommandBuffer(*m_cmdBuffer));
-	submitCommandsAndWait(*m_device, *m_logicalDevice, m_queue, *m_cmdBuffer);
+	submitCommandsAndWait(*m_device, m_logicalDevice, m_queue, *m_cmdBuffer);
 }
 
 void MultiViewMultsampleTestInstance::afterDraw (void)
@@ -2480,10 +2485,10 @@ MultiViewQueriesTestInstance::MultiViewQueriesTestInstance (Context& context, co
 tcu::TestStatus MultiViewQueriesTestInstance::iterate (void)
 {
 	const deUint32								subpassCount			= static_cast<deUint32>(m_parameters.viewMasks.size());
-	Unique<VkRenderPass>						renderPass				(makeRenderPass (*m_device, *m_logicalDevice, m_parameters.colorFormat, m_parameters.viewMasks, m_parameters.renderPassType));
+	Unique<VkRenderPass>						renderPass				(makeRenderPass (*m_device, m_logicalDevice, m_parameters.colorFormat, m_parameters.viewMasks, m_parameters.renderPassType));
 	vector<VkImageView>							attachments				(1u, m_colorAttachment->getImageView());
-	Unique<VkFramebuffer>						frameBuffer				(makeFramebuffer(*m_device, *m_logicalDevice, *renderPass, attachments, m_parameters.extent.width, m_parameters.extent.height, 1u));
-	Unique<VkPipelineLayout>					pipelineLayout			(makePipelineLayout(*m_device, *m_logicalDevice));
+	Unique<VkFramebuffer>						frameBuffer				(makeFramebuffer(*m_device, m_logicalDevice, *renderPass, attachments, m_parameters.extent.width, m_parameters.extent.height, 1u));
+	Unique<VkPipelineLayout>					pipelineLayout			(makePipelineLayout(*m_device, m_logicalDevice));
 	vector<PipelineSp>							pipelines				(subpassCount);
 	deUint64									occlusionValue			= 0;
 	deUint64									occlusionExpectedValue	= 0;
@@ -2640,9 +2645,9 @@ void MultiViewQueriesTestInstance::draw (const deUint32 subpassCount, VkRenderPa
 		queryCountersNumber,						//  deUint32						queryCount;
 		0u,											//  VkQueryPipelineStatisticFlags	pipelineStatistics;
 	};
-	const Unique<VkQueryPool>	occlusionQueryPool				(createQueryPool(*m_device, *m_logicalDevice, &occlusionQueryPoolCreateInfo));
-	const Unique<VkQueryPool>	timestampStartQueryPool			(createQueryPool(*m_device, *m_logicalDevice, &timestampQueryPoolCreateInfo));
-	const Unique<VkQueryPool>	timestampEndQueryPool			(createQueryPool(*m_device, *m_logicalDevice, &timestampQueryPoolCreateInfo));
+	const Unique<VkQueryPool>	occlusionQueryPool				(createQueryPool(*m_device, m_logicalDevice, &occlusionQueryPoolCreateInfo));
+	const Unique<VkQueryPool>	timestampStartQueryPool			(createQueryPool(*m_device, m_logicalDevice, &timestampQueryPoolCreateInfo));
+	const Unique<VkQueryPool>	timestampEndQueryPool			(createQueryPool(*m_device, m_logicalDevice, &timestampQueryPoolCreateInfo));
 	VkQueryControlFlags			occlusionQueryFlags				= VK_QUERY_CONTROL_PRECISE_BIT;
 	deUint32					queryStartIndex					= 0;
 
@@ -2701,18 +2706,18 @@ void MultiViewQueriesTestInstance::draw (const deUint32 subpassCount, VkRenderPa
 	afterDraw();
 
 	VK_CHECK(m_device->endCommandBuffer(*m_cmdBuffer));
-	submitCommandsAndWait(*m_device, *m_logicalDevice, m_queue, *m_cmdBuffer);
+	submitCommandsAndWait(*m_device, m_logicalDevice, m_queue, *m_cmdBuffer);
 
 	m_occlusionValues.resize(queryCountersNumber, 0ull);
-	m_device->getQueryPoolResults(*m_logicalDevice, *occlusionQueryPool, 0u, queryCountersNumber, sizeof(deUint64) * queryCountersNumber, (void*)&m_occlusionValues[0], sizeof(deUint64), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+	m_device->getQueryPoolResults(m_logicalDevice, *occlusionQueryPool, 0u, queryCountersNumber, sizeof(deUint64) * queryCountersNumber, (void*)&m_occlusionValues[0], sizeof(deUint64), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
 
 	m_timestampStartValues.resize(queryCountersNumber, 0ull);
-	m_device->getQueryPoolResults(*m_logicalDevice, *timestampStartQueryPool, 0u, queryCountersNumber, sizeof(deUint64) * queryCountersNumber, (void*)&m_timestampStartValues[0], sizeof(deUint64), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+	m_device->getQueryPoolResults(m_logicalDevice, *timestampStartQueryPool, 0u, queryCountersNumber, sizeof(deUint64) * queryCountersNumber, (void*)&m_timestampStartValues[0], sizeof(deUint64), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
 	for (deUint32 ndx = 0; ndx < m_timestampStartValues.size(); ++ndx)
 		m_timestampStartValues[ndx] &= m_timestampMask;
 
 	m_timestampEndValues.resize(queryCountersNumber, 0ull);
-	m_device->getQueryPoolResults(*m_logicalDevice, *timestampEndQueryPool, 0u, queryCountersNumber, sizeof(deUint64) * queryCountersNumber, (void*)&m_timestampEndValues[0], sizeof(deUint64), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+	m_device->getQueryPoolResults(m_logicalDevice, *timestampEndQueryPool, 0u, queryCountersNumber, sizeof(deUint64) * queryCountersNumber, (void*)&m_timestampEndValues[0], sizeof(deUint64), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
 	for (deUint32 ndx = 0; ndx < m_timestampEndValues.size(); ++ndx)
 		m_timestampEndValues[ndx] &= m_timestampMask;
 }
@@ -2786,10 +2791,10 @@ tcu::TestStatus MultiViewReadbackTestInstance::iterate (void)
 																	  (m_parameters.viewIndex == TEST_TYPE_READBACK_WITH_IMPLICIT_CLEAR) ? VK_ATTACHMENT_LOAD_OP_CLEAR :
 																	  (m_parameters.viewIndex == TEST_TYPE_READBACK_WITH_EXPLICIT_CLEAR) ? VK_ATTACHMENT_LOAD_OP_DONT_CARE :
 																	  VK_ATTACHMENT_LOAD_OP_LAST;
-		Unique<VkRenderPass>						renderPass		(makeRenderPass (*m_device, *m_logicalDevice, m_parameters.colorFormat, m_parameters.viewMasks, m_parameters.renderPassType, VK_SAMPLE_COUNT_1_BIT, loadOp));
+		Unique<VkRenderPass>						renderPass		(makeRenderPass (*m_device, m_logicalDevice, m_parameters.colorFormat, m_parameters.viewMasks, m_parameters.renderPassType, VK_SAMPLE_COUNT_1_BIT, loadOp));
 		vector<VkImageView>							attachments		(1u, m_colorAttachment->getImageView());
-		Unique<VkFramebuffer>						frameBuffer		(makeFramebuffer(*m_device, *m_logicalDevice, *renderPass, attachments, m_parameters.extent.width, m_parameters.extent.height, 1u));
-		Unique<VkPipelineLayout>					pipelineLayout	(makePipelineLayout(*m_device, *m_logicalDevice));
+		Unique<VkFramebuffer>						frameBuffer		(makeFramebuffer(*m_device, m_logicalDevice, *renderPass, attachments, m_parameters.extent.width, m_parameters.extent.height, 1u));
+		Unique<VkPipelineLayout>					pipelineLayout	(makePipelineLayout(*m_device, m_logicalDevice));
 		vector<PipelineSp>							pipelines		(subpassCount);
 		map<VkShaderStageFlagBits, ShaderModuleSP>	shaderModule;
 
@@ -2869,7 +2874,7 @@ void MultiViewReadbackTestInstance::drawClears (const deUint32 subpassCount, VkR
 		afterDraw();
 
 	VK_CHECK(m_device->endCommandBuffer(*m_cmdBuffer));
-	submitCommandsAndWait(*m_device, *m_logicalDevice, m_queue, *m_cmdBuffer);
+	submitCommandsAndWait(*m_device, m_logicalDevice, m_queue, *m_cmdBuffer);
 }
 
 void MultiViewReadbackTestInstance::clear (const VkCommandBuffer commandBuffer, const VkRect2D& clearRect2D, const tcu::Vec4& clearColor)
@@ -2939,7 +2944,7 @@ MultiViewDepthStencilTestInstance::MultiViewDepthStencilTestInstance (Context& c
 		TCU_FAIL("Supported depth/stencil format not found, that violates specification");
 
 	// Depth/stencil attachment
-	m_dsAttachment = de::SharedPtr<ImageAttachment>(new ImageAttachment(*m_logicalDevice, *m_device, *m_allocator, m_parameters.extent, m_dsFormat));
+	m_dsAttachment = de::SharedPtr<ImageAttachment>(new ImageAttachment(m_logicalDevice, *m_device, *m_allocator, m_parameters.extent, m_dsFormat));
 }
 
 vector<VkImageView>	MultiViewDepthStencilTestInstance::makeAttachmentsVector (void)
@@ -2977,12 +2982,12 @@ void MultiViewDepthStencilTestInstance::readImage (VkImage image, const tcu::Pix
 			&m_queueFamilyIndex,					// const deUint32*		pQueueFamilyIndices;
 		};
 
-		buffer		= createBuffer(*m_device, *m_logicalDevice, &bufferParams);
-		bufferAlloc	= m_allocator->allocate(getBufferMemoryRequirements(*m_device, *m_logicalDevice, *buffer), MemoryRequirement::HostVisible);
-		VK_CHECK(m_device->bindBufferMemory(*m_logicalDevice, *buffer, bufferAlloc->getMemory(), bufferAlloc->getOffset()));
+		buffer		= createBuffer(*m_device, m_logicalDevice, &bufferParams);
+		bufferAlloc	= m_allocator->allocate(getBufferMemoryRequirements(*m_device, m_logicalDevice, *buffer), MemoryRequirement::HostVisible);
+		VK_CHECK(m_device->bindBufferMemory(m_logicalDevice, *buffer, bufferAlloc->getMemory(), bufferAlloc->getOffset()));
 
 		deMemset(bufferAlloc->getHostPtr(), 0xCC, static_cast<size_t>(pixelDataSize));
-		flushMappedMemoryRange(*m_device, *m_logicalDevice, bufferAlloc->getMemory(), bufferAlloc->getOffset(), pixelDataSize);
+		flushMappedMemoryRange(*m_device, m_logicalDevice, bufferAlloc->getMemory(), bufferAlloc->getOffset(), pixelDataSize);
 	}
 
 	const VkBufferMemoryBarrier	bufferBarrier	=
@@ -3027,10 +3032,10 @@ void MultiViewDepthStencilTestInstance::readImage (VkImage image, const tcu::Pix
 		m_device->cmdPipelineBarrier(*m_cmdBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, (VkDependencyFlags)0, 0, (const VkMemoryBarrier*)DE_NULL, 1, &bufferBarrier, 0u, DE_NULL);
 	}
 	VK_CHECK(m_device->endCommandBuffer(*m_cmdBuffer));
-	submitCommandsAndWait(*m_device, *m_logicalDevice, m_queue, *m_cmdBuffer);
+	submitCommandsAndWait(*m_device, m_logicalDevice, m_queue, *m_cmdBuffer);
 
 	// Read buffer data
-	invalidateMappedMemoryRange(*m_device, *m_logicalDevice, bufferAlloc->getMemory(), bufferAlloc->getOffset(), pixelDataSize);
+	invalidateMappedMemoryRange(*m_device, m_logicalDevice, bufferAlloc->getMemory(), bufferAlloc->getOffset(), pixelDataSize);
 
 	if (m_depthTest)
 	{
@@ -3079,10 +3084,10 @@ void MultiViewDepthStencilTestInstance::readImage (VkImage image, const tcu::Pix
 tcu::TestStatus MultiViewDepthStencilTestInstance::iterate (void)
 {
 	const deUint32								subpassCount				= static_cast<deUint32>(m_parameters.viewMasks.size());
-	Unique<VkRenderPass>						renderPass					(makeRenderPassWithDepth (*m_device, *m_logicalDevice, m_parameters.colorFormat, m_parameters.viewMasks, m_dsFormat, m_parameters.renderPassType));
+	Unique<VkRenderPass>						renderPass					(makeRenderPassWithDepth (*m_device, m_logicalDevice, m_parameters.colorFormat, m_parameters.viewMasks, m_dsFormat, m_parameters.renderPassType));
 	vector<VkImageView>							attachments					(makeAttachmentsVector());
-	Unique<VkFramebuffer>						frameBuffer					(makeFramebuffer(*m_device, *m_logicalDevice, *renderPass, attachments, m_parameters.extent.width, m_parameters.extent.height, 1u));
-	Unique<VkPipelineLayout>					pipelineLayout				(makePipelineLayout(*m_device, *m_logicalDevice));
+	Unique<VkFramebuffer>						frameBuffer					(makeFramebuffer(*m_device, m_logicalDevice, *renderPass, attachments, m_parameters.extent.width, m_parameters.extent.height, 1u));
+	Unique<VkPipelineLayout>					pipelineLayout				(makePipelineLayout(*m_device, m_logicalDevice));
 	map<VkShaderStageFlagBits, ShaderModuleSP>	shaderModule;
 	vector<PipelineSp>							pipelines(subpassCount);
 
@@ -3253,7 +3258,7 @@ void MultiViewDepthStencilTestInstance::draw (const deUint32 subpassCount, VkRen
 	afterDraw();
 
 	VK_CHECK(m_device->endCommandBuffer(*m_cmdBuffer));
-	submitCommandsAndWait(*m_device, *m_logicalDevice, m_queue, *m_cmdBuffer);
+	submitCommandsAndWait(*m_device, m_logicalDevice, m_queue, *m_cmdBuffer);
 }
 
 void MultiViewDepthStencilTestInstance::beforeDraw (void)
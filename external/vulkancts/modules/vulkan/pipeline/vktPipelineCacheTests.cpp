@@ -1012,22 +1012,21 @@ tcu::TestStatus GraphicsCacheTestInstance::verifyTestResult (void)
 	const deUint32          queueFamilyIndex = m_context.getUniversalQueueFamilyIndex();
 
 	const VkQueue                   queue               = m_context.getUniversalQueue();
-	de::MovePtr<tcu::TextureLevel>  resultNoCache       = readColorAttachment(vk,
-																			  vkDevice,
-																			  queue,
-																			  queueFamilyIndex,
-																			  m_context.getDefaultAllocator(),
-																			  *m_colorImage[PIPELINE_CACHE_NDX_NO_CACHE],
-																			  m_colorFormat,
-																			  m_renderSize);
-	de::MovePtr<tcu::TextureLevel>  resultCache         = readColorAttachment(vk,
-																			  vkDevice,
-																			  queue,
-																			  queueFamilyIndex,
-																			  m_context.getDefaultAllocator(),
-																			  *m_colorImage[PIPELINE_CACHE_NDX_CACHED],
-																			  m_colorFormat,
-																			  m_renderSize);
+	std::vector<VkImage>            colorImages         (PIPELINE_CACHE_NDX_COUNT);
+
+	colorImages[PIPELINE_CACHE_NDX_NO_CACHE]	= *m_colorImage[PIPELINE_CACHE_NDX_NO_CACHE];
+	colorImages[PIPELINE_CACHE_NDX_CACHED]		= *m_colorImage[PIPELINE_CACHE_NDX_CACHED];
+
+	const std::vector<de::SharedPtr<tcu::TextureLevel> > results = readColorAttachments(vk,
+																						 vkDevice,
+																						 queue,
+																						 queueFamilyIndex,
+																						 m_context.getDefaultAllocator(),
+																						 colorImages,
+																						 m_colorFormat,
+																						 m_renderSize);
+	const de::SharedPtr<tcu::TextureLevel>  resultNoCache   = results[PIPELINE_CACHE_NDX_NO_CACHE];
+	const de::SharedPtr<tcu::TextureLevel>  resultCache     = results[PIPELINE_CACHE_NDX_CACHED];
 
 	bool compareOk = tcu::intThresholdCompare(m_context.getTestContext().getLog(),
 											  "IntImageCompare",
@@ -218,6 +218,32 @@ void getLookupScaleBias (vk::VkFormat format, tcu::Vec4& lookupScale, tcu::Vec4&
 	}
 }
 
+static de::MovePtr<Allocation> createReadbackBuffer (const vk::DeviceInterface&	vk,
+													 vk::VkDevice				device,
+													 vk::Allocator&				allocator,
+													 VkDeviceSize				size,
+													 Move<VkBuffer>&			buffer)
+{
+	const VkBufferCreateInfo bufferParams =
+	{
+		VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,		// VkStructureType		sType;
+		DE_NULL,									// const void*			pNext;
+		0u,											// VkBufferCreateFlags	flags;
+		size,										// VkDeviceSize			size;
+		VK_BUFFER_USAGE_TRANSFER_DST_BIT,			// VkBufferUsageFlags	usage;
+		VK_SHARING_MODE_EXCLUSIVE,					// VkSharingMode		sharingMode;
+		0u,											// deUint32				queueFamilyIndexCount;
+		DE_NULL										// const deUint32*		pQueueFamilyIndices;
+	};
+
+	buffer = createBuffer(vk, device, &bufferParams);
+
+	de::MovePtr<Allocation> bufferAlloc = allocator.allocate(getBufferMemoryRequirements(vk, device, *buffer), MemoryRequirement::HostVisible);
+	VK_CHECK(vk.bindBufferMemory(device, *buffer, bufferAlloc->getMemory(), bufferAlloc->getOffset()));
+
+	return bufferAlloc;
+}
+
 de::MovePtr<tcu::TextureLevel> readColorAttachment (const vk::DeviceInterface&	vk,
 													vk::VkDevice				device,
 													vk::VkQueue					queue,
@@ -228,51 +254,71 @@ de::MovePtr<tcu::TextureLevel> readColorAttachment (const vk::DeviceInterface&	v
 													const tcu::UVec2&			renderSize)
 {
 	Move<VkBuffer>					buffer;
-	de::MovePtr<Allocation>			bufferAlloc;
-	Move<VkCommandPool>				cmdPool;
-	Move<VkCommandBuffer>			cmdBuffer;
-	Move<VkFence>					fence;
 	const tcu::TextureFormat		tcuFormat		= mapVkFormat(format);
 	const VkDeviceSize				pixelDataSize	= renderSize.x() * renderSize.y() * tcuFormat.getPixelSize();
 	de::MovePtr<tcu::TextureLevel>	resultLevel		(new tcu::TextureLevel(tcuFormat, renderSize.x(), renderSize.y()));
+	de::MovePtr<Allocation>			bufferAlloc		= createReadbackBuffer(vk, device, allocator, pixelDataSize, buffer);
 
-	// Create destination buffer
 	{
-		const VkBufferCreateInfo bufferParams =
-		{
-			VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,		// VkStructureType		sType;
-			DE_NULL,									// const void*			pNext;
-			0u,											// VkBufferCreateFlags	flags;
-			pixelDataSize,								// VkDeviceSize			size;
-			VK_BUFFER_USAGE_TRANSFER_DST_BIT,			// VkBufferUsageFlags	usage;
-			VK_SHARING_MODE_EXCLUSIVE,					// VkSharingMode		sharingMode;
-			0u,											// deUint32				queueFamilyIndexCount;
-			DE_NULL										// const deUint32*		pQueueFamilyIndices;
-		};
+		PooledCommandBuffer cmdBuffer (vk, device, queue, queueFamilyIndex);
 
-		buffer		= createBuffer(vk, device, &bufferParams);
-		bufferAlloc = allocator.allocate(getBufferMemoryRequirements(vk, device, *buffer), MemoryRequirement::HostVisible);
-		VK_CHECK(vk.bindBufferMemory(device, *buffer, bufferAlloc->getMemory(), bufferAlloc->getOffset()));
+		copyImageToBuffer(vk, *cmdBuffer, image, *buffer, tcu::IVec2(renderSize.x(), renderSize.y()));
+		cmdBuffer.submitAndWait();
 	}
 
-	// Create command pool and buffer
-	cmdPool		= createCommandPool(vk, device, VK_COMMAND_POOL_CREATE_TRANSIENT_BIT, queueFamilyIndex);
-	cmdBuffer	= allocateCommandBuffer(vk, device, *cmdPool, VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+	// Read buffer data
+	invalidateAlloc(vk, device, *bufferAlloc);
+	tcu::copy(*resultLevel, tcu::ConstPixelBufferAccess(resultLevel->getFormat(), resultLevel->getSize(), bufferAlloc->getHostPtr()));
+
+	return resultLevel;
+}
+
+std::vector<de::SharedPtr<tcu::TextureLevel> > readColorAttachments (const vk::DeviceInterface&			vk,
+																	 vk::VkDevice						device,
+																	 vk::VkQueue						queue,
+																	 deUint32							queueFamilyIndex,
+																	 vk::Allocator&						allocator,
+																	 const std::vector<vk::VkImage>&	images,
+																	 vk::VkFormat						format,
+																	 const tcu::UVec2&					renderSize)
+{
+	const tcu::TextureFormat						tcuFormat		= mapVkFormat(format);
+	const VkDeviceSize								pixelDataSize	= renderSize.x() * renderSize.y() * tcuFormat.getPixelSize();
+	std::vector<de::SharedPtr<Unique<VkBuffer> > >	buffers;
+	std::vector<de::SharedPtr<Allocation> >			bufferAllocs;
+	std::vector<de::SharedPtr<tcu::TextureLevel> >	resultLevels;
+
+	for (size_t imageNdx = 0; imageNdx < images.size(); ++imageNdx)
+	{
+		Move<VkBuffer>			buffer;
+		de::MovePtr<Allocation>	bufferAlloc	= createReadbackBuffer(vk, device, allocator, pixelDataSize, buffer);
+
+		buffers.push_back(de::SharedPtr<Unique<VkBuffer> >(new Unique<VkBuffer>(buffer)));
+		bufferAllocs.push_back(de::SharedPtr<Allocation>(bufferAlloc.release()));
+	}
 
-	// Create fence
-	fence = createFence(vk, device);
+	// One command buffer per copy, all waited for with a single fence
+	{
+		SubmissionBatch batch (vk, device, queue, queueFamilyIndex);
 
-	beginCommandBuffer(vk, *cmdBuffer);
-	copyImageToBuffer(vk, *cmdBuffer, image, *buffer, tcu::IVec2(renderSize.x(), renderSize.y()));
-	endCommandBuffer(vk, *cmdBuffer);
+		for (size_t imageNdx = 0; imageNdx < images.size(); ++imageNdx)
+			copyImageToBuffer(vk, batch.record(), images[imageNdx], **buffers[imageNdx], tcu::IVec2(renderSize.x(), renderSize.y()));
 
-	submitCommandsAndWait(vk, device, queue, cmdBuffer.get());
+		batch.submitAndWait();
+	}
 
 	// Read buffer data
-	invalidateAlloc(vk, device, *bufferAlloc);
-	tcu::copy(*resultLevel, tcu::ConstPixelBufferAccess(resultLevel->getFormat(), resultLevel->getSize(), bufferAlloc->getHostPtr()));
+	for (size_t imageNdx = 0; imageNdx < images.size(); ++imageNdx)
+	{
+		de::SharedPtr<tcu::TextureLevel> resultLevel (new tcu::TextureLevel(tcuFormat, renderSize.x(), renderSize.y()));
 
-	return resultLevel;
+		invalidateAlloc(vk, device, *bufferAllocs[imageNdx]);
+		tcu::copy(*resultLevel, tcu::ConstPixelBufferAccess(resultLevel->getFormat(), resultLevel->getSize(), bufferAllocs[imageNdx]->getHostPtr()));
+
+		resultLevels.push_back(resultLevel);
+	}
+
+	return resultLevels;
 }
 
 void uploadTestTextureInternal (const DeviceInterface&	vk,
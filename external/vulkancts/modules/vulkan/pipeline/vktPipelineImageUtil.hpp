@@ -85,6 +85,20 @@ de::MovePtr<tcu::TextureLevel>	readColorAttachment			 (const vk::DeviceInterface
 															  vk::VkFormat					format,
 															  const tcu::UVec2&				renderSize);
 
+/*--------------------------------------------------------------------*//*!
+ * Reads several VK color attachments of the same format and size with
+ * a single queue submission. See readColorAttachment().
+ *//*--------------------------------------------------------------------*/
+std::vector<de::SharedPtr<tcu::TextureLevel> >
+								readColorAttachments		 (const vk::DeviceInterface&	vk,
+															  vk::VkDevice					device,
+															  vk::VkQueue					queue,
+															  deUint32						queueFamilyIndex,
+															  vk::Allocator&				allocator,
+															  const std::vector<vk::VkImage>&	images,
+															  vk::VkFormat					format,
+															  const tcu::UVec2&				renderSize);
+
 /*--------------------------------------------------------------------*//*!
  * Uploads data from a test texture to a destination VK image.
  *
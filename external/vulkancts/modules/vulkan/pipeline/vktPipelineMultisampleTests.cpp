@@ -41,6 +41,7 @@
 #include "vkCmdUtil.hpp"
 #include "vkTypeUtil.hpp"
 #include "vkObjUtil.hpp"
+#include "vkReadbackQueue.hpp"
 #include "tcuImageCompare.hpp"
 #include "tcuTestLog.hpp"
 #include "deUniquePtr.hpp"
@@ -316,7 +317,7 @@ public:
 	virtual										~MultisampleRenderer		(void);
 
 	de::MovePtr<tcu::TextureLevel>				render						(void);
-	de::MovePtr<tcu::TextureLevel>				getSingleSampledImage		(deUint32 sampleId);
+	vk::ReadbackQueue::Request					readSingleSampledImage		(vk::ReadbackQueue& readback, deUint32 sampleId);
 
 protected:
 	void										initialize					(Context&										context,
@@ -1362,10 +1363,21 @@ tcu::TestStatus MinSampleShadingInstance::iterate (void)
 		MultisampleRenderer renderer (m_context, m_colorFormat, m_renderSize, m_primitiveTopology, m_vertices, m_multisampleStateParams, m_colorBlendState, RENDER_TYPE_COPY_SAMPLES, m_backingMode);
 		renderer.render();
 
-		sampleShadedImages.resize(m_multisampleStateParams.rasterizationSamples);
+		ReadbackQueue&							readback	= m_context.getReadbackQueue();
+		std::vector<ReadbackQueue::Request>		requests	(m_multisampleStateParams.rasterizationSamples);
+
+		for (deUint32 sampleId = 0; sampleId < requests.size(); sampleId++)
+			requests[sampleId] = renderer.readSingleSampledImage(readback, sampleId);
+
+		readback.flush();
+
+		sampleShadedImages.resize(requests.size());
 		for (deUint32 sampleId = 0; sampleId < sampleShadedImages.size(); sampleId++)
 		{
-			sampleShadedImages[sampleId] = *renderer.getSingleSampledImage(sampleId);
+			const tcu::ConstPixelBufferAccess	result	= readback.wait(requests[sampleId]);
+
+			sampleShadedImages[sampleId].setStorage(result.getFormat(), result.getWidth(), result.getHeight());
+			tcu::copy(sampleShadedImages[sampleId].getAccess(), result);
 		}
 	}
 
@@ -2896,9 +2908,9 @@ de::MovePtr<tcu::TextureLevel> MultisampleRenderer::render (void)
 	}
 }
 
-de::MovePtr<tcu::TextureLevel> MultisampleRenderer::getSingleSampledImage (deUint32 sampleId)
+ReadbackQueue::Request MultisampleRenderer::readSingleSampledImage (ReadbackQueue& readback, deUint32 sampleId)
 {
-	return readColorAttachment(m_context.getDeviceInterface(), m_context.getDevice(), m_context.getUniversalQueue(), m_context.getUniversalQueueFamilyIndex(), m_context.getDefaultAllocator(), *m_perSampleImages[sampleId]->m_image, m_colorFormat, m_renderSize.cast<deUint32>());
+	return readback.enqueue(*m_perSampleImages[sampleId]->m_image, m_colorFormat, makeExtent3D(m_renderSize.x(), m_renderSize.y(), 1u), makeImageSubresourceLayers(VK_IMAGE_ASPECT_COLOR_BIT, 0u, 0u, 1u));
 }
 
 } // anonymous
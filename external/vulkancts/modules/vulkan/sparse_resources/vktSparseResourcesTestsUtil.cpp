@@ -25,6 +25,7 @@
 #include "vkQueryUtil.hpp"
 #include "vkDeviceUtil.hpp"
 #include "vkTypeUtil.hpp"
+#include "vkPipelineCacheUtil.hpp"
 #include "tcuTextureUtil.hpp"
 
 #include <deMath.h>
@@ -321,7 +322,7 @@ Move<VkPipeline> makeComputePipeline (const DeviceInterface&		vk,
 		DE_NULL,											// VkPipeline						basePipelineHandle;
 		0,													// deInt32							basePipelineIndex;
 	};
-	return createComputePipeline(vk, device, DE_NULL , &pipelineCreateInfo);
+	return createComputePipeline(vk, device, getDefaultPipelineCache(device), &pipelineCreateInfo);
 }
 
 Move<VkBufferView> makeBufferView (const DeviceInterface&	vk,
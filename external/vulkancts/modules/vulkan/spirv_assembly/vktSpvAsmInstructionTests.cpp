@@ -17873,36 +17873,36 @@ tcu::TestCaseGroup* createInstructionTests (tcu::TestContext& testCtx)
 	de::MovePtr<tcu::TestCaseGroup> graphicsTests		(new tcu::TestCaseGroup(testCtx, "graphics", "Graphics Instructions with special opcodes/operands"));
 
 	computeTests->addChild(createSpivVersionCheckTests(testCtx, testComputePipeline));
-	computeTests->addChild(createLocalSizeGroup(testCtx));
-	computeTests->addChild(createOpNopGroup(testCtx));
-	computeTests->addChild(createOpFUnordGroup(testCtx));
+	computeTests->addLazyChild("localsize", createLocalSizeGroup);
+	computeTests->addLazyChild("opnop", createOpNopGroup);
+	computeTests->addLazyChild("opfunord", createOpFUnordGroup);
 	computeTests->addChild(createOpAtomicGroup(testCtx, false));
 	computeTests->addChild(createOpAtomicGroup(testCtx, true));					// Using new StorageBuffer decoration
 	computeTests->addChild(createOpAtomicGroup(testCtx, false, 1024, true));	// Return value validation
-	computeTests->addChild(createOpLineGroup(testCtx));
-	computeTests->addChild(createOpModuleProcessedGroup(testCtx));
-	computeTests->addChild(createOpNoLineGroup(testCtx));
-	computeTests->addChild(createOpConstantNullGroup(testCtx));
-	computeTests->addChild(createOpConstantCompositeGroup(testCtx));
-	computeTests->addChild(createOpConstantUsageGroup(testCtx));
-	computeTests->addChild(createSpecConstantGroup(testCtx));
-	computeTests->addChild(createOpSourceGroup(testCtx));
-	computeTests->addChild(createOpSourceExtensionGroup(testCtx));
-	computeTests->addChild(createDecorationGroupGroup(testCtx));
-	computeTests->addChild(createOpPhiGroup(testCtx));
-	computeTests->addChild(createLoopControlGroup(testCtx));
-	computeTests->addChild(createFunctionControlGroup(testCtx));
-	computeTests->addChild(createSelectionControlGroup(testCtx));
-	computeTests->addChild(createBlockOrderGroup(testCtx));
-	computeTests->addChild(createMultipleShaderGroup(testCtx));
-	computeTests->addChild(createMemoryAccessGroup(testCtx));
-	computeTests->addChild(createOpCopyMemoryGroup(testCtx));
-	computeTests->addChild(createOpCopyObjectGroup(testCtx));
-	computeTests->addChild(createNoContractionGroup(testCtx));
-	computeTests->addChild(createOpUndefGroup(testCtx));
-	computeTests->addChild(createOpUnreachableGroup(testCtx));
-	computeTests->addChild(createOpQuantizeToF16Group(testCtx));
-	computeTests->addChild(createOpFRemGroup(testCtx));
+	computeTests->addLazyChild("opline", createOpLineGroup);
+	computeTests->addLazyChild("opmoduleprocessed", createOpModuleProcessedGroup);
+	computeTests->addLazyChild("opnoline", createOpNoLineGroup);
+	computeTests->addLazyChild("opconstantnull", createOpConstantNullGroup);
+	computeTests->addLazyChild("opconstantcomposite", createOpConstantCompositeGroup);
+	computeTests->addLazyChild("opconstantnullcomposite", createOpConstantUsageGroup);
+	computeTests->addLazyChild("opspecconstantop", createSpecConstantGroup);
+	computeTests->addLazyChild("opsource", createOpSourceGroup);
+	computeTests->addLazyChild("opsourceextension", createOpSourceExtensionGroup);
+	computeTests->addLazyChild("decoration_group", createDecorationGroupGroup);
+	computeTests->addLazyChild("opphi", createOpPhiGroup);
+	computeTests->addLazyChild("loop_control", createLoopControlGroup);
+	computeTests->addLazyChild("function_control", createFunctionControlGroup);
+	computeTests->addLazyChild("selection_control", createSelectionControlGroup);
+	computeTests->addLazyChild("block_order", createBlockOrderGroup);
+	computeTests->addLazyChild("multiple_shaders", createMultipleShaderGroup);
+	computeTests->addLazyChild("memory_access", createMemoryAccessGroup);
+	computeTests->addLazyChild("opcopymemory", createOpCopyMemoryGroup);
+	computeTests->addLazyChild("opcopyobject", createOpCopyObjectGroup);
+	computeTests->addLazyChild("nocontraction", createNoContractionGroup);
+	computeTests->addLazyChild("opundef", createOpUndefGroup);
+	computeTests->addLazyChild("opunreachable", createOpUnreachableGroup);
+	computeTests->addLazyChild("opquantize", createOpQuantizeToF16Group);
+	computeTests->addLazyChild("opfrem", createOpFRemGroup);
 	computeTests->addChild(createOpSRemComputeGroup(testCtx, QP_TEST_RESULT_PASS));
 	computeTests->addChild(createOpSRemComputeGroup64(testCtx, QP_TEST_RESULT_PASS));
 	computeTests->addChild(createOpSModComputeGroup(testCtx, QP_TEST_RESULT_PASS));
@@ -17914,12 +17914,12 @@ tcu::TestCaseGroup* createInstructionTests (tcu::TestContext& testCtx)
 	computeTests->addChild(createConvertComputeTests(testCtx, "OpConvertFToS", "convertftos"));
 	computeTests->addChild(createConvertComputeTests(testCtx, "OpConvertUToF", "convertutof"));
 	computeTests->addChild(createConvertComputeTests(testCtx, "OpConvertFToU", "convertftou"));
-	computeTests->addChild(createOpCompositeInsertGroup(testCtx));
-	computeTests->addChild(createOpInBoundsAccessChainGroup(testCtx));
-	computeTests->addChild(createShaderDefaultOutputGroup(testCtx));
-	computeTests->addChild(createOpNMinGroup(testCtx));
-	computeTests->addChild(createOpNMaxGroup(testCtx));
-	computeTests->addChild(createOpNClampGroup(testCtx));
+	computeTests->addLazyChild("opcompositeinsert", createOpCompositeInsertGroup);
+	computeTests->addLazyChild("opinboundsaccesschain", createOpInBoundsAccessChainGroup);
+	computeTests->addLazyChild("shader_default_output", createShaderDefaultOutputGroup);
+	computeTests->addLazyChild("opnmin", createOpNMinGroup);
+	computeTests->addLazyChild("opnmax", createOpNMaxGroup);
+	computeTests->addLazyChild("opnclamp", createOpNClampGroup);
 	{
 		de::MovePtr<tcu::TestCaseGroup>	computeAndroidTests	(new tcu::TestCaseGroup(testCtx, "android", "Android CTS Tests"));
 
@@ -17929,45 +17929,45 @@ tcu::TestCaseGroup* createInstructionTests (tcu::TestContext& testCtx)
 		computeTests->addChild(computeAndroidTests.release());
 	}
 
-	computeTests->addChild(create8BitStorageComputeGroup(testCtx));
-	computeTests->addChild(create16BitStorageComputeGroup(testCtx));
-	computeTests->addChild(createFloatControlsComputeGroup(testCtx));
-	computeTests->addChild(createUboMatrixPaddingComputeGroup(testCtx));
-	computeTests->addChild(createCompositeInsertComputeGroup(testCtx));
-	computeTests->addChild(createVariableInitComputeGroup(testCtx));
-	computeTests->addChild(createConditionalBranchComputeGroup(testCtx));
-	computeTests->addChild(createIndexingComputeGroup(testCtx));
-	computeTests->addChild(createVariablePointersComputeGroup(testCtx));
-	computeTests->addChild(createImageSamplerComputeGroup(testCtx));
-	computeTests->addChild(createOpNameGroup(testCtx));
-	computeTests->addChild(createOpMemberNameGroup(testCtx));
-	computeTests->addChild(createPointerParameterComputeGroup(testCtx));
-	computeTests->addChild(createFloat16Group(testCtx));
-
-	graphicsTests->addChild(createCrossStageInterfaceTests(testCtx));
+	computeTests->addLazyChild("8bit_storage", create8BitStorageComputeGroup);
+	computeTests->addLazyChild("16bit_storage", create16BitStorageComputeGroup);
+	computeTests->addLazyChild("float_controls", createFloatControlsComputeGroup);
+	computeTests->addLazyChild("ubo_padding", createUboMatrixPaddingComputeGroup);
+	computeTests->addLazyChild("composite_insert", createCompositeInsertComputeGroup);
+	computeTests->addLazyChild("variable_init", createVariableInitComputeGroup);
+	computeTests->addLazyChild("conditional_branch", createConditionalBranchComputeGroup);
+	computeTests->addLazyChild("indexing", createIndexingComputeGroup);
+	computeTests->addLazyChild("variable_pointers", createVariablePointersComputeGroup);
+	computeTests->addLazyChild("image_sampler", createImageSamplerComputeGroup);
+	computeTests->addLazyChild("opname", createOpNameGroup);
+	computeTests->addLazyChild("opmembername", createOpMemberNameGroup);
+	computeTests->addLazyChild("pointer_parameter", createPointerParameterComputeGroup);
+	computeTests->addLazyChild("float16", createFloat16Group);
+
+	graphicsTests->addLazyChild("cross_stage", createCrossStageInterfaceTests);
 	graphicsTests->addChild(createSpivVersionCheckTests(testCtx, !testComputePipeline));
-	graphicsTests->addChild(createOpNopTests(testCtx));
-	graphicsTests->addChild(createOpSourceTests(testCtx));
-	graphicsTests->addChild(createOpSourceContinuedTests(testCtx));
-	graphicsTests->addChild(createOpModuleProcessedTests(testCtx));
-	graphicsTests->addChild(createOpLineTests(testCtx));
-	graphicsTests->addChild(createOpNoLineTests(testCtx));
-	graphicsTests->addChild(createOpConstantNullTests(testCtx));
-	graphicsTests->addChild(createOpConstantCompositeTests(testCtx));
-	graphicsTests->addChild(createMemoryAccessTests(testCtx));
-	graphicsTests->addChild(createOpUndefTests(testCtx));
-	graphicsTests->addChild(createSelectionBlockOrderTests(testCtx));
-	graphicsTests->addChild(createModuleTests(testCtx));
-	graphicsTests->addChild(createSwitchBlockOrderTests(testCtx));
-	graphicsTests->addChild(createOpPhiTests(testCtx));
-	graphicsTests->addChild(createNoContractionTests(testCtx));
-	graphicsTests->addChild(createOpQuantizeTests(testCtx));
-	graphicsTests->addChild(createLoopTests(testCtx));
-	graphicsTests->addChild(createSpecConstantTests(testCtx));
-	graphicsTests->addChild(createSpecConstantOpQuantizeToF16Group(testCtx));
-	graphicsTests->addChild(createBarrierTests(testCtx));
-	graphicsTests->addChild(createDecorationGroupTests(testCtx));
-	graphicsTests->addChild(createFRemTests(testCtx));
+	graphicsTests->addLazyChild("opnop", createOpNopTests);
+	graphicsTests->addLazyChild("opsource", createOpSourceTests);
+	graphicsTests->addLazyChild("opsourcecontinued", createOpSourceContinuedTests);
+	graphicsTests->addLazyChild("opmoduleprocessed", createOpModuleProcessedTests);
+	graphicsTests->addLazyChild("opline", createOpLineTests);
+	graphicsTests->addLazyChild("opnoline", createOpNoLineTests);
+	graphicsTests->addLazyChild("opconstantnull", createOpConstantNullTests);
+	graphicsTests->addLazyChild("opconstantcomposite", createOpConstantCompositeTests);
+	graphicsTests->addLazyChild("opmemoryaccess", createMemoryAccessTests);
+	graphicsTests->addLazyChild("opundef", createOpUndefTests);
+	graphicsTests->addLazyChild("selection_block_order", createSelectionBlockOrderTests);
+	graphicsTests->addLazyChild("module", createModuleTests);
+	graphicsTests->addLazyChild("switch_block_order", createSwitchBlockOrderTests);
+	graphicsTests->addLazyChild("opphi", createOpPhiTests);
+	graphicsTests->addLazyChild("nocontraction", createNoContractionTests);
+	graphicsTests->addLazyChild("opquantize", createOpQuantizeTests);
+	graphicsTests->addLazyChild("loop", createLoopTests);
+	graphicsTests->addLazyChild("opspecconstantop", createSpecConstantTests);
+	graphicsTests->addLazyChild("opspecconstantop_opquantize", createSpecConstantOpQuantizeToF16Group);
+	graphicsTests->addLazyChild("barrier", createBarrierTests);
+	graphicsTests->addLazyChild("decoration_group", createDecorationGroupTests);
+	graphicsTests->addLazyChild("frem", createFRemTests);
 	graphicsTests->addChild(createOpSRemGraphicsTests(testCtx, QP_TEST_RESULT_PASS));
 	graphicsTests->addChild(createOpSModGraphicsTests(testCtx, QP_TEST_RESULT_PASS));
 
@@ -17979,20 +17979,20 @@ tcu::TestCaseGroup* createInstructionTests (tcu::TestContext& testCtx)
 
 		graphicsTests->addChild(graphicsAndroidTests.release());
 	}
-	graphicsTests->addChild(createOpNameTests(testCtx));
-	graphicsTests->addChild(createOpNameAbuseTests(testCtx));
-	graphicsTests->addChild(createOpMemberNameAbuseTests(testCtx));
-
-	graphicsTests->addChild(create8BitStorageGraphicsGroup(testCtx));
-	graphicsTests->addChild(create16BitStorageGraphicsGroup(testCtx));
-	graphicsTests->addChild(createFloatControlsGraphicsGroup(testCtx));
-	graphicsTests->addChild(createUboMatrixPaddingGraphicsGroup(testCtx));
-	graphicsTests->addChild(createCompositeInsertGraphicsGroup(testCtx));
-	graphicsTests->addChild(createVariableInitGraphicsGroup(testCtx));
-	graphicsTests->addChild(createConditionalBranchGraphicsGroup(testCtx));
-	graphicsTests->addChild(createIndexingGraphicsGroup(testCtx));
-	graphicsTests->addChild(createVariablePointersGraphicsGroup(testCtx));
-	graphicsTests->addChild(createImageSamplerGraphicsGroup(testCtx));
+	graphicsTests->addLazyChild("opname", createOpNameTests);
+	graphicsTests->addLazyChild("opname_abuse", createOpNameAbuseTests);
+	graphicsTests->addLazyChild("opmembername_abuse", createOpMemberNameAbuseTests);
+
+	graphicsTests->addLazyChild("8bit_storage", create8BitStorageGraphicsGroup);
+	graphicsTests->addLazyChild("16bit_storage", create16BitStorageGraphicsGroup);
+	graphicsTests->addLazyChild("float_controls", createFloatControlsGraphicsGroup);
+	graphicsTests->addLazyChild("ubo_padding", createUboMatrixPaddingGraphicsGroup);
+	graphicsTests->addLazyChild("composite_insert", createCompositeInsertGraphicsGroup);
+	graphicsTests->addLazyChild("variable_init", createVariableInitGraphicsGroup);
+	graphicsTests->addLazyChild("conditional_branch", createConditionalBranchGraphicsGroup);
+	graphicsTests->addLazyChild("indexing", createIndexingGraphicsGroup);
+	graphicsTests->addLazyChild("variable_pointers", createVariablePointersGraphicsGroup);
+	graphicsTests->addLazyChild("image_sampler", createImageSamplerGraphicsGroup);
 	graphicsTests->addChild(createConvertGraphicsTests(testCtx, "OpSConvert", "sconvert"));
 	graphicsTests->addChild(createConvertGraphicsTests(testCtx, "OpUConvert", "uconvert"));
 	graphicsTests->addChild(createConvertGraphicsTests(testCtx, "OpFConvert", "fconvert"));
@@ -18000,9 +18000,9 @@ tcu::TestCaseGroup* createInstructionTests (tcu::TestContext& testCtx)
 	graphicsTests->addChild(createConvertGraphicsTests(testCtx, "OpConvertFToS", "convertftos"));
 	graphicsTests->addChild(createConvertGraphicsTests(testCtx, "OpConvertUToF", "convertutof"));
 	graphicsTests->addChild(createConvertGraphicsTests(testCtx, "OpConvertFToU", "convertftou"));
-	graphicsTests->addChild(createPointerParameterGraphicsGroup(testCtx));
+	graphicsTests->addLazyChild("pointer_parameter", createPointerParameterGraphicsGroup);
 
-	graphicsTests->addChild(createFloat16Tests(testCtx));
+	graphicsTests->addLazyChild("float16", createFloat16Tests);
 
 	instructionTests->addChild(computeTests.release());
 	instructionTests->addChild(graphicsTests.release());
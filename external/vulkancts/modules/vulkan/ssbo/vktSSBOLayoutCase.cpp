@@ -1069,6 +1069,109 @@ glu::DataType getPromoteType(glu::DataType type)
 	}
 }
 
+const char* getRefLoadFuncForScalarType (glu::DataType type)
+{
+	switch (type)
+	{
+		case glu::TYPE_FLOAT:	return "highp float ref_float     (highp uint offset) { return uintBitsToFloat(ref_data[offset >> 2u]); }\n";
+		case glu::TYPE_INT:		return "highp int   ref_int       (highp uint offset) { return int(ref_data[offset >> 2u]); }\n";
+		case glu::TYPE_UINT:	return "highp uint  ref_uint      (highp uint offset) { return ref_data[offset >> 2u]; }\n";
+		case glu::TYPE_BOOL:	return "bool        ref_bool      (highp uint offset) { return ref_data[offset >> 2u] != 0u; }\n";
+		case glu::TYPE_FLOAT16:	return "highp float ref_float16_t (highp uint offset) { return unpackHalf2x16(ref_data[offset >> 2u] >> ((offset & 2u) * 8u)).x; }\n";
+		case glu::TYPE_INT8:	return "highp int   ref_int8_t    (highp uint offset) { return bitfieldExtract(int(ref_data[offset >> 2u]), int((offset & 3u) * 8u), 8); }\n";
+		case glu::TYPE_UINT8:	return "highp uint  ref_uint8_t   (highp uint offset) { return bitfieldExtract(ref_data[offset >> 2u], int((offset & 3u) * 8u), 8); }\n";
+		case glu::TYPE_INT16:	return "highp int   ref_int16_t   (highp uint offset) { return bitfieldExtract(int(ref_data[offset >> 2u]), int((offset & 2u) * 8u), 16); }\n";
+		case glu::TYPE_UINT16:	return "highp uint  ref_uint16_t  (highp uint offset) { return bitfieldExtract(ref_data[offset >> 2u], int((offset & 2u) * 8u), 16); }\n";
+		default:
+			DE_ASSERT(false);
+			return DE_NULL;
+	}
+}
+
+void generateRefLoadFunc (std::ostream& str, glu::DataType type)
+{
+	const glu::DataType	scalarType	= glu::getDataTypeScalarType(type);
+	const char*			precision	= glu::isDataTypeBoolOrBVec(type) ? "" : "highp ";
+
+	if (glu::isDataTypeScalar(type))
+		str << getRefLoadFuncForScalarType(type);
+	else if (glu::isDataTypeMatrix(type))
+	{
+		const int	numRows	= glu::getDataTypeMatrixNumRows(type);
+		const int	numCols	= glu::getDataTypeMatrixNumColumns(type);
+
+		DE_ASSERT(scalarType == glu::TYPE_FLOAT);
+
+		str << precision << glu::getDataTypeName(type) << " ref_" << glu::getDataTypeName(type) << " (highp uint offset, highp uint colStride, highp uint rowStride) { return " << glu::getDataTypeName(type) << "(";
+
+		// Constructed in column-wise order.
+		for (int colNdx = 0; colNdx < numCols; colNdx++)
+		{
+			for (int rowNdx = 0; rowNdx < numRows; rowNdx++)
+			{
+				if (colNdx > 0 || rowNdx > 0)
+					str << ", ";
+
+				str << "ref_float(offset";
+
+				if (colNdx > 0)
+					str << " + " << colNdx << "u*colStride";
+
+				if (rowNdx > 0)
+					str << " + " << rowNdx << "u*rowStride";
+
+				str << ")";
+			}
+		}
+
+		str << "); }\n";
+	}
+	else
+	{
+		const char*	promotedName	= glu::getDataTypeName(getPromoteType(type));
+		const int	compSize		= getDataTypeByteSize(scalarType);
+
+		str << precision << promotedName << " ref_" << glu::getDataTypeName(type) << " (highp uint offset) { return " << promotedName << "(";
+
+		for (int compNdx = 0; compNdx < glu::getDataTypeScalarSize(type); compNdx++)
+		{
+			if (compNdx > 0)
+				str << ", ref_" << glu::getDataTypeName(scalarType) << "(offset + " << compNdx*compSize << "u)";
+			else
+				str << "ref_" << glu::getDataTypeName(scalarType) << "(offset)";
+		}
+
+		str << "); }\n";
+	}
+}
+
+void generateRefLoadFuncs (std::ostream& str, const ShaderInterface& interface)
+{
+	std::set<glu::DataType> types;
+	std::set<glu::DataType> loadFuncs;
+
+	collectUniqueBasicTypes(types, interface);
+
+	for (std::set<glu::DataType>::const_iterator iter = types.begin(); iter != types.end(); ++iter)
+	{
+		loadFuncs.insert(glu::getDataTypeScalarType(*iter));
+		loadFuncs.insert(*iter);
+	}
+
+	// Scalar loads are used by vector and matrix loads so they must be declared first.
+	for (std::set<glu::DataType>::const_iterator iter = loadFuncs.begin(); iter != loadFuncs.end(); ++iter)
+	{
+		if (glu::isDataTypeScalar(*iter))
+			generateRefLoadFunc(str, *iter);
+	}
+
+	for (std::set<glu::DataType>::const_iterator iter = loadFuncs.begin(); iter != loadFuncs.end(); ++iter)
+	{
+		if (!glu::isDataTypeScalar(*iter))
+			generateRefLoadFunc(str, *iter);
+	}
+}
+
 void generateDeclaration (std::ostream& src, const BufferVar& bufferVar, int indentLevel)
 {
 	// \todo [pyry] Qualifiers
@@ -1305,6 +1408,48 @@ int computeOffset (const BufferVarLayoutEntry& varLayout, const glu::TypeCompone
 	return varLayout.offset + varLayout.topLevelArrayStride*topLevelNdx + varLayout.arrayStride*bottomLevelNdx;
 }
 
+string getRefLoadSrc (glu::DataType basicType, const BufferVarLayoutEntry& varLayout, int refOffset)
+{
+	std::ostringstream src;
+
+	src << "ref_" << glu::getDataTypeName(basicType) << "(" << refOffset << "u";
+
+	if (glu::isDataTypeMatrix(basicType))
+	{
+		const int compSize = (int)sizeof(deUint32);
+
+		src << ", " << (varLayout.isRowMajor ? compSize : varLayout.matrixStride) << "u"
+			<< ", " << (varLayout.isRowMajor ? varLayout.matrixStride : compSize) << "u";
+	}
+
+	src << ")";
+
+	return src.str();
+}
+
+void generateRefMatrixSrc (std::ostream& src,
+						   glu::DataType basicType,
+						   const BufferVarLayoutEntry& varLayout,
+						   int refOffset,
+						   const char* resultVar,
+						   const string shaderName)
+{
+	const int		compSize		= sizeof(deUint32);
+	const int		numRows			= glu::getDataTypeMatrixNumRows(basicType);
+	const int		numCols			= glu::getDataTypeMatrixNumColumns(basicType);
+
+	for (int colNdex = 0; colNdex < numCols; colNdex++)
+	{
+		for (int rowNdex = 0; rowNdex < numRows; rowNdex++)
+		{
+			const int compOffset = refOffset + (varLayout.isRowMajor ? rowNdex*varLayout.matrixStride + colNdex*compSize
+																	 : colNdex*varLayout.matrixStride + rowNdex*compSize);
+
+			src << "\t" << resultVar << " = " << resultVar << " && compare_float(" << shaderName << "[" << colNdex << "][" << rowNdex << "], ref_float(" << compOffset << "u));\n";
+		}
+	}
+}
+
 void generateCompareSrc (
 	std::ostream&				src,
 	const char*					resultVar,
@@ -1312,6 +1457,7 @@ void generateCompareSrc (
 	const BufferBlock&			block,
 	int							instanceNdx,
 	const BlockDataPtr&			blockPtr,
+	int							refBlockOffset,
 	const BufferVar&			bufVar,
 	const glu::SubTypeAccess&	accessPath,
 	MatrixLoadFlags				matrixLoadFlag)
@@ -1323,14 +1469,14 @@ void generateCompareSrc (
 		const int arraySize = curType.getArraySize() == VarType::UNSIZED_ARRAY ? block.getLastUnsizedArraySize(instanceNdx) : curType.getArraySize();
 
 		for (int elemNdx = 0; elemNdx < arraySize; elemNdx++)
-			generateCompareSrc(src, resultVar, bufferLayout, block, instanceNdx, blockPtr, bufVar, accessPath.element(elemNdx), LOAD_FULL_MATRIX);
+			generateCompareSrc(src, resultVar, bufferLayout, block, instanceNdx, blockPtr, refBlockOffset, bufVar, accessPath.element(elemNdx), LOAD_FULL_MATRIX);
 	}
 	else if (curType.isStructType())
 	{
 		const int numMembers = curType.getStructPtr()->getNumMembers();
 
 		for (int memberNdx = 0; memberNdx < numMembers; memberNdx++)
-			generateCompareSrc(src, resultVar, bufferLayout, block, instanceNdx, blockPtr, bufVar, accessPath.member(memberNdx), LOAD_FULL_MATRIX);
+			generateCompareSrc(src, resultVar, bufferLayout, block, instanceNdx, blockPtr, refBlockOffset, bufVar, accessPath.member(memberNdx), LOAD_FULL_MATRIX);
 	}
 	else
 	{
@@ -1347,9 +1493,21 @@ void generateCompareSrc (
 			const bool					isMatrix		= glu::isDataTypeMatrix(basicType);
 			const char*					typeName		= glu::getDataTypeName(basicType);
 			const void*					valuePtr		= (const deUint8*)blockPtr.ptr + computeOffset(varLayout, accessPath.getPath());
+			const int					refOffset		= refBlockOffset + computeOffset(varLayout, accessPath.getPath());
 
+			if (refBlockOffset >= 0)
+			{
+				if (isMatrix && matrixLoadFlag == LOAD_MATRIX_COMPONENTS)
+					generateRefMatrixSrc(src, basicType, varLayout, refOffset, resultVar, shaderName);
+				else
+				{
+					const glu::DataType	promoteType	= getPromoteType(basicType);
+					const char*			castName	= basicType != promoteType ? glu::getDataTypeName(promoteType) : "";
 
-			if (isMatrix)
+					src << "\t" << resultVar << " = " << resultVar << " && compare_" << typeName << "(" << castName << "(" << shaderName << "), " << getRefLoadSrc(basicType, varLayout, refOffset) << ");\n";
+				}
+			}
+			else if (isMatrix)
 			{
 				if (matrixLoadFlag == LOAD_MATRIX_COMPONENTS)
 					generateImmMatrixSrc(src, basicType, varLayout.matrixStride, varLayout.isRowMajor, valuePtr, resultVar, typeName, shaderName);
@@ -1375,7 +1533,7 @@ void generateCompareSrc (
 	}
 }
 
-void generateCompareSrc (std::ostream& src, const char* resultVar, const ShaderInterface& interface, const BufferLayout& layout, const vector<BlockDataPtr>& blockPointers, MatrixLoadFlags matrixLoadFlag)
+void generateCompareSrc (std::ostream& src, const char* resultVar, const ShaderInterface& interface, const BufferLayout& layout, const RefDataStorage& data, int refDataOffset, MatrixLoadFlags matrixLoadFlag)
 {
 	for (int declNdx = 0; declNdx < interface.getNumBlocks(); declNdx++)
 	{
@@ -1389,7 +1547,8 @@ void generateCompareSrc (std::ostream& src, const char* resultVar, const ShaderI
 		{
 			const string		instanceName	= block.getBlockName() + (isArray ? "[" + de::toString(instanceNdx) + "]" : string(""));
 			const int			blockNdx		= layout.getBlockIndex(instanceName);
-			const BlockDataPtr&	blockPtr		= blockPointers[blockNdx];
+			const BlockDataPtr&	blockPtr		= data.pointers[blockNdx];
+			const int			refBlockOffset	= refDataOffset >= 0 ? refDataOffset + (int)((const deUint8*)blockPtr.ptr - &data.data[0]) : -1;
 
 			for (BufferBlock::const_iterator varIter = block.begin(); varIter != block.end(); varIter++)
 			{
@@ -1398,7 +1557,7 @@ void generateCompareSrc (std::ostream& src, const char* resultVar, const ShaderI
 				if ((bufVar.getFlags() & ACCESS_READ) == 0)
 					continue; // Don't read from that variable.
 
-				generateCompareSrc(src, resultVar, layout, block, instanceNdx, blockPtr, bufVar, glu::SubTypeAccess(bufVar.getType()), matrixLoadFlag);
+				generateCompareSrc(src, resultVar, layout, block, instanceNdx, blockPtr, refBlockOffset, bufVar, glu::SubTypeAccess(bufVar.getType()), matrixLoadFlag);
 			}
 		}
 	}
@@ -1412,6 +1571,7 @@ void generateWriteSrc (
 	const BufferBlock&			block,
 	int							instanceNdx,
 	const BlockDataPtr&			blockPtr,
+	int							refBlockOffset,
 	const BufferVar&			bufVar,
 	const glu::SubTypeAccess&	accessPath)
 {
@@ -1422,14 +1582,14 @@ void generateWriteSrc (
 		const int arraySize = curType.getArraySize() == VarType::UNSIZED_ARRAY ? block.getLastUnsizedArraySize(instanceNdx) : curType.getArraySize();
 
 		for (int elemNdx = 0; elemNdx < arraySize; elemNdx++)
-			generateWriteSrc(src, bufferLayout, block, instanceNdx, blockPtr, bufVar, accessPath.element(elemNdx));
+			generateWriteSrc(src, bufferLayout, block, instanceNdx, blockPtr, refBlockOffset, bufVar, accessPath.element(elemNdx));
 	}
 	else if (curType.isStructType())
 	{
 		const int numMembers = curType.getStructPtr()->getNumMembers();
 
 		for (int memberNdx = 0; memberNdx < numMembers; memberNdx++)
-			generateWriteSrc(src, bufferLayout, block, instanceNdx, blockPtr, bufVar, accessPath.member(memberNdx));
+			generateWriteSrc(src, bufferLayout, block, instanceNdx, blockPtr, refBlockOffset, bufVar, accessPath.member(memberNdx));
 	}
 	else
 	{
@@ -1453,7 +1613,9 @@ void generateWriteSrc (
 
 			src << "\t" << shaderName << " = " << castName << "(";
 
-			if (isMatrix)
+			if (refBlockOffset >= 0)
+				src << getRefLoadSrc(basicType, varLayout, refBlockOffset + computeOffset(varLayout, accessPath.getPath()));
+			else if (isMatrix)
 				generateImmMatrixSrc(src, basicType, varLayout.matrixStride, varLayout.isRowMajor, valuePtr);
 			else
 				generateImmScalarVectorSrc(src, basicType, valuePtr);
@@ -1463,7 +1625,7 @@ void generateWriteSrc (
 	}
 }
 
-void generateWriteSrc (std::ostream& src, const ShaderInterface& interface, const BufferLayout& layout, const vector<BlockDataPtr>& blockPointers)
+void generateWriteSrc (std::ostream& src, const ShaderInterface& interface, const BufferLayout& layout, const RefDataStorage& data, int refDataOffset)
 {
 	for (int declNdx = 0; declNdx < interface.getNumBlocks(); declNdx++)
 	{
@@ -1477,7 +1639,8 @@ void generateWriteSrc (std::ostream& src, const ShaderInterface& interface, cons
 		{
 			const string		instanceName	= block.getBlockName() + (isArray ? "[" + de::toString(instanceNdx) + "]" : string(""));
 			const int			blockNdx		= layout.getBlockIndex(instanceName);
-			const BlockDataPtr&	blockPtr		= blockPointers[blockNdx];
+			const BlockDataPtr&	blockPtr		= data.pointers[blockNdx];
+			const int			refBlockOffset	= refDataOffset >= 0 ? refDataOffset + (int)((const deUint8*)blockPtr.ptr - &data.data[0]) : -1;
 
 			for (BufferBlock::const_iterator varIter = block.begin(); varIter != block.end(); varIter++)
 			{
@@ -1486,15 +1649,22 @@ void generateWriteSrc (std::ostream& src, const ShaderInterface& interface, cons
 				if ((bufVar.getFlags() & ACCESS_WRITE) == 0)
 					continue; // Don't write to that variable.
 
-				generateWriteSrc(src, layout, block, instanceNdx, blockPtr, bufVar, glu::SubTypeAccess(bufVar.getType()));
+				generateWriteSrc(src, layout, block, instanceNdx, blockPtr, refBlockOffset, bufVar, glu::SubTypeAccess(bufVar.getType()));
 			}
 		}
 	}
 }
 
-string generateComputeShader (const ShaderInterface& interface, const BufferLayout& layout, const vector<BlockDataPtr>& comparePtrs, const vector<BlockDataPtr>& writePtrs, MatrixLoadFlags matrixLoadFlag)
+//! Offset of written values in reference buffer. Expected values are stored at the beginning.
+int getRefWriteDataOffset (const RefDataStorage& initialData)
 {
-	std::ostringstream src;
+	return deRoundUp32((int)initialData.data.size(), (int)sizeof(deUint32)*4);
+}
+
+string generateComputeShader (const ShaderInterface& interface, const BufferLayout& layout, const RefDataStorage& initialData, const RefDataStorage& writeData, MatrixLoadFlags matrixLoadFlag, ReferenceDataMode refDataMode)
+{
+	const bool			useRefBuffer	= refDataMode == REFERENCE_DATA_BUFFER;
+	std::ostringstream	src;
 
 	if (uses16BitStorage(interface) || uses8BitStorage(interface) || usesRelaxedLayout(interface) || usesScalarLayout(interface))
 		src << "#version 450\n";
@@ -1523,24 +1693,31 @@ string generateComputeShader (const ShaderInterface& interface, const BufferLayo
 		}
 	}
 
+	// Expected and written values, stored with the reference layout.
+	if (useRefBuffer)
+		src << "layout(std430, binding = " << 1 + interface.getNumBlocks() << ") readonly buffer RefBlock { highp uint ref_data[]; };\n";
+
 	// Comparison utilities.
 	src << "\n";
 	generateCompareFuncs(src, interface);
 
+	if (useRefBuffer)
+		generateRefLoadFuncs(src, interface);
+
 	src << "\n"
 		   "void main (void)\n"
 		   "{\n"
 		   "	bool allOk = true;\n";
 
 	// Value compare.
-	generateCompareSrc(src, "allOk", interface, layout, comparePtrs, matrixLoadFlag);
+	generateCompareSrc(src, "allOk", interface, layout, initialData, useRefBuffer ? 0 : -1, matrixLoadFlag);
 
 	src << "	if (allOk)\n"
 		<< "		ac_numPassed++;\n"
 		<< "\n";
 
 	// Value write.
-	generateWriteSrc(src, interface, layout, writePtrs);
+	generateWriteSrc(src, interface, layout, writeData, useRefBuffer ? getRefWriteDataOffset(initialData) : -1);
 
 	src << "}\n";
 
@@ -2101,7 +2278,8 @@ public:
 														const ShaderInterface&		interface,
 														const BufferLayout&			refLayout,
 														const RefDataStorage&		initialData,
-														const RefDataStorage&		writeData);
+														const RefDataStorage&		writeData,
+														ReferenceDataMode			refDataMode);
 	virtual						~SSBOLayoutCaseInstance	(void);
 	virtual tcu::TestStatus		iterate						(void);
 
@@ -2111,7 +2289,7 @@ private:
 	const BufferLayout&			m_refLayout;
 	const RefDataStorage&		m_initialData;	// Initial data stored in buffer.
 	const RefDataStorage&		m_writeData;	// Data written by compute shader.
-
+	ReferenceDataMode			m_refDataMode;
 
 	typedef de::SharedPtr<vk::Unique<vk::VkBuffer> >	VkBufferSp;
 	typedef de::SharedPtr<vk::Allocation>				AllocationSp;
@@ -2125,13 +2303,15 @@ SSBOLayoutCaseInstance::SSBOLayoutCaseInstance (Context&					context,
 												const ShaderInterface&		interface,
 												const BufferLayout&			refLayout,
 												const RefDataStorage&		initialData,
-												const RefDataStorage&		writeData)
+												const RefDataStorage&		writeData,
+												ReferenceDataMode			refDataMode)
 	: TestInstance	(context)
 	, m_bufferMode	(bufferMode)
 	, m_interface	(interface)
 	, m_refLayout	(refLayout)
 	, m_initialData	(initialData)
 	, m_writeData	(writeData)
+	, m_refDataMode	(refDataMode)
 {
 }
 
@@ -2180,8 +2360,14 @@ tcu::TestStatus SSBOLayoutCaseInstance::iterate (void)
 		}
 	}
 
+	const bool useRefBuffer = m_refDataMode == REFERENCE_DATA_BUFFER;
+
+	if (useRefBuffer)
+		setLayoutBuilder
+			.addSingleBinding(vk::VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, vk::VK_SHADER_STAGE_COMPUTE_BIT);
+
 	poolBuilder
-		.addType(vk::VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, (deUint32)(1 + numBlocks));
+		.addType(vk::VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, (deUint32)(1 + numBlocks + (useRefBuffer ? 1 : 0)));
 
 	const vk::Unique<vk::VkDescriptorSetLayout> descriptorSetLayout(setLayoutBuilder.build(vk, device));
 	const vk::Unique<vk::VkDescriptorPool> descriptorPool(poolBuilder.build(vk, device, vk::VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT, 1u));
@@ -2301,6 +2487,30 @@ tcu::TestStatus SSBOLayoutCaseInstance::iterate (void)
 		}
 	}
 
+	// Upload expected and written values
+	vk::Move<vk::VkBuffer>			refBuffer;
+	de::MovePtr<vk::Allocation>		refBufferAlloc;
+	vk::VkDescriptorBufferInfo		refDescriptorInfo;
+
+	if (useRefBuffer)
+	{
+		const int	writeDataOffset	= getRefWriteDataOffset(m_initialData);
+		const int	refBufferSize	= writeDataOffset + (int)m_writeData.data.size();
+		deUint8*	refPtr;
+
+		refBuffer			= createBuffer(m_context, refBufferSize, vk::VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+		refBufferAlloc		= allocateAndBindMemory(m_context, *refBuffer, vk::MemoryRequirement::HostVisible);
+		refDescriptorInfo	= makeDescriptorBufferInfo(*refBuffer, 0ull, refBufferSize);
+		refPtr				= (deUint8*)refBufferAlloc->getHostPtr();
+
+		deMemset(refPtr, 0, refBufferSize);
+		deMemcpy(refPtr, &m_initialData.data[0], m_initialData.data.size());
+		deMemcpy(refPtr + writeDataOffset, &m_writeData.data[0], m_writeData.data.size());
+		flushMappedMemoryRange(vk, device, refBufferAlloc->getMemory(), refBufferAlloc->getOffset(), refBufferSize);
+
+		setUpdateBuilder.writeSingle(*descriptorSet, vk::DescriptorSetUpdateBuilder::Location::binding((deUint32)numBindings + 1u), vk::VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, &refDescriptorInfo);
+	}
+
 	setUpdateBuilder.update(vk, device);
 
 	const vk::VkPipelineLayoutCreateInfo pipelineLayoutParams =
@@ -2438,10 +2648,11 @@ tcu::TestStatus SSBOLayoutCaseInstance::iterate (void)
 
 // SSBOLayoutCase.
 
-SSBOLayoutCase::SSBOLayoutCase (tcu::TestContext& testCtx, const char* name, const char* description, BufferMode bufferMode, MatrixLoadFlags matrixLoadFlag)
+SSBOLayoutCase::SSBOLayoutCase (tcu::TestContext& testCtx, const char* name, const char* description, BufferMode bufferMode, MatrixLoadFlags matrixLoadFlag, ReferenceDataMode refDataMode)
 	: TestCase			(testCtx, name, description)
 	, m_bufferMode		(bufferMode)
 	, m_matrixLoadFlag	(matrixLoadFlag)
+	, m_refDataMode		(refDataMode)
 {
 }
 
@@ -2479,7 +2690,7 @@ TestInstance* SSBOLayoutCase::createInstance (Context& context) const
 	if (!context.getScalarBlockLayoutFeatures().scalarBlockLayout && usesScalarLayout(m_interface))
 		TCU_THROW(NotSupportedError, "scalarBlockLayout not supported");
 
-	return new SSBOLayoutCaseInstance(context, m_bufferMode, m_interface, m_refLayout, m_initialData, m_writeData);
+	return new SSBOLayoutCaseInstance(context, m_bufferMode, m_interface, m_refLayout, m_initialData, m_writeData, m_refDataMode);
 }
 
 void SSBOLayoutCase::init ()
@@ -2491,7 +2702,7 @@ void SSBOLayoutCase::init ()
 	generateValues			(m_refLayout, m_writeData.pointers, deStringHash(getName()) ^ 0x25ca4e7);
 	copyNonWrittenData		(m_interface, m_refLayout, m_initialData.pointers, m_writeData.pointers);
 
-	m_computeShaderSrc = generateComputeShader(m_interface, m_refLayout, m_initialData.pointers, m_writeData.pointers, m_matrixLoadFlag);
+	m_computeShaderSrc = generateComputeShader(m_interface, m_refLayout, m_initialData, m_writeData, m_matrixLoadFlag, m_refDataMode);
 }
 
 } // ssbo
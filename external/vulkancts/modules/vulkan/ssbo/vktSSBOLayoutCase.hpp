@@ -63,6 +63,12 @@ enum MatrixLoadFlags
 	LOAD_MATRIX_COMPONENTS	= 1,
 };
 
+enum ReferenceDataMode
+{
+	REFERENCE_DATA_IMMEDIATE	= 0,	//!< Expected and written values are constants in the shader.
+	REFERENCE_DATA_BUFFER		= 1,	//!< Expected and written values are read from a reference buffer.
+};
+
 class BufferVar
 {
 public:
@@ -231,7 +237,7 @@ public:
 		BUFFERMODE_LAST
 	};
 
-								SSBOLayoutCase				(tcu::TestContext& testCtx, const char* name, const char* description, BufferMode bufferMode, MatrixLoadFlags matrixLoadFlag);
+								SSBOLayoutCase				(tcu::TestContext& testCtx, const char* name, const char* description, BufferMode bufferMode, MatrixLoadFlags matrixLoadFlag, ReferenceDataMode refDataMode = REFERENCE_DATA_IMMEDIATE);
 	virtual						~SSBOLayoutCase				(void);
 
 	virtual void				initPrograms				(vk::SourceCollections& programCollection) const;
@@ -243,6 +249,7 @@ protected:
 	BufferMode					m_bufferMode;
 	ShaderInterface				m_interface;
 	MatrixLoadFlags				m_matrixLoadFlag;
+	ReferenceDataMode			m_refDataMode;
 	std::string					m_computeShaderSrc;
 
 private:
@@ -103,7 +103,7 @@ private:
 };
 
 RandomSSBOLayoutCase::RandomSSBOLayoutCase (tcu::TestContext& testCtx, const char* name, const char* description, BufferMode bufferMode, deUint32 features, deUint32 seed)
-	: SSBOLayoutCase		(testCtx, name, description, bufferMode, LOAD_FULL_MATRIX)
+	: SSBOLayoutCase		(testCtx, name, description, bufferMode, LOAD_FULL_MATRIX, REFERENCE_DATA_BUFFER)
 	, m_features			(features)
 	, m_maxBlocks			(4)
 	, m_maxInstances		((features & FEATURE_INSTANCE_ARRAYS)	? 3 : 0)
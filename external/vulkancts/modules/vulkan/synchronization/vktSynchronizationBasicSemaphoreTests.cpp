@@ -23,6 +23,7 @@
 
 #include "vktSynchronizationBasicSemaphoreTests.hpp"
 #include "vktTestCaseUtil.hpp"
+#include "vktDeviceCache.hpp"
 #include "vktSynchronizationUtil.hpp"
 
 #include "vkDefs.hpp"
@@ -165,7 +166,8 @@ tcu::TestStatus basicMultiQueueCase (Context& context)
 	const DeviceInterface&					vk							= context.getDeviceInterface();
 	const InstanceInterface&				instance					= context.getInstanceInterface();
 	const VkPhysicalDevice					physicalDevice				= context.getPhysicalDevice();
-	vk::Move<vk::VkDevice>					logicalDevice;
+	de::MovePtr<CustomDevice>				customDevice;
+	VkDevice								logicalDevice				= DE_NULL;
 	std::vector<VkQueueFamilyProperties>	queueFamilyProperties;
 	VkDeviceCreateInfo						deviceInfo;
 	VkPhysicalDeviceFeatures				deviceFeatures;
@@ -238,21 +240,22 @@ tcu::TestStatus basicMultiQueueCase (Context& context)
 	deviceInfo.queueCreateInfoCount		= (queues[FIRST].queueFamilyIndex == queues[SECOND].queueFamilyIndex) ? 1 : COUNT;
 	deviceInfo.pQueueCreateInfos		= queueInfos;
 
-	logicalDevice = vk::createDevice(context.getPlatformInterface(), context.getInstance(), instance, physicalDevice, &deviceInfo);
+	customDevice	= context.getDeviceCache().getDevice(physicalDevice, deviceInfo);
+	logicalDevice	= customDevice->getDevice();
 
 	for (deUint32 queueReqNdx = 0; queueReqNdx < COUNT; ++queueReqNdx)
 	{
 		if (queues[FIRST].queueFamilyIndex == queues[SECOND].queueFamilyIndex)
-			vk.getDeviceQueue(*logicalDevice, queues[queueReqNdx].queueFamilyIndex, queueReqNdx, &queues[queueReqNdx].queue);
+			vk.getDeviceQueue(logicalDevice, queues[queueReqNdx].queueFamilyIndex, queueReqNdx, &queues[queueReqNdx].queue);
 		else
-			vk.getDeviceQueue(*logicalDevice, queues[queueReqNdx].queueFamilyIndex, 0u, &queues[queueReqNdx].queue);
+			vk.getDeviceQueue(logicalDevice, queues[queueReqNdx].queueFamilyIndex, 0u, &queues[queueReqNdx].queue);
 	}
 
-	semaphore			= (createSemaphore (vk, *logicalDevice));
-	cmdPool[FIRST]		= (createCommandPool(vk, *logicalDevice, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT, queues[FIRST].queueFamilyIndex));
-	cmdPool[SECOND]		= (createCommandPool(vk, *logicalDevice, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT, queues[SECOND].queueFamilyIndex));
-	cmdBuffer[FIRST]	= (makeCommandBuffer(vk, *logicalDevice, *cmdPool[FIRST]));
-	cmdBuffer[SECOND]	= (makeCommandBuffer(vk, *logicalDevice, *cmdPool[SECOND]));
+	semaphore			= (createSemaphore (vk, logicalDevice));
+	cmdPool[FIRST]		= (createCommandPool(vk, logicalDevice, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT, queues[FIRST].queueFamilyIndex));
+	cmdPool[SECOND]		= (createCommandPool(vk, logicalDevice, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT, queues[SECOND].queueFamilyIndex));
+	cmdBuffer[FIRST]	= (makeCommandBuffer(vk, logicalDevice, *cmdPool[FIRST]));
+	cmdBuffer[SECOND]	= (makeCommandBuffer(vk, logicalDevice, *cmdPool[SECOND]));
 
 	submitInfo[FIRST].sType					= VK_STRUCTURE_TYPE_SUBMIT_INFO;
 	submitInfo[FIRST].pNext					= DE_NULL;
@@ -279,16 +282,16 @@ tcu::TestStatus basicMultiQueueCase (Context& context)
 	VK_CHECK(vk.beginCommandBuffer(*cmdBuffer[SECOND], &info));
 	endCommandBuffer(vk, *cmdBuffer[SECOND]);
 
-	fence[FIRST]  = (createFence(vk, *logicalDevice));
-	fence[SECOND] = (createFence(vk, *logicalDevice));
+	fence[FIRST]  = (createFence(vk, logicalDevice));
+	fence[SECOND] = (createFence(vk, logicalDevice));
 
 	VK_CHECK(vk.queueSubmit(queues[FIRST].queue, 1u, &submitInfo[FIRST], *fence[FIRST]));
 	VK_CHECK(vk.queueSubmit(queues[SECOND].queue, 1u, &submitInfo[SECOND], *fence[SECOND]));
 
-	if (VK_SUCCESS != vk.waitForFences(*logicalDevice, 1u, &fence[FIRST].get(), DE_TRUE, FENCE_WAIT))
+	if (VK_SUCCESS != vk.waitForFences(logicalDevice, 1u, &fence[FIRST].get(), DE_TRUE, FENCE_WAIT))
 		return tcu::TestStatus::fail("Basic semaphore tests with multi queue failed");
 
-	if (VK_SUCCESS != vk.waitForFences(*logicalDevice, 1u, &fence[SECOND].get(), DE_TRUE, FENCE_WAIT))
+	if (VK_SUCCESS != vk.waitForFences(logicalDevice, 1u, &fence[SECOND].get(), DE_TRUE, FENCE_WAIT))
 		return tcu::TestStatus::fail("Basic semaphore tests with multi queue failed");
 
 	{
@@ -299,16 +302,16 @@ tcu::TestStatus basicMultiQueueCase (Context& context)
 		submitInfo[FIRST].pCommandBuffers	= &cmdBuffer[FIRST].get();
 	}
 
-	VK_CHECK(vk.resetFences(*logicalDevice, 1u, &fence[FIRST].get()));
-	VK_CHECK(vk.resetFences(*logicalDevice, 1u, &fence[SECOND].get()));
+	VK_CHECK(vk.resetFences(logicalDevice, 1u, &fence[FIRST].get()));
+	VK_CHECK(vk.resetFences(logicalDevice, 1u, &fence[SECOND].get()));
 
 	VK_CHECK(vk.queueSubmit(queues[SECOND].queue, 1u, &submitInfo[SECOND], *fence[SECOND]));
 	VK_CHECK(vk.queueSubmit(queues[FIRST].queue, 1u, &submitInfo[FIRST], *fence[FIRST]));
 
-	if (VK_SUCCESS != vk.waitForFences(*logicalDevice, 1u, &fence[FIRST].get(), DE_TRUE, FENCE_WAIT))
+	if (VK_SUCCESS != vk.waitForFences(logicalDevice, 1u, &fence[FIRST].get(), DE_TRUE, FENCE_WAIT))
 		return tcu::TestStatus::fail("Basic semaphore tests with multi queue failed");
 
-	if (VK_SUCCESS != vk.waitForFences(*logicalDevice, 1u, &fence[SECOND].get(), DE_TRUE, FENCE_WAIT))
+	if (VK_SUCCESS != vk.waitForFences(logicalDevice, 1u, &fence[SECOND].get(), DE_TRUE, FENCE_WAIT))
 		return tcu::TestStatus::fail("Basic semaphore tests with multi queue failed");
 
 	return tcu::TestStatus::pass("Basic semaphore tests with multi queue passed");
@@ -25,6 +25,7 @@
 #include "vkDefs.hpp"
 #include "vktTestCase.hpp"
 #include "vktTestCaseUtil.hpp"
+#include "vktDeviceCache.hpp"
 #include "vkRef.hpp"
 #include "vkRefUtil.hpp"
 #include "vkMemUtil.hpp"
@@ -133,13 +134,12 @@ public:
 				&context.getDeviceFeatures()									//const VkPhysicalDeviceFeatures*	pEnabledFeatures;
 			};
 
-			m_logicalDevice	= createDevice(context.getPlatformInterface(), context.getInstance(), instance, physicalDevice, &deviceInfo);
-			m_deviceDriver	= MovePtr<DeviceDriver>(new DeviceDriver(context.getPlatformInterface(), context.getInstance(), *m_logicalDevice));
-			m_allocator		= MovePtr<Allocator>(new SimpleAllocator(*m_deviceDriver, *m_logicalDevice, getPhysicalDeviceMemoryProperties(instance, physicalDevice)));
+			m_device		= context.getDeviceCache().getDevice(physicalDevice, deviceInfo);
+			m_allocator		= MovePtr<Allocator>(new SimpleAllocator(getDeviceInterface(), getDevice(), getPhysicalDeviceMemoryProperties(instance, physicalDevice)));
 
 			for (std::map<deUint32, QueueData>::iterator it = m_queues.begin(); it != m_queues.end(); ++it)
 			for (int queueNdx = 0; queueNdx < static_cast<int>(it->second.queue.size()); ++queueNdx)
-				m_deviceDriver->getDeviceQueue(*m_logicalDevice, it->first, queueNdx, &it->second.queue[queueNdx]);
+				getDeviceInterface().getDeviceQueue(getDevice(), it->first, queueNdx, &it->second.queue[queueNdx]);
 		}
 	}
 
@@ -201,12 +201,12 @@ public:
 
 	VkDevice getDevice (void) const
 	{
-		return *m_logicalDevice;
+		return m_device->getDevice();
 	}
 
 	const DeviceInterface& getDeviceInterface (void) const
 	{
-		return *m_deviceDriver;
+		return m_device->getDeviceInterface();
 	}
 
 	Allocator& getAllocator (void)
@@ -215,8 +215,7 @@ public:
 	}
 
 private:
-	Move<VkDevice>					m_logicalDevice;
-	MovePtr<DeviceDriver>			m_deviceDriver;
+	MovePtr<CustomDevice>			m_device;
 	MovePtr<Allocator>				m_allocator;
 	std::map<deUint32, QueueData>	m_queues;
 };
@@ -25,6 +25,7 @@
 #include "vktTessellationUtil.hpp"
 #include "vkTypeUtil.hpp"
 #include "vkCmdUtil.hpp"
+#include "vkPipelineCacheUtil.hpp"
 #include "deMath.h"
 
 namespace vkt
@@ -183,7 +184,7 @@ Move<VkPipeline> makeComputePipeline (const DeviceInterface&		vk,
 		DE_NULL,											// VkPipeline						basePipelineHandle;
 		0,													// deInt32							basePipelineIndex;
 	};
-	return createComputePipeline(vk, device, DE_NULL , &pipelineInfo);
+	return createComputePipeline(vk, device, getDefaultPipelineCache(device), &pipelineInfo);
 }
 
 VkImageCreateInfo makeImageCreateInfo (const tcu::IVec2& size, const VkFormat format, const VkImageUsageFlags usage, const deUint32 numArrayLayers)
@@ -29,6 +29,7 @@
 #include "tcuTestHierarchyIterator.hpp"
 #include "deUniquePtr.hpp"
 #include "vkPrograms.hpp"
+#include "vkProgramBinaryCache.hpp"
 #include "vkBinaryRegistry.hpp"
 #include "vktTestCase.hpp"
 #include "vktTestPackage.hpp"
@@ -249,6 +250,7 @@ public:
 		: m_source		(source)
 		, m_program		(program)
 		, m_commandLine	(0)
+		, m_cache		(0)
 	{}
 
 	BuildHighLevelShaderTask (void) : m_program(DE_NULL) {}
@@ -258,6 +260,11 @@ public:
 		m_commandLine = &commandLine;
 	}
 
+	void setCache (vk::ProgramBinaryCache& cache)
+	{
+		m_cache = &cache;
+	}
+
 	void execute (void)
 	{
 		glu::ShaderProgramInfo buildInfo;
@@ -265,8 +272,8 @@ public:
 		try
 		{
 			DE_ASSERT(m_source.buildOptions.targetVersion < vk::SPIRV_VERSION_LAST);
-			DE_ASSERT(m_commandLine != DE_NULL);
-			m_program->binary			= ProgramBinarySp(vk::buildProgram(m_source, &buildInfo, *m_commandLine));
+			DE_ASSERT(m_commandLine != DE_NULL && m_cache != DE_NULL);
+			m_program->binary			= ProgramBinarySp(m_cache->buildProgram(m_source, &buildInfo, *m_commandLine));
 			m_program->buildStatus		= Program::STATUS_PASSED;
 			m_program->validatorOptions	= m_source.buildOptions.getSpirvValidatorOptions();
 		}
@@ -285,6 +292,7 @@ private:
 	Source					m_source;
 	Program*				m_program;
 	const tcu::CommandLine*	m_commandLine;
+	vk::ProgramBinaryCache*	m_cache;
 };
 
 void writeBuildLogs (const vk::SpirVProgramInfo& buildInfo, std::ostream& dst)
@@ -304,6 +312,7 @@ public:
 		: m_source		(source)
 		, m_program		(program)
 		, m_commandLine	(0)
+		, m_cache		(0)
 	{}
 
 	BuildSpirVAsmTask (void) : m_program(DE_NULL) {}
@@ -313,6 +322,11 @@ public:
 		m_commandLine = &commandLine;
 	}
 
+	void setCache (vk::ProgramBinaryCache& cache)
+	{
+		m_cache = &cache;
+	}
+
 	void execute (void)
 	{
 		vk::SpirVProgramInfo buildInfo;
@@ -320,8 +334,8 @@ public:
 		try
 		{
 			DE_ASSERT(m_source.buildOptions.targetVersion < vk::SPIRV_VERSION_LAST);
-			DE_ASSERT(m_commandLine != DE_NULL);
-			m_program->binary		= ProgramBinarySp(vk::assembleProgram(m_source, &buildInfo, *m_commandLine));
+			DE_ASSERT(m_commandLine != DE_NULL && m_cache != DE_NULL);
+			m_program->binary		= ProgramBinarySp(m_cache->assembleProgram(m_source, &buildInfo, *m_commandLine));
 			m_program->buildStatus	= Program::STATUS_PASSED;
 		}
 		catch (const tcu::Exception&)
@@ -339,6 +353,7 @@ private:
 	vk::SpirVAsmSource		m_source;
 	Program*				m_program;
 	const tcu::CommandLine*	m_commandLine;
+	vk::ProgramBinaryCache*	m_cache;
 };
 
 class ValidateBinaryTask : public Task
@@ -380,11 +395,13 @@ struct BuildStats
 	int		numSucceeded;
 	int		numFailed;
 	int		notSupported;
+	int		numReused;		//!< Programs identical to an earlier one, not compiled again
 
 	BuildStats (void)
 		: numSucceeded	(0)
 		, numFailed		(0)
 		, notSupported	(0)
+		, numReused		(0)
 	{
 	}
 };
@@ -401,12 +418,14 @@ BuildStats buildPrograms (tcu::TestContext&			testCtx,
 	TaskExecutor						executor			(numThreads);
 
 	// de::PoolArray<> is faster to build than std::vector
-	de::MemPool							programPool;
+	const deMemPoolPageConfig			largePages			= { DE_MEMPOOL_DEFAULT_INITIAL_PAGE_SIZE, DE_MEMPOOL_LARGE_MAX_PAGE_SIZE };
+	de::MemPool							programPool			(largePages);
 	de::PoolArray<Program>				programs			(&programPool);
 	int									notSupported		= 0;
+	vk::ProgramBinaryCache				programCache;
 
 	{
-		de::MemPool							tmpPool;
+		de::MemPool							tmpPool				(largePages);
 		de::PoolArray<BuildHighLevelShaderTask<vk::GlslSource> >	buildGlslTasks		(&tmpPool);
 		de::PoolArray<BuildHighLevelShaderTask<vk::HlslSource> >	buildHlslTasks		(&tmpPool);
 		de::PoolArray<BuildSpirVAsmTask>	buildSpirvAsmTasks	(&tmpPool);
@@ -452,6 +471,7 @@ BuildStats buildPrograms (tcu::TestContext&			testCtx,
 						programs.pushBack(Program(vk::ProgramIdentifier(casePath, progIter.getName()), progIter.getProgram().buildOptions.getSpirvValidatorOptions()));
 						buildGlslTasks.pushBack(BuildHighLevelShaderTask<vk::GlslSource>(progIter.getProgram(), &programs.back()));
 						buildGlslTasks.back().setCommandline(testCtx.getCommandLine());
+						buildGlslTasks.back().setCache(programCache);
 						executor.submit(&buildGlslTasks.back());
 					}
 
@@ -466,6 +486,7 @@ BuildStats buildPrograms (tcu::TestContext&			testCtx,
 						programs.pushBack(Program(vk::ProgramIdentifier(casePath, progIter.getName()), progIter.getProgram().buildOptions.getSpirvValidatorOptions()));
 						buildHlslTasks.pushBack(BuildHighLevelShaderTask<vk::HlslSource>(progIter.getProgram(), &programs.back()));
 						buildHlslTasks.back().setCommandline(testCtx.getCommandLine());
+						buildHlslTasks.back().setCache(programCache);
 						executor.submit(&buildHlslTasks.back());
 					}
 
@@ -480,6 +501,7 @@ BuildStats buildPrograms (tcu::TestContext&			testCtx,
 						programs.pushBack(Program(vk::ProgramIdentifier(casePath, progIter.getName()), progIter.getProgram().buildOptions.getSpirvValidatorOptions()));
 						buildSpirvAsmTasks.pushBack(BuildSpirVAsmTask(progIter.getProgram(), &programs.back()));
 						buildSpirvAsmTasks.back().setCommandline(testCtx.getCommandLine());
+						buildSpirvAsmTasks.back().setCache(programCache);
 						executor.submit(&buildSpirvAsmTasks.back());
 					}
 				}
@@ -525,6 +547,7 @@ BuildStats buildPrograms (tcu::TestContext&			testCtx,
 	{
 		BuildStats	stats;
 		stats.notSupported = notSupported;
+		stats.numReused = programCache.getStatistics().numHits;
 		for (de::PoolArray<Program>::iterator progIter = programs.begin(); progIter != programs.end(); ++progIter)
 		{
 			const bool	buildOk			= progIter->buildStatus == Program::STATUS_PASSED;
@@ -683,7 +706,7 @@ int main (int argc, const char* argv[])
 																 baselineSpirvVersion,
 																 maxSpirvVersion);
 
-		tcu::print("DONE: %d passed, %d failed, %d not supported\n", stats.numSucceeded, stats.numFailed, stats.notSupported);
+		tcu::print("DONE: %d passed, %d failed, %d not supported, %d reused without compiling\n", stats.numSucceeded, stats.numFailed, stats.notSupported, stats.numReused);
 
 		return stats.numFailed == 0 ? 0 : -1;
 	}
@@ -0,0 +1,230 @@
+/*-------------------------------------------------------------------------
+ * Vulkan Conformance Tests
+ * ------------------------
+ *
+ * Copyright (c) 2018 Google Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Local compile server shared by test processes on the same host
+ *
+ * Test processes started with --deqp-compile-server-port send program
+ * builds to this server. Compilers stay initialized for the lifetime of
+ * the server, and identical requests from different processes are built
+ * only once.
+ *//*--------------------------------------------------------------------*/
+
+#include "vkCompileServer.hpp"
+#include "xsTcpServer.hpp"
+#include "deCommandLine.hpp"
+#include "deSemaphore.hpp"
+#include "deMutex.hpp"
+#include "deSharedPtr.hpp"
+#include "deThread.hpp"
+
+#include <iostream>
+#include <map>
+#include <deque>
+#include <cstdio>
+
+using std::vector;
+using de::SharedPtr;
+
+namespace vkt
+{
+
+namespace // anonymous
+{
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Results of recent requests
+ *
+ * A request that is already being built by another connection waits for
+ * that build instead of starting a new one. Oldest results are dropped
+ * once cache has more than maxEntries results.
+ *//*--------------------------------------------------------------------*/
+class ResultCache
+{
+public:
+	ResultCache (size_t maxEntries, int maxConcurrentBuilds)
+		: m_maxEntries	(maxEntries)
+		, m_buildSlots	(maxConcurrentBuilds)
+	{
+	}
+
+	void getResult (const vector<deUint8>& request, vector<deUint8>& result)
+	{
+		const SharedPtr<Entry>	entry	= getEntry(request);
+		const de::ScopedLock	lock	(entry->lock);
+
+		if (!entry->done)
+		{
+			m_buildSlots.decrement();
+
+			try
+			{
+				vk::processCompileRequest(request, entry->result);
+			}
+			catch (...)
+			{
+				m_buildSlots.increment();
+				throw;
+			}
+
+			m_buildSlots.increment();
+			entry->done = true;
+		}
+
+		result = entry->result;
+	}
+
+private:
+	struct Entry
+	{
+		Entry (void) : done(false) {}
+
+		de::Mutex			lock;
+		bool				done;
+		vector<deUint8>		result;
+	};
+
+	typedef std::map<vector<deUint8>, SharedPtr<Entry> >	EntryMap;
+
+	SharedPtr<Entry> getEntry (const vector<deUint8>& request)
+	{
+		const de::ScopedLock		lock		(m_entryLock);
+		const EntryMap::iterator	existing	= m_entries.find(request);
+
+		if (existing != m_entries.end())
+			return existing->second;
+
+		{
+			const SharedPtr<Entry>	entry	(new Entry());
+
+			m_order.push_back(m_entries.insert(std::make_pair(request, entry)).first);
+
+			// Dropped entries stay alive until connections using them are done.
+			while (m_order.size() > m_maxEntries)
+			{
+				m_entries.erase(m_order.front());
+				m_order.pop_front();
+			}
+
+			return entry;
+		}
+	}
+
+	const size_t					m_maxEntries;
+	de::Semaphore					m_buildSlots;
+
+	de::Mutex						m_entryLock;
+	EntryMap						m_entries;
+	std::deque<EntryMap::iterator>	m_order;
+};
+
+class CompileConnectionHandler : public xs::ConnectionHandler
+{
+public:
+	CompileConnectionHandler (xs::TcpServer* server, de::Socket* socket, ResultCache& cache)
+		: xs::ConnectionHandler	(server, socket)
+		, m_cache				(cache)
+	{
+	}
+
+protected:
+	void handle (void)
+	{
+		vector<deUint8>	request;
+		vector<deUint8>	result;
+
+		while (vk::receiveCompileMessage(*m_socket, xs::MESSAGETYPE_COMPILE_PROGRAM, request))
+		{
+			m_cache.getResult(request, result);
+			vk::sendCompileMessage(*m_socket, xs::MESSAGETYPE_COMPILE_RESULT, result);
+		}
+	}
+
+private:
+	ResultCache&	m_cache;
+};
+
+class CompileServer : public xs::TcpServer
+{
+public:
+	CompileServer (int port, size_t maxCachedResults)
+		: xs::TcpServer	(DE_SOCKETFAMILY_INET4, port, "127.0.0.1")
+		, m_cache		(maxCachedResults, de::max(1, (int)deGetNumAvailableLogicalCores()))
+	{
+	}
+
+	xs::ConnectionHandler* createHandler (de::Socket* socket, const de::SocketAddress&)
+	{
+		return new CompileConnectionHandler(this, socket, m_cache);
+	}
+
+private:
+	ResultCache		m_cache;
+};
+
+} // anonymous
+} // vkt
+
+namespace opt
+{
+
+DE_DECLARE_COMMAND_LINE_OPT(Port,			int);
+DE_DECLARE_COMMAND_LINE_OPT(CacheSize,		int);
+
+void registerOptions (de::cmdline::Parser& parser)
+{
+	using de::cmdline::Option;
+
+	parser << Option<Port>		("p", "port",		"Port (listens on 127.0.0.1 only)", "50020")
+		   << Option<CacheSize>	("c", "cache-size",	"Number of build results kept in memory", "4096");
+}
+
+} // opt
+
+int main (int argc, const char* argv[])
+{
+	de::cmdline::CommandLine	cmdLine;
+
+	{
+		de::cmdline::Parser		parser;
+		opt::registerOptions(parser);
+		if (!parser.parse(argc, argv, &cmdLine, std::cerr))
+		{
+			parser.help(std::cout);
+			return -1;
+		}
+	}
+
+	try
+	{
+		vkt::CompileServer	server	(cmdLine.getOption<opt::Port>(), (size_t)de::max(1, cmdLine.getOption<opt::CacheSize>()));
+
+		printf("Listening on 127.0.0.1:%d\n", cmdLine.getOption<opt::Port>());
+		fflush(stdout);
+
+		server.runServer();
+	}
+	catch (const std::exception& e)
+	{
+		printf("%s\n", e.what());
+		return -1;
+	}
+
+	return 0;
+}
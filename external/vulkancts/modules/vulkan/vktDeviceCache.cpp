@@ -0,0 +1,336 @@
+/*-------------------------------------------------------------------------
+ * Vulkan Conformance Tests
+ * ------------------------
+ *
+ * Copyright (c) 2019 Google Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Cache of custom devices shared between test cases
+ *//*--------------------------------------------------------------------*/
+
+#include "vktDeviceCache.hpp"
+#include "vkPlatform.hpp"
+#include "vkRefUtil.hpp"
+#include "vkQueryUtil.hpp"
+#include "deMemory.h"
+
+#include <algorithm>
+#include <string>
+
+namespace vkt
+{
+
+using namespace vk;
+
+using std::vector;
+using std::string;
+using de::SharedPtr;
+
+struct CustomDevice::Entry
+{
+	Entry (void) : inUse(false), lastUse(0u) {}
+
+	vector<deUint8>				key;		//!< Empty if device is never reused
+	Move<VkDevice>				device;
+	de::MovePtr<DeviceDriver>	driver;
+	bool						inUse;
+	deUint64					lastUse;
+};
+
+namespace
+{
+
+struct StructHeader
+{
+	VkStructureType				sType;
+	const void*					pNext;
+};
+
+void appendBytes (vector<deUint8>& key, const void* data, size_t size)
+{
+	key.insert(key.end(), (const deUint8*)data, (const deUint8*)data + size);
+}
+
+template<typename T>
+void appendValue (vector<deUint8>& key, const T& value)
+{
+	appendBytes(key, &value, sizeof(value));
+}
+
+void appendNames (vector<deUint8>& key, deUint32 count, const char* const* names)
+{
+	vector<string> sorted (names, names + count);
+
+	std::sort(sorted.begin(), sorted.end());
+
+	appendValue(key, count);
+
+	for (vector<string>::const_iterator name = sorted.begin(); name != sorted.end(); ++name)
+		appendBytes(key, name->c_str(), name->size() + 1);
+}
+
+//! Get size of feature structure up to and including its last member, or 0 if sType is not a known feature structure.
+size_t getFeatureStructSize (VkStructureType sType)
+{
+#define FEATURE_STRUCT(TYPE, LAST_MEMBER) { getStructureType<TYPE>(), DE_OFFSET_OF(TYPE, LAST_MEMBER) + sizeof(VkBool32) }
+
+	// All members following sType and pNext are VkBool32.
+	const struct
+	{
+		VkStructureType	sType;
+		size_t			size;
+	} featureStructs[] =
+	{
+		FEATURE_STRUCT(VkPhysicalDevice8BitStorageFeaturesKHR,				storagePushConstant8),
+		FEATURE_STRUCT(VkPhysicalDevice16BitStorageFeatures,				storageInputOutput16),
+		FEATURE_STRUCT(VkPhysicalDeviceMultiviewFeatures,					multiviewTessellationShader),
+		FEATURE_STRUCT(VkPhysicalDeviceVariablePointerFeatures,				variablePointers),
+		FEATURE_STRUCT(VkPhysicalDeviceProtectedMemoryFeatures,				protectedMemory),
+		FEATURE_STRUCT(VkPhysicalDeviceSamplerYcbcrConversionFeatures,		samplerYcbcrConversion),
+		FEATURE_STRUCT(VkPhysicalDeviceShaderDrawParameterFeatures,			shaderDrawParameters),
+		FEATURE_STRUCT(VkPhysicalDeviceFloat16Int8FeaturesKHR,				shaderInt8),
+		FEATURE_STRUCT(VkPhysicalDeviceConditionalRenderingFeaturesEXT,		inheritedConditionalRendering),
+		FEATURE_STRUCT(VkPhysicalDeviceBlendOperationAdvancedFeaturesEXT,	advancedBlendCoherentOperations),
+		FEATURE_STRUCT(VkPhysicalDeviceVertexAttributeDivisorFeaturesEXT,	vertexAttributeInstanceRateZeroDivisor),
+		FEATURE_STRUCT(VkPhysicalDeviceDescriptorIndexingFeaturesEXT,		runtimeDescriptorArray),
+		FEATURE_STRUCT(VkPhysicalDeviceInlineUniformBlockFeaturesEXT,		descriptorBindingInlineUniformBlockUpdateAfterBind),
+		FEATURE_STRUCT(VkPhysicalDeviceShaderAtomicInt64FeaturesKHR,		shaderSharedInt64Atomics),
+		FEATURE_STRUCT(VkPhysicalDeviceVulkanMemoryModelFeaturesKHR,		vulkanMemoryModelDeviceScope),
+		FEATURE_STRUCT(VkPhysicalDeviceScalarBlockLayoutFeaturesEXT,		scalarBlockLayout),
+	};
+
+#undef FEATURE_STRUCT
+
+	for (int structNdx = 0; structNdx < DE_LENGTH_OF_ARRAY(featureStructs); structNdx++)
+	{
+		if (featureStructs[structNdx].sType == sType)
+			return featureStructs[structNdx].size;
+	}
+
+	return 0;
+}
+
+bool compareQueueFamily (const VkDeviceQueueCreateInfo* a, const VkDeviceQueueCreateInfo* b)
+{
+	return a->queueFamilyIndex < b->queueFamilyIndex;
+}
+
+//! Build normalized key of create info. Returns false if device can not be reused.
+bool buildKey (VkPhysicalDevice physicalDevice, const VkDeviceCreateInfo& createInfo, vector<deUint8>& key)
+{
+	VkPhysicalDeviceFeatures	features;
+
+	deMemset(&features, 0, sizeof(features));
+
+	if (createInfo.pEnabledFeatures)
+		features = *createInfo.pEnabledFeatures;
+
+	appendValue(key, physicalDevice);
+	appendValue(key, createInfo.flags);
+
+	for (const StructHeader* ext = (const StructHeader*)createInfo.pNext; ext; ext = (const StructHeader*)ext->pNext)
+	{
+		if (ext->sType == VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2)
+			features = ((const VkPhysicalDeviceFeatures2*)ext)->features;
+		else if (ext->sType == VK_STRUCTURE_TYPE_DEVICE_GROUP_DEVICE_CREATE_INFO)
+		{
+			const VkDeviceGroupDeviceCreateInfo* groupInfo = (const VkDeviceGroupDeviceCreateInfo*)ext;
+
+			appendValue(key, ext->sType);
+			appendValue(key, groupInfo->physicalDeviceCount);
+			appendBytes(key, groupInfo->pPhysicalDevices, groupInfo->physicalDeviceCount * sizeof(VkPhysicalDevice));
+		}
+		else if (const size_t size = getFeatureStructSize(ext->sType))
+		{
+			appendValue(key, ext->sType);
+			appendBytes(key, (const deUint8*)ext + sizeof(StructHeader), size - sizeof(StructHeader));
+		}
+		else
+			return false;
+	}
+
+	appendValue(key, features);
+
+	{
+		vector<const VkDeviceQueueCreateInfo*> queueInfos;
+
+		for (deUint32 queueInfoNdx = 0; queueInfoNdx < createInfo.queueCreateInfoCount; queueInfoNdx++)
+		{
+			if (createInfo.pQueueCreateInfos[queueInfoNdx].pNext)
+				return false;
+
+			queueInfos.push_back(&createInfo.pQueueCreateInfos[queueInfoNdx]);
+		}
+
+		std::sort(queueInfos.begin(), queueInfos.end(), compareQueueFamily);
+
+		appendValue(key, createInfo.queueCreateInfoCount);
+
+		for (size_t queueInfoNdx = 0; queueInfoNdx < queueInfos.size(); queueInfoNdx++)
+		{
+			appendValue(key, queueInfos[queueInfoNdx]->flags);
+			appendValue(key, queueInfos[queueInfoNdx]->queueFamilyIndex);
+			appendValue(key, queueInfos[queueInfoNdx]->queueCount);
+			appendBytes(key, queueInfos[queueInfoNdx]->pQueuePriorities, queueInfos[queueInfoNdx]->queueCount * sizeof(float));
+		}
+	}
+
+	appendNames(key, createInfo.enabledLayerCount, createInfo.ppEnabledLayerNames);
+	appendNames(key, createInfo.enabledExtensionCount, createInfo.ppEnabledExtensionNames);
+
+	return true;
+}
+
+} // anonymous
+
+// CustomDevice
+
+CustomDevice::CustomDevice (DeviceCache* cache, const SharedPtr<Entry>& entry, bool reused)
+	: m_cache	(cache)
+	, m_entry	(entry)
+	, m_reused	(reused)
+{
+}
+
+CustomDevice::~CustomDevice (void)
+{
+	m_cache->release(m_entry);
+}
+
+VkDevice CustomDevice::getDevice (void) const
+{
+	return *m_entry->device;
+}
+
+const DeviceInterface& CustomDevice::getDeviceInterface (void) const
+{
+	return *m_entry->driver;
+}
+
+// DeviceCache
+
+DeviceCache::DeviceCache (const PlatformInterface&	vkp,
+						  VkInstance				instance,
+						  const InstanceInterface&	vki,
+						  size_t					maxIdleDevices)
+	: m_vkp				(vkp)
+	, m_instance		(instance)
+	, m_vki				(vki)
+	, m_maxIdleDevices	(maxIdleDevices)
+	, m_useCounter		(0u)
+{
+}
+
+DeviceCache::~DeviceCache (void)
+{
+	clear();
+
+	// Leases must end before cache is destroyed.
+	DE_ASSERT(m_entries.empty());
+}
+
+de::MovePtr<CustomDevice> DeviceCache::getDevice (VkPhysicalDevice physicalDevice, const VkDeviceCreateInfo& createInfo, bool allowReuse)
+{
+	vector<deUint8>	key;
+
+	if (!allowReuse || m_maxIdleDevices == 0 || !buildKey(physicalDevice, createInfo, key))
+		key.clear();
+
+	if (!key.empty())
+	{
+		for (EntryList::iterator iter = m_entries.begin(); iter != m_entries.end(); ++iter)
+		{
+			const SharedPtr<Entry>& entry = *iter;
+
+			if (entry->inUse || entry->key != key)
+				continue;
+
+			// Device that has been lost or hangs can't be reused.
+			if (entry->driver->deviceWaitIdle(*entry->device) != VK_SUCCESS)
+			{
+				m_entries.erase(iter);
+				break;
+			}
+
+			entry->inUse	= true;
+			entry->lastUse	= ++m_useCounter;
+
+			return de::MovePtr<CustomDevice>(new CustomDevice(this, entry, true));
+		}
+	}
+
+	{
+		const SharedPtr<Entry> entry (new Entry());
+
+		entry->key		= key;
+		entry->device	= createDevice(m_vkp, m_instance, m_vki, physicalDevice, &createInfo);
+		entry->driver	= de::MovePtr<DeviceDriver>(new DeviceDriver(m_vkp, m_instance, *entry->device));
+		entry->inUse	= true;
+		entry->lastUse	= ++m_useCounter;
+
+		if (!key.empty())
+			m_entries.push_back(entry);
+
+		return de::MovePtr<CustomDevice>(new CustomDevice(this, entry, false));
+	}
+}
+
+void DeviceCache::release (const SharedPtr<Entry>& entry)
+{
+	// Devices that are not reused are destroyed with their last reference.
+	entry->inUse = false;
+	evictIdle();
+}
+
+void DeviceCache::evictIdle (void)
+{
+	for (;;)
+	{
+		EntryList::iterator	oldest		= m_entries.end();
+		size_t				numIdle		= 0;
+
+		for (EntryList::iterator iter = m_entries.begin(); iter != m_entries.end(); ++iter)
+		{
+			if ((*iter)->inUse)
+				continue;
+
+			numIdle += 1;
+
+			if (oldest == m_entries.end() || (*iter)->lastUse < (*oldest)->lastUse)
+				oldest = iter;
+		}
+
+		if (numIdle <= m_maxIdleDevices)
+			break;
+
+		m_entries.erase(oldest);
+	}
+}
+
+void DeviceCache::clear (void)
+{
+	EntryList inUse;
+
+	for (EntryList::const_iterator iter = m_entries.begin(); iter != m_entries.end(); ++iter)
+	{
+		if ((*iter)->inUse)
+			inUse.push_back(*iter);
+	}
+
+	m_entries.swap(inUse);
+}
+
+} // vkt
@@ -0,0 +1,124 @@
+#ifndef _VKTDEVICECACHE_HPP
+#define _VKTDEVICECACHE_HPP
+/*-------------------------------------------------------------------------
+ * Vulkan Conformance Tests
+ * ------------------------
+ *
+ * Copyright (c) 2019 Google Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Cache of custom devices shared between test cases
+ *//*--------------------------------------------------------------------*/
+
+#include "vkDefs.hpp"
+#include "vkRef.hpp"
+#include "deSharedPtr.hpp"
+#include "deUniquePtr.hpp"
+
+#include <vector>
+
+namespace vkt
+{
+
+class DeviceCache;
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Device leased from DeviceCache
+ *
+ * Device is returned to the cache when this object is destroyed. All
+ * objects created on the device must be destroyed before that.
+ *//*--------------------------------------------------------------------*/
+class CustomDevice
+{
+public:
+									~CustomDevice			(void);
+
+	vk::VkDevice					getDevice				(void) const;
+	const vk::DeviceInterface&		getDeviceInterface		(void) const;
+
+	//! True if device was reused from earlier lease instead of being created for this one.
+	bool							isReused				(void) const { return m_reused; }
+
+private:
+	friend class DeviceCache;
+
+	struct Entry;
+
+									CustomDevice			(DeviceCache* cache, const de::SharedPtr<Entry>& entry, bool reused);
+									CustomDevice			(const CustomDevice&);
+	CustomDevice&					operator=				(const CustomDevice&);
+
+	DeviceCache* const				m_cache;
+	const de::SharedPtr<Entry>		m_entry;
+	const bool						m_reused;
+};
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Cache of custom devices
+ *
+ * Devices are created on the instance given to the cache, which must
+ * outlive it. Device created with identical parameters (physical device
+ * and create info, with queue create infos, layers and extensions in any
+ * order) is reused if an idle one exists. Idle devices are checked with
+ * vkDeviceWaitIdle() before reuse, and least recently used idle devices
+ * are destroyed when more than maxIdleDevices are kept.
+ *
+ * Create infos with pNext structures other than feature structures and
+ * VkDeviceGroupDeviceCreateInfo always get a new device, as do requests
+ * with allowReuse = false. Such devices are destroyed when the
+ * lease ends.
+ *//*--------------------------------------------------------------------*/
+class DeviceCache
+{
+public:
+									DeviceCache				(const vk::PlatformInterface&		vkp,
+															 vk::VkInstance						instance,
+															 const vk::InstanceInterface&		vki,
+															 size_t								maxIdleDevices);
+									~DeviceCache			(void);
+
+	de::MovePtr<CustomDevice>		getDevice				(vk::VkPhysicalDevice				physicalDevice,
+															 const vk::VkDeviceCreateInfo&		createInfo,
+															 bool								allowReuse	= true);
+
+	//! Destroy all idle devices.
+	void							clear					(void);
+
+	size_t							getNumDevices			(void) const { return m_entries.size(); }
+
+private:
+	friend class CustomDevice;
+
+	typedef CustomDevice::Entry						Entry;
+	typedef std::vector<de::SharedPtr<Entry> >		EntryList;
+
+									DeviceCache				(const DeviceCache&);
+	DeviceCache&					operator=				(const DeviceCache&);
+
+	void							release					(const de::SharedPtr<Entry>& entry);
+	void							evictIdle				(void);
+
+	const vk::PlatformInterface&	m_vkp;
+	const vk::VkInstance			m_instance;
+	const vk::InstanceInterface&	m_vki;
+	const size_t					m_maxIdleDevices;
+	EntryList						m_entries;
+	deUint64						m_useCounter;
+};
+
+} // vkt
+
+#endif // _VKTDEVICECACHE_HPP
@@ -22,6 +22,7 @@
  *//*--------------------------------------------------------------------*/
 
 #include "vktTestCase.hpp"
+#include "vktDeviceCache.hpp"
 
 #include "vkRef.hpp"
 #include "vkRefUtil.hpp"
@@ -30,6 +31,9 @@
 #include "vkMemUtil.hpp"
 #include "vkPlatform.hpp"
 #include "vkDebugReportUtil.hpp"
+#include "vkCmdUtil.hpp"
+#include "vkReadbackQueue.hpp"
+#include "vkPipelineCacheUtil.hpp"
 
 #include "tcuCommandLine.hpp"
 
@@ -556,6 +560,28 @@ vk::Allocator* createAllocator (DefaultDevice* device)
 	return new SimpleAllocator(device->getDeviceInterface(), device->getDevice(), memoryProperties);
 }
 
+Move<VkPipelineCache> createDefaultPipelineCache (const DefaultDevice& device, const tcu::CommandLine& cmdLine)
+{
+	if (cmdLine.isPipelineCacheEnabled())
+		return createPipelineCacheFromFile(device.getInstanceInterface(), device.getPhysicalDevice(), device.getDeviceInterface(), device.getDevice(), cmdLine.getPipelineCacheFilename());
+	else
+		return Move<VkPipelineCache>();
+}
+
+Move<VkPipelineCache> createEmptyPipelineCache (const DefaultDevice& device)
+{
+	const VkPipelineCacheCreateInfo	createInfo	=
+	{
+		VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,	// VkStructureType				sType;
+		DE_NULL,										// const void*					pNext;
+		0u,												// VkPipelineCacheCreateFlags	flags;
+		0u,												// deUintptr					initialDataSize;
+		DE_NULL,										// const void*					pInitialData;
+	};
+
+	return createPipelineCache(device.getDeviceInterface(), device.getDevice(), &createInfo);
+}
+
 } // anonymous
 
 // Context
@@ -568,11 +594,45 @@ Context::Context (tcu::TestContext&				testCtx,
 	, m_progCollection		(progCollection)
 	, m_device				(new DefaultDevice(m_platformInterface, testCtx.getCommandLine()))
 	, m_allocator			(createAllocator(m_device.get()))
+	, m_submissionPool		(new vk::SubmissionPool(m_device->getDeviceInterface(), m_device->getDevice(), m_device->getUniversalQueue(), m_device->getUniversalQueueFamilyIndex()))
+	, m_readbackQueue		(new vk::ReadbackQueue(m_device->getDeviceInterface(), m_device->getDevice(), m_device->getUniversalQueue(), m_device->getUniversalQueueFamilyIndex(), *m_allocator))
+	, m_deviceCache			(new DeviceCache(m_platformInterface, m_device->getInstance(), m_device->getInstanceInterface(), (size_t)de::max(0, testCtx.getCommandLine().getDeviceCacheSize())))
+	, m_pipelineCache		(createDefaultPipelineCache(*m_device, testCtx.getCommandLine()))
+{
+	setDefaultPipelineCache(m_device->getDevice(), *m_pipelineCache);
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Replace default pipeline cache with an empty one if it is too large
+ *
+ * Drivers never evict pipeline cache entries, so a cache shared by a whole
+ * session grows with every distinct pipeline. Must not be called while
+ * pipelines are created; cache handles obtained earlier become invalid.
+ * Returns true if the cache was replaced.
+ *//*--------------------------------------------------------------------*/
+bool Context::limitPipelineCacheSize (size_t maxDataSize)
 {
+	if (*m_pipelineCache == DE_NULL || (size_t)getPipelineCacheDataSize(m_device->getDeviceInterface(), m_device->getDevice(), *m_pipelineCache) <= maxDataSize)
+		return false;
+
+	setDefaultPipelineCache(DE_NULL, DE_NULL);
+	m_pipelineCache = createEmptyPipelineCache(*m_device);
+	setDefaultPipelineCache(m_device->getDevice(), *m_pipelineCache);
+
+	return true;
 }
 
 Context::~Context (void)
 {
+	const std::string	cacheFilename	= m_testCtx.getCommandLine().getPipelineCacheFilename();
+
+	setDefaultPipelineCache(DE_NULL, DE_NULL);
+
+	if (*m_pipelineCache != DE_NULL && !cacheFilename.empty())
+	{
+		if (!savePipelineCacheToFile(m_device->getInstanceInterface(), m_device->getPhysicalDevice(), m_device->getDeviceInterface(), m_device->getDevice(), *m_pipelineCache, cacheFilename))
+			tcu::print("WARNING: Failed to write pipeline cache to %s\n", cacheFilename.c_str());
+	}
 }
 
 deUint32								Context::getAvailableInstanceVersion	(void) const { return m_device->getAvailableInstanceVersion();	}
@@ -613,6 +673,9 @@ vk::VkQueue								Context::getUniversalQueue				(void) const { return m_device-
 deUint32								Context::getSparseQueueFamilyIndex		(void) const { return m_device->getSparseQueueFamilyIndex();	}
 vk::VkQueue								Context::getSparseQueue					(void) const { return m_device->getSparseQueue();				}
 vk::Allocator&							Context::getDefaultAllocator			(void) const { return *m_allocator;								}
+vk::ReadbackQueue&						Context::getReadbackQueue				(void) const { return *m_readbackQueue;							}
+DeviceCache&							Context::getDeviceCache					(void) const { return *m_deviceCache;							}
+vk::VkPipelineCache						Context::getPipelineCache				(void) const { return *m_pipelineCache;							}
 deUint32								Context::getUsedApiVersion				(void) const { return m_device->getUsedApiVersion();			}
 bool									Context::contextSupports				(const deUint32 majorNum, const deUint32 minorNum, const deUint32 patchNum) const
 																							{ return m_device->getUsedApiVersion() >= VK_MAKE_VERSION(majorNum, minorNum, patchNum); }
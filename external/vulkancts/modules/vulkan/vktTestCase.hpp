@@ -40,6 +40,8 @@ namespace vk
 {
 class PlatformInterface;
 class Allocator;
+class SubmissionPool;
+class ReadbackQueue;
 struct SourceCollections;
 }
 
@@ -47,6 +49,7 @@ namespace vkt
 {
 
 class DefaultDevice;
+class DeviceCache;
 
 class Context
 {
@@ -100,6 +103,10 @@ public:
 	deUint32									getSparseQueueFamilyIndex		(void) const;
 	vk::VkQueue									getSparseQueue					(void) const;
 	vk::Allocator&								getDefaultAllocator				(void) const;
+	vk::ReadbackQueue&							getReadbackQueue				(void) const;
+	DeviceCache&								getDeviceCache					(void) const;
+	vk::VkPipelineCache							getPipelineCache				(void) const;
+	bool										limitPipelineCacheSize			(size_t maxDataSize);
 	bool										contextSupports					(const deUint32 majorNum, const deUint32 minorNum, const deUint32 patchNum) const;
 	bool										contextSupports					(const vk::ApiVersion version) const;
 	bool										contextSupports					(const deUint32 requiredApiVersionBits) const;
@@ -114,6 +121,10 @@ protected:
 
 	const de::UniquePtr<DefaultDevice>			m_device;
 	const de::UniquePtr<vk::Allocator>			m_allocator;
+	const de::UniquePtr<vk::SubmissionPool>		m_submissionPool;
+	const de::UniquePtr<vk::ReadbackQueue>		m_readbackQueue;
+	const de::UniquePtr<DeviceCache>			m_deviceCache;
+	vk::Move<vk::VkPipelineCache>				m_pipelineCache;	//!< Default cache of object utilities, null if disabled
 
 private:
 												Context							(const Context&); // Not allowed
@@ -27,16 +27,22 @@
 #include "tcuTestCase.hpp"
 #include "tcuTestLog.hpp"
 #include "tcuCommandLine.hpp"
+#include "tcuScopedTimer.hpp"
+#include "tcuWorkerPool.hpp"
 
 #include "vkPlatform.hpp"
 #include "vkPrograms.hpp"
+#include "vkProgramBinaryCache.hpp"
 #include "vkBinaryRegistry.hpp"
 #include "vkShaderToSpirV.hpp"
 #include "vkDebugReportUtil.hpp"
 #include "vkQueryUtil.hpp"
 #include "vkApiVersion.hpp"
+#include "vkReadbackQueue.hpp"
 
 #include "deUniquePtr.hpp"
+#include "deSharedPtr.hpp"
+#include "deSemaphore.hpp"
 
 #include "vktTestGroupUtil.hpp"
 #include "vktApiTests.hpp"
@@ -90,58 +96,150 @@
 #include "vktMetamorphicTests.hpp"
 
 #include <vector>
+#include <map>
 #include <sstream>
 
 namespace // compilation
 {
 
-vk::ProgramBinary* compileProgram (const vk::GlslSource& source, glu::ShaderProgramInfo* buildInfo, const tcu::CommandLine& commandLine)
+//! Build program, reusing binaries built earlier in the session if cache is not null. Cache use is counted into cacheStats.
+vk::ProgramBinary* compileProgram (const vk::GlslSource& source, glu::ShaderProgramInfo* buildInfo, const tcu::CommandLine& commandLine, vk::ProgramBinaryCache* cache, vk::ProgramBinaryCache::Statistics* cacheStats)
 {
-	return vk::buildProgram(source, buildInfo, commandLine);
+	if (cache)
+		return cache->buildProgram(source, buildInfo, commandLine, cacheStats);
+	else
+		return vk::buildProgram(source, buildInfo, commandLine);
 }
 
-vk::ProgramBinary* compileProgram (const vk::HlslSource& source, glu::ShaderProgramInfo* buildInfo, const tcu::CommandLine& commandLine)
+vk::ProgramBinary* compileProgram (const vk::HlslSource& source, glu::ShaderProgramInfo* buildInfo, const tcu::CommandLine& commandLine, vk::ProgramBinaryCache* cache, vk::ProgramBinaryCache::Statistics* cacheStats)
 {
-	return vk::buildProgram(source, buildInfo, commandLine);
+	if (cache)
+		return cache->buildProgram(source, buildInfo, commandLine, cacheStats);
+	else
+		return vk::buildProgram(source, buildInfo, commandLine);
 }
 
-vk::ProgramBinary* compileProgram (const vk::SpirVAsmSource& source, vk::SpirVProgramInfo* buildInfo, const tcu::CommandLine& commandLine)
+vk::ProgramBinary* compileProgram (const vk::SpirVAsmSource& source, vk::SpirVProgramInfo* buildInfo, const tcu::CommandLine& commandLine, vk::ProgramBinaryCache* cache, vk::ProgramBinaryCache::Statistics* cacheStats)
 {
-	return vk::assembleProgram(source, buildInfo, commandLine);
+	if (cache)
+		return cache->assembleProgram(source, buildInfo, commandLine, cacheStats);
+	else
+		return vk::assembleProgram(source, buildInfo, commandLine);
 }
 
-template <typename InfoType, typename IteratorType>
-vk::ProgramBinary* buildProgram (const std::string&					casePath,
-								 IteratorType						iter,
-								 const vk::BinaryRegistryReader&	prebuiltBinRegistry,
-								 tcu::TestLog&						log,
-								 vk::BinaryCollection*				progCollection,
-								 const tcu::CommandLine&			commandLine)
+//! Program build (including validation and optional disassembly) executed in background
+template <typename SourceType, typename InfoType>
+class ProgramBuildTask : public tcu::WorkerPool::Task
+{
+public:
+	ProgramBuildTask (void)
+		: source		(DE_NULL)
+		, commandLine	(DE_NULL)
+		, cache			(DE_NULL)
+		, cacheStats	(DE_NULL)
+		, done			(DE_NULL)
+		, disassemble	(false)
+		, binary		(DE_NULL)
+		, disassembled	(false)
+	{
+	}
+
+	void execute (void)
+	{
+		try
+		{
+			binary = compileProgram(*source, &buildInfo, *commandLine, cache, cacheStats);
+		}
+		catch (...)
+		{
+			// Failed programs are built again in TestCaseExecutor::init() to report the error.
+			binary = DE_NULL;
+		}
+
+		if (binary && disassemble)
+		{
+			try
+			{
+				std::ostringstream disasm;
+
+				vk::disassembleProgram(*binary, &disasm);
+
+				disassembly = disasm.str();
+			}
+			catch (const tcu::NotSupportedError& err)
+			{
+				disassemblyError = de::SharedPtr<tcu::NotSupportedError>(new tcu::NotSupportedError(err));
+			}
+
+			disassembled = true;
+		}
+
+		done->increment();
+	}
+
+	const SourceType*			source;
+	const tcu::CommandLine*		commandLine;
+	vk::ProgramBinaryCache*		cache;			//!< Null if binaries are not reused
+	vk::ProgramBinaryCache::Statistics*	cacheStats;	//!< Cache use of the owning test case
+	de::Semaphore*				done;
+	bool						disassemble;
+
+	InfoType					buildInfo;
+	vk::ProgramBinary*			binary;			//!< Null if not built or build failed
+	bool						disassembled;	//!< True if binary was disassembled for shader log
+	std::string					disassembly;
+	de::SharedPtr<tcu::NotSupportedError>	disassemblyError;
+};
+
+typedef ProgramBuildTask<vk::GlslSource, glu::ShaderProgramInfo>		GlslBuildTask;
+typedef ProgramBuildTask<vk::HlslSource, glu::ShaderProgramInfo>		HlslBuildTask;
+typedef ProgramBuildTask<vk::SpirVAsmSource, vk::SpirVProgramInfo>		SpirVAsmBuildTask;
+
+template <typename InfoType, typename IteratorType, typename SourceType>
+vk::ProgramBinary* buildProgram (const std::string&						casePath,
+								 IteratorType							iter,
+								 const vk::BinaryRegistryReader&		prebuiltBinRegistry,
+								 tcu::TestLog&							log,
+								 vk::BinaryCollection*					progCollection,
+								 const tcu::CommandLine&				commandLine,
+								 vk::ProgramBinaryCache*				cache,
+								 vk::ProgramBinaryCache::Statistics*	cacheStats,
+								 ProgramBuildTask<SourceType, InfoType>*	prebuilt)
 {
+	const tcu::ScopedTimer			timer		("vkt::buildProgram");
 	const vk::ProgramIdentifier		progId		(casePath, iter.getName());
 	const tcu::ScopedLogSection		progSection	(log, iter.getName(), "Program: " + iter.getName());
 	de::MovePtr<vk::ProgramBinary>	binProg;
 	InfoType						buildInfo;
 
-	try
+	if (prebuilt && prebuilt->binary)
 	{
-		binProg	= de::MovePtr<vk::ProgramBinary>(compileProgram(iter.getProgram(), &buildInfo, commandLine));
-		log << buildInfo;
+		binProg				= de::MovePtr<vk::ProgramBinary>(prebuilt->binary);
+		prebuilt->binary	= DE_NULL;
+		log << prebuilt->buildInfo;
 	}
-	catch (const tcu::NotSupportedError& err)
+	else
 	{
-		// Try to load from cache
-		log << err << tcu::TestLog::Message << "Building from source not supported, loading stored binary instead" << tcu::TestLog::EndMessage;
+		try
+		{
+			binProg	= de::MovePtr<vk::ProgramBinary>(compileProgram(iter.getProgram(), &buildInfo, commandLine, cache, cacheStats));
+			log << buildInfo;
+		}
+		catch (const tcu::NotSupportedError& err)
+		{
+			// Try to load from cache
+			log << err << tcu::TestLog::Message << "Building from source not supported, loading stored binary instead" << tcu::TestLog::EndMessage;
 
-		binProg = de::MovePtr<vk::ProgramBinary>(prebuiltBinRegistry.loadProgram(progId));
+			binProg = de::MovePtr<vk::ProgramBinary>(prebuiltBinRegistry.loadProgram(progId));
 
-		log << iter.getProgram();
-	}
-	catch (const tcu::Exception&)
-	{
-		// Build failed for other reason
-		log << buildInfo;
-		throw;
+			log << iter.getProgram();
+		}
+		catch (const tcu::Exception&)
+		{
+			// Build failed for other reason
+			log << buildInfo;
+			throw;
+		}
 	}
 
 	TCU_CHECK_INTERNAL(binProg);
@@ -155,6 +253,33 @@ vk::ProgramBinary* buildProgram (const std::string&					casePath,
 	}
 }
 
+template <typename TaskType>
+void logProgramDisassembly (tcu::TestLog& log, const vk::ProgramBinary& binary, const TaskType* prebuilt)
+{
+	if (prebuilt && prebuilt->disassembled)
+	{
+		if (prebuilt->disassemblyError)
+			log << *prebuilt->disassemblyError;
+		else
+			log << vk::SpirVAsmSource(prebuilt->disassembly);
+
+		return;
+	}
+
+	try
+	{
+		std::ostringstream disasm;
+
+		vk::disassembleProgram(binary, &disasm);
+
+		log << vk::SpirVAsmSource(disasm.str());
+	}
+	catch (const tcu::NotSupportedError& err)
+	{
+		log << err;
+	}
+}
+
 } // anonymous(compilation)
 
 namespace vkt
@@ -168,6 +293,9 @@ using tcu::TestLog;
 namespace
 {
 
+//! Shared pipeline cache is recreated empty between test cases once its data grows over this size.
+static const size_t MAX_PIPELINE_CACHE_DATA_SIZE = 256u*1024u*1024u;
+
 MovePtr<vk::DebugReportRecorder> createDebugReportRecorder (const vk::PlatformInterface& vkp, const vk::InstanceInterface& vki, vk::VkInstance instance)
 {
 	if (isDebugReportSupported(vkp))
@@ -176,6 +304,142 @@ MovePtr<vk::DebugReportRecorder> createDebugReportRecorder (const vk::PlatformIn
 		TCU_THROW(NotSupportedError, "VK_EXT_debug_report is not supported");
 }
 
+vk::SourceCollections* createSourceCollections (deUint32 usedVulkanVersion)
+{
+	const vk::SpirvVersion		baselineSpirvVersion		= vk::getBaselineSpirvVersion(usedVulkanVersion);
+	vk::ShaderBuildOptions		defaultGlslBuildOptions		(usedVulkanVersion, baselineSpirvVersion, 0u);
+	vk::ShaderBuildOptions		defaultHlslBuildOptions		(usedVulkanVersion, baselineSpirvVersion, 0u);
+	vk::SpirVAsmBuildOptions	defaultSpirvAsmBuildOptions	(usedVulkanVersion, baselineSpirvVersion);
+
+	return new vk::SourceCollections(usedVulkanVersion, defaultGlslBuildOptions, defaultHlslBuildOptions, defaultSpirvAsmBuildOptions);
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Programs of a single test case
+ *
+ * Sources are initialized on construction. Binaries can optionally be
+ * built in background with submit(); programs that were not built, or
+ * failed to build, have no binary in their build task and are built by
+ * TestCaseExecutor::init() as usual. Program binary cache use of both
+ * is counted into getCacheStatistics().
+ *//*--------------------------------------------------------------------*/
+class CasePrograms
+{
+public:
+									CasePrograms		(const TestCase& testCase, deUint32 usedVulkanVersion);
+									~CasePrograms		(void);
+
+	void							submit				(tcu::WorkerPool& pool, const tcu::CommandLine& commandLine, vk::ProgramBinaryCache* cache, bool disassemble);
+	void							wait				(void);
+
+	const vk::SourceCollections&	getSources			(void) const	{ return *m_sources; }
+
+	GlslBuildTask*					getGlslBuild		(size_t ndx)	{ return ndx < m_glslBuilds.size() ? &m_glslBuilds[ndx] : DE_NULL;			}
+	HlslBuildTask*					getHlslBuild		(size_t ndx)	{ return ndx < m_hlslBuilds.size() ? &m_hlslBuilds[ndx] : DE_NULL;			}
+	SpirVAsmBuildTask*				getSpirVAsmBuild	(size_t ndx)	{ return ndx < m_spirvAsmBuilds.size() ? &m_spirvAsmBuilds[ndx] : DE_NULL;	}
+
+	//! Valid only after wait().
+	vk::ProgramBinaryCache::Statistics*	getCacheStatistics	(void)		{ return &m_cacheStats;	}
+
+private:
+									CasePrograms		(const CasePrograms&);
+	CasePrograms&					operator=			(const CasePrograms&);
+
+	const UniquePtr<vk::SourceCollections>	m_sources;
+
+	std::vector<GlslBuildTask>		m_glslBuilds;
+	std::vector<HlslBuildTask>		m_hlslBuilds;
+	std::vector<SpirVAsmBuildTask>	m_spirvAsmBuilds;
+
+	de::Semaphore					m_done;
+	int								m_numPending;
+
+	vk::ProgramBinaryCache::Statistics	m_cacheStats;
+};
+
+CasePrograms::CasePrograms (const TestCase& testCase, deUint32 usedVulkanVersion)
+	: m_sources		(createSourceCollections(usedVulkanVersion))
+	, m_done		(0)
+	, m_numPending	(0)
+{
+	testCase.initPrograms(*m_sources);
+}
+
+CasePrograms::~CasePrograms (void)
+{
+	wait();
+
+	for (size_t ndx = 0; ndx < m_glslBuilds.size(); ndx++)
+		delete m_glslBuilds[ndx].binary;
+
+	for (size_t ndx = 0; ndx < m_hlslBuilds.size(); ndx++)
+		delete m_hlslBuilds[ndx].binary;
+
+	for (size_t ndx = 0; ndx < m_spirvAsmBuilds.size(); ndx++)
+		delete m_spirvAsmBuilds[ndx].binary;
+}
+
+template <typename TaskType, typename IteratorType>
+static void createBuildTasks (IteratorType begin, IteratorType end, vk::SpirvVersion maxSpirvVersion, const tcu::CommandLine& commandLine, vk::ProgramBinaryCache* cache, vk::ProgramBinaryCache::Statistics* cacheStats, bool disassemble, de::Semaphore* done, std::vector<TaskType>& tasks)
+{
+	for (IteratorType progIter = begin; progIter != end; ++progIter)
+	{
+		TaskType task;
+
+		// Programs requiring unsupported SPIR-V are left to init(), which reports them as not supported.
+		if (progIter.getProgram().buildOptions.targetVersion <= maxSpirvVersion)
+		{
+			task.source			= &progIter.getProgram();
+			task.commandLine	= &commandLine;
+			task.cache			= cache;
+			task.cacheStats		= cacheStats;
+			task.done			= done;
+			task.disassemble	= disassemble;
+		}
+
+		tasks.push_back(task);
+	}
+}
+
+template <typename TaskType>
+static int submitBuildTasks (tcu::WorkerPool& pool, std::vector<TaskType>& tasks)
+{
+	int numSubmitted = 0;
+
+	for (size_t ndx = 0; ndx < tasks.size(); ndx++)
+	{
+		if (tasks[ndx].source)
+		{
+			pool.submit(&tasks[ndx]);
+			numSubmitted += 1;
+		}
+	}
+
+	return numSubmitted;
+}
+
+void CasePrograms::submit (tcu::WorkerPool& pool, const tcu::CommandLine& commandLine, vk::ProgramBinaryCache* cache, bool disassemble)
+{
+	const deUint32	usedVulkanVersion	= m_sources->usedVulkanVersion;
+
+	DE_ASSERT(m_glslBuilds.empty() && m_hlslBuilds.empty() && m_spirvAsmBuilds.empty());
+
+	// All tasks are created before any are submitted, as task addresses must stay stable.
+	createBuildTasks(m_sources->glslSources.begin(), m_sources->glslSources.end(), vk::getMaxSpirvVersionForGlsl(usedVulkanVersion), commandLine, cache, &m_cacheStats, disassemble, &m_done, m_glslBuilds);
+	createBuildTasks(m_sources->hlslSources.begin(), m_sources->hlslSources.end(), vk::getMaxSpirvVersionForGlsl(usedVulkanVersion), commandLine, cache, &m_cacheStats, disassemble, &m_done, m_hlslBuilds);
+	createBuildTasks(m_sources->spirvAsmSources.begin(), m_sources->spirvAsmSources.end(), vk::getMaxSpirvVersionForAsm(usedVulkanVersion), commandLine, cache, &m_cacheStats, false, &m_done, m_spirvAsmBuilds);
+
+	m_numPending += submitBuildTasks(pool, m_glslBuilds);
+	m_numPending += submitBuildTasks(pool, m_hlslBuilds);
+	m_numPending += submitBuildTasks(pool, m_spirvAsmBuilds);
+}
+
+void CasePrograms::wait (void)
+{
+	for (; m_numPending > 0; m_numPending--)
+		m_done.decrement();
+}
+
 } // anonymous
 
 // TestCaseExecutor
@@ -191,9 +455,14 @@ public:
 
 	virtual tcu::TestNode::IterateResult		iterate				(tcu::TestCase* testCase);
 
+	virtual void								prepare				(const vector<tcu::TestCase*>& cases, const vector<std::string>& casePaths);
+
 private:
+	typedef std::map<const tcu::TestCase*, de::SharedPtr<CasePrograms> >	CaseProgramMap;
+
 	vk::BinaryCollection						m_progCollection;
 	vk::BinaryRegistryReader					m_prebuiltBinRegistry;
+	const UniquePtr<vk::ProgramBinaryCache>		m_programCache;		//!< Binaries built earlier in this session, null if disabled
 
 	const UniquePtr<vk::Library>				m_library;
 	Context										m_context;
@@ -201,6 +470,9 @@ private:
 	const UniquePtr<vk::DebugReportRecorder>	m_debugReportRecorder;
 
 	TestInstance*								m_instance;			//!< Current test case instance
+
+	const UniquePtr<tcu::WorkerPool>			m_buildPool;		//!< Background program build threads, if case look-ahead is enabled
+	CaseProgramMap								m_preparedPrograms;	//!< Programs of current and upcoming cases, see prepare()
 };
 
 static MovePtr<vk::Library> createLibrary (tcu::TestContext& testCtx)
@@ -208,8 +480,26 @@ static MovePtr<vk::Library> createLibrary (tcu::TestContext& testCtx)
 	return MovePtr<vk::Library>(testCtx.getPlatform().getVulkanPlatform().createLibrary());
 }
 
+static MovePtr<vk::ProgramBinaryCache> createProgramCache (tcu::TestContext& testCtx)
+{
+	if (testCtx.getCommandLine().isVkProgramBinaryCacheEnabled())
+		return MovePtr<vk::ProgramBinaryCache>(new vk::ProgramBinaryCache());
+	else
+		return MovePtr<vk::ProgramBinaryCache>(DE_NULL);
+}
+
+static MovePtr<tcu::WorkerPool> createBuildPool (tcu::TestContext& testCtx)
+{
+	// Without look-ahead programs are built in the calling thread, as before.
+	if (testCtx.getCommandLine().getCaseLookahead() > 0)
+		return MovePtr<tcu::WorkerPool>(new tcu::WorkerPool(de::max(1, (int)deGetNumAvailableLogicalCores() - 1)));
+	else
+		return MovePtr<tcu::WorkerPool>(DE_NULL);
+}
+
 TestCaseExecutor::TestCaseExecutor (tcu::TestContext& testCtx)
 	: m_prebuiltBinRegistry	(testCtx.getArchive(), "vulkan/prebuilt")
+	, m_programCache		(createProgramCache(testCtx))
 	, m_library				(createLibrary(testCtx))
 	, m_context				(testCtx, m_library->getPlatformInterface(), m_progCollection)
 	, m_debugReportRecorder	(testCtx.getCommandLine().isValidationEnabled()
@@ -218,12 +508,54 @@ TestCaseExecutor::TestCaseExecutor (tcu::TestContext& testCtx)
 														 m_context.getInstance())
 							 : MovePtr<vk::DebugReportRecorder>(DE_NULL))
 	, m_instance			(DE_NULL)
+	, m_buildPool			(createBuildPool(testCtx))
 {
 }
 
 TestCaseExecutor::~TestCaseExecutor (void)
 {
 	delete m_instance;
+
+	// Wait for background builds before the build pool is destroyed.
+	m_preparedPrograms.clear();
+}
+
+void TestCaseExecutor::prepare (const vector<tcu::TestCase*>& cases, const vector<std::string>& casePaths)
+{
+	const deUint32	usedVulkanVersion	= m_context.getUsedApiVersion();
+	CaseProgramMap	prepared;
+
+	DE_UNREF(casePaths);
+
+	if (!m_buildPool)
+		return;
+
+	for (size_t caseNdx = 0; caseNdx < cases.size(); caseNdx++)
+	{
+		const CaseProgramMap::const_iterator	existing	= m_preparedPrograms.find(cases[caseNdx]);
+		const TestCase* const					vktCase		= dynamic_cast<const TestCase*>(cases[caseNdx]);
+
+		if (existing != m_preparedPrograms.end())
+			prepared.insert(*existing);
+		else if (vktCase)
+		{
+			try
+			{
+				const de::SharedPtr<CasePrograms>	programs	(new CasePrograms(*vktCase, usedVulkanVersion));
+
+				programs->submit(*m_buildPool, m_context.getTestContext().getCommandLine(), m_programCache.get(), m_context.getTestContext().getLog().isShaderLoggingEnabled());
+				prepared[cases[caseNdx]] = programs;
+			}
+			catch (const std::exception&)
+			{
+				// Programs are initialized again in init(), which reports the error.
+			}
+		}
+	}
+
+	// Cases that are no longer listed may be destroyed after this call, so their
+	// programs are released (and background builds waited for) here.
+	m_preparedPrograms.swap(prepared);
 }
 
 void TestCaseExecutor::init (tcu::TestCase* testCase, const std::string& casePath)
@@ -231,80 +563,82 @@ void TestCaseExecutor::init (tcu::TestCase* testCase, const std::string& casePat
 	const TestCase*				vktCase						= dynamic_cast<TestCase*>(testCase);
 	tcu::TestLog&				log							= m_context.getTestContext().getLog();
 	const deUint32				usedVulkanVersion			= m_context.getUsedApiVersion();
-	const vk::SpirvVersion		baselineSpirvVersion		= vk::getBaselineSpirvVersion(usedVulkanVersion);
-	vk::ShaderBuildOptions		defaultGlslBuildOptions		(usedVulkanVersion, baselineSpirvVersion, 0u);
-	vk::ShaderBuildOptions		defaultHlslBuildOptions		(usedVulkanVersion, baselineSpirvVersion, 0u);
-	vk::SpirVAsmBuildOptions	defaultSpirvAsmBuildOptions	(usedVulkanVersion, baselineSpirvVersion);
-	vk::SourceCollections		sourceProgs					(usedVulkanVersion, defaultGlslBuildOptions, defaultHlslBuildOptions, defaultSpirvAsmBuildOptions);
 	const bool					doShaderLog					= log.isShaderLoggingEnabled();
 	const tcu::CommandLine&		commandLine					= m_context.getTestContext().getCommandLine();
+	de::SharedPtr<CasePrograms>	casePrograms;
+	size_t						progNdx						= 0;
 
 	DE_UNREF(casePath); // \todo [2015-03-13 pyry] Use this to identify ProgramCollection storage path
 
+	// Take programs prepared in background, if any, before anything can throw.
+	{
+		const CaseProgramMap::iterator	prepared	= m_preparedPrograms.find(testCase);
+
+		if (prepared != m_preparedPrograms.end())
+		{
+			casePrograms = prepared->second;
+			m_preparedPrograms.erase(prepared);
+		}
+	}
+
 	if (!vktCase)
 		TCU_THROW(InternalError, "Test node not an instance of vkt::TestCase");
 
 	vktCase->checkSupport(m_context);
 
 	m_progCollection.clear();
-	vktCase->initPrograms(sourceProgs);
 
-	for (vk::GlslSourceCollection::Iterator progIter = sourceProgs.glslSources.begin(); progIter != sourceProgs.glslSources.end(); ++progIter)
+	if (!casePrograms)
+	{
+		casePrograms = de::SharedPtr<CasePrograms>(new CasePrograms(*vktCase, usedVulkanVersion));
+
+		// Build, validate and disassemble programs of this case in parallel. Results are logged below in program order.
+		if (m_buildPool)
+			casePrograms->submit(*m_buildPool, commandLine, m_programCache.get(), doShaderLog);
+	}
+
+	casePrograms->wait();
+
+	const vk::SourceCollections&	sourceProgs	= casePrograms->getSources();
+
+	for (vk::GlslSourceCollection::Iterator progIter = sourceProgs.glslSources.begin(); progIter != sourceProgs.glslSources.end(); ++progIter, ++progNdx)
 	{
 		if (progIter.getProgram().buildOptions.targetVersion > vk::getMaxSpirvVersionForGlsl(m_context.getUsedApiVersion()))
 			TCU_THROW(NotSupportedError, "Shader requires SPIR-V higher than available");
 
-		const vk::ProgramBinary* const binProg = buildProgram<glu::ShaderProgramInfo, vk::GlslSourceCollection::Iterator>(casePath, progIter, m_prebuiltBinRegistry, log, &m_progCollection, commandLine);
+		const vk::ProgramBinary* const binProg = buildProgram<glu::ShaderProgramInfo, vk::GlslSourceCollection::Iterator>(casePath, progIter, m_prebuiltBinRegistry, log, &m_progCollection, commandLine, m_programCache.get(), casePrograms->getCacheStatistics(), casePrograms->getGlslBuild(progNdx));
 
 		if (doShaderLog)
-		{
-			try
-			{
-				std::ostringstream disasm;
-
-				vk::disassembleProgram(*binProg, &disasm);
-
-				log << vk::SpirVAsmSource(disasm.str());
-			}
-			catch (const tcu::NotSupportedError& err)
-			{
-				log << err;
-			}
-		}
+			logProgramDisassembly(log, *binProg, casePrograms->getGlslBuild(progNdx));
 	}
 
-	for (vk::HlslSourceCollection::Iterator progIter = sourceProgs.hlslSources.begin(); progIter != sourceProgs.hlslSources.end(); ++progIter)
+	progNdx = 0;
+
+	for (vk::HlslSourceCollection::Iterator progIter = sourceProgs.hlslSources.begin(); progIter != sourceProgs.hlslSources.end(); ++progIter, ++progNdx)
 	{
 		if (progIter.getProgram().buildOptions.targetVersion > vk::getMaxSpirvVersionForGlsl(m_context.getUsedApiVersion()))
 			TCU_THROW(NotSupportedError, "Shader requires SPIR-V higher than available");
 
-		const vk::ProgramBinary* const binProg = buildProgram<glu::ShaderProgramInfo, vk::HlslSourceCollection::Iterator>(casePath, progIter, m_prebuiltBinRegistry, log, &m_progCollection, commandLine);
+		const vk::ProgramBinary* const binProg = buildProgram<glu::ShaderProgramInfo, vk::HlslSourceCollection::Iterator>(casePath, progIter, m_prebuiltBinRegistry, log, &m_progCollection, commandLine, m_programCache.get(), casePrograms->getCacheStatistics(), casePrograms->getHlslBuild(progNdx));
 
 		if (doShaderLog)
-		{
-			try
-			{
-				std::ostringstream disasm;
-
-				vk::disassembleProgram(*binProg, &disasm);
-
-				log << vk::SpirVAsmSource(disasm.str());
-			}
-			catch (const tcu::NotSupportedError& err)
-			{
-				log << err;
-			}
-		}
+			logProgramDisassembly(log, *binProg, casePrograms->getHlslBuild(progNdx));
 	}
 
-	for (vk::SpirVAsmCollection::Iterator asmIterator = sourceProgs.spirvAsmSources.begin(); asmIterator != sourceProgs.spirvAsmSources.end(); ++asmIterator)
+	progNdx = 0;
+
+	for (vk::SpirVAsmCollection::Iterator asmIterator = sourceProgs.spirvAsmSources.begin(); asmIterator != sourceProgs.spirvAsmSources.end(); ++asmIterator, ++progNdx)
 	{
 		if (asmIterator.getProgram().buildOptions.targetVersion > vk::getMaxSpirvVersionForAsm(m_context.getUsedApiVersion()))
 			TCU_THROW(NotSupportedError, "Shader requires SPIR-V higher than available");
 
-		buildProgram<vk::SpirVProgramInfo, vk::SpirVAsmCollection::Iterator>(casePath, asmIterator, m_prebuiltBinRegistry, log, &m_progCollection, commandLine);
+		buildProgram<vk::SpirVProgramInfo, vk::SpirVAsmCollection::Iterator>(casePath, asmIterator, m_prebuiltBinRegistry, log, &m_progCollection, commandLine, m_programCache.get(), casePrograms->getCacheStatistics(), casePrograms->getSpirVAsmBuild(progNdx));
 	}
 
+	// Only programs of this case are counted, including those built in background. Reused programs are also marked in their build info.
+	if (m_programCache)
+		vk::ProgramBinaryCache::logStatistics(log, *casePrograms->getCacheStatistics());
+
 	DE_ASSERT(!m_instance);
 	m_instance = vktCase->createInstance(m_context);
 }
@@ -314,6 +648,13 @@ void TestCaseExecutor::deinit (tcu::TestCase*)
 	delete m_instance;
 	m_instance = DE_NULL;
 
+	// Don't let staging memory of one case affect allocations in later cases.
+	m_context.getReadbackQueue().release();
+
+	// Shared pipeline cache would otherwise grow for the whole session.
+	if (m_context.limitPipelineCacheSize(MAX_PIPELINE_CACHE_DATA_SIZE))
+		m_context.getTestContext().getLog() << TestLog::Message << "Pipeline cache data exceeded " << MAX_PIPELINE_CACHE_DATA_SIZE << " bytes, cache was reset" << TestLog::EndMessage;
+
 	// Collect and report any debug messages
 	if (m_debugReportRecorder)
 	{
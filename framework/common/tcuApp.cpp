@@ -26,8 +26,10 @@
 #include "tcuTestContext.hpp"
 #include "tcuTestSessionExecutor.hpp"
 #include "tcuTestHierarchyUtil.hpp"
+#include "tcuCaseIndex.hpp"
 #include "tcuCommandLine.hpp"
 #include "tcuTestLog.hpp"
+#include "tcuScopedTimer.hpp"
 
 #include "qpInfo.h"
 #include "qpDebugOut.h"
@@ -105,23 +107,42 @@ App::App (Platform& platform, Archive& archive, TestLog& log, const CommandLine&
 		if (cmdLine.isCrashHandlingEnabled())
 			TCU_CHECK_INTERNAL(m_crashHandler = qpCrashHandler_create(onCrash, this));
 
+		log.setImageBudget((size_t)de::max(0, cmdLine.getLogImageCaseBudget()) * 1024u,
+						   (size_t)de::max(0, cmdLine.getLogImageSessionBudget()) * 1024u);
+
+		setScopedTimingEnabled(cmdLine.isTimingLogEnabled());
+
 		// Create test context
 		m_testCtx = new TestContext(m_platform, archive, log, cmdLine, m_watchDog);
 
-		// Create root from registry
-		m_testRoot = new TestPackageRoot(*m_testCtx, TestPackageRegistry::getSingleton());
+		if (cmdLine.getCaseIndexFile() && (runMode == RUNMODE_DUMP_STDOUT_CASELIST || runMode == RUNMODE_DUMP_TEXT_CASELIST))
+		{
+			// Plain-text case lists can be produced from case index without creating test hierarchy at all
+			const CaseIndex						caseIndex		(cmdLine.getCaseIndexFile());
+			de::MovePtr<const CaseListFilter>	caseListFilter	(cmdLine.createCaseListFilter(archive));
 
-		// \note No executor is created if runmode is not EXECUTE
-		if (runMode == RUNMODE_EXECUTE)
-			m_testExecutor = new TestSessionExecutor(*m_testRoot, *m_testCtx);
-		else if (runMode == RUNMODE_DUMP_STDOUT_CASELIST)
-			writeCaselistsToStdout(*m_testRoot, *m_testCtx);
-		else if (runMode == RUNMODE_DUMP_XML_CASELIST)
-			writeXmlCaselistsToFiles(*m_testRoot, *m_testCtx, cmdLine);
-		else if (runMode == RUNMODE_DUMP_TEXT_CASELIST)
-			writeTxtCaselistsToFiles(*m_testRoot, *m_testCtx, cmdLine);
+			writeCaselistsFromIndex(caseIndex, *caseListFilter, cmdLine);
+		}
 		else
-			DE_ASSERT(false);
+		{
+			// Create root from registry
+			// \note With case index, case list filter only lets hierarchy iteration enter groups with selected cases
+			m_testRoot = new TestPackageRoot(*m_testCtx, TestPackageRegistry::getSingleton());
+
+			// \note No executor is created if runmode is not EXECUTE
+			if (runMode == RUNMODE_EXECUTE)
+				m_testExecutor = new TestSessionExecutor(*m_testRoot, *m_testCtx);
+			else if (runMode == RUNMODE_DUMP_STDOUT_CASELIST)
+				writeCaselistsToStdout(*m_testRoot, *m_testCtx);
+			else if (runMode == RUNMODE_DUMP_XML_CASELIST)
+				writeXmlCaselistsToFiles(*m_testRoot, *m_testCtx, cmdLine);
+			else if (runMode == RUNMODE_DUMP_TEXT_CASELIST)
+				writeTxtCaselistsToFiles(*m_testRoot, *m_testCtx, cmdLine);
+			else if (runMode == RUNMODE_DUMP_CASE_INDEX)
+				writeCaseIndexesToFiles(*m_testRoot, *m_testCtx, cmdLine);
+			else
+				DE_ASSERT(false);
+		}
 	}
 	catch (const std::exception& e)
 	{
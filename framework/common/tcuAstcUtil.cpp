@@ -25,6 +25,7 @@
 #include "deFloat16.h"
 #include "deRandom.hpp"
 #include "deMeta.hpp"
+#include "deSingleton.h"
 
 #include <algorithm>
 
@@ -453,6 +454,23 @@ ASTCBlockMode getASTCBlockMode (deUint32 blockModeData)
 	return blockMode;
 }
 
+// Block mode is decoded from 11 bits; all modes are decoded once and shared between threads.
+static volatile deSingletonState	s_blockModeTableState	= DE_SINGLETON_STATE_NOT_INITIALIZED;
+static ASTCBlockMode				s_blockModeTable[1<<11];
+
+static void initBlockModeTable (void*)
+{
+	for (deUint32 blockModeData = 0; blockModeData < DE_LENGTH_OF_ARRAY(s_blockModeTable); blockModeData++)
+		s_blockModeTable[blockModeData] = getASTCBlockMode(blockModeData);
+}
+
+inline const ASTCBlockMode& getCachedASTCBlockMode (deUint32 blockModeData)
+{
+	DE_ASSERT(blockModeData < DE_LENGTH_OF_ARRAY(s_blockModeTable));
+	deInitSingleton(&s_blockModeTableState, initBlockModeTable, DE_NULL);
+	return s_blockModeTable[blockModeData];
+}
+
 inline void setASTCErrorColorBlock (void* dst, int blockWidth, int blockHeight, bool isSRGB)
 {
 	if (isSRGB)
@@ -1267,20 +1285,27 @@ void unquantizeWeights (deUint32 dst[64], const ISEDecodedResult* weightGrid, co
 
 }
 
-void interpolateWeights (TexelWeightPair* dst, const deUint32 (&unquantizedWeights) [64], int blockWidth, int blockHeight, const ASTCBlockMode& blockMode)
+// Weight grid infill of a single texel, see interpolateWeights().
+struct WeightInfillTexel
 {
-	const int		numWeightsPerTexel	= blockMode.isDualPlane ? 2 : 1;
-	const deUint32	scaleX				= (1024 + blockWidth/2) / (blockWidth-1);
-	const deUint32	scaleY				= (1024 + blockHeight/2) / (blockHeight-1);
+	deUint8		i00;	//!< Index of top-left contributing grid point
+	deUint8		w00;
+	deUint8		w01;
+	deUint8		w10;
+	deUint8		w11;
+};
 
-	DE_ASSERT(blockMode.weightGridWidth*blockMode.weightGridHeight*numWeightsPerTexel <= DE_LENGTH_OF_ARRAY(unquantizedWeights));
+void computeWeightInfill (WeightInfillTexel* dst, int blockWidth, int blockHeight, int weightGridWidth, int weightGridHeight)
+{
+	const deUint32	scaleX	= (1024 + blockWidth/2) / (blockWidth-1);
+	const deUint32	scaleY	= (1024 + blockHeight/2) / (blockHeight-1);
 
 	for (int texelY = 0; texelY < blockHeight; texelY++)
 	{
 		for (int texelX = 0; texelX < blockWidth; texelX++)
 		{
-			const deUint32 gX	= (scaleX*texelX*(blockMode.weightGridWidth-1) + 32) >> 6;
-			const deUint32 gY	= (scaleY*texelY*(blockMode.weightGridHeight-1) + 32) >> 6;
+			const deUint32 gX	= (scaleX*texelX*(weightGridWidth-1) + 32) >> 6;
+			const deUint32 gY	= (scaleY*texelY*(weightGridHeight-1) + 32) >> 6;
 			const deUint32 jX	= gX >> 4;
 			const deUint32 jY	= gY >> 4;
 			const deUint32 fX	= gX & 0xf;
@@ -1291,32 +1316,54 @@ void interpolateWeights (TexelWeightPair* dst, const deUint32 (&unquantizedWeigh
 			const deUint32 w01	= fX - w11;
 			const deUint32 w00	= 16 - fX - fY + w11;
 
-			const deUint32 i00	= jY*blockMode.weightGridWidth + jX;
-			const deUint32 i01	= i00 + 1;
-			const deUint32 i10	= i00 + blockMode.weightGridWidth;
-			const deUint32 i11	= i00 + blockMode.weightGridWidth + 1;
+			const deUint32 i00	= jY*weightGridWidth + jX;
 
-			// These addresses can be out of bounds, but respective weights will be 0 then.
-			DE_ASSERT(deInBounds32(i00, 0, blockMode.weightGridWidth*blockMode.weightGridHeight) || w00 == 0);
-			DE_ASSERT(deInBounds32(i01, 0, blockMode.weightGridWidth*blockMode.weightGridHeight) || w01 == 0);
-			DE_ASSERT(deInBounds32(i10, 0, blockMode.weightGridWidth*blockMode.weightGridHeight) || w10 == 0);
-			DE_ASSERT(deInBounds32(i11, 0, blockMode.weightGridWidth*blockMode.weightGridHeight) || w11 == 0);
+			// Neighbor addresses can be out of bounds, but respective weights will be 0 then.
+			DE_ASSERT(deInBounds32(i00, 0, weightGridWidth*weightGridHeight) || w00 == 0);
+			DE_ASSERT(deInBounds32(i00 + 1, 0, weightGridWidth*weightGridHeight) || w01 == 0);
+			DE_ASSERT(deInBounds32(i00 + weightGridWidth, 0, weightGridWidth*weightGridHeight) || w10 == 0);
+			DE_ASSERT(deInBounds32(i00 + weightGridWidth + 1, 0, weightGridWidth*weightGridHeight) || w11 == 0);
 
-			for (int texelWeightNdx = 0; texelWeightNdx < numWeightsPerTexel; texelWeightNdx++)
-			{
-				// & 0x3f clamps address to bounds of unquantizedWeights
-				const deUint32 p00	= unquantizedWeights[(i00 * numWeightsPerTexel + texelWeightNdx) & 0x3f];
-				const deUint32 p01	= unquantizedWeights[(i01 * numWeightsPerTexel + texelWeightNdx) & 0x3f];
-				const deUint32 p10	= unquantizedWeights[(i10 * numWeightsPerTexel + texelWeightNdx) & 0x3f];
-				const deUint32 p11	= unquantizedWeights[(i11 * numWeightsPerTexel + texelWeightNdx) & 0x3f];
+			WeightInfillTexel& texel = dst[texelY*blockWidth + texelX];
 
-				dst[texelY*blockWidth + texelX].w[texelWeightNdx] = (p00*w00 + p01*w01 + p10*w10 + p11*w11 + 8) >> 4;
-			}
+			texel.i00	= (deUint8)i00;
+			texel.w00	= (deUint8)w00;
+			texel.w01	= (deUint8)w01;
+			texel.w10	= (deUint8)w10;
+			texel.w11	= (deUint8)w11;
 		}
 	}
 }
 
-void computeTexelWeights (TexelWeightPair* dst, const Block128& blockData, int blockWidth, int blockHeight, const ASTCBlockMode& blockMode)
+void interpolateWeights (TexelWeightPair* dst, const deUint32 (&unquantizedWeights) [64], int numTexels, const WeightInfillTexel* infill, const ASTCBlockMode& blockMode)
+{
+	const deUint32	numWeightsPerTexel	= blockMode.isDualPlane ? 2 : 1;
+	const deUint32	gridWidth			= (deUint32)blockMode.weightGridWidth;
+
+	DE_ASSERT(blockMode.weightGridWidth*blockMode.weightGridHeight*numWeightsPerTexel <= DE_LENGTH_OF_ARRAY(unquantizedWeights));
+
+	for (int texelNdx = 0; texelNdx < numTexels; texelNdx++)
+	{
+		const WeightInfillTexel&	texel	= infill[texelNdx];
+		const deUint32				i00		= texel.i00;
+		const deUint32				i01		= i00 + 1;
+		const deUint32				i10		= i00 + gridWidth;
+		const deUint32				i11		= i00 + gridWidth + 1;
+
+		for (deUint32 texelWeightNdx = 0; texelWeightNdx < numWeightsPerTexel; texelWeightNdx++)
+		{
+			// & 0x3f clamps address to bounds of unquantizedWeights
+			const deUint32 p00	= unquantizedWeights[(i00 * numWeightsPerTexel + texelWeightNdx) & 0x3f];
+			const deUint32 p01	= unquantizedWeights[(i01 * numWeightsPerTexel + texelWeightNdx) & 0x3f];
+			const deUint32 p10	= unquantizedWeights[(i10 * numWeightsPerTexel + texelWeightNdx) & 0x3f];
+			const deUint32 p11	= unquantizedWeights[(i11 * numWeightsPerTexel + texelWeightNdx) & 0x3f];
+
+			dst[texelNdx].w[texelWeightNdx] = (p00*texel.w00 + p01*texel.w01 + p10*texel.w10 + p11*texel.w11 + 8) >> 4;
+		}
+	}
+}
+
+void computeTexelWeights (TexelWeightPair* dst, const Block128& blockData, int numTexels, const WeightInfillTexel* infill, const ASTCBlockMode& blockMode)
 {
 	ISEDecodedResult weightGrid[64];
 
@@ -1328,7 +1375,7 @@ void computeTexelWeights (TexelWeightPair* dst, const Block128& blockData, int b
 	{
 		deUint32 unquantizedWeights[64];
 		unquantizeWeights(&unquantizedWeights[0], &weightGrid[0], blockMode);
-		interpolateWeights(dst, unquantizedWeights, blockWidth, blockHeight, blockMode);
+		interpolateWeights(dst, unquantizedWeights, numTexels, infill, blockMode);
 	}
 }
 
@@ -1405,21 +1452,114 @@ int computeTexelPartition (deUint32 seedIn, deUint32 xIn, deUint32 yIn, deUint32
 		 :								  3;
 }
 
-DecompressResult setTexelColors (void* dst, ColorEndpointPair* colorEndpoints, TexelWeightPair* texelWeights, int ccs, deUint32 partitionIndexSeed,
-								 int numPartitions, int blockWidth, int blockHeight, bool isSRGB, bool isLDRMode, const deUint32* colorEndpointModes)
+// Partition and weight infill tables of one block footprint. Tables are built on first use and shared between threads.
+class BlockFootprintTables
+{
+public:
+	BlockFootprintTables (int blockWidth, int blockHeight)
+		: m_blockWidth		(blockWidth)
+		, m_blockHeight		(blockHeight)
+		, m_numTexels		(blockWidth*blockHeight)
+		, m_partitions		((size_t)NUM_PARTITION_COUNTS*NUM_PARTITION_SEEDS*m_numTexels)
+		, m_weightInfill	((size_t)(blockWidth-1)*(blockHeight-1)*m_numTexels)
+	{
+		const bool smallBlock = m_numTexels < 31;
+
+		for (int numPartitions = 2; numPartitions <= 4; numPartitions++)
+		for (deUint32 seed = 0; seed < NUM_PARTITION_SEEDS; seed++)
+		{
+			deUint8* const dst = &m_partitions[getPartitionTableOffset(seed, numPartitions)];
+
+			for (int texelY = 0; texelY < blockHeight; texelY++)
+			for (int texelX = 0; texelX < blockWidth; texelX++)
+				dst[texelY*blockWidth + texelX] = (deUint8)computeTexelPartition(seed, texelX, texelY, 0, numPartitions, smallBlock);
+		}
+
+		for (int gridHeight = 2; gridHeight <= blockHeight; gridHeight++)
+		for (int gridWidth = 2; gridWidth <= blockWidth; gridWidth++)
+			computeWeightInfill(&m_weightInfill[getWeightInfillOffset(gridWidth, gridHeight)], blockWidth, blockHeight, gridWidth, gridHeight);
+	}
+
+	int							getNumTexels		(void) const { return m_numTexels; }
+
+	//! Partition index of each texel for given partition seed (block bits 13..22)
+	const deUint8*				getPartitions		(deUint32 seed, int numPartitions) const { return &m_partitions[getPartitionTableOffset(seed, numPartitions)];	}
+
+	//! Weight infill of each texel for given weight grid size. Grid must not be larger than block.
+	const WeightInfillTexel*	getWeightInfill		(int gridWidth, int gridHeight) const { return &m_weightInfill[getWeightInfillOffset(gridWidth, gridHeight)];	}
+
+private:
+	enum
+	{
+		NUM_PARTITION_SEEDS		= 1<<10,
+		NUM_PARTITION_COUNTS	= 3		//!< 2, 3 or 4 partitions
+	};
+
+	size_t getPartitionTableOffset (deUint32 seed, int numPartitions) const
+	{
+		DE_ASSERT(seed < NUM_PARTITION_SEEDS && de::inRange(numPartitions, 2, 4));
+		return ((size_t)(numPartitions-2)*NUM_PARTITION_SEEDS + seed) * (size_t)m_numTexels;
+	}
+
+	size_t getWeightInfillOffset (int gridWidth, int gridHeight) const
+	{
+		DE_ASSERT(de::inRange(gridWidth, 2, m_blockWidth) && de::inRange(gridHeight, 2, m_blockHeight));
+		return ((size_t)(gridHeight-2)*(m_blockWidth-1) + (size_t)(gridWidth-2)) * (size_t)m_numTexels;
+	}
+
+	const int							m_blockWidth;
+	const int							m_blockHeight;
+	const int							m_numTexels;
+	std::vector<deUint8>				m_partitions;
+	std::vector<WeightInfillTexel>		m_weightInfill;
+};
+
+static volatile deSingletonState		s_footprintTableState	[MAX_BLOCK_WIDTH+1][MAX_BLOCK_HEIGHT+1];
+static const BlockFootprintTables*		s_footprintTables		[MAX_BLOCK_WIDTH+1][MAX_BLOCK_HEIGHT+1];
+
+static void initFootprintTables (void* arg)
+{
+	const IVec2& footprint = *(const IVec2*)arg;
+
+	// \note Tables are never destroyed: there are at most 14 footprints and they are needed until the process exits.
+	s_footprintTables[footprint.x()][footprint.y()] = new BlockFootprintTables(footprint.x(), footprint.y());
+}
+
+const BlockFootprintTables& getFootprintTables (int blockWidth, int blockHeight)
+{
+	const IVec2 footprint (blockWidth, blockHeight);
+
+	DE_ASSERT(de::inRange(blockWidth, 4, (int)MAX_BLOCK_WIDTH) && de::inRange(blockHeight, 4, (int)MAX_BLOCK_HEIGHT));
+	deInitSingleton(&s_footprintTableState[blockWidth][blockHeight], initFootprintTables, (void*)&footprint);
+
+	return *s_footprintTables[blockWidth][blockHeight];
+}
+
+DecompressResult setTexelColors (void* dst, ColorEndpointPair* colorEndpoints, TexelWeightPair* texelWeights, int ccs, const deUint8* texelPartitions,
+								 int numPartitions, int numTexels, bool isSRGB, bool isLDRMode, const deUint32* colorEndpointModes)
 {
-	const bool			smallBlock	= blockWidth*blockHeight < 31;
 	DecompressResult	result		= DECOMPRESS_RESULT_VALID_BLOCK;
 	bool				isHDREndpoint[4];
+	deUint32			ldrC0[4][4];	//!< Expanded LDR endpoint values, per partition and channel
+	deUint32			ldrC1[4][4];
 
 	for (int i = 0; i < numPartitions; i++)
+	{
 		isHDREndpoint[i] = isColorEndpointModeHDR(colorEndpointModes[i]);
 
-	for (int texelY = 0; texelY < blockHeight; texelY++)
-	for (int texelX = 0; texelX < blockWidth; texelX++)
+		for (int channelNdx = 0; channelNdx < 4; channelNdx++)
+		{
+			const deUint32 e0 = colorEndpoints[i].e0[channelNdx];
+			const deUint32 e1 = colorEndpoints[i].e1[channelNdx];
+
+			ldrC0[i][channelNdx] = (e0 << 8) | (isSRGB ? 0x80 : e0);
+			ldrC1[i][channelNdx] = (e1 << 8) | (isSRGB ? 0x80 : e1);
+		}
+	}
+
+	for (int texelNdx = 0; texelNdx < numTexels; texelNdx++)
 	{
-		const int				texelNdx			= texelY*blockWidth + texelX;
-		const int				colorEndpointNdx	= numPartitions == 1 ? 0 : computeTexelPartition(partitionIndexSeed, texelX, texelY, 0, numPartitions, smallBlock);
+		const int				colorEndpointNdx	= numPartitions == 1 ? 0 : (int)texelPartitions[texelNdx];
 		DE_ASSERT(colorEndpointNdx < numPartitions);
 		const UVec4&			e0					= colorEndpoints[colorEndpointNdx].e0;
 		const UVec4&			e1					= colorEndpoints[colorEndpointNdx].e1;
@@ -1444,14 +1584,38 @@ DecompressResult setTexelColors (void* dst, ColorEndpointPair* colorEndpoints, T
 
 			result = DECOMPRESS_RESULT_ERROR;
 		}
+		else if (!isHDREndpoint[colorEndpointNdx])
+		{
+			// All channels are interpolated the same way; written as separate loops over channels to allow vectorization.
+			const deUint32* const	c0	= ldrC0[colorEndpointNdx];
+			const deUint32* const	c1	= ldrC1[colorEndpointNdx];
+			deUint32				c[4];
+
+			for (int channelNdx = 0; channelNdx < 4; channelNdx++)
+			{
+				const deUint32 w = weight.w[ccs == channelNdx ? 1 : 0];
+				c[channelNdx] = (c0[channelNdx]*(64-w) + c1[channelNdx]*w + 32) / 64;
+			}
+
+			if (isSRGB)
+			{
+				for (int channelNdx = 0; channelNdx < 4; channelNdx++)
+					((deUint8*)dst)[texelNdx*4 + channelNdx] = (deUint8)((c[channelNdx] & 0xff00) >> 8);
+			}
+			else
+			{
+				for (int channelNdx = 0; channelNdx < 4; channelNdx++)
+					((float*)dst)[texelNdx*4 + channelNdx] = c[channelNdx] == 65535 ? 1.0f : (float)c[channelNdx] / 65536.0f;
+			}
+		}
 		else
 		{
 			for (int channelNdx = 0; channelNdx < 4; channelNdx++)
 			{
-				if (!isHDREndpoint[colorEndpointNdx] || (channelNdx == 3 && colorEndpointModes[colorEndpointNdx] == 14)) // \note Alpha for mode 14 is treated the same as LDR.
+				if (channelNdx == 3 && colorEndpointModes[colorEndpointNdx] == 14) // \note Alpha for mode 14 is treated the same as LDR.
 				{
-					const deUint32 c0	= (e0[channelNdx] << 8) | (isSRGB ? 0x80 : e0[channelNdx]);
-					const deUint32 c1	= (e1[channelNdx] << 8) | (isSRGB ? 0x80 : e1[channelNdx]);
+					const deUint32 c0	= ldrC0[colorEndpointNdx][channelNdx];
+					const deUint32 c1	= ldrC1[colorEndpointNdx][channelNdx];
 					const deUint32 w	= weight.w[ccs == channelNdx ? 1 : 0];
 					const deUint32 c	= (c0*(64-w) + c1*w + 32) / 64;
 
@@ -1489,7 +1653,7 @@ DecompressResult decompressBlock (void* dst, const Block128& blockData, int bloc
 
 	// Decode block mode.
 
-	const ASTCBlockMode blockMode = getASTCBlockMode(blockData.getBits(0, 10));
+	const ASTCBlockMode& blockMode = getCachedASTCBlockMode(blockData.getBits(0, 10));
 
 	// Check for block mode errors.
 
@@ -1557,15 +1721,18 @@ DecompressResult decompressBlock (void* dst, const Block128& blockData, int bloc
 
 	// Compute texel weights.
 
+	const BlockFootprintTables&	footprintTables	= getFootprintTables(blockWidth, blockHeight);
+	const int					numTexels		= footprintTables.getNumTexels();
+
 	TexelWeightPair texelWeights[MAX_BLOCK_WIDTH*MAX_BLOCK_HEIGHT];
-	computeTexelWeights(&texelWeights[0], blockData, blockWidth, blockHeight, blockMode);
+	computeTexelWeights(&texelWeights[0], blockData, numTexels, footprintTables.getWeightInfill(blockMode.weightGridWidth, blockMode.weightGridHeight), blockMode);
 
 	// Set texel colors.
 
 	const int		ccs						= blockMode.isDualPlane ? (int)blockData.getBits(extraCemBitsStart-2, extraCemBitsStart-1) : -1;
-	const deUint32	partitionIndexSeed		= numPartitions > 1 ? blockData.getBits(13, 22) : (deUint32)-1;
+	const deUint8*	texelPartitions			= numPartitions > 1 ? footprintTables.getPartitions(blockData.getBits(13, 22), numPartitions) : DE_NULL;
 
-	return setTexelColors(dst, &colorEndpoints[0], &texelWeights[0], ccs, partitionIndexSeed, numPartitions, blockWidth, blockHeight, isSRGB, isLDR, &colorEndpointModes[0]);
+	return setTexelColors(dst, &colorEndpoints[0], &texelWeights[0], ccs, texelPartitions, numPartitions, numTexels, isSRGB, isLDR, &colorEndpointModes[0]);
 }
 
 void decompress (const PixelBufferAccess& dst, const deUint8* data, bool isSRGB, bool isLDR)
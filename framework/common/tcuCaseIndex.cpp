@@ -0,0 +1,572 @@
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Tester Core
+ * ----------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Precompiled test case index.
+ *//*--------------------------------------------------------------------*/
+
+#include "tcuCaseIndex.hpp"
+#include "tcuCommandLine.hpp"
+#include "tcuTestHierarchyIterator.hpp"
+#include "tcuTestPackage.hpp"
+#include "tcuStringTemplate.hpp"
+#include "deFilePath.hpp"
+#include "deStringUtil.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+namespace tcu
+{
+
+using std::string;
+using std::vector;
+
+enum
+{
+	HEADER_SIZE		= 4 + 4 + 4 + 4 + 4,
+	NODE_SIZE		= 4 + 4 + 4 + 1 + 3 + 8 + 4 + 4,
+	TAG_REF_SIZE	= 4
+};
+
+static const char s_magic[4] = { 'd', 'Q', 'C', 'I' };
+
+// Utilities
+
+static void writeU32 (vector<deUint8>& dst, deUint32 value)
+{
+	for (int ndx = 0; ndx < 4; ndx++)
+		dst.push_back((deUint8)(value >> (8*ndx)));
+}
+
+static void writeU64 (vector<deUint8>& dst, deUint64 value)
+{
+	for (int ndx = 0; ndx < 8; ndx++)
+		dst.push_back((deUint8)(value >> (8*ndx)));
+}
+
+static deUint32 readU32 (const deUint8* src)
+{
+	return (deUint32)src[0] | ((deUint32)src[1] << 8) | ((deUint32)src[2] << 16) | ((deUint32)src[3] << 24);
+}
+
+static deUint64 readU64 (const deUint8* src)
+{
+	return (deUint64)readU32(src) | ((deUint64)readU32(src + 4) << 32);
+}
+
+static string makePackageFilename (const string& pattern, const string& packageName, const string& typeExtension)
+{
+	std::map<string, string> args;
+	args["packageName"]		= packageName;
+	args["typeExtension"]	= typeExtension;
+	return StringTemplate(pattern).specialize(args);
+}
+
+static string joinPath (const string& parent, const char* name)
+{
+	return parent.empty() ? string(name) : parent + "." + name;
+}
+
+// CaseIndexEntry
+
+bool CaseIndexEntry::hasTag (const string& tag) const
+{
+	return std::find(tags.begin(), tags.end(), tag) != tags.end();
+}
+
+bool CaseIndexEntry::matchesTags (const vector<string>& tagFilter) const
+{
+	for (vector<string>::const_iterator tagIter = tagFilter.begin(); tagIter != tagFilter.end(); ++tagIter)
+	{
+		const bool	exclude	= !tagIter->empty() && (*tagIter)[0] == '!';
+		const bool	found	= hasTag(exclude ? tagIter->substr(1) : *tagIter);
+
+		if (found == exclude)
+			return false;
+	}
+
+	return true;
+}
+
+// CaseIndex
+
+CaseIndex::CaseIndex (const string& filename)
+	: m_numCases(0)
+{
+	std::ifstream	in		(filename.c_str(), std::ios_base::binary);
+	vector<deUint8>	data;
+
+	if (!in.is_open() || !in.good())
+		throw Exception("Failed to open " + filename);
+
+	in.seekg(0, std::ios_base::end);
+	data.resize((size_t)in.tellg());
+	in.seekg(0, std::ios_base::beg);
+
+	if (!data.empty())
+		in.read((char*)&data[0], (std::streamsize)data.size());
+
+	if (!in.good())
+		throw Exception("Failed to read " + filename);
+
+	parse(data);
+}
+
+CaseIndex::CaseIndex (const vector<deUint8>& data)
+	: m_numCases(0)
+{
+	parse(data);
+}
+
+CaseIndex::~CaseIndex (void)
+{
+}
+
+void CaseIndex::parse (const vector<deUint8>& data)
+{
+	if (data.size() < HEADER_SIZE || !std::equal(DE_ARRAY_BEGIN(s_magic), DE_ARRAY_END(s_magic), data.begin()))
+		throw Exception("Not a test case index");
+
+	{
+		const deUint32	version			= readU32(&data[4]);
+		const deUint32	numNodes		= readU32(&data[8]);
+		const deUint32	numTagRefs		= readU32(&data[12]);
+		const deUint32	stringTableSize	= readU32(&data[16]);
+		const size_t	tagRefsOffset	= HEADER_SIZE + (size_t)numNodes*NODE_SIZE;
+		const size_t	stringsOffset	= tagRefsOffset + (size_t)numTagRefs*TAG_REF_SIZE;
+
+		if (version != FORMAT_VERSION)
+			throw Exception("Unsupported test case index version " + de::toString(version));
+
+		if (numNodes == 0 || stringTableSize == 0 ||
+			(deUint64)data.size() != (deUint64)HEADER_SIZE + (deUint64)numNodes*NODE_SIZE + (deUint64)numTagRefs*TAG_REF_SIZE + stringTableSize)
+			throw Exception("Test case index is truncated or corrupted");
+
+		m_nodes.resize(numNodes);
+		m_tagOffsets.resize(numTagRefs);
+		m_strings.assign((const char*)&data[stringsOffset], (const char*)&data[0] + data.size());
+
+		if (m_strings.back() != 0)
+			throw Exception("Test case index string table is not terminated");
+
+		for (deUint32 tagNdx = 0; tagNdx < numTagRefs; tagNdx++)
+		{
+			m_tagOffsets[tagNdx] = readU32(&data[tagRefsOffset + tagNdx*TAG_REF_SIZE]);
+
+			if (m_tagOffsets[tagNdx] >= stringTableSize)
+				throw Exception("Test case index is corrupted");
+		}
+
+		for (deUint32 nodeNdx = 0; nodeNdx < numNodes; nodeNdx++)
+		{
+			const deUint8* const	src		= &data[HEADER_SIZE + nodeNdx*NODE_SIZE];
+			Node&					node	= m_nodes[nodeNdx];
+
+			node.nameOffset		= readU32(src + 0);
+			node.firstChild		= readU32(src + 4);
+			node.numChildren	= readU32(src + 8);
+			node.nodeType		= (TestNodeType)src[12];
+			node.durationUs		= readU64(src + 16);
+			node.firstTag		= readU32(src + 24);
+			node.numTags		= readU32(src + 28);
+
+			// Children are always stored after the parent, which also rules out cycles.
+			if (node.nameOffset >= stringTableSize ||
+				(node.numChildren > 0 && (node.firstChild <= nodeNdx || (deUint64)node.firstChild + node.numChildren > numNodes)) ||
+				(deUint64)node.firstTag + node.numTags > numTagRefs)
+				throw Exception("Test case index is corrupted");
+
+			if (isTestNodeTypeExecutable(node.nodeType))
+				m_numCases += 1;
+		}
+
+		if (m_nodes[0].nodeType != NODETYPE_PACKAGE)
+			throw Exception("Test case index doesn't start with a package node");
+	}
+}
+
+const char* CaseIndex::getPackageName (void) const
+{
+	return getName(m_nodes[0]);
+}
+
+CaseIndexEntry CaseIndex::makeEntry (const Node& node, const string& path) const
+{
+	CaseIndexEntry entry (path, node.nodeType, node.durationUs);
+
+	for (deUint32 tagNdx = node.firstTag; tagNdx < node.firstTag + node.numTags; tagNdx++)
+		entry.tags.push_back(&m_strings[m_tagOffsets[tagNdx]]);
+
+	return entry;
+}
+
+void CaseIndex::collectNodes (const CaseListFilter* filter, deUint32 nodeNdx, const string& path, bool includeGroups, vector<CaseIndexEntry>& dst) const
+{
+	const Node& node = m_nodes[nodeNdx];
+
+	if (isTestNodeTypeExecutable(node.nodeType))
+	{
+		if (!filter || filter->checkTestCaseName(path.c_str()))
+			dst.push_back(makeEntry(node, path));
+	}
+	else
+	{
+		// Same pruning rule as TestHierarchyIterator: non-matching groups are never entered.
+		if (filter && !filter->checkTestGroupName(path.c_str()))
+			return;
+
+		if (includeGroups && node.nodeType != NODETYPE_PACKAGE)
+			dst.push_back(makeEntry(node, path));
+
+		for (deUint32 childNdx = node.firstChild; childNdx < node.firstChild + node.numChildren; childNdx++)
+			collectNodes(filter, childNdx, joinPath(path, getName(m_nodes[childNdx])), includeGroups, dst);
+	}
+}
+
+void CaseIndex::getMatchingCases (const CaseListFilter& filter, vector<CaseIndexEntry>& dst) const
+{
+	collectNodes(&filter, 0, getPackageName(), false, dst);
+}
+
+void CaseIndex::getMatchingNodes (const CaseListFilter& filter, vector<CaseIndexEntry>& dst) const
+{
+	collectNodes(&filter, 0, getPackageName(), true, dst);
+}
+
+void CaseIndex::getAllCases (vector<CaseIndexEntry>& dst) const
+{
+	collectNodes(DE_NULL, 0, getPackageName(), false, dst);
+}
+
+bool CaseIndex::findCase (const string& path, CaseIndexEntry* dst) const
+{
+	deUint32	nodeNdx		= 0;
+	size_t		compStart	= 0;
+
+	for (;;)
+	{
+		const size_t	compEnd		= path.find('.', compStart);
+		const string	compName	= path.substr(compStart, compEnd == string::npos ? string::npos : compEnd - compStart);
+
+		if (compStart == 0)
+		{
+			if (compName != getPackageName())
+				return false;
+		}
+		else
+		{
+			const Node&	parent		= m_nodes[nodeNdx];
+			bool		found		= false;
+
+			for (deUint32 childNdx = parent.firstChild; childNdx < parent.firstChild + parent.numChildren; childNdx++)
+			{
+				if (compName == getName(m_nodes[childNdx]))
+				{
+					nodeNdx	= childNdx;
+					found	= true;
+					break;
+				}
+			}
+
+			if (!found)
+				return false;
+		}
+
+		if (compEnd == string::npos)
+			break;
+
+		compStart = compEnd + 1;
+	}
+
+	if (!isTestNodeTypeExecutable(m_nodes[nodeNdx].nodeType))
+		return false;
+
+	if (dst)
+		*dst = makeEntry(m_nodes[nodeNdx], path);
+
+	return true;
+}
+
+// CaseIndexBuilder
+
+CaseIndexBuilder::CaseIndexBuilder (void)
+{
+}
+
+CaseIndexBuilder::~CaseIndexBuilder (void)
+{
+}
+
+void CaseIndexBuilder::enterNode (const char* name, TestNodeType nodeType)
+{
+	const int nodeNdx = (int)m_nodes.size();
+
+	DE_ASSERT(m_nodeStack.empty() == (nodeType == NODETYPE_PACKAGE));
+	DE_ASSERT(m_nodes.empty() || !m_nodeStack.empty());
+
+	m_nodes.push_back(BuildNode());
+	m_nodes.back().name			= name;
+	m_nodes.back().nodeType		= nodeType;
+	m_nodes.back().durationUs	= 0;
+
+	if (!m_nodeStack.empty())
+		m_nodes[m_nodeStack.back()].children.push_back(nodeNdx);
+
+	m_nodeStack.push_back(nodeNdx);
+}
+
+void CaseIndexBuilder::leaveNode (void)
+{
+	DE_ASSERT(!m_nodeStack.empty());
+	m_nodeStack.pop_back();
+}
+
+void CaseIndexBuilder::addTag (const char* tag)
+{
+	DE_ASSERT(!m_nodeStack.empty() && tag[0] != 0);
+
+	vector<string>& tags = m_nodes[m_nodeStack.back()].tags;
+
+	if (std::find(tags.begin(), tags.end(), string(tag)) == tags.end())
+		tags.push_back(tag);
+}
+
+void CaseIndexBuilder::collectPaths (int nodeNdx, const string& path, std::map<string, int>& dst) const
+{
+	const BuildNode& node = m_nodes[nodeNdx];
+
+	if (isTestNodeTypeExecutable(node.nodeType))
+		dst[path] = nodeNdx;
+
+	for (vector<int>::const_iterator childIter = node.children.begin(); childIter != node.children.end(); ++childIter)
+		collectPaths(*childIter, joinPath(path, m_nodes[*childIter].name.c_str()), dst);
+}
+
+void CaseIndexBuilder::setRecordedData (const CaseIndex& previous)
+{
+	std::map<string, int>	pathToNode;
+	vector<CaseIndexEntry>	previousCases;
+
+	DE_ASSERT(!m_nodes.empty());
+
+	collectPaths(0, m_nodes[0].name, pathToNode);
+	previous.getAllCases(previousCases);
+
+	for (vector<CaseIndexEntry>::const_iterator caseIter = previousCases.begin(); caseIter != previousCases.end(); ++caseIter)
+	{
+		const std::map<string, int>::const_iterator node = pathToNode.find(caseIter->path);
+
+		if (node != pathToNode.end())
+		{
+			m_nodes[node->second].durationUs	= caseIter->durationUs;
+			m_nodes[node->second].tags			= caseIter->tags;
+		}
+	}
+}
+
+void CaseIndexBuilder::serialize (vector<deUint8>& dst) const
+{
+	vector<int>					order;		//!< Build node indices in breadth-first order
+	vector<deUint32>			firstChild	(m_nodes.size(), 0);
+	vector<deUint8>				strings;
+	vector<deUint32>			nameOffset	(m_nodes.size(), 0);
+	vector<deUint32>			firstTag	(m_nodes.size(), 0);
+	vector<deUint32>			tagRefs;
+	std::map<string, deUint32>	tagOffsets;	//!< Each tag name is stored once
+
+	DE_ASSERT(!m_nodes.empty() && m_nodeStack.empty());
+
+	order.push_back(0);
+
+	for (size_t orderNdx = 0; orderNdx < order.size(); orderNdx++)
+	{
+		const BuildNode& node = m_nodes[order[orderNdx]];
+
+		firstChild[order[orderNdx]] = (deUint32)order.size();
+		order.insert(order.end(), node.children.begin(), node.children.end());
+	}
+
+	for (size_t orderNdx = 0; orderNdx < order.size(); orderNdx++)
+	{
+		const string& name = m_nodes[order[orderNdx]].name;
+
+		nameOffset[order[orderNdx]] = (deUint32)strings.size();
+		strings.insert(strings.end(), name.begin(), name.end());
+		strings.push_back(0);
+	}
+
+	for (size_t orderNdx = 0; orderNdx < order.size(); orderNdx++)
+	{
+		const vector<string>& tags = m_nodes[order[orderNdx]].tags;
+
+		firstTag[order[orderNdx]] = (deUint32)tagRefs.size();
+
+		for (vector<string>::const_iterator tagIter = tags.begin(); tagIter != tags.end(); ++tagIter)
+		{
+			const std::map<string, deUint32>::const_iterator existing = tagOffsets.find(*tagIter);
+
+			if (existing != tagOffsets.end())
+				tagRefs.push_back(existing->second);
+			else
+			{
+				tagOffsets[*tagIter] = (deUint32)strings.size();
+				tagRefs.push_back((deUint32)strings.size());
+				strings.insert(strings.end(), tagIter->begin(), tagIter->end());
+				strings.push_back(0);
+			}
+		}
+	}
+
+	dst.clear();
+	dst.reserve(HEADER_SIZE + order.size()*NODE_SIZE + tagRefs.size()*TAG_REF_SIZE + strings.size());
+
+	dst.insert(dst.end(), DE_ARRAY_BEGIN(s_magic), DE_ARRAY_END(s_magic));
+	writeU32(dst, (deUint32)CaseIndex::FORMAT_VERSION);
+	writeU32(dst, (deUint32)order.size());
+	writeU32(dst, (deUint32)tagRefs.size());
+	writeU32(dst, (deUint32)strings.size());
+
+	for (size_t orderNdx = 0; orderNdx < order.size(); orderNdx++)
+	{
+		const int			nodeNdx	= order[orderNdx];
+		const BuildNode&	node	= m_nodes[nodeNdx];
+
+		writeU32(dst, nameOffset[nodeNdx]);
+		writeU32(dst, node.children.empty() ? 0u : firstChild[nodeNdx]);
+		writeU32(dst, (deUint32)node.children.size());
+		dst.push_back((deUint8)node.nodeType);
+		dst.push_back(0);
+		dst.push_back(0);
+		dst.push_back(0);
+		writeU64(dst, node.durationUs);
+		writeU32(dst, firstTag[nodeNdx]);
+		writeU32(dst, (deUint32)node.tags.size());
+	}
+
+	for (vector<deUint32>::const_iterator tagIter = tagRefs.begin(); tagIter != tagRefs.end(); ++tagIter)
+		writeU32(dst, *tagIter);
+
+	dst.insert(dst.end(), strings.begin(), strings.end());
+}
+
+void CaseIndexBuilder::write (const string& filename) const
+{
+	vector<deUint8>	data;
+	std::ofstream	out;
+
+	serialize(data);
+
+	out.open(filename.c_str(), std::ios_base::binary);
+	if (!out.is_open() || !out.good())
+		throw Exception("Failed to open " + filename);
+
+	out.write((const char*)&data[0], (std::streamsize)data.size());
+	if (!out.good())
+		throw Exception("Failed to write " + filename);
+}
+
+// Case index export
+
+void writeCaseIndexesToFiles (TestPackageRoot& root, TestContext& testCtx, const CommandLine& cmdLine)
+{
+	DefaultHierarchyInflater			inflater		(testCtx);
+	de::MovePtr<const CaseListFilter>	caseListFilter	(testCtx.getCommandLine().createCaseListFilter(testCtx.getArchive()));
+
+	TestHierarchyIterator				iter			(root, inflater, *caseListFilter);
+	const char* const					filenamePattern = cmdLine.getCaseListExportFile();
+
+	while (iter.getState() != TestHierarchyIterator::STATE_FINISHED)
+	{
+		const TestNode*		node		= iter.getNode();
+		const char*			pkgName		= node->getName();
+		const string		filename	= makePackageFilename(filenamePattern, pkgName, "idx");
+		CaseIndexBuilder	builder;
+		int					depth		= 0;
+
+		DE_ASSERT(iter.getState() == TestHierarchyIterator::STATE_ENTER_NODE &&
+				  node->getNodeType() == NODETYPE_PACKAGE);
+
+		print("Writing test case index of '%s' to file '%s'..\n", pkgName, filename.c_str());
+
+		do
+		{
+			if (iter.getState() == TestHierarchyIterator::STATE_ENTER_NODE)
+			{
+				builder.enterNode(iter.getNode()->getName(), iter.getNode()->getNodeType());
+				depth += 1;
+			}
+			else
+			{
+				DE_ASSERT(iter.getState() == TestHierarchyIterator::STATE_LEAVE_NODE);
+				builder.leaveNode();
+				depth -= 1;
+			}
+
+			iter.next();
+		} while (depth > 0);
+
+		// Keep duration estimates and tags recorded into the existing index
+		if (de::FilePath(filename).exists())
+		{
+			try
+			{
+				builder.setRecordedData(CaseIndex(filename));
+			}
+			catch (const Exception& e)
+			{
+				print("  ignoring durations and tags from existing index: %s\n", e.what());
+			}
+		}
+
+		builder.write(filename);
+	}
+}
+
+void writeCaselistsFromIndex (const CaseIndex& index, const CaseListFilter& filter, const CommandLine& cmdLine)
+{
+	const RunMode			runMode		= cmdLine.getRunMode();
+	vector<CaseIndexEntry>	nodes;
+	std::ofstream			file;
+
+	if (runMode == RUNMODE_DUMP_TEXT_CASELIST)
+	{
+		const string filename = makePackageFilename(cmdLine.getCaseListExportFile(), index.getPackageName(), "txt");
+
+		file.open(filename.c_str(), std::ios_base::binary);
+		if (!file.is_open() || !file.good())
+			throw Exception("Failed to open " + filename);
+
+		print("Writing test cases from '%s' to file '%s'..\n", index.getPackageName(), filename.c_str());
+	}
+	else if (runMode != RUNMODE_DUMP_STDOUT_CASELIST)
+		throw NotSupportedError("Test case index can only be used with txt-caselist and stdout-caselist run modes");
+
+	index.getMatchingNodes(filter, nodes);
+
+	{
+		std::ostream& out = (runMode == RUNMODE_DUMP_TEXT_CASELIST) ? (std::ostream&)file : std::cout;
+
+		for (vector<CaseIndexEntry>::const_iterator nodeIter = nodes.begin(); nodeIter != nodes.end(); ++nodeIter)
+			out << (isTestNodeTypeExecutable(nodeIter->nodeType) ? "TEST" : "GROUP") << ": " << nodeIter->path << "\n";
+	}
+}
+
+} // tcu
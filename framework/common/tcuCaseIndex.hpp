@@ -0,0 +1,186 @@
+#ifndef _TCUCASEINDEX_HPP
+#define _TCUCASEINDEX_HPP
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Tester Core
+ * ----------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Precompiled test case index.
+ *
+ * Case index is a compact binary image of a single test package hierarchy.
+ * It allows enumerating and filtering test cases without instantiating the
+ * test hierarchy. Index file layout (all integers little-endian):
+ *
+ *   char[4]	magic "dQCI"
+ *   deUint32	format version
+ *   deUint32	number of nodes
+ *   deUint32	number of tag references
+ *   deUint32	size of string table in bytes
+ *   Node[]		nodes in breadth-first order, package node first:
+ *     deUint32	offset of name in string table
+ *     deUint32	index of first child
+ *     deUint32	number of children
+ *     deUint8	node type (tcu::TestNodeType)
+ *     deUint8	reserved[3]
+ *     deUint64	duration estimate in microseconds, 0 if unknown
+ *     deUint32	index of first tag reference
+ *     deUint32	number of tags
+ *   deUint32[]	tag references, offsets of tag names in string table
+ *   char[]		string table, null-terminated node and tag names
+ *
+ * Children of each node are stored contiguously, which keeps duration
+ * slots at fixed offsets so that tools can update them in place.
+ *
+ * Tags are free-form per-case labels. The test hierarchy has no tag data,
+ * so tags are recorded by tools (for example status of the previous run,
+ * see scripts/log/update_case_index_durations.py) and carried over when
+ * the index is regenerated.
+ *//*--------------------------------------------------------------------*/
+
+#include "tcuDefs.hpp"
+#include "tcuTestCase.hpp"
+
+#include <string>
+#include <vector>
+#include <map>
+
+namespace tcu
+{
+
+class CaseListFilter;
+class CommandLine;
+class TestPackageRoot;
+
+struct CaseIndexEntry
+{
+	std::string					path;			//!< Full case path, including package name.
+	TestNodeType				nodeType;		//!< Case type.
+	deUint64					durationUs;		//!< Duration estimate from previous run, 0 if unknown.
+	std::vector<std::string>	tags;			//!< Case tags.
+
+	CaseIndexEntry (void) : nodeType(NODETYPE_SELF_VALIDATE), durationUs(0) {}
+	CaseIndexEntry (const std::string& path_, TestNodeType nodeType_, deUint64 durationUs_) : path(path_), nodeType(nodeType_), durationUs(durationUs_) {}
+
+	bool			hasTag			(const std::string& tag) const;
+
+	//! Check tag filter; case must have every listed tag and none of the tags prefixed with '!'
+	bool			matchesTags		(const std::vector<std::string>& tagFilter) const;
+};
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Read-only test case index
+ *//*--------------------------------------------------------------------*/
+class CaseIndex
+{
+public:
+	explicit					CaseIndex			(const std::string& filename);
+	explicit					CaseIndex			(const std::vector<deUint8>& data);
+								~CaseIndex			(void);
+
+	const char*					getPackageName		(void) const;
+	int							getNumCases			(void) const { return m_numCases;	}
+
+	//! Get all cases (in hierarchy order) that match the filter
+	void						getMatchingCases	(const CaseListFilter& filter, std::vector<CaseIndexEntry>& dst) const;
+
+	//! Get groups and cases that match the filter, in the order TestHierarchyIterator would enter them
+	void						getMatchingNodes	(const CaseListFilter& filter, std::vector<CaseIndexEntry>& dst) const;
+
+	//! Find case by full path. Returns false if not found.
+	bool						findCase			(const std::string& path, CaseIndexEntry* dst) const;
+
+	//! Get all cases regardless of filter
+	void						getAllCases			(std::vector<CaseIndexEntry>& dst) const;
+
+	enum
+	{
+		FORMAT_VERSION	= 2
+	};
+
+private:
+	struct Node
+	{
+		deUint32				nameOffset;
+		deUint32				firstChild;
+		deUint32				numChildren;
+		TestNodeType			nodeType;
+		deUint64				durationUs;
+		deUint32				firstTag;
+		deUint32				numTags;
+	};
+
+								CaseIndex			(const CaseIndex&);
+	CaseIndex&					operator=			(const CaseIndex&);
+
+	void						parse				(const std::vector<deUint8>& data);
+	const char*					getName				(const Node& node) const { return &m_strings[node.nameOffset]; }
+	CaseIndexEntry				makeEntry			(const Node& node, const std::string& path) const;
+	void						collectNodes		(const CaseListFilter* filter, deUint32 nodeNdx, const std::string& path, bool includeGroups, std::vector<CaseIndexEntry>& dst) const;
+
+	std::vector<Node>			m_nodes;
+	std::vector<deUint32>		m_tagOffsets;
+	std::vector<char>			m_strings;
+	int							m_numCases;
+};
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Test case index builder
+ *
+ * Builder is fed with enterNode() and leaveNode() calls in hierarchy
+ * order, starting from the package node.
+ *//*--------------------------------------------------------------------*/
+class CaseIndexBuilder
+{
+public:
+								CaseIndexBuilder	(void);
+								~CaseIndexBuilder	(void);
+
+	void						enterNode			(const char* name, TestNodeType nodeType);
+	void						leaveNode			(void);
+
+	//! Add tag to the current node
+	void						addTag				(const char* tag);
+
+	//! Carry over duration estimates and tags from previous index by case path
+	void						setRecordedData		(const CaseIndex& previous);
+
+	void						serialize			(std::vector<deUint8>& dst) const;
+	void						write				(const std::string& filename) const;
+
+private:
+	struct BuildNode
+	{
+		std::string					name;
+		TestNodeType				nodeType;
+		deUint64					durationUs;
+		std::vector<std::string>	tags;
+		std::vector<int>			children;
+	};
+
+	void						collectPaths		(int nodeNdx, const std::string& path, std::map<std::string, int>& dst) const;
+
+	std::vector<BuildNode>		m_nodes;
+	std::vector<int>			m_nodeStack;
+};
+
+void	writeCaseIndexesToFiles		(TestPackageRoot& root, TestContext& testCtx, const CommandLine& cmdLine);
+void	writeCaselistsFromIndex		(const CaseIndex& index, const CaseListFilter& filter, const CommandLine& cmdLine);
+
+} // tcu
+
+#endif // _TCUCASEINDEX_HPP
@@ -25,6 +25,7 @@
 #include "tcuPlatform.hpp"
 #include "tcuTestCase.hpp"
 #include "tcuResource.hpp"
+#include "tcuCaseIndex.hpp"
 #include "deFilePath.hpp"
 #include "deStringUtil.hpp"
 #include "deString.h"
@@ -63,6 +64,8 @@ DE_DECLARE_COMMAND_LINE_OPT(StdinCaseList,				bool);
 DE_DECLARE_COMMAND_LINE_OPT(LogFilename,				std::string);
 DE_DECLARE_COMMAND_LINE_OPT(RunMode,					tcu::RunMode);
 DE_DECLARE_COMMAND_LINE_OPT(ExportFilenamePattern,		std::string);
+DE_DECLARE_COMMAND_LINE_OPT(CaseIndexFile,				std::string);
+DE_DECLARE_COMMAND_LINE_OPT(CaseTags,					std::string);
 DE_DECLARE_COMMAND_LINE_OPT(WatchDog,					bool);
 DE_DECLARE_COMMAND_LINE_OPT(CrashHandler,				bool);
 DE_DECLARE_COMMAND_LINE_OPT(BaseSeed,					int);
@@ -84,16 +87,27 @@ DE_DECLARE_COMMAND_LINE_OPT(EGLWindowType,				std::string);
 DE_DECLARE_COMMAND_LINE_OPT(EGLPixmapType,				std::string);
 DE_DECLARE_COMMAND_LINE_OPT(LogImages,					bool);
 DE_DECLARE_COMMAND_LINE_OPT(LogShaderSources,			bool);
+DE_DECLARE_COMMAND_LINE_OPT(LogImageCaseBudget,			int);
+DE_DECLARE_COMMAND_LINE_OPT(LogImageSessionBudget,		int);
+DE_DECLARE_COMMAND_LINE_OPT(LogTiming,					bool);
+DE_DECLARE_COMMAND_LINE_OPT(CaseLookahead,				int);
 DE_DECLARE_COMMAND_LINE_OPT(TestOOM,					bool);
 DE_DECLARE_COMMAND_LINE_OPT(VKDeviceID,					int);
 DE_DECLARE_COMMAND_LINE_OPT(VKDeviceGroupID,			int);
 DE_DECLARE_COMMAND_LINE_OPT(LogFlush,					bool);
 DE_DECLARE_COMMAND_LINE_OPT(Validation,					bool);
 DE_DECLARE_COMMAND_LINE_OPT(ShaderCache,				bool);
+DE_DECLARE_COMMAND_LINE_OPT(CompileServerPort,			int);
+DE_DECLARE_COMMAND_LINE_OPT(DeviceCacheSize,			int);
+DE_DECLARE_COMMAND_LINE_OPT(PipelineCache,			bool);
+DE_DECLARE_COMMAND_LINE_OPT(PipelineCacheFilename,	std::string);
+DE_DECLARE_COMMAND_LINE_OPT(VkProgramBinaryCache,		bool);
 DE_DECLARE_COMMAND_LINE_OPT(ShaderCacheFilename,		std::string);
 DE_DECLARE_COMMAND_LINE_OPT(Optimization,				int);
 DE_DECLARE_COMMAND_LINE_OPT(OptimizeSpirv,				bool);
 DE_DECLARE_COMMAND_LINE_OPT(ShaderCacheTruncate,		bool);
+DE_DECLARE_COMMAND_LINE_OPT(GLProgramBinaryCache,		bool);
+DE_DECLARE_COMMAND_LINE_OPT(GLProgramBinaryCacheFilename,	std::string);
 
 static void parseIntList (const char* src, std::vector<int>* dst)
 {
@@ -123,7 +137,8 @@ void registerOptions (de::cmdline::Parser& parser)
 		{ "execute",		RUNMODE_EXECUTE				},
 		{ "xml-caselist",	RUNMODE_DUMP_XML_CASELIST	},
 		{ "txt-caselist",	RUNMODE_DUMP_TEXT_CASELIST	},
-		{ "stdout-caselist",RUNMODE_DUMP_STDOUT_CASELIST}
+		{ "stdout-caselist",RUNMODE_DUMP_STDOUT_CASELIST},
+		{ "case-index",		RUNMODE_DUMP_CASE_INDEX		}
 	};
 	static const NamedValue<WindowVisibility> s_visibilites[] =
 	{
@@ -157,6 +172,8 @@ void registerOptions (de::cmdline::Parser& parser)
 		<< Option<RunMode>				(DE_NULL,	"deqp-runmode",					"Execute tests, or write list of test cases into a file",
 																																		s_runModes,			"execute")
 		<< Option<ExportFilenamePattern>(DE_NULL,	"deqp-caselist-export-file",	"Set the target file name pattern for caselist export",					"${packageName}-cases.${typeExtension}")
+		<< Option<CaseIndexFile>		(DE_NULL,	"deqp-case-index",				"Select test cases from given case index; only cases of the indexed package are listed or run")
+		<< Option<CaseTags>				(DE_NULL,	"deqp-case-tags",				"Select cases from case index by tags (comma-separated, prefix with ! to exclude)")
 		<< Option<WatchDog>				(DE_NULL,	"deqp-watchdog",				"Enable test watchdog",								s_enableNames,		"disable")
 		<< Option<CrashHandler>			(DE_NULL,	"deqp-crashhandler",			"Enable crash handling",							s_enableNames,		"disable")
 		<< Option<BaseSeed>				(DE_NULL,	"deqp-base-seed",				"Base seed for test cases that use randomization",						"0")
@@ -180,6 +197,10 @@ void registerOptions (de::cmdline::Parser& parser)
 		<< Option<VKDeviceGroupID>		(DE_NULL,	"deqp-vk-device-group-id",		"Vulkan device Group ID (IDs start from 1)",							"1")
 		<< Option<LogImages>			(DE_NULL,	"deqp-log-images",				"Enable or disable logging of result images",		s_enableNames,		"enable")
 		<< Option<LogShaderSources>		(DE_NULL,	"deqp-log-shader-sources",		"Enable or disable logging of shader sources",		s_enableNames,		"enable")
+		<< Option<LogImageCaseBudget>	(DE_NULL,	"deqp-log-image-case-budget",	"Maximum image data logged per test case in kilobytes (0 = unlimited)",	"0")
+		<< Option<LogImageSessionBudget>(DE_NULL,	"deqp-log-image-session-budget","Maximum image data logged per session in kilobytes (0 = unlimited)",	"0")
+		<< Option<LogTiming>			(DE_NULL,	"deqp-log-timing",				"Enable or disable logging of per-case timing breakdown",	s_enableNames,	"disable")
+		<< Option<CaseLookahead>		(DE_NULL,	"deqp-case-lookahead",			"Number of upcoming test cases to prepare in background (0 = disabled)",	"0")
 		<< Option<TestOOM>				(DE_NULL,	"deqp-test-oom",				"Run tests that exhaust memory on purpose",			s_enableNames,		TEST_OOM_DEFAULT)
 		<< Option<LogFlush>				(DE_NULL,	"deqp-log-flush",				"Enable or disable log file fflush",				s_enableNames,		"enable")
 		<< Option<Validation>			(DE_NULL,	"deqp-validation",				"Enable or disable test case validation",			s_enableNames,		"disable")
@@ -187,7 +208,14 @@ void registerOptions (de::cmdline::Parser& parser)
 		<< Option<OptimizeSpirv>		(DE_NULL,	"deqp-optimize-spirv",			"Apply optimization to spir-v shaders as well",		s_enableNames,		"disable")
 		<< Option<ShaderCache>			(DE_NULL,	"deqp-shadercache",				"Enable or disable shader cache",					s_enableNames,		"enable")
 		<< Option<ShaderCacheFilename>	(DE_NULL,	"deqp-shadercache-filename",	"Write shader cache to given file",										"shadercache.bin")
-		<< Option<ShaderCacheTruncate>	(DE_NULL,	"deqp-shadercache-truncate",	"Truncate shader cache before running tests",		s_enableNames,		"enable");
+		<< Option<ShaderCacheTruncate>	(DE_NULL,	"deqp-shadercache-truncate",	"Truncate shader cache before running tests",		s_enableNames,		"enable")
+		<< Option<CompileServerPort>	(DE_NULL,	"deqp-compile-server-port",		"Build shaders with local compile server listening on given port (0 = disabled)",	"0")
+		<< Option<DeviceCacheSize>		(DE_NULL,	"deqp-device-cache-size",		"Number of idle custom Vulkan devices kept for reuse (0 = disabled)",	"4")
+		<< Option<PipelineCache>		(DE_NULL,	"deqp-pipeline-cache",			"Enable or disable shared Vulkan pipeline cache",	s_enableNames,		"enable")
+		<< Option<PipelineCacheFilename>	(DE_NULL,	"deqp-pipeline-cache-filename",	"Load and save shared Vulkan pipeline cache using given file",			"")
+		<< Option<VkProgramBinaryCache>	(DE_NULL,	"deqp-vk-program-binary-cache",	"Enable or disable reuse of Vulkan program binaries built earlier in the session",	s_enableNames,	"enable")
+		<< Option<GLProgramBinaryCache>	(DE_NULL,	"deqp-gl-program-binary-cache",	"Enable or disable GL program binary cache",		s_enableNames,		"disable")
+		<< Option<GLProgramBinaryCacheFilename>	(DE_NULL,	"deqp-gl-program-binary-cache-filename",	"Write GL program binary cache to given file",		"glprogramcache.bin");
 }
 
 void registerLegacyOptions (de::cmdline::Parser& parser)
@@ -799,14 +827,33 @@ int						CommandLine::getCLPlatformId				(void) const	{ return m_cmdLine.getOpti
 const std::vector<int>&	CommandLine::getCLDeviceIds					(void) const	{ return m_cmdLine.getOption<opt::CLDeviceIDs>();					}
 int						CommandLine::getVKDeviceId					(void) const	{ return m_cmdLine.getOption<opt::VKDeviceID>();					}
 int						CommandLine::getVKDeviceGroupId				(void) const	{ return m_cmdLine.getOption<opt::VKDeviceGroupID>();				}
+int						CommandLine::getLogImageCaseBudget			(void) const	{ return m_cmdLine.getOption<opt::LogImageCaseBudget>();			}
+int						CommandLine::getLogImageSessionBudget		(void) const	{ return m_cmdLine.getOption<opt::LogImageSessionBudget>();			}
+bool					CommandLine::isTimingLogEnabled				(void) const	{ return m_cmdLine.getOption<opt::LogTiming>();						}
+int						CommandLine::getCaseLookahead				(void) const	{ return m_cmdLine.getOption<opt::CaseLookahead>();					}
 bool					CommandLine::isValidationEnabled			(void) const	{ return m_cmdLine.getOption<opt::Validation>();					}
 bool					CommandLine::isOutOfMemoryTestEnabled		(void) const	{ return m_cmdLine.getOption<opt::TestOOM>();						}
 bool					CommandLine::isShadercacheEnabled			(void) const	{ return m_cmdLine.getOption<opt::ShaderCache>();					}
 const char*				CommandLine::getShaderCacheFilename			(void) const	{ return m_cmdLine.getOption<opt::ShaderCacheFilename>().c_str();	}
 bool					CommandLine::isShaderCacheTruncateEnabled	(void) const	{ return m_cmdLine.getOption<opt::ShaderCacheTruncate>();			}
+int						CommandLine::getCompileServerPort			(void) const	{ return m_cmdLine.getOption<opt::CompileServerPort>();				}
+int						CommandLine::getDeviceCacheSize				(void) const	{ return m_cmdLine.getOption<opt::DeviceCacheSize>();				}
+bool					CommandLine::isPipelineCacheEnabled			(void) const	{ return m_cmdLine.getOption<opt::PipelineCache>();					}
+const char*				CommandLine::getPipelineCacheFilename		(void) const	{ return m_cmdLine.getOption<opt::PipelineCacheFilename>().c_str();	}
+bool					CommandLine::isVkProgramBinaryCacheEnabled	(void) const	{ return m_cmdLine.getOption<opt::VkProgramBinaryCache>();			}
+bool					CommandLine::isGLProgramBinaryCacheEnabled	(void) const	{ return m_cmdLine.getOption<opt::GLProgramBinaryCache>();			}
+const char*				CommandLine::getGLProgramBinaryCacheFilename	(void) const	{ return m_cmdLine.getOption<opt::GLProgramBinaryCacheFilename>().c_str();	}
 int						CommandLine::getOptimizationRecipe			(void) const	{ return m_cmdLine.getOption<opt::Optimization>();					}
 bool					CommandLine::isSpirvOptimizationEnabled		(void) const	{ return m_cmdLine.getOption<opt::OptimizeSpirv>();					}
 
+const char* CommandLine::getCaseIndexFile (void) const
+{
+	if (m_cmdLine.hasOption<opt::CaseIndexFile>())
+		return m_cmdLine.getOption<opt::CaseIndexFile>().c_str();
+	else
+		return DE_NULL;
+}
+
 const char* CommandLine::getGLContextType (void) const
 {
 	if (m_cmdLine.hasOption<opt::GLContextType>())
@@ -947,6 +994,40 @@ CaseListFilter::CaseListFilter (const de::cmdline::CommandLine& cmdLine, const t
 	}
 	else if (cmdLine.hasOption<opt::CasePath>())
 		m_casePaths = de::MovePtr<const CasePaths>(new CasePaths(cmdLine.getOption<opt::CasePath>()));
+
+	if (cmdLine.hasOption<opt::CaseIndexFile>())
+	{
+		const vector<string> tagFilter = cmdLine.hasOption<opt::CaseTags>() ? de::splitString(cmdLine.getOption<opt::CaseTags>(), ',') : vector<string>();
+
+		restrictToCaseIndex(CaseIndex(cmdLine.getOption<opt::CaseIndexFile>()), tagFilter);
+	}
+	else if (cmdLine.hasOption<opt::CaseTags>())
+		throw Exception("--deqp-case-tags requires --deqp-case-index");
+}
+
+void CaseListFilter::restrictToCaseIndex (const CaseIndex& index, const vector<string>& tagFilter)
+{
+	// Cases are matched against the index, and replaced with an exact list of matching cases. Hierarchy
+	// iteration then never enters groups that have no selected cases in them.
+	vector<CaseIndexEntry>	cases;
+	std::ostringstream		caseList;
+
+	index.getMatchingCases(*this, cases);
+
+	for (vector<CaseIndexEntry>::const_iterator caseIter = cases.begin(); caseIter != cases.end(); ++caseIter)
+	{
+		if (caseIter->matchesTags(tagFilter))
+			caseList << caseIter->path << "\n";
+	}
+
+	{
+		std::istringstream in (caseList.str());
+
+		delete m_caseTree;
+		m_caseTree	= DE_NULL;
+		m_casePaths	= de::MovePtr<const CasePaths>();
+		m_caseTree	= caseList.str().empty() ? new CaseTreeNode("") : parseCaseList(in);
+	}
 }
 
 CaseListFilter::~CaseListFilter (void)
@@ -44,6 +44,7 @@ enum RunMode
 	RUNMODE_DUMP_XML_CASELIST,		//! Test program dumps the list of contained test cases in XML format.
 	RUNMODE_DUMP_TEXT_CASELIST,		//! Test program dumps the list of contained test cases in plain-text format.
 	RUNMODE_DUMP_STDOUT_CASELIST,	//! Test program dumps the list of contained test cases in plain-text format into stdout.
+	RUNMODE_DUMP_CASE_INDEX,		//! Test program writes binary test case index of each package.
 
 	RUNMODE_LAST
 };
@@ -89,6 +90,7 @@ enum ScreenRotation
 
 class CaseTreeNode;
 class CasePaths;
+class CaseIndex;
 class Archive;
 
 class CaseListFilter
@@ -108,6 +110,8 @@ private:
 	CaseListFilter												(const CaseListFilter&);	// not allowed!
 	CaseListFilter&					operator=					(const CaseListFilter&);	// not allowed!
 
+	void							restrictToCaseIndex			(const CaseIndex& index, const std::vector<std::string>& tagFilter);
+
 	CaseTreeNode*					m_caseTree;
 	de::MovePtr<const CasePaths>	m_casePaths;
 };
@@ -135,12 +139,27 @@ public:
 	//! Get logging flags
 	deUint32						getLogFlags						(void) const;
 
+	//! Get maximum image data logged per test case in kilobytes (--deqp-log-image-case-budget)
+	int								getLogImageCaseBudget			(void) const;
+
+	//! Get maximum image data logged per session in kilobytes (--deqp-log-image-session-budget)
+	int								getLogImageSessionBudget		(void) const;
+
+	//! Should per-case timing breakdown be logged (--deqp-log-timing)
+	bool							isTimingLogEnabled				(void) const;
+
+	//! Get number of upcoming test cases to prepare in background (--deqp-case-lookahead)
+	int								getCaseLookahead				(void) const;
+
 	//! Get run mode (--deqp-runmode)
 	RunMode							getRunMode						(void) const;
 
 	//! Get caselist dump target file pattern (--deqp-caselist-export-file)
 	const char*						getCaseListExportFile			(void) const;
 
+	//! Get test case index used for selecting test cases (--deqp-case-index)
+	const char*						getCaseIndexFile				(void) const;
+
 	//! Get default window visibility (--deqp-visibility)
 	WindowVisibility				getVisibility					(void) const;
 
@@ -220,6 +239,27 @@ public:
 	//! Should the shader cache be truncated before run (--deqp-shadercache-truncate)
 	bool							isShaderCacheTruncateEnabled	(void) const;
 
+	//! Get port of local shader compile server (--deqp-compile-server-port)
+	int								getCompileServerPort			(void) const;
+
+	//! Get number of idle custom Vulkan devices kept for reuse (--deqp-device-cache-size)
+	int								getDeviceCacheSize				(void) const;
+
+	//! Should Vulkan object utilities use a shared pipeline cache (--deqp-pipeline-cache)
+	bool							isPipelineCacheEnabled			(void) const;
+
+	//! Get the filename for persistent Vulkan pipeline cache, empty if not persisted (--deqp-pipeline-cache-filename)
+	const char*						getPipelineCacheFilename		(void) const;
+
+	//! Should Vulkan programs built earlier in the session be reused (--deqp-vk-program-binary-cache)
+	bool							isVkProgramBinaryCacheEnabled	(void) const;
+
+	//! Should the GL program binary cache be enabled (--deqp-gl-program-binary-cache)
+	bool							isGLProgramBinaryCacheEnabled	(void) const;
+
+	//! Get the filename for GL program binary cache (--deqp-gl-program-binary-cache-filename)
+	const char*						getGLProgramBinaryCacheFilename	(void) const;
+
 	//! Get shader optimization recipe (--deqp-optimization-recipe)
 	int								getOptimizationRecipe		(void) const;
 
@@ -24,6 +24,7 @@
 #include "tcuCompressedTexture.hpp"
 #include "tcuTextureUtil.hpp"
 #include "tcuAstcUtil.hpp"
+#include "tcuWorkerPool.hpp"
 
 #include "deStringUtil.hpp"
 #include "deFloat16.h"
@@ -2493,37 +2494,81 @@ int componentSum (const IVec3& vec)
 	return vec.x() + vec.y() + vec.z();
 }
 
-} // anonymous
-
-void decompress (const PixelBufferAccess& dst, CompressedTexFormat fmt, const deUint8* src, const TexDecompressionParams& params)
+enum
 {
-	const int				blockSize			= getBlockSize(fmt);
-	const IVec3				blockPixelSize		(getBlockPixelSize(fmt));
-	const IVec3				blockCount			(deDivRoundUp32(dst.getWidth(),		blockPixelSize.x()),
-												 deDivRoundUp32(dst.getHeight(),	blockPixelSize.y()),
-												 deDivRoundUp32(dst.getDepth(),		blockPixelSize.z()));
-	const IVec3				blockPitches		(blockSize, blockSize * blockCount.x(), blockSize * blockCount.x() * blockCount.y());
+	DECOMPRESS_BLOCKS_PER_BATCH	= 256	//!< Minimum number of blocks decompressed by one parallel batch
+};
 
-	std::vector<deUint8>	uncompressedBlock	(dst.getFormat().getPixelSize() * blockPixelSize.x() * blockPixelSize.y() * blockPixelSize.z());
-	const PixelBufferAccess	blockAccess			(getUncompressedFormat(fmt), blockPixelSize.x(), blockPixelSize.y(), blockPixelSize.z(), &uncompressedBlock[0]);
+//! Decompresses rows of blocks. Row index is blockZ*blockCount.y() + blockY.
+class DecompressBlockRows : public BatchFunc
+{
+public:
+	DecompressBlockRows (const PixelBufferAccess& dst, CompressedTexFormat format, const deUint8* src, const TexDecompressionParams& params)
+		: m_dst				(dst)
+		, m_format			(format)
+		, m_src				(src)
+		, m_params			(params)
+		, m_blockSize		(getBlockSize(format))
+		, m_blockPixelSize	(getBlockPixelSize(format))
+		, m_blockCount		(deDivRoundUp32(dst.getWidth(),		m_blockPixelSize.x()),
+							 deDivRoundUp32(dst.getHeight(),	m_blockPixelSize.y()),
+							 deDivRoundUp32(dst.getDepth(),		m_blockPixelSize.z()))
+		, m_blockPitches	(m_blockSize, m_blockSize * m_blockCount.x(), m_blockSize * m_blockCount.x() * m_blockCount.y())
+	{
+	}
 
-	DE_ASSERT(dst.getFormat() == getUncompressedFormat(fmt));
+	int		getNumRows			(void) const { return m_blockCount.y() * m_blockCount.z();	}
+	int		getNumBlocksPerRow	(void) const { return m_blockCount.x();						}
 
-	for (int blockZ = 0; blockZ < blockCount.z(); blockZ++)
-	for (int blockY = 0; blockY < blockCount.y(); blockY++)
-	for (int blockX = 0; blockX < blockCount.x(); blockX++)
+	void operator() (int batchNdx, int beginRow, int endRow) const
 	{
-		const IVec3				blockPos	(blockX, blockY, blockZ);
-		const deUint8* const	blockPtr	= src + componentSum(blockPos * blockPitches);
-		const IVec3				copySize	(de::min(blockPixelSize.x(), dst.getWidth()		- blockPos.x() * blockPixelSize.x()),
-											 de::min(blockPixelSize.y(), dst.getHeight()	- blockPos.y() * blockPixelSize.y()),
-											 de::min(blockPixelSize.z(), dst.getDepth()		- blockPos.z() * blockPixelSize.z()));
-		const IVec3				dstPixelPos	= blockPos * blockPixelSize;
+		std::vector<deUint8>	uncompressedBlock	(m_dst.getFormat().getPixelSize() * m_blockPixelSize.x() * m_blockPixelSize.y() * m_blockPixelSize.z());
+		const PixelBufferAccess	blockAccess			(getUncompressedFormat(m_format), m_blockPixelSize.x(), m_blockPixelSize.y(), m_blockPixelSize.z(), &uncompressedBlock[0]);
+
+		DE_UNREF(batchNdx);
 
-		decompressBlock(fmt, blockAccess, blockPtr, params);
+		for (int rowNdx = beginRow; rowNdx < endRow; rowNdx++)
+		for (int blockX = 0; blockX < m_blockCount.x(); blockX++)
+		{
+			const IVec3				blockPos	(blockX, rowNdx % m_blockCount.y(), rowNdx / m_blockCount.y());
+			const deUint8* const	blockPtr	= m_src + componentSum(blockPos * m_blockPitches);
+			const IVec3				copySize	(de::min(m_blockPixelSize.x(), m_dst.getWidth()		- blockPos.x() * m_blockPixelSize.x()),
+												 de::min(m_blockPixelSize.y(), m_dst.getHeight()	- blockPos.y() * m_blockPixelSize.y()),
+												 de::min(m_blockPixelSize.z(), m_dst.getDepth()		- blockPos.z() * m_blockPixelSize.z()));
+			const IVec3				dstPixelPos	= blockPos * m_blockPixelSize;
+
+			decompressBlock(m_format, blockAccess, blockPtr, m_params);
 
-		copy(getSubregion(dst, dstPixelPos.x(), dstPixelPos.y(), dstPixelPos.z(), copySize.x(), copySize.y(), copySize.z()), getSubregion(blockAccess, 0, 0, 0, copySize.x(), copySize.y(), copySize.z()));
+			copy(getSubregion(m_dst, dstPixelPos.x(), dstPixelPos.y(), dstPixelPos.z(), copySize.x(), copySize.y(), copySize.z()), getSubregion(blockAccess, 0, 0, 0, copySize.x(), copySize.y(), copySize.z()));
+		}
 	}
+
+private:
+	const PixelBufferAccess			m_dst;
+	const CompressedTexFormat		m_format;
+	const deUint8* const			m_src;
+	const TexDecompressionParams	m_params;
+	const int						m_blockSize;
+	const IVec3						m_blockPixelSize;
+	const IVec3						m_blockCount;
+	const IVec3						m_blockPitches;
+};
+
+} // anonymous
+
+void decompress (const PixelBufferAccess& dst, CompressedTexFormat fmt, const deUint8* src, const TexDecompressionParams& params)
+{
+	const DecompressBlockRows	decompressRows	(dst, fmt, src, params);
+	const int					numRows			= decompressRows.getNumRows();
+	const int					rowsPerBatch	= de::max(1, (int)DECOMPRESS_BLOCKS_PER_BATCH / de::max(1, decompressRows.getNumBlocksPerRow()));
+
+	DE_ASSERT(dst.getFormat() == getUncompressedFormat(fmt));
+
+	// Block rows are written to disjoint destination areas, so they can be decompressed in parallel.
+	if (numRows > rowsPerBatch)
+		executeBatches(numRows, rowsPerBatch, decompressRows, DE_NULL);
+	else
+		decompressRows(0, 0, numRows);
 }
 
 CompressedTexture::CompressedTexture (void)
@@ -0,0 +1,111 @@
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Tester Core
+ * ----------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Compressed texture decompression throughput benchmark.
+ *//*--------------------------------------------------------------------*/
+
+#include "tcuCompressedTexture.hpp"
+#include "tcuAstcUtil.hpp"
+#include "tcuTexture.hpp"
+#include "deRandom.hpp"
+#include "deClock.h"
+
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+
+using namespace tcu;
+
+static void generateBlocks (std::vector<deUint8>& dst, CompressedTexFormat format, size_t numBlocks)
+{
+	dst.resize(numBlocks * getBlockSize(format));
+
+	if (isAstcFormat(format))
+		astc::generateRandomValidBlocks(&dst[0], numBlocks, format, TexDecompressionParams::ASTCMODE_LDR, 1234);
+	else
+	{
+		// All ETC and EAC bit patterns are valid blocks.
+		de::Random rnd (1234);
+
+		for (size_t ndx = 0; ndx < dst.size(); ndx++)
+			dst[ndx] = rnd.getUint8();
+	}
+}
+
+static void runBenchmark (CompressedTexFormat format, const char* name)
+{
+	const int					size			= 1024;
+	const int					numIterations	= 4;
+	const IVec3					blockPixelSize	= getBlockPixelSize(format);
+	const size_t				numBlocks		= (size_t)deDivRoundUp32(size, blockPixelSize.x()) * (size_t)deDivRoundUp32(size, blockPixelSize.y());
+	CompressedTexture			compressed		(format, size, size);
+	TextureLevel				decompressed	(getUncompressedFormat(format), size, size);
+	std::vector<deUint8>		blocks;
+
+	generateBlocks(blocks, format, numBlocks);
+	std::copy(blocks.begin(), blocks.end(), (deUint8*)compressed.getData());
+
+	// Warm up; this also builds any lookup tables used by the decoder.
+	compressed.decompress(decompressed.getAccess(), TexDecompressionParams(TexDecompressionParams::ASTCMODE_LDR));
+
+	{
+		const deUint64	startTime	= deGetMicroseconds();
+
+		for (int iterNdx = 0; iterNdx < numIterations; iterNdx++)
+			compressed.decompress(decompressed.getAccess(), TexDecompressionParams(TexDecompressionParams::ASTCMODE_LDR));
+
+		{
+			const deUint64	elapsedUs		= de::max<deUint64>(1, deGetMicroseconds() - startTime);
+			const double	blocksPerSec	= (double)numBlocks * (double)numIterations * 1e6 / (double)elapsedUs;
+
+			printf("%-32s %14.0f blocks/s\n", name, blocksPerSec);
+		}
+	}
+}
+
+int main (int argc, const char* const* argv)
+{
+	static const struct
+	{
+		CompressedTexFormat	format;
+		const char*			name;
+	} formats[] =
+	{
+		{ COMPRESSEDTEXFORMAT_ETC1_RGB8,						"etc1_rgb8"							},
+		{ COMPRESSEDTEXFORMAT_EAC_R11,							"eac_r11"							},
+		{ COMPRESSEDTEXFORMAT_EAC_RG11,							"eac_rg11"							},
+		{ COMPRESSEDTEXFORMAT_ETC2_RGB8,						"etc2_rgb8"							},
+		{ COMPRESSEDTEXFORMAT_ETC2_RGB8_PUNCHTHROUGH_ALPHA1,	"etc2_rgb8_punchthrough_alpha1"		},
+		{ COMPRESSEDTEXFORMAT_ETC2_EAC_RGBA8,					"etc2_eac_rgba8"					},
+		{ COMPRESSEDTEXFORMAT_ASTC_4x4_RGBA,					"astc_4x4_rgba"						},
+		{ COMPRESSEDTEXFORMAT_ASTC_6x6_RGBA,					"astc_6x6_rgba"						},
+		{ COMPRESSEDTEXFORMAT_ASTC_8x8_RGBA,					"astc_8x8_rgba"						},
+		{ COMPRESSEDTEXFORMAT_ASTC_12x12_RGBA,					"astc_12x12_rgba"					},
+		{ COMPRESSEDTEXFORMAT_ASTC_4x4_SRGB8_ALPHA8,			"astc_4x4_srgb8_alpha8"				},
+		{ COMPRESSEDTEXFORMAT_ASTC_8x8_SRGB8_ALPHA8,			"astc_8x8_srgb8_alpha8"				}
+	};
+
+	DE_UNREF(argc && argv);
+
+	for (int formatNdx = 0; formatNdx < DE_LENGTH_OF_ARRAY(formats); formatNdx++)
+		runBenchmark(formats[formatNdx].format, formats[formatNdx].name);
+
+	return 0;
+}
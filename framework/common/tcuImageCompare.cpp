@@ -32,8 +32,10 @@
 #include "tcuTexture.hpp"
 #include "tcuTextureUtil.hpp"
 #include "tcuFloat.hpp"
+#include "tcuScopedTimer.hpp"
 
 #include <string.h>
+#include <limits>
 
 namespace tcu
 {
@@ -183,6 +185,97 @@ static int findNumPositionDeviationFailingPixels (const PixelBufferAccess& error
 	return numFailingPixels;
 }
 
+enum
+{
+	ERROR_REGION_MARGIN	= 8		//!< Pixels logged around failing region for context
+};
+
+//! Axis-aligned box of pixels, end is exclusive
+struct PixelRegion
+{
+	IVec3	begin;
+	IVec3	end;
+
+	PixelRegion (void)
+		: begin	(std::numeric_limits<int>::max())
+		, end	(std::numeric_limits<int>::min())
+	{
+	}
+
+	PixelRegion (const IVec3& begin_, const IVec3& end_)
+		: begin	(begin_)
+		, end	(end_)
+	{
+	}
+
+	bool	isEmpty		(void) const	{ return !boolAll(lessThan(begin, end));	}
+	IVec3	getSize		(void) const	{ return end - begin;						}
+
+	void include (int x, int y, int z)
+	{
+		begin	= min(begin, IVec3(x, y, z));
+		end		= max(end, IVec3(x+1, y+1, z+1));
+	}
+};
+
+//! Region of images to log: failing pixels with some margin, or whole image if there are none
+PixelRegion getLoggedRegion (const PixelRegion& failingRegion, const IVec3& imageSize)
+{
+	if (failingRegion.isEmpty())
+		return PixelRegion(IVec3(0), imageSize);
+	else
+		return PixelRegion(max(failingRegion.begin - IVec3(ERROR_REGION_MARGIN), IVec3(0)),
+						   min(failingRegion.end + IVec3(ERROR_REGION_MARGIN), imageSize));
+}
+
+//! Find region of non-green pixels in error mask
+PixelRegion findErrorMaskRegion (const ConstPixelBufferAccess& errorMask)
+{
+	const Vec3	okColor	(0.0f, 1.0f, 0.0f);
+	PixelRegion	region;
+
+	for (int z = 0; z < errorMask.getDepth(); z++)
+	for (int y = 0; y < errorMask.getHeight(); y++)
+	for (int x = 0; x < errorMask.getWidth(); x++)
+	{
+		if (errorMask.getPixel(x, y, z).toWidth<3>() != okColor)
+			region.include(x, y, z);
+	}
+
+	return region;
+}
+
+ConstPixelBufferAccess getRegionAccess (const ConstPixelBufferAccess& access, const PixelRegion& region)
+{
+	const IVec3 size = region.getSize();
+	return getSubregion(access, region.begin.x(), region.begin.y(), region.begin.z(), size.x(), size.y(), size.z());
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Log result, reference and error mask of failed comparison
+ *
+ * Result and reference images are cropped to the given region. Error mask
+ * must already have the size of the region. Reference may be null.
+ *//*--------------------------------------------------------------------*/
+void logCompareImages (TestLog& log, const char* imageSetName, const char* imageSetDesc, const ConstPixelBufferAccess* reference, const ConstPixelBufferAccess& result, const ConstPixelBufferAccess& errorMask, const PixelRegion& region, const Vec4& pixelScale, const Vec4& pixelBias)
+{
+	const IVec3 imageSize (result.getWidth(), result.getHeight(), result.getDepth());
+
+	DE_ASSERT(errorMask.getSize() == region.getSize());
+
+	if (region.begin != IVec3(0) || region.end != imageSize)
+		log << TestLog::Message << "Logged images are cropped to region of failing pixels: offset = " << region.begin << ", size = " << region.getSize() << ", full image size = " << imageSize << TestLog::EndMessage;
+
+	log << TestLog::ImageSet(imageSetName, imageSetDesc)
+		<< TestLog::Image("Result",		"Result",		getRegionAccess(result, region),		pixelScale, pixelBias);
+
+	if (reference)
+		log << TestLog::Image("Reference",	"Reference",	getRegionAccess(*reference, region),	pixelScale, pixelBias);
+
+	log << TestLog::Image("ErrorMask",	"Error mask",	errorMask)
+		<< TestLog::EndImageSet;
+}
+
 } // anonymous
 
 /*--------------------------------------------------------------------*//*!
@@ -216,6 +309,8 @@ static int findNumPositionDeviationFailingPixels (const PixelBufferAccess& error
  *//*--------------------------------------------------------------------*/
 bool fuzzyCompare (TestLog& log, const char* imageSetName, const char* imageSetDesc, const ConstPixelBufferAccess& reference, const ConstPixelBufferAccess& result, float threshold, CompareLogMode logMode)
 {
+	const ScopedTimer timer ("tcu::fuzzyCompare");
+
 	FuzzyCompareParams	params;		// Use defaults.
 	TextureLevel		errorMask		(TextureFormat(TextureFormat::RGB, TextureFormat::UNORM_INT8), reference.getWidth(), reference.getHeight());
 	float				difference		= fuzzyCompare(params, reference, result, errorMask.getAccess());
@@ -235,11 +330,11 @@ bool fuzzyCompare (TestLog& log, const char* imageSetName, const char* imageSetD
 		if (!isOk)
 			log << TestLog::Message << "Image comparison failed: difference = " << difference << ", threshold = " << threshold << TestLog::EndMessage;
 
-		log << TestLog::ImageSet(imageSetName, imageSetDesc)
-			<< TestLog::Image("Result",		"Result",		result,		pixelScale, pixelBias)
-			<< TestLog::Image("Reference",	"Reference",	reference,	pixelScale, pixelBias)
-			<< TestLog::Image("ErrorMask",	"Error mask",	errorMask)
-			<< TestLog::EndImageSet;
+		{
+			const PixelRegion loggedRegion = getLoggedRegion(findErrorMaskRegion(errorMask.getAccess()), reference.getSize());
+
+			logCompareImages(log, imageSetName, imageSetDesc, &reference, result, getRegionAccess(errorMask.getAccess(), loggedRegion), loggedRegion, pixelScale, pixelBias);
+		}
 	}
 	else if (logMode == COMPARE_LOG_RESULT)
 	{
@@ -334,6 +429,8 @@ static deInt64 computeSquaredDiffSum (const ConstPixelBufferAccess& ref, const C
  *//*--------------------------------------------------------------------*/
 int measurePixelDiffAccuracy (TestLog& log, const char* imageSetName, const char* imageSetDesc, const ConstPixelBufferAccess& reference, const ConstPixelBufferAccess& result, int bestScoreDiff, int worstScoreDiff, CompareLogMode logMode)
 {
+	const ScopedTimer timer ("tcu::measurePixelDiffAccuracy");
+
 	TextureLevel	diffMask		(TextureFormat(TextureFormat::RGB, TextureFormat::UNORM_INT8), reference.getWidth(), reference.getHeight());
 	int				diffFactor		= 8;
 	deInt64			squaredSum		= computeSquaredDiffSum(reference, result, diffMask.getAccess(), diffFactor);
@@ -462,6 +559,114 @@ static tcu::UVec4 computeFlushRelaxedULPDiff (const tcu::Vec4& a, const tcu::Vec
 					  computeFloatFlushRelaxedULPDiff(a.w(), b.w()));
 }
 
+namespace
+{
+
+// Per-pixel difference functors for threshold comparisons
+
+class FloatUlpPixelDiff
+{
+public:
+	typedef UVec4 DiffType;
+
+	FloatUlpPixelDiff (const ConstPixelBufferAccess& reference, const ConstPixelBufferAccess& result) : m_reference(reference), m_result(result) {}
+
+	UVec4 operator() (int x, int y, int z) const { return computeFlushRelaxedULPDiff(m_reference.getPixel(x, y, z), m_result.getPixel(x, y, z)); }
+
+private:
+	const ConstPixelBufferAccess&	m_reference;
+	const ConstPixelBufferAccess&	m_result;
+};
+
+class FloatPixelDiff
+{
+public:
+	typedef Vec4 DiffType;
+
+	FloatPixelDiff (const ConstPixelBufferAccess& reference, const ConstPixelBufferAccess& result) : m_reference(reference), m_result(result) {}
+
+	Vec4 operator() (int x, int y, int z) const { return abs(m_reference.getPixel(x, y, z) - m_result.getPixel(x, y, z)); }
+
+private:
+	const ConstPixelBufferAccess&	m_reference;
+	const ConstPixelBufferAccess&	m_result;
+};
+
+class FloatColorPixelDiff
+{
+public:
+	typedef Vec4 DiffType;
+
+	FloatColorPixelDiff (const Vec4& reference, const ConstPixelBufferAccess& result) : m_reference(reference), m_result(result) {}
+
+	Vec4 operator() (int x, int y, int z) const { return abs(m_reference - m_result.getPixel(x, y, z)); }
+
+private:
+	const Vec4						m_reference;
+	const ConstPixelBufferAccess&	m_result;
+};
+
+class IntPixelDiff
+{
+public:
+	typedef UVec4 DiffType;
+
+	IntPixelDiff (const ConstPixelBufferAccess& reference, const ConstPixelBufferAccess& result) : m_reference(reference), m_result(result) {}
+
+	UVec4 operator() (int x, int y, int z) const { return abs(m_reference.getPixelInt(x, y, z) - m_result.getPixelInt(x, y, z)).cast<deUint32>(); }
+
+private:
+	const ConstPixelBufferAccess&	m_reference;
+	const ConstPixelBufferAccess&	m_result;
+};
+
+//! Compute maximum difference and region of pixels exceeding threshold without generating error mask
+template<typename PixelDiff>
+typename PixelDiff::DiffType findMaxDiff (const PixelDiff& pixelDiff, const IVec3& size, const typename PixelDiff::DiffType& threshold, PixelRegion& failingRegion)
+{
+	typedef typename PixelDiff::DiffType DiffType;
+
+	DiffType maxDiff (0);
+
+	for (int z = 0; z < size.z(); z++)
+	{
+		for (int y = 0; y < size.y(); y++)
+		{
+			for (int x = 0; x < size.x(); x++)
+			{
+				const DiffType	diff	= pixelDiff(x, y, z);
+
+				maxDiff = max(maxDiff, diff);
+
+				if (!boolAll(lessThanEqual(diff, threshold)))
+					failingRegion.include(x, y, z);
+			}
+		}
+	}
+
+	return maxDiff;
+}
+
+//! Generate error mask for region starting at offset
+template<typename PixelDiff>
+void generateErrorMask (const PixelBufferAccess& errorMask, const PixelDiff& pixelDiff, const IVec3& offset, const typename PixelDiff::DiffType& threshold)
+{
+	for (int z = 0; z < errorMask.getDepth(); z++)
+	{
+		for (int y = 0; y < errorMask.getHeight(); y++)
+		{
+			for (int x = 0; x < errorMask.getWidth(); x++)
+			{
+				const bool isOk = boolAll(lessThanEqual(pixelDiff(offset.x() + x, offset.y() + y, offset.z() + z), threshold));
+
+				errorMask.setPixel(isOk ? Vec4(0.0f, 1.0f, 0.0f, 1.0f) : Vec4(1.0f, 0.0f, 0.0f, 1.0f), x, y, z);
+			}
+		}
+	}
+}
+
+} // anonymous
+
 /*--------------------------------------------------------------------*//*!
  * \brief Per-pixel threshold-based comparison
  *
@@ -487,39 +692,26 @@ static tcu::UVec4 computeFlushRelaxedULPDiff (const tcu::Vec4& a, const tcu::Vec
  *//*--------------------------------------------------------------------*/
 bool floatUlpThresholdCompare (TestLog& log, const char* imageSetName, const char* imageSetDesc, const ConstPixelBufferAccess& reference, const ConstPixelBufferAccess& result, const UVec4& threshold, CompareLogMode logMode)
 {
-	int					width				= reference.getWidth();
-	int					height				= reference.getHeight();
-	int					depth				= reference.getDepth();
-	TextureLevel		errorMaskStorage	(TextureFormat(TextureFormat::RGB, TextureFormat::UNORM_INT8), width, height, depth);
-	PixelBufferAccess	errorMask			= errorMaskStorage.getAccess();
-	UVec4				maxDiff				(0, 0, 0, 0);
-	Vec4				pixelBias			(0.0f, 0.0f, 0.0f, 0.0f);
-	Vec4				pixelScale			(1.0f, 1.0f, 1.0f, 1.0f);
-
-	TCU_CHECK(result.getWidth() == width && result.getHeight() == height && result.getDepth() == depth);
+	const ScopedTimer timer ("tcu::floatUlpThresholdCompare");
 
-	for (int z = 0; z < depth; z++)
-	{
-		for (int y = 0; y < height; y++)
-		{
-			for (int x = 0; x < width; x++)
-			{
-				const Vec4	refPix	= reference.getPixel(x, y, z);
-				const Vec4	cmpPix	= result.getPixel(x, y, z);
-				const UVec4	diff	= computeFlushRelaxedULPDiff(refPix, cmpPix);
-				const bool	isOk	= boolAll(lessThanEqual(diff, threshold));
+	const IVec3				size			= reference.getSize();
+	const FloatUlpPixelDiff	pixelDiff		(reference, result);
+	PixelRegion				failingRegion;
+	Vec4					pixelBias		(0.0f, 0.0f, 0.0f, 0.0f);
+	Vec4					pixelScale		(1.0f, 1.0f, 1.0f, 1.0f);
 
-				maxDiff = max(maxDiff, diff);
-
-				errorMask.setPixel(isOk ? Vec4(0.0f, 1.0f, 0.0f, 1.0f) : Vec4(1.0f, 0.0f, 0.0f, 1.0f), x, y, z);
-			}
-		}
-	}
+	TCU_CHECK(result.getSize() == size);
 
-	bool compareOk = boolAll(lessThanEqual(maxDiff, threshold));
+	const UVec4				maxDiff			= findMaxDiff(pixelDiff, size, threshold, failingRegion);
+	const bool				compareOk		= boolAll(lessThanEqual(maxDiff, threshold));
 
 	if (!compareOk || logMode == COMPARE_LOG_EVERYTHING)
 	{
+		const PixelRegion	loggedRegion	= getLoggedRegion(failingRegion, size);
+		TextureLevel		errorMask		(TextureFormat(TextureFormat::RGB, TextureFormat::UNORM_INT8), loggedRegion.getSize().x(), loggedRegion.getSize().y(), loggedRegion.getSize().z());
+
+		generateErrorMask(errorMask.getAccess(), pixelDiff, loggedRegion.begin, threshold);
+
 		// All formats except normalized unsigned fixed point ones need remapping in order to fit into unorm channels in logged images.
 		if (tcu::getTextureChannelClass(reference.getFormat().type)	!= tcu::TEXTURECHANNELCLASS_UNSIGNED_FIXED_POINT ||
 			tcu::getTextureChannelClass(result.getFormat().type)	!= tcu::TEXTURECHANNELCLASS_UNSIGNED_FIXED_POINT)
@@ -531,11 +723,7 @@ bool floatUlpThresholdCompare (TestLog& log, const char* imageSetName, const cha
 		if (!compareOk)
 			log << TestLog::Message << "Image comparison failed: max difference = " << maxDiff << ", threshold = " << threshold << TestLog::EndMessage;
 
-		log << TestLog::ImageSet(imageSetName, imageSetDesc)
-			<< TestLog::Image("Result",		"Result",		result,		pixelScale, pixelBias)
-			<< TestLog::Image("Reference",	"Reference",	reference,	pixelScale, pixelBias)
-			<< TestLog::Image("ErrorMask",	"Error mask",	errorMask)
-			<< TestLog::EndImageSet;
+		logCompareImages(log, imageSetName, imageSetDesc, &reference, result, errorMask.getAccess(), loggedRegion, pixelScale, pixelBias);
 	}
 	else if (logMode == COMPARE_LOG_RESULT)
 	{
@@ -573,40 +761,26 @@ bool floatUlpThresholdCompare (TestLog& log, const char* imageSetName, const cha
  *//*--------------------------------------------------------------------*/
 bool floatThresholdCompare (TestLog& log, const char* imageSetName, const char* imageSetDesc, const ConstPixelBufferAccess& reference, const ConstPixelBufferAccess& result, const Vec4& threshold, CompareLogMode logMode)
 {
-	int					width				= reference.getWidth();
-	int					height				= reference.getHeight();
-	int					depth				= reference.getDepth();
-	TextureLevel		errorMaskStorage	(TextureFormat(TextureFormat::RGB, TextureFormat::UNORM_INT8), width, height, depth);
-	PixelBufferAccess	errorMask			= errorMaskStorage.getAccess();
-	Vec4				maxDiff				(0.0f, 0.0f, 0.0f, 0.0f);
-	Vec4				pixelBias			(0.0f, 0.0f, 0.0f, 0.0f);
-	Vec4				pixelScale			(1.0f, 1.0f, 1.0f, 1.0f);
-
-	TCU_CHECK_INTERNAL(result.getWidth() == width && result.getHeight() == height && result.getDepth() == depth);
-
-	for (int z = 0; z < depth; z++)
-	{
-		for (int y = 0; y < height; y++)
-		{
-			for (int x = 0; x < width; x++)
-			{
-				Vec4	refPix		= reference.getPixel(x, y, z);
-				Vec4	cmpPix		= result.getPixel(x, y, z);
+	const ScopedTimer timer ("tcu::floatThresholdCompare");
 
-				Vec4	diff		= abs(refPix - cmpPix);
-				bool	isOk		= boolAll(lessThanEqual(diff, threshold));
+	const IVec3				size			= reference.getSize();
+	const FloatPixelDiff	pixelDiff		(reference, result);
+	PixelRegion				failingRegion;
+	Vec4					pixelBias		(0.0f, 0.0f, 0.0f, 0.0f);
+	Vec4					pixelScale		(1.0f, 1.0f, 1.0f, 1.0f);
 
-				maxDiff = max(maxDiff, diff);
+	TCU_CHECK_INTERNAL(result.getSize() == size);
 
-				errorMask.setPixel(isOk ? Vec4(0.0f, 1.0f, 0.0f, 1.0f) : Vec4(1.0f, 0.0f, 0.0f, 1.0f), x, y, z);
-			}
-		}
-	}
-
-	bool compareOk = boolAll(lessThanEqual(maxDiff, threshold));
+	const Vec4				maxDiff			= findMaxDiff(pixelDiff, size, threshold, failingRegion);
+	const bool				compareOk		= boolAll(lessThanEqual(maxDiff, threshold));
 
 	if (!compareOk || logMode == COMPARE_LOG_EVERYTHING)
 	{
+		const PixelRegion	loggedRegion	= getLoggedRegion(failingRegion, size);
+		TextureLevel		errorMask		(TextureFormat(TextureFormat::RGB, TextureFormat::UNORM_INT8), loggedRegion.getSize().x(), loggedRegion.getSize().y(), loggedRegion.getSize().z());
+
+		generateErrorMask(errorMask.getAccess(), pixelDiff, loggedRegion.begin, threshold);
+
 		// All formats except normalized unsigned fixed point ones need remapping in order to fit into unorm channels in logged images.
 		if (tcu::getTextureChannelClass(reference.getFormat().type)	!= tcu::TEXTURECHANNELCLASS_UNSIGNED_FIXED_POINT ||
 			tcu::getTextureChannelClass(result.getFormat().type)	!= tcu::TEXTURECHANNELCLASS_UNSIGNED_FIXED_POINT)
@@ -618,11 +792,7 @@ bool floatThresholdCompare (TestLog& log, const char* imageSetName, const char*
 		if (!compareOk)
 			log << TestLog::Message << "Image comparison failed: max difference = " << maxDiff << ", threshold = " << threshold << TestLog::EndMessage;
 
-		log << TestLog::ImageSet(imageSetName, imageSetDesc)
-			<< TestLog::Image("Result",		"Result",		result,		pixelScale, pixelBias)
-			<< TestLog::Image("Reference",	"Reference",	reference,	pixelScale, pixelBias)
-			<< TestLog::Image("ErrorMask",	"Error mask",	errorMask)
-			<< TestLog::EndImageSet;
+		logCompareImages(log, imageSetName, imageSetDesc, &reference, result, errorMask.getAccess(), loggedRegion, pixelScale, pixelBias);
 	}
 	else if (logMode == COMPARE_LOG_RESULT)
 	{
@@ -660,37 +830,24 @@ bool floatThresholdCompare (TestLog& log, const char* imageSetName, const char*
  *//*--------------------------------------------------------------------*/
 bool floatThresholdCompare (TestLog& log, const char* imageSetName, const char* imageSetDesc, const Vec4& reference, const ConstPixelBufferAccess& result, const Vec4& threshold, CompareLogMode logMode)
 {
-	const int			width				= result.getWidth();
-	const int			height				= result.getHeight();
-	const int			depth				= result.getDepth();
-
-	TextureLevel		errorMaskStorage	(TextureFormat(TextureFormat::RGB, TextureFormat::UNORM_INT8), width, height, depth);
-	PixelBufferAccess	errorMask			= errorMaskStorage.getAccess();
-	Vec4				maxDiff				(0.0f, 0.0f, 0.0f, 0.0f);
-	Vec4				pixelBias			(0.0f, 0.0f, 0.0f, 0.0f);
-	Vec4				pixelScale			(1.0f, 1.0f, 1.0f, 1.0f);
-
-	for (int z = 0; z < depth; z++)
-	{
-		for (int y = 0; y < height; y++)
-		{
-			for (int x = 0; x < width; x++)
-			{
-				const Vec4	cmpPix		= result.getPixel(x, y, z);
-				const Vec4	diff		= abs(reference - cmpPix);
-				const bool	isOk		= boolAll(lessThanEqual(diff, threshold));
-
-				maxDiff = max(maxDiff, diff);
+	const ScopedTimer timer ("tcu::floatThresholdCompare");
 
-				errorMask.setPixel(isOk ? Vec4(0.0f, 1.0f, 0.0f, 1.0f) : Vec4(1.0f, 0.0f, 0.0f, 1.0f), x, y, z);
-			}
-		}
-	}
+	const IVec3					size			= result.getSize();
+	const FloatColorPixelDiff	pixelDiff		(reference, result);
+	PixelRegion					failingRegion;
+	Vec4						pixelBias		(0.0f, 0.0f, 0.0f, 0.0f);
+	Vec4						pixelScale		(1.0f, 1.0f, 1.0f, 1.0f);
 
-	bool compareOk = boolAll(lessThanEqual(maxDiff, threshold));
+	const Vec4					maxDiff			= findMaxDiff(pixelDiff, size, threshold, failingRegion);
+	const bool					compareOk		= boolAll(lessThanEqual(maxDiff, threshold));
 
 	if (!compareOk || logMode == COMPARE_LOG_EVERYTHING)
 	{
+		const PixelRegion	loggedRegion	= getLoggedRegion(failingRegion, size);
+		TextureLevel		errorMask		(TextureFormat(TextureFormat::RGB, TextureFormat::UNORM_INT8), loggedRegion.getSize().x(), loggedRegion.getSize().y(), loggedRegion.getSize().z());
+
+		generateErrorMask(errorMask.getAccess(), pixelDiff, loggedRegion.begin, threshold);
+
 		// All formats except normalized unsigned fixed point ones need remapping in order to fit into unorm channels in logged images.
 		if (tcu::getTextureChannelClass(result.getFormat().type) != tcu::TEXTURECHANNELCLASS_UNSIGNED_FIXED_POINT)
 		{
@@ -701,10 +858,7 @@ bool floatThresholdCompare (TestLog& log, const char* imageSetName, const char*
 		if (!compareOk)
 			log << TestLog::Message << "Image comparison failed: max difference = " << maxDiff << ", threshold = " << threshold << ", reference = " << reference << TestLog::EndMessage;
 
-		log << TestLog::ImageSet(imageSetName, imageSetDesc)
-			<< TestLog::Image("Result",		"Result",		result,		pixelScale, pixelBias)
-			<< TestLog::Image("ErrorMask",	"Error mask",	errorMask)
-			<< TestLog::EndImageSet;
+		logCompareImages(log, imageSetName, imageSetDesc, DE_NULL, result, errorMask.getAccess(), loggedRegion, pixelScale, pixelBias);
 	}
 	else if (logMode == COMPARE_LOG_RESULT)
 	{
@@ -742,40 +896,26 @@ bool floatThresholdCompare (TestLog& log, const char* imageSetName, const char*
  *//*--------------------------------------------------------------------*/
 bool intThresholdCompare (TestLog& log, const char* imageSetName, const char* imageSetDesc, const ConstPixelBufferAccess& reference, const ConstPixelBufferAccess& result, const UVec4& threshold, CompareLogMode logMode)
 {
-	int					width				= reference.getWidth();
-	int					height				= reference.getHeight();
-	int					depth				= reference.getDepth();
-	TextureLevel		errorMaskStorage	(TextureFormat(TextureFormat::RGB, TextureFormat::UNORM_INT8), width, height, depth);
-	PixelBufferAccess	errorMask			= errorMaskStorage.getAccess();
-	UVec4				maxDiff				(0, 0, 0, 0);
-	Vec4				pixelBias			(0.0f, 0.0f, 0.0f, 0.0f);
-	Vec4				pixelScale			(1.0f, 1.0f, 1.0f, 1.0f);
+	const ScopedTimer timer ("tcu::intThresholdCompare");
 
-	TCU_CHECK_INTERNAL(result.getWidth() == width && result.getHeight() == height && result.getDepth() == depth);
-
-	for (int z = 0; z < depth; z++)
-	{
-		for (int y = 0; y < height; y++)
-		{
-			for (int x = 0; x < width; x++)
-			{
-				IVec4	refPix		= reference.getPixelInt(x, y, z);
-				IVec4	cmpPix		= result.getPixelInt(x, y, z);
-
-				UVec4	diff		= abs(refPix - cmpPix).cast<deUint32>();
-				bool	isOk		= boolAll(lessThanEqual(diff, threshold));
+	const IVec3				size			= reference.getSize();
+	const IntPixelDiff		pixelDiff		(reference, result);
+	PixelRegion				failingRegion;
+	Vec4					pixelBias		(0.0f, 0.0f, 0.0f, 0.0f);
+	Vec4					pixelScale		(1.0f, 1.0f, 1.0f, 1.0f);
 
-				maxDiff = max(maxDiff, diff);
-
-				errorMask.setPixel(isOk ? IVec4(0, 0xff, 0, 0xff) : IVec4(0xff, 0, 0, 0xff), x, y, z);
-			}
-		}
-	}
+	TCU_CHECK_INTERNAL(result.getSize() == size);
 
-	bool compareOk = boolAll(lessThanEqual(maxDiff, threshold));
+	const UVec4				maxDiff			= findMaxDiff(pixelDiff, size, threshold, failingRegion);
+	const bool				compareOk		= boolAll(lessThanEqual(maxDiff, threshold));
 
 	if (!compareOk || logMode == COMPARE_LOG_EVERYTHING)
 	{
+		const PixelRegion	loggedRegion	= getLoggedRegion(failingRegion, size);
+		TextureLevel		errorMask		(TextureFormat(TextureFormat::RGB, TextureFormat::UNORM_INT8), loggedRegion.getSize().x(), loggedRegion.getSize().y(), loggedRegion.getSize().z());
+
+		generateErrorMask(errorMask.getAccess(), pixelDiff, loggedRegion.begin, threshold);
+
 		// All formats except normalized unsigned fixed point ones need remapping in order to fit into unorm channels in logged images.
 		if (tcu::getTextureChannelClass(reference.getFormat().type)	!= tcu::TEXTURECHANNELCLASS_UNSIGNED_FIXED_POINT ||
 			tcu::getTextureChannelClass(result.getFormat().type)	!= tcu::TEXTURECHANNELCLASS_UNSIGNED_FIXED_POINT)
@@ -787,11 +927,7 @@ bool intThresholdCompare (TestLog& log, const char* imageSetName, const char* im
 		if (!compareOk)
 			log << TestLog::Message << "Image comparison failed: max difference = " << maxDiff << ", threshold = " << threshold << TestLog::EndMessage;
 
-		log << TestLog::ImageSet(imageSetName, imageSetDesc)
-			<< TestLog::Image("Result",		"Result",		result,		pixelScale, pixelBias)
-			<< TestLog::Image("Reference",	"Reference",	reference,	pixelScale, pixelBias)
-			<< TestLog::Image("ErrorMask",	"Error mask",	errorMask)
-			<< TestLog::EndImageSet;
+		logCompareImages(log, imageSetName, imageSetDesc, &reference, result, errorMask.getAccess(), loggedRegion, pixelScale, pixelBias);
 	}
 	else if (logMode == COMPARE_LOG_RESULT)
 	{
@@ -837,6 +973,8 @@ bool intThresholdCompare (TestLog& log, const char* imageSetName, const char* im
  *//*--------------------------------------------------------------------*/
 bool intThresholdPositionDeviationCompare (TestLog& log, const char* imageSetName, const char* imageSetDesc, const ConstPixelBufferAccess& reference, const ConstPixelBufferAccess& result, const UVec4& threshold, const tcu::IVec3& maxPositionDeviation, bool acceptOutOfBoundsAsAnyValue, CompareLogMode logMode)
 {
+	const ScopedTimer timer ("tcu::intThresholdPositionDeviationCompare");
+
 	const int			width				= reference.getWidth();
 	const int			height				= reference.getHeight();
 	const int			depth				= reference.getDepth();
@@ -864,11 +1002,11 @@ bool intThresholdPositionDeviationCompare (TestLog& log, const char* imageSetNam
 				<< "\tcolor threshold = " << threshold
 				<< TestLog::EndMessage;
 
-		log << TestLog::ImageSet(imageSetName, imageSetDesc)
-			<< TestLog::Image("Result",		"Result",		result,		pixelScale, pixelBias)
-			<< TestLog::Image("Reference",	"Reference",	reference,	pixelScale, pixelBias)
-			<< TestLog::Image("ErrorMask",	"Error mask",	errorMask)
-			<< TestLog::EndImageSet;
+		{
+			const PixelRegion loggedRegion = getLoggedRegion(findErrorMaskRegion(errorMask), reference.getSize());
+
+			logCompareImages(log, imageSetName, imageSetDesc, &reference, result, getRegionAccess(errorMask, loggedRegion), loggedRegion, pixelScale, pixelBias);
+		}
 	}
 	else if (logMode == COMPARE_LOG_RESULT)
 	{
@@ -916,6 +1054,8 @@ bool intThresholdPositionDeviationCompare (TestLog& log, const char* imageSetNam
  *//*--------------------------------------------------------------------*/
 bool intThresholdPositionDeviationErrorThresholdCompare (TestLog& log, const char* imageSetName, const char* imageSetDesc, const ConstPixelBufferAccess& reference, const ConstPixelBufferAccess& result, const UVec4& threshold, const tcu::IVec3& maxPositionDeviation, bool acceptOutOfBoundsAsAnyValue, int maxAllowedFailingPixels, CompareLogMode logMode)
 {
+	const ScopedTimer timer ("tcu::intThresholdPositionDeviationErrorThresholdCompare");
+
 	const int			width				= reference.getWidth();
 	const int			height				= reference.getHeight();
 	const int			depth				= reference.getDepth();
@@ -944,11 +1084,11 @@ bool intThresholdPositionDeviationErrorThresholdCompare (TestLog& log, const cha
 				<< TestLog::EndMessage;
 		log << TestLog::Message << "Number of failing pixels = " << numFailingPixels << ", max allowed = " << maxAllowedFailingPixels << TestLog::EndMessage;
 
-		log << TestLog::ImageSet(imageSetName, imageSetDesc)
-			<< TestLog::Image("Result",		"Result",		result,		pixelScale, pixelBias)
-			<< TestLog::Image("Reference",	"Reference",	reference,	pixelScale, pixelBias)
-			<< TestLog::Image("ErrorMask",	"Error mask",	errorMask)
-			<< TestLog::EndImageSet;
+		{
+			const PixelRegion loggedRegion = getLoggedRegion(findErrorMaskRegion(errorMask), reference.getSize());
+
+			logCompareImages(log, imageSetName, imageSetDesc, &reference, result, getRegionAccess(errorMask, loggedRegion), loggedRegion, pixelScale, pixelBias);
+		}
 	}
 	else if (logMode == COMPARE_LOG_RESULT)
 	{
@@ -1006,6 +1146,8 @@ bool pixelThresholdCompare (TestLog& log, const char* imageSetName, const char*
  *//*--------------------------------------------------------------------*/
 bool bilinearCompare (TestLog& log, const char* imageSetName, const char* imageSetDesc, const ConstPixelBufferAccess& reference, const ConstPixelBufferAccess& result, const RGBA threshold, CompareLogMode logMode)
 {
+	const ScopedTimer timer ("tcu::bilinearCompare");
+
 	TextureLevel		errorMask		(TextureFormat(TextureFormat::RGB, TextureFormat::UNORM_INT8), reference.getWidth(), reference.getHeight());
 	bool				isOk			= bilinearCompare(reference, result, errorMask, threshold);
 	Vec4				pixelBias		(0.0f, 0.0f, 0.0f, 0.0f);
@@ -1019,11 +1161,11 @@ bool bilinearCompare (TestLog& log, const char* imageSetName, const char* imageS
 		if (!isOk)
 			log << TestLog::Message << "Image comparison failed, threshold = " << threshold << TestLog::EndMessage;
 
-		log << TestLog::ImageSet(imageSetName, imageSetDesc)
-			<< TestLog::Image("Result",		"Result",		result,		pixelScale, pixelBias)
-			<< TestLog::Image("Reference",	"Reference",	reference,	pixelScale, pixelBias)
-			<< TestLog::Image("ErrorMask",	"Error mask",	errorMask)
-			<< TestLog::EndImageSet;
+		{
+			const PixelRegion loggedRegion = getLoggedRegion(findErrorMaskRegion(errorMask.getAccess()), reference.getSize());
+
+			logCompareImages(log, imageSetName, imageSetDesc, &reference, result, getRegionAccess(errorMask.getAccess(), loggedRegion), loggedRegion, pixelScale, pixelBias);
+		}
 	}
 	else if (logMode == COMPARE_LOG_RESULT)
 	{
@@ -0,0 +1,42 @@
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Tester Core
+ * ----------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Memory pool utilities.
+ *//*--------------------------------------------------------------------*/
+
+#include "tcuMemPoolUtil.hpp"
+#include "tcuTestLog.hpp"
+
+namespace tcu
+{
+
+void logMemPoolStats (TestLog& log, const char* name, const char* description, const deMemPoolStats& stats)
+{
+	log << TestLog::Section(name, description)
+		<< TestLog::Integer("NumAllocs",			"Number of allocations",			"",		QP_KEY_TAG_NONE,	stats.numAllocs)
+		<< TestLog::Integer("NumPagesCreated",		"Number of pages allocated",		"",		QP_KEY_TAG_NONE,	stats.numPagesCreated)
+		<< TestLog::Integer("NumPagesReused",		"Number of pages reused",			"",		QP_KEY_TAG_NONE,	stats.numPagesReused)
+		<< TestLog::Integer("NumResets",			"Number of pool resets",			"",		QP_KEY_TAG_NONE,	stats.numResets)
+		<< TestLog::Integer("NumAllocatedBytes",	"Bytes allocated from pool",		"B",	QP_KEY_TAG_NONE,	stats.numAllocatedBytes)
+		<< TestLog::Integer("Capacity",				"Bytes held by pool",				"B",	QP_KEY_TAG_NONE,	stats.capacity)
+		<< TestLog::EndSection;
+}
+
+} // tcu
@@ -0,0 +1,44 @@
+#ifndef _TCUMEMPOOLUTIL_HPP
+#define _TCUMEMPOOLUTIL_HPP
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Tester Core
+ * ----------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Memory pool utilities.
+ *//*--------------------------------------------------------------------*/
+
+#include "tcuDefs.hpp"
+#include "deMemPool.h"
+
+namespace tcu
+{
+
+class TestLog;
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Write memory pool allocation statistics to log
+ *
+ * Statistics are written as integer values in a section with given name,
+ * see deMemPool_getStats().
+ *//*--------------------------------------------------------------------*/
+void	logMemPoolStats		(TestLog& log, const char* name, const char* description, const deMemPoolStats& stats);
+
+} // tcu
+
+#endif // _TCUMEMPOOLUTIL_HPP
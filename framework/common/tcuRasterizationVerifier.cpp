@@ -28,6 +28,7 @@
 #include "tcuTextureUtil.hpp"
 #include "tcuVectorUtil.hpp"
 #include "tcuFloat.hpp"
+#include "tcuWorkerPool.hpp"
 #include "deMath.h"
 
 #include "rrRasterizer.hpp"
@@ -2108,12 +2109,33 @@ bool verifySinglesampleWideLineGroupInterpolation (const tcu::Surface& surface,
 	}
 }
 
-} // anonymous
+typedef tcu::Vector<deInt64, 2> I64Vec2;
 
-CoverageType calculateTriangleCoverage (const tcu::Vec4& p0, const tcu::Vec4& p1, const tcu::Vec4& p2, const tcu::IVec2& pixel, const tcu::IVec2& viewportSize, int subpixelBits, bool multisample)
+/*--------------------------------------------------------------------*//*!
+ * \brief Per-triangle state of calculateTriangleCoverage()
+ *
+ * Coverage of a pixel is classified with three successively more
+ * expensive tests: screen space bounding box, distance of pixel center
+ * from the edges, and intersection of edges with the pixel. Edge
+ * distances are cross products of the edges and pixel center positions,
+ * which are linear in pixel coordinates and can be stepped incrementally
+ * along a row.
+ *//*--------------------------------------------------------------------*/
+struct TriangleCoverageSetup
 {
-	typedef tcu::Vector<deInt64, 2> I64Vec2;
+	deInt64		numSubPixels;
+	bool		multisample;
+	tcu::Vec2	screenMin;				//!< Screen space bounding box.
+	tcu::Vec2	screenMax;
+	I64Vec2		vtxRound[3];			//!< Clockwise vertices in subpixel space.
+	I64Vec2		vtxFloor[3];
+	I64Vec2		vtxCeil[3];
+	I64Vec2		edge[3];				//!< vtxRound[ndx+1] - vtxRound[ndx]
+	deInt64		maxDistanceSquared[3];	//!< Squared max distance of pixel center from edge, scaled by squared edge length.
+};
 
+void setupTriangleCoverage (TriangleCoverageSetup& dst, const tcu::Vec4& p0, const tcu::Vec4& p1, const tcu::Vec4& p2, const tcu::IVec2& viewportSize, int subpixelBits, bool multisample)
+{
 	const deUint64		numSubPixels						= ((deUint64)1) << subpixelBits;
 	const deUint64		pixelHitBoxSize						= (multisample) ? (numSubPixels) : (2+2);	//!< allow 4 central (2x2) for non-multisample pixels. Rounding may move edges 1 subpixel to any direction.
 	const bool			order								= isTriangleClockwise(p0, p1, p2);			//!< clockwise / counter-clockwise
@@ -2133,125 +2155,262 @@ CoverageType calculateTriangleCoverage (const tcu::Vec4& p0, const tcu::Vec4& p1
 		(triangleNormalizedDeviceSpace[2] + tcu::Vec2(1.0f, 1.0f)) * 0.5f * tcu::Vec2((float)viewportSize.x(), (float)viewportSize.y()),
 	};
 
-	// Broad bounding box - pixel check
+	dst.numSubPixels	= (deInt64)numSubPixels;
+	dst.multisample		= multisample;
+	dst.screenMin		= tcu::min(tcu::min(triangleScreenSpace[0], triangleScreenSpace[1]), triangleScreenSpace[2]);
+	dst.screenMax		= tcu::max(tcu::max(triangleScreenSpace[0], triangleScreenSpace[1]), triangleScreenSpace[2]);
+
+	for (int vtxNdx = 0; vtxNdx < 3; ++vtxNdx)
+	{
+		// both rounding directions
+		dst.vtxRound[vtxNdx]	= I64Vec2(deRoundFloatToInt32(triangleScreenSpace[vtxNdx].x() * (float)numSubPixels), deRoundFloatToInt32(triangleScreenSpace[vtxNdx].y() * (float)numSubPixels));
+		dst.vtxFloor[vtxNdx]	= I64Vec2(deFloorFloatToInt32(triangleScreenSpace[vtxNdx].x() * (float)numSubPixels), deFloorFloatToInt32(triangleScreenSpace[vtxNdx].y() * (float)numSubPixels));
+		dst.vtxCeil[vtxNdx]		= I64Vec2(deCeilFloatToInt32(triangleScreenSpace[vtxNdx].x() * (float)numSubPixels), deCeilFloatToInt32(triangleScreenSpace[vtxNdx].y() * (float)numSubPixels));
+	}
+
+	for (int vtxNdx = 0; vtxNdx < 3; ++vtxNdx)
 	{
-		const float minX = de::min(de::min(triangleScreenSpace[0].x(), triangleScreenSpace[1].x()), triangleScreenSpace[2].x());
-		const float minY = de::min(de::min(triangleScreenSpace[0].y(), triangleScreenSpace[1].y()), triangleScreenSpace[2].y());
-		const float maxX = de::max(de::max(triangleScreenSpace[0].x(), triangleScreenSpace[1].x()), triangleScreenSpace[2].x());
-		const float maxY = de::max(de::max(triangleScreenSpace[0].y(), triangleScreenSpace[1].y()), triangleScreenSpace[2].y());
+		// Max distance from the pixel center from within the pixel is (sqrt(2) * boxWidth/2). Use 2x value for rounding tolerance
+		dst.edge[vtxNdx]				= dst.vtxRound[(vtxNdx + 1) % 3] - dst.vtxRound[vtxNdx];
+		dst.maxDistanceSquared[vtxNdx]	= (deInt64)(pixelHitBoxSize*pixelHitBoxSize) * tcu::lengthSquared(dst.edge[vtxNdx]);
+	}
+}
 
-		if ((float)pixel.x() > maxX + 1 ||
-			(float)pixel.y() > maxY + 1 ||
-			(float)pixel.x() < minX - 1 ||
-			(float)pixel.y() < minY - 1)
+//! Broad bounding box - pixel check
+inline bool isPixelNearTriangleBounds (const TriangleCoverageSetup& setup, const tcu::IVec2& pixel)
+{
+	return !((float)pixel.x() > setup.screenMax.x() + 1 ||
+			 (float)pixel.y() > setup.screenMax.y() + 1 ||
+			 (float)pixel.x() < setup.screenMin.x() - 1 ||
+			 (float)pixel.y() < setup.screenMin.y() - 1);
+}
+
+//! Cross product of edge and vector from edge start to pixel center in subpixel space
+inline deInt64 getEdgeCrossProduct (const TriangleCoverageSetup& setup, int edgeNdx, const tcu::IVec2& pixel)
+{
+	const I64Vec2 pixelCenterPosition	= I64Vec2(pixel.x(), pixel.y()) * setup.numSubPixels + I64Vec2(setup.numSubPixels / 2, setup.numSubPixels / 2);
+	const I64Vec2 v						= pixelCenterPosition - setup.vtxRound[edgeNdx];
+
+	return setup.edge[edgeNdx].x() * v.y() - setup.edge[edgeNdx].y() * v.x();
+}
+
+//! Change of getEdgeCrossProduct() when moving one pixel to the right
+inline deInt64 getEdgeCrossProductStepX (const TriangleCoverageSetup& setup, int edgeNdx)
+{
+	return -setup.edge[edgeNdx].y() * setup.numSubPixels;
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Broad triangle - pixel area intersection
+ *
+ * Checks if pixel center is a) too far from any edge or b) fully inside
+ * all edges. Returns COVERAGE_PARTIAL if neither is true.
+ *//*--------------------------------------------------------------------*/
+inline CoverageType classifyBroadTriangleCoverage (const TriangleCoverageSetup& setup, const deInt64 (&crossProducts)[3])
+{
+	bool insideAllEdges = true;
+
+	for (int edgeNdx = 0; edgeNdx < 3; ++edgeNdx)
+	{
+		const deInt64 crossProduct = crossProducts[edgeNdx];
+
+		// distance from edge: (edge x v) / |edge|
+		//     (edge x v) / |edge| > maxPixelDistance
+		// ==> (edge x v)^2 / edge^2 > maxPixelDistance^2    | edge x v > 0
+		// ==> (edge x v)^2 > maxPixelDistance^2 * edge^2
+		if (crossProduct < 0 && crossProduct*crossProduct > setup.maxDistanceSquared[edgeNdx])
 			return COVERAGE_NONE;
+		if (crossProduct < 0 || crossProduct*crossProduct < setup.maxDistanceSquared[edgeNdx])
+			insideAllEdges = false;
 	}
 
-	// Broad triangle - pixel area intersection
+	return (insideAllEdges) ? (COVERAGE_FULL) : (COVERAGE_PARTIAL);
+}
+
+//! Accurate intersection for edge pixels
+CoverageType calculateEdgePixelCoverage (const TriangleCoverageSetup& setup, const tcu::IVec2& pixel)
+{
+	const deInt64 numSubPixels = setup.numSubPixels;
+
+	//  In multisampling, the sample points can be anywhere in the pixel, and in single sampling only in the center.
+	const I64Vec2 pixelCorners[4] =
 	{
-		const I64Vec2 pixelCenterPosition = I64Vec2(pixel.x(), pixel.y()) * I64Vec2(numSubPixels, numSubPixels) + I64Vec2(numSubPixels / 2, numSubPixels / 2);
-		const I64Vec2 triangleSubPixelSpaceRound[3] =
-		{
-			I64Vec2(deRoundFloatToInt32(triangleScreenSpace[0].x() * (float)numSubPixels), deRoundFloatToInt32(triangleScreenSpace[0].y() * (float)numSubPixels)),
-			I64Vec2(deRoundFloatToInt32(triangleScreenSpace[1].x() * (float)numSubPixels), deRoundFloatToInt32(triangleScreenSpace[1].y() * (float)numSubPixels)),
-			I64Vec2(deRoundFloatToInt32(triangleScreenSpace[2].x() * (float)numSubPixels), deRoundFloatToInt32(triangleScreenSpace[2].y() * (float)numSubPixels)),
-		};
+		I64Vec2((pixel.x()+0) * numSubPixels, (pixel.y()+0) * numSubPixels),
+		I64Vec2((pixel.x()+1) * numSubPixels, (pixel.y()+0) * numSubPixels),
+		I64Vec2((pixel.x()+1) * numSubPixels, (pixel.y()+1) * numSubPixels),
+		I64Vec2((pixel.x()+0) * numSubPixels, (pixel.y()+1) * numSubPixels),
+	};
+	const I64Vec2 pixelCenterCorners[4] =
+	{
+		I64Vec2(pixel.x() * numSubPixels + numSubPixels/2 + 0, pixel.y() * numSubPixels + numSubPixels/2 + 0),
+		I64Vec2(pixel.x() * numSubPixels + numSubPixels/2 + 1, pixel.y() * numSubPixels + numSubPixels/2 + 0),
+		I64Vec2(pixel.x() * numSubPixels + numSubPixels/2 + 1, pixel.y() * numSubPixels + numSubPixels/2 + 1),
+		I64Vec2(pixel.x() * numSubPixels + numSubPixels/2 + 0, pixel.y() * numSubPixels + numSubPixels/2 + 1),
+	};
+	const I64Vec2* const corners = (setup.multisample) ? (pixelCorners) : (pixelCenterCorners);
 
-		// Check (using cross product) if pixel center is
-		// a) too far from any edge
-		// b) fully inside all edges
-		bool insideAllEdges = true;
-		for (int vtxNdx = 0; vtxNdx < 3; ++vtxNdx)
+	// Test if any edge (with any rounding) intersects the pixel (boundary). If it does => Partial. If not => fully inside or outside
+
+	for (int edgeNdx = 0; edgeNdx < 3; ++edgeNdx)
+	for (int startRounding = 0; startRounding < 4; ++startRounding)
+	for (int endRounding = 0; endRounding < 4; ++endRounding)
+	{
+		const int		nextEdgeNdx	= (edgeNdx+1) % 3;
+		const I64Vec2	startPos	((startRounding&0x01)	? (setup.vtxFloor[edgeNdx].x())		: (setup.vtxCeil[edgeNdx].x()),		(startRounding&0x02)	? (setup.vtxFloor[edgeNdx].y())		: (setup.vtxCeil[edgeNdx].y()));
+		const I64Vec2	endPos		((endRounding&0x01)		? (setup.vtxFloor[nextEdgeNdx].x())	: (setup.vtxCeil[nextEdgeNdx].x()),	(endRounding&0x02)		? (setup.vtxFloor[nextEdgeNdx].y())	: (setup.vtxCeil[nextEdgeNdx].y()));
+
+		for (int pixelEdgeNdx = 0; pixelEdgeNdx < 4; ++pixelEdgeNdx)
 		{
-			const int		otherVtxNdx				= (vtxNdx + 1) % 3;
-			const deInt64	maxPixelDistanceSquared	= pixelHitBoxSize*pixelHitBoxSize; // Max distance from the pixel center from within the pixel is (sqrt(2) * boxWidth/2). Use 2x value for rounding tolerance
-			const I64Vec2	edge					= triangleSubPixelSpaceRound[otherVtxNdx]	- triangleSubPixelSpaceRound[vtxNdx];
-			const I64Vec2	v						= pixelCenterPosition						- triangleSubPixelSpaceRound[vtxNdx];
-			const deInt64	crossProduct			= (edge.x() * v.y() - edge.y() * v.x());
-
-			// distance from edge: (edge x v) / |edge|
-			//     (edge x v) / |edge| > maxPixelDistance
-			// ==> (edge x v)^2 / edge^2 > maxPixelDistance^2    | edge x v > 0
-			// ==> (edge x v)^2 > maxPixelDistance^2 * edge^2
-			if (crossProduct < 0 && crossProduct*crossProduct > maxPixelDistanceSquared * tcu::lengthSquared(edge))
-				return COVERAGE_NONE;
-			if (crossProduct < 0 || crossProduct*crossProduct < maxPixelDistanceSquared * tcu::lengthSquared(edge))
-				insideAllEdges = false;
+			const int pixelEdgeEnd = (pixelEdgeNdx + 1) % 4;
+
+			if (lineLineIntersect(startPos, endPos, corners[pixelEdgeNdx], corners[pixelEdgeEnd]))
+				return COVERAGE_PARTIAL;
 		}
+	}
 
-		if (insideAllEdges)
-			return COVERAGE_FULL;
+	// fully inside or outside
+	for (int edgeNdx = 0; edgeNdx < 3; ++edgeNdx)
+	{
+		const int		nextEdgeNdx		= (edgeNdx+1) % 3;
+		const I64Vec2&	startPos		= setup.vtxFloor[edgeNdx];
+		const I64Vec2&	endPos			= setup.vtxFloor[nextEdgeNdx];
+		const I64Vec2	edge			= endPos - startPos;
+		const I64Vec2	v				= corners[0] - endPos;
+		const deInt64	crossProduct	= (edge.x() * v.y() - edge.y() * v.x());
+
+		// a corner of the pixel is outside => "fully inside" option is impossible
+		if (crossProduct < 0)
+			return COVERAGE_NONE;
 	}
 
-	// Accurate intersection for edge pixels
+	return COVERAGE_FULL;
+}
+
+enum
+{
+	TRIANGLE_COVERAGE_BAND_HEIGHT	= 8		//!< Coverage map rows per batch
+};
+
+//! Builds coverage map rows of a triangle scene in bands. Rows of each band are rasterized with incremental edge functions.
+class TriangleCoverageBands : public tcu::BatchFunc
+{
+public:
+	TriangleCoverageBands (const TriangleSceneSpec& scene, const tcu::IVec2& viewportSize, int subpixelBits, bool multisample, std::vector<deUint8>& coverageMap)
+		: m_scene			(scene)
+		, m_viewportSize	(viewportSize)
+		, m_setups			(scene.triangles.size())
+		, m_aabbs			(scene.triangles.size())
+		, m_coverageMap		(coverageMap)
 	{
-		//  In multisampling, the sample points can be anywhere in the pixel, and in single sampling only in the center.
-		const I64Vec2 pixelCorners[4] =
-		{
-			I64Vec2((pixel.x()+0) * numSubPixels, (pixel.y()+0) * numSubPixels),
-			I64Vec2((pixel.x()+1) * numSubPixels, (pixel.y()+0) * numSubPixels),
-			I64Vec2((pixel.x()+1) * numSubPixels, (pixel.y()+1) * numSubPixels),
-			I64Vec2((pixel.x()+0) * numSubPixels, (pixel.y()+1) * numSubPixels),
-		};
-		const I64Vec2 pixelCenterCorners[4] =
-		{
-			I64Vec2(pixel.x() * numSubPixels + numSubPixels/2 + 0, pixel.y() * numSubPixels + numSubPixels/2 + 0),
-			I64Vec2(pixel.x() * numSubPixels + numSubPixels/2 + 1, pixel.y() * numSubPixels + numSubPixels/2 + 0),
-			I64Vec2(pixel.x() * numSubPixels + numSubPixels/2 + 1, pixel.y() * numSubPixels + numSubPixels/2 + 1),
-			I64Vec2(pixel.x() * numSubPixels + numSubPixels/2 + 0, pixel.y() * numSubPixels + numSubPixels/2 + 1),
-		};
+		DE_ASSERT((int)coverageMap.size() == viewportSize.x()*viewportSize.y());
 
-		// both rounding directions
-		const I64Vec2 triangleSubPixelSpaceFloor[3] =
-		{
-			I64Vec2(deFloorFloatToInt32(triangleScreenSpace[0].x() * (float)numSubPixels), deFloorFloatToInt32(triangleScreenSpace[0].y() * (float)numSubPixels)),
-			I64Vec2(deFloorFloatToInt32(triangleScreenSpace[1].x() * (float)numSubPixels), deFloorFloatToInt32(triangleScreenSpace[1].y() * (float)numSubPixels)),
-			I64Vec2(deFloorFloatToInt32(triangleScreenSpace[2].x() * (float)numSubPixels), deFloorFloatToInt32(triangleScreenSpace[2].y() * (float)numSubPixels)),
-		};
-		const I64Vec2 triangleSubPixelSpaceCeil[3] =
+		for (int triNdx = 0; triNdx < (int)scene.triangles.size(); ++triNdx)
 		{
-			I64Vec2(deCeilFloatToInt32(triangleScreenSpace[0].x() * (float)numSubPixels), deCeilFloatToInt32(triangleScreenSpace[0].y() * (float)numSubPixels)),
-			I64Vec2(deCeilFloatToInt32(triangleScreenSpace[1].x() * (float)numSubPixels), deCeilFloatToInt32(triangleScreenSpace[1].y() * (float)numSubPixels)),
-			I64Vec2(deCeilFloatToInt32(triangleScreenSpace[2].x() * (float)numSubPixels), deCeilFloatToInt32(triangleScreenSpace[2].y() * (float)numSubPixels)),
-		};
-		const I64Vec2* const corners = (multisample) ? (pixelCorners) : (pixelCenterCorners);
-
-		// Test if any edge (with any rounding) intersects the pixel (boundary). If it does => Partial. If not => fully inside or outside
+			setupTriangleCoverage(m_setups[triNdx], scene.triangles[triNdx].positions[0], scene.triangles[triNdx].positions[1], scene.triangles[triNdx].positions[2], viewportSize, subpixelBits, multisample);
+			m_aabbs[triNdx] = getTriangleAABB(scene.triangles[triNdx], viewportSize);
+		}
+	}
 
-		for (int edgeNdx = 0; edgeNdx < 3; ++edgeNdx)
-		for (int startRounding = 0; startRounding < 4; ++startRounding)
-		for (int endRounding = 0; endRounding < 4; ++endRounding)
+	void operator() (int, int rowBegin, int rowEnd) const
+	{
+		// \note Triangles are processed in scene order within each row, so the result does not depend on the banding.
+		for (int triNdx = 0; triNdx < (int)m_scene.triangles.size(); ++triNdx)
 		{
-			const int		nextEdgeNdx	= (edgeNdx+1) % 3;
-			const I64Vec2	startPos	((startRounding&0x01)	? (triangleSubPixelSpaceFloor[edgeNdx].x())		: (triangleSubPixelSpaceCeil[edgeNdx].x()),		(startRounding&0x02)	? (triangleSubPixelSpaceFloor[edgeNdx].y())		: (triangleSubPixelSpaceCeil[edgeNdx].y()));
-			const I64Vec2	endPos		((endRounding&0x01)		? (triangleSubPixelSpaceFloor[nextEdgeNdx].x())	: (triangleSubPixelSpaceCeil[nextEdgeNdx].x()),	(endRounding&0x02)		? (triangleSubPixelSpaceFloor[nextEdgeNdx].y())	: (triangleSubPixelSpaceCeil[nextEdgeNdx].y()));
+			const TriangleCoverageSetup&	setup	= m_setups[triNdx];
+			const tcu::IVec4&				aabb	= m_aabbs[triNdx];
+			const int						xBegin	= de::max(0, aabb.x());
+			const int						xEnd	= de::min(aabb.z(), m_viewportSize.x() - 1);
+			const deInt64					stepX[3]=
+			{
+				getEdgeCrossProductStepX(setup, 0),
+				getEdgeCrossProductStepX(setup, 1),
+				getEdgeCrossProductStepX(setup, 2),
+			};
 
-			for (int pixelEdgeNdx = 0; pixelEdgeNdx < 4; ++pixelEdgeNdx)
+			for (int y = de::max(rowBegin, aabb.y()); y <= de::min(aabb.w(), rowEnd - 1); ++y)
 			{
-				const int pixelEdgeEnd = (pixelEdgeNdx + 1) % 4;
+				deUint8* const	row					= &m_coverageMap[y * m_viewportSize.x()];
+				deInt64			crossProducts[3]	=
+				{
+					getEdgeCrossProduct(setup, 0, tcu::IVec2(xBegin, y)),
+					getEdgeCrossProduct(setup, 1, tcu::IVec2(xBegin, y)),
+					getEdgeCrossProduct(setup, 2, tcu::IVec2(xBegin, y)),
+				};
 
-				if (lineLineIntersect(startPos, endPos, corners[pixelEdgeNdx], corners[pixelEdgeEnd]))
-					return COVERAGE_PARTIAL;
+				for (int x = xBegin; x <= xEnd; ++x)
+				{
+					if (row[x] != COVERAGE_FULL && isPixelNearTriangleBounds(setup, tcu::IVec2(x, y)))
+					{
+						CoverageType coverage = classifyBroadTriangleCoverage(setup, crossProducts);
+
+						if (coverage == COVERAGE_PARTIAL)
+							coverage = calculateEdgePixelCoverage(setup, tcu::IVec2(x, y));
+
+						if (coverage == COVERAGE_FULL)
+							row[x] = COVERAGE_FULL;
+						else if (coverage == COVERAGE_PARTIAL)
+							row[x] = (deUint8)getSharedEdgeCoverage(triNdx, tcu::IVec2(x, y));
+					}
+
+					for (int edgeNdx = 0; edgeNdx < 3; ++edgeNdx)
+						crossProducts[edgeNdx] += stepX[edgeNdx];
+				}
 			}
 		}
+	}
 
-		// fully inside or outside
-		for (int edgeNdx = 0; edgeNdx < 3; ++edgeNdx)
+private:
+	//! Coverage of a partially covered pixel, taking shared edges into account.
+	CoverageType getSharedEdgeCoverage (int triNdx, const tcu::IVec2& pixel) const
+	{
+		// Sharing an edge with another triangle?
+		// There should always be such a triangle, but the pixel in the other triangle might be
+		// on multiple edges, some of which are not shared. In these cases the coverage cannot be determined.
+		// Assume full coverage if the pixel is only on a shared edge in shared triangle too.
+		if (pixelOnlyOnASharedEdge(pixel, m_scene.triangles[triNdx], m_viewportSize))
 		{
-			const int		nextEdgeNdx		= (edgeNdx+1) % 3;
-			const I64Vec2&	startPos		= triangleSubPixelSpaceFloor[edgeNdx];
-			const I64Vec2&	endPos			= triangleSubPixelSpaceFloor[nextEdgeNdx];
-			const I64Vec2	edge			= endPos - startPos;
-			const I64Vec2	v				= corners[0] - endPos;
-			const deInt64	crossProduct	= (edge.x() * v.y() - edge.y() * v.x());
-
-			// a corner of the pixel is outside => "fully inside" option is impossible
-			if (crossProduct < 0)
-				return COVERAGE_NONE;
+			for (int friendTriNdx = 0; friendTriNdx < (int)m_scene.triangles.size(); ++friendTriNdx)
+			{
+				if (friendTriNdx != triNdx && pixelOnlyOnASharedEdge(pixel, m_scene.triangles[friendTriNdx], m_viewportSize))
+					return COVERAGE_FULL;
+			}
 		}
 
-		return COVERAGE_FULL;
+		return COVERAGE_PARTIAL;
+	}
+
+	const TriangleSceneSpec&				m_scene;
+	const tcu::IVec2						m_viewportSize;
+	std::vector<TriangleCoverageSetup>		m_setups;
+	std::vector<tcu::IVec4>					m_aabbs;
+	std::vector<deUint8>&					m_coverageMap;
+};
+
+} // anonymous
+
+CoverageType calculateTriangleCoverage (const tcu::Vec4& p0, const tcu::Vec4& p1, const tcu::Vec4& p2, const tcu::IVec2& pixel, const tcu::IVec2& viewportSize, int subpixelBits, bool multisample)
+{
+	TriangleCoverageSetup setup;
+
+	setupTriangleCoverage(setup, p0, p1, p2, viewportSize, subpixelBits, multisample);
+
+	if (!isPixelNearTriangleBounds(setup, pixel))
+		return COVERAGE_NONE;
+
+	{
+		const deInt64		crossProducts[3]	=
+		{
+			getEdgeCrossProduct(setup, 0, pixel),
+			getEdgeCrossProduct(setup, 1, pixel),
+			getEdgeCrossProduct(setup, 2, pixel),
+		};
+		const CoverageType	broadCoverage		= classifyBroadTriangleCoverage(setup, crossProducts);
+
+		if (broadCoverage != COVERAGE_PARTIAL)
+			return broadCoverage;
 	}
+
+	return calculateEdgePixelCoverage(setup, pixel);
 }
 
 static void verifyTriangleGroupRasterizationLog (const tcu::Surface& surface, tcu::TestLog& log, VerifyTriangleGroupRasterizationLogStash& logStash)
@@ -2284,21 +2443,21 @@ bool verifyTriangleGroupRasterization (const tcu::Surface& surface, const Triang
 {
 	DE_ASSERT(mode < VERIFICATIONMODE_LAST);
 
-	const tcu::RGBA		backGroundColor				= tcu::RGBA(0, 0, 0, 255);
-	const tcu::RGBA		triangleColor				= tcu::RGBA(255, 255, 255, 255);
-	const tcu::RGBA		missingPixelColor			= tcu::RGBA(255, 0, 255, 255);
-	const tcu::RGBA		unexpectedPixelColor		= tcu::RGBA(255, 0, 0, 255);
-	const tcu::RGBA		partialPixelColor			= tcu::RGBA(255, 255, 0, 255);
-	const tcu::RGBA		primitivePixelColor			= tcu::RGBA(30, 30, 30, 255);
-	const int			weakVerificationThreshold	= 10;
-	const bool			multisampled				= (args.numSamples != 0);
-	const tcu::IVec2	viewportSize				= tcu::IVec2(surface.getWidth(), surface.getHeight());
-	int					missingPixels				= 0;
-	int					unexpectedPixels			= 0;
-	int					subPixelBits				= args.subpixelBits;
-	tcu::TextureLevel	coverageMap					(tcu::TextureFormat(tcu::TextureFormat::R, tcu::TextureFormat::UNSIGNED_INT8), surface.getWidth(), surface.getHeight());
-	tcu::Surface		errorMask					(surface.getWidth(), surface.getHeight());
-	bool				result						= false;
+	const tcu::RGBA			backGroundColor				= tcu::RGBA(0, 0, 0, 255);
+	const tcu::RGBA			triangleColor				= tcu::RGBA(255, 255, 255, 255);
+	const tcu::RGBA			missingPixelColor			= tcu::RGBA(255, 0, 255, 255);
+	const tcu::RGBA			unexpectedPixelColor		= tcu::RGBA(255, 0, 0, 255);
+	const tcu::RGBA			partialPixelColor			= tcu::RGBA(255, 255, 0, 255);
+	const tcu::RGBA			primitivePixelColor			= tcu::RGBA(30, 30, 30, 255);
+	const int				weakVerificationThreshold	= 10;
+	const bool				multisampled				= (args.numSamples != 0);
+	const tcu::IVec2		viewportSize				= tcu::IVec2(surface.getWidth(), surface.getHeight());
+	int						missingPixels				= 0;
+	int						unexpectedPixels			= 0;
+	int						subPixelBits				= args.subpixelBits;
+	std::vector<deUint8>	coverageMap					(surface.getWidth() * surface.getHeight(), (deUint8)COVERAGE_NONE);
+	tcu::Surface			errorMask					(surface.getWidth(), surface.getHeight());
+	bool					result						= false;
 
 	// subpixel bits in in a valid range?
 
@@ -2316,57 +2475,10 @@ bool verifyTriangleGroupRasterization (const tcu::Surface& surface, const Triang
 
 	// generate coverage map
 
-	tcu::clear(coverageMap.getAccess(), tcu::IVec4(COVERAGE_NONE, 0, 0, 0));
-
-	for (int triNdx = 0; triNdx < (int)scene.triangles.size(); ++triNdx)
 	{
-		const tcu::IVec4 aabb = getTriangleAABB(scene.triangles[triNdx], viewportSize);
-
-		for (int y = de::max(0, aabb.y()); y <= de::min(aabb.w(), coverageMap.getHeight() - 1); ++y)
-		for (int x = de::max(0, aabb.x()); x <= de::min(aabb.z(), coverageMap.getWidth() - 1); ++x)
-		{
-			if (coverageMap.getAccess().getPixelUint(x, y).x() == COVERAGE_FULL)
-				continue;
-
-			const CoverageType coverage = calculateTriangleCoverage(scene.triangles[triNdx].positions[0],
-																	scene.triangles[triNdx].positions[1],
-																	scene.triangles[triNdx].positions[2],
-																	tcu::IVec2(x, y),
-																	viewportSize,
-																	subPixelBits,
-																	multisampled);
-
-			if (coverage == COVERAGE_FULL)
-			{
-				coverageMap.getAccess().setPixel(tcu::IVec4(COVERAGE_FULL, 0, 0, 0), x, y);
-			}
-			else if (coverage == COVERAGE_PARTIAL)
-			{
-				CoverageType resultCoverage = COVERAGE_PARTIAL;
+		const TriangleCoverageBands bands (scene, viewportSize, subPixelBits, multisampled, coverageMap);
 
-				// Sharing an edge with another triangle?
-				// There should always be such a triangle, but the pixel in the other triangle might be
-				// on multiple edges, some of which are not shared. In these cases the coverage cannot be determined.
-				// Assume full coverage if the pixel is only on a shared edge in shared triangle too.
-				if (pixelOnlyOnASharedEdge(tcu::IVec2(x, y), scene.triangles[triNdx], viewportSize))
-				{
-					bool friendFound = false;
-					for (int friendTriNdx = 0; friendTriNdx < (int)scene.triangles.size(); ++friendTriNdx)
-					{
-						if (friendTriNdx != triNdx && pixelOnlyOnASharedEdge(tcu::IVec2(x, y), scene.triangles[friendTriNdx], viewportSize))
-						{
-							friendFound = true;
-							break;
-						}
-					}
-
-					if (friendFound)
-						resultCoverage = COVERAGE_FULL;
-				}
-
-				coverageMap.getAccess().setPixel(tcu::IVec4(resultCoverage, 0, 0, 0), x, y);
-			}
-		}
+		tcu::executeBatches(viewportSize.y(), TRIANGLE_COVERAGE_BAND_HEIGHT, bands, DE_NULL);
 	}
 
 	// check pixels
@@ -2379,7 +2491,7 @@ bool verifyTriangleGroupRasterization (const tcu::Surface& surface, const Triang
 		const tcu::RGBA		color				= surface.getPixel(x, y);
 		const bool			imageNoCoverage		= compareColors(color, backGroundColor, args.redBits, args.greenBits, args.blueBits);
 		const bool			imageFullCoverage	= compareColors(color, triangleColor, args.redBits, args.greenBits, args.blueBits);
-		CoverageType		referenceCoverage	= (CoverageType)coverageMap.getAccess().getPixelUint(x, y).x();
+		CoverageType		referenceCoverage	= (CoverageType)coverageMap[y * surface.getWidth() + x];
 
 		switch (referenceCoverage)
 		{
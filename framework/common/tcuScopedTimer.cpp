@@ -0,0 +1,109 @@
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Tester Core
+ * ----------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Scoped timing markers for per-test-case profiling.
+ *//*--------------------------------------------------------------------*/
+
+#include "tcuScopedTimer.hpp"
+#include "tcuTestLog.hpp"
+#include "deMutex.hpp"
+#include "deClock.h"
+
+#include <map>
+#include <cstring>
+
+namespace tcu
+{
+
+namespace
+{
+
+struct ScopeTiming
+{
+	int			count;
+	deUint64	durationUs;
+
+	ScopeTiming (void) : count(0), durationUs(0) {}
+};
+
+struct NameLess
+{
+	bool operator() (const char* a, const char* b) const { return std::strcmp(a, b) < 0; }
+};
+
+// \note Keyed by name contents, as equal literals in different modules may have different addresses.
+typedef std::map<const char*, ScopeTiming, NameLess> TimingMap;
+
+volatile bool	s_timingEnabled	= false;
+de::Mutex		s_timingLock;
+TimingMap		s_timings;
+
+} // anonymous
+
+ScopedTimer::ScopedTimer (const char* name)
+	: m_name		(name)
+	, m_startTime	(s_timingEnabled ? deGetMicroseconds() : 0)
+{
+	DE_ASSERT(name);
+}
+
+ScopedTimer::~ScopedTimer (void)
+{
+	if (m_startTime != 0)
+	{
+		const deUint64			duration	= deGetMicroseconds() - m_startTime;
+		const de::ScopedLock	lock		(s_timingLock);
+		ScopeTiming&			timing		= s_timings[m_name];
+
+		timing.count		+= 1;
+		timing.durationUs	+= duration;
+	}
+}
+
+void setScopedTimingEnabled (bool enabled)
+{
+	s_timingEnabled = enabled;
+}
+
+bool isScopedTimingEnabled (void)
+{
+	return s_timingEnabled;
+}
+
+void resetScopedTimings (void)
+{
+	const de::ScopedLock lock (s_timingLock);
+	s_timings.clear();
+}
+
+void logScopedTimings (TestLog& log)
+{
+	TimingMap timings;
+
+	{
+		const de::ScopedLock lock (s_timingLock);
+		timings.swap(s_timings);
+	}
+
+	for (TimingMap::const_iterator iter = timings.begin(); iter != timings.end(); ++iter)
+		log.writeTiming(iter->first, iter->second.count, (deInt64)iter->second.durationUs);
+}
+
+} // tcu
@@ -0,0 +1,76 @@
+#ifndef _TCUSCOPEDTIMER_HPP
+#define _TCUSCOPEDTIMER_HPP
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Tester Core
+ * ----------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Scoped timing markers for per-test-case profiling.
+ *//*--------------------------------------------------------------------*/
+
+#include "tcuDefs.hpp"
+
+namespace tcu
+{
+
+class TestLog;
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Accumulate time spent in a scope to the current case's profile
+ *
+ * Time and entry count are accumulated per scope name, and written to
+ * the log as <Timing> elements when the test case ends. Timers are
+ * thread-safe; nested scopes report inclusive times.
+ *
+ * Timing is disabled by default (--deqp-log-timing), in which case
+ * constructing a timer only checks a flag.
+ *
+ * \code
+ * {
+ *     const tcu::ScopedTimer timer ("rr::Renderer::draw");
+ *     ...
+ * }
+ * \endcode
+ *//*--------------------------------------------------------------------*/
+class ScopedTimer
+{
+public:
+	//! Name must be a string with static storage duration
+	explicit		ScopedTimer		(const char* name);
+					~ScopedTimer	(void);
+
+private:
+					ScopedTimer		(const ScopedTimer&);
+	ScopedTimer&	operator=		(const ScopedTimer&);
+
+	const char*		m_name;
+	deUint64		m_startTime;
+};
+
+void	setScopedTimingEnabled		(bool enabled);
+bool	isScopedTimingEnabled		(void);
+
+//! Discard accumulated timings
+void	resetScopedTimings			(void);
+
+//! Write accumulated timings to log and reset them
+void	logScopedTimings			(TestLog& log);
+
+} // tcu
+
+#endif // _TCUSCOPEDTIMER_HPP
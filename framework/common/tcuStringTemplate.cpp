@@ -24,15 +24,56 @@
 #include "tcuStringTemplate.hpp"
 #include "tcuDefs.hpp"
 
-#include <sstream>
-
 using std::string;
 using std::map;
-using std::ostringstream;
+using std::vector;
 
 namespace tcu
 {
 
+namespace
+{
+
+class MapLookup
+{
+public:
+	MapLookup (const map<string, string>& params, const vector<string>& names)
+		: m_params	(params)
+		, m_names	(names)
+	{
+	}
+
+	const string* operator() (int paramNdx) const
+	{
+		const map<string, string>::const_iterator iter = m_params.find(m_names[paramNdx]);
+
+		return iter != m_params.end() ? &iter->second : DE_NULL;
+	}
+
+private:
+	const map<string, string>&	m_params;
+	const vector<string>&		m_names;
+};
+
+class IndexLookup
+{
+public:
+	IndexLookup (const vector<string>& values)
+		: m_values	(values)
+	{
+	}
+
+	const string* operator() (int paramNdx) const
+	{
+		return &m_values[paramNdx];
+	}
+
+private:
+	const vector<string>&		m_values;
+};
+
+} // anonymous
+
 StringTemplate::StringTemplate (void)
 {
 }
@@ -49,82 +90,237 @@ StringTemplate::~StringTemplate (void)
 void StringTemplate::setString (const std::string& str)
 {
 	m_template = str;
-}
-
-string StringTemplate::specialize (const map<string, string>& params) const
-{
-	ostringstream res;
+	m_segments.clear();
+	m_paramNames.clear();
+	m_error.clear();
 
 	size_t curNdx = 0;
 	for (;;)
 	{
-		size_t paramNdx = m_template.find("${", curNdx);
-		if (paramNdx != string::npos)
+		const size_t	paramNdx	= m_template.find("${", curNdx);
+		Segment			segment;
+
+		segment.type		= SEGMENTTYPE_LITERAL;
+		segment.start		= curNdx;
+		segment.length		= (paramNdx != string::npos ? paramNdx : m_template.length()) - curNdx;
+		segment.paramNdx	= -1;
+		segment.singleLine	= false;
+		segment.optional	= false;
+
+		// Append in-between stuff.
+		if (segment.length > 0)
+			m_segments.push_back(segment);
+
+		if (paramNdx == string::npos)
+			break;
+
+		// Find end-of-param.
+		const size_t paramEndNdx = m_template.find('}', paramNdx);
+		if (paramEndNdx == string::npos)
 		{
-			// Append in-between stuff.
-			res << m_template.substr(curNdx, paramNdx - curNdx);
-
-			// Find end-of-param.
-			size_t paramEndNdx = m_template.find("}", paramNdx);
-			if (paramEndNdx == string::npos)
-				TCU_THROW(InternalError, "No '}' found in template parameter");
-
-			// Parse parameter contents.
-			string	paramStr		= m_template.substr(paramNdx+2, paramEndNdx-2-paramNdx);
-			bool	paramSingleLine	= false;
-			bool	paramOptional	= false;
-			string	paramName;
-			size_t colonNdx = paramStr.find(":");
-			if (colonNdx != string::npos)
+			m_error			= "No '}' found in template parameter";
+			segment.type	= SEGMENTTYPE_ERROR;
+			m_segments.push_back(segment);
+			break;
+		}
+
+		// Parse parameter contents.
+		const size_t	nameNdx		= paramNdx + 2;
+		const size_t	colonNdx	= m_template.find(':', nameNdx);
+		size_t			nameLength	= paramEndNdx - nameNdx;
+
+		if (colonNdx < paramEndNdx)
+		{
+			const size_t flagsNdx		= colonNdx + 1;
+			const size_t flagsLength	= paramEndNdx - flagsNdx;
+
+			nameLength = colonNdx - nameNdx;
+
+			if (m_template.compare(flagsNdx, flagsLength, "single-line") == 0)
+				segment.singleLine = true;
+			else if (m_template.compare(flagsNdx, flagsLength, "opt") == 0)
+				segment.optional = true;
+			else
 			{
-				paramName = paramStr.substr(0, colonNdx);
-				string flagsStr = paramStr.substr(colonNdx+1);
-				if (flagsStr == "single-line")
-				{
-					paramSingleLine = true;
-				}
-				else if (flagsStr == "opt")
-				{
-					paramOptional = true;
-				}
-				else
-				{
-					TCU_THROW(InternalError, (string("Unrecognized flag") + paramStr).c_str());
-				}
+				m_error			= string("Unrecognized flag") + m_template.substr(nameNdx, paramEndNdx - nameNdx);
+				segment.type	= SEGMENTTYPE_ERROR;
+				m_segments.push_back(segment);
+				break;
 			}
-			else
-				paramName = paramStr;
+		}
+
+		{
+			const string name = m_template.substr(nameNdx, nameLength);
+
+			segment.type		= SEGMENTTYPE_PARAM;
+			segment.paramNdx	= findParam(name);
 
-			// Fill in parameter value.
-			if (params.find(paramName) != params.end())
+			if (segment.paramNdx < 0)
 			{
-				const string& val = (*params.find(paramName)).second;
-				if (paramSingleLine)
-				{
-					string tmp = val;
-					for (size_t ndx = tmp.find("\n"); ndx != string::npos; ndx = tmp.find("\n"))
-						tmp = tmp.replace(ndx, 1, " ");
-					res << tmp;
-				}
-				else
-					res << val;
+				segment.paramNdx = (int)m_paramNames.size();
+				m_paramNames.push_back(name);
 			}
-			else if (!paramOptional)
-				TCU_THROW(InternalError, (string("Value for parameter '") + paramName + "' not found in map").c_str());
 
-			// Skip over template.
-			curNdx = paramEndNdx + 1;
+			m_segments.push_back(segment);
+		}
+
+		// Skip over template.
+		curNdx = paramEndNdx + 1;
+	}
+}
+
+int StringTemplate::findParam (const std::string& name) const
+{
+	for (size_t ndx = 0; ndx < m_paramNames.size(); ndx++)
+	{
+		if (m_paramNames[ndx] == name)
+			return (int)ndx;
+	}
+
+	return -1;
+}
+
+template<typename Lookup>
+void StringTemplate::specializeImpl (const Lookup& lookup, string& dst) const
+{
+	size_t resultLength = 0;
+
+	// Validate parameters and compute result length first so that result is only allocated once.
+	for (vector<Segment>::const_iterator segment = m_segments.begin(); segment != m_segments.end(); ++segment)
+	{
+		if (segment->type == SEGMENTTYPE_LITERAL)
+			resultLength += segment->length;
+		else if (segment->type == SEGMENTTYPE_PARAM)
+		{
+			const string* const value = lookup(segment->paramNdx);
+
+			if (value)
+				resultLength += value->length();
+			else if (!segment->optional)
+				TCU_THROW(InternalError, (string("Value for parameter '") + m_paramNames[segment->paramNdx] + "' not found in map").c_str());
 		}
 		else
 		{
-			if (curNdx < m_template.length())
-				res << &m_template[curNdx];
+			DE_ASSERT(segment->type == SEGMENTTYPE_ERROR);
+			TCU_THROW(InternalError, m_error.c_str());
+		}
+	}
 
-			break;
+	dst.clear();
+	dst.reserve(resultLength);
+
+	for (vector<Segment>::const_iterator segment = m_segments.begin(); segment != m_segments.end(); ++segment)
+	{
+		if (segment->type == SEGMENTTYPE_LITERAL)
+			dst.append(m_template, segment->start, segment->length);
+		else
+		{
+			const string* const value = lookup(segment->paramNdx);
+
+			if (!value)
+				continue;
+
+			if (segment->singleLine)
+			{
+				for (string::const_iterator ch = value->begin(); ch != value->end(); ++ch)
+					dst.push_back(*ch == '\n' ? ' ' : *ch);
+			}
+			else
+				dst.append(*value);
 		}
 	}
+}
+
+string StringTemplate::specialize (const map<string, string>& params) const
+{
+	string res;
+	specialize(params, res);
+	return res;
+}
+
+void StringTemplate::specialize (const map<string, string>& params, string& dst) const
+{
+	specializeImpl(MapLookup(params, m_paramNames), dst);
+}
+
+string StringTemplate::specialize (const vector<string>& values) const
+{
+	string res;
+	specialize(values, res);
+	return res;
+}
+
+void StringTemplate::specialize (const vector<string>& values, string& dst) const
+{
+	if (values.size() != m_paramNames.size())
+		TCU_THROW(InternalError, "Number of values doesn't match number of template parameters");
+
+	specializeImpl(IndexLookup(values), dst);
+}
 
-	return res.str();
+void StringTemplate_selfTest (void)
+{
+	// Named parameters and flags
+	{
+		const StringTemplate	tmpl	("a${x}b${y:opt}c${z:single-line}${x}");
+		map<string, string>		params;
+
+		params["x"] = "1";
+		params["z"] = "2\n3";
+
+		TCU_CHECK(tmpl.getNumParams() == 3);
+		TCU_CHECK(tmpl.findParam("z") == 2);
+		TCU_CHECK(tmpl.findParam("w") == -1);
+		TCU_CHECK(tmpl.specialize(params) == "a1bc2 31");
+
+		params["y"] = "4";
+
+		TCU_CHECK(tmpl.specialize(params) == "a1b4c2 31");
+	}
+
+	// Index-based parameters
+	{
+		const StringTemplate	tmpl	("${a} + ${b} = ${a}${b}");
+		vector<string>			values	(2);
+		string					result;
+
+		values[tmpl.findParam("a")] = "x";
+		values[tmpl.findParam("b")] = "y";
+
+		tmpl.specialize(values, result);
+		TCU_CHECK(result == "x + y = xy");
+	}
+
+	// Templates without parameters
+	{
+		TCU_CHECK(StringTemplate("").specialize(map<string, string>()) == "");
+		TCU_CHECK(StringTemplate("abc").specialize(map<string, string>()) == "abc");
+	}
+
+	// Errors are reported when specialized
+	{
+		const char* const	invalidTemplates[]	= { "${x", "${x:foo}", "${y}" };
+		map<string, string>	params;
+
+		params["x"] = "1";
+
+		for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(invalidTemplates); ndx++)
+		{
+			const StringTemplate	tmpl	(invalidTemplates[ndx]);
+			bool					thrown	= false;
+
+			try
+			{
+				tmpl.specialize(params);
+			}
+			catch (const InternalError&)
+			{
+				thrown = true;
+			}
+
+			TCU_CHECK(thrown);
+		}
+	}
 }
 
 } // tcu
@@ -23,30 +23,84 @@
  * \brief String template class.
  *//*--------------------------------------------------------------------*/
 
+#include "tcuDefs.hpp"
+
 #include <map>
 #include <string>
+#include <vector>
 
 namespace tcu
 {
 
+/*--------------------------------------------------------------------*//*!
+ * \brief String template with ${name} style parameters
+ *
+ * Parameters may have a flag: ${name:opt} is replaced with nothing if no
+ * value is given and ${name:single-line} replaces newlines in value with
+ * spaces. Template is parsed once by setString() and can be specialized
+ * any number of times.
+ *
+ * Parameters can also be bound by index instead of by name. Each unique
+ * parameter name gets an index in order of first appearance.
+ *//*--------------------------------------------------------------------*/
 class StringTemplate
 {
 public:
-						StringTemplate		(void);
-						StringTemplate		(const std::string& str);
-						~StringTemplate		(void);
+								StringTemplate		(void);
+								StringTemplate		(const std::string& str);
+								~StringTemplate		(void);
+
+	void						setString			(const std::string& str);
+
+	std::string					specialize			(const std::map<std::string, std::string>& params) const;
+
+	//! Specialize into dst. Storage of dst is reused so repeated specializations don't need to allocate.
+	void						specialize			(const std::map<std::string, std::string>& params, std::string& dst) const;
 
-	void				setString			(const std::string& str);
+	int							getNumParams		(void) const		{ return (int)m_paramNames.size();	}
+	const std::string&			getParamName		(int ndx) const		{ return m_paramNames[ndx];			}
 
-	std::string			specialize			(const std::map<std::string, std::string>& params) const;
+	//! Get index of parameter, or -1 if template has no such parameter.
+	int							findParam			(const std::string& name) const;
+
+	//! Specialize with one value per parameter index.
+	std::string					specialize			(const std::vector<std::string>& values) const;
+	void						specialize			(const std::vector<std::string>& values, std::string& dst) const;
 
 private:
-						StringTemplate		(const StringTemplate&);		// not allowed!
-	StringTemplate&		operator=			(const StringTemplate&);		// not allowed!
+								StringTemplate		(const StringTemplate&);		// not allowed!
+	StringTemplate&				operator=			(const StringTemplate&);		// not allowed!
+
+	enum SegmentType
+	{
+		SEGMENTTYPE_LITERAL = 0,
+		SEGMENTTYPE_PARAM,
+		SEGMENTTYPE_ERROR,		//!< Malformed parameter, reported when specialized.
+
+		SEGMENTTYPE_LAST
+	};
 
-	std::string			m_template;
+	struct Segment
+	{
+		SegmentType				type;
+		size_t					start;			//!< Literal start in template
+		size_t					length;
+		int						paramNdx;
+		bool					singleLine;
+		bool					optional;
+	};
+
+	template<typename Lookup>
+	void						specializeImpl		(const Lookup& lookup, std::string& dst) const;
+
+	std::string					m_template;
+	std::vector<Segment>		m_segments;
+	std::vector<std::string>	m_paramNames;
+	std::string					m_error;
 } DE_WARN_UNUSED_TYPE;
 
+void StringTemplate_selfTest (void);
+
 } // tcu
 
 #endif // _TCUSTRINGTEMPLATE_HPP
@@ -23,6 +23,7 @@
 
 #include "tcuTestCase.hpp"
 #include "tcuPlatform.hpp"
+#include "tcuCommandLine.hpp"
 
 #include "deString.h"
 
@@ -72,7 +73,28 @@ void TestNode::getChildren (vector<TestNode*>& res)
 {
 	res.clear();
 	for (int i = 0; i < (int)m_children.size(); i++)
-		res.push_back(m_children[i]);
+	{
+		// Skip lazy children that have not been created.
+		if (m_children[i])
+			res.push_back(m_children[i]);
+	}
+}
+
+bool TestNode::hasChild (const char* name) const
+{
+	for (int i = 0; i < (int)m_children.size(); i++)
+	{
+		if (m_children[i] && deStringEqual(name, m_children[i]->getName()))
+			return true;
+	}
+
+	for (int i = 0; i < (int)m_lazyChildren.size(); i++)
+	{
+		if (!m_children[m_lazyChildren[i].childNdx] && m_lazyChildren[i].name == name)
+			return true;
+	}
+
+	return false;
 }
 
 void TestNode::addChild (TestNode* node)
@@ -80,23 +102,66 @@ void TestNode::addChild (TestNode* node)
 	// Child names must be unique!
 	// \todo [petri] O(n^2) algorithm, but shouldn't really matter..
 #if defined(DE_DEBUG)
-	for (int i = 0; i < (int)m_children.size(); i++)
-	{
-		if (deStringEqual(node->getName(), m_children[i]->getName()))
-			throw tcu::InternalError(std::string("Test case with non-unique name '") + node->getName() + "' added to group '" + getName() + "'.");
-	}
+	if (hasChild(node->getName()))
+		throw tcu::InternalError(std::string("Test case with non-unique name '") + node->getName() + "' added to group '" + getName() + "'.");
 #endif
 
 	// children only in group nodes
 	DE_ASSERT(getTestNodeTypeClass(m_nodeType) == NODECLASS_GROUP);
 
 	// children must have the same class
-	if (!m_children.empty())
-		DE_ASSERT(getTestNodeTypeClass(m_children.front()->getNodeType()) == getTestNodeTypeClass(node->getNodeType()));
+	for (int i = 0; i < (int)m_children.size(); i++)
+	{
+		if (m_children[i])
+		{
+			DE_ASSERT(getTestNodeTypeClass(m_children[i]->getNodeType()) == getTestNodeTypeClass(node->getNodeType()));
+			break;
+		}
+	}
 
 	m_children.push_back(node);
 }
 
+void TestNode::addLazyChild (const char* name, CreateGroupFunc createGroup)
+{
+	DE_ASSERT(isValidCaseName(name));
+	DE_ASSERT(getTestNodeTypeClass(m_nodeType) == NODECLASS_GROUP);
+
+#if defined(DE_DEBUG)
+	if (hasChild(name))
+		throw tcu::InternalError(std::string("Test case with non-unique name '") + name + "' added to group '" + getName() + "'.");
+#endif
+
+	m_lazyChildren.push_back(LazyChild(m_children.size(), name, createGroup));
+	m_children.push_back(DE_NULL);
+}
+
+void TestNode::createLazyChildren (const std::string& nodePath, const CaseListFilter& caseListFilter)
+{
+	for (int i = 0; i < (int)m_lazyChildren.size(); i++)
+	{
+		const LazyChild&	lazyChild	= m_lazyChildren[i];
+		const std::string	childPath	= nodePath.empty() ? lazyChild.name : nodePath + "." + lazyChild.name;
+
+		if (m_children[lazyChild.childNdx] || !caseListFilter.checkTestGroupName(childPath.c_str()))
+			continue;
+
+		{
+			TestCaseGroup* const child = lazyChild.createGroup(m_testCtx);
+
+			if (lazyChild.name != child->getName())
+			{
+				const std::string childName = child->getName();
+
+				delete child;
+				throw tcu::InternalError("Lazy child '" + lazyChild.name + "' of group '" + getName() + "' created with name '" + childName + "'.");
+			}
+
+			m_children[lazyChild.childNdx] = child;
+		}
+	}
+}
+
 void TestNode::init (void)
 {
 }
@@ -106,6 +171,7 @@ void TestNode::deinit (void)
 	for (int i = 0; i < (int)m_children.size(); i++)
 		delete m_children[i];
 	m_children.clear();
+	m_lazyChildren.clear();
 }
 
 // TestCaseGroup
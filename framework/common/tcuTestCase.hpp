@@ -32,6 +32,9 @@
 namespace tcu
 {
 
+class TestCaseGroup;
+class CaseListFilter;
+
 enum TestNodeType
 {
 	NODETYPE_ROOT = 0,		//!< Root for all test packages.
@@ -93,6 +96,12 @@ inline bool isValidTestCaseNameChar (char c)
  * During test execution TestExecutor iterates the hierarchy. Upon entering
  * the node (both groups and test cases) init() is called. When exiting the
  * node deinit() is called respectively.
+ *
+ * Child groups can also be added lazily with addLazyChild(), in which case
+ * only the name and a creation function are stored. The hierarchy inflater
+ * creates lazy children with createLazyChildren() after init(), and skips
+ * the ones that can't match the case list filter in use. This avoids
+ * constructing large sub-trees when only a few cases are run.
  *//*--------------------------------------------------------------------*/
 class TestNode
 {
@@ -103,6 +112,8 @@ public:
 		CONTINUE	= 1
 	};
 
+	typedef TestCaseGroup*	(*CreateGroupFunc)	(TestContext& testCtx);
+
 	// Methods.
 							TestNode		(TestContext& testCtx, TestNodeType nodeType, const char* name, const char* description);
 							TestNode		(TestContext& testCtx, TestNodeType nodeType, const char* name, const char* description, const std::vector<TestNode*>& children);
@@ -114,6 +125,8 @@ public:
 	const char*				getDescription	(void) const	{ return m_description.c_str(); }
 	void					getChildren		(std::vector<TestNode*>& children);
 	void					addChild		(TestNode* node);
+	void					addLazyChild	(const char* name, CreateGroupFunc createGroup);
+	void					createLazyChildren	(const std::string& nodePath, const CaseListFilter& caseListFilter);
 
 	virtual void			init			(void);
 	virtual void			deinit			(void);
@@ -125,8 +138,20 @@ protected:
 	std::string				m_description;
 
 private:
+	struct LazyChild
+	{
+		size_t				childNdx;		//!< Slot in m_children, DE_NULL until created.
+		std::string			name;
+		CreateGroupFunc		createGroup;
+
+		LazyChild (size_t childNdx_, const std::string& name_, CreateGroupFunc createGroup_) : childNdx(childNdx_), name(name_), createGroup(createGroup_) {}
+	};
+
+	bool					hasChild		(const char* name) const;
+
 	const TestNodeType		m_nodeType;
 	std::vector<TestNode*>	m_children;
+	std::vector<LazyChild>	m_lazyChildren;
 };
 
 /*--------------------------------------------------------------------*//*!
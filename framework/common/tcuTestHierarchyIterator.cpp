@@ -51,7 +51,7 @@ DefaultHierarchyInflater::~DefaultHierarchyInflater (void)
 {
 }
 
-void DefaultHierarchyInflater::enterTestPackage (TestPackage* testPackage, vector<TestNode*>& children)
+void DefaultHierarchyInflater::enterTestPackage (TestPackage* testPackage, const string& nodePath, const CaseListFilter& caseListFilter, vector<TestNode*>& children)
 {
 	{
 		Archive* const	pkgArchive	= testPackage->getArchive();
@@ -63,6 +63,7 @@ void DefaultHierarchyInflater::enterTestPackage (TestPackage* testPackage, vecto
 	}
 
 	testPackage->init();
+	testPackage->createLazyChildren(nodePath, caseListFilter);
 	testPackage->getChildren(children);
 }
 
@@ -72,9 +73,10 @@ void DefaultHierarchyInflater::leaveTestPackage (TestPackage* testPackage)
 	testPackage->deinit();
 }
 
-void DefaultHierarchyInflater::enterGroupNode (TestCaseGroup* testGroup, vector<TestNode*>& children)
+void DefaultHierarchyInflater::enterGroupNode (TestCaseGroup* testGroup, const string& nodePath, const CaseListFilter& caseListFilter, vector<TestNode*>& children)
 {
 	testGroup->init();
+	testGroup->createLazyChildren(nodePath, caseListFilter);
 	testGroup->getChildren(children);
 }
 
@@ -198,8 +200,8 @@ void TestHierarchyIterator::next (void)
 					switch (node->getNodeType())
 					{
 						case NODETYPE_ROOT:		static_cast<TestPackageRoot*>(node)->getChildren(iter.children);				break;
-						case NODETYPE_PACKAGE:	m_inflater.enterTestPackage(static_cast<TestPackage*>(node), iter.children);	break;
-						case NODETYPE_GROUP:	m_inflater.enterGroupNode(static_cast<TestCaseGroup*>(node), iter.children);	break;
+						case NODETYPE_PACKAGE:	m_inflater.enterTestPackage(static_cast<TestPackage*>(node), m_nodePath, m_caseListFilter, iter.children);	break;
+						case NODETYPE_GROUP:	m_inflater.enterGroupNode(static_cast<TestCaseGroup*>(node), m_nodePath, m_caseListFilter, iter.children);	break;
 						default:
 							DE_ASSERT(false);
 					}
@@ -256,4 +258,28 @@ void TestHierarchyIterator::next (void)
 	DE_ASSERT(m_sessionStack.empty() && getState() == STATE_FINISHED);
 }
 
+void TestHierarchyIterator::getUpcomingCases (int maxCases, vector<TestCase*>& cases, vector<string>& casePaths) const
+{
+	DE_ASSERT(getState() != STATE_FINISHED && m_sessionStack.size() >= 2);
+
+	const NodeIter&		parent		= m_sessionStack[m_sessionStack.size()-2];
+	const string		parentPath	= m_nodePath.substr(0, m_nodePath.rfind('.'));
+	int					numAdded	= 0;
+
+	DE_ASSERT(parent.getState() == NodeIter::STATE_TRAVERSE_CHILDREN);
+
+	for (int childNdx = parent.curChildNdx+1; childNdx < (int)parent.children.size() && numAdded < maxCases; childNdx++)
+	{
+		TestNode* const	childNode	= parent.children[childNdx];
+		const string	childPath	= parentPath + "." + childNode->getName();
+
+		if (isTestNodeTypeExecutable(childNode->getNodeType()) && m_caseListFilter.checkTestCaseName(childPath.c_str()))
+		{
+			cases.push_back(static_cast<TestCase*>(childNode));
+			casePaths.push_back(childPath);
+			numAdded += 1;
+		}
+	}
+}
+
 } // tcu
@@ -40,16 +40,20 @@ class CaseListFilter;
  *
  * This interface is used by TestHierarchyIterator to materialize, and clean
  * up, test hierarchy on-demand while walking through it.
+ *
+ * Node path and case list filter are passed to enter functions so that
+ * inflater can skip creating lazy child nodes (see TestNode::addLazyChild())
+ * that won't be visited.
  *//*--------------------------------------------------------------------*/
 class TestHierarchyInflater
 {
 public:
 									TestHierarchyInflater	(void);
 
-	virtual void					enterTestPackage		(TestPackage* testPackage, std::vector<TestNode*>& children) = 0;
+	virtual void					enterTestPackage		(TestPackage* testPackage, const std::string& nodePath, const CaseListFilter& caseListFilter, std::vector<TestNode*>& children) = 0;
 	virtual void					leaveTestPackage		(TestPackage* testPackage) = 0;
 
-	virtual void					enterGroupNode			(TestCaseGroup* testGroup, std::vector<TestNode*>& children) = 0;
+	virtual void					enterGroupNode			(TestCaseGroup* testGroup, const std::string& nodePath, const CaseListFilter& caseListFilter, std::vector<TestNode*>& children) = 0;
 	virtual void					leaveGroupNode			(TestCaseGroup* testGroup) = 0;
 
 protected:
@@ -63,10 +67,10 @@ public:
 									DefaultHierarchyInflater	(TestContext& testCtx);
 									~DefaultHierarchyInflater	(void);
 
-	virtual void					enterTestPackage			(TestPackage* testPackage, std::vector<TestNode*>& children);
+	virtual void					enterTestPackage			(TestPackage* testPackage, const std::string& nodePath, const CaseListFilter& caseListFilter, std::vector<TestNode*>& children);
 	virtual void					leaveTestPackage			(TestPackage* testPackage);
 
-	virtual void					enterGroupNode				(TestCaseGroup* testGroup, std::vector<TestNode*>& children);
+	virtual void					enterGroupNode				(TestCaseGroup* testGroup, const std::string& nodePath, const CaseListFilter& caseListFilter, std::vector<TestNode*>& children);
 	virtual void					leaveGroupNode				(TestCaseGroup* testGroup);
 
 protected:
@@ -100,6 +104,7 @@ protected:
  * Test hierarchy is created on demand with help of TestHierarchyInflater.
  * Upon entering a group node, after STATE_ENTER_NODE has been signaled,
  * inflater is called to construct the list of child nodes for that group.
+ * Lazy child nodes that don't match the case list filter are never created.
  * Upon exiting a group node, before STATE_LEAVE_NODE is called, inflater
  * is asked to clean up any resources by calling leaveGroupNode() or
  * leaveTestPackage() depending on the type of the node.
@@ -126,6 +131,11 @@ public:
 
 	void					next					(void);
 
+	//! Append up to maxCases test cases that will be entered after the current one.
+	//! Only remaining siblings of the current case are considered, as other
+	//! nodes may not have been inflated yet.
+	void					getUpcomingCases		(int maxCases, std::vector<TestCase*>& cases, std::vector<std::string>& casePaths) const;
+
 private:
 	struct NodeIter
 	{
@@ -24,6 +24,7 @@
 #include "tcuTestLog.hpp"
 #include "tcuTextureUtil.hpp"
 #include "tcuSurface.hpp"
+#include "tcuScopedTimer.hpp"
 #include "deMath.h"
 
 #include <limits>
@@ -40,7 +41,8 @@ public:
 enum
 {
 	MAX_IMAGE_SIZE_2D		= 4096,
-	MAX_IMAGE_SIZE_3D		= 128
+	MAX_IMAGE_SIZE_3D		= 128,
+	MIN_BUDGET_IMAGE_SIZE	= 16	//!< Images that would have to be downsampled below this size to fit into budget are omitted
 };
 
 // LogImage
@@ -181,7 +183,12 @@ TestLog& SampleBuilder::operator<< (const TestLog::EndSampleToken&)
 // TestLog
 
 TestLog::TestLog (const char* fileName, deUint32 flags)
-	: m_log(qpTestLog_createFileLog(fileName, flags))
+	: m_log					(qpTestLog_createFileLog(fileName, flags))
+	, m_caseImageBudget		(0)
+	, m_sessionImageBudget	(0)
+	, m_caseImageBytes		(0)
+	, m_sessionImageBytes	(0)
+	, m_numOmittedImages	(0)
 {
 	if (!m_log)
 		throw ResourceError(std::string("Failed to open test log file '") + fileName + "'");
@@ -247,8 +254,18 @@ void TestLog::writeImage (const char* name, const char* description, const Const
 	if ((qpTestLog_getLogFlags(m_log) & QP_TEST_LOG_EXCLUDE_IMAGES) != 0)
 		return;
 
+	// Downsample further if image would not fit into the remaining budget.
+	const size_t			budget		= getRemainingImageBudget();
+	const int				budgetSize	= (int)de::min<size_t>(MAX_IMAGE_SIZE_2D, (size_t)deFloatSqrt((float)(budget / 4)));
+
+	if (depth == 1 && budgetSize < de::min(de::max(width, height), (int)MIN_BUDGET_IMAGE_SIZE))
+	{
+		m_numOmittedImages += 1;
+		return;
+	}
+
 	if (depth == 1 && format.type == TextureFormat::UNORM_INT8
-		&& width <= MAX_IMAGE_SIZE_2D && height <= MAX_IMAGE_SIZE_2D
+		&& width <= budgetSize && height <= budgetSize
 		&& (format.order == TextureFormat::RGB || format.order == TextureFormat::RGBA)
 		&& access.getPixelPitch() == access.getFormat().getPixelSize()
 		&& pixelBias[0] == 0.0f && pixelBias[1] == 0.0f && pixelBias[2] == 0.0f && pixelBias[3] == 0.0f
@@ -264,13 +281,16 @@ void TestLog::writeImage (const char* name, const char* description, const Const
 	else if (depth == 1)
 	{
 		Sampler				sampler			(Sampler::CLAMP_TO_EDGE, Sampler::CLAMP_TO_EDGE, Sampler::CLAMP_TO_EDGE, Sampler::LINEAR, Sampler::NEAREST);
-		IVec2				logImageSize	= computeScaledSize(IVec2(width, height), MAX_IMAGE_SIZE_2D);
+		IVec2				logImageSize	= computeScaledSize(IVec2(width, height), budgetSize);
 		tcu::TextureLevel	logImage		(TextureFormat(TextureFormat::RGBA, TextureFormat::UNORM_INT8), logImageSize.x(), logImageSize.y(), 1);
 		PixelBufferAccess	logImageAccess	= logImage.getAccess();
 		std::ostringstream	longDesc;
 
 		longDesc << description << " (p' = p * " << pixelScale << " + " << pixelBias << ")";
 
+		if (logImageSize != computeScaledSize(IVec2(width, height), MAX_IMAGE_SIZE_2D))
+			longDesc << " (downsampled to fit log image budget)";
+
 		for (int y = 0; y < logImage.getHeight(); y++)
 		{
 			for (int x = 0; x < logImage.getWidth(); x++)
@@ -359,6 +379,22 @@ void TestLog::writeImage (const char* name, const char* description, const Const
 
 void TestLog::writeImage (const char* name, const char* description, qpImageCompressionMode compressionMode, qpImageFormat format, int width, int height, int stride, const void* data)
 {
+	const size_t	numBytes	= (size_t)width * (size_t)height * (format == QP_IMAGE_FORMAT_RGB888 ? 3u : 4u);
+
+	if ((qpTestLog_getLogFlags(m_log) & QP_TEST_LOG_EXCLUDE_IMAGES) != 0)
+		return;
+
+	if (numBytes > getRemainingImageBudget())
+	{
+		m_numOmittedImages += 1;
+		return;
+	}
+
+	m_caseImageBytes	+= numBytes;
+	m_sessionImageBytes	+= numBytes;
+
+	const ScopedTimer timer ("qpTestLog_writeImage");
+
 	if (qpTestLog_writeImage(m_log, name, description, compressionMode, format, width, height, stride, data) == DE_FALSE)
 		throw LogWriteFailedError();
 }
@@ -423,6 +459,12 @@ void TestLog::writeInteger (const char* name, const char* description, const cha
 		throw LogWriteFailedError();
 }
 
+void TestLog::writeTiming (const char* name, int count, deInt64 durationUs)
+{
+	if (qpTestLog_writeTiming(m_log, name, count, durationUs) == DE_FALSE)
+		throw LogWriteFailedError();
+}
+
 void TestLog::startEglConfigSet (const char* name, const char* description)
 {
 	if (qpTestLog_startEglConfigSet(m_log, name, description) == DE_FALSE)
@@ -443,12 +485,22 @@ void TestLog::endEglConfigSet (void)
 
 void TestLog::startCase (const char* testCasePath, qpTestCaseType testCaseType)
 {
+	m_caseImageBytes	= 0;
+	m_numOmittedImages	= 0;
+
 	if (qpTestLog_startCase(m_log, testCasePath, testCaseType) == DE_FALSE)
 		throw LogWriteFailedError();
 }
 
 void TestLog::endCase (qpTestResult result, const char* description)
 {
+	if (m_numOmittedImages > 0)
+	{
+		std::ostringstream msg;
+		msg << m_numOmittedImages << " image(s) omitted from log, log image budget exceeded";
+		writeMessage(msg.str().c_str());
+	}
+
 	if (qpTestLog_endCase(m_log, result, description) == DE_FALSE)
 		throw LogWriteFailedError();
 }
@@ -530,6 +582,25 @@ bool TestLog::isShaderLoggingEnabled (void)
 	return (qpTestLog_getLogFlags(m_log) & QP_TEST_LOG_EXCLUDE_SHADER_SOURCES) == 0;
 }
 
+void TestLog::setImageBudget (size_t caseBudgetBytes, size_t sessionBudgetBytes)
+{
+	m_caseImageBudget		= caseBudgetBytes;
+	m_sessionImageBudget	= sessionBudgetBytes;
+}
+
+size_t TestLog::getRemainingImageBudget (void) const
+{
+	size_t remaining = std::numeric_limits<size_t>::max();
+
+	if (m_caseImageBudget != 0)
+		remaining = de::min(remaining, m_caseImageBudget - de::min(m_caseImageBudget, m_caseImageBytes));
+
+	if (m_sessionImageBudget != 0)
+		remaining = de::min(remaining, m_sessionImageBudget - de::min(m_sessionImageBudget, m_sessionImageBytes));
+
+	return remaining;
+}
+
 const TestLog::BeginMessageToken		TestLog::Message			= TestLog::BeginMessageToken();
 const TestLog::EndMessageToken			TestLog::EndMessage			= TestLog::EndMessageToken();
 const TestLog::EndImageSetToken			TestLog::EndImageSet		= TestLog::EndImageSetToken();
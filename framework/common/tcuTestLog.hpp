@@ -152,6 +152,7 @@ public:
 
 	void				writeFloat				(const char* name, const char* description, const char* unit, qpKeyValueTag tag, float value);
 	void				writeInteger			(const char* name, const char* description, const char* unit, qpKeyValueTag tag, deInt64 value);
+	void				writeTiming				(const char* name, int count, deInt64 durationUs);
 
 	void				startEglConfigSet		(const char* name, const char* description);
 	void				writeEglConfig			(const qpEglConfigInfo* config);
@@ -175,11 +176,31 @@ public:
 	void				endSampleList			(void);
 
 	bool				isShaderLoggingEnabled	(void);
+
+	/*--------------------------------------------------------------------*//*!
+	 * \brief Limit amount of image data written to log
+	 *
+	 * Budgets are given in bytes of uncompressed 8-bit pixel data written
+	 * per test case and per whole session. Zero disables the limit. Images
+	 * that do not fit into the remaining budget are downsampled, or if that
+	 * is not possible, omitted. Number of omitted images is reported when
+	 * the case ends.
+	 *//*--------------------------------------------------------------------*/
+	void				setImageBudget			(size_t caseBudgetBytes, size_t sessionBudgetBytes);
+
 private:
 						TestLog					(const TestLog& other); // Not allowed!
 	TestLog&			operator=				(const TestLog& other); // Not allowed!
 
+	size_t				getRemainingImageBudget	(void) const;
+
 	qpTestLog*			m_log;
+
+	size_t				m_caseImageBudget;
+	size_t				m_sessionImageBudget;
+	size_t				m_caseImageBytes;
+	size_t				m_sessionImageBytes;
+	int					m_numOmittedImages;
 };
 
 class MessageBuilder
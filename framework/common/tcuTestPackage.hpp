@@ -58,6 +58,12 @@ public:
 	virtual void						init				(TestCase* testCase, const std::string& path) = 0;
 	virtual void						deinit				(TestCase* testCase) = 0;
 	virtual TestNode::IterateResult		iterate				(TestCase* testCase) = 0;
+
+	//! Called before init() when case look-ahead is enabled (--deqp-case-lookahead).
+	//! First case is the one about to be initialized, the rest are upcoming cases
+	//! in execution order. Executor may start preparing them in the background.
+	//! Cases not listed in the next call may be destroyed after that call.
+	virtual void						prepare				(const std::vector<TestCase*>& cases, const std::vector<std::string>& casePaths) { DE_UNREF(cases); DE_UNREF(casePaths); }
 };
 
 /*--------------------------------------------------------------------*//*!
@@ -24,6 +24,7 @@
 #include "tcuTestSessionExecutor.hpp"
 #include "tcuCommandLine.hpp"
 #include "tcuTestLog.hpp"
+#include "tcuScopedTimer.hpp"
 
 #include "deClock.h"
 
@@ -200,12 +201,22 @@ bool TestSessionExecutor::enterTestCase (TestCase* testCase, const std::string&
 	m_testCtx.setTestResult(QP_TEST_RESULT_LAST, "");
 	m_testCtx.setTerminateAfter(false);
 	log.startCase(casePath.c_str(), caseType);
+	resetScopedTimings();
 
 	m_isInTestCase	= true;
 	m_testStartTime	= deGetMicroseconds();
 
 	try
 	{
+		if (m_testCtx.getCommandLine().getCaseLookahead() > 0)
+		{
+			std::vector<TestCase*>		cases		(1, testCase);
+			std::vector<std::string>	casePaths	(1, casePath);
+
+			m_iterator.getUpcomingCases(m_testCtx.getCommandLine().getCaseLookahead(), cases, casePaths);
+			m_caseExecutor->prepare(cases, casePaths);
+		}
+
 		m_caseExecutor->init(testCase, casePath);
 		initOk = true;
 	}
@@ -256,6 +267,9 @@ void TestSessionExecutor::leaveTestCase (TestCase* testCase)
 		m_testCtx.getLog() << TestLog::Integer("TestDuration", "Test case duration in microseconds", "us", QP_KEY_TAG_TIME, duration);
 	}
 
+	if (isScopedTimingEnabled())
+		logScopedTimings(m_testCtx.getLog());
+
 	{
 		const qpTestResult	testResult		= m_testCtx.getTestResult();
 		const char* const	testResultDesc	= m_testCtx.getTestResultDesc();
@@ -28,6 +28,8 @@
 #include "tcuTextureUtil.hpp"
 #include "deMath.h"
 
+#include <limits>
+
 namespace tcu
 {
 
@@ -2193,6 +2195,549 @@ bool isLookupResultValid (const TextureCubeArrayView& texture, const Sampler& sa
 	return false;
 }
 
+// Min/max pyramid
+
+TextureMinMaxPyramid::TextureMinMaxPyramid (const Texture1DView& texture)
+	: m_numFaces	(1)
+	, m_isFinite	(true)
+{
+	for (int levelNdx = 0; levelNdx < texture.getNumLevels(); levelNdx++)
+		addLevel(texture.getLevel(levelNdx), IVec3(1, 0, 0));
+}
+
+TextureMinMaxPyramid::TextureMinMaxPyramid (const Texture2DView& texture)
+	: m_numFaces	(1)
+	, m_isFinite	(true)
+{
+	for (int levelNdx = 0; levelNdx < texture.getNumLevels(); levelNdx++)
+		addLevel(texture.getLevel(levelNdx), IVec3(1, 1, 0));
+}
+
+TextureMinMaxPyramid::TextureMinMaxPyramid (const Texture1DArrayView& texture)
+	: m_numFaces	(1)
+	, m_isFinite	(true)
+{
+	for (int levelNdx = 0; levelNdx < texture.getNumLevels(); levelNdx++)
+		addLevel(texture.getLevel(levelNdx), IVec3(1, 0, 0));
+}
+
+TextureMinMaxPyramid::TextureMinMaxPyramid (const Texture2DArrayView& texture)
+	: m_numFaces	(1)
+	, m_isFinite	(true)
+{
+	for (int levelNdx = 0; levelNdx < texture.getNumLevels(); levelNdx++)
+		addLevel(texture.getLevel(levelNdx), IVec3(1, 1, 0));
+}
+
+TextureMinMaxPyramid::TextureMinMaxPyramid (const Texture3DView& texture)
+	: m_numFaces	(1)
+	, m_isFinite	(true)
+{
+	for (int levelNdx = 0; levelNdx < texture.getNumLevels(); levelNdx++)
+		addLevel(texture.getLevel(levelNdx), IVec3(1, 1, 1));
+}
+
+TextureMinMaxPyramid::TextureMinMaxPyramid (const TextureCubeView& texture)
+	: m_numFaces	(CUBEFACE_LAST)
+	, m_isFinite	(true)
+{
+	for (int levelNdx = 0; levelNdx < texture.getNumLevels(); levelNdx++)
+	for (int faceNdx = 0; faceNdx < CUBEFACE_LAST; faceNdx++)
+		addLevel(texture.getLevelFace(levelNdx, (CubeFace)faceNdx), IVec3(1, 1, 0));
+}
+
+TextureMinMaxPyramid::~TextureMinMaxPyramid (void)
+{
+}
+
+static inline bool isFiniteColor (const Vec4& color)
+{
+	for (int compNdx = 0; compNdx < 4; compNdx++)
+	{
+		if (deFloatIsInf(color[compNdx]) || deFloatIsNaN(color[compNdx]))
+			return false;
+	}
+	return true;
+}
+
+void TextureMinMaxPyramid::addLevel (const ConstPixelBufferAccess& level, const IVec3& reducedDims)
+{
+	const bool			isSRGBFormat	= isSRGB(level.getFormat());
+	const float			inf				= std::numeric_limits<float>::infinity();
+	std::vector<Grid>	grids;
+
+	// \note Grids are not reallocated, so that the previous grid can be referenced while building the next one.
+	grids.reserve(32);
+
+	// First grid is reduced from the texels, and each following grid from the previous one until reduced dimensions are 1.
+	for (;;)
+	{
+		const Grid* const	src			= grids.empty() ? DE_NULL : &grids.back();
+		const IVec3			srcSize		= src ? src->size : level.getSize();
+		IVec3				step;
+
+		for (int dimNdx = 0; dimNdx < 3; dimNdx++)
+			step[dimNdx] = (reducedDims[dimNdx] != 0 && (!src || srcSize[dimNdx] > 1)) ? 1 : 0;
+
+		DE_ASSERT(grids.size() < grids.capacity());
+		grids.push_back(Grid());
+
+		{
+			Grid&	grid	= grids.back();
+
+			grid.size		= (srcSize + (IVec3(1) << step) - 1) >> step;
+			grid.blockShift	= (src ? src->blockShift : IVec3(0)) + step;
+			grid.minVal.resize(grid.size.x()*grid.size.y()*grid.size.z(), Vec4(inf));
+			grid.maxVal.resize(grid.size.x()*grid.size.y()*grid.size.z(), Vec4(-inf));
+
+			for (int z = 0; z < srcSize.z(); z++)
+			for (int y = 0; y < srcSize.y(); y++)
+			for (int x = 0; x < srcSize.x(); x++)
+			{
+				const int	dstNdx	= ((z >> step.z())*grid.size.y() + (y >> step.y()))*grid.size.x() + (x >> step.x());
+				Vec4		minVal;
+				Vec4		maxVal;
+
+				if (src)
+				{
+					const int	srcNdx	= (z*srcSize.y() + y)*srcSize.x() + x;
+
+					minVal	= src->minVal[srcNdx];
+					maxVal	= src->maxVal[srcNdx];
+				}
+				else
+				{
+					const Vec4	texel	= level.getPixel(x, y, z);
+
+					minVal	= isSRGBFormat ? sRGBToLinear(texel) : texel;
+					maxVal	= minVal;
+
+					if (!isFiniteColor(minVal))
+						m_isFinite = false;
+				}
+
+				grid.minVal[dstNdx] = min(grid.minVal[dstNdx], minVal);
+				grid.maxVal[dstNdx] = max(grid.maxVal[dstNdx], maxVal);
+			}
+
+			if (boolAll(logicalOr(equal(grid.size, IVec3(1)), equal(reducedDims, IVec3(0)))))
+				break;
+		}
+	}
+
+	m_levels.push_back(grids);
+}
+
+void TextureMinMaxPyramid::getRegionBounds (int levelNdx, const IVec3& regionMin, const IVec3& regionMax, Vec4& minVal, Vec4& maxVal) const
+{
+	DE_ASSERT(m_numFaces == 1);
+	getGridRegionBounds(levelNdx, regionMin, regionMax, minVal, maxVal);
+}
+
+void TextureMinMaxPyramid::getRegionBounds (int levelNdx, CubeFace face, const IVec3& regionMin, const IVec3& regionMax, Vec4& minVal, Vec4& maxVal) const
+{
+	DE_ASSERT(m_numFaces == CUBEFACE_LAST && de::inBounds((int)face, 0, (int)CUBEFACE_LAST));
+	getGridRegionBounds(levelNdx*CUBEFACE_LAST + (int)face, regionMin, regionMax, minVal, maxVal);
+}
+
+void TextureMinMaxPyramid::getGridRegionBounds (int gridsNdx, const IVec3& regionMin, const IVec3& regionMax, Vec4& minVal, Vec4& maxVal) const
+{
+	const std::vector<Grid>&	grids	= m_levels[gridsNdx];
+	size_t						gridNdx	= 0;
+
+	DE_ASSERT(boolAll(lessThanEqual(IVec3(0), regionMin)) && boolAll(lessThanEqual(regionMin, regionMax)));
+
+	// Use the finest grid where region overlaps at most two blocks along each reduced dimension.
+	for (; gridNdx+1 < grids.size(); gridNdx++)
+	{
+		const IVec3	numBlocks	= (regionMax >> grids[gridNdx].blockShift) - (regionMin >> grids[gridNdx].blockShift) + 1;
+
+		if (boolAll(logicalOr(lessThanEqual(numBlocks, IVec3(2)), equal(grids[gridNdx].blockShift, IVec3(0)))))
+			break;
+	}
+
+	{
+		const Grid&	grid		= grids[gridNdx];
+		const IVec3	blockMin	= regionMin >> grid.blockShift;
+		const IVec3	blockMax	= min(regionMax >> grid.blockShift, grid.size - 1);
+
+		minVal	= Vec4(std::numeric_limits<float>::infinity());
+		maxVal	= Vec4(-std::numeric_limits<float>::infinity());
+
+		for (int z = blockMin.z(); z <= blockMax.z(); z++)
+		for (int y = blockMin.y(); y <= blockMax.y(); y++)
+		for (int x = blockMin.x(); x <= blockMax.x(); x++)
+		{
+			const int	ndx		= (z*grid.size.y() + y)*grid.size.x() + x;
+
+			minVal	= min(minVal, grid.minVal[ndx]);
+			maxVal	= max(maxVal, grid.maxVal[ndx]);
+		}
+	}
+}
+
+//! Get range of levels that any filter can access within lod bounds. Returns false if no level is accessed.
+static bool computeReachableLevelRange (const Sampler& sampler, int numLevels, const Vec2& lodBounds, IVec2& dst)
+{
+	const float		minLod			= lodBounds.x();
+	const float		maxLod			= lodBounds.y();
+	const bool		canBeMagnified	= minLod <= sampler.lodThreshold;
+	const bool		canBeMinified	= maxLod > sampler.lodThreshold;
+	const int		maxTexLevel		= numLevels-1;
+	int				minLevel		= numLevels;
+	int				maxLevel		= -1;
+
+	if (canBeMagnified)
+	{
+		minLevel = 0;
+		maxLevel = 0;
+	}
+
+	if (canBeMinified)
+	{
+		if (isLinearMipmapFilter(sampler.minFilter) && maxTexLevel > 0)
+		{
+			minLevel = de::min(minLevel, de::clamp((int)deFloatFloor(minLod), 0, maxTexLevel-1));
+			maxLevel = de::max(maxLevel, de::clamp((int)deFloatFloor(maxLod), 0, maxTexLevel-1) + 1);
+		}
+		else if (isNearestMipmapFilter(sampler.minFilter))
+		{
+			minLevel = de::min(minLevel, de::clamp((int)deFloatCeil(minLod + 0.5f) - 1,	0, maxTexLevel));
+			maxLevel = de::max(maxLevel, de::clamp((int)deFloatFloor(maxLod + 0.5f),	0, maxTexLevel));
+		}
+		else
+		{
+			minLevel = 0;
+			maxLevel = de::max(maxLevel, 0);
+		}
+	}
+
+	dst = IVec2(minLevel, maxLevel);
+	return minLevel <= maxLevel;
+}
+
+//! Get unwrapped range of texels that nearest or linear filtering can access along one axis. Returns false for huge and non-finite coordinates.
+static bool computeUnwrappedTexelRange (bool normalizedCoords, int size, float coord, int coordBits, int uvwBits, IVec2& dst)
+{
+	const Vec2	bounds		= computeNonNormalizedCoordBounds(normalizedCoords, size, coord, coordBits, uvwBits);
+	const float	maxBound	= float(1<<24);
+
+	if (!(de::abs(bounds.x()) < maxBound && de::abs(bounds.y()) < maxBound))
+		return false;
+
+	dst = IVec2(deFloorFloatToInt32(bounds.x()-0.5f), deFloorFloatToInt32(bounds.y()+0.5f));
+	return true;
+}
+
+//! Get range of texels that nearest or linear filtering can access along one axis. Returns true if border color can be accessed.
+static bool computeReachableTexelRange (Sampler::WrapMode wrapMode, bool normalizedCoords, int size, float coord, int coordBits, int uvwBits, IVec2& dst)
+{
+	IVec2 range;
+
+	// Huge and non-finite coordinates can wrap to any texel.
+	if (!computeUnwrappedTexelRange(normalizedCoords, size, coord, coordBits, uvwBits, range))
+	{
+		dst = IVec2(0, size-1);
+		return wrapMode == Sampler::CLAMP_TO_BORDER;
+	}
+
+	{
+		const int	minI	= range.x();
+		const int	maxI	= range.y();
+
+		if (minI >= 0 && maxI < size)
+		{
+			dst = IVec2(minI, maxI);
+			return false;
+		}
+		else if (wrapMode == Sampler::CLAMP_TO_EDGE)
+		{
+			dst = IVec2(de::clamp(minI, 0, size-1), de::clamp(maxI, 0, size-1));
+			return false;
+		}
+		else if (wrapMode == Sampler::CLAMP_TO_BORDER)
+		{
+			// \note Range is empty if only border can be accessed.
+			dst = IVec2(de::max(minI, 0), de::min(maxI, size-1));
+			return true;
+		}
+		else
+		{
+			dst = IVec2(0, size-1);
+			return false;
+		}
+	}
+}
+
+//! Extend bounds with values within inclusive texel region of a level. Small regions are read directly to get exact bounds.
+static void addRegionBounds (const ConstPixelBufferAccess&	level,
+							 const TextureMinMaxPyramid&	minMax,
+							 const Sampler&					sampler,
+							 int							levelNdx,
+							 CubeFace						face,
+							 const IVec3&					regionMin,
+							 const IVec3&					regionMax,
+							 Vec4&							minVal,
+							 Vec4&							maxVal)
+{
+	const int	maxDirectTexels	= 16;
+	const IVec3	regionSize		= regionMax - regionMin + 1;
+
+	if (!boolAll(lessThanEqual(regionMin, regionMax)))
+		return;
+
+	if (regionSize.x()*regionSize.y()*regionSize.z() <= maxDirectTexels)
+	{
+		for (int z = regionMin.z(); z <= regionMax.z(); z++)
+		for (int y = regionMin.y(); y <= regionMax.y(); y++)
+		for (int x = regionMin.x(); x <= regionMax.x(); x++)
+		{
+			const Vec4 texel = lookup<float>(level, sampler, x, y, z);
+
+			minVal = min(minVal, texel);
+			maxVal = max(maxVal, texel);
+		}
+	}
+	else
+	{
+		Vec4 regionMinVal;
+		Vec4 regionMaxVal;
+
+		if (face == CUBEFACE_LAST)
+			minMax.getRegionBounds(levelNdx, regionMin, regionMax, regionMinVal, regionMaxVal);
+		else
+			minMax.getRegionBounds(levelNdx, face, regionMin, regionMax, regionMinVal, regionMaxVal);
+
+		minVal = min(minVal, regionMinVal);
+		maxVal = max(maxVal, regionMaxVal);
+	}
+}
+
+static void addBorderBounds (const ConstPixelBufferAccess& level, const Sampler& sampler, Vec4& minVal, Vec4& maxVal)
+{
+	const Vec4 border = sampleTextureBorder<float>(level.getFormat(), sampler);
+
+	minVal = min(minVal, border);
+	maxVal = max(maxVal, border);
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Decide lookup result from bounds of reachable texel values
+ *
+ * Filtering results are convex combinations of texel values, and with
+ * min/max reduction texel values themselves. Result that is outside
+ * the bounds of all texels any filter can access on any level within
+ * lod bounds is always rejected by the exhaustive search, and result that
+ * is within threshold of every point inside the bounds is always accepted.
+ *//*--------------------------------------------------------------------*/
+static QuickLookupResult decideFromBounds (const LookupPrecision& prec, const Vec4& minVal, const Vec4& maxVal, const Vec4& result)
+{
+	// Margin covers rounding errors in interpolation.
+	const Vec4	margin		= max(abs(minVal), abs(maxVal)) * (1.0f / float(1<<16));
+	const BVec4	isOutside	= logicalOr(lessThan(result, minVal - prec.colorThreshold - margin), greaterThan(result, maxVal + prec.colorThreshold + margin));
+	const BVec4	matchesAll	= logicalAnd(greaterThanEqual(result, maxVal - prec.colorThreshold + margin), lessThanEqual(result, minVal + prec.colorThreshold - margin));
+
+	if (boolAny(logicalAnd(isOutside, prec.colorMask)))
+		return QUICK_LOOKUP_REJECT;
+	else if (boolAll(logicalOr(matchesAll, logicalNot(prec.colorMask))))
+		return QUICK_LOOKUP_ACCEPT;
+	else
+		return QUICK_LOOKUP_UNKNOWN;
+}
+
+//! Quick check for non-cube textures. Coordinate dimensions are followed by the layer dimension, if any.
+static QuickLookupResult quickCheckLevelsLookupResult (const ConstPixelBufferAccess*	levels,
+													   const TextureMinMaxPyramid&		minMax,
+													   const Sampler&					sampler,
+													   const LookupPrecision&			prec,
+													   const int						numCoordDims,
+													   const Vec3&						coord,
+													   const IVec2&						layerRange,
+													   const Vec2&						lodBounds,
+													   const Vec4&						result)
+{
+	const Sampler::WrapMode	wrapModes[]		= { sampler.wrapS, sampler.wrapT, sampler.wrapR };
+	Vec4					minVal			(std::numeric_limits<float>::infinity());
+	Vec4					maxVal			(-std::numeric_limits<float>::infinity());
+	IVec2					levelRange;
+
+	if (!minMax.isFinite() || !computeReachableLevelRange(sampler, minMax.getNumLevels(), lodBounds, levelRange))
+		return QUICK_LOOKUP_UNKNOWN;
+
+	for (int levelNdx = levelRange.x(); levelNdx <= levelRange.y(); levelNdx++)
+	{
+		const ConstPixelBufferAccess&	level			= levels[levelNdx];
+		bool							accessesBorder	= false;
+		IVec3							regionMin;
+		IVec3							regionMax;
+
+		for (int dimNdx = 0; dimNdx < 3; dimNdx++)
+		{
+			IVec2 range (0, 0);
+
+			if (dimNdx < numCoordDims)
+				accessesBorder |= computeReachableTexelRange(wrapModes[dimNdx], sampler.normalizedCoords, level.getSize()[dimNdx], coord[dimNdx], prec.coordBits[dimNdx], prec.uvwBits[dimNdx], range);
+			else if (dimNdx == numCoordDims)
+				range = layerRange;
+
+			regionMin[dimNdx] = range.x();
+			regionMax[dimNdx] = range.y();
+		}
+
+		if (accessesBorder)
+			addBorderBounds(level, sampler, minVal, maxVal);
+
+		addRegionBounds(level, minMax, sampler, levelNdx, CUBEFACE_LAST, regionMin, regionMax, minVal, maxVal);
+	}
+
+	return decideFromBounds(prec, minVal, maxVal, result);
+}
+
+QuickLookupResult quickCheckLookupResult (const Texture1DView& texture, const TextureMinMaxPyramid& minMax, const Sampler& sampler, const LookupPrecision& prec, const float coord, const Vec2& lodBounds, const Vec4& result)
+{
+	DE_ASSERT(minMax.getNumLevels() == texture.getNumLevels());
+	return quickCheckLevelsLookupResult(texture.getLevels(), minMax, sampler, prec, 1, Vec3(coord, 0.0f, 0.0f), IVec2(0), lodBounds, result);
+}
+
+QuickLookupResult quickCheckLookupResult (const Texture2DView& texture, const TextureMinMaxPyramid& minMax, const Sampler& sampler, const LookupPrecision& prec, const Vec2& coord, const Vec2& lodBounds, const Vec4& result)
+{
+	DE_ASSERT(minMax.getNumLevels() == texture.getNumLevels());
+	return quickCheckLevelsLookupResult(texture.getLevels(), minMax, sampler, prec, 2, Vec3(coord.x(), coord.y(), 0.0f), IVec2(0), lodBounds, result);
+}
+
+QuickLookupResult quickCheckLookupResult (const TextureCubeView& texture, const TextureMinMaxPyramid& minMax, const Sampler& sampler, const LookupPrecision& prec, const Vec3& coord, const Vec2& lodBounds, const Vec4& result)
+{
+	const bool	canBeSeamlessLinear		= sampler.seamlessCubeMap && (sampler.magFilter == Sampler::LINEAR || isLinearFilter(sampler.minFilter));
+	Vec4		minVal					(std::numeric_limits<float>::infinity());
+	Vec4		maxVal					(-std::numeric_limits<float>::infinity());
+	int			numPossibleFaces		= 0;
+	CubeFace	possibleFaces[CUBEFACE_LAST];
+	IVec2		levelRange;
+
+	DE_ASSERT(minMax.getNumLevels() == texture.getNumLevels());
+
+	if (!minMax.isFinite() || !computeReachableLevelRange(sampler, minMax.getNumLevels(), lodBounds, levelRange))
+		return QUICK_LOOKUP_UNKNOWN;
+
+	getPossibleCubeFaces(coord, prec.coordBits, &possibleFaces[0], numPossibleFaces);
+
+	// Exhaustive search accepts anything when face is undefined.
+	if (numPossibleFaces == 0)
+		return QUICK_LOOKUP_UNKNOWN;
+
+	for (int tryFaceNdx = 0; tryFaceNdx < numPossibleFaces; tryFaceNdx++)
+	{
+		const CubeFace	face		= possibleFaces[tryFaceNdx];
+		const Vec2		faceCoord	= projectToFace(face, coord);
+
+		for (int levelNdx = levelRange.x(); levelNdx <= levelRange.y(); levelNdx++)
+		{
+			const ConstPixelBufferAccess&	level				= texture.getLevelFace(levelNdx, face);
+			const int						size				= level.getWidth();
+			bool							crossesEdge[2]		= { false, false };
+			bool							accessesBorder		= false;
+			IVec3							regionMin			(0);
+			IVec3							regionMax			(0);
+
+			for (int dimNdx = 0; dimNdx < 2; dimNdx++)
+			{
+				const Sampler::WrapMode	wrapMode	= dimNdx == 0 ? sampler.wrapS : sampler.wrapT;
+				IVec2					range;
+
+				if (canBeSeamlessLinear)
+				{
+					IVec2 unwrapped;
+
+					crossesEdge[dimNdx] = !computeUnwrappedTexelRange(sampler.normalizedCoords, size, faceCoord[dimNdx], prec.coordBits[dimNdx], prec.uvwBits[dimNdx], unwrapped) ||
+										  unwrapped.x() < 0 || unwrapped.y() >= size;
+				}
+
+				accessesBorder |= computeReachableTexelRange(wrapMode, sampler.normalizedCoords, size, faceCoord[dimNdx], prec.coordBits[dimNdx], prec.uvwBits[dimNdx], range);
+
+				regionMin[dimNdx] = range.x();
+				regionMax[dimNdx] = range.y();
+			}
+
+			// Exhaustive search accepts anything when seamless filtering reaches past a corner.
+			if (crossesEdge[0] && crossesEdge[1])
+				return QUICK_LOOKUP_UNKNOWN;
+
+			if (crossesEdge[0] || crossesEdge[1])
+			{
+				// \note Any texel of an adjacent face may be reached; bounds of whole faces are cheap and conservative.
+				for (int faceNdx = 0; faceNdx < CUBEFACE_LAST; faceNdx++)
+					addRegionBounds(texture.getLevelFace(levelNdx, (CubeFace)faceNdx), minMax, sampler, levelNdx, (CubeFace)faceNdx, IVec3(0), IVec3(size-1, size-1, 0), minVal, maxVal);
+			}
+
+			if (accessesBorder)
+				addBorderBounds(level, sampler, minVal, maxVal);
+
+			addRegionBounds(level, minMax, sampler, levelNdx, face, regionMin, regionMax, minVal, maxVal);
+		}
+	}
+
+	return decideFromBounds(prec, minVal, maxVal, result);
+}
+
+QuickLookupResult quickCheckLookupResult (const Texture1DArrayView& texture, const TextureMinMaxPyramid& minMax, const Sampler& sampler, const LookupPrecision& prec, const Vec2& coord, const Vec2& lodBounds, const Vec4& result)
+{
+	DE_ASSERT(minMax.getNumLevels() == texture.getNumLevels());
+	return quickCheckLevelsLookupResult(texture.getLevels(), minMax, sampler, prec, 1, Vec3(coord.x(), 0.0f, 0.0f), computeLayerRange(texture.getNumLayers(), prec.coordBits.y(), coord.y()), lodBounds, result);
+}
+
+QuickLookupResult quickCheckLookupResult (const Texture2DArrayView& texture, const TextureMinMaxPyramid& minMax, const Sampler& sampler, const LookupPrecision& prec, const Vec3& coord, const Vec2& lodBounds, const Vec4& result)
+{
+	DE_ASSERT(minMax.getNumLevels() == texture.getNumLevels());
+	return quickCheckLevelsLookupResult(texture.getLevels(), minMax, sampler, prec, 2, Vec3(coord.x(), coord.y(), 0.0f), computeLayerRange(texture.getNumLayers(), prec.coordBits.z(), coord.z()), lodBounds, result);
+}
+
+QuickLookupResult quickCheckLookupResult (const Texture3DView& texture, const TextureMinMaxPyramid& minMax, const Sampler& sampler, const LookupPrecision& prec, const Vec3& coord, const Vec2& lodBounds, const Vec4& result)
+{
+	DE_ASSERT(minMax.getNumLevels() == texture.getNumLevels());
+	return quickCheckLevelsLookupResult(texture.getLevels(), minMax, sampler, prec, 3, coord, IVec2(0), lodBounds, result);
+}
+
+template<typename TextureViewType, typename CoordType>
+static bool isLookupResultValidWithMinMax (const TextureViewType& texture, const TextureMinMaxPyramid& minMax, const Sampler& sampler, const LookupPrecision& prec, const CoordType& coord, const Vec2& lodBounds, const Vec4& result)
+{
+	switch (quickCheckLookupResult(texture, minMax, sampler, prec, coord, lodBounds, result))
+	{
+		case QUICK_LOOKUP_REJECT:	return false;
+		case QUICK_LOOKUP_ACCEPT:	return true;
+		default:					return isLookupResultValid(texture, sampler, prec, coord, lodBounds, result);
+	}
+}
+
+bool isLookupResultValid (const Texture1DView& texture, const TextureMinMaxPyramid& minMax, const Sampler& sampler, const LookupPrecision& prec, const float coord, const Vec2& lodBounds, const Vec4& result)
+{
+	return isLookupResultValidWithMinMax(texture, minMax, sampler, prec, coord, lodBounds, result);
+}
+
+bool isLookupResultValid (const Texture2DView& texture, const TextureMinMaxPyramid& minMax, const Sampler& sampler, const LookupPrecision& prec, const Vec2& coord, const Vec2& lodBounds, const Vec4& result)
+{
+	return isLookupResultValidWithMinMax(texture, minMax, sampler, prec, coord, lodBounds, result);
+}
+
+bool isLookupResultValid (const TextureCubeView& texture, const TextureMinMaxPyramid& minMax, const Sampler& sampler, const LookupPrecision& prec, const Vec3& coord, const Vec2& lodBounds, const Vec4& result)
+{
+	return isLookupResultValidWithMinMax(texture, minMax, sampler, prec, coord, lodBounds, result);
+}
+
+bool isLookupResultValid (const Texture1DArrayView& texture, const TextureMinMaxPyramid& minMax, const Sampler& sampler, const LookupPrecision& prec, const Vec2& coord, const Vec2& lodBounds, const Vec4& result)
+{
+	return isLookupResultValidWithMinMax(texture, minMax, sampler, prec, coord, lodBounds, result);
+}
+
+bool isLookupResultValid (const Texture2DArrayView& texture, const TextureMinMaxPyramid& minMax, const Sampler& sampler, const LookupPrecision& prec, const Vec3& coord, const Vec2& lodBounds, const Vec4& result)
+{
+	return isLookupResultValidWithMinMax(texture, minMax, sampler, prec, coord, lodBounds, result);
+}
+
+bool isLookupResultValid (const Texture3DView& texture, const TextureMinMaxPyramid& minMax, const Sampler& sampler, const LookupPrecision& prec, const Vec3& coord, const Vec2& lodBounds, const Vec4& result)
+{
+	return isLookupResultValidWithMinMax(texture, minMax, sampler, prec, coord, lodBounds, result);
+}
+
 Vec4 computeFixedPointThreshold (const IVec4& bits)
 {
 	return computeFixedPointError(bits);
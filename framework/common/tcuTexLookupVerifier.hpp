@@ -27,6 +27,8 @@
 #include "tcuDefs.hpp"
 #include "tcuTexture.hpp"
 
+#include <vector>
+
 namespace tcu
 {
 
@@ -100,6 +102,65 @@ enum TexLookupScaleMode
 	TEX_LOOKUP_SCALE_MODE_LAST
 };
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Conservative per-level min/max hierarchy of texture values.
+ *
+ * Each level is reduced into successively coarser grids of per-block
+ * component-wise min/max values (sRGB values are linearized first). Array
+ * layers and cube faces are never merged into the same block. The hierarchy is used for
+ * rejecting lookup results that lie outside all reachable texel values
+ * and accepting results that match every reachable texel value without
+ * running the exhaustive filtering search.
+ *//*--------------------------------------------------------------------*/
+class TextureMinMaxPyramid
+{
+public:
+	explicit				TextureMinMaxPyramid	(const Texture1DView& texture);
+	explicit				TextureMinMaxPyramid	(const Texture2DView& texture);
+	explicit				TextureMinMaxPyramid	(const Texture1DArrayView& texture);
+	explicit				TextureMinMaxPyramid	(const Texture2DArrayView& texture);
+	explicit				TextureMinMaxPyramid	(const Texture3DView& texture);
+	explicit				TextureMinMaxPyramid	(const TextureCubeView& texture);
+							~TextureMinMaxPyramid	(void);
+
+	int						getNumLevels			(void) const { return (int)m_levels.size() / m_numFaces;	}
+
+	//! False if texture contains Inf or NaN values, in which case bounds are meaningless.
+	bool					isFinite				(void) const { return m_isFinite;			}
+
+	//! Get bounds of values within inclusive texel region of a level. Bounds may include values from outside the region.
+	void					getRegionBounds			(int levelNdx, const IVec3& regionMin, const IVec3& regionMax, Vec4& minVal, Vec4& maxVal) const;
+
+	//! Get bounds of values within inclusive texel region of a cube face level.
+	void					getRegionBounds			(int levelNdx, CubeFace face, const IVec3& regionMin, const IVec3& regionMax, Vec4& minVal, Vec4& maxVal) const;
+
+private:
+	struct Grid
+	{
+		IVec3				size;
+		IVec3				blockShift;		//!< log2 of block size per dimension.
+		std::vector<Vec4>	minVal;
+		std::vector<Vec4>	maxVal;
+	};
+
+	void					addLevel				(const ConstPixelBufferAccess& level, const IVec3& reducedDims);
+	void					getGridRegionBounds		(int gridsNdx, const IVec3& regionMin, const IVec3& regionMax, Vec4& minVal, Vec4& maxVal) const;
+
+	std::vector<std::vector<Grid> >	m_levels;		//!< Cube face levels are stored as levelNdx*CUBEFACE_LAST + face.
+	int						m_numFaces;
+	bool					m_isFinite;
+};
+
+//! Outcome of deciding lookup result from min/max bounds alone.
+enum QuickLookupResult
+{
+	QUICK_LOOKUP_REJECT = 0,	//!< Exhaustive search would reject the result.
+	QUICK_LOOKUP_ACCEPT,		//!< Exhaustive search would accept the result.
+	QUICK_LOOKUP_UNKNOWN,		//!< Result can't be decided from bounds.
+
+	QUICK_LOOKUP_LAST
+};
+
 Vec4		computeFixedPointThreshold			(const IVec4& bits);
 Vec4		computeFloatingPointThreshold		(const IVec4& bits, const Vec4& value);
 
@@ -118,6 +179,21 @@ bool		isLookupResultValid					(const Texture2DArrayView&		texture, const Sampler
 bool		isLookupResultValid					(const Texture3DView&			texture, const Sampler& sampler, const LookupPrecision& prec, const Vec3& coord, const Vec2& lodBounds, const Vec4& result);
 bool		isLookupResultValid					(const TextureCubeArrayView&	texture, const Sampler& sampler, const LookupPrecision& prec, const IVec4& coordBits, const Vec4& coord, const Vec2& lodBounds, const Vec4& result);
 
+QuickLookupResult	quickCheckLookupResult		(const Texture1DView&			texture, const TextureMinMaxPyramid& minMax, const Sampler& sampler, const LookupPrecision& prec, const float coord, const Vec2& lodBounds, const Vec4& result);
+QuickLookupResult	quickCheckLookupResult		(const Texture2DView&			texture, const TextureMinMaxPyramid& minMax, const Sampler& sampler, const LookupPrecision& prec, const Vec2& coord, const Vec2& lodBounds, const Vec4& result);
+QuickLookupResult	quickCheckLookupResult		(const TextureCubeView&			texture, const TextureMinMaxPyramid& minMax, const Sampler& sampler, const LookupPrecision& prec, const Vec3& coord, const Vec2& lodBounds, const Vec4& result);
+QuickLookupResult	quickCheckLookupResult		(const Texture1DArrayView&		texture, const TextureMinMaxPyramid& minMax, const Sampler& sampler, const LookupPrecision& prec, const Vec2& coord, const Vec2& lodBounds, const Vec4& result);
+QuickLookupResult	quickCheckLookupResult		(const Texture2DArrayView&		texture, const TextureMinMaxPyramid& minMax, const Sampler& sampler, const LookupPrecision& prec, const Vec3& coord, const Vec2& lodBounds, const Vec4& result);
+QuickLookupResult	quickCheckLookupResult		(const Texture3DView&			texture, const TextureMinMaxPyramid& minMax, const Sampler& sampler, const LookupPrecision& prec, const Vec3& coord, const Vec2& lodBounds, const Vec4& result);
+
+// \note Quick accept and reject with the min/max pyramid; exhaustive search is done only when result can't be decided from bounds.
+bool		isLookupResultValid					(const Texture1DView&			texture, const TextureMinMaxPyramid& minMax, const Sampler& sampler, const LookupPrecision& prec, const float coord, const Vec2& lodBounds, const Vec4& result);
+bool		isLookupResultValid					(const Texture2DView&			texture, const TextureMinMaxPyramid& minMax, const Sampler& sampler, const LookupPrecision& prec, const Vec2& coord, const Vec2& lodBounds, const Vec4& result);
+bool		isLookupResultValid					(const TextureCubeView&			texture, const TextureMinMaxPyramid& minMax, const Sampler& sampler, const LookupPrecision& prec, const Vec3& coord, const Vec2& lodBounds, const Vec4& result);
+bool		isLookupResultValid					(const Texture1DArrayView&		texture, const TextureMinMaxPyramid& minMax, const Sampler& sampler, const LookupPrecision& prec, const Vec2& coord, const Vec2& lodBounds, const Vec4& result);
+bool		isLookupResultValid					(const Texture2DArrayView&		texture, const TextureMinMaxPyramid& minMax, const Sampler& sampler, const LookupPrecision& prec, const Vec3& coord, const Vec2& lodBounds, const Vec4& result);
+bool		isLookupResultValid					(const Texture3DView&			texture, const TextureMinMaxPyramid& minMax, const Sampler& sampler, const LookupPrecision& prec, const Vec3& coord, const Vec2& lodBounds, const Vec4& result);
+
 bool		isLevel1DLookupResultValid			(const ConstPixelBufferAccess& access, const Sampler& sampler, TexLookupScaleMode scaleMode, const LookupPrecision& prec, const float coordX, const int coordY, const Vec4& result);
 bool		isLevel1DLookupResultValid			(const ConstPixelBufferAccess& access, const Sampler& sampler, TexLookupScaleMode scaleMode, const IntLookupPrecision& prec, const float coordX, const int coordY, const IVec4& result);
 bool		isLevel1DLookupResultValid			(const ConstPixelBufferAccess& access, const Sampler& sampler, TexLookupScaleMode scaleMode, const IntLookupPrecision& prec, const float coordX, const int coordY, const UVec4& result);
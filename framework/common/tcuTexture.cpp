@@ -34,6 +34,7 @@
 #include "deArrayUtil.hpp"
 
 #include <limits>
+#include <algorithm>
 
 namespace tcu
 {
@@ -2254,6 +2255,382 @@ Vec4 sampleLevelArray2DOffset (const ConstPixelBufferAccess* levels, int numLeve
 	}
 }
 
+// Packet sampling
+
+enum
+{
+	MAX_SAMPLE_PACKET_SIZE	= 16
+};
+
+enum PacketFetchFormat
+{
+	PACKETFETCH_GENERIC = 0,	//!< lookup() with full format conversion
+	PACKETFETCH_RGBA8,
+	PACKETFETCH_RGBA16F,
+	PACKETFETCH_RGBA32F,
+	PACKETFETCH_D16,
+	PACKETFETCH_D32F,
+
+	PACKETFETCH_LAST
+};
+
+static PacketFetchFormat getPacketFetchFormat (const TextureFormat& format)
+{
+	if (format.order == TextureFormat::RGBA)
+	{
+		switch (format.type)
+		{
+			case TextureFormat::UNORM_INT8:	return PACKETFETCH_RGBA8;
+			case TextureFormat::HALF_FLOAT:	return PACKETFETCH_RGBA16F;
+			case TextureFormat::FLOAT:		return PACKETFETCH_RGBA32F;
+			default:						break;
+		}
+	}
+	else if (format.order == TextureFormat::D)
+	{
+		switch (format.type)
+		{
+			case TextureFormat::UNORM_INT16:	return PACKETFETCH_D16;
+			case TextureFormat::FLOAT:			return PACKETFETCH_D32F;
+			default:							break;
+		}
+	}
+
+	return PACKETFETCH_GENERIC;
+}
+
+// Texel fetch specialized by format. Must match lookup() exactly.
+template<PacketFetchFormat Format>
+static inline Vec4 fetchTexel (const ConstPixelBufferAccess& access, int i, int j, int k);
+
+template<>
+inline Vec4 fetchTexel<PACKETFETCH_GENERIC> (const ConstPixelBufferAccess& access, int i, int j, int k)
+{
+	return lookup(access, i, j, k);
+}
+
+template<>
+inline Vec4 fetchTexel<PACKETFETCH_RGBA8> (const ConstPixelBufferAccess& access, int i, int j, int k)
+{
+	return readRGBA8888Float((const deUint8*)access.getPixelPtr(i, j, k));
+}
+
+template<>
+inline Vec4 fetchTexel<PACKETFETCH_RGBA16F> (const ConstPixelBufferAccess& access, int i, int j, int k)
+{
+	const deFloat16* const ptr = (const deFloat16*)access.getPixelPtr(i, j, k);
+	return Vec4(deFloat16To32(ptr[0]), deFloat16To32(ptr[1]), deFloat16To32(ptr[2]), deFloat16To32(ptr[3]));
+}
+
+template<>
+inline Vec4 fetchTexel<PACKETFETCH_RGBA32F> (const ConstPixelBufferAccess& access, int i, int j, int k)
+{
+	const float* const ptr = (const float*)access.getPixelPtr(i, j, k);
+	return Vec4(ptr[0], ptr[1], ptr[2], ptr[3]);
+}
+
+template<>
+inline Vec4 fetchTexel<PACKETFETCH_D16> (const ConstPixelBufferAccess& access, int i, int j, int k)
+{
+	return Vec4((float)*(const deUint16*)access.getPixelPtr(i, j, k) / 65535.0f, 0.0f, 0.0f, 1.0f);
+}
+
+template<>
+inline Vec4 fetchTexel<PACKETFETCH_D32F> (const ConstPixelBufferAccess& access, int i, int j, int k)
+{
+	return Vec4(*(const float*)access.getPixelPtr(i, j, k), 0.0f, 0.0f, 1.0f);
+}
+
+// Wrap all coordinates in packet. Common modes are hoisted out of the per-lane loop.
+static void wrapPacket (Sampler::WrapMode mode, int size, const int* c, int* dst, int numSamples)
+{
+	switch (mode)
+	{
+		case Sampler::CLAMP_TO_EDGE:
+			for (int ndx = 0; ndx < numSamples; ndx++)
+				dst[ndx] = deClamp32(c[ndx], 0, size-1);
+			break;
+
+		case Sampler::CLAMP_TO_BORDER:
+			for (int ndx = 0; ndx < numSamples; ndx++)
+				dst[ndx] = deClamp32(c[ndx], -1, size);
+			break;
+
+		default:
+			for (int ndx = 0; ndx < numSamples; ndx++)
+				dst[ndx] = wrap(mode, c[ndx], size);
+			break;
+	}
+}
+
+static void unnormalizePacket (Sampler::WrapMode mode, int size, const float* c, float* dst, int numSamples)
+{
+	switch (mode)
+	{
+		case Sampler::CLAMP_TO_EDGE:
+		case Sampler::CLAMP_TO_BORDER:
+		case Sampler::REPEAT_GL:
+		case Sampler::MIRRORED_REPEAT_GL:
+		case Sampler::MIRRORED_ONCE:
+			for (int ndx = 0; ndx < numSamples; ndx++)
+				dst[ndx] = (float)size*c[ndx];
+			break;
+
+		default:
+			for (int ndx = 0; ndx < numSamples; ndx++)
+				dst[ndx] = unnormalize(mode, c[ndx], size);
+			break;
+	}
+}
+
+template<PacketFetchFormat Format>
+static void sampleNearest2DPacket (Vec4* dst, const ConstPixelBufferAccess& access, const Sampler& sampler, const float* u, const float* v, int numSamples)
+{
+	const int	width	= access.getWidth();
+	const int	height	= access.getHeight();
+	int			x		[MAX_SAMPLE_PACKET_SIZE];
+	int			y		[MAX_SAMPLE_PACKET_SIZE];
+	int			i		[MAX_SAMPLE_PACKET_SIZE];
+	int			j		[MAX_SAMPLE_PACKET_SIZE];
+
+	for (int ndx = 0; ndx < numSamples; ndx++)
+	{
+		x[ndx] = deFloorFloatToInt32(u[ndx]);
+		y[ndx] = deFloorFloatToInt32(v[ndx]);
+	}
+
+	wrapPacket(sampler.wrapS, width, x, i, numSamples);
+	wrapPacket(sampler.wrapT, height, y, j, numSamples);
+
+	for (int ndx = 0; ndx < numSamples; ndx++)
+	{
+		if ((sampler.wrapS == Sampler::CLAMP_TO_BORDER && !deInBounds32(x[ndx], 0, width)) ||
+			(sampler.wrapT == Sampler::CLAMP_TO_BORDER && !deInBounds32(y[ndx], 0, height)))
+			dst[ndx] = lookupBorder(access.getFormat(), sampler);
+		else
+			dst[ndx] = fetchTexel<Format>(access, i[ndx], j[ndx], 0);
+	}
+}
+
+template<PacketFetchFormat Format>
+static void sampleLinear2DPacket (Vec4* dst, const ConstPixelBufferAccess& access, const Sampler& sampler, const float* u, const float* v, int numSamples)
+{
+	const int	w		= access.getWidth();
+	const int	h		= access.getHeight();
+	int			x0		[MAX_SAMPLE_PACKET_SIZE];
+	int			x1		[MAX_SAMPLE_PACKET_SIZE];
+	int			y0		[MAX_SAMPLE_PACKET_SIZE];
+	int			y1		[MAX_SAMPLE_PACKET_SIZE];
+	int			i0		[MAX_SAMPLE_PACKET_SIZE];
+	int			i1		[MAX_SAMPLE_PACKET_SIZE];
+	int			j0		[MAX_SAMPLE_PACKET_SIZE];
+	int			j1		[MAX_SAMPLE_PACKET_SIZE];
+	float		a		[MAX_SAMPLE_PACKET_SIZE];
+	float		b		[MAX_SAMPLE_PACKET_SIZE];
+
+	for (int ndx = 0; ndx < numSamples; ndx++)
+	{
+		x0[ndx]	= deFloorFloatToInt32(u[ndx]-0.5f);
+		x1[ndx]	= x0[ndx]+1;
+		y0[ndx]	= deFloorFloatToInt32(v[ndx]-0.5f);
+		y1[ndx]	= y0[ndx]+1;
+		a[ndx]	= deFloatFrac(u[ndx]-0.5f);
+		b[ndx]	= deFloatFrac(v[ndx]-0.5f);
+	}
+
+	wrapPacket(sampler.wrapS, w, x0, i0, numSamples);
+	wrapPacket(sampler.wrapS, w, x1, i1, numSamples);
+	wrapPacket(sampler.wrapT, h, y0, j0, numSamples);
+	wrapPacket(sampler.wrapT, h, y1, j1, numSamples);
+
+	if (sampler.wrapS != Sampler::CLAMP_TO_BORDER && sampler.wrapT != Sampler::CLAMP_TO_BORDER)
+	{
+		for (int ndx = 0; ndx < numSamples; ndx++)
+		{
+			const Vec4	p00	= fetchTexel<Format>(access, i0[ndx], j0[ndx], 0);
+			const Vec4	p10	= fetchTexel<Format>(access, i1[ndx], j0[ndx], 0);
+			const Vec4	p01	= fetchTexel<Format>(access, i0[ndx], j1[ndx], 0);
+			const Vec4	p11	= fetchTexel<Format>(access, i1[ndx], j1[ndx], 0);
+
+			dst[ndx] = (p00*(1.0f-a[ndx])*(1.0f-b[ndx])) +
+					   (p10*(     a[ndx])*(1.0f-b[ndx])) +
+					   (p01*(1.0f-a[ndx])*(     b[ndx])) +
+					   (p11*(     a[ndx])*(     b[ndx]));
+		}
+	}
+	else
+	{
+		const Vec4 border = lookupBorder(access.getFormat(), sampler);
+
+		for (int ndx = 0; ndx < numSamples; ndx++)
+		{
+			const bool	i0UseBorder	= sampler.wrapS == Sampler::CLAMP_TO_BORDER && !de::inBounds(i0[ndx], 0, w);
+			const bool	i1UseBorder	= sampler.wrapS == Sampler::CLAMP_TO_BORDER && !de::inBounds(i1[ndx], 0, w);
+			const bool	j0UseBorder	= sampler.wrapT == Sampler::CLAMP_TO_BORDER && !de::inBounds(j0[ndx], 0, h);
+			const bool	j1UseBorder	= sampler.wrapT == Sampler::CLAMP_TO_BORDER && !de::inBounds(j1[ndx], 0, h);
+
+			const Vec4	p00			= (i0UseBorder || j0UseBorder) ? border : fetchTexel<Format>(access, i0[ndx], j0[ndx], 0);
+			const Vec4	p10			= (i1UseBorder || j0UseBorder) ? border : fetchTexel<Format>(access, i1[ndx], j0[ndx], 0);
+			const Vec4	p01			= (i0UseBorder || j1UseBorder) ? border : fetchTexel<Format>(access, i0[ndx], j1[ndx], 0);
+			const Vec4	p11			= (i1UseBorder || j1UseBorder) ? border : fetchTexel<Format>(access, i1[ndx], j1[ndx], 0);
+
+			dst[ndx] = (p00*(1.0f-a[ndx])*(1.0f-b[ndx])) +
+					   (p10*(     a[ndx])*(1.0f-b[ndx])) +
+					   (p01*(1.0f-a[ndx])*(     b[ndx])) +
+					   (p11*(     a[ndx])*(     b[ndx]));
+		}
+	}
+}
+
+template<PacketFetchFormat Format>
+static void sampleLevel2DPacket (Vec4* dst, const ConstPixelBufferAccess& access, const Sampler& sampler, Sampler::FilterMode filter, const float* s, const float* t, int numSamples)
+{
+	float	u	[MAX_SAMPLE_PACKET_SIZE];
+	float	v	[MAX_SAMPLE_PACKET_SIZE];
+
+	if (sampler.normalizedCoords)
+	{
+		unnormalizePacket(sampler.wrapS, access.getWidth(), s, u, numSamples);
+		unnormalizePacket(sampler.wrapT, access.getHeight(), t, v, numSamples);
+	}
+	else
+	{
+		std::copy(s, s+numSamples, u);
+		std::copy(t, t+numSamples, v);
+	}
+
+	if (filter == Sampler::NEAREST)
+		sampleNearest2DPacket<Format>(dst, access, sampler, u, v, numSamples);
+	else
+	{
+		DE_ASSERT(filter == Sampler::LINEAR);
+		sampleLinear2DPacket<Format>(dst, access, sampler, u, v, numSamples);
+	}
+}
+
+static void sampleLevel2DPacket (Vec4* dst, const ConstPixelBufferAccess& access, const Sampler& sampler, Sampler::FilterMode filter, const float* s, const float* t, int numSamples)
+{
+	switch (getPacketFetchFormat(access.getFormat()))
+	{
+		case PACKETFETCH_RGBA8:		sampleLevel2DPacket<PACKETFETCH_RGBA8>		(dst, access, sampler, filter, s, t, numSamples);	break;
+		case PACKETFETCH_RGBA16F:	sampleLevel2DPacket<PACKETFETCH_RGBA16F>	(dst, access, sampler, filter, s, t, numSamples);	break;
+		case PACKETFETCH_RGBA32F:	sampleLevel2DPacket<PACKETFETCH_RGBA32F>	(dst, access, sampler, filter, s, t, numSamples);	break;
+		case PACKETFETCH_D16:		sampleLevel2DPacket<PACKETFETCH_D16>		(dst, access, sampler, filter, s, t, numSamples);	break;
+		case PACKETFETCH_D32F:		sampleLevel2DPacket<PACKETFETCH_D32F>		(dst, access, sampler, filter, s, t, numSamples);	break;
+		default:					sampleLevel2DPacket<PACKETFETCH_GENERIC>	(dst, access, sampler, filter, s, t, numSamples);	break;
+	}
+}
+
+// Level and filter selection for single lookup; matches sampleLevelArray2DOffset().
+struct LevelSelection
+{
+	Sampler::FilterMode	filter;
+	int					level0;
+	int					level1;		//!< -1 if only level0 is sampled
+	float				weight;		//!< Weight of level1
+
+	bool isCompatible (const LevelSelection& other) const
+	{
+		return filter == other.filter && level0 == other.level0 && level1 == other.level1;
+	}
+};
+
+static LevelSelection selectLevels (int numLevels, const Sampler& sampler, float lod)
+{
+	const bool					magnified	= lod <= sampler.lodThreshold;
+	const Sampler::FilterMode	filterMode	= magnified ? sampler.magFilter : sampler.minFilter;
+	const int					maxLevel	= numLevels-1;
+	LevelSelection				sel;
+
+	sel.level1	= -1;
+	sel.weight	= 0.0f;
+
+	switch (filterMode)
+	{
+		case Sampler::NEAREST:
+		case Sampler::LINEAR:
+			sel.filter	= filterMode;
+			sel.level0	= 0;
+			break;
+
+		case Sampler::NEAREST_MIPMAP_NEAREST:
+		case Sampler::LINEAR_MIPMAP_NEAREST:
+			sel.filter	= (filterMode == Sampler::LINEAR_MIPMAP_NEAREST) ? Sampler::LINEAR : Sampler::NEAREST;
+			sel.level0	= deClamp32((int)deFloatCeil(lod + 0.5f) - 1, 0, maxLevel);
+			break;
+
+		case Sampler::NEAREST_MIPMAP_LINEAR:
+		case Sampler::LINEAR_MIPMAP_LINEAR:
+			sel.filter	= (filterMode == Sampler::LINEAR_MIPMAP_LINEAR) ? Sampler::LINEAR : Sampler::NEAREST;
+			sel.level0	= deClamp32((int)deFloatFloor(lod), 0, maxLevel);
+			sel.level1	= de::min(maxLevel, sel.level0 + 1);
+			sel.weight	= deFloatFrac(lod);
+			break;
+
+		default:
+			DE_ASSERT(DE_FALSE);
+			sel.filter	= Sampler::NEAREST;
+			sel.level0	= 0;
+	}
+
+	return sel;
+}
+
+void sampleLevelArray2DPacket (Vec4* dst, const ConstPixelBufferAccess* levels, int numLevels, const Sampler& sampler, const Vec2* coords, const float* lods, int numSamples)
+{
+	for (int packetStart = 0; packetStart < numSamples; packetStart += MAX_SAMPLE_PACKET_SIZE)
+	{
+		const int		packetSize	= de::min<int>(MAX_SAMPLE_PACKET_SIZE, numSamples - packetStart);
+		LevelSelection	selection	[MAX_SAMPLE_PACKET_SIZE];
+		int				laneNdx		[MAX_SAMPLE_PACKET_SIZE];
+		float			s			[MAX_SAMPLE_PACKET_SIZE];
+		float			t			[MAX_SAMPLE_PACKET_SIZE];
+		Vec4			color0		[MAX_SAMPLE_PACKET_SIZE];
+		Vec4			color1		[MAX_SAMPLE_PACKET_SIZE];
+		int				numLanes	= 0;
+
+		for (int ndx = 0; ndx < packetSize; ndx++)
+			selection[ndx] = selectLevels(numLevels, sampler, lods[packetStart+ndx]);
+
+		// Lanes that select the same levels as the first lane are sampled as a packet, the rest one by one.
+		for (int ndx = 0; ndx < packetSize; ndx++)
+		{
+			const Vec2& coord = coords[packetStart+ndx];
+
+			if (selection[ndx].isCompatible(selection[0]))
+			{
+				laneNdx[numLanes]	= ndx;
+				s[numLanes]			= coord.x();
+				t[numLanes]			= coord.y();
+				numLanes += 1;
+			}
+			else
+				dst[packetStart+ndx] = sampleLevelArray2D(levels, numLevels, sampler, coord.x(), coord.y(), 0, lods[packetStart+ndx]);
+		}
+
+		sampleLevel2DPacket(color0, levels[selection[0].level0], sampler, selection[0].filter, s, t, numLanes);
+
+		if (selection[0].level1 < 0)
+		{
+			for (int ndx = 0; ndx < numLanes; ndx++)
+				dst[packetStart+laneNdx[ndx]] = color0[ndx];
+		}
+		else
+		{
+			if (selection[0].level1 != selection[0].level0)
+				sampleLevel2DPacket(color1, levels[selection[0].level1], sampler, selection[0].filter, s, t, numLanes);
+			else
+				std::copy(color0, color0+numLanes, color1);
+
+			for (int ndx = 0; ndx < numLanes; ndx++)
+			{
+				const float f = selection[laneNdx[ndx]].weight;
+				dst[packetStart+laneNdx[ndx]] = color0[ndx]*(1.0f - f) + color1[ndx]*f;
+			}
+		}
+	}
+}
+
 Vec4 sampleLevelArray3DOffset (const ConstPixelBufferAccess* levels, int numLevels, const Sampler& sampler, float s, float t, float r, float lod, const IVec3& offset)
 {
 	bool					magnified	= lod <= sampler.lodThreshold;
@@ -461,6 +461,9 @@ Vec4	sampleLevelArray1DOffset		(const ConstPixelBufferAccess* levels, int numLev
 Vec4	sampleLevelArray2DOffset		(const ConstPixelBufferAccess* levels, int numLevels, const Sampler& sampler, float s, float t, float lod, const IVec3& offset);
 Vec4	sampleLevelArray3DOffset		(const ConstPixelBufferAccess* levels, int numLevels, const Sampler& sampler, float s, float t, float r, float lod, const IVec3& offset);
 
+//! Sample numSamples coordinates at once. Results are identical to calling sampleLevelArray2D() with depth 0 for each coordinate.
+void	sampleLevelArray2DPacket		(Vec4* dst, const ConstPixelBufferAccess* levels, int numLevels, const Sampler& sampler, const Vec2* coords, const float* lods, int numSamples);
+
 float	sampleLevelArray1DCompare		(const ConstPixelBufferAccess* levels, int numLevels, const Sampler& sampler, float ref, float s, float lod, const IVec2& offset);
 float	sampleLevelArray2DCompare		(const ConstPixelBufferAccess* levels, int numLevels, const Sampler& sampler, float ref, float s, float t, float lod, const IVec3& offset);
 
@@ -569,6 +572,7 @@ public:
 	Vec4							sampleOffset		(const Sampler& sampler, float s, float t, float lod, const IVec2& offset) const;
 	float							sampleCompare		(const Sampler& sampler, float ref, float s, float t, float lod) const;
 	float							sampleCompareOffset	(const Sampler& sampler, float ref, float s, float t, float lod, const IVec2& offset) const;
+	void							samplePacket		(Vec4* dst, const Sampler& sampler, const Vec2* coords, const float* lods, int numSamples) const;
 
 	Vec4							gatherOffsets		(const Sampler& sampler, float s, float t, int componentNdx, const IVec2 (&offsets)[4]) const;
 	Vec4							gatherOffsetsCompare(const Sampler& sampler, float ref, float s, float t, const IVec2 (&offsets)[4]) const;
@@ -595,6 +599,11 @@ inline Vec4 Texture2DView::sampleOffset (const Sampler& sampler, float s, float
 	return sampleLevelArray2DOffset(m_levels, m_numLevels, sampler, s, t, lod, IVec3(offset.x(), offset.y(), 0));
 }
 
+inline void Texture2DView::samplePacket (Vec4* dst, const Sampler& sampler, const Vec2* coords, const float* lods, int numSamples) const
+{
+	sampleLevelArray2DPacket(dst, m_levels, m_numLevels, sampler, coords, lods, numSamples);
+}
+
 inline float Texture2DView::sampleCompare (const Sampler& sampler, float ref, float s, float t, float lod) const
 {
 	return sampleLevelArray2DCompare(m_levels, m_numLevels, sampler, ref, s, t, lod, IVec3(0, 0, 0));
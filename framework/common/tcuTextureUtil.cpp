@@ -677,50 +677,53 @@ static inline Vec4 linearInterpolate (float t, const Vec4& a, const Vec4& b)
 enum
 {
 	CLEAR_OPTIMIZE_THRESHOLD		= 128,
-	CLEAR_OPTIMIZE_MAX_PIXEL_SIZE	= 8
+	CLEAR_OPTIMIZE_MAX_PIXEL_SIZE	= 16
 };
 
-inline void fillRow (const PixelBufferAccess& dst, int y, int z, int pixelSize, const deUint8* pixel)
+//! Fill tightly packed access with packed pixel value. First row is filled by doubling, other rows are copied from it.
+static void fillWithPixel (const PixelBufferAccess& dst, int pixelSize, const deUint8* pixel)
 {
 	DE_ASSERT(dst.getPixelPitch() == pixelSize); // only tightly packed
 
-	deUint8*	dstPtr	= (deUint8*)dst.getPixelPtr(0, y, z);
-	int			width	= dst.getWidth();
+	const int		rowSize		= dst.getWidth()*pixelSize;
+	deUint8* const	firstRow	= (deUint8*)dst.getPixelPtr(0, 0, 0);
 
-	if (pixelSize == 8 && deIsAlignedPtr(dstPtr, pixelSize))
+	if (pixelSize == 1)
+		deMemset(firstRow, pixel[0], rowSize);
+	else
 	{
-		deUint64 val;
-		memcpy(&val, pixel, sizeof(val));
+		int filledSize = pixelSize;
 
-		for (int i = 0; i < width; i++)
-			((deUint64*)dstPtr)[i] = val;
-	}
-	else if (pixelSize == 4 && deIsAlignedPtr(dstPtr, pixelSize))
-	{
-		deUint32 val;
-		memcpy(&val, pixel, sizeof(val));
+		deMemcpy(firstRow, pixel, pixelSize);
+
+		while (filledSize < rowSize)
+		{
+			const int copySize = de::min(filledSize, rowSize - filledSize);
 
-		for (int i = 0; i < width; i++)
-			((deUint32*)dstPtr)[i] = val;
+			deMemcpy(firstRow + filledSize, firstRow, copySize);
+			filledSize += copySize;
+		}
 	}
-	else
+
+	for (int z = 0; z < dst.getDepth(); z++)
+	for (int y = 0; y < dst.getHeight(); y++)
 	{
-		for (int i = 0; i < width; i++)
-			for (int j = 0; j < pixelSize; j++)
-				dstPtr[i*pixelSize+j] = pixel[j];
+		if (y != 0 || z != 0)
+			deMemcpy(dst.getPixelPtr(0, y, z), firstRow, rowSize);
 	}
 }
 
-void clear (const PixelBufferAccess& access, const Vec4& color)
+template<typename ColorType>
+static void clearWithColor (const PixelBufferAccess& access, const ColorType& color)
 {
 	const int	pixelSize				= access.getFormat().getPixelSize();
 	const int	pixelPitch				= access.getPixelPitch();
 	const bool	rowPixelsTightlyPacked	= (pixelSize == pixelPitch);
 
 	if (access.getWidth()*access.getHeight()*access.getDepth() >= CLEAR_OPTIMIZE_THRESHOLD &&
-		pixelSize < CLEAR_OPTIMIZE_MAX_PIXEL_SIZE && rowPixelsTightlyPacked)
+		pixelSize <= CLEAR_OPTIMIZE_MAX_PIXEL_SIZE && rowPixelsTightlyPacked)
 	{
-		// Convert to destination format.
+		// Convert to destination format once.
 		union
 		{
 			deUint8		u8[CLEAR_OPTIMIZE_MAX_PIXEL_SIZE];
@@ -729,9 +732,7 @@ void clear (const PixelBufferAccess& access, const Vec4& color)
 		DE_STATIC_ASSERT(sizeof(pixel) == CLEAR_OPTIMIZE_MAX_PIXEL_SIZE);
 		PixelBufferAccess(access.getFormat(), 1, 1, 1, 0, 0, &pixel.u8[0]).setPixel(color, 0, 0);
 
-		for (int z = 0; z < access.getDepth(); z++)
-			for (int y = 0; y < access.getHeight(); y++)
-				fillRow(access, y, z, pixelSize, &pixel.u8[0]);
+		fillWithPixel(access, pixelSize, &pixel.u8[0]);
 	}
 	else
 	{
@@ -742,35 +743,14 @@ void clear (const PixelBufferAccess& access, const Vec4& color)
 	}
 }
 
-void clear (const PixelBufferAccess& access, const IVec4& color)
+void clear (const PixelBufferAccess& access, const Vec4& color)
 {
-	const int	pixelSize				= access.getFormat().getPixelSize();
-	const int	pixelPitch				= access.getPixelPitch();
-	const bool	rowPixelsTightlyPacked	= (pixelSize == pixelPitch);
-
-	if (access.getWidth()*access.getHeight()*access.getDepth() >= CLEAR_OPTIMIZE_THRESHOLD &&
-		pixelSize < CLEAR_OPTIMIZE_MAX_PIXEL_SIZE && rowPixelsTightlyPacked)
-	{
-		// Convert to destination format.
-		union
-		{
-			deUint8		u8[CLEAR_OPTIMIZE_MAX_PIXEL_SIZE];
-			deUint64	u64; // Forces 64-bit alignment.
-		} pixel;
-		DE_STATIC_ASSERT(sizeof(pixel) == CLEAR_OPTIMIZE_MAX_PIXEL_SIZE);
-		PixelBufferAccess(access.getFormat(), 1, 1, 1, 0, 0, &pixel.u8[0]).setPixel(color, 0, 0);
+	clearWithColor(access, color);
+}
 
-		for (int z = 0; z < access.getDepth(); z++)
-			for (int y = 0; y < access.getHeight(); y++)
-				fillRow(access, y, z, pixelSize, &pixel.u8[0]);
-	}
-	else
-	{
-		for (int z = 0; z < access.getDepth(); z++)
-			for (int y = 0; y < access.getHeight(); y++)
-				for (int x = 0; x < access.getWidth(); x++)
-					access.setPixel(color, x, y, z);
-	}
+void clear (const PixelBufferAccess& access, const IVec4& color)
+{
+	clearWithColor(access, color);
 }
 
 void clear (const PixelBufferAccess& access, const UVec4& color)
@@ -1017,6 +997,199 @@ void fillWithMetaballs (const PixelBufferAccess& dst, int numBalls, deUint32 see
 	}
 }
 
+namespace
+{
+
+// Row converters for common format-converting copies. Results must be bit-exact
+// with the generic getPixel()/setPixel() path.
+
+typedef void (*ConvertRowFunc) (void* dst, const void* src, int numPixels);
+
+inline deUint32 readUint32 (const deUint8* src)
+{
+	deUint32 val;
+	deMemcpy(&val, src, sizeof(val));
+	return val;
+}
+
+//! Same as deFloat16To32(), but inlined and branch-light
+inline float halfToFloat (deUint16 val16)
+{
+	union
+	{
+		float		f;
+		deUint32	u;
+	} x;
+
+	const deUint32	sign		= (deUint32)(val16 & 0x8000u) << 16;
+	const deUint32	exponent	= (deUint32)(val16 & 0x7c00u);
+
+	x.u = (deUint32)(val16 & 0x7fffu) << 13;
+
+	if (exponent == 0x7c00u)
+		x.u |= 0x7f800000u;					// Inf / NaN
+	else if (exponent == 0u)
+	{
+		x.u += 113u << 23;					// Denormal, renormalize with exact float subtract
+		x.f -= 6.103515625e-05f;			// 2^-14
+	}
+	else
+		x.u += (127u - 15u) << 23;
+
+	x.u |= sign;
+
+	return x.f;
+}
+
+template<int NumChannels>
+void convertRowUnorm8ToFloat (void* dst, const void* src, int numPixels)
+{
+	const deUint8*	srcPtr	= (const deUint8*)src;
+	float*			dstPtr	= (float*)dst;
+
+	for (int ndx = 0; ndx < numPixels*NumChannels; ndx++)
+		dstPtr[ndx] = (float)srcPtr[ndx] / 255.0f;
+}
+
+template<int NumChannels>
+void convertRowHalfToFloat (void* dst, const void* src, int numPixels)
+{
+	const deUint8*	srcPtr	= (const deUint8*)src;
+	float*			dstPtr	= (float*)dst;
+
+	for (int ndx = 0; ndx < numPixels*NumChannels; ndx++)
+	{
+		deUint16 val16;
+		deMemcpy(&val16, srcPtr + ndx*sizeof(deUint16), sizeof(deUint16));
+		dstPtr[ndx] = halfToFloat(val16);
+	}
+}
+
+//! RGBA8 <-> BGRA8
+void convertRowSwapRB8 (void* dst, const void* src, int numPixels)
+{
+	const deUint8*	srcPtr	= (const deUint8*)src;
+	deUint8*		dstPtr	= (deUint8*)dst;
+
+	for (int ndx = 0; ndx < numPixels; ndx++)
+	{
+		dstPtr[ndx*4 + 0] = srcPtr[ndx*4 + 2];
+		dstPtr[ndx*4 + 1] = srcPtr[ndx*4 + 1];
+		dstPtr[ndx*4 + 2] = srcPtr[ndx*4 + 0];
+		dstPtr[ndx*4 + 3] = srcPtr[ndx*4 + 3];
+	}
+}
+
+void convertRowRGB8ToRGBA8 (void* dst, const void* src, int numPixels)
+{
+	const deUint8*	srcPtr	= (const deUint8*)src;
+	deUint8*		dstPtr	= (deUint8*)dst;
+
+	for (int ndx = 0; ndx < numPixels; ndx++)
+	{
+		dstPtr[ndx*4 + 0] = srcPtr[ndx*3 + 0];
+		dstPtr[ndx*4 + 1] = srcPtr[ndx*3 + 1];
+		dstPtr[ndx*4 + 2] = srcPtr[ndx*3 + 2];
+		dstPtr[ndx*4 + 3] = 0xffu;
+	}
+}
+
+void convertRowRGBA8ToRGB8 (void* dst, const void* src, int numPixels)
+{
+	const deUint8*	srcPtr	= (const deUint8*)src;
+	deUint8*		dstPtr	= (deUint8*)dst;
+
+	for (int ndx = 0; ndx < numPixels; ndx++)
+	{
+		dstPtr[ndx*3 + 0] = srcPtr[ndx*4 + 0];
+		dstPtr[ndx*3 + 1] = srcPtr[ndx*4 + 1];
+		dstPtr[ndx*3 + 2] = srcPtr[ndx*4 + 2];
+	}
+}
+
+//! Extract depth from FLOAT_UNSIGNED_INT_24_8_REV
+void convertRowDepth32FStencil8ToDepth32F (void* dst, const void* src, int numPixels)
+{
+	const deUint8*	srcPtr	= (const deUint8*)src;
+	deUint8*		dstPtr	= (deUint8*)dst;
+
+	for (int ndx = 0; ndx < numPixels; ndx++)
+		deMemcpy(dstPtr + ndx*4, srcPtr + ndx*8, 4);
+}
+
+//! Extract stencil from FLOAT_UNSIGNED_INT_24_8_REV
+void convertRowDepth32FStencil8ToStencil8 (void* dst, const void* src, int numPixels)
+{
+	const deUint8*	srcPtr	= (const deUint8*)src;
+	deUint8*		dstPtr	= (deUint8*)dst;
+
+	for (int ndx = 0; ndx < numPixels; ndx++)
+		dstPtr[ndx] = (deUint8)(readUint32(srcPtr + ndx*8 + 4) & 0xffu);
+}
+
+//! Extract stencil from UNSIGNED_INT_24_8
+void convertRowDepth24Stencil8ToStencil8 (void* dst, const void* src, int numPixels)
+{
+	const deUint8*	srcPtr	= (const deUint8*)src;
+	deUint8*		dstPtr	= (deUint8*)dst;
+
+	for (int ndx = 0; ndx < numPixels; ndx++)
+		dstPtr[ndx] = (deUint8)(readUint32(srcPtr + ndx*4) & 0xffu);
+}
+
+//! Extract stencil from UNSIGNED_INT_24_8_REV
+void convertRowDepth24Stencil8RevToStencil8 (void* dst, const void* src, int numPixels)
+{
+	const deUint8*	srcPtr	= (const deUint8*)src;
+	deUint8*		dstPtr	= (deUint8*)dst;
+
+	for (int ndx = 0; ndx < numPixels; ndx++)
+		dstPtr[ndx] = (deUint8)(readUint32(srcPtr + ndx*4) >> 24);
+}
+
+ConvertRowFunc findConvertRowFunc (const TextureFormat& dstFormat, const TextureFormat& srcFormat)
+{
+	static const struct
+	{
+		TextureFormat::ChannelOrder	srcOrder;
+		TextureFormat::ChannelType	srcType;
+		TextureFormat::ChannelOrder	dstOrder;
+		TextureFormat::ChannelType	dstType;
+		ConvertRowFunc				func;
+	} s_converters[] =
+	{
+		{ TextureFormat::RGBA,	TextureFormat::UNORM_INT8,					TextureFormat::BGRA,	TextureFormat::UNORM_INT8,		convertRowSwapRB8							},
+		{ TextureFormat::BGRA,	TextureFormat::UNORM_INT8,					TextureFormat::RGBA,	TextureFormat::UNORM_INT8,		convertRowSwapRB8							},
+		{ TextureFormat::RGB,	TextureFormat::UNORM_INT8,					TextureFormat::RGBA,	TextureFormat::UNORM_INT8,		convertRowRGB8ToRGBA8						},
+		{ TextureFormat::RGBA,	TextureFormat::UNORM_INT8,					TextureFormat::RGB,		TextureFormat::UNORM_INT8,		convertRowRGBA8ToRGB8						},
+		{ TextureFormat::R,		TextureFormat::UNORM_INT8,					TextureFormat::R,		TextureFormat::FLOAT,			convertRowUnorm8ToFloat<1>					},
+		{ TextureFormat::RG,	TextureFormat::UNORM_INT8,					TextureFormat::RG,		TextureFormat::FLOAT,			convertRowUnorm8ToFloat<2>					},
+		{ TextureFormat::RGB,	TextureFormat::UNORM_INT8,					TextureFormat::RGB,		TextureFormat::FLOAT,			convertRowUnorm8ToFloat<3>					},
+		{ TextureFormat::RGBA,	TextureFormat::UNORM_INT8,					TextureFormat::RGBA,	TextureFormat::FLOAT,			convertRowUnorm8ToFloat<4>					},
+		{ TextureFormat::R,		TextureFormat::HALF_FLOAT,					TextureFormat::R,		TextureFormat::FLOAT,			convertRowHalfToFloat<1>					},
+		{ TextureFormat::RG,	TextureFormat::HALF_FLOAT,					TextureFormat::RG,		TextureFormat::FLOAT,			convertRowHalfToFloat<2>					},
+		{ TextureFormat::RGB,	TextureFormat::HALF_FLOAT,					TextureFormat::RGB,		TextureFormat::FLOAT,			convertRowHalfToFloat<3>					},
+		{ TextureFormat::RGBA,	TextureFormat::HALF_FLOAT,					TextureFormat::RGBA,	TextureFormat::FLOAT,			convertRowHalfToFloat<4>					},
+		{ TextureFormat::DS,	TextureFormat::FLOAT_UNSIGNED_INT_24_8_REV,	TextureFormat::D,		TextureFormat::FLOAT,			convertRowDepth32FStencil8ToDepth32F		},
+		{ TextureFormat::DS,	TextureFormat::FLOAT_UNSIGNED_INT_24_8_REV,	TextureFormat::S,		TextureFormat::UNSIGNED_INT8,	convertRowDepth32FStencil8ToStencil8		},
+		{ TextureFormat::DS,	TextureFormat::UNSIGNED_INT_24_8,			TextureFormat::S,		TextureFormat::UNSIGNED_INT8,	convertRowDepth24Stencil8ToStencil8			},
+		{ TextureFormat::DS,	TextureFormat::UNSIGNED_INT_24_8_REV,		TextureFormat::S,		TextureFormat::UNSIGNED_INT8,	convertRowDepth24Stencil8RevToStencil8		},
+	};
+
+	for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(s_converters); ndx++)
+	{
+		if (s_converters[ndx].srcOrder	== srcFormat.order	&&
+			s_converters[ndx].srcType	== srcFormat.type	&&
+			s_converters[ndx].dstOrder	== dstFormat.order	&&
+			s_converters[ndx].dstType	== dstFormat.type)
+			return s_converters[ndx].func;
+	}
+
+	return DE_NULL;
+}
+
+} // anonymous
+
 void copy (const PixelBufferAccess& dst, const ConstPixelBufferAccess& src)
 {
 	DE_ASSERT(src.getSize() == dst.getSize());
@@ -1037,6 +1210,8 @@ void copy (const PixelBufferAccess& dst, const ConstPixelBufferAccess& src)
 	const bool	dstHasDepth			= (dst.getFormat().order == tcu::TextureFormat::DS || dst.getFormat().order == tcu::TextureFormat::D);
 	const bool	dstHasStencil		= (dst.getFormat().order == tcu::TextureFormat::DS || dst.getFormat().order == tcu::TextureFormat::S);
 
+	const ConvertRowFunc	convertRow	= (srcTightlyPacked && dstTightlyPacked) ? findConvertRowFunc(dst.getFormat(), src.getFormat()) : DE_NULL;
+
 	if (src.getFormat() == dst.getFormat() && srcTightlyPacked && dstTightlyPacked)
 	{
 		// Fast-path for matching formats.
@@ -1052,6 +1227,13 @@ void copy (const PixelBufferAccess& dst, const ConstPixelBufferAccess& src)
 		for (int x = 0; x < width; x++)
 			deMemcpy(dst.getPixelPtr(x, y, z), src.getPixelPtr(x, y, z), srcPixelSize);
 	}
+	else if (convertRow)
+	{
+		// Fast-path for common format conversions.
+		for (int z = 0; z < depth; z++)
+		for (int y = 0; y < height; y++)
+			convertRow(dst.getPixelPtr(0, y, z), src.getPixelPtr(0, y, z), width);
+	}
 	else if (srcHasDepth || srcHasStencil || dstHasDepth || dstHasStencil)
 	{
 		DE_ASSERT((srcHasDepth && dstHasDepth) || (srcHasStencil && dstHasStencil)); // must have at least one common channel
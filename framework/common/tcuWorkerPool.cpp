@@ -0,0 +1,324 @@
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Tester Core
+ * ----------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Worker thread pool for parallel verification.
+ *//*--------------------------------------------------------------------*/
+
+#include "tcuWorkerPool.hpp"
+#include "deThread.hpp"
+#include "deThreadLocal.hpp"
+#include "deSemaphore.hpp"
+#include "deMutex.hpp"
+#include "deSingleton.h"
+#include "deAtomic.h"
+
+#include <new>
+
+namespace tcu
+{
+
+#if defined(DE_THREAD_LOCAL)
+
+DE_THREAD_LOCAL bool	s_isWorkerThread	= false;
+
+static void setIsWorkerThread (void)	{ s_isWorkerThread = true;		}
+bool WorkerPool::isWorkerThread (void)	{ return s_isWorkerThread;		}
+
+#else // defined(DE_THREAD_LOCAL)
+
+static de::ThreadLocal	s_isWorkerThread;
+
+static void setIsWorkerThread (void)	{ s_isWorkerThread.set((void*)1);		}
+bool WorkerPool::isWorkerThread (void)	{ return s_isWorkerThread.get() != DE_NULL;	}
+
+#endif // defined(DE_THREAD_LOCAL)
+
+class WorkerThread : public de::Thread
+{
+public:
+	WorkerThread (de::ThreadSafeRingBuffer<WorkerPool::Task*>& tasks)
+		: m_tasks(tasks)
+	{
+		start();
+	}
+
+	void run (void)
+	{
+		setIsWorkerThread();
+
+		for (;;)
+		{
+			WorkerPool::Task* const	task	= m_tasks.popBack();
+
+			if (task)
+				task->execute();
+			else
+				break; // End of tasks - time to terminate
+		}
+	}
+
+private:
+	de::ThreadSafeRingBuffer<WorkerPool::Task*>&	m_tasks;
+};
+
+WorkerPool::WorkerPool (int numThreads)
+	: m_tasks	((size_t)(numThreads + 1) * 64u)
+	, m_threads	(numThreads)
+{
+	DE_ASSERT(numThreads >= 0);
+
+	for (size_t ndx = 0; ndx < m_threads.size(); ++ndx)
+		m_threads[ndx] = de::SharedPtr<WorkerThread>(new WorkerThread(m_tasks));
+}
+
+WorkerPool::~WorkerPool (void)
+{
+	for (size_t ndx = 0; ndx < m_threads.size(); ++ndx)
+		m_tasks.pushFront(DE_NULL);
+
+	for (size_t ndx = 0; ndx < m_threads.size(); ++ndx)
+		m_threads[ndx]->join();
+}
+
+void WorkerPool::submit (Task* task)
+{
+	DE_ASSERT(task);
+	m_tasks.pushFront(task);
+}
+
+// Shared pool
+
+static volatile deSingletonState	s_sharedPoolState	= DE_SINGLETON_STATE_NOT_INITIALIZED;
+static WorkerPool*					s_sharedPool		= DE_NULL;
+
+static void createSharedWorkerPool (void*)
+{
+	// \note Pool is never destroyed: workers are blocked waiting for tasks until the process exits.
+	s_sharedPool = new WorkerPool((int)deGetNumAvailableLogicalCores() - 1);
+}
+
+WorkerPool& getSharedWorkerPool (void)
+{
+	deInitSingleton(&s_sharedPoolState, createSharedWorkerPool, DE_NULL);
+	return *s_sharedPool;
+}
+
+// Batch execution
+
+CapturedException::CapturedException (void)
+	: m_type	(TYPE_NONE)
+	, m_result	(QP_TEST_RESULT_LAST)
+{
+}
+
+void CapturedException::capture (void)
+{
+	try
+	{
+		throw;
+	}
+	catch (const NotSupportedError& e)
+	{
+		m_type		= TYPE_NOT_SUPPORTED_ERROR;
+		m_message	= e.what();
+	}
+	catch (const ResourceError& e)
+	{
+		m_type		= TYPE_RESOURCE_ERROR;
+		m_message	= e.what();
+	}
+	catch (const InternalError& e)
+	{
+		m_type		= TYPE_INTERNAL_ERROR;
+		m_message	= e.what();
+	}
+	catch (const TestError& e)
+	{
+		m_type		= TYPE_TEST_ERROR;
+		m_message	= e.what();
+	}
+	catch (const TestException& e)
+	{
+		m_type		= TYPE_TEST_EXCEPTION;
+		m_result	= e.getTestResult();
+		m_message	= e.what();
+	}
+	catch (const std::bad_alloc&)
+	{
+		m_type		= TYPE_BAD_ALLOC;
+		m_message.clear();
+	}
+	catch (const std::exception& e)
+	{
+		m_type		= TYPE_TEST_ERROR;
+		m_message	= e.what();
+	}
+	catch (...)
+	{
+		m_type		= TYPE_TEST_ERROR;
+		m_message	= "Unknown exception";
+	}
+}
+
+void CapturedException::rethrow (void) const
+{
+	switch (m_type)
+	{
+		case TYPE_NONE:					return;
+		case TYPE_TEST_ERROR:			throw TestError(m_message);
+		case TYPE_INTERNAL_ERROR:		throw InternalError(m_message);
+		case TYPE_RESOURCE_ERROR:		throw ResourceError(m_message);
+		case TYPE_NOT_SUPPORTED_ERROR:	throw NotSupportedError(m_message);
+		case TYPE_TEST_EXCEPTION:		throw TestException(m_message, m_result);
+		case TYPE_BAD_ALLOC:			throw std::bad_alloc();
+		default:
+			DE_ASSERT(false);
+	}
+}
+
+namespace
+{
+
+class BatchExecution
+{
+public:
+	BatchExecution (int numItems, int batchSize, const BatchFunc& func)
+		: m_numItems	(numItems)
+		, m_batchSize	(batchSize)
+		, m_numBatches	(tcu::getNumBatches(numItems, batchSize))
+		, m_func		(func)
+		, m_nextBatch	(0)
+		, m_failed		(false)
+	{
+	}
+
+	int getNumBatches (void) const { return m_numBatches; }
+
+	//! Execute next unclaimed batch. Returns false if all batches have been claimed.
+	bool executeNext (void)
+	{
+		const int batchNdx = (int)deAtomicIncrementUint32(&m_nextBatch) - 1;
+
+		if (batchNdx >= m_numBatches)
+			return false;
+
+		if (!m_failed)
+		{
+			try
+			{
+				m_func(batchNdx, batchNdx*m_batchSize, de::min((batchNdx+1)*m_batchSize, m_numItems));
+			}
+			catch (...)
+			{
+				setError();
+			}
+		}
+
+		return true;
+	}
+
+	void checkError (void) const
+	{
+		m_error.rethrow();
+	}
+
+private:
+	//! Keep first exception. Must be called from a catch block.
+	void setError (void)
+	{
+		const de::ScopedLock lock (m_errorLock);
+
+		if (!m_failed)
+		{
+			m_error.capture();
+			m_failed = true;
+		}
+	}
+
+	const int				m_numItems;
+	const int				m_batchSize;
+	const int				m_numBatches;
+	const BatchFunc&		m_func;
+
+	volatile deUint32		m_nextBatch;
+	volatile bool			m_failed;
+	de::Mutex				m_errorLock;
+	CapturedException		m_error;
+};
+
+class BatchHelperTask : public WorkerPool::Task
+{
+public:
+	BatchHelperTask (void)
+		: m_execution	(DE_NULL)
+		, m_done		(DE_NULL)
+	{
+	}
+
+	BatchHelperTask (BatchExecution* execution, de::Semaphore* done)
+		: m_execution	(execution)
+		, m_done		(done)
+	{
+	}
+
+	void execute (void)
+	{
+		while (m_execution->executeNext());
+		m_done->increment();
+	}
+
+private:
+	BatchExecution*		m_execution;
+	de::Semaphore*		m_done;
+};
+
+} // anonymous
+
+void executeBatches (int numItems, int batchSize, const BatchFunc& func, qpWatchDog* watchDog)
+{
+	DE_ASSERT(numItems >= 0 && batchSize > 0);
+
+	BatchExecution					execution	(numItems, batchSize, func);
+	const bool						canUsePool	= execution.getNumBatches() > 1 && !WorkerPool::isWorkerThread();
+	WorkerPool*	const				pool		= canUsePool ? &getSharedWorkerPool() : DE_NULL;
+	const int						numHelpers	= pool ? de::min(pool->getNumThreads(), execution.getNumBatches() - 1) : 0;
+	de::Semaphore					done		(0);
+	std::vector<BatchHelperTask>	helpers		(numHelpers);
+
+	for (int ndx = 0; ndx < numHelpers; ndx++)
+	{
+		helpers[ndx] = BatchHelperTask(&execution, &done);
+		pool->submit(&helpers[ndx]);
+	}
+
+	while (execution.executeNext())
+	{
+		if (watchDog)
+			qpWatchDog_touch(watchDog);
+	}
+
+	// Wait for batches still being executed by helpers.
+	for (int ndx = 0; ndx < numHelpers; ndx++)
+		done.decrement();
+
+	execution.checkError();
+}
+
+} // tcu
@@ -0,0 +1,153 @@
+#ifndef _TCUWORKERPOOL_HPP
+#define _TCUWORKERPOOL_HPP
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Tester Core
+ * ----------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Worker thread pool for parallel verification.
+ *//*--------------------------------------------------------------------*/
+
+#include "tcuDefs.hpp"
+#include "deSharedPtr.hpp"
+#include "deThreadSafeRingBuffer.hpp"
+#include "qpWatchDog.h"
+
+#include <string>
+#include <vector>
+
+namespace tcu
+{
+
+class WorkerThread;
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Pool of worker threads executing submitted tasks
+ *
+ * Tasks are executed in submission order by whichever worker is free.
+ * Submitted tasks must stay alive until they have been executed.
+ *//*--------------------------------------------------------------------*/
+class WorkerPool
+{
+public:
+	class Task
+	{
+	public:
+		virtual			~Task		(void) {}
+		virtual void	execute		(void) = 0;
+	};
+
+	explicit						WorkerPool			(int numThreads);
+									~WorkerPool			(void);
+
+	int								getNumThreads		(void) const { return (int)m_threads.size(); }
+
+	void							submit				(Task* task);
+
+	//! Is the calling thread one of the worker threads of any pool?
+	static bool						isWorkerThread		(void);
+
+private:
+									WorkerPool			(const WorkerPool&);
+	WorkerPool&						operator=			(const WorkerPool&);
+
+	typedef de::ThreadSafeRingBuffer<Task*>	TaskQueue;
+
+	TaskQueue						m_tasks;
+	std::vector<de::SharedPtr<WorkerThread> >	m_threads;
+};
+
+//! Get process-wide worker pool. Pool has one thread less than there are available cores.
+WorkerPool&		getSharedWorkerPool		(void);
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Copy of an exception thrown on another thread
+ *
+ * capture() must be called from a catch block. rethrow() throws a new
+ * exception of the same tcu exception type and message, so that for
+ * example NotSupportedError still results in a not supported result when
+ * re-thrown in the calling thread. Exceptions of other types are
+ * re-thrown as TestError, except std::bad_alloc which is kept as is.
+ *//*--------------------------------------------------------------------*/
+class CapturedException
+{
+public:
+						CapturedException	(void);
+
+	//! Store copy of the exception currently being handled.
+	void				capture				(void);
+
+	bool				isCaptured			(void) const { return m_type != TYPE_NONE;	}
+
+	//! Throw copy of the captured exception, if any.
+	void				rethrow				(void) const;
+
+private:
+	enum Type
+	{
+		TYPE_NONE = 0,
+		TYPE_TEST_ERROR,
+		TYPE_INTERNAL_ERROR,
+		TYPE_RESOURCE_ERROR,
+		TYPE_NOT_SUPPORTED_ERROR,
+		TYPE_TEST_EXCEPTION,
+		TYPE_BAD_ALLOC,
+
+		TYPE_LAST
+	};
+
+	Type				m_type;
+	qpTestResult		m_result;			//!< Result of TYPE_TEST_EXCEPTION
+	std::string			m_message;
+};
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Function executed over a range of items in batches
+ *
+ * Batches are executed concurrently and in unspecified order, so
+ * implementations must only write to disjoint outputs per batch.
+ *//*--------------------------------------------------------------------*/
+class BatchFunc
+{
+public:
+	virtual			~BatchFunc		(void) {}
+	virtual void	operator()		(int batchNdx, int begin, int end) const = 0;
+};
+
+inline int getNumBatches (int numItems, int batchSize)
+{
+	return (numItems + batchSize - 1) / batchSize;
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Execute function over numItems items in batches of batchSize
+ *
+ * Batches are distributed to the shared worker pool, and the calling
+ * thread executes batches as well. Watchdog is touched by the calling
+ * thread after each batch it completes. When called from a worker thread
+ * or when pool has no threads, all batches are executed by the calling
+ * thread in order.
+ *
+ * First exception thrown by the function is re-thrown in the calling
+ * thread once all batches have finished, see CapturedException.
+ *//*--------------------------------------------------------------------*/
+void			executeBatches			(int numItems, int batchSize, const BatchFunc& func, qpWatchDog* watchDog);
+
+} // tcu
+
+#endif // _TCUWORKERPOOL_HPP
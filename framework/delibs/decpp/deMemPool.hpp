@@ -38,6 +38,7 @@ class MemPool
 {
 public:
 					MemPool					(const deMemPoolUtil* util = DE_NULL, deUint32 flags = 0u);
+	explicit		MemPool					(const deMemPoolPageConfig& config);
 					MemPool					(MemPool* parent);
 					~MemPool				(void);
 
@@ -47,6 +48,10 @@ public:
 
 	deUintptr		getNumAllocatedBytes	(bool recurse) const	{ return deMemPool_getNumAllocatedBytes(m_pool, recurse ? DE_TRUE : DE_FALSE);	}
 	deUintptr		getCapacity				(bool recurse) const	{ return deMemPool_getCapacity(m_pool, recurse ? DE_TRUE : DE_FALSE);			}
+	deMemPoolStats	getStats				(bool recurse) const;
+
+	//! Invalidate all allocations but keep pages for reuse (see deMemPool_reset()).
+	void			reset					(void)					{ deMemPool_reset(m_pool);														}
 
 	void*			alloc					(deUintptr numBytes);
 	void*			alignedAlloc			(deUintptr numBytes, deUint32 alignBytes);
@@ -71,6 +76,13 @@ inline MemPool::MemPool (const deMemPoolUtil* util, deUint32 flags)
 		throw std::bad_alloc();
 }
 
+inline MemPool::MemPool (const deMemPoolPageConfig& config)
+{
+	m_pool = deMemPool_createRootWithConfig(DE_NULL, 0u, &config);
+	if (!m_pool)
+		throw std::bad_alloc();
+}
+
 inline MemPool::MemPool (MemPool* parent)
 {
 	m_pool = deMemPool_create(parent->m_pool);
@@ -83,6 +95,13 @@ inline MemPool::~MemPool (void)
 	deMemPool_destroy(m_pool);
 }
 
+inline deMemPoolStats MemPool::getStats (bool recurse) const
+{
+	deMemPoolStats stats;
+	deMemPool_getStats(m_pool, recurse ? DE_TRUE : DE_FALSE, &stats);
+	return stats;
+}
+
 inline void* MemPool::alloc (deUintptr numBytes)
 {
 	// \todo [2013-02-07 pyry] Use deUintptr in deMemPool.
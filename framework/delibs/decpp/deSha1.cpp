@@ -44,6 +44,14 @@ Sha1 Sha1::compute (size_t size, const void* data)
 	return Sha1(hash);
 }
 
+std::string Sha1::toString (void) const
+{
+	char buffer[40];
+
+	deSha1_render(&m_hash, buffer);
+	return std::string(buffer, DE_LENGTH_OF_ARRAY(buffer));
+}
+
 Sha1Stream::Sha1Stream (void)
 {
 	deSha1Stream_init(&m_stream);
@@ -34,8 +34,6 @@
 
 enum
 {
-	INITIAL_PAGE_SIZE		= 128,		/*!< Size for the first allocated memory page.			*/
-	MAX_PAGE_SIZE			= 8096,		/*!< Maximum size for a memory page.					*/
 	MEM_PAGE_BASE_ALIGN		= 4			/*!< Base alignment guarantee for mem page data ptr.	*/
 };
 
@@ -94,6 +92,16 @@ struct deMemPool_s
 	deMemPool*		nextPool;			/*!< Next pool in parent's linked list.				*/
 
 	MemPage*		currentPage;		/*!< Current memory page from which to allocate.	*/
+	MemPage*		freePages;			/*!< Pages released by reset, kept for reuse.		*/
+	MemPage*		reservedPage;		/*!< Page holding pool internals (kept on reset).	*/
+	int				reservedBytes;		/*!< Bytes of reservedPage used by pool internals.	*/
+	int				initialPageSize;	/*!< Size of the first page.						*/
+	int				maxPageSize;		/*!< Maximum size for a grown page.					*/
+
+	int				numAllocs;			/*!< Number of allocations made.					*/
+	int				numPagesCreated;	/*!< Number of pages allocated from the system.		*/
+	int				numPagesReused;		/*!< Number of pages taken from freePages.			*/
+	int				numResets;			/*!< Number of deMemPool_reset() calls.				*/
 
 #if defined(DE_SUPPORT_FAILING_POOL_ALLOC)
 	deBool			allowFailing;		/*!< Is allocation failure simulation enabled?		*/
@@ -155,21 +163,42 @@ static void MemPage_destroy (MemPage* page)
 #if defined(DE_DEBUG)
 	/* Fill with garbage to hopefully catch dangling pointer bugs easier. */
 	deUint8* dataPtr = (deUint8*)(page + 1);
-	memset(dataPtr, 0xCD, (size_t)page->capacity);
+	memset(dataPtr, 0xCD, (size_t)page->bytesAllocated);
 #endif
 	deFree(page);
 }
 
+/*--------------------------------------------------------------------*//*!
+ * \internal
+ * \brief Release a used memory page for reuse.
+ * \param page		Memory page to release.
+ * \param keepBytes	Number of bytes at the start of the page to keep.
+ *
+ * In debug builds the released part of the page is filled with garbage
+ * just like on MemPage_destroy().
+ *//*--------------------------------------------------------------------*/
+static void MemPage_release (MemPage* page, int keepBytes)
+{
+	DE_ASSERT(deInRange32(keepBytes, 0, page->bytesAllocated));
+#if defined(DE_DEBUG)
+	memset((deUint8*)(page + 1) + keepBytes, 0xCD, (size_t)(page->bytesAllocated - keepBytes));
+#endif
+	page->bytesAllocated = keepBytes;
+}
+
 /*--------------------------------------------------------------------*//*!
  * \internal
  * \brief Internal function for creating a new memory pool.
  * \param parent	Parent pool (may be null).
+ * \param config	Page configuration (only used for root pools).
  * \return The created memory pool (or null on failure).
  *//*--------------------------------------------------------------------*/
-static deMemPool* createPoolInternal (deMemPool* parent)
+static deMemPool* createPoolInternal (deMemPool* parent, const deMemPoolPageConfig* config)
 {
 	deMemPool*	pool;
 	MemPage*	initialPage;
+	int			initialPageSize	= parent ? parent->initialPageSize	: config->initialPageSize;
+	int			maxPageSize		= parent ? parent->maxPageSize		: config->maxPageSize;
 
 #if defined(DE_SUPPORT_FAILING_POOL_ALLOC)
 	if (parent && parent->allowFailing)
@@ -179,8 +208,11 @@ static deMemPool* createPoolInternal (deMemPool* parent)
 	}
 #endif
 
+	DE_ASSERT(initialPageSize > 0 && maxPageSize > 0);
+
 	/* Init first page. */
-	initialPage = MemPage_create(INITIAL_PAGE_SIZE);
+	initialPageSize	= deMax32(initialPageSize, (int)sizeof(deMemPool));
+	initialPage		= MemPage_create((size_t)initialPageSize);
 	if (!initialPage)
 		return DE_NULL;
 
@@ -190,7 +222,12 @@ static deMemPool* createPoolInternal (deMemPool* parent)
 	initialPage->bytesAllocated += (int)sizeof(deMemPool);
 
 	memset(pool, 0, sizeof(deMemPool));
-	pool->currentPage = initialPage;
+	pool->currentPage		= initialPage;
+	pool->reservedPage		= initialPage;
+	pool->reservedBytes		= initialPage->bytesAllocated;
+	pool->initialPageSize	= initialPageSize;
+	pool->maxPageSize		= maxPageSize;
+	pool->numPagesCreated	= 1;
 
 	/* Register to parent. */
 	pool->parent = parent;
@@ -240,7 +277,24 @@ static deMemPool* createPoolInternal (deMemPool* parent)
  *//*--------------------------------------------------------------------*/
 deMemPool* deMemPool_createRoot	(const deMemPoolUtil* util, deUint32 flags)
 {
-	deMemPool* pool = createPoolInternal(DE_NULL);
+	return deMemPool_createRootWithConfig(util, flags, DE_NULL);
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Create a new root memory pool with custom page growth policy.
+ * \param util		Utilities (may be null).
+ * \param flags		Pool flags.
+ * \param config	Page growth policy (null for default).
+ * \return The created memory pool (or null on failure).
+ *
+ * Pools that hold large containers benefit from a large maxPageSize
+ * (such as DE_MEMPOOL_LARGE_MAX_PAGE_SIZE), as it reduces the number of
+ * page allocations made while the containers grow.
+ *//*--------------------------------------------------------------------*/
+deMemPool* deMemPool_createRootWithConfig (const deMemPoolUtil* util, deUint32 flags, const deMemPoolPageConfig* config)
+{
+	static const deMemPoolPageConfig	s_defaultConfig	= { DE_MEMPOOL_DEFAULT_INITIAL_PAGE_SIZE, DE_MEMPOOL_DEFAULT_MAX_PAGE_SIZE };
+	deMemPool*							pool			= createPoolInternal(DE_NULL, config ? config : &s_defaultConfig);
 	if (!pool)
 		return DE_NULL;
 #if defined(DE_SUPPORT_FAILING_POOL_ALLOC)
@@ -269,6 +323,10 @@ deMemPool* deMemPool_createRoot	(const deMemPoolUtil* util, deUint32 flags)
 
 		memcpy(utilCopy, util, sizeof(deMemPoolUtil));
 		pool->util = utilCopy;
+
+		/* Utilities must survive deMemPool_reset(). */
+		pool->reservedPage	= pool->currentPage;
+		pool->reservedBytes	= pool->currentPage->bytesAllocated;
 	}
 
 	return pool;
@@ -282,12 +340,60 @@ deMemPool* deMemPool_create (deMemPool* parent)
 {
 	deMemPool* pool;
 	DE_ASSERT(parent);
-	pool = createPoolInternal(parent);
+	pool = createPoolInternal(parent, DE_NULL);
 	if (!pool && parent->util)
 		parent->util->allocFailCallback(parent->util->userPointer);
 	return pool;
 }
 
+#if defined(DE_SUPPORT_POOL_MEMORY_TRACKING)
+static void updateMemoryTracking (deMemPool* pool)
+{
+	deMemPool* root = pool;
+	while (root->parent)
+		root = root->parent;
+	root->maxMemoryAllocated	= deMax32(root->maxMemoryAllocated, deMemPool_getNumAllocatedBytes(root, DE_TRUE));
+	root->maxMemoryCapacity		= deMax32(root->maxMemoryCapacity, deMemPool_getCapacity(root, DE_TRUE));
+}
+#endif
+
+static void destroyChildren (deMemPool* pool)
+{
+	deMemPool* iter = pool->firstChild;
+	deMemPool* iterNext;
+
+	while (iter)
+	{
+		iterNext = iter->nextPool;
+		deMemPool_destroy(iter);
+		iter = iterNext;
+	}
+
+	DE_ASSERT(pool->numChildren == 0);
+	DE_ASSERT(!pool->firstChild);
+}
+
+#if defined(DE_SUPPORT_DEBUG_POOLS)
+static void freeDebugAllocs (deMemPool* pool)
+{
+	if (pool->enableDebugAllocs)
+	{
+		DebugAlloc* alloc	= pool->debugAllocListHead;
+		DebugAlloc* next;
+
+		while (alloc)
+		{
+			next = alloc->next;
+			deAlignedFree(alloc->memPtr);
+			deFree(alloc);
+			alloc = next;
+		}
+
+		pool->debugAllocListHead = DE_NULL;
+	}
+}
+#endif
+
 /*--------------------------------------------------------------------*//*!
  * \brief Destroy a memory pool.
  * \param pool	Pool to be destroyed.
@@ -297,31 +403,13 @@ deMemPool* deMemPool_create (deMemPool* parent)
  *//*--------------------------------------------------------------------*/
 void deMemPool_destroy (deMemPool* pool)
 {
-	deMemPool* iter;
-	deMemPool* iterNext;
-
 #if defined(DE_SUPPORT_POOL_MEMORY_TRACKING)
 	/* Update memory consumption statistics. */
 	if (pool->parent)
-	{
-		deMemPool* root = pool->parent;
-		while (root->parent)
-			root = root->parent;
-		root->maxMemoryAllocated	= deMax32(root->maxMemoryAllocated, deMemPool_getNumAllocatedBytes(root, DE_TRUE));
-		root->maxMemoryCapacity		= deMax32(root->maxMemoryCapacity, deMemPool_getCapacity(root, DE_TRUE));
-	}
+		updateMemoryTracking(pool);
 #endif
 
-	/* Destroy all children. */
-	iter = pool->firstChild;
-	while (iter)
-	{
-		iterNext = iter->nextPool;
-		deMemPool_destroy(iter);
-		iter = iterNext;
-	}
-
-	DE_ASSERT(pool->numChildren == 0);
+	destroyChildren(pool);
 
 	/* Update pointers. */
 	if (pool->prevPool) pool->prevPool->nextPool = pool->nextPool;
@@ -338,28 +426,13 @@ void deMemPool_destroy (deMemPool* pool)
 	}
 
 #if defined(DE_SUPPORT_DEBUG_POOLS)
-	/* Free all debug allocations. */
-	if (pool->enableDebugAllocs)
-	{
-		DebugAlloc* alloc	= pool->debugAllocListHead;
-		DebugAlloc* next;
-
-		while (alloc)
-		{
-			next = alloc->next;
-			deAlignedFree(alloc->memPtr);
-			deFree(alloc);
-			alloc = next;
-		}
-
-		pool->debugAllocListHead = DE_NULL;
-	}
+	freeDebugAllocs(pool);
 #endif
 
 	/* Free pages. */
 	/* \note Pool itself is allocated from first page, so we must not touch the pool after freeing the page! */
 	{
-		MemPage* page = pool->currentPage;
+		MemPage* page = pool->freePages;
 		MemPage* nextPage;
 
 		while (page)
@@ -368,9 +441,62 @@ void deMemPool_destroy (deMemPool* pool)
 			MemPage_destroy(page);
 			page = nextPage;
 		}
+
+		page = pool->currentPage;
+
+		while (page)
+		{
+			nextPage = page->nextPage;
+			MemPage_destroy(page);
+			page = nextPage;
+		}
 	}
 }
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Reset a memory pool.
+ * \param pool	Pool to be reset.
+ *
+ * Invalidates all the memory allocated from the pool and destroys any
+ * child pools, but keeps the pages of the pool itself for later
+ * allocations. This allows reusing a single pool for a sequence of
+ * similar workloads (such as per-test case data) without paying for
+ * page allocation again.
+ *//*--------------------------------------------------------------------*/
+void deMemPool_reset (deMemPool* pool)
+{
+	MemPage* page;
+	MemPage* nextPage;
+
+#if defined(DE_SUPPORT_POOL_MEMORY_TRACKING)
+	updateMemoryTracking(pool);
+#endif
+
+	destroyChildren(pool);
+
+#if defined(DE_SUPPORT_DEBUG_POOLS)
+	freeDebugAllocs(pool);
+#endif
+
+	/* Move pages allocated after pool internals to the free list. */
+	/* \note Pages are pushed newest-first so that the oldest (smallest) page is reused first. */
+	page = pool->currentPage;
+	while (page != pool->reservedPage)
+	{
+		nextPage = page->nextPage;
+
+		MemPage_release(page, 0);
+		page->nextPage	= pool->freePages;
+		pool->freePages	= page;
+
+		page = nextPage;
+	}
+
+	MemPage_release(pool->reservedPage, pool->reservedBytes);
+	pool->currentPage = pool->reservedPage;
+	pool->numResets++;
+}
+
 /*--------------------------------------------------------------------*//*!
  * \brief Get the number of children for a pool.
  * \return The number of (immediate) child pools a memory pool has.
@@ -413,6 +539,9 @@ int deMemPool_getCapacity (const deMemPool* pool, deBool recurse)
 	for (memPage = pool->currentPage; memPage; memPage = memPage->nextPage)
 		numCapacityBytes += memPage->capacity;
 
+	for (memPage = pool->freePages; memPage; memPage = memPage->nextPage)
+		numCapacityBytes += memPage->capacity;
+
 	if (recurse)
 	{
 		deMemPool* child;
@@ -423,10 +552,47 @@ int deMemPool_getCapacity (const deMemPool* pool, deBool recurse)
 	return numCapacityBytes;
 }
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Get allocation statistics for a pool.
+ * \param pool		Pool pointer.
+ * \param recurse	Is operation recursive to child pools?
+ * \param stats		Statistics output.
+ *//*--------------------------------------------------------------------*/
+void deMemPool_getStats (const deMemPool* pool, deBool recurse, deMemPoolStats* stats)
+{
+	memset(stats, 0, sizeof(deMemPoolStats));
+
+	stats->numAllocs			= pool->numAllocs;
+	stats->numPagesCreated		= pool->numPagesCreated;
+	stats->numPagesReused		= pool->numPagesReused;
+	stats->numResets			= pool->numResets;
+	stats->numAllocatedBytes	= deMemPool_getNumAllocatedBytes(pool, DE_FALSE);
+	stats->capacity				= deMemPool_getCapacity(pool, DE_FALSE);
+
+	if (recurse)
+	{
+		deMemPool* child;
+		for (child = pool->firstChild; child; child = child->nextPool)
+		{
+			deMemPoolStats childStats;
+			deMemPool_getStats(child, DE_TRUE, &childStats);
+
+			stats->numAllocs			+= childStats.numAllocs;
+			stats->numPagesCreated		+= childStats.numPagesCreated;
+			stats->numPagesReused		+= childStats.numPagesReused;
+			stats->numResets			+= childStats.numResets;
+			stats->numAllocatedBytes	+= childStats.numAllocatedBytes;
+			stats->capacity				+= childStats.capacity;
+		}
+	}
+}
+
 DE_INLINE void* deMemPool_allocInternal (deMemPool* pool, size_t numBytes, deUint32 alignBytes)
 {
 	MemPage* curPage = pool->currentPage;
 
+	pool->numAllocs++;
+
 #if defined(DE_SUPPORT_FAILING_POOL_ALLOC)
 	if (pool->allowFailing)
 	{
@@ -467,11 +633,25 @@ DE_INLINE void* deMemPool_allocInternal (deMemPool* pool, size_t numBytes, deUin
 		{
 			/* Does not fit to current page. */
 			int		maxAlignPadding		= deMax32(0, ((int)alignBytes)-MEM_PAGE_BASE_ALIGN);
-			int		newPageCapacity		= deMax32(deMin32(2*curPage->capacity, MAX_PAGE_SIZE), ((int)numBytes)+maxAlignPadding);
-
-			curPage = MemPage_create((size_t)newPageCapacity);
-			if (!curPage)
-				return DE_NULL;
+			int		minPageCapacity		= ((int)numBytes)+maxAlignPadding;
+
+			if (pool->freePages && pool->freePages->capacity >= minPageCapacity)
+			{
+				/* Reuse page released by deMemPool_reset(). */
+				curPage				= pool->freePages;
+				pool->freePages		= curPage->nextPage;
+				pool->numPagesReused++;
+			}
+			else
+			{
+				int newPageCapacity = deMax32(deMin32(2*curPage->capacity, pool->maxPageSize), minPageCapacity);
+
+				curPage = MemPage_create((size_t)newPageCapacity);
+				if (!curPage)
+					return DE_NULL;
+
+				pool->numPagesCreated++;
+			}
 
 			curPage->nextPage	= pool->currentPage;
 			pool->currentPage	= curPage;
@@ -593,3 +773,59 @@ int deMemPool_getMaxCapacity (const deMemPool* pool)
 }
 
 #endif
+
+/*--------------------------------------------------------------------*//*!
+ * \internal
+ * \brief Test memory pool reset and page configuration.
+ *//*--------------------------------------------------------------------*/
+void deMemPool_selfTest (void)
+{
+	const deMemPoolPageConfig	config	= { 256, DE_MEMPOOL_LARGE_MAX_PAGE_SIZE };
+	deMemPool*					root	= deMemPool_createRootWithConfig(DE_NULL, 0, &config);
+	deMemPoolStats				stats;
+	int							iter;
+	int							i;
+
+	DE_TEST_ASSERT(root);
+
+	for (iter = 0; iter < 4; iter++)
+	{
+		deMemPool* child = deMemPool_create(root);
+		DE_TEST_ASSERT(child);
+		DE_TEST_ASSERT(deMemPool_getNumChildren(root) == 1);
+
+		for (i = 0; i < 1000; i++)
+		{
+			deUint8* ptr = (deUint8*)deMemPool_alloc(root, (size_t)(1 + (i % 57)));
+			DE_TEST_ASSERT(ptr);
+			memset(ptr, iter, (size_t)(1 + (i % 57)));
+		}
+
+		/* Aligned allocation larger than max page size. */
+		{
+			void* ptr = deMemPool_alignedAlloc(root, DE_MEMPOOL_LARGE_MAX_PAGE_SIZE + 1, 64);
+			DE_TEST_ASSERT(ptr && deIsAlignedPtr(ptr, 64));
+		}
+
+		DE_TEST_ASSERT(deMemPool_alloc(child, 100));
+
+		deMemPool_getStats(root, DE_TRUE, &stats);
+		DE_TEST_ASSERT(stats.numResets == iter);
+		DE_TEST_ASSERT(stats.numAllocs >= 1002);
+		DE_TEST_ASSERT(stats.numAllocatedBytes == deMemPool_getNumAllocatedBytes(root, DE_TRUE));
+		DE_TEST_ASSERT(stats.capacity == deMemPool_getCapacity(root, DE_TRUE));
+
+		deMemPool_reset(root);
+		DE_TEST_ASSERT(deMemPool_getNumChildren(root) == 0);
+	}
+
+	deMemPool_getStats(root, DE_FALSE, &stats);
+	DE_TEST_ASSERT(stats.numResets == 4);
+
+	/* Identical workloads after the first one should not need new pages. */
+	DE_TEST_ASSERT(stats.numPagesReused > 0);
+	DE_TEST_ASSERT(stats.numPagesReused == 3 * (stats.numPagesCreated - 1));
+	DE_TEST_ASSERT(stats.numAllocatedBytes <= config.initialPageSize);
+
+	deMemPool_destroy(root);
+}
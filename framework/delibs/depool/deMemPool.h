@@ -44,7 +44,11 @@ typedef enum deMemPoolFlag_e
 
 enum
 {
-	DE_POOL_DEFAULT_ALLOC_ALIGNMENT = DE_PTR_SIZE		/*!< Default alignment for pool allocations (in bytes). */
+	DE_POOL_DEFAULT_ALLOC_ALIGNMENT		= DE_PTR_SIZE,		/*!< Default alignment for pool allocations (in bytes). */
+
+	DE_MEMPOOL_DEFAULT_INITIAL_PAGE_SIZE	= 128,			/*!< Default size for the first page of a pool (in bytes). */
+	DE_MEMPOOL_DEFAULT_MAX_PAGE_SIZE		= 8096,			/*!< Default maximum size for a grown page (in bytes). */
+	DE_MEMPOOL_LARGE_MAX_PAGE_SIZE			= 64*1024		/*!< Suggested maximum page size for pools holding large containers. */
 };
 
 /** Macro for allocating a new struct from a pool (leaves it uninitialized!). */
@@ -58,16 +62,46 @@ typedef struct deMemPoolUtil_s
 	deMemPoolAllocFailFunc		allocFailCallback;
 } deMemPoolUtil;
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Page growth policy for a pool hierarchy.
+ *
+ * Each pool starts with a page of initialPageSize bytes and doubles the
+ * page size on every new page until maxPageSize is reached. Allocations
+ * larger than maxPageSize always get a page of their own. The policy is
+ * inherited by all child pools.
+ *//*--------------------------------------------------------------------*/
+typedef struct deMemPoolPageConfig_s
+{
+	int							initialPageSize;
+	int							maxPageSize;
+} deMemPoolPageConfig;
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Pool allocation statistics.
+ *//*--------------------------------------------------------------------*/
+typedef struct deMemPoolStats_s
+{
+	int							numAllocs;			/*!< Number of allocations made since pool creation.		*/
+	int							numPagesCreated;	/*!< Number of pages allocated from the system.				*/
+	int							numPagesReused;		/*!< Number of pages reused after deMemPool_reset().		*/
+	int							numResets;			/*!< Number of times deMemPool_reset() has been called.		*/
+	int							numAllocatedBytes;	/*!< Bytes currently allocated by the user.					*/
+	int							capacity;			/*!< Bytes currently held by the pool, including free pages.	*/
+} deMemPoolStats;
+
 typedef struct deMemPool_s deMemPool;
 
 DE_BEGIN_EXTERN_C
 
 deMemPool*	deMemPool_createRoot				(const deMemPoolUtil* util, deUint32 flags);
+deMemPool*	deMemPool_createRootWithConfig		(const deMemPoolUtil* util, deUint32 flags, const deMemPoolPageConfig* config);
 deMemPool*	deMemPool_create					(deMemPool* parent);
 void		deMemPool_destroy					(deMemPool* pool);
+void		deMemPool_reset						(deMemPool* pool);
 int			deMemPool_getNumChildren			(const deMemPool* pool);
 int			deMemPool_getNumAllocatedBytes		(const deMemPool* pool, deBool recurse);
 int			deMemPool_getCapacity				(const deMemPool* pool, deBool recurse);
+void		deMemPool_getStats					(const deMemPool* pool, deBool recurse, deMemPoolStats* stats);
 
 void*		deMemPool_alloc						(deMemPool* pool, size_t numBytes);
 void*		deMemPool_alignedAlloc				(deMemPool* pool, size_t numBytes, deUint32 alignBytes);
@@ -80,6 +114,8 @@ int			deMemPool_getMaxNumAllocatedBytes	(const deMemPool* pool);
 int			deMemPool_getMaxCapacity			(const deMemPool* pool);
 #endif
 
+void		deMemPool_selfTest					(void);
+
 DE_END_EXTERN_C
 
 #endif /* _DEMEMPOOL_H */
@@ -0,0 +1,305 @@
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program OpenGL ES Utilities
+ * ------------------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Persistent cache of linked GL program binaries.
+ *
+ * Cache file is a sequence of chunks:
+ *
+ *   deUint32	chunk size in bytes, including this field
+ *   char[40]	key (SHA-1 as hex string)
+ *   deUint32	binary format
+ *   deUint32	binary length
+ *   deUint8[]	binary
+ *
+ * Later chunks with the same key override earlier ones. Each chunk is
+ * appended with a single write, so the file can be shared by processes
+ * running at the same time.
+ *//*--------------------------------------------------------------------*/
+
+#include "gluProgramBinaryCache.hpp"
+#include "gluShaderProgram.hpp"
+#include "gluRenderContext.hpp"
+#include "gluContextInfo.hpp"
+#include "glwFunctions.hpp"
+#include "glwEnums.hpp"
+#include "tcuTestLog.hpp"
+#include "deSha1.hpp"
+#include "deFilePath.hpp"
+#include "deMemory.h"
+#include "deThreadLocal.hpp"
+
+#include <cstdio>
+#include <sstream>
+
+namespace glu
+{
+
+enum
+{
+	KEY_LENGTH			= 40,
+	CHUNK_HEADER_SIZE	= 4 + KEY_LENGTH + 4 + 4
+};
+
+static std::string getDriverFingerprint (const RenderContext& renderCtx, const ContextInfo& contextInfo)
+{
+	const char* const	vendor		= contextInfo.getString(GL_VENDOR);
+	const char* const	renderer	= contextInfo.getString(GL_RENDERER);
+	const char* const	version		= contextInfo.getString(GL_VERSION);
+	std::ostringstream	str;
+
+	str << renderCtx.getType().getAPI().getPacked() << " " << (deUint32)renderCtx.getType().getFlags() << "\n"
+		<< (vendor ? vendor : "") << "\n"
+		<< (renderer ? renderer : "") << "\n"
+		<< (version ? version : "") << "\n";
+
+	return str.str();
+}
+
+ProgramBinaryCache::ProgramBinaryCache (const RenderContext& renderCtx, const ContextInfo& contextInfo, const std::string& filename)
+	: m_gl					(renderCtx.getFunctions())
+	, m_filename			(filename)
+	, m_driverFingerprint	(getDriverFingerprint(renderCtx, contextInfo))
+	, m_isSupported			(false)
+{
+	if (m_gl.getProgramBinary && m_gl.programBinary)
+	{
+		glw::GLint numFormats = 0;
+
+		m_gl.getIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+
+		// Implementations that advertise no formats can't load anything back.
+		m_isSupported = (m_gl.getError() == GL_NO_ERROR && numFormats > 0);
+	}
+
+	if (m_isSupported)
+		readIndex();
+}
+
+ProgramBinaryCache::~ProgramBinaryCache (void)
+{
+}
+
+void ProgramBinaryCache::readIndex (void)
+{
+	FILE* const file = fopen(m_filename.c_str(), "rb");
+
+	if (!file)
+		return;
+
+	for (;;)
+	{
+		const long	offset		= ftell(file);
+		deUint32	chunkSize	= 0;
+		char		key[KEY_LENGTH];
+
+		if (fread(&chunkSize, 1, 4, file) != 4 || chunkSize < CHUNK_HEADER_SIZE)
+			break;
+
+		if (fread(key, 1, KEY_LENGTH, file) != KEY_LENGTH)
+			break;
+
+		if (fseek(file, offset + (long)chunkSize, SEEK_SET) != 0)
+			break;
+
+		m_index[std::string(key, KEY_LENGTH)] = (deUint32)offset;
+	}
+
+	fclose(file);
+}
+
+std::string ProgramBinaryCache::computeKey (const ProgramSources& sources) const
+{
+	de::Sha1Stream stream;
+
+	stream << m_driverFingerprint;
+
+	for (int shaderType = 0; shaderType < SHADERTYPE_LAST; shaderType++)
+		stream << sources.sources[shaderType];
+
+	stream << (deUint64)sources.attribLocationBindings.size();
+	for (std::vector<AttribLocationBinding>::const_iterator binding = sources.attribLocationBindings.begin(); binding != sources.attribLocationBindings.end(); ++binding)
+		stream << binding->name << binding->location;
+
+	stream << sources.transformFeedbackBufferMode
+		   << sources.transformFeedbackVaryings
+		   << sources.separable;
+
+	return stream.finalize().toString();
+}
+
+bool ProgramBinaryCache::load (const std::string& key, deUint32* binaryFormat, std::vector<deUint8>* binary)
+{
+	const de::ScopedLock						lock	(m_lock);
+	std::map<std::string, deUint32>::iterator	entry	= m_index.find(key);
+	bool										ok		= false;
+
+	DE_ASSERT(key.size() == KEY_LENGTH);
+
+	if (entry != m_index.end())
+	{
+		FILE* const	file		= fopen(m_filename.c_str(), "rb");
+		deUint32	chunkSize	= 0;
+		deUint32	length		= 0;
+		char		storedKey[KEY_LENGTH];
+
+		ok = file != DE_NULL;
+
+		if (ok) ok = fseek(file, (long)entry->second, SEEK_SET)				== 0;
+		if (ok) ok = fread(&chunkSize, 1, 4, file)							== 4;
+		if (ok) ok = fread(storedKey, 1, KEY_LENGTH, file)					== KEY_LENGTH;
+		if (ok) ok = key.compare(0, KEY_LENGTH, storedKey, KEY_LENGTH)		== 0;
+		if (ok) ok = fread(binaryFormat, 1, 4, file)						== 4;
+		if (ok) ok = fread(&length, 1, 4, file)								== 4;
+		if (ok) ok = length > 0 && length == chunkSize - CHUNK_HEADER_SIZE;
+		if (ok) binary->resize(length);
+		if (ok) ok = fread(&(*binary)[0], 1, length, file)					== length;
+
+		if (file)
+			fclose(file);
+
+		// Drop corrupted entries so that program gets stored again.
+		if (!ok)
+			m_index.erase(entry);
+	}
+
+	if (ok)
+		m_stats.numHits += 1;
+	else
+		m_stats.numMisses += 1;
+
+	return ok;
+}
+
+void ProgramBinaryCache::store (const std::string& key, deUint32 binaryFormat, const std::vector<deUint8>& binary)
+{
+	const de::ScopedLock	lock		(m_lock);
+	const de::FilePath		filePath	(m_filename);
+	const deUint32			length		= (deUint32)binary.size();
+	const deUint32			chunkSize	= CHUNK_HEADER_SIZE + length;
+	std::vector<deUint8>	chunk		(chunkSize);
+	FILE*					file		= DE_NULL;
+	long					endOffset	= -1;
+
+	DE_ASSERT(key.size() == KEY_LENGTH);
+
+	if (binary.empty())
+		return;
+
+	deMemcpy(&chunk[0],						&chunkSize,		4);
+	deMemcpy(&chunk[4],						key.c_str(),	KEY_LENGTH);
+	deMemcpy(&chunk[4 + KEY_LENGTH],		&binaryFormat,	4);
+	deMemcpy(&chunk[4 + KEY_LENGTH + 4],	&length,		4);
+	deMemcpy(&chunk[CHUNK_HEADER_SIZE],		&binary[0],		length);
+
+	if (!filePath.getDirName().empty() && !de::FilePath(filePath.getDirName()).exists())
+		de::createDirectoryAndParents(filePath.getDirName().c_str());
+
+	file = fopen(m_filename.c_str(), "ab");
+	if (!file)
+		return;
+
+	// Several processes, such as parallel test shards, may append to the same file. Writing the
+	// whole chunk with a single unbuffered write in append mode keeps chunks from interleaving,
+	// and the position after the write is the end of this chunk regardless of what others have
+	// appended before it. load() still checks the key and size stored at the offset.
+	setvbuf(file, DE_NULL, _IONBF, 0);
+
+	if (fwrite(&chunk[0], 1, chunk.size(), file) == chunk.size())
+		endOffset = ftell(file);
+
+	fclose(file);
+
+	if (endOffset >= (long)chunkSize)
+	{
+		m_index[key] = (deUint32)(endOffset - (long)chunkSize);
+		m_stats.numStored += 1;
+	}
+}
+
+void ProgramBinaryCache::reject (const std::string& key)
+{
+	const de::ScopedLock lock (m_lock);
+
+	// Rejected lookup was counted as a hit in load().
+	m_stats.numHits		-= 1;
+	m_stats.numMisses	+= 1;
+	m_stats.numRejected	+= 1;
+
+	m_index.erase(key);
+}
+
+ProgramBinaryCache::Statistics ProgramBinaryCache::getStatistics (void) const
+{
+	const de::ScopedLock lock (m_lock);
+	return m_stats;
+}
+
+void ProgramBinaryCache::logStatistics (tcu::TestLog& log, const Statistics& since) const
+{
+	const Statistics	stats		= getStatistics();
+	const int			numHits		= stats.numHits		- since.numHits;
+	const int			numMisses	= stats.numMisses	- since.numMisses;
+	const int			numRejected	= stats.numRejected	- since.numRejected;
+	const int			numStored	= stats.numStored	- since.numStored;
+
+	if (numHits + numMisses == 0)
+		return;
+
+	log << tcu::TestLog::Section("ProgramBinaryCache", "Program binary cache statistics")
+		<< tcu::TestLog::Integer("ProgramBinaryCacheHits",		"Programs loaded from binary cache",		"", QP_KEY_TAG_NONE, numHits)
+		<< tcu::TestLog::Integer("ProgramBinaryCacheMisses",	"Programs compiled from source",			"", QP_KEY_TAG_NONE, numMisses)
+		<< tcu::TestLog::Integer("ProgramBinaryCacheRejected",	"Cached binaries rejected by the driver",	"", QP_KEY_TAG_NONE, numRejected)
+		<< tcu::TestLog::Integer("ProgramBinaryCacheStored",	"Program binaries stored to cache",			"", QP_KEY_TAG_NONE, numStored)
+		<< tcu::TestLog::EndSection;
+}
+
+// Thread-local current cache.
+
+#if defined(DE_THREAD_LOCAL)
+
+DE_THREAD_LOCAL ProgramBinaryCache*	s_currentCache	= DE_NULL;
+
+void setCurrentThreadProgramBinaryCache (ProgramBinaryCache* cache)
+{
+	s_currentCache = cache;
+}
+
+ProgramBinaryCache* getCurrentThreadProgramBinaryCache (void)
+{
+	return s_currentCache;
+}
+
+#else // defined(DE_THREAD_LOCAL)
+
+static de::ThreadLocal s_currentCache;
+
+void setCurrentThreadProgramBinaryCache (ProgramBinaryCache* cache)
+{
+	s_currentCache.set(cache);
+}
+
+ProgramBinaryCache* getCurrentThreadProgramBinaryCache (void)
+{
+	return (ProgramBinaryCache*)s_currentCache.get();
+}
+
+#endif // defined(DE_THREAD_LOCAL)
+
+} // glu
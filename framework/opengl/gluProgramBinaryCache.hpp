@@ -0,0 +1,120 @@
+#ifndef _GLUPROGRAMBINARYCACHE_HPP
+#define _GLUPROGRAMBINARYCACHE_HPP
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program OpenGL ES Utilities
+ * ------------------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Persistent cache of linked GL program binaries.
+ *//*--------------------------------------------------------------------*/
+
+#include "gluDefs.hpp"
+#include "deMutex.hpp"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace tcu
+{
+class TestLog;
+}
+
+namespace glw
+{
+class Functions;
+}
+
+namespace glu
+{
+
+class RenderContext;
+class ContextInfo;
+struct ProgramSources;
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Program binary cache
+ *
+ * Stores linked program binaries obtained with glGetProgramBinary() in a
+ * chunked file, and restores them with glProgramBinary() when the same
+ * program is built again. Entries are keyed by a SHA-1 of the program
+ * sources, attribute bindings, transform feedback setup and a fingerprint
+ * of the driver (vendor, renderer and version strings), so binaries are
+ * never shared between implementations.
+ *
+ * The cache is bound to a single render context. ShaderProgram consults
+ * the cache installed for the current thread with
+ * setCurrentThreadProgramBinaryCache(), and only when it is built with the
+ * functions of that same context.
+ *
+ * \note Programs restored from a binary have their shader objects created
+ *       and attached, but not compiled.
+ *//*--------------------------------------------------------------------*/
+class ProgramBinaryCache
+{
+public:
+	struct Statistics
+	{
+		int							numHits;		//!< Programs restored from a binary.
+		int							numMisses;		//!< Programs not found in cache.
+		int							numRejected;	//!< Binaries rejected by the implementation.
+		int							numStored;		//!< Binaries written to cache.
+
+		Statistics (void) : numHits(0), numMisses(0), numRejected(0), numStored(0) {}
+	};
+
+									ProgramBinaryCache		(const RenderContext& renderCtx, const ContextInfo& contextInfo, const std::string& filename);
+									~ProgramBinaryCache		(void);
+
+	//! Does the context support retrieving and loading program binaries?
+	bool							isSupported				(void) const { return m_isSupported;	}
+	const glw::Functions&			getFunctions			(void) const { return m_gl;				}
+
+	std::string						computeKey				(const ProgramSources& sources) const;
+
+	bool							load					(const std::string& key, deUint32* binaryFormat, std::vector<deUint8>* binary);
+	void							store					(const std::string& key, deUint32 binaryFormat, const std::vector<deUint8>& binary);
+	void							reject					(const std::string& key);
+
+	Statistics						getStatistics			(void) const;
+
+	//! Log statistics accumulated since given snapshot, if the cache was used.
+	void							logStatistics			(tcu::TestLog& log, const Statistics& since) const;
+
+private:
+									ProgramBinaryCache		(const ProgramBinaryCache& other);
+	ProgramBinaryCache&				operator=				(const ProgramBinaryCache& other);
+
+	void							readIndex				(void);
+
+	const glw::Functions&			m_gl;
+	const std::string				m_filename;
+	std::string						m_driverFingerprint;
+	bool							m_isSupported;
+
+	mutable de::Mutex				m_lock;
+	std::map<std::string, deUint32>	m_index;		//!< Key -> offset of latest chunk in file.
+	Statistics						m_stats;
+};
+
+void					setCurrentThreadProgramBinaryCache	(ProgramBinaryCache* cache);
+ProgramBinaryCache*		getCurrentThreadProgramBinaryCache	(void);
+
+} // glu
+
+#endif // _GLUPROGRAMBINARYCACHE_HPP
@@ -23,6 +23,7 @@
 
 #include "gluShaderProgram.hpp"
 #include "gluRenderContext.hpp"
+#include "gluProgramBinaryCache.hpp"
 #include "glwFunctions.hpp"
 #include "glwEnums.hpp"
 #include "tcuTestLog.hpp"
@@ -191,6 +192,14 @@ void Shader::specialize (const char* entryPoint, glw::GLuint numSpecializationCo
 	}
 }
 
+void Shader::setPrecompiled (void)
+{
+	// Shader is part of a program restored from a program binary and is never compiled.
+	m_info.compileOk		= true;
+	m_info.compileTimeUs	= 0;
+	m_info.infoLog.clear();
+}
+
 // Program
 
 static bool getProgramLinkStatus (const glw::Functions& gl, deUint32 program)
@@ -301,6 +310,43 @@ void Program::link (void)
 	m_info.infoLog	= getProgramInfoLog(m_gl, m_program);
 }
 
+void Program::loadBinary (deUint32 binaryFormat, const void* binary, int length)
+{
+	m_info.linkOk		= false;
+	m_info.linkTimeUs	= 0;
+	m_info.infoLog.clear();
+
+	{
+		deUint64 linkStart = deGetMicroseconds();
+		m_gl.programBinary(m_program, binaryFormat, binary, length);
+		m_info.linkTimeUs = deGetMicroseconds() - linkStart;
+	}
+
+	// Format may have been dropped by the implementation (GL_INVALID_ENUM). Treat as failed link.
+	if (m_gl.getError() != GL_NO_ERROR)
+		return;
+
+	m_info.linkOk	= getProgramLinkStatus(m_gl, m_program);
+	m_info.infoLog	= getProgramInfoLog(m_gl, m_program);
+}
+
+static bool getProgramBinary (const glw::Functions& gl, deUint32 program, deUint32* binaryFormat, std::vector<deUint8>* binary)
+{
+	int binaryLength = 0;
+
+	gl.getProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+	if (gl.getError() != GL_NO_ERROR || binaryLength <= 0)
+		return false;
+
+	binary->resize(binaryLength);
+	gl.getProgramBinary(program, binaryLength, &binaryLength, binaryFormat, &(*binary)[0]);
+	if (gl.getError() != GL_NO_ERROR || binaryLength <= 0)
+		return false;
+
+	binary->resize(binaryLength);
+	return true;
+}
+
 bool Program::isSeparable (void) const
 {
 	int separable = GL_FALSE;
@@ -391,10 +437,17 @@ ShaderProgram::ShaderProgram (const glw::Functions& gl, const ProgramBinaries& b
 
 void ShaderProgram::init (const glw::Functions& gl, const ProgramSources& sources)
 {
+	ProgramBinaryCache* const	cache		= getCurrentThreadProgramBinaryCache();
+	const bool					useCache	= cache && cache->isSupported() && &cache->getFunctions() == &gl;
+	const std::string			cacheKey	= useCache ? cache->computeKey(sources) : std::string();
+
 	try
 	{
 		bool shadersOk = true;
 
+		if (useCache && initFromCache(gl, sources, *cache, cacheKey))
+			return;
+
 		for (int shaderType = 0; shaderType < SHADERTYPE_LAST; shaderType++)
 		{
 			for (int shaderNdx = 0; shaderNdx < (int)sources.sources[shaderType].size(); ++shaderNdx)
@@ -414,9 +467,7 @@ void ShaderProgram::init (const glw::Functions& gl, const ProgramSources& source
 
 		if (shadersOk)
 		{
-			for (int shaderType = 0; shaderType < SHADERTYPE_LAST; shaderType++)
-				for (int shaderNdx = 0; shaderNdx < (int)m_shaders[shaderType].size(); ++shaderNdx)
-					m_program.attachShader(m_shaders[shaderType][shaderNdx]->getShader());
+			attachShaders();
 
 			for (std::vector<AttribLocationBinding>::const_iterator binding = sources.attribLocationBindings.begin(); binding != sources.attribLocationBindings.end(); ++binding)
 				m_program.bindAttribLocation(binding->location, binding->name.c_str());
@@ -435,6 +486,15 @@ void ShaderProgram::init (const glw::Functions& gl, const ProgramSources& source
 				m_program.setSeparable(true);
 
 			m_program.link();
+
+			if (useCache && m_program.getLinkStatus())
+			{
+				deUint32				binaryFormat	= 0;
+				std::vector<deUint8>	binary;
+
+				if (getProgramBinary(gl, m_program.getProgram(), &binaryFormat, &binary))
+					cache->store(cacheKey, binaryFormat, binary);
+			}
 		}
 	}
 	catch (...)
@@ -446,6 +506,69 @@ void ShaderProgram::init (const glw::Functions& gl, const ProgramSources& source
 	}
 }
 
+bool ShaderProgram::initFromCache (const glw::Functions& gl, const ProgramSources& sources, ProgramBinaryCache& cache, const std::string& key)
+{
+	deUint32				binaryFormat	= 0;
+	std::vector<deUint8>	binary;
+
+	if (!cache.load(key, &binaryFormat, &binary))
+		return false;
+
+	// Shader objects are still created so that sources and shader info are available as usual.
+	for (int shaderType = 0; shaderType < SHADERTYPE_LAST; shaderType++)
+	{
+		for (int shaderNdx = 0; shaderNdx < (int)sources.sources[shaderType].size(); ++shaderNdx)
+		{
+			const char* source	= sources.sources[shaderType][shaderNdx].c_str();
+			const int	length	= (int)sources.sources[shaderType][shaderNdx].size();
+
+			m_shaders[shaderType].reserve(m_shaders[shaderType].size() + 1);
+
+			m_shaders[shaderType].push_back(new Shader(gl, ShaderType(shaderType)));
+			m_shaders[shaderType].back()->setSources(1, &source, &length);
+			m_shaders[shaderType].back()->setPrecompiled();
+		}
+	}
+
+	attachShaders();
+
+	if (sources.separable)
+		m_program.setSeparable(true);
+
+	m_program.loadBinary(binaryFormat, &binary[0], (int)binary.size());
+
+	if (m_program.getLinkStatus())
+		return true;
+
+	// Binary was rejected, for example after a driver update. Start over from sources.
+	cache.reject(key);
+	deleteShaders();
+
+	return false;
+}
+
+void ShaderProgram::attachShaders (void)
+{
+	for (int shaderType = 0; shaderType < SHADERTYPE_LAST; shaderType++)
+		for (int shaderNdx = 0; shaderNdx < (int)m_shaders[shaderType].size(); ++shaderNdx)
+			m_program.attachShader(m_shaders[shaderType][shaderNdx]->getShader());
+}
+
+void ShaderProgram::deleteShaders (void)
+{
+	for (int shaderType = 0; shaderType < SHADERTYPE_LAST; shaderType++)
+		for (int shaderNdx = 0; shaderNdx < (int)m_shaders[shaderType].size(); ++shaderNdx)
+			m_program.detachShader(m_shaders[shaderType][shaderNdx]->getShader());
+
+	for (int shaderType = 0; shaderType < SHADERTYPE_LAST; shaderType++)
+	{
+		for (int shaderNdx = 0; shaderNdx < (int)m_shaders[shaderType].size(); ++shaderNdx)
+			delete m_shaders[shaderType][shaderNdx];
+
+		m_shaders[shaderType].clear();
+	}
+}
+
 void ShaderProgram::init (const glw::Functions& gl, const ProgramBinaries& binaries)
 {
 	try
@@ -40,6 +40,7 @@ namespace glu
 {
 
 class RenderContext;
+class ProgramBinaryCache;
 
 typedef std::vector<deUint32> ShaderBinaryDataType;
 
@@ -92,6 +93,7 @@ public:
 	void					compile				(void);
 	void					specialize			(const char* entryPoint, glw::GLuint numSpecializationConstants,
 												 const glw::GLuint* constantIndex, const glw::GLuint* constantValue);
+	void					setPrecompiled		(void);
 
 	deUint32				getShader			(void) const { return m_shader;				}
 	const ShaderInfo&		getInfo				(void) const { return m_info;				}
@@ -130,6 +132,7 @@ public:
 	void					transformFeedbackVaryings	(int count, const char* const* varyings, deUint32 bufferMode);
 
 	void					link						(void);
+	void					loadBinary					(deUint32 binaryFormat, const void* binary, int length);
 
 	deUint32				getProgram					(void) const { return m_program;			}
 	const ProgramInfo&		getInfo						(void) const { return m_info;				}
@@ -210,6 +213,9 @@ private:
 	void					init						(const glw::Functions& gl, const ProgramSources& sources);
 	void					init						(const glw::Functions& gl, const ProgramBinaries& binaries);
 	void					setBinary					(const glw::Functions& gl, std::vector<Shader*>& shaders, glw::GLenum binaryFormat, const void* binaryData, const int length);
+	bool					initFromCache				(const glw::Functions& gl, const ProgramSources& sources, ProgramBinaryCache& cache, const std::string& key);
+	void					attachShaders				(void);
+	void					deleteShaders				(void);
 
 	std::vector<Shader*>	m_shaders[SHADERTYPE_LAST];
 	Program					m_program;
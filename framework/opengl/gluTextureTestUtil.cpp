@@ -29,8 +29,10 @@
 #include "tcuImageCompare.hpp"
 #include "tcuTestLog.hpp"
 #include "tcuVectorUtil.hpp"
+#include "tcuWorkerPool.hpp"
 
 #include "deMath.h"
+#include "deMutex.hpp"
 #include "deStringUtil.hpp"
 
 #include <string>
@@ -45,7 +47,9 @@ namespace TextureTestUtil
 
 enum
 {
-	MIN_SUBPIXEL_BITS	= 4
+	MIN_SUBPIXEL_BITS			= 4,
+	LOOKUP_DIFF_BAND_HEIGHT		= 4,	//!< Rows per parallel verification batch
+	PACKET_SIZE					= 16	//!< Lookups per Texture2DView::samplePacket() call
 };
 
 SamplerType getSamplerType (tcu::TextureFormat format)
@@ -357,6 +361,17 @@ static inline tcu::Vec4 execSample (const tcu::Texture2DView& src, const Referen
 		return src.sample(params.sampler, s, t, lod);
 }
 
+static void execSamplePacket (const tcu::Texture2DView& src, const ReferenceParams& params, tcu::Vec4* dst, const tcu::Vec2* coords, const float* lods, int numSamples)
+{
+	if (params.samplerType == SAMPLERTYPE_SHADOW)
+	{
+		for (int ndx = 0; ndx < numSamples; ndx++)
+			dst[ndx] = execSample(src, params, coords[ndx].x(), coords[ndx].y(), lods[ndx]);
+	}
+	else
+		src.samplePacket(dst, params.sampler, coords, lods, numSamples);
+}
+
 static inline tcu::Vec4 execSample (const tcu::TextureCubeView& src, const ReferenceParams& params, float s, float t, float r, float lod)
 {
 	if (params.samplerType == SAMPLERTYPE_SHADOW)
@@ -441,22 +456,35 @@ static void sampleTextureNonProjected (const tcu::SurfaceAccess& dst, const tcu:
 	float										triLod[2]			= { de::clamp(computeNonProjectedTriLod(params.lodMode, dstSize, srcSize, triS[0], triT[0]) + lodBias, params.minLod, params.maxLod),
 																		de::clamp(computeNonProjectedTriLod(params.lodMode, dstSize, srcSize, triS[1], triT[1]) + lodBias, params.minLod, params.maxLod) };
 
+	// Pixels are sampled in packets along each row.
+	tcu::Vec2									coords[PACKET_SIZE];
+	float										lods[PACKET_SIZE];
+	tcu::Vec4									colors[PACKET_SIZE];
+
 	for (int y = 0; y < dst.getHeight(); y++)
 	{
-		for (int x = 0; x < dst.getWidth(); x++)
+		for (int packetX = 0; packetX < dst.getWidth(); packetX += PACKET_SIZE)
 		{
-			float	yf		= ((float)y + 0.5f) / (float)dst.getHeight();
-			float	xf		= ((float)x + 0.5f) / (float)dst.getWidth();
+			const int	packetSize	= de::min<int>(PACKET_SIZE, dst.getWidth() - packetX);
 
-			int		triNdx	= xf + yf >= 1.0f ? 1 : 0; // Top left fill rule.
-			float	triX	= triNdx ? 1.0f-xf : xf;
-			float	triY	= triNdx ? 1.0f-yf : yf;
+			for (int ndx = 0; ndx < packetSize; ndx++)
+			{
+				float	yf		= ((float)y + 0.5f) / (float)dst.getHeight();
+				float	xf		= ((float)(packetX + ndx) + 0.5f) / (float)dst.getWidth();
 
-			float	s		= triangleInterpolate(triS[triNdx].x(), triS[triNdx].y(), triS[triNdx].z(), triX, triY);
-			float	t		= triangleInterpolate(triT[triNdx].x(), triT[triNdx].y(), triT[triNdx].z(), triX, triY);
-			float	lod		= triLod[triNdx];
+				int		triNdx	= xf + yf >= 1.0f ? 1 : 0; // Top left fill rule.
+				float	triX	= triNdx ? 1.0f-xf : xf;
+				float	triY	= triNdx ? 1.0f-yf : yf;
 
-			dst.setPixel(execSample(src, params, s, t, lod) * params.colorScale + params.colorBias, x, y);
+				coords[ndx]	= tcu::Vec2(triangleInterpolate(triS[triNdx].x(), triS[triNdx].y(), triS[triNdx].z(), triX, triY),
+										triangleInterpolate(triT[triNdx].x(), triT[triNdx].y(), triT[triNdx].z(), triX, triY));
+				lods[ndx]	= triLod[triNdx];
+			}
+
+			execSamplePacket(src, params, colors, coords, lods, packetSize);
+
+			for (int ndx = 0; ndx < packetSize; ndx++)
+				dst.setPixel(colors[ndx] * params.colorScale + params.colorBias, packetX + ndx, y);
 		}
 	}
 }
@@ -520,27 +548,40 @@ static void sampleTextureProjected (const tcu::SurfaceAccess& dst, const tcu::Te
 	tcu::Vec3									triV[2]				= { vq.swizzle(0, 1, 2), vq.swizzle(3, 2, 1) };
 	tcu::Vec3									triW[2]				= { params.w.swizzle(0, 1, 2), params.w.swizzle(3, 2, 1) };
 
+	// Pixels are sampled in packets along each row.
+	tcu::Vec2									coords[PACKET_SIZE];
+	float										lods[PACKET_SIZE];
+	tcu::Vec4									colors[PACKET_SIZE];
+
 	for (int py = 0; py < dst.getHeight(); py++)
 	{
-		for (int px = 0; px < dst.getWidth(); px++)
+		for (int packetX = 0; packetX < dst.getWidth(); packetX += PACKET_SIZE)
 		{
-			float	wx		= (float)px + 0.5f;
-			float	wy		= (float)py + 0.5f;
-			float	nx		= wx / dstW;
-			float	ny		= wy / dstH;
+			const int	packetSize	= de::min<int>(PACKET_SIZE, dst.getWidth() - packetX);
 
-			int		triNdx	= nx + ny >= 1.0f ? 1 : 0;
-			float	triWx	= triNdx ? dstW - wx : wx;
-			float	triWy	= triNdx ? dstH - wy : wy;
-			float	triNx	= triNdx ? 1.0f - nx : nx;
-			float	triNy	= triNdx ? 1.0f - ny : ny;
-
-			float	s		= projectedTriInterpolate(triS[triNdx], triW[triNdx], triNx, triNy);
-			float	t		= projectedTriInterpolate(triT[triNdx], triW[triNdx], triNx, triNy);
-			float	lod		= computeProjectedTriLod(params.lodMode, triU[triNdx], triV[triNdx], triW[triNdx], triWx, triWy, (float)dst.getWidth(), (float)dst.getHeight())
+			for (int ndx = 0; ndx < packetSize; ndx++)
+			{
+				float	wx		= (float)(packetX + ndx) + 0.5f;
+				float	wy		= (float)py + 0.5f;
+				float	nx		= wx / dstW;
+				float	ny		= wy / dstH;
+
+				int		triNdx	= nx + ny >= 1.0f ? 1 : 0;
+				float	triWx	= triNdx ? dstW - wx : wx;
+				float	triWy	= triNdx ? dstH - wy : wy;
+				float	triNx	= triNdx ? 1.0f - nx : nx;
+				float	triNy	= triNdx ? 1.0f - ny : ny;
+
+				coords[ndx]	= tcu::Vec2(projectedTriInterpolate(triS[triNdx], triW[triNdx], triNx, triNy),
+										projectedTriInterpolate(triT[triNdx], triW[triNdx], triNx, triNy));
+				lods[ndx]	= computeProjectedTriLod(params.lodMode, triU[triNdx], triV[triNdx], triW[triNdx], triWx, triWy, (float)dst.getWidth(), (float)dst.getHeight())
 							+ lodBias;
+			}
 
-			dst.setPixel(execSample(src, params, s, t, lod) * params.colorScale + params.colorBias, px, py);
+			execSamplePacket(src, params, colors, coords, lods, packetSize);
+
+			for (int ndx = 0; ndx < packetSize; ndx++)
+				dst.setPixel(colors[ndx] * params.colorScale + params.colorBias, packetX + ndx, py);
 		}
 	}
 }
@@ -1221,16 +1262,51 @@ void computeQuadTexCoordCubeArray (std::vector<float>& dst, tcu::CubeFace face,
 
 // Texture result verification
 
-//! Verifies texture lookup results and returns number of failed pixels.
-int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
-							  const tcu::ConstPixelBufferAccess&	reference,
-							  const tcu::PixelBufferAccess&			errorMask,
-							  const tcu::Texture1DView&				baseView,
-							  const float*							texCoord,
-							  const ReferenceParams&				sampleParams,
-							  const tcu::LookupPrecision&			lookupPrec,
-							  const tcu::LodPrecision&				lodPrec,
-							  qpWatchDog*							watchDog)
+//! Min/max pyramid of the effective source texture. Built on first use and shared by all row bands.
+class SharedMinMaxPyramid
+{
+public:
+	SharedMinMaxPyramid (void)
+		: m_pyramid(DE_NULL)
+	{
+	}
+
+	~SharedMinMaxPyramid (void)
+	{
+		delete m_pyramid;
+	}
+
+	template<typename TextureViewType>
+	const tcu::TextureMinMaxPyramid& get (const TextureViewType& src) const
+	{
+		const de::ScopedLock lock (m_lock);
+
+		if (!m_pyramid)
+			m_pyramid = new tcu::TextureMinMaxPyramid(src);
+
+		return *m_pyramid;
+	}
+
+private:
+										SharedMinMaxPyramid	(const SharedMinMaxPyramid&);
+	SharedMinMaxPyramid&				operator=			(const SharedMinMaxPyramid&);
+
+	mutable de::Mutex					m_lock;
+	mutable tcu::TextureMinMaxPyramid*	m_pyramid;
+};
+
+//! Verifies texture lookup results for rows [rowBegin, rowEnd) and returns number of failed pixels.
+static int computeTextureLookupDiffRows (const tcu::ConstPixelBufferAccess&	result,
+										 const tcu::ConstPixelBufferAccess&	reference,
+										 const tcu::PixelBufferAccess&		errorMask,
+										 const tcu::Texture1DView&			baseView,
+										 const float*						texCoord,
+										 const ReferenceParams&				sampleParams,
+										 const tcu::LookupPrecision&		lookupPrec,
+										 const tcu::LodPrecision&			lodPrec,
+										 const SharedMinMaxPyramid&			minMax,
+										 int								rowBegin,
+										 int								rowEnd)
 {
 	DE_ASSERT(result.getWidth() == reference.getWidth() && result.getHeight() == reference.getHeight());
 	DE_ASSERT(result.getWidth() == errorMask.getWidth() && result.getHeight() == errorMask.getHeight());
@@ -1252,6 +1328,7 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 	const tcu::Vec2								lodBias				((sampleParams.flags & ReferenceParams::USE_BIAS) ? sampleParams.bias : 0.0f);
 
 	int											numFailed			= 0;
+	const tcu::TextureMinMaxPyramid*			srcMinMax			= DE_NULL;
 
 	const tcu::Vec2 lodOffsets[] =
 	{
@@ -1261,14 +1338,8 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 		tcu::Vec2( 0, +1),
 	};
 
-	tcu::clear(errorMask, tcu::RGBA::green().toVec());
-
-	for (int py = 0; py < result.getHeight(); py++)
+	for (int py = rowBegin; py < rowEnd; py++)
 	{
-		// Ugly hack, validation can take way too long at the moment.
-		if (watchDog)
-			qpWatchDog_touch(watchDog);
-
 		for (int px = 0; px < result.getWidth(); px++)
 		{
 			const tcu::Vec4	resPix	= (result.getPixel(px, py)		- sampleParams.colorBias) / sampleParams.colorScale;
@@ -1277,6 +1348,9 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 			// Try comparison to ideal reference first, and if that fails use slower verificator.
 			if (!tcu::boolAll(tcu::lessThanEqual(tcu::abs(resPix - refPix), lookupPrec.colorThreshold)))
 			{
+				if (!srcMinMax)
+					srcMinMax = &minMax.get(src);
+
 				const float		wx		= (float)px + 0.5f;
 				const float		wy		= (float)py + 0.5f;
 				const float		nx		= wx / dstW;
@@ -1311,7 +1385,7 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 				}
 
 				const tcu::Vec2	clampedLod	= tcu::clampLodBounds(lodBounds + lodBias, tcu::Vec2(sampleParams.minLod, sampleParams.maxLod), lodPrec);
-				const bool		isOk		= tcu::isLookupResultValid(src, sampleParams.sampler, lookupPrec, coord, clampedLod, resPix);
+				const bool		isOk		= tcu::isLookupResultValid(src, *srcMinMax, sampleParams.sampler, lookupPrec, coord, clampedLod, resPix);
 
 				if (!isOk)
 				{
@@ -1325,15 +1399,18 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 	return numFailed;
 }
 
-int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
-							  const tcu::ConstPixelBufferAccess&	reference,
-							  const tcu::PixelBufferAccess&			errorMask,
-							  const tcu::Texture2DView&				baseView,
-							  const float*							texCoord,
-							  const ReferenceParams&				sampleParams,
-							  const tcu::LookupPrecision&			lookupPrec,
-							  const tcu::LodPrecision&				lodPrec,
-							  qpWatchDog*							watchDog)
+//! Verifies texture lookup results for rows [rowBegin, rowEnd) and returns number of failed pixels.
+static int computeTextureLookupDiffRows (const tcu::ConstPixelBufferAccess&	result,
+										 const tcu::ConstPixelBufferAccess&	reference,
+										 const tcu::PixelBufferAccess&		errorMask,
+										 const tcu::Texture2DView&			baseView,
+										 const float*						texCoord,
+										 const ReferenceParams&				sampleParams,
+										 const tcu::LookupPrecision&		lookupPrec,
+										 const tcu::LodPrecision&			lodPrec,
+										 const SharedMinMaxPyramid&			minMax,
+										 int								rowBegin,
+										 int								rowEnd)
 {
 	DE_ASSERT(result.getWidth() == reference.getWidth() && result.getHeight() == reference.getHeight());
 	DE_ASSERT(result.getWidth() == errorMask.getWidth() && result.getHeight() == errorMask.getHeight());
@@ -1359,6 +1436,7 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 	const float									posEps				= 1.0f / float(1<<MIN_SUBPIXEL_BITS);
 
 	int											numFailed			= 0;
+	const tcu::TextureMinMaxPyramid*			srcMinMax			= DE_NULL;
 
 	const tcu::Vec2 lodOffsets[] =
 	{
@@ -1368,14 +1446,8 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 		tcu::Vec2( 0, +1),
 	};
 
-	tcu::clear(errorMask, tcu::RGBA::green().toVec());
-
-	for (int py = 0; py < result.getHeight(); py++)
+	for (int py = rowBegin; py < rowEnd; py++)
 	{
-		// Ugly hack, validation can take way too long at the moment.
-		if (watchDog)
-			qpWatchDog_touch(watchDog);
-
 		for (int px = 0; px < result.getWidth(); px++)
 		{
 			const tcu::Vec4	resPix	= (result.getPixel(px, py)		- sampleParams.colorBias) / sampleParams.colorScale;
@@ -1384,6 +1456,9 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 			// Try comparison to ideal reference first, and if that fails use slower verificator.
 			if (!tcu::boolAll(tcu::lessThanEqual(tcu::abs(resPix - refPix), lookupPrec.colorThreshold)))
 			{
+				if (!srcMinMax)
+					srcMinMax = &minMax.get(src);
+
 				const float		wx		= (float)px + 0.5f;
 				const float		wy		= (float)py + 0.5f;
 				const float		nx		= wx / dstW;
@@ -1432,7 +1507,7 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 					}
 
 					const tcu::Vec2	clampedLod	= tcu::clampLodBounds(lodBounds + lodBias, tcu::Vec2(sampleParams.minLod, sampleParams.maxLod), lodPrec);
-					if (tcu::isLookupResultValid(src, sampleParams.sampler, lookupPrec, coord, clampedLod, resPix))
+					if (tcu::isLookupResultValid(src, *srcMinMax, sampleParams.sampler, lookupPrec, coord, clampedLod, resPix))
 					{
 						isOk = true;
 						break;
@@ -1523,16 +1598,17 @@ bool verifyTextureResult (tcu::TestContext&						testCtx,
 	return numFailedPixels == 0;
 }
 
-//! Verifies texture lookup results and returns number of failed pixels.
-int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
-							  const tcu::ConstPixelBufferAccess&	reference,
-							  const tcu::PixelBufferAccess&			errorMask,
-							  const tcu::TextureCubeView&			baseView,
-							  const float*							texCoord,
-							  const ReferenceParams&				sampleParams,
-							  const tcu::LookupPrecision&			lookupPrec,
-							  const tcu::LodPrecision&				lodPrec,
-							  qpWatchDog*							watchDog)
+//! Verifies texture lookup results for rows [rowBegin, rowEnd) and returns number of failed pixels.
+static int computeTextureLookupDiffRows (const tcu::ConstPixelBufferAccess&	result,
+										 const tcu::ConstPixelBufferAccess&	reference,
+										 const tcu::PixelBufferAccess&		errorMask,
+										 const tcu::TextureCubeView&		baseView,
+										 const float*						texCoord,
+										 const ReferenceParams&				sampleParams,
+										 const tcu::LookupPrecision&		lookupPrec,
+										 const tcu::LodPrecision&			lodPrec,
+										 int								rowBegin,
+										 int								rowEnd)
 {
 	DE_ASSERT(result.getWidth() == reference.getWidth() && result.getHeight() == reference.getHeight());
 	DE_ASSERT(result.getWidth() == errorMask.getWidth() && result.getHeight() == errorMask.getHeight());
@@ -1575,14 +1651,8 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 		tcu::Vec2(+1, +1),
 	};
 
-	tcu::clear(errorMask, tcu::RGBA::green().toVec());
-
-	for (int py = 0; py < result.getHeight(); py++)
+	for (int py = rowBegin; py < rowEnd; py++)
 	{
-		// Ugly hack, validation can take way too long at the moment.
-		if (watchDog)
-			qpWatchDog_touch(watchDog);
-
 		for (int px = 0; px < result.getWidth(); px++)
 		{
 			const tcu::Vec4	resPix	= (result.getPixel(px, py)		- sampleParams.colorBias) / sampleParams.colorScale;
@@ -1703,16 +1773,18 @@ bool verifyTextureResult (tcu::TestContext&						testCtx,
 	return numFailedPixels == 0;
 }
 
-//! Verifies texture lookup results and returns number of failed pixels.
-int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
-							  const tcu::ConstPixelBufferAccess&	reference,
-							  const tcu::PixelBufferAccess&			errorMask,
-							  const tcu::Texture3DView&				baseView,
-							  const float*							texCoord,
-							  const ReferenceParams&				sampleParams,
-							  const tcu::LookupPrecision&			lookupPrec,
-							  const tcu::LodPrecision&				lodPrec,
-							  qpWatchDog*							watchDog)
+//! Verifies texture lookup results for rows [rowBegin, rowEnd) and returns number of failed pixels.
+static int computeTextureLookupDiffRows (const tcu::ConstPixelBufferAccess&	result,
+										 const tcu::ConstPixelBufferAccess&	reference,
+										 const tcu::PixelBufferAccess&		errorMask,
+										 const tcu::Texture3DView&			baseView,
+										 const float*						texCoord,
+										 const ReferenceParams&				sampleParams,
+										 const tcu::LookupPrecision&		lookupPrec,
+										 const tcu::LodPrecision&			lodPrec,
+										 const SharedMinMaxPyramid&			minMax,
+										 int								rowBegin,
+										 int								rowEnd)
 {
 	DE_ASSERT(result.getWidth() == reference.getWidth() && result.getHeight() == reference.getHeight());
 	DE_ASSERT(result.getWidth() == errorMask.getWidth() && result.getHeight() == errorMask.getHeight());
@@ -1740,6 +1812,7 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 	const float									posEps				= 1.0f / float(1<<MIN_SUBPIXEL_BITS);
 
 	int											numFailed			= 0;
+	const tcu::TextureMinMaxPyramid*			srcMinMax			= DE_NULL;
 
 	const tcu::Vec2 lodOffsets[] =
 	{
@@ -1749,14 +1822,8 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 		tcu::Vec2( 0, +1),
 	};
 
-	tcu::clear(errorMask, tcu::RGBA::green().toVec());
-
-	for (int py = 0; py < result.getHeight(); py++)
+	for (int py = rowBegin; py < rowEnd; py++)
 	{
-		// Ugly hack, validation can take way too long at the moment.
-		if (watchDog)
-			qpWatchDog_touch(watchDog);
-
 		for (int px = 0; px < result.getWidth(); px++)
 		{
 			const tcu::Vec4	resPix	= (result.getPixel(px, py)		- sampleParams.colorBias) / sampleParams.colorScale;
@@ -1765,6 +1832,9 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 			// Try comparison to ideal reference first, and if that fails use slower verificator.
 			if (!tcu::boolAll(tcu::lessThanEqual(tcu::abs(resPix - refPix), lookupPrec.colorThreshold)))
 			{
+				if (!srcMinMax)
+					srcMinMax = &minMax.get(src);
+
 				const float		wx		= (float)px + 0.5f;
 				const float		wy		= (float)py + 0.5f;
 				const float		nx		= wx / dstW;
@@ -1819,7 +1889,7 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 
 					const tcu::Vec2	clampedLod	= tcu::clampLodBounds(lodBounds + lodBias, tcu::Vec2(sampleParams.minLod, sampleParams.maxLod), lodPrec);
 
-					if (tcu::isLookupResultValid(src, sampleParams.sampler, lookupPrec, coord, clampedLod, resPix))
+					if (tcu::isLookupResultValid(src, *srcMinMax, sampleParams.sampler, lookupPrec, coord, clampedLod, resPix))
 					{
 						isOk = true;
 						break;
@@ -1874,16 +1944,18 @@ bool verifyTextureResult (tcu::TestContext&						testCtx,
 	return numFailedPixels == 0;
 }
 
-//! Verifies texture lookup results and returns number of failed pixels.
-int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
-							  const tcu::ConstPixelBufferAccess&	reference,
-							  const tcu::PixelBufferAccess&			errorMask,
-							  const tcu::Texture1DArrayView&		baseView,
-							  const float*							texCoord,
-							  const ReferenceParams&				sampleParams,
-							  const tcu::LookupPrecision&			lookupPrec,
-							  const tcu::LodPrecision&				lodPrec,
-							  qpWatchDog*							watchDog)
+//! Verifies texture lookup results for rows [rowBegin, rowEnd) and returns number of failed pixels.
+static int computeTextureLookupDiffRows (const tcu::ConstPixelBufferAccess&	result,
+										 const tcu::ConstPixelBufferAccess&	reference,
+										 const tcu::PixelBufferAccess&		errorMask,
+										 const tcu::Texture1DArrayView&		baseView,
+										 const float*						texCoord,
+										 const ReferenceParams&				sampleParams,
+										 const tcu::LookupPrecision&		lookupPrec,
+										 const tcu::LodPrecision&			lodPrec,
+										 const SharedMinMaxPyramid&			minMax,
+										 int								rowBegin,
+										 int								rowEnd)
 {
 	DE_ASSERT(result.getWidth() == reference.getWidth() && result.getHeight() == reference.getHeight());
 	DE_ASSERT(result.getWidth() == errorMask.getWidth() && result.getHeight() == errorMask.getHeight());
@@ -1907,6 +1979,7 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 	const tcu::Vec2								lodBias				((sampleParams.flags & ReferenceParams::USE_BIAS) ? sampleParams.bias : 0.0f);
 
 	int											numFailed			= 0;
+	const tcu::TextureMinMaxPyramid*			srcMinMax			= DE_NULL;
 
 	const tcu::Vec2 lodOffsets[] =
 	{
@@ -1916,14 +1989,8 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 		tcu::Vec2( 0, +1),
 	};
 
-	tcu::clear(errorMask, tcu::RGBA::green().toVec());
-
-	for (int py = 0; py < result.getHeight(); py++)
+	for (int py = rowBegin; py < rowEnd; py++)
 	{
-		// Ugly hack, validation can take way too long at the moment.
-		if (watchDog)
-			qpWatchDog_touch(watchDog);
-
 		for (int px = 0; px < result.getWidth(); px++)
 		{
 			const tcu::Vec4	resPix	= (result.getPixel(px, py)		- sampleParams.colorBias) / sampleParams.colorScale;
@@ -1932,6 +1999,9 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 			// Try comparison to ideal reference first, and if that fails use slower verificator.
 			if (!tcu::boolAll(tcu::lessThanEqual(tcu::abs(resPix - refPix), lookupPrec.colorThreshold)))
 			{
+				if (!srcMinMax)
+					srcMinMax = &minMax.get(src);
+
 				const float		wx		= (float)px + 0.5f;
 				const float		wy		= (float)py + 0.5f;
 				const float		nx		= wx / dstW;
@@ -1967,7 +2037,7 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 				}
 
 				const tcu::Vec2	clampedLod	= tcu::clampLodBounds(lodBounds + lodBias, tcu::Vec2(sampleParams.minLod, sampleParams.maxLod), lodPrec);
-				const bool		isOk		= tcu::isLookupResultValid(src, sampleParams.sampler, lookupPrec, coord, clampedLod, resPix);
+				const bool		isOk		= tcu::isLookupResultValid(src, *srcMinMax, sampleParams.sampler, lookupPrec, coord, clampedLod, resPix);
 
 				if (!isOk)
 				{
@@ -1981,16 +2051,18 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 	return numFailed;
 }
 
-//! Verifies texture lookup results and returns number of failed pixels.
-int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
-							  const tcu::ConstPixelBufferAccess&	reference,
-							  const tcu::PixelBufferAccess&			errorMask,
-							  const tcu::Texture2DArrayView&		baseView,
-							  const float*							texCoord,
-							  const ReferenceParams&				sampleParams,
-							  const tcu::LookupPrecision&			lookupPrec,
-							  const tcu::LodPrecision&				lodPrec,
-							  qpWatchDog*							watchDog)
+//! Verifies texture lookup results for rows [rowBegin, rowEnd) and returns number of failed pixels.
+static int computeTextureLookupDiffRows (const tcu::ConstPixelBufferAccess&	result,
+										 const tcu::ConstPixelBufferAccess&	reference,
+										 const tcu::PixelBufferAccess&		errorMask,
+										 const tcu::Texture2DArrayView&		baseView,
+										 const float*						texCoord,
+										 const ReferenceParams&				sampleParams,
+										 const tcu::LookupPrecision&		lookupPrec,
+										 const tcu::LodPrecision&			lodPrec,
+										 const SharedMinMaxPyramid&			minMax,
+										 int								rowBegin,
+										 int								rowEnd)
 {
 	DE_ASSERT(result.getWidth() == reference.getWidth() && result.getHeight() == reference.getHeight());
 	DE_ASSERT(result.getWidth() == errorMask.getWidth() && result.getHeight() == errorMask.getHeight());
@@ -2016,6 +2088,7 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 	const tcu::Vec2								lodBias				((sampleParams.flags & ReferenceParams::USE_BIAS) ? sampleParams.bias : 0.0f);
 
 	int											numFailed			= 0;
+	const tcu::TextureMinMaxPyramid*			srcMinMax			= DE_NULL;
 
 	const tcu::Vec2 lodOffsets[] =
 	{
@@ -2025,14 +2098,8 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 		tcu::Vec2( 0, +1),
 	};
 
-	tcu::clear(errorMask, tcu::RGBA::green().toVec());
-
-	for (int py = 0; py < result.getHeight(); py++)
+	for (int py = rowBegin; py < rowEnd; py++)
 	{
-		// Ugly hack, validation can take way too long at the moment.
-		if (watchDog)
-			qpWatchDog_touch(watchDog);
-
 		for (int px = 0; px < result.getWidth(); px++)
 		{
 			const tcu::Vec4	resPix	= (result.getPixel(px, py)		- sampleParams.colorBias) / sampleParams.colorScale;
@@ -2041,6 +2108,9 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 			// Try comparison to ideal reference first, and if that fails use slower verificator.
 			if (!tcu::boolAll(tcu::lessThanEqual(tcu::abs(resPix - refPix), lookupPrec.colorThreshold)))
 			{
+				if (!srcMinMax)
+					srcMinMax = &minMax.get(src);
+
 				const float		wx		= (float)px + 0.5f;
 				const float		wy		= (float)py + 0.5f;
 				const float		nx		= wx / dstW;
@@ -2081,7 +2151,7 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 				}
 
 				const tcu::Vec2	clampedLod	= tcu::clampLodBounds(lodBounds + lodBias, tcu::Vec2(sampleParams.minLod, sampleParams.maxLod), lodPrec);
-				const bool		isOk		= tcu::isLookupResultValid(src, sampleParams.sampler, lookupPrec, coord, clampedLod, resPix);
+				const bool		isOk		= tcu::isLookupResultValid(src, *srcMinMax, sampleParams.sampler, lookupPrec, coord, clampedLod, resPix);
 
 				if (!isOk)
 				{
@@ -2167,17 +2237,18 @@ bool verifyTextureResult (tcu::TestContext&						testCtx,
 	return numFailedPixels == 0;
 }
 
-//! Verifies texture lookup results and returns number of failed pixels.
-int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
-							  const tcu::ConstPixelBufferAccess&	reference,
-							  const tcu::PixelBufferAccess&			errorMask,
-							  const tcu::TextureCubeArrayView&		baseView,
-							  const float*							texCoord,
-							  const ReferenceParams&				sampleParams,
-							  const tcu::LookupPrecision&			lookupPrec,
-							  const tcu::IVec4&						coordBits,
-							  const tcu::LodPrecision&				lodPrec,
-							  qpWatchDog*							watchDog)
+//! Verifies texture lookup results for rows [rowBegin, rowEnd) and returns number of failed pixels.
+static int computeTextureLookupDiffRows (const tcu::ConstPixelBufferAccess&	result,
+										 const tcu::ConstPixelBufferAccess&	reference,
+										 const tcu::PixelBufferAccess&		errorMask,
+										 const tcu::TextureCubeArrayView&	baseView,
+										 const float*						texCoord,
+										 const ReferenceParams&				sampleParams,
+										 const tcu::LookupPrecision&		lookupPrec,
+										 const tcu::IVec4&					coordBits,
+										 const tcu::LodPrecision&			lodPrec,
+										 int								rowBegin,
+										 int								rowEnd)
 {
 	DE_ASSERT(result.getWidth() == reference.getWidth() && result.getHeight() == reference.getHeight());
 	DE_ASSERT(result.getWidth() == errorMask.getWidth() && result.getHeight() == errorMask.getHeight());
@@ -2222,14 +2293,8 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 		tcu::Vec2(+1, +1),
 	};
 
-	tcu::clear(errorMask, tcu::RGBA::green().toVec());
-
-	for (int py = 0; py < result.getHeight(); py++)
+	for (int py = rowBegin; py < rowEnd; py++)
 	{
-		// Ugly hack, validation can take way too long at the moment.
-		if (watchDog)
-			qpWatchDog_touch(watchDog);
-
 		for (int px = 0; px < result.getWidth(); px++)
 		{
 			const tcu::Vec4	resPix	= (result.getPixel(px, py)		- sampleParams.colorBias) / sampleParams.colorScale;
@@ -2315,6 +2380,210 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 	return numFailed;
 }
 
+//! Verifies a band of rows per batch with computeTextureLookupDiffRows().
+template<typename TextureViewType>
+class LookupDiffBands : public tcu::BatchFunc
+{
+public:
+	LookupDiffBands (const tcu::ConstPixelBufferAccess&	result,
+					 const tcu::ConstPixelBufferAccess&	reference,
+					 const tcu::PixelBufferAccess&		errorMask,
+					 const TextureViewType&				baseView,
+					 const float*						texCoord,
+					 const ReferenceParams&				sampleParams,
+					 const tcu::LookupPrecision&		lookupPrec,
+					 const tcu::LodPrecision&			lodPrec,
+					 const tcu::IVec4&					coordBits = tcu::IVec4(0))
+		: m_result			(result)
+		, m_reference		(reference)
+		, m_errorMask		(errorMask)
+		, m_baseView		(baseView)
+		, m_texCoord		(texCoord)
+		, m_sampleParams	(sampleParams)
+		, m_lookupPrec		(lookupPrec)
+		, m_lodPrec			(lodPrec)
+		, m_coordBits		(coordBits)
+		, m_numFailed		(tcu::getNumBatches(result.getHeight(), LOOKUP_DIFF_BAND_HEIGHT), 0)
+	{
+	}
+
+	void operator() (int bandNdx, int rowBegin, int rowEnd) const
+	{
+		m_numFailed[bandNdx] = computeTextureLookupDiffRows(m_result, m_reference, m_errorMask, m_baseView, m_texCoord, m_sampleParams, m_lookupPrec, m_lodPrec, m_minMax, rowBegin, rowEnd);
+	}
+
+	int getNumFailed (void) const
+	{
+		int numFailed = 0;
+
+		// Bands write disjoint rows of the error mask, so the sum is the same regardless of the execution order.
+		for (size_t bandNdx = 0; bandNdx < m_numFailed.size(); bandNdx++)
+			numFailed += m_numFailed[bandNdx];
+
+		return numFailed;
+	}
+
+private:
+	const tcu::ConstPixelBufferAccess&	m_result;
+	const tcu::ConstPixelBufferAccess&	m_reference;
+	const tcu::PixelBufferAccess&		m_errorMask;
+	const TextureViewType&				m_baseView;
+	const float* const					m_texCoord;
+	const ReferenceParams&				m_sampleParams;
+	const tcu::LookupPrecision&			m_lookupPrec;
+	const tcu::LodPrecision&			m_lodPrec;
+	const tcu::IVec4					m_coordBits;
+	const SharedMinMaxPyramid			m_minMax;
+	mutable std::vector<int>			m_numFailed;
+};
+
+// \note Cube lookups may access neighboring faces, so cube textures are verified without min/max pyramid.
+template<>
+void LookupDiffBands<tcu::TextureCubeView>::operator() (int bandNdx, int rowBegin, int rowEnd) const
+{
+	m_numFailed[bandNdx] = computeTextureLookupDiffRows(m_result, m_reference, m_errorMask, m_baseView, m_texCoord, m_sampleParams, m_lookupPrec, m_lodPrec, rowBegin, rowEnd);
+}
+
+template<>
+void LookupDiffBands<tcu::TextureCubeArrayView>::operator() (int bandNdx, int rowBegin, int rowEnd) const
+{
+	m_numFailed[bandNdx] = computeTextureLookupDiffRows(m_result, m_reference, m_errorMask, m_baseView, m_texCoord, m_sampleParams, m_lookupPrec, m_coordBits, m_lodPrec, rowBegin, rowEnd);
+}
+
+//! Verifies texture lookup results and returns number of failed pixels.
+int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
+							  const tcu::ConstPixelBufferAccess&	reference,
+							  const tcu::PixelBufferAccess&			errorMask,
+							  const tcu::Texture1DView&				baseView,
+							  const float*							texCoord,
+							  const ReferenceParams&				sampleParams,
+							  const tcu::LookupPrecision&			lookupPrec,
+							  const tcu::LodPrecision&				lodPrec,
+							  qpWatchDog*							watchDog)
+{
+	const LookupDiffBands<tcu::Texture1DView>	bands	(result, reference, errorMask, baseView, texCoord, sampleParams, lookupPrec, lodPrec);
+
+	tcu::clear(errorMask, tcu::RGBA::green().toVec());
+	tcu::executeBatches(result.getHeight(), LOOKUP_DIFF_BAND_HEIGHT, bands, watchDog);
+
+	return bands.getNumFailed();
+}
+
+//! Verifies texture lookup results and returns number of failed pixels.
+int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
+							  const tcu::ConstPixelBufferAccess&	reference,
+							  const tcu::PixelBufferAccess&			errorMask,
+							  const tcu::Texture2DView&				baseView,
+							  const float*							texCoord,
+							  const ReferenceParams&				sampleParams,
+							  const tcu::LookupPrecision&			lookupPrec,
+							  const tcu::LodPrecision&				lodPrec,
+							  qpWatchDog*							watchDog)
+{
+	const LookupDiffBands<tcu::Texture2DView>	bands	(result, reference, errorMask, baseView, texCoord, sampleParams, lookupPrec, lodPrec);
+
+	tcu::clear(errorMask, tcu::RGBA::green().toVec());
+	tcu::executeBatches(result.getHeight(), LOOKUP_DIFF_BAND_HEIGHT, bands, watchDog);
+
+	return bands.getNumFailed();
+}
+
+//! Verifies texture lookup results and returns number of failed pixels.
+int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
+							  const tcu::ConstPixelBufferAccess&	reference,
+							  const tcu::PixelBufferAccess&			errorMask,
+							  const tcu::TextureCubeView&			baseView,
+							  const float*							texCoord,
+							  const ReferenceParams&				sampleParams,
+							  const tcu::LookupPrecision&			lookupPrec,
+							  const tcu::LodPrecision&				lodPrec,
+							  qpWatchDog*							watchDog)
+{
+	const LookupDiffBands<tcu::TextureCubeView>	bands	(result, reference, errorMask, baseView, texCoord, sampleParams, lookupPrec, lodPrec);
+
+	tcu::clear(errorMask, tcu::RGBA::green().toVec());
+	tcu::executeBatches(result.getHeight(), LOOKUP_DIFF_BAND_HEIGHT, bands, watchDog);
+
+	return bands.getNumFailed();
+}
+
+//! Verifies texture lookup results and returns number of failed pixels.
+int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
+							  const tcu::ConstPixelBufferAccess&	reference,
+							  const tcu::PixelBufferAccess&			errorMask,
+							  const tcu::Texture3DView&				baseView,
+							  const float*							texCoord,
+							  const ReferenceParams&				sampleParams,
+							  const tcu::LookupPrecision&			lookupPrec,
+							  const tcu::LodPrecision&				lodPrec,
+							  qpWatchDog*							watchDog)
+{
+	const LookupDiffBands<tcu::Texture3DView>	bands	(result, reference, errorMask, baseView, texCoord, sampleParams, lookupPrec, lodPrec);
+
+	tcu::clear(errorMask, tcu::RGBA::green().toVec());
+	tcu::executeBatches(result.getHeight(), LOOKUP_DIFF_BAND_HEIGHT, bands, watchDog);
+
+	return bands.getNumFailed();
+}
+
+//! Verifies texture lookup results and returns number of failed pixels.
+int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
+							  const tcu::ConstPixelBufferAccess&	reference,
+							  const tcu::PixelBufferAccess&			errorMask,
+							  const tcu::Texture1DArrayView&		baseView,
+							  const float*							texCoord,
+							  const ReferenceParams&				sampleParams,
+							  const tcu::LookupPrecision&			lookupPrec,
+							  const tcu::LodPrecision&				lodPrec,
+							  qpWatchDog*							watchDog)
+{
+	const LookupDiffBands<tcu::Texture1DArrayView>	bands	(result, reference, errorMask, baseView, texCoord, sampleParams, lookupPrec, lodPrec);
+
+	tcu::clear(errorMask, tcu::RGBA::green().toVec());
+	tcu::executeBatches(result.getHeight(), LOOKUP_DIFF_BAND_HEIGHT, bands, watchDog);
+
+	return bands.getNumFailed();
+}
+
+//! Verifies texture lookup results and returns number of failed pixels.
+int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
+							  const tcu::ConstPixelBufferAccess&	reference,
+							  const tcu::PixelBufferAccess&			errorMask,
+							  const tcu::Texture2DArrayView&		baseView,
+							  const float*							texCoord,
+							  const ReferenceParams&				sampleParams,
+							  const tcu::LookupPrecision&			lookupPrec,
+							  const tcu::LodPrecision&				lodPrec,
+							  qpWatchDog*							watchDog)
+{
+	const LookupDiffBands<tcu::Texture2DArrayView>	bands	(result, reference, errorMask, baseView, texCoord, sampleParams, lookupPrec, lodPrec);
+
+	tcu::clear(errorMask, tcu::RGBA::green().toVec());
+	tcu::executeBatches(result.getHeight(), LOOKUP_DIFF_BAND_HEIGHT, bands, watchDog);
+
+	return bands.getNumFailed();
+}
+
+//! Verifies texture lookup results and returns number of failed pixels.
+int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
+							  const tcu::ConstPixelBufferAccess&	reference,
+							  const tcu::PixelBufferAccess&			errorMask,
+							  const tcu::TextureCubeArrayView&		baseView,
+							  const float*							texCoord,
+							  const ReferenceParams&				sampleParams,
+							  const tcu::LookupPrecision&			lookupPrec,
+							  const tcu::IVec4&						coordBits,
+							  const tcu::LodPrecision&				lodPrec,
+							  qpWatchDog*							watchDog)
+{
+	const LookupDiffBands<tcu::TextureCubeArrayView>	bands	(result, reference, errorMask, baseView, texCoord, sampleParams, lookupPrec, lodPrec, coordBits);
+
+	tcu::clear(errorMask, tcu::RGBA::green().toVec());
+	tcu::executeBatches(result.getHeight(), LOOKUP_DIFF_BAND_HEIGHT, bands, watchDog);
+
+	return bands.getNumFailed();
+}
+
 bool verifyTextureResult (tcu::TestContext&						testCtx,
 						  const tcu::ConstPixelBufferAccess&	result,
 						  const tcu::TextureCubeArrayView&		src,
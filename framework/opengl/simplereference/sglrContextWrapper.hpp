@@ -35,6 +35,31 @@ class Context;
 class ContextWrapper
 {
 public:
+	/*--------------------------------------------------------------------*//*!
+	 * \brief Override wrapper context for the calling thread
+	 *
+	 * While the object is alive, calls made through the wrapper from the
+	 * thread that created it are forwarded to the given context instead of
+	 * the one set with setContext(). This allows rendering the same command
+	 * sequence to different contexts on different threads concurrently.
+	 *//*--------------------------------------------------------------------*/
+	class ScopedThreadContext
+	{
+	public:
+									ScopedThreadContext		(const ContextWrapper& wrapper, Context* context);
+									~ScopedThreadContext	(void);
+
+	private:
+									ScopedThreadContext		(const ScopedThreadContext&);
+		ScopedThreadContext&		operator=				(const ScopedThreadContext&);
+
+		const ContextWrapper&		m_wrapper;
+		Context* const				m_context;
+		const ScopedThreadContext*	m_prev;
+
+		friend class ContextWrapper;
+	};
+
 					ContextWrapper							(void);
 					~ContextWrapper							(void);
 
@@ -384,6 +384,11 @@ ReferenceContext::ReferenceContext (const ReferenceContextLimits& limits, const
 	, m_primitiveRestartIndex			(0)
 
 	, m_lastError						(GL_NO_ERROR)
+
+	, m_renderStateGeneration			(1)
+	, m_cachedRenderStateGeneration		(0)
+	, m_cachedRenderState				((rr::ViewportState)(colorbuffer))
+	, m_drawBatchingEnabled				(false)
 {
 	// Create empty textures to be used when texture objects are incomplete.
 	m_emptyTex1D.getSampler().wrapS		= tcu::Sampler::CLAMP_TO_EDGE;
@@ -445,6 +450,9 @@ ReferenceContext::ReferenceContext (const ReferenceContextLimits& limits, const
 
 ReferenceContext::~ReferenceContext (void)
 {
+	// Framebuffer contents may still be accessed directly after the context is gone
+	flushDeferredDraws();
+
 	// Destroy all objects -- verifies that ref counting works
 	{
 		vector<VertexArray*> vertexArrays;
@@ -591,6 +599,8 @@ void ReferenceContext::setTexCubeArrayBinding (int unitNdx, TextureCubeArray* te
 
 void ReferenceContext::bindTexture (deUint32 target, deUint32 texture)
 {
+	flushDeferredDraws();
+
 	int unitNdx = m_activeTexture;
 
 	RC_IF_ERROR(target != GL_TEXTURE_1D				&&
@@ -679,6 +689,8 @@ void ReferenceContext::genTextures (int numTextures, deUint32* textures)
 
 void ReferenceContext::deleteTextures (int numTextures, const deUint32* textures)
 {
+	flushDeferredDraws();
+
 	for (int i = 0; i < numTextures; i++)
 	{
 		deUint32	name		= textures[i];
@@ -730,6 +742,8 @@ void ReferenceContext::deleteTexture (Texture* texture)
 
 void ReferenceContext::bindFramebuffer (deUint32 target, deUint32 name)
 {
+	flushDeferredDraws();
+
 	Framebuffer* fbo = DE_NULL;
 
 	RC_IF_ERROR(target != GL_FRAMEBUFFER		&&
@@ -796,6 +810,8 @@ void ReferenceContext::deleteFramebuffer (Framebuffer* framebuffer)
 
 void ReferenceContext::deleteFramebuffers (int numFramebuffers, const deUint32* framebuffers)
 {
+	flushDeferredDraws();
+
 	for (int i = 0; i < numFramebuffers; i++)
 	{
 		deUint32		name		= framebuffers[i];
@@ -808,6 +824,8 @@ void ReferenceContext::deleteFramebuffers (int numFramebuffers, const deUint32*
 
 void ReferenceContext::bindRenderbuffer (deUint32 target, deUint32 name)
 {
+	flushDeferredDraws();
+
 	Renderbuffer* rbo = DE_NULL;
 
 	RC_IF_ERROR(target != GL_RENDERBUFFER, GL_INVALID_ENUM, RC_RET_VOID);
@@ -872,6 +890,8 @@ void ReferenceContext::deleteRenderbuffer (Renderbuffer* renderbuffer)
 
 void ReferenceContext::deleteRenderbuffers (int numRenderbuffers, const deUint32* renderbuffers)
 {
+	flushDeferredDraws();
+
 	for (int i = 0; i < numRenderbuffers; i++)
 	{
 		deUint32		name			= renderbuffers[i];
@@ -1020,6 +1040,8 @@ static void clearToTextureInitialValue (PixelBufferAccess access)
 
 void ReferenceContext::texImage3D (deUint32 target, int level, deUint32 internalFormat, int width, int height, int depth, int border, deUint32 format, deUint32 type, const void* data)
 {
+	flushDeferredDraws();
+
 	TextureUnit&		unit					= m_textureUnits[m_activeTexture];
 	const void*			unpackPtr				= getPixelUnpackPtr(data);
 	const bool			isDstFloatDepthFormat	= (internalFormat == GL_DEPTH_COMPONENT32F || internalFormat == GL_DEPTH32F_STENCIL8); // depth components are limited to [0,1] range
@@ -1286,6 +1308,8 @@ void ReferenceContext::texSubImage2D (deUint32 target, int level, int xoffset, i
 
 void ReferenceContext::texSubImage3D (deUint32 target, int level, int xoffset, int yoffset, int zoffset, int width, int height, int depth, deUint32 format, deUint32 type, const void* data)
 {
+	flushDeferredDraws();
+
 	TextureUnit& unit = m_textureUnits[m_activeTexture];
 
 	RC_IF_ERROR(xoffset < 0 || yoffset < 0 || zoffset < 0,	GL_INVALID_VALUE, RC_RET_VOID);
@@ -1423,6 +1447,8 @@ void ReferenceContext::texSubImage3D (deUint32 target, int level, int xoffset, i
 
 void ReferenceContext::copyTexImage1D (deUint32 target, int level, deUint32 internalFormat, int x, int y, int width, int border)
 {
+	flushDeferredDraws();
+
 	TextureUnit&							unit		= m_textureUnits[m_activeTexture];
 	TextureFormat							storageFmt;
 	rr::MultisampleConstPixelBufferAccess	src			= getReadColorbuffer();
@@ -1471,6 +1497,8 @@ void ReferenceContext::copyTexImage1D (deUint32 target, int level, deUint32 inte
 
 void ReferenceContext::copyTexImage2D (deUint32 target, int level, deUint32 internalFormat, int x, int y, int width, int height, int border)
 {
+	flushDeferredDraws();
+
 	TextureUnit&							unit		= m_textureUnits[m_activeTexture];
 	TextureFormat							storageFmt;
 	rr::MultisampleConstPixelBufferAccess	src			= getReadColorbuffer();
@@ -1558,6 +1586,8 @@ void ReferenceContext::copyTexImage2D (deUint32 target, int level, deUint32 inte
 
 void ReferenceContext::copyTexSubImage1D (deUint32 target, int level, int xoffset, int x, int y, int width)
 {
+	flushDeferredDraws();
+
 	TextureUnit&							unit	= m_textureUnits[m_activeTexture];
 	rr::MultisampleConstPixelBufferAccess	src		= getReadColorbuffer();
 
@@ -1589,6 +1619,8 @@ void ReferenceContext::copyTexSubImage1D (deUint32 target, int level, int xoffse
 
 void ReferenceContext::copyTexSubImage2D (deUint32 target, int level, int xoffset, int yoffset, int x, int y, int width, int height)
 {
+	flushDeferredDraws();
+
 	TextureUnit&							unit	= m_textureUnits[m_activeTexture];
 	rr::MultisampleConstPixelBufferAccess	src		= getReadColorbuffer();
 
@@ -1656,6 +1688,8 @@ void ReferenceContext::copyTexSubImage3D (deUint32 target, int level, int xoffse
 
 void ReferenceContext::texStorage2D (deUint32 target, int levels, deUint32 internalFormat, int width, int height)
 {
+	flushDeferredDraws();
+
 	TextureUnit&		unit		= m_textureUnits[m_activeTexture];
 	TextureFormat		storageFmt;
 
@@ -1710,6 +1744,8 @@ void ReferenceContext::texStorage2D (deUint32 target, int levels, deUint32 inter
 
 void ReferenceContext::texStorage3D (deUint32 target, int levels, deUint32 internalFormat, int width, int height, int depth)
 {
+	flushDeferredDraws();
+
 	TextureUnit&		unit		= m_textureUnits[m_activeTexture];
 	TextureFormat		storageFmt;
 
@@ -1816,6 +1852,8 @@ static inline tcu::Sampler::FilterMode mapGLFilterMode (int value)
 
 void ReferenceContext::texParameteri (deUint32 target, deUint32 pname, int value)
 {
+	flushDeferredDraws();
+
 	TextureUnit&	unit		= m_textureUnits[m_activeTexture];
 	Texture*		texture		= DE_NULL;
 
@@ -1968,6 +2006,8 @@ void ReferenceContext::releaseFboAttachmentReference (const Framebuffer::Attachm
 
 void ReferenceContext::framebufferTexture2D (deUint32 target, deUint32 attachment, deUint32 textarget, deUint32 texture, int level)
 {
+	flushDeferredDraws();
+
 	if (attachment == GL_DEPTH_STENCIL_ATTACHMENT)
 	{
 		// Attach to both depth and stencil.
@@ -2030,6 +2070,8 @@ void ReferenceContext::framebufferTexture2D (deUint32 target, deUint32 attachmen
 
 void ReferenceContext::framebufferTextureLayer (deUint32 target, deUint32 attachment, deUint32 texture, int level, int layer)
 {
+	flushDeferredDraws();
+
 	if (attachment == GL_DEPTH_STENCIL_ATTACHMENT)
 	{
 		// Attach to both depth and stencil.
@@ -2100,6 +2142,8 @@ void ReferenceContext::framebufferTextureLayer (deUint32 target, deUint32 attach
 
 void ReferenceContext::framebufferRenderbuffer (deUint32 target, deUint32 attachment, deUint32 renderbuffertarget, deUint32 renderbuffer)
 {
+	flushDeferredDraws();
+
 	if (attachment == GL_DEPTH_STENCIL_ATTACHMENT)
 	{
 		// Attach both to depth and stencil.
@@ -2307,6 +2351,8 @@ void ReferenceContext::getFramebufferAttachmentParameteriv (deUint32 target, deU
 
 void ReferenceContext::renderbufferStorage (deUint32 target, deUint32 internalformat, int width, int height)
 {
+	flushDeferredDraws();
+
 	TextureFormat format = glu::mapGLInternalFormat(internalformat);
 
 	RC_IF_ERROR(target != GL_RENDERBUFFER, GL_INVALID_ENUM, RC_RET_VOID);
@@ -2464,6 +2510,8 @@ DataBuffer* ReferenceContext::getBufferBinding (deUint32 target) const
 
 void ReferenceContext::bindBuffer (deUint32 target, deUint32 buffer)
 {
+	flushDeferredDraws();
+
 	RC_IF_ERROR(!isValidBufferTarget(target), GL_INVALID_ENUM, RC_RET_VOID);
 
 	rc::DataBuffer*	bufObj	= DE_NULL;
@@ -2491,6 +2539,8 @@ void ReferenceContext::genBuffers (int numBuffers, deUint32* buffers)
 
 void ReferenceContext::deleteBuffers (int numBuffers, const deUint32* buffers)
 {
+	flushDeferredDraws();
+
 	RC_IF_ERROR(numBuffers < 0, GL_INVALID_VALUE, RC_RET_VOID);
 
 	for (int ndx = 0; ndx < numBuffers; ndx++)
@@ -2560,6 +2610,8 @@ void ReferenceContext::deleteBuffer (DataBuffer* buffer)
 
 void ReferenceContext::bufferData (deUint32 target, deIntptr size, const void* data, deUint32 usage)
 {
+	flushDeferredDraws();
+
 	RC_IF_ERROR(!isValidBufferTarget(target), GL_INVALID_ENUM, RC_RET_VOID);
 	RC_IF_ERROR(size < 0, GL_INVALID_VALUE, RC_RET_VOID);
 
@@ -2576,6 +2628,8 @@ void ReferenceContext::bufferData (deUint32 target, deIntptr size, const void* d
 
 void ReferenceContext::bufferSubData (deUint32 target, deIntptr offset, deIntptr size, const void* data)
 {
+	flushDeferredDraws();
+
 	RC_IF_ERROR(!isValidBufferTarget(target), GL_INVALID_ENUM, RC_RET_VOID);
 	RC_IF_ERROR(offset < 0 || size < 0, GL_INVALID_VALUE, RC_RET_VOID);
 
@@ -2607,12 +2661,15 @@ void ReferenceContext::clearStencil (int stencil)
 
 void ReferenceContext::scissor (int x, int y, int width, int height)
 {
+	invalidateRenderState();
 	RC_IF_ERROR(width < 0 || height < 0, GL_INVALID_VALUE, RC_RET_VOID);
 	m_scissorBox = IVec4(x, y, width, height);
 }
 
 void ReferenceContext::enable (deUint32 cap)
 {
+	invalidateRenderState();
+
 	switch (cap)
 	{
 		case GL_BLEND:					m_blendEnabled				= true;	break;
@@ -2669,6 +2726,8 @@ void ReferenceContext::enable (deUint32 cap)
 
 void ReferenceContext::disable (deUint32 cap)
 {
+	invalidateRenderState();
+
 	switch (cap)
 	{
 		case GL_BLEND:					m_blendEnabled				= false;	break;
@@ -2767,6 +2826,8 @@ void ReferenceContext::stencilFunc (deUint32 func, int ref, deUint32 mask)
 
 void ReferenceContext::stencilFuncSeparate (deUint32 face, deUint32 func, int ref, deUint32 mask)
 {
+	invalidateRenderState();
+
 	const bool	setFront	= face == GL_FRONT || face == GL_FRONT_AND_BACK;
 	const bool	setBack		= face == GL_BACK || face == GL_FRONT_AND_BACK;
 
@@ -2792,6 +2853,8 @@ void ReferenceContext::stencilOp (deUint32 sfail, deUint32 dpfail, deUint32 dppa
 
 void ReferenceContext::stencilOpSeparate (deUint32 face, deUint32 sfail, deUint32 dpfail, deUint32 dppass)
 {
+	invalidateRenderState();
+
 	const bool	setFront	= face == GL_FRONT || face == GL_FRONT_AND_BACK;
 	const bool	setBack		= face == GL_BACK || face == GL_FRONT_AND_BACK;
 
@@ -2815,12 +2878,14 @@ void ReferenceContext::stencilOpSeparate (deUint32 face, deUint32 sfail, deUint3
 
 void ReferenceContext::depthFunc (deUint32 func)
 {
+	invalidateRenderState();
 	RC_IF_ERROR(!isValidCompareFunc(func), GL_INVALID_ENUM, RC_RET_VOID);
 	m_depthFunc = func;
 }
 
 void ReferenceContext::depthRangef (float n, float f)
 {
+	invalidateRenderState();
 	m_depthRangeNear = de::clamp(n, 0.0f, 1.0f);
 	m_depthRangeFar = de::clamp(f, 0.0f, 1.0f);
 }
@@ -2832,12 +2897,15 @@ void ReferenceContext::depthRange (double n, double f)
 
 void ReferenceContext::polygonOffset (float factor, float units)
 {
+	invalidateRenderState();
 	m_polygonOffsetFactor = factor;
 	m_polygonOffsetUnits = units;
 }
 
 void ReferenceContext::provokingVertex (deUint32 convention)
 {
+	invalidateRenderState();
+
 	// only in core
 	DE_ASSERT(glu::isContextTypeGLCore(getType()));
 
@@ -2853,6 +2921,8 @@ void ReferenceContext::provokingVertex (deUint32 convention)
 
 void ReferenceContext::primitiveRestartIndex (deUint32 index)
 {
+	invalidateRenderState();
+
 	// only in core
 	DE_ASSERT(glu::isContextTypeGLCore(getType()));
 	m_primitiveRestartIndex = index;
@@ -2895,6 +2965,8 @@ static bool isValidBlendFactor (deUint32 factor)
 
 void ReferenceContext::blendEquation (deUint32 mode)
 {
+	invalidateRenderState();
+
 	RC_IF_ERROR(!isValidBlendEquation(mode), GL_INVALID_ENUM, RC_RET_VOID);
 
 	m_blendModeRGB		= mode;
@@ -2903,6 +2975,8 @@ void ReferenceContext::blendEquation (deUint32 mode)
 
 void ReferenceContext::blendEquationSeparate (deUint32 modeRGB, deUint32 modeAlpha)
 {
+	invalidateRenderState();
+
 	RC_IF_ERROR(!isValidBlendEquation(modeRGB) ||
 				!isValidBlendEquation(modeAlpha),
 				GL_INVALID_ENUM, RC_RET_VOID);
@@ -2913,6 +2987,8 @@ void ReferenceContext::blendEquationSeparate (deUint32 modeRGB, deUint32 modeAlp
 
 void ReferenceContext::blendFunc (deUint32 src, deUint32 dst)
 {
+	invalidateRenderState();
+
 	RC_IF_ERROR(!isValidBlendFactor(src) ||
 				!isValidBlendFactor(dst),
 				GL_INVALID_ENUM, RC_RET_VOID);
@@ -2925,6 +3001,8 @@ void ReferenceContext::blendFunc (deUint32 src, deUint32 dst)
 
 void ReferenceContext::blendFuncSeparate (deUint32 srcRGB, deUint32 dstRGB, deUint32 srcAlpha, deUint32 dstAlpha)
 {
+	invalidateRenderState();
+
 	RC_IF_ERROR(!isValidBlendFactor(srcRGB)		||
 				!isValidBlendFactor(dstRGB)		||
 				!isValidBlendFactor(srcAlpha)	||
@@ -2939,6 +3017,8 @@ void ReferenceContext::blendFuncSeparate (deUint32 srcRGB, deUint32 dstRGB, deUi
 
 void ReferenceContext::blendColor (float red, float green, float blue, float alpha)
 {
+	invalidateRenderState();
+
 	m_blendColor = Vec4(de::clamp(red,	0.0f, 1.0f),
 						de::clamp(green,	0.0f, 1.0f),
 						de::clamp(blue,	0.0f, 1.0f),
@@ -2947,11 +3027,13 @@ void ReferenceContext::blendColor (float red, float green, float blue, float alp
 
 void ReferenceContext::colorMask (deBool r, deBool g, deBool b, deBool a)
 {
+	invalidateRenderState();
 	m_colorMask = tcu::BVec4(!!r, !!g, !!b, !!a);
 }
 
 void ReferenceContext::depthMask (deBool mask)
 {
+	invalidateRenderState();
 	m_depthMask = !!mask;
 }
 
@@ -2962,6 +3044,8 @@ void ReferenceContext::stencilMask (deUint32 mask)
 
 void ReferenceContext::stencilMaskSeparate (deUint32 face, deUint32 mask)
 {
+	invalidateRenderState();
+
 	const bool	setFront	= face == GL_FRONT || face == GL_FRONT_AND_BACK;
 	const bool	setBack		= face == GL_BACK || face == GL_FRONT_AND_BACK;
 
@@ -3108,6 +3192,8 @@ deUint32 ReferenceContext::blitResolveMultisampleFramebuffer (deUint32 mask, con
 
 void ReferenceContext::blitFramebuffer (int srcX0, int srcY0, int srcX1, int srcY1, int dstX0, int dstY0, int dstX1, int dstY1, deUint32 mask, deUint32 filter)
 {
+	flushDeferredDraws();
+
 	// p0 in inclusive, p1 exclusive.
 	// Negative width/height means swap.
 	bool	swapSrcX	= srcX1 < srcX0;
@@ -3279,6 +3365,8 @@ void ReferenceContext::blitFramebuffer (int srcX0, int srcY0, int srcX1, int src
 
 void ReferenceContext::invalidateSubFramebuffer (deUint32 target, int numAttachments, const deUint32* attachments, int x, int y, int width, int height)
 {
+	flushDeferredDraws();
+
 	RC_IF_ERROR(target != GL_FRAMEBUFFER, GL_INVALID_ENUM, RC_RET_VOID);
 	RC_IF_ERROR((numAttachments < 0) || (numAttachments > 1 && attachments == DE_NULL), GL_INVALID_VALUE, RC_RET_VOID);
 	RC_IF_ERROR(width < 0 || height < 0, GL_INVALID_VALUE, RC_RET_VOID);
@@ -3335,6 +3423,8 @@ void ReferenceContext::invalidateSubFramebuffer (deUint32 target, int numAttachm
 
 void ReferenceContext::invalidateFramebuffer (deUint32 target, int numAttachments, const deUint32* attachments)
 {
+	flushDeferredDraws();
+
 	// \todo [2012-07-17 pyry] Support multiple color attachments.
 	rr::MultisampleConstPixelBufferAccess	colorBuf0	= getDrawColorbuffer();
 	rr::MultisampleConstPixelBufferAccess	depthBuf	= getDrawDepthbuffer();
@@ -3355,6 +3445,8 @@ void ReferenceContext::invalidateFramebuffer (deUint32 target, int numAttachment
 
 void ReferenceContext::clear (deUint32 buffers)
 {
+	flushDeferredDraws();
+
 	RC_IF_ERROR((buffers & ~(GL_COLOR_BUFFER_BIT|GL_DEPTH_BUFFER_BIT|GL_STENCIL_BUFFER_BIT)) != 0, GL_INVALID_VALUE, RC_RET_VOID);
 
 	rr::MultisamplePixelBufferAccess	colorBuf0	= getDrawColorbuffer();
@@ -3415,6 +3507,8 @@ void ReferenceContext::clear (deUint32 buffers)
 
 void ReferenceContext::clearBufferiv (deUint32 buffer, int drawbuffer, const int* value)
 {
+	flushDeferredDraws();
+
 	RC_IF_ERROR(buffer != GL_COLOR && buffer != GL_STENCIL, GL_INVALID_ENUM, RC_RET_VOID);
 	RC_IF_ERROR(drawbuffer != 0, GL_INVALID_VALUE, RC_RET_VOID); // \todo [2012-04-06 pyry] MRT support.
 
@@ -3465,6 +3559,8 @@ void ReferenceContext::clearBufferiv (deUint32 buffer, int drawbuffer, const int
 
 void ReferenceContext::clearBufferfv (deUint32 buffer, int drawbuffer, const float* value)
 {
+	flushDeferredDraws();
+
 	RC_IF_ERROR(buffer != GL_COLOR && buffer != GL_DEPTH, GL_INVALID_ENUM, RC_RET_VOID);
 	RC_IF_ERROR(drawbuffer != 0, GL_INVALID_VALUE, RC_RET_VOID); // \todo [2012-04-06 pyry] MRT support.
 
@@ -3515,6 +3611,8 @@ void ReferenceContext::clearBufferfv (deUint32 buffer, int drawbuffer, const flo
 
 void ReferenceContext::clearBufferuiv (deUint32 buffer, int drawbuffer, const deUint32* value)
 {
+	flushDeferredDraws();
+
 	RC_IF_ERROR(buffer != GL_COLOR, GL_INVALID_ENUM, RC_RET_VOID);
 	RC_IF_ERROR(drawbuffer != 0, GL_INVALID_VALUE, RC_RET_VOID); // \todo [2012-04-06 pyry] MRT support.
 
@@ -3547,6 +3645,8 @@ void ReferenceContext::clearBufferuiv (deUint32 buffer, int drawbuffer, const de
 
 void ReferenceContext::clearBufferfi (deUint32 buffer, int drawbuffer, float depth, int stencil)
 {
+	flushDeferredDraws();
+
 	RC_IF_ERROR(buffer != GL_DEPTH_STENCIL, GL_INVALID_ENUM, RC_RET_VOID);
 	clearBufferfv(GL_DEPTH, drawbuffer, &depth);
 	clearBufferiv(GL_STENCIL, drawbuffer, &stencil);
@@ -3554,6 +3654,8 @@ void ReferenceContext::clearBufferfi (deUint32 buffer, int drawbuffer, float dep
 
 void ReferenceContext::bindVertexArray (deUint32 array)
 {
+	flushDeferredDraws();
+
 	rc::VertexArray* vertexArrayObject = DE_NULL;
 
 	if (array != 0)
@@ -3587,6 +3689,8 @@ void ReferenceContext::genVertexArrays (int numArrays, deUint32* vertexArrays)
 
 void ReferenceContext::deleteVertexArrays (int numArrays, const deUint32* vertexArrays)
 {
+	flushDeferredDraws();
+
 	for (int i = 0; i < numArrays; i++)
 	{
 		deUint32		name		= vertexArrays[i];
@@ -3599,6 +3703,8 @@ void ReferenceContext::deleteVertexArrays (int numArrays, const deUint32* vertex
 
 void ReferenceContext::vertexAttribPointer (deUint32 index, int rawSize, deUint32 type, deBool normalized, int stride, const void *pointer)
 {
+	flushDeferredDraws();
+
 	const bool allowBGRA	= !glu::isContextTypeES(getType());
 	const int effectiveSize	= (allowBGRA && rawSize == GL_BGRA) ? (4) : (rawSize);
 
@@ -3640,6 +3746,8 @@ void ReferenceContext::vertexAttribPointer (deUint32 index, int rawSize, deUint3
 
 void ReferenceContext::vertexAttribIPointer (deUint32 index, int size, deUint32 type, int stride, const void *pointer)
 {
+	flushDeferredDraws();
+
 	RC_IF_ERROR(index >= (deUint32)m_limits.maxVertexAttribs, GL_INVALID_VALUE, RC_RET_VOID);
 	RC_IF_ERROR(size <= 0 || size > 4, GL_INVALID_VALUE, RC_RET_VOID);
 	RC_IF_ERROR(type != GL_BYTE					&&	type != GL_UNSIGNED_BYTE	&&
@@ -3671,6 +3779,8 @@ void ReferenceContext::vertexAttribIPointer (deUint32 index, int size, deUint32
 
 void ReferenceContext::enableVertexAttribArray (deUint32 index)
 {
+	flushDeferredDraws();
+
 	RC_IF_ERROR(index >= (deUint32)m_limits.maxVertexAttribs, GL_INVALID_VALUE, RC_RET_VOID);
 
 	rc::VertexArray& vao = (m_vertexArrayBinding) ? (*m_vertexArrayBinding) : (m_clientVertexArray);
@@ -3679,6 +3789,8 @@ void ReferenceContext::enableVertexAttribArray (deUint32 index)
 
 void ReferenceContext::disableVertexAttribArray (deUint32 index)
 {
+	flushDeferredDraws();
+
 	RC_IF_ERROR(index >= (deUint32)m_limits.maxVertexAttribs, GL_INVALID_VALUE, RC_RET_VOID);
 
 	rc::VertexArray& vao = (m_vertexArrayBinding) ? (*m_vertexArrayBinding) : (m_clientVertexArray);
@@ -3687,6 +3799,8 @@ void ReferenceContext::disableVertexAttribArray (deUint32 index)
 
 void ReferenceContext::vertexAttribDivisor (deUint32 index, deUint32 divisor)
 {
+	flushDeferredDraws();
+
 	RC_IF_ERROR(index >= (deUint32)m_limits.maxVertexAttribs, GL_INVALID_VALUE, RC_RET_VOID);
 
 	rc::VertexArray& vao = (m_vertexArrayBinding) ? (*m_vertexArrayBinding) : (m_clientVertexArray);
@@ -3695,6 +3809,8 @@ void ReferenceContext::vertexAttribDivisor (deUint32 index, deUint32 divisor)
 
 void ReferenceContext::vertexAttrib1f (deUint32 index, float x)
 {
+	flushDeferredDraws();
+
 	RC_IF_ERROR(index >= (deUint32)m_limits.maxVertexAttribs, GL_INVALID_VALUE, RC_RET_VOID);
 
 	m_currentAttribs[index] = rr::GenericVec4(tcu::Vec4(x, 0, 0, 1));
@@ -3702,6 +3818,8 @@ void ReferenceContext::vertexAttrib1f (deUint32 index, float x)
 
 void ReferenceContext::vertexAttrib2f (deUint32 index, float x, float y)
 {
+	flushDeferredDraws();
+
 	RC_IF_ERROR(index >= (deUint32)m_limits.maxVertexAttribs, GL_INVALID_VALUE, RC_RET_VOID);
 
 	m_currentAttribs[index] = rr::GenericVec4(tcu::Vec4(x, y, 0, 1));
@@ -3709,6 +3827,8 @@ void ReferenceContext::vertexAttrib2f (deUint32 index, float x, float y)
 
 void ReferenceContext::vertexAttrib3f (deUint32 index, float x, float y, float z)
 {
+	flushDeferredDraws();
+
 	RC_IF_ERROR(index >= (deUint32)m_limits.maxVertexAttribs, GL_INVALID_VALUE, RC_RET_VOID);
 
 	m_currentAttribs[index] = rr::GenericVec4(tcu::Vec4(x, y, z, 1));
@@ -3716,6 +3836,8 @@ void ReferenceContext::vertexAttrib3f (deUint32 index, float x, float y, float z
 
 void ReferenceContext::vertexAttrib4f (deUint32 index, float x, float y, float z, float w)
 {
+	flushDeferredDraws();
+
 	RC_IF_ERROR(index >= (deUint32)m_limits.maxVertexAttribs, GL_INVALID_VALUE, RC_RET_VOID);
 
 	m_currentAttribs[index] = rr::GenericVec4(tcu::Vec4(x, y, z, w));
@@ -3723,6 +3845,8 @@ void ReferenceContext::vertexAttrib4f (deUint32 index, float x, float y, float z
 
 void ReferenceContext::vertexAttribI4i (deUint32 index, deInt32 x, deInt32 y, deInt32 z, deInt32 w)
 {
+	flushDeferredDraws();
+
 	RC_IF_ERROR(index >= (deUint32)m_limits.maxVertexAttribs, GL_INVALID_VALUE, RC_RET_VOID);
 
 	m_currentAttribs[index] = rr::GenericVec4(tcu::IVec4(x, y, z, w));
@@ -3730,6 +3854,8 @@ void ReferenceContext::vertexAttribI4i (deUint32 index, deInt32 x, deInt32 y, de
 
 void ReferenceContext::vertexAttribI4ui (deUint32 index, deUint32 x, deUint32 y, deUint32 z, deUint32 w)
 {
+	flushDeferredDraws();
+
 	RC_IF_ERROR(index >= (deUint32)m_limits.maxVertexAttribs, GL_INVALID_VALUE, RC_RET_VOID);
 
 	m_currentAttribs[index] = rr::GenericVec4(tcu::UVec4(x, y, z, w));
@@ -3755,6 +3881,8 @@ deInt32 ReferenceContext::getAttribLocation (deUint32 program, const char *name)
 
 void ReferenceContext::uniformv (deInt32 location, glu::DataType type, deInt32 count, const void* v)
 {
+	flushDeferredDraws();
+
 	RC_IF_ERROR(m_currentProgram == DE_NULL, GL_INVALID_OPERATION, RC_RET_VOID);
 
 	std::vector<sglr::UniformSlot>& uniforms = m_currentProgram->m_program->m_uniforms;
@@ -3775,6 +3903,8 @@ void ReferenceContext::uniformv (deInt32 location, glu::DataType type, deInt32 c
 
 void ReferenceContext::uniform1iv (deInt32 location, deInt32 count, const deInt32* v)
 {
+	flushDeferredDraws();
+
 	RC_IF_ERROR(m_currentProgram == DE_NULL, GL_INVALID_OPERATION, RC_RET_VOID);
 
 	std::vector<sglr::UniformSlot>& uniforms = m_currentProgram->m_program->m_uniforms;
@@ -3861,6 +3991,8 @@ void ReferenceContext::uniform4iv (deInt32 location, deInt32 count, const deInt3
 
 void ReferenceContext::uniformMatrix3fv (deInt32 location, deInt32 count, deBool transpose, const float *value)
 {
+	flushDeferredDraws();
+
 	RC_IF_ERROR(m_currentProgram == DE_NULL, GL_INVALID_OPERATION, RC_RET_VOID);
 
 	std::vector<sglr::UniformSlot>& uniforms = m_currentProgram->m_program->m_uniforms;
@@ -3899,6 +4031,8 @@ void ReferenceContext::uniformMatrix3fv (deInt32 location, deInt32 count, deBool
 
 void ReferenceContext::uniformMatrix4fv (deInt32 location, deInt32 count, deBool transpose, const float *value)
 {
+	flushDeferredDraws();
+
 	RC_IF_ERROR(m_currentProgram == DE_NULL, GL_INVALID_OPERATION, RC_RET_VOID);
 
 	std::vector<sglr::UniformSlot>& uniforms = m_currentProgram->m_program->m_uniforms;
@@ -3951,6 +4085,7 @@ deInt32 ReferenceContext::getUniformLocation (deUint32 program, const char *name
 
 void ReferenceContext::lineWidth (float w)
 {
+	invalidateRenderState();
 	RC_IF_ERROR(w < 0.0f, GL_INVALID_VALUE, RC_RET_VOID);
 	m_lineWidth = w;
 }
@@ -3988,6 +4123,19 @@ void ReferenceContext::deleteProgramObject (rc::ShaderProgramObjectContainer* sp
 	m_programs.releaseReference(sp);
 }
 
+static int getNumPrimitiveVertices (rr::PrimitiveType type)
+{
+	switch (type)
+	{
+		case rr::PRIMITIVETYPE_TRIANGLES:	return 3;
+		case rr::PRIMITIVETYPE_LINES:		return 2;
+		case rr::PRIMITIVETYPE_POINTS:		return 1;
+		default:
+			DE_ASSERT(false);
+			return 0;
+	}
+}
+
 void ReferenceContext::drawArrays (deUint32 mode, int first, int count)
 {
 	drawArraysInstanced(mode, first, count, 1);
@@ -4007,7 +4155,29 @@ void ReferenceContext::drawArraysInstanced (deUint32 mode, int first, int count,
 	{
 		const rr::PrimitiveType primitiveType = sglr::rr_util::mapGLPrimitiveType(mode);
 
-		drawWithReference(rr::PrimitiveList(primitiveType, count, first), instanceCount);
+		if (instanceCount == 1 && canBatchDraw(primitiveType))
+		{
+			const bool continuesDeferred	= m_deferredDraw.count > 0									&&
+											  m_deferredDraw.primitiveType == primitiveType				&&
+											  m_deferredDraw.first + m_deferredDraw.count == first		&&
+											  m_deferredDraw.count % getNumPrimitiveVertices(primitiveType) == 0;
+
+			if (continuesDeferred)
+				m_deferredDraw.count += count;
+			else
+			{
+				flushDeferredDraws();
+
+				m_deferredDraw.primitiveType	= primitiveType;
+				m_deferredDraw.first			= first;
+				m_deferredDraw.count			= count;
+			}
+		}
+		else
+		{
+			flushDeferredDraws();
+			drawWithReference(rr::PrimitiveList(primitiveType, count, first), instanceCount);
+		}
 	}
 }
 
@@ -4028,6 +4198,8 @@ void ReferenceContext::drawElementsInstanced (deUint32 mode, int count, deUint32
 
 void ReferenceContext::drawElementsInstancedBaseVertex (deUint32 mode, int count, deUint32 type, const void *indices, int instanceCount, int baseVertex)
 {
+	flushDeferredDraws();
+
 	rc::VertexArray& vao = (m_vertexArrayBinding) ? (*m_vertexArrayBinding) : (m_clientVertexArray);
 
 	// Error conditions
@@ -4274,38 +4446,69 @@ static deUint32 getFixedRestartIndex (rr::IndexType indexType)
 	}
 }
 
-void ReferenceContext::drawWithReference (const rr::PrimitiveList& primitives, int instanceCount)
+void ReferenceContext::setDrawBatchingEnabled (bool enabled)
 {
-	// undefined results
-	if (m_currentProgram == DE_NULL)
-		return;
+	flushDeferredDraws();
+	m_drawBatchingEnabled = enabled;
+}
 
-	rr::MultisamplePixelBufferAccess	colorBuf0	= getDrawColorbuffer();
-	rr::MultisamplePixelBufferAccess	depthBuf	= getDepthMultisampleAccess(getDrawDepthbuffer());
-	rr::MultisamplePixelBufferAccess	stencilBuf	= getStencilMultisampleAccess(getDrawStencilbuffer());
-	const bool							hasStencil	= !isEmpty(stencilBuf);
-	const int							stencilBits	= (hasStencil) ? (getNumStencilBits(stencilBuf.raw().getFormat())) : (0);
+void ReferenceContext::invalidateRenderState (void)
+{
+	flushDeferredDraws();
+	m_renderStateGeneration += 1;
+}
 
-	const rr::RenderTarget				renderTarget(colorBuf0, depthBuf, stencilBuf);
-	const rr::Program					program		(m_currentProgram->m_program->getVertexShader(),
-													 m_currentProgram->m_program->getFragmentShader(),
-													 (m_currentProgram->m_program->m_hasGeometryShader) ? (m_currentProgram->m_program->getGeometryShader()) : (DE_NULL));
-	rr::RenderState						state		((rr::ViewportState)(colorBuf0));
+bool ReferenceContext::canBatchDraw (rr::PrimitiveType primitiveType) const
+{
+	if (!m_drawBatchingEnabled || m_currentProgram == DE_NULL || m_currentProgram->m_program->m_hasGeometryShader)
+		return false;
 
-	const rr::Renderer					referenceRenderer;
-	std::vector<rr::VertexAttrib>		vertexAttribs;
+	// Only independent primitives can be merged without changing primitive assembly.
+	if (primitiveType != rr::PRIMITIVETYPE_TRIANGLES &&
+		primitiveType != rr::PRIMITIVETYPE_LINES &&
+		primitiveType != rr::PRIMITIVETYPE_POINTS)
+		return false;
+
+	// \note PRIMITIVE_RESTART applies to non-indexed draws as well, and restart vertex could land inside merged range.
+	if (m_primitiveRestartSettableIndex)
+		return false;
 
-	// Gen state
+	// Client-side arrays may be modified by the application after the draw call returns.
 	{
-		const rr::PrimitiveType	baseType							= getPrimitiveBaseType(primitives.getPrimitiveType());
-		const bool				polygonOffsetEnabled				= (baseType == rr::PRIMITIVETYPE_TRIANGLES) ? (m_polygonOffsetFillEnabled) : (false);
+		const rc::VertexArray& vao = (m_vertexArrayBinding) ? (*m_vertexArrayBinding) : (m_clientVertexArray);
+
+		for (size_t ndx = 0; ndx < vao.m_arrays.size(); ++ndx)
+		{
+			if (vao.m_arrays[ndx].enabled && !vao.m_arrays[ndx].bufferDeleted && !vao.m_arrays[ndx].bufferBinding)
+				return false;
+		}
+	}
+
+	return true;
+}
+
+void ReferenceContext::flushDeferredDraws (void)
+{
+	if (m_deferredDraw.count > 0)
+	{
+		const DeferredDraw draw = m_deferredDraw;
+
+		m_deferredDraw = DeferredDraw();
+		drawWithReference(rr::PrimitiveList(draw.primitiveType, draw.count, draw.first), 1);
+	}
+}
+
+const rr::RenderState& ReferenceContext::getCachedRenderState (void)
+{
+	if (m_cachedRenderStateGeneration != m_renderStateGeneration)
+	{
+		rr::RenderState& state = m_cachedRenderState;
 
 		//state.cullMode											= m_cullMode
 
 		state.fragOps.scissorTestEnabled							= m_scissorEnabled;
 		state.fragOps.scissorRectangle								= rr::WindowRectangle(m_scissorBox.x(), m_scissorBox.y(), m_scissorBox.z(), m_scissorBox.w());
 
-		state.fragOps.numStencilBits								= stencilBits;
 		state.fragOps.stencilTestEnabled							= m_stencilTestEnabled;
 
 		for (int faceType = 0; faceType < rr::FACETYPE_LAST; faceType++)
@@ -4345,10 +4548,46 @@ void ReferenceContext::drawWithReference (const rr::PrimitiveList& primitives, i
 		//state.point.pointSize										= m_pointSize;
 		state.line.lineWidth										= m_lineWidth;
 
-		state.fragOps.polygonOffsetEnabled							= polygonOffsetEnabled;
 		state.fragOps.polygonOffsetFactor							= m_polygonOffsetFactor;
 		state.fragOps.polygonOffsetUnits							= m_polygonOffsetUnits;
 
+		state.provokingVertexConvention								= (m_provokingFirstVertexConvention) ? (rr::PROVOKINGVERTEX_FIRST) : (rr::PROVOKINGVERTEX_LAST);
+
+		m_cachedRenderStateGeneration = m_renderStateGeneration;
+	}
+
+	return m_cachedRenderState;
+}
+
+void ReferenceContext::drawWithReference (const rr::PrimitiveList& primitives, int instanceCount)
+{
+	// undefined results
+	if (m_currentProgram == DE_NULL)
+		return;
+
+	rr::MultisamplePixelBufferAccess	colorBuf0	= getDrawColorbuffer();
+	rr::MultisamplePixelBufferAccess	depthBuf	= getDepthMultisampleAccess(getDrawDepthbuffer());
+	rr::MultisamplePixelBufferAccess	stencilBuf	= getStencilMultisampleAccess(getDrawStencilbuffer());
+	const bool							hasStencil	= !isEmpty(stencilBuf);
+	const int							stencilBits	= (hasStencil) ? (getNumStencilBits(stencilBuf.raw().getFormat())) : (0);
+
+	const rr::RenderTarget				renderTarget(colorBuf0, depthBuf, stencilBuf);
+	const rr::Program					program		(m_currentProgram->m_program->getVertexShader(),
+													 m_currentProgram->m_program->getFragmentShader(),
+													 (m_currentProgram->m_program->m_hasGeometryShader) ? (m_currentProgram->m_program->getGeometryShader()) : (DE_NULL));
+	rr::RenderState						state		(getCachedRenderState());
+
+	const rr::Renderer					referenceRenderer;
+	std::vector<rr::VertexAttrib>		vertexAttribs;
+
+	// Primitive and framebuffer dependent state
+	{
+		const rr::PrimitiveType	baseType							= getPrimitiveBaseType(primitives.getPrimitiveType());
+		const bool				polygonOffsetEnabled				= (baseType == rr::PRIMITIVETYPE_TRIANGLES) ? (m_polygonOffsetFillEnabled) : (false);
+
+		state.fragOps.numStencilBits								= stencilBits;
+		state.fragOps.polygonOffsetEnabled							= polygonOffsetEnabled;
+
 		{
 			const rr::IndexType indexType = primitives.getIndexType();
 
@@ -4368,8 +4607,6 @@ void ReferenceContext::drawWithReference (const rr::PrimitiveList& primitives, i
 				state.restart.enabled = false;
 			}
 		}
-
-		state.provokingVertexConvention								= (m_provokingFirstVertexConvention) ? (rr::PROVOKINGVERTEX_FIRST) : (rr::PROVOKINGVERTEX_LAST);
 	}
 
 	// gen attributes
@@ -4544,6 +4781,8 @@ deUint32 ReferenceContext::createProgram (ShaderProgram* program)
 
 void ReferenceContext::useProgram (deUint32 program)
 {
+	flushDeferredDraws();
+
 	rc::ShaderProgramObjectContainer* shaderProg			= DE_NULL;
 	rc::ShaderProgramObjectContainer* programToBeDeleted	= DE_NULL;
 
@@ -4570,6 +4809,8 @@ void ReferenceContext::useProgram (deUint32 program)
 
 void ReferenceContext::deleteProgram (deUint32 program)
 {
+	flushDeferredDraws();
+
 	if (!program)
 		return;
 
@@ -4590,6 +4831,8 @@ void ReferenceContext::deleteProgram (deUint32 program)
 
 void ReferenceContext::readPixels (int x, int y, int width, int height, deUint32 format, deUint32 type, void* data)
 {
+	flushDeferredDraws();
+
 	rr::MultisamplePixelBufferAccess	src = getReadColorbuffer();
 	TextureFormat						transferFmt;
 
@@ -4617,6 +4860,7 @@ deUint32 ReferenceContext::getError (void)
 
 void ReferenceContext::finish (void)
 {
+	flushDeferredDraws();
 }
 
 inline void ReferenceContext::setError (deUint32 error)
@@ -4912,6 +5156,8 @@ void Texture2D::sample4 (tcu::Vec4 output[4], const tcu::Vec2 packetTexcoords[4]
 	const tcu::Vec2 dFdy0 = packetTexcoords[2] - packetTexcoords[0];
 	const tcu::Vec2 dFdy1 = packetTexcoords[3] - packetTexcoords[1];
 
+	float lods[4];
+
 	for (int fragNdx = 0; fragNdx < 4; ++fragNdx)
 	{
 		const tcu::Vec2& dFdx = (fragNdx & 2) ? dFdx1 : dFdx0;
@@ -4921,10 +5167,10 @@ void Texture2D::sample4 (tcu::Vec4 output[4], const tcu::Vec2 packetTexcoords[4]
 		const float mv = de::max(de::abs(dFdx.y()), de::abs(dFdy.y()));
 		const float p = de::max(mu * texWidth, mv * texHeight);
 
-		const float	lod = deFloatLog2(p) + lodBias;
-
-		output[fragNdx] = sample(packetTexcoords[fragNdx].x(), packetTexcoords[fragNdx].y(), lod);
+		lods[fragNdx] = deFloatLog2(p) + lodBias;
 	}
+
+	m_view.samplePacket(output, getSampler(), packetTexcoords, lods, 4);
 }
 
 TextureCube::TextureCube (deUint32 name)
@@ -609,7 +609,7 @@ public:
 	virtual int				getWidth				(void) const	{ return m_defaultColorbuffer.raw().getHeight();	}
 	virtual int				getHeight				(void) const	{ return m_defaultColorbuffer.raw().getDepth();		}
 
-	virtual void			viewport				(int x, int y, int width, int height) { m_viewport = tcu::IVec4(x, y, width, height); }
+	virtual void			viewport				(int x, int y, int width, int height) { invalidateRenderState(); m_viewport = tcu::IVec4(x, y, width, height); }
 	virtual void			activeTexture			(deUint32 texture);
 
 	virtual void			bindTexture				(deUint32 target, deUint32 texture);
@@ -763,6 +763,22 @@ public:
 	virtual void			getIntegerv				(deUint32 pname, int* params);
 	virtual const char*		getString				(deUint32 pname);
 
+	/*--------------------------------------------------------------------*//*!
+	 * \brief Enable or disable draw batching
+	 *
+	 * When enabled, non-instanced DrawArrays calls rendering independent
+	 * primitives from buffer objects are deferred, and consecutive such
+	 * draws continuing the same vertex range are merged into a single
+	 * reference renderer draw. Deferred draws are executed before any other
+	 * call that modifies state or accesses framebuffer contents, such as
+	 * readPixels() or finish().
+	 *
+	 * Since merged draws are rendered as a single draw, primitive IDs are
+	 * not reset between them. Framebuffer contents must not be accessed
+	 * directly without calling finish() first.
+	 *//*--------------------------------------------------------------------*/
+	void					setDrawBatchingEnabled	(bool enabled);
+
 	// Expose helpers from Context.
 	using Context::readPixels;
 	using Context::texImage2D;
@@ -813,6 +829,10 @@ private:
 
 	bool					predrawErrorChecks		(deUint32 mode);
 	void					drawWithReference		(const rr::PrimitiveList& primitives, int instanceCount);
+	const rr::RenderState&	getCachedRenderState	(void);
+	void					invalidateRenderState	(void);
+	bool					canBatchDraw			(rr::PrimitiveType primitiveType) const;
+	void					flushDeferredDraws		(void);
 
 	// Helpers for getting valid access object based on current unpack state.
 	tcu::ConstPixelBufferAccess		getUnpack2DAccess		(const tcu::TextureFormat& format, int width, int height, const void* data);
@@ -867,6 +887,15 @@ private:
 		StencilState (void);
 	};
 
+	struct DeferredDraw
+	{
+		rr::PrimitiveType	primitiveType;
+		int					first;
+		int					count;		//!< 0 if there is no deferred draw
+
+		DeferredDraw (void) : primitiveType(rr::PRIMITIVETYPE_LAST), first(0), count(0) {}
+	};
+
 	ReferenceContextLimits						m_limits;
 
 	rr::MultisamplePixelBufferAccess			m_defaultColorbuffer;
@@ -961,6 +990,13 @@ private:
 
 	deUint32									m_lastError;
 
+	deUint32									m_renderStateGeneration;		//!< Incremented whenever state translated to m_cachedRenderState changes
+	deUint32									m_cachedRenderStateGeneration;
+	rr::RenderState								m_cachedRenderState;
+
+	bool										m_drawBatchingEnabled;
+	DeferredDraw								m_deferredDraw;
+
 	rr::FragmentProcessor						m_fragmentProcessor;
 	std::vector<rr::Fragment>					m_fragmentBuffer;
 	std::vector<float>							m_fragmentDepths;
@@ -650,6 +650,43 @@ deBool qpTestLog_writeFloat (qpTestLog* log, const char* name, const char* descr
 	return qpTestLog_writeKeyValuePair(log, "Number", name, description, unit, tag, tmpString);
 }
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Write accumulated timing of a profiled scope into log
+ * \param log			qpTestLog instance
+ * \param name			Name of the profiled scope
+ * \param count			Number of times scope was entered
+ * \param durationUs	Total time spent in scope in microseconds
+ * \return true if ok, false otherwise
+ *//*--------------------------------------------------------------------*/
+deBool qpTestLog_writeTiming (qpTestLog* log, const char* name, int count, deInt64 durationUs)
+{
+	char			tmpString[64];
+	qpXmlAttribute	attribs[3];
+	int				numAttribs	= 0;
+
+	DE_ASSERT(log && name);
+	deMutex_lock(log->lock);
+
+	int64ToString(durationUs, tmpString);
+
+	attribs[numAttribs++] = qpSetStringAttrib("Name", name);
+	attribs[numAttribs++] = qpSetIntAttrib("Count", count);
+	attribs[numAttribs++] = qpSetStringAttrib("Unit", "us");
+
+	/* <Timing Name="name" Count="3" Unit="us">1500</Timing> */
+	if (!qpXmlWriter_startElement(log->writer, "Timing", numAttribs, attribs) ||
+		!qpXmlWriter_writeString(log->writer, tmpString) ||
+		!qpXmlWriter_endElement(log->writer, "Timing"))
+	{
+		qpPrintf("qpTestLog_writeTiming(): Writing XML failed\n");
+		deMutex_unlock(log->lock);
+		return DE_FALSE;
+	}
+
+	deMutex_unlock(log->lock);
+	return DE_TRUE;
+}
+
 typedef struct Buffer_s
 {
 	size_t		capacity;
@@ -204,6 +204,7 @@ deBool			qpTestLog_endSection			(qpTestLog* log);
 deBool			qpTestLog_writeText				(qpTestLog* log, const char* name, const char* description, qpKeyValueTag tag, const char* value);
 deBool			qpTestLog_writeInteger			(qpTestLog* log, const char* name, const char* description, const char* unit, qpKeyValueTag tag, deInt64 value);
 deBool			qpTestLog_writeFloat			(qpTestLog* log, const char* name, const char* description, const char* unit, qpKeyValueTag tag, float value);
+deBool			qpTestLog_writeTiming			(qpTestLog* log, const char* name, int count, deInt64 durationUs);
 
 deBool			qpTestLog_startImageSet			(qpTestLog* log, const char* name, const char* description);
 deBool			qpTestLog_endImageSet			(qpTestLog* log);
@@ -86,21 +86,21 @@ void CustomAbsOp::tokenize (GeneratorState& state, TokenStream& str) const
 	str << Token::RIGHT_PAREN;
 }
 
-void CustomAbsOp::evaluate (ExecutionContext& execCtx)
+namespace
 {
-	m_child->evaluate(execCtx);
 
-	ExecConstValueAccess	srcValue	= m_child->getValue();
-	ExecValueAccess			dstValue	= m_value.getValue(m_type);
+struct EvaluateAbs
+{
+	inline float operator() (float a) const { return deFloatAbs(a); }
+};
 
-	for (int elemNdx = 0; elemNdx < m_type.getNumElements(); elemNdx++)
-	{
-		ExecConstValueAccess	srcComp		= srcValue.component(elemNdx);
-		ExecValueAccess			dstComp		= dstValue.component(elemNdx);
+} // anonymous
 
-		for (int compNdx = 0; compNdx < EXEC_VEC_WIDTH; compNdx++)
-			dstComp.asFloat(compNdx) = deFloatAbs(srcComp.asFloat(compNdx));
-	}
+void CustomAbsOp::evaluate (ExecutionContext& execCtx)
+{
+	m_child->evaluate(execCtx);
+
+	execUnaryVec<float, EvaluateAbs>(m_value.getValue(m_type), m_child->getValue());
 }
 
 typedef BinaryOp<5, ASSOCIATIVITY_LEFT> CustomBinaryBase;
@@ -173,11 +173,7 @@ void CustomBinaryOp<ComputeValue>::evaluate(ExecValueAccess dst, ExecConstValueA
 	DE_ASSERT(dst.getType() == b.getType());
 	DE_ASSERT(dst.getType().getBaseType() == VariableType::TYPE_FLOAT);
 
-	for (int elemNdx = 0; elemNdx < dst.getType().getNumElements(); elemNdx++)
-	{
-		for (int compNdx = 0; compNdx < EXEC_VEC_WIDTH; compNdx++)
-			dst.component(elemNdx).asFloat(compNdx) = ComputeValue()(a.component(elemNdx).asFloat(compNdx),b.component(elemNdx).asFloat(compNdx));
-	}
+	execBinaryVec<float, float, ComputeValue>(dst, a, b);
 }
 
 template <>
@@ -186,11 +182,7 @@ void CustomBinaryOp<EvaluateLessThan>::evaluate(ExecValueAccess dst, ExecConstVa
 	DE_ASSERT(a.getType() == b.getType());
 	DE_ASSERT(dst.getType().getBaseType() == VariableType::TYPE_BOOL);
 
-	for (int elemNdx = 0; elemNdx < dst.getType().getNumElements(); elemNdx++)
-	{
-		for (int compNdx = 0; compNdx < EXEC_VEC_WIDTH; compNdx++)
-			dst.component(elemNdx).asBool(compNdx) = EvaluateLessThan()(a.component(elemNdx).asFloat(compNdx),b.component(elemNdx).asFloat(compNdx));
-	}
+	execBinaryVec<bool, float, EvaluateLessThan>(dst, a, b);
 }
 
 template <int Precedence, Associativity Assoc>
@@ -440,19 +432,11 @@ void BinaryVecOp<Precedence, Float, Int, Bool, ComputeValueRange, EvaluateComp>:
 	switch (dst.getType().getBaseType())
 	{
 		case VariableType::TYPE_FLOAT:
-			for (int elemNdx = 0; elemNdx < dst.getType().getNumElements(); elemNdx++)
-			{
-				for (int compNdx = 0; compNdx < EXEC_VEC_WIDTH; compNdx++)
-					dst.component(elemNdx).asFloat(compNdx) = EvaluateComp()(a.component(elemNdx).asFloat(compNdx), b.component(elemNdx).asFloat(compNdx));
-			}
+			execBinaryVec<float, float, EvaluateComp>(dst, a, b);
 			break;
 
 		case VariableType::TYPE_INT:
-			for (int elemNdx = 0; elemNdx < dst.getType().getNumElements(); elemNdx++)
-			{
-				for (int compNdx = 0; compNdx < EXEC_VEC_WIDTH; compNdx++)
-					dst.component(elemNdx).asInt(compNdx) = EvaluateComp()(a.component(elemNdx).asInt(compNdx), b.component(elemNdx).asInt(compNdx));
-			}
+			execBinaryVec<int, int, EvaluateComp>(dst, a, b);
 			break;
 
 		default:
@@ -697,13 +681,11 @@ void RelationalOp<ComputeValueRange, EvaluateComp>::evaluate (ExecValueAccess ds
 	switch (a.getType().getBaseType())
 	{
 		case VariableType::TYPE_FLOAT:
-			for (int compNdx = 0; compNdx < EXEC_VEC_WIDTH; compNdx++)
-				dst.asBool(compNdx) = EvaluateComp()(a.asFloat(compNdx), b.asFloat(compNdx));
+			execBinaryLanes<bool, float, EvaluateComp>(dst.getValuePtr(), a.getValuePtr(), b.getValuePtr());
 			break;
 
 		case VariableType::TYPE_INT:
-			for (int compNdx = 0; compNdx < EXEC_VEC_WIDTH; compNdx++)
-				dst.asBool(compNdx) = EvaluateComp()(a.asInt(compNdx), b.asInt(compNdx));
+			execBinaryLanes<bool, int, EvaluateComp>(dst.getValuePtr(), a.getValuePtr(), b.getValuePtr());
 			break;
 
 		default:
@@ -1038,43 +1020,18 @@ void EqualityComparisonOp<IsEqual>::evaluate (ExecValueAccess dst, ExecConstValu
 {
 	DE_ASSERT(a.getType() == b.getType());
 
-
 	switch (a.getType().getBaseType())
 	{
 		case VariableType::TYPE_FLOAT:
-			for (int compNdx = 0; compNdx < EXEC_VEC_WIDTH; compNdx++)
-			{
-				bool result = IsEqual ? true : false;
-
-				for (int elemNdx = 0; elemNdx < a.getType().getNumElements(); elemNdx++)
-					result = EqualityCompare<IsEqual>::combine(result, EqualityCompare<IsEqual>::compare(a.component(elemNdx).asFloat(compNdx), b.component(elemNdx).asFloat(compNdx)));
-
-				dst.asBool(compNdx) = result;
-			}
+			execCompareReduce<float, EqualityCompare<IsEqual> >(dst, a, b, IsEqual);
 			break;
 
 		case VariableType::TYPE_INT:
-			for (int compNdx = 0; compNdx < EXEC_VEC_WIDTH; compNdx++)
-			{
-				bool result = IsEqual ? true : false;
-
-				for (int elemNdx = 0; elemNdx < a.getType().getNumElements(); elemNdx++)
-					result = EqualityCompare<IsEqual>::combine(result, EqualityCompare<IsEqual>::compare(a.component(elemNdx).asInt(compNdx), b.component(elemNdx).asInt(compNdx)));
-
-				dst.asBool(compNdx) = result;
-			}
+			execCompareReduce<int, EqualityCompare<IsEqual> >(dst, a, b, IsEqual);
 			break;
 
 		case VariableType::TYPE_BOOL:
-			for (int compNdx = 0; compNdx < EXEC_VEC_WIDTH; compNdx++)
-			{
-				bool result = IsEqual ? true : false;
-
-				for (int elemNdx = 0; elemNdx < a.getType().getNumElements(); elemNdx++)
-					result = EqualityCompare<IsEqual>::combine(result, EqualityCompare<IsEqual>::compare(a.component(elemNdx).asBool(compNdx), b.component(elemNdx).asBool(compNdx)));
-
-				dst.asBool(compNdx) = result;
-			}
+			execCompareReduce<bool, EqualityCompare<IsEqual> >(dst, a, b, IsEqual);
 			break;
 
 		default:
@@ -104,17 +104,7 @@ void UnaryBuiltinVecFunc<GetValueRangeWeight, ComputeValueRange, Evaluate>::eval
 {
 	m_child->evaluate(execCtx);
 
-	ExecConstValueAccess	srcValue	= m_child->getValue();
-	ExecValueAccess			dstValue	= m_value.getValue(m_inValueRange.getType());
-
-	for (int elemNdx = 0; elemNdx < m_inValueRange.getType().getNumElements(); elemNdx++)
-	{
-		ExecConstValueAccess	srcComp		= srcValue.component(elemNdx);
-		ExecValueAccess			dstComp		= dstValue.component(elemNdx);
-
-		for (int compNdx = 0; compNdx < EXEC_VEC_WIDTH; compNdx++)
-			dstComp.asFloat(compNdx) = Evaluate()(srcComp.asFloat(compNdx));
-	}
+	execUnaryVec<float, Evaluate>(m_value.getValue(m_inValueRange.getType()), m_child->getValue());
 }
 
 template <class GetValueRangeWeight, class ComputeValueRange, class Evaluate>
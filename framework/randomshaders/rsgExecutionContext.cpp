@@ -42,6 +42,16 @@ ExecConstValueAccess ExecMaskStorage::getValue (void) const
 	return ExecConstValueAccess(VariableType::getScalarType(VariableType::TYPE_BOOL), m_data);
 }
 
+namespace
+{
+
+struct LogicalAnd
+{
+	inline bool operator() (bool a, bool b) const { return a && b; }
+};
+
+} // anonymous
+
 ExecutionContext::ExecutionContext (const Sampler2DMap& samplers2D, const SamplerCubeMap& samplersCube)
 	: m_samplers2D		(samplers2D)
 	, m_samplersCube	(samplersCube)
@@ -95,8 +105,7 @@ void ExecutionContext::andExecutionMask (ExecConstValueAccess value)
 	ExecValueAccess			newValue	= tmp.getValue();
 	ExecConstValueAccess	oldValue	= getExecutionMask();
 
-	for (int i = 0; i < EXEC_VEC_WIDTH; i++)
-		newValue.asBool(i) = oldValue.asBool(i) && value.asBool(i);
+	execBinaryLanes<bool, bool, LogicalAnd>(newValue.getValuePtr(), oldValue.getValuePtr(), value.getValuePtr());
 
 	pushExecutionMask(newValue);
 }
@@ -148,16 +157,15 @@ void assignMasked (ExecValueAccess dst, ExecConstValueAccess src, ExecConstValue
 		case VariableType::TYPE_SAMPLER_2D:
 		case VariableType::TYPE_SAMPLER_CUBE:
 		{
+			const Scalar*	maskPtr		= mask.getValuePtr();
+
 			for (int elemNdx = 0; elemNdx < type.getNumElements(); elemNdx++)
 			{
-				ExecValueAccess			dstElem		= dst.component(elemNdx);
-				ExecConstValueAccess	srcElem		= src.component(elemNdx);
+				Scalar*			dstPtr		= dst.getValuePtr() + elemNdx*EXEC_VEC_WIDTH;
+				const Scalar*	srcPtr		= src.getValuePtr() + elemNdx*EXEC_VEC_WIDTH;
 
 				for (int compNdx = 0; compNdx < EXEC_VEC_WIDTH; compNdx++)
-				{
-					if (mask.asBool(compNdx))
-						dstElem.asScalar(compNdx) = srcElem.asScalar(compNdx);
-				}
+					dstPtr[compNdx] = maskPtr[compNdx].boolVal ? srcPtr[compNdx] : dstPtr[compNdx];
 			}
 
 			break;
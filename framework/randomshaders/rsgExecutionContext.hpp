@@ -86,6 +86,78 @@ protected:
 
 void assignMasked (ExecValueAccess dst, ExecConstValueAccess src, ExecConstValueAccess mask);
 
+// Packet kernels.
+//
+// Each kernel evaluates an operation for all EXEC_VEC_WIDTH lanes of a value.
+// Lanes of a single scalar component are stored contiguously, so the kernels
+// walk plain Scalar pointers instead of going through the strided access
+// helpers per lane. This keeps the inner loops simple enough for the compiler
+// to vectorize. Results are identical to evaluating each lane separately.
+
+template <typename DstT, typename SrcT, class Evaluate>
+inline void execUnaryLanes (Scalar* dst, const Scalar* src)
+{
+	for (int laneNdx = 0; laneNdx < EXEC_VEC_WIDTH; laneNdx++)
+		dst[laneNdx].as<DstT>() = Evaluate()(src[laneNdx].as<SrcT>());
+}
+
+template <typename DstT, typename SrcT, class Evaluate>
+inline void execBinaryLanes (Scalar* dst, const Scalar* a, const Scalar* b)
+{
+	for (int laneNdx = 0; laneNdx < EXEC_VEC_WIDTH; laneNdx++)
+		dst[laneNdx].as<DstT>() = Evaluate()(a[laneNdx].as<SrcT>(), b[laneNdx].as<SrcT>());
+}
+
+//! Component-wise unary operation, dst and src must have same number of elements.
+template <typename T, class Evaluate>
+void execUnaryVec (ExecValueAccess dst, ExecConstValueAccess src)
+{
+	const int numElements = dst.getType().getNumElements();
+
+	DE_ASSERT(src.getType().getNumElements() == numElements);
+
+	for (int elemNdx = 0; elemNdx < numElements; elemNdx++)
+		execUnaryLanes<T, T, Evaluate>(dst.getValuePtr() + elemNdx*EXEC_VEC_WIDTH, src.getValuePtr() + elemNdx*EXEC_VEC_WIDTH);
+}
+
+//! Component-wise binary operation, dst, a and b must have same number of elements.
+template <typename DstT, typename SrcT, class Evaluate>
+void execBinaryVec (ExecValueAccess dst, ExecConstValueAccess a, ExecConstValueAccess b)
+{
+	const int numElements = dst.getType().getNumElements();
+
+	DE_ASSERT(a.getType().getNumElements() == numElements);
+	DE_ASSERT(b.getType().getNumElements() == numElements);
+
+	for (int elemNdx = 0; elemNdx < numElements; elemNdx++)
+		execBinaryLanes<DstT, SrcT, Evaluate>(dst.getValuePtr() + elemNdx*EXEC_VEC_WIDTH, a.getValuePtr() + elemNdx*EXEC_VEC_WIDTH, b.getValuePtr() + elemNdx*EXEC_VEC_WIDTH);
+}
+
+//! Reduce component-wise comparison of a and b into single boolean using Compare::compare() and Compare::combine().
+template <typename T, class Compare>
+void execCompareReduce (ExecValueAccess dst, ExecConstValueAccess a, ExecConstValueAccess b, bool initVal)
+{
+	const int	numElements	= a.getType().getNumElements();
+	bool		result[EXEC_VEC_WIDTH];
+
+	DE_ASSERT(b.getType().getNumElements() == numElements);
+
+	for (int laneNdx = 0; laneNdx < EXEC_VEC_WIDTH; laneNdx++)
+		result[laneNdx] = initVal;
+
+	for (int elemNdx = 0; elemNdx < numElements; elemNdx++)
+	{
+		const Scalar* aPtr = a.getValuePtr() + elemNdx*EXEC_VEC_WIDTH;
+		const Scalar* bPtr = b.getValuePtr() + elemNdx*EXEC_VEC_WIDTH;
+
+		for (int laneNdx = 0; laneNdx < EXEC_VEC_WIDTH; laneNdx++)
+			result[laneNdx] = Compare::combine(result[laneNdx], Compare::compare(aPtr[laneNdx].as<T>(), bPtr[laneNdx].as<T>()));
+	}
+
+	for (int laneNdx = 0; laneNdx < EXEC_VEC_WIDTH; laneNdx++)
+		dst.getValuePtr()[laneNdx].as<bool>() = result[laneNdx];
+}
+
 } // rsg
 
 #endif // _RSGEXECUTIONCONTEXT_HPP
@@ -111,6 +111,9 @@ public:
 	template <typename T>
 	T							as						(int ndx) const			{ DE_ASSERT(de::inBounds(ndx, 0, Stride)); return this->m_value[ndx].template as<T>();	}
 
+	// Raw access to all Stride values of the first scalar, used by packet kernels
+	const Scalar*				getValuePtr				(void) const			{ return m_value;											}
+
 	// For assignment: b = a.value()
 	StridedValueRead<Stride>	value					(void) const			{ return StridedValueRead<Stride>(getType(), m_value);		}
 
@@ -144,6 +147,8 @@ public:
 	template <typename T>
 	T&							as					(int ndx)			{ DE_ASSERT(de::inBounds(ndx, 0, Stride)); return this->m_value[ndx].template as<T>();		}
 
+	Scalar*						getValuePtr			(void)				{ return this->m_value;																	}
+
 	template <int SrcStride>
 	StridedValueAccess&			operator=			(const StridedValueRead<SrcStride>& value);
 
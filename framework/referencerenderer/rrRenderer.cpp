@@ -25,6 +25,7 @@
 #include "tcuVectorUtil.hpp"
 #include "tcuTextureUtil.hpp"
 #include "tcuFloat.hpp"
+#include "tcuScopedTimer.hpp"
 #include "rrPrimitiveAssembler.hpp"
 #include "rrFragmentOperations.hpp"
 #include "rrRasterizer.hpp"
@@ -1746,6 +1747,8 @@ void Renderer::draw (const DrawCommand& command) const
 
 void Renderer::drawInstanced (const DrawCommand& command, int numInstances) const
 {
+	const tcu::ScopedTimer timer ("rr::Renderer::draw");
+
 	// Do not run bad commands
 	{
 		const bool validCommand = isValidCommand(command, numInstances);
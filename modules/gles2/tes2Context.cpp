@@ -27,6 +27,7 @@
 #include "gluRenderConfig.hpp"
 #include "gluFboRenderContext.hpp"
 #include "gluContextInfo.hpp"
+#include "gluProgramBinaryCache.hpp"
 #include "tcuCommandLine.hpp"
 #include "glwWrapper.hpp"
 
@@ -38,22 +39,31 @@ namespace gles2
 {
 
 Context::Context (tcu::TestContext& testCtx)
-	: m_testCtx		(testCtx)
-	, m_renderCtx	(DE_NULL)
-	, m_contextInfo	(DE_NULL)
+	: m_testCtx				(testCtx)
+	, m_renderCtx			(DE_NULL)
+	, m_contextInfo			(DE_NULL)
+	, m_programBinaryCache	(DE_NULL)
 {
 	try
 	{
 		m_renderCtx		= glu::createDefaultRenderContext(m_testCtx.getPlatform(), m_testCtx.getCommandLine(), glu::ApiType::es(2,0));
 		m_contextInfo	= glu::ContextInfo::create(*m_renderCtx);
 
+		if (m_testCtx.getCommandLine().isGLProgramBinaryCacheEnabled())
+		{
+			m_programBinaryCache = new glu::ProgramBinaryCache(*m_renderCtx, *m_contextInfo, m_testCtx.getCommandLine().getGLProgramBinaryCacheFilename());
+			glu::setCurrentThreadProgramBinaryCache(m_programBinaryCache);
+		}
+
 		// Set up function table for transparent wrapper.
 		glw::setCurrentThreadFunctions(&m_renderCtx->getFunctions());
 	}
 	catch (...)
 	{
 		glw::setCurrentThreadFunctions(DE_NULL);
+		glu::setCurrentThreadProgramBinaryCache(DE_NULL);
 
+		delete m_programBinaryCache;
 		delete m_contextInfo;
 		delete m_renderCtx;
 
@@ -65,7 +75,9 @@ Context::~Context (void)
 {
 	// Remove functions from wrapper.
 	glw::setCurrentThreadFunctions(DE_NULL);
+	glu::setCurrentThreadProgramBinaryCache(DE_NULL);
 
+	delete m_programBinaryCache;
 	delete m_contextInfo;
 	delete m_renderCtx;
 }
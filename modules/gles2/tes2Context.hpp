@@ -30,6 +30,7 @@ namespace glu
 {
 class RenderContext;
 class ContextInfo;
+class ProgramBinaryCache;
 }
 
 namespace tcu
@@ -53,10 +54,14 @@ public:
 	const glu::ContextInfo&			getContextInfo			(void)			{ return *m_contextInfo;	}
 	const tcu::RenderTarget&		getRenderTarget			(void) const;
 
+	//! Program binary cache, or DE_NULL if not enabled (--deqp-gl-program-binary-cache)
+	glu::ProgramBinaryCache*		getProgramBinaryCache	(void)			{ return m_programBinaryCache;	}
+
 private:
 	tcu::TestContext&				m_testCtx;
 	glu::RenderContext*				m_renderCtx;
 	glu::ContextInfo*				m_contextInfo;
+	glu::ProgramBinaryCache*		m_programBinaryCache;
 };
 
 } // gles2
@@ -30,6 +30,7 @@
 #include "es2sStressTests.hpp"
 #include "tcuTestLog.hpp"
 #include "gluRenderContext.hpp"
+#include "gluProgramBinaryCache.hpp"
 #include "gluStateReset.hpp"
 #include "glwFunctions.hpp"
 #include "glwEnums.hpp"
@@ -50,7 +51,8 @@ public:
 	tcu::TestNode::IterateResult	iterate				(tcu::TestCase* testCase);
 
 private:
-	TestPackage&					m_testPackage;
+	TestPackage&						m_testPackage;
+	glu::ProgramBinaryCache::Statistics	m_programBinaryCacheStats;
 };
 
 TestCaseWrapper::TestCaseWrapper (TestPackage& package)
@@ -64,6 +66,9 @@ TestCaseWrapper::~TestCaseWrapper (void)
 
 void TestCaseWrapper::init (tcu::TestCase* testCase, const std::string&)
 {
+	if (const glu::ProgramBinaryCache* cache = m_testPackage.getContext()->getProgramBinaryCache())
+		m_programBinaryCacheStats = cache->getStatistics();
+
 	testCase->init();
 }
 
@@ -72,6 +77,10 @@ void TestCaseWrapper::deinit (tcu::TestCase* testCase)
 	testCase->deinit();
 
 	DE_ASSERT(m_testPackage.getContext());
+
+	if (const glu::ProgramBinaryCache* cache = m_testPackage.getContext()->getProgramBinaryCache())
+		cache->logStatistics(m_testPackage.getContext()->getTestContext().getLog(), m_programBinaryCacheStats);
+
 	glu::resetState(m_testPackage.getContext()->getRenderContext(), m_testPackage.getContext()->getContextInfo());
 }
 
@@ -26,11 +26,13 @@
 #include "tcuTestLog.hpp"
 #include "tcuImageCompare.hpp"
 #include "tcuRenderTarget.hpp"
+#include "tcuWorkerPool.hpp"
 #include "sglrGLContext.hpp"
 #include "sglrReferenceContext.hpp"
 #include "gluStrUtil.hpp"
 #include "gluContextInfo.hpp"
 #include "deRandom.hpp"
+#include "deThread.hpp"
 #include "glwEnums.hpp"
 #include "glwFunctions.hpp"
 
@@ -57,6 +59,52 @@ FboTestCase::~FboTestCase (void)
 {
 }
 
+class FboTestCase::ReferenceRenderThread : public de::Thread
+{
+public:
+	ReferenceRenderThread (FboTestCase& testCase, const sglr::ReferenceContextLimits& limits, int width, int height, tcu::Surface& dst)
+		: m_testCase	(testCase)
+		, m_limits		(limits)
+		, m_width		(width)
+		, m_height		(height)
+		, m_dst			(dst)
+	{
+	}
+
+	~ReferenceRenderThread (void)
+	{
+		if (isStarted())
+			join();
+	}
+
+	void run (void)
+	{
+		try
+		{
+			m_testCase.renderReference(m_limits, m_width, m_height, m_dst);
+		}
+		catch (...)
+		{
+			m_error.capture();
+		}
+	}
+
+	//! Re-throw error from reference rendering in the calling thread with the original type. Thread must have been joined.
+	void checkError (void) const
+	{
+		m_error.rethrow();
+	}
+
+private:
+	FboTestCase&						m_testCase;
+	const sglr::ReferenceContextLimits&	m_limits;
+	const int							m_width;
+	const int							m_height;
+	tcu::Surface&						m_dst;
+
+	tcu::CapturedException				m_error;
+};
+
 FboTestCase::IterateResult FboTestCase::iterate (void)
 {
 	glu::RenderContext&			renderCtx		= TestCase::m_context.getRenderContext();
@@ -77,6 +125,13 @@ FboTestCase::IterateResult FboTestCase::iterate (void)
 	// Call preCheck() that can throw exception if some requirement is not met.
 	preCheck();
 
+	// Reference is rendered on a separate thread while GL rendering is in progress.
+	const sglr::ReferenceContextLimits	refLimits	(renderCtx);
+	ReferenceRenderThread				refThread	(*this, refLimits, width, height, reference);
+
+	log << TestLog::Message << "Rendering reference image" << TestLog::EndMessage;
+	refThread.start();
+
 	log << TestLog::Message << "Rendering with GL driver" << TestLog::EndMessage;
 
 	// Render using GLES3.1
@@ -105,17 +160,9 @@ FboTestCase::IterateResult FboTestCase::iterate (void)
 			throw;
 	}
 
-	log << TestLog::Message << "Rendering reference image" << TestLog::EndMessage;
-
-	// Render reference.
-	{
-		sglr::ReferenceContextBuffers	buffers	(tcu::PixelFormat(8,8,8,renderTarget.getPixelFormat().alphaBits?8:0), renderTarget.getDepthBits(), renderTarget.getStencilBits(), width, height);
-		sglr::ReferenceContext			context	(sglr::ReferenceContextLimits(renderCtx), buffers.getColorbuffer(), buffers.getDepthbuffer(), buffers.getStencilbuffer());
-
-		setContext(&context);
-		render(reference);
-		setContext(DE_NULL);
-	}
+	// Wait for reference.
+	refThread.join();
+	refThread.checkError();
 
 	bool isOk = compare(reference, result);
 	m_testCtx.setTestResult(isOk ? QP_TEST_RESULT_PASS	: QP_TEST_RESULT_FAIL,
@@ -123,6 +170,16 @@ FboTestCase::IterateResult FboTestCase::iterate (void)
 	return STOP;
 }
 
+void FboTestCase::renderReference (const sglr::ReferenceContextLimits& limits, int width, int height, tcu::Surface& dst)
+{
+	const tcu::RenderTarget&		renderTarget	= TestCase::m_context.getRenderTarget();
+	sglr::ReferenceContextBuffers	buffers			(tcu::PixelFormat(8,8,8,renderTarget.getPixelFormat().alphaBits?8:0), renderTarget.getDepthBits(), renderTarget.getStencilBits(), width, height);
+	sglr::ReferenceContext			context			(limits, buffers.getColorbuffer(), buffers.getDepthbuffer(), buffers.getStencilbuffer());
+	const ScopedThreadContext		threadContext	(*this, &context);
+
+	render(dst);
+}
+
 bool FboTestCase::compare (const tcu::Surface& reference, const tcu::Surface& result)
 {
 	return tcu::fuzzyCompare(m_testCtx.getLog(), "Result", "Image comparison result", reference, result, 0.05f, tcu::COMPARE_LOG_RESULT);
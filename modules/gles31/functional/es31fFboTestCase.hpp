@@ -33,6 +33,11 @@ class Surface;
 class TextureFormat;
 }
 
+namespace sglr
+{
+class ReferenceContextLimits;
+}
+
 namespace deqp
 {
 namespace gles31
@@ -68,6 +73,10 @@ protected:
 private:
 						FboTestCase				(const FboTestCase& other);
 	FboTestCase&		operator=				(const FboTestCase& other);
+
+	class ReferenceRenderThread;
+
+	void				renderReference			(const sglr::ReferenceContextLimits& limits, int width, int height, tcu::Surface& dst);
 };
 
 } // Functional
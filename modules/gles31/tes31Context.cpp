@@ -26,6 +26,7 @@
 #include "gluRenderConfig.hpp"
 #include "gluFboRenderContext.hpp"
 #include "gluContextInfo.hpp"
+#include "gluProgramBinaryCache.hpp"
 #include "gluDummyRenderContext.hpp"
 #include "tcuCommandLine.hpp"
 
@@ -35,9 +36,10 @@ namespace gles31
 {
 
 Context::Context (tcu::TestContext& testCtx)
-	: m_testCtx		(testCtx)
-	, m_renderCtx	(DE_NULL)
-	, m_contextInfo	(DE_NULL)
+	: m_testCtx				(testCtx)
+	, m_renderCtx			(DE_NULL)
+	, m_contextInfo			(DE_NULL)
+	, m_programBinaryCache	(DE_NULL)
 {
 	if (m_testCtx.getCommandLine().getRunMode() == tcu::RUNMODE_EXECUTE)
 		createRenderContext();
@@ -57,7 +59,7 @@ Context::~Context (void)
 
 void Context::createRenderContext (void)
 {
-	DE_ASSERT(!m_renderCtx && !m_contextInfo);
+	DE_ASSERT(!m_renderCtx && !m_contextInfo && !m_programBinaryCache);
 
 	try
 	{
@@ -70,6 +72,12 @@ void Context::createRenderContext (void)
 			m_renderCtx		= glu::createDefaultRenderContext(m_testCtx.getPlatform(), m_testCtx.getCommandLine(), glu::ApiType::es(3, 1));
 		}
 		m_contextInfo	= glu::ContextInfo::create(*m_renderCtx);
+
+		if (m_testCtx.getCommandLine().isGLProgramBinaryCacheEnabled())
+		{
+			m_programBinaryCache = new glu::ProgramBinaryCache(*m_renderCtx, *m_contextInfo, m_testCtx.getCommandLine().getGLProgramBinaryCacheFilename());
+			glu::setCurrentThreadProgramBinaryCache(m_programBinaryCache);
+		}
 	}
 	catch (...)
 	{
@@ -80,11 +88,16 @@ void Context::createRenderContext (void)
 
 void Context::destroyRenderContext (void)
 {
+	if (m_programBinaryCache)
+		glu::setCurrentThreadProgramBinaryCache(DE_NULL);
+
+	delete m_programBinaryCache;
 	delete m_contextInfo;
 	delete m_renderCtx;
 
-	m_contextInfo	= DE_NULL;
-	m_renderCtx		= DE_NULL;
+	m_programBinaryCache	= DE_NULL;
+	m_contextInfo			= DE_NULL;
+	m_renderCtx				= DE_NULL;
 }
 
 const tcu::RenderTarget& Context::getRenderTarget (void) const
@@ -27,6 +27,7 @@
 #include "es31sStressTests.hpp"
 #include "gluStateReset.hpp"
 #include "gluRenderContext.hpp"
+#include "gluProgramBinaryCache.hpp"
 #include "tcuTestLog.hpp"
 
 namespace deqp
@@ -45,7 +46,8 @@ public:
 	tcu::TestNode::IterateResult	iterate				(tcu::TestCase* testCase);
 
 private:
-	TestPackage&					m_testPackage;
+	TestPackage&						m_testPackage;
+	glu::ProgramBinaryCache::Statistics	m_programBinaryCacheStats;
 };
 
 TestCaseWrapper::TestCaseWrapper (TestPackage& package)
@@ -59,6 +61,9 @@ TestCaseWrapper::~TestCaseWrapper (void)
 
 void TestCaseWrapper::init (tcu::TestCase* testCase, const std::string&)
 {
+	if (const glu::ProgramBinaryCache* cache = m_testPackage.getContext()->getProgramBinaryCache())
+		m_programBinaryCacheStats = cache->getStatistics();
+
 	testCase->init();
 }
 
@@ -67,6 +72,10 @@ void TestCaseWrapper::deinit (tcu::TestCase* testCase)
 	testCase->deinit();
 
 	DE_ASSERT(m_testPackage.getContext());
+
+	if (const glu::ProgramBinaryCache* cache = m_testPackage.getContext()->getProgramBinaryCache())
+		cache->logStatistics(m_testPackage.getContext()->getTestContext().getLog(), m_programBinaryCacheStats);
+
 	glu::resetState(m_testPackage.getContext()->getRenderContext(), m_testPackage.getContext()->getContextInfo());
 }
 
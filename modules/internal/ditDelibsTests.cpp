@@ -23,8 +23,10 @@
 
 #include "ditDelibsTests.hpp"
 #include "tcuTestLog.hpp"
+#include "tcuMemPoolUtil.hpp"
 
 // depool
+#include "deMemPool.h"
 #include "dePoolArray.h"
 #include "dePoolHeap.h"
 #include "dePoolHash.h"
@@ -51,6 +53,7 @@
 // decpp
 #include "deBlockBuffer.hpp"
 #include "deFilePath.hpp"
+#include "deMemPool.hpp"
 #include "dePoolArray.hpp"
 #include "deRingBuffer.hpp"
 #include "deSharedPtr.hpp"
@@ -69,6 +72,60 @@ namespace dit
 
 using tcu::TestLog;
 
+class MemPoolStatsCase : public tcu::TestCase
+{
+public:
+	MemPoolStatsCase (tcu::TestContext& testCtx, const char* name, const char* description, const deMemPoolPageConfig& config)
+		: tcu::TestCase	(testCtx, name, description)
+		, m_config		(config)
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		const int		numIterations	= 8;
+		const int		numElements		= 20000;
+		de::MemPool		pool			(m_config);
+		TestLog&		log				= m_testCtx.getLog();
+
+		log << TestLog::Message << "Initial page size " << m_config.initialPageSize << ", maximum page size " << m_config.maxPageSize << TestLog::EndMessage;
+
+		// Simulate a per-case workload that is thrown away with reset() after each case.
+		for (int iterNdx = 0; iterNdx < numIterations; iterNdx++)
+		{
+			if (iterNdx > 0)
+				pool.reset();
+
+			{
+				de::PoolArray<deUint32> values(&pool);
+
+				for (int elemNdx = 0; elemNdx < numElements; elemNdx++)
+				{
+					values.pushBack((deUint32)elemNdx);
+					pool.alloc(1 + (elemNdx % 13));
+				}
+
+				for (int elemNdx = 0; elemNdx < numElements; elemNdx++)
+				{
+					if (values[elemNdx] != (deUint32)elemNdx)
+					{
+						m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Invalid value in pool array");
+						return STOP;
+					}
+				}
+			}
+		}
+
+		tcu::logMemPoolStats(log, "MemPool", "Pool statistics", pool.getStats(true));
+
+		m_testCtx.setTestResult(QP_TEST_RESULT_PASS, "Pass");
+		return STOP;
+	}
+
+private:
+	const deMemPoolPageConfig	m_config;
+};
+
 class DepoolTests : public tcu::TestCaseGroup
 {
 public:
@@ -79,6 +136,7 @@ public:
 
 	void init (void)
 	{
+		addChild(new SelfCheckCase(m_testCtx, "mem_pool",	"deMemPool_selfTest()",			deMemPool_selfTest));
 		addChild(new SelfCheckCase(m_testCtx, "array",		"dePoolArray_selfTest()",		dePoolArray_selfTest));
 		addChild(new SelfCheckCase(m_testCtx, "heap",		"dePoolHeap_selfTest()",		dePoolHeap_selfTest));
 		addChild(new SelfCheckCase(m_testCtx, "hash",		"dePoolHash_selfTest()",		dePoolHash_selfTest));
@@ -86,6 +144,14 @@ public:
 		addChild(new SelfCheckCase(m_testCtx, "hash_set",	"dePoolHashSet_selfTest()",		dePoolHashSet_selfTest));
 		addChild(new SelfCheckCase(m_testCtx, "hash_array",	"dePoolHashArray_selfTest()",	dePoolHashArray_selfTest));
 		addChild(new SelfCheckCase(m_testCtx, "multi_set",	"dePoolMultiSet_selfTest()",	dePoolMultiSet_selfTest));
+
+		{
+			const deMemPoolPageConfig	defaultPages	= { DE_MEMPOOL_DEFAULT_INITIAL_PAGE_SIZE, DE_MEMPOOL_DEFAULT_MAX_PAGE_SIZE };
+			const deMemPoolPageConfig	largePages		= { DE_MEMPOOL_DEFAULT_INITIAL_PAGE_SIZE, DE_MEMPOOL_LARGE_MAX_PAGE_SIZE };
+
+			addChild(new MemPoolStatsCase(m_testCtx, "reset_default_pages",	"Pool reuse with default page sizes",	defaultPages));
+			addChild(new MemPoolStatsCase(m_testCtx, "reset_large_pages",		"Pool reuse with large pages",			largePages));
+		}
 	}
 };
 
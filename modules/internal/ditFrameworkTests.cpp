@@ -30,16 +30,42 @@
 #include "tcuEither.hpp"
 #include "tcuTestLog.hpp"
 #include "tcuCommandLine.hpp"
+#include "tcuTestPackage.hpp"
+#include "tcuTestHierarchyIterator.hpp"
+#include "tcuCaseIndex.hpp"
+#include "tcuTexLookupVerifier.hpp"
+#include "tcuStringTemplate.hpp"
 
 #include "rrRenderer.hpp"
+#include "sglrReferenceContext.hpp"
+#include "sglrShaderProgram.hpp"
+#include "sglrContextWrapper.hpp"
+#include "glwEnums.hpp"
+#include "glwFunctions.hpp"
+#include "gluRenderContext.hpp"
+#include "gluContextInfo.hpp"
+#include "gluShaderProgram.hpp"
+#include "gluProgramBinaryCache.hpp"
+#include "gluTextureTestUtil.hpp"
+#include "tcuRenderTarget.hpp"
+#include "tcuSurfaceAccess.hpp"
+#include "tcuWorkerPool.hpp"
+#include "tcuSurface.hpp"
+#include "tcuImageCompare.hpp"
 #include "tcuTextureUtil.hpp"
 #include "tcuVectorUtil.hpp"
 #include "tcuFloat.hpp"
 
 #include "deRandom.hpp"
 #include "deArrayUtil.hpp"
+#include "deFile.h"
+#include "deStringUtil.hpp"
+#include "deSemaphore.hpp"
+#include "deThread.hpp"
 
+#include <algorithm>
 #include <stdexcept>
+#include <new>
 
 namespace dit
 {
@@ -571,6 +597,1124 @@ public:
 	}
 };
 
+class LazyChildCase : public tcu::TestCase
+{
+public:
+	LazyChildCase (tcu::TestContext& testCtx, const char* name, const char* caseList, const char* expectedCases, int expectedNumCreated)
+		: tcu::TestCase			(testCtx, name, "")
+		, m_caseList			(caseList)
+		, m_expectedCases		(expectedCases)
+		, m_expectedNumCreated	(expectedNumCreated)
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		TestLog&							log			= m_testCtx.getLog();
+		tcu::CommandLine					cmdLine;
+		de::MovePtr<tcu::CaseListFilter>	caseListFilter;
+		string								visitedCases;
+
+		log << TestLog::Message << "Input:\n\"" << m_caseList << "\"" << TestLog::EndMessage;
+
+		{
+			const char* argv[] =
+			{
+				"deqp",
+				"--deqp-caselist",
+				m_caseList
+			};
+
+			if (!cmdLine.parse(DE_LENGTH_OF_ARRAY(argv), argv))
+				TCU_FAIL("Failed to parse command line");
+		}
+
+		caseListFilter	= cmdLine.createCaseListFilter(m_testCtx.getArchive());
+		s_numCreated	= 0;
+
+		{
+			tcu::TestPackageRoot			root		(m_testCtx, vector<tcu::TestNode*>(1, new RootGroup(m_testCtx)));
+			tcu::DefaultHierarchyInflater	inflater	(m_testCtx);
+			tcu::TestHierarchyIterator		iter		(root, inflater, *caseListFilter);
+
+			while (iter.getState() != tcu::TestHierarchyIterator::STATE_FINISHED)
+			{
+				if (iter.getState() == tcu::TestHierarchyIterator::STATE_ENTER_NODE &&
+					tcu::isTestNodeTypeExecutable(iter.getNode()->getNodeType()))
+					visitedCases += (visitedCases.empty() ? "" : ",") + iter.getNodePath();
+
+				iter.next();
+			}
+		}
+
+		log << TestLog::Message << "Visited cases: " << visitedCases << "\n"
+								<< "Created lazy groups: " << s_numCreated
+			<< TestLog::EndMessage;
+
+		if (visitedCases != m_expectedCases)
+			m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Wrong cases visited");
+		else if (s_numCreated != m_expectedNumCreated)
+			m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Unexpected number of lazy groups created");
+		else
+			m_testCtx.setTestResult(QP_TEST_RESULT_PASS, "Pass");
+
+		return STOP;
+	}
+
+private:
+	class DummyCase : public tcu::TestCase
+	{
+	public:
+		DummyCase (tcu::TestContext& testCtx, const char* name) : tcu::TestCase(testCtx, name, "") {}
+		IterateResult iterate (void) { return STOP; }
+	};
+
+	static tcu::TestCaseGroup* createGroup (tcu::TestContext& testCtx, const char* name)
+	{
+		tcu::TestCaseGroup* const group = new tcu::TestCaseGroup(testCtx, name, "");
+
+		group->addChild(new DummyCase(testCtx, "a"));
+		group->addChild(new DummyCase(testCtx, "b"));
+
+		return group;
+	}
+
+	static tcu::TestCaseGroup* createLazyGroupX (tcu::TestContext& testCtx) { s_numCreated += 1; return createGroup(testCtx, "x"); }
+	static tcu::TestCaseGroup* createLazyGroupY (tcu::TestContext& testCtx) { s_numCreated += 1; return createGroup(testCtx, "y"); }
+
+	class RootGroup : public tcu::TestCaseGroup
+	{
+	public:
+		RootGroup (tcu::TestContext& testCtx) : tcu::TestCaseGroup(testCtx, "root", "") {}
+
+		void init (void)
+		{
+			addLazyChild("x", createLazyGroupX);
+			addChild(createGroup(m_testCtx, "eager"));
+			addLazyChild("y", createLazyGroupY);
+		}
+	};
+
+	static int			s_numCreated;
+
+	const char* const	m_caseList;
+	const char* const	m_expectedCases;
+	const int			m_expectedNumCreated;
+};
+
+int LazyChildCase::s_numCreated = 0;
+
+class LazyChildTests : public tcu::TestCaseGroup
+{
+public:
+	LazyChildTests (tcu::TestContext& testCtx)
+		: tcu::TestCaseGroup(testCtx, "lazy_child", "Lazy child creation tests")
+	{
+	}
+
+	void init (void)
+	{
+		addChild(new LazyChildCase(m_testCtx, "all",			"{root{x{a,b},eager{a,b},y{a,b}}}",	"root.x.a,root.x.b,root.eager.a,root.eager.b,root.y.a,root.y.b",	2));
+		addChild(new LazyChildCase(m_testCtx, "single_lazy",	"{root{y{b}}}",							"root.y.b",															1));
+		addChild(new LazyChildCase(m_testCtx, "single_eager",	"{root{eager{a}}}",						"root.eager.a",														0));
+	}
+};
+
+//! Index of {root{x{a,b},c,y{z{a}}}} with tags.
+static void buildTestCaseIndex (vector<deUint8>& dst)
+{
+	tcu::CaseIndexBuilder builder;
+
+	builder.enterNode("root", tcu::NODETYPE_PACKAGE);
+	builder.enterNode("x", tcu::NODETYPE_GROUP);
+	builder.enterNode("a", tcu::NODETYPE_SELF_VALIDATE);	builder.addTag("fast");											builder.leaveNode();
+	builder.enterNode("b", tcu::NODETYPE_PERFORMANCE);		builder.addTag("slow");		builder.addTag("last-Pass");		builder.leaveNode();
+	builder.leaveNode();
+	builder.enterNode("c", tcu::NODETYPE_ACCURACY);			builder.addTag("last-NotSupported");							builder.leaveNode();
+	builder.enterNode("y", tcu::NODETYPE_GROUP);
+	builder.enterNode("z", tcu::NODETYPE_GROUP);
+	builder.enterNode("a", tcu::NODETYPE_CAPABILITY);		builder.addTag("fast");		builder.addTag("last-Pass");		builder.leaveNode();
+	builder.leaveNode();
+	builder.leaveNode();
+	builder.leaveNode();
+	builder.serialize(dst);
+}
+
+class CaseIndexCase : public tcu::TestCase
+{
+public:
+	CaseIndexCase (tcu::TestContext& testCtx, const char* name, const char* caseList, const char* expectedNodes)
+		: tcu::TestCase		(testCtx, name, "")
+		, m_caseList		(caseList)
+		, m_expectedNodes	(expectedNodes)
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		TestLog&							log			= m_testCtx.getLog();
+		tcu::CommandLine					cmdLine;
+		de::MovePtr<tcu::CaseListFilter>	caseListFilter;
+		vector<deUint8>						data;
+		vector<tcu::CaseIndexEntry>			nodes;
+		string								visitedNodes;
+
+		log << TestLog::Message << "Input:\n\"" << m_caseList << "\"" << TestLog::EndMessage;
+
+		{
+			const char* argv[] =
+			{
+				"deqp",
+				"--deqp-caselist",
+				m_caseList
+			};
+
+			if (!cmdLine.parse(DE_LENGTH_OF_ARRAY(argv), argv))
+				TCU_FAIL("Failed to parse command line");
+		}
+
+		caseListFilter = cmdLine.createCaseListFilter(m_testCtx.getArchive());
+
+		buildTestCaseIndex(data);
+
+		{
+			const tcu::CaseIndex	index	(data);
+			tcu::CaseIndexEntry		entry;
+
+			index.getMatchingNodes(*caseListFilter, nodes);
+
+			for (vector<tcu::CaseIndexEntry>::const_iterator node = nodes.begin(); node != nodes.end(); ++node)
+				visitedNodes += (visitedNodes.empty() ? "" : ",") + node->path;
+
+			log << TestLog::Message << "Index size: " << data.size() << " bytes\n"
+									<< "Matching nodes: " << visitedNodes
+				<< TestLog::EndMessage;
+
+			if (index.getNumCases() != 4 || !index.findCase("root.y.z.a", &entry) || entry.nodeType != tcu::NODETYPE_CAPABILITY || index.findCase("root.y.z", DE_NULL))
+				m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Index lookup failed");
+			else if (entry.tags.size() != 2 || !entry.hasTag("fast") || !entry.hasTag("last-Pass"))
+				m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Wrong case tags");
+			else if (visitedNodes != m_expectedNodes)
+				m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Wrong nodes matched");
+			else
+				m_testCtx.setTestResult(QP_TEST_RESULT_PASS, "Pass");
+		}
+
+		return STOP;
+	}
+
+private:
+	const char* const	m_caseList;
+	const char* const	m_expectedNodes;
+};
+
+//! Case list filter selecting cases with --deqp-case-index and --deqp-case-tags.
+class CaseIndexFilterCase : public tcu::TestCase
+{
+public:
+	CaseIndexFilterCase (tcu::TestContext& testCtx, const char* name, const char* caseList, const char* tags, const char* expectedNodes)
+		: tcu::TestCase		(testCtx, name, "")
+		, m_caseList		(caseList)
+		, m_tags			(tags)
+		, m_expectedNodes	(expectedNodes)
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		const char* const	filename	= "dit-case-index.idx";
+
+		deDeleteFile(filename);
+
+		try
+		{
+			run(filename);
+		}
+		catch (...)
+		{
+			deDeleteFile(filename);
+			throw;
+		}
+
+		deDeleteFile(filename);
+		return STOP;
+	}
+
+private:
+	void run (const char* filename)
+	{
+		TestLog&							log				= m_testCtx.getLog();
+		const string						indexArg		= string("--deqp-case-index=") + filename;
+		const string						tagsArg			= string("--deqp-case-tags=") + (m_tags ? m_tags : "");
+		vector<const char*>					argv;
+		tcu::CommandLine					cmdLine;
+		de::MovePtr<tcu::CaseListFilter>	caseListFilter;
+		vector<deUint8>						data;
+		vector<tcu::CaseIndexEntry>			allNodes;
+		string								visitedNodes;
+
+		buildTestCaseIndex(data);
+
+		{
+			deFile* const file = deFile_create(filename, DE_FILEMODE_CREATE|DE_FILEMODE_OPEN|DE_FILEMODE_WRITE|DE_FILEMODE_TRUNCATE);
+
+			TCU_CHECK_MSG(file, "Failed to create index file");
+			TCU_CHECK(deFile_write(file, &data[0], (deInt64)data.size(), DE_NULL) == DE_FILERESULT_SUCCESS);
+			deFile_destroy(file);
+		}
+
+		argv.push_back("deqp");
+		argv.push_back(indexArg.c_str());
+
+		if (m_caseList)
+		{
+			argv.push_back("--deqp-caselist");
+			argv.push_back(m_caseList);
+		}
+
+		if (m_tags)
+			argv.push_back(tagsArg.c_str());
+
+		if (!cmdLine.parse((int)argv.size(), &argv[0]))
+			TCU_FAIL("Failed to parse command line");
+
+		caseListFilter = cmdLine.createCaseListFilter(m_testCtx.getArchive());
+
+		// Walk full hierarchy and record what filter lets TestHierarchyIterator enter.
+		{
+			const tcu::CaseIndex	index		(data);
+			tcu::CaseListFilter		noFilter;
+
+			allNodes.clear();
+			index.getMatchingNodes(noFilter, allNodes);
+		}
+
+		for (vector<tcu::CaseIndexEntry>::const_iterator node = allNodes.begin(); node != allNodes.end(); ++node)
+		{
+			const bool isCase = tcu::isTestNodeTypeExecutable(node->nodeType);
+
+			if (isCase ? caseListFilter->checkTestCaseName(node->path.c_str()) : caseListFilter->checkTestGroupName(node->path.c_str()))
+				visitedNodes += (visitedNodes.empty() ? "" : ",") + node->path;
+		}
+
+		log << TestLog::Message << "Case list: " << (m_caseList ? m_caseList : "(none)") << "\n"
+								<< "Tags: " << (m_tags ? m_tags : "(none)") << "\n"
+								<< "Selected nodes: " << visitedNodes
+			<< TestLog::EndMessage;
+
+		m_testCtx.setTestResult(visitedNodes == m_expectedNodes ? QP_TEST_RESULT_PASS	: QP_TEST_RESULT_FAIL,
+								visitedNodes == m_expectedNodes ? "Pass"				: "Wrong nodes selected");
+	}
+
+	const char* const	m_caseList;
+	const char* const	m_tags;
+	const char* const	m_expectedNodes;
+};
+
+class CaseIndexTests : public tcu::TestCaseGroup
+{
+public:
+	CaseIndexTests (tcu::TestContext& testCtx)
+		: tcu::TestCaseGroup(testCtx, "case_index", "Test case index tests")
+	{
+	}
+
+	void init (void)
+	{
+		addChild(new CaseIndexCase(m_testCtx, "all",			"{root{x{a,b},c,y{z{a}}}}",	"root.x,root.x.a,root.x.b,root.c,root.y,root.y.z,root.y.z.a"));
+		addChild(new CaseIndexCase(m_testCtx, "single_group",	"{root{x{b}}}",				"root.x,root.x.b"));
+		addChild(new CaseIndexCase(m_testCtx, "nested",			"{root{c,y{z{a}}}}",		"root.c,root.y,root.y.z,root.y.z.a"));
+
+		addChild(new CaseIndexFilterCase(m_testCtx, "filter_all",			DE_NULL,				DE_NULL,					"root.x,root.x.a,root.x.b,root.c,root.y,root.y.z,root.y.z.a"));
+		addChild(new CaseIndexFilterCase(m_testCtx, "filter_tag",			DE_NULL,				"fast",						"root.x,root.x.a,root.y,root.y.z,root.y.z.a"));
+		addChild(new CaseIndexFilterCase(m_testCtx, "filter_tags",			DE_NULL,				"fast,last-Pass",			"root.y,root.y.z,root.y.z.a"));
+		addChild(new CaseIndexFilterCase(m_testCtx, "filter_exclude_tag",	DE_NULL,				"!last-NotSupported,!slow",	"root.x,root.x.a,root.y,root.y.z,root.y.z.a"));
+		addChild(new CaseIndexFilterCase(m_testCtx, "filter_case_list",		"{root{x{a,b},c}}",		"last-Pass",				"root.x,root.x.b"));
+		addChild(new CaseIndexFilterCase(m_testCtx, "filter_no_match",		DE_NULL,				"missing",					""));
+	}
+};
+
+class TexLookupMinMaxCase : public tcu::TestCase
+{
+public:
+	enum TextureType
+	{
+		TEXTURETYPE_1D = 0,
+		TEXTURETYPE_2D,
+		TEXTURETYPE_CUBE,
+		TEXTURETYPE_2D_ARRAY,
+		TEXTURETYPE_3D,
+
+		TEXTURETYPE_LAST
+	};
+
+	TexLookupMinMaxCase (tcu::TestContext& testCtx, const char* name, TextureType textureType)
+		: tcu::TestCase		(testCtx, name, "Compare min/max pyramid lookup verification to exhaustive search")
+		, m_textureType		(textureType)
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		static const tcu::Sampler::WrapMode		wrapModes[]		=
+		{
+			tcu::Sampler::CLAMP_TO_EDGE,
+			tcu::Sampler::CLAMP_TO_BORDER,
+			tcu::Sampler::REPEAT_GL,
+			tcu::Sampler::MIRRORED_REPEAT_GL
+		};
+		static const tcu::Sampler::FilterMode	minFilters[]	=
+		{
+			tcu::Sampler::NEAREST,
+			tcu::Sampler::LINEAR,
+			tcu::Sampler::NEAREST_MIPMAP_NEAREST,
+			tcu::Sampler::LINEAR_MIPMAP_NEAREST,
+			tcu::Sampler::NEAREST_MIPMAP_LINEAR,
+			tcu::Sampler::LINEAR_MIPMAP_LINEAR
+		};
+		static const tcu::TextureFormat			formats[]		=
+		{
+			tcu::TextureFormat(tcu::TextureFormat::sRGBA,	tcu::TextureFormat::UNORM_INT8),
+			tcu::TextureFormat(tcu::TextureFormat::RGBA,	tcu::TextureFormat::UNORM_INT8),
+			tcu::TextureFormat(tcu::TextureFormat::RGBA,	tcu::TextureFormat::SNORM_INT8),
+			tcu::TextureFormat(tcu::TextureFormat::RGBA,	tcu::TextureFormat::HALF_FLOAT),
+			tcu::TextureFormat(tcu::TextureFormat::RGBA,	tcu::TextureFormat::FLOAT)
+		};
+
+		TestLog&	log				= m_testCtx.getLog();
+		de::Random	rnd				(deStringHash(getName()));
+		const bool	isCube			= m_textureType == TEXTURETYPE_CUBE;
+		const int	numFaces		= isCube ? (int)tcu::CUBEFACE_LAST : 1;
+		const int	numTextures		= 20;
+		const int	numLookups		= 1000;
+		int			numValid		= 0;
+		int			numMismatches	= 0;
+		int			numQuick[tcu::QUICK_LOOKUP_LAST];
+
+		std::fill(DE_ARRAY_BEGIN(numQuick), DE_ARRAY_END(numQuick), 0);
+
+		for (int texNdx = 0; texNdx < numTextures; texNdx++)
+		{
+			const tcu::TextureFormat				format		= formats[texNdx % DE_LENGTH_OF_ARRAY(formats)];
+			const bool								isUnsigned	= tcu::getTextureChannelClass(format.type) == tcu::TEXTURECHANNELCLASS_UNSIGNED_FIXED_POINT;
+			const float								minValue	= isUnsigned ? 0.0f : -1.0f;
+			const int								width		= rnd.getInt(1, 40);
+			const tcu::IVec3						size		(width,
+																 m_textureType == TEXTURETYPE_1D ? 1 : isCube ? width : rnd.getInt(1, 40),
+																 m_textureType == TEXTURETYPE_2D_ARRAY || m_textureType == TEXTURETYPE_3D ? rnd.getInt(1, 6) : 1);
+			const int								numLevels	= deLog2Floor32(m_textureType == TEXTURETYPE_3D ? de::max(size.x(), de::max(size.y(), size.z())) : de::max(size.x(), size.y())) + 1;
+			vector<tcu::TextureLevel>				levels		(numLevels*numFaces);
+			vector<tcu::ConstPixelBufferAccess>		levelAccess	(numLevels*numFaces);
+			tcu::Sampler							sampler		(wrapModes[rnd.getInt(0, DE_LENGTH_OF_ARRAY(wrapModes)-1)],
+																 wrapModes[rnd.getInt(0, DE_LENGTH_OF_ARRAY(wrapModes)-1)],
+																 wrapModes[rnd.getInt(0, DE_LENGTH_OF_ARRAY(wrapModes)-1)],
+																 minFilters[rnd.getInt(0, DE_LENGTH_OF_ARRAY(minFilters)-1)],
+																 rnd.getBool() ? tcu::Sampler::LINEAR : tcu::Sampler::NEAREST);
+			tcu::LookupPrecision					prec;
+
+			sampler.borderColor		= tcu::Vec4(rnd.getFloat(minValue, 1.0f), 0.5f, 0.25f, 1.0f);
+			sampler.seamlessCubeMap	= rnd.getBool();
+			prec.coordBits			= tcu::IVec3(20);
+			prec.uvwBits			= tcu::IVec3(rnd.getInt(4, 8));
+			// Exhaustive search cost grows with value range / threshold, steeply so for trilinear 3D lookups.
+			prec.colorThreshold		= tcu::Vec4(rnd.getFloat(m_textureType == TEXTURETYPE_3D ? 0.02f : 0.005f, 0.05f) * (1.0f - minValue));
+			prec.colorMask			= tcu::BVec4(true, true, rnd.getBool(), true);
+
+			// Levels of each cube face are consecutive.
+			for (int faceNdx = 0; faceNdx < numFaces; faceNdx++)
+			for (int levelNdx = 0; levelNdx < numLevels; levelNdx++)
+			{
+				const int			ndx		= faceNdx*numLevels + levelNdx;
+				const int			depth	= m_textureType == TEXTURETYPE_2D_ARRAY ? size.z() : de::max(1, size.z() >> levelNdx);
+				const bool			isFlat	= rnd.getBool();
+				const tcu::Vec4		base	(rnd.getFloat(minValue, 1.0f), rnd.getFloat(minValue, 1.0f), rnd.getFloat(minValue, 1.0f), rnd.getFloat(minValue, 1.0f));
+
+				levels[ndx].setStorage(format, de::max(1, size.x() >> levelNdx), de::max(1, size.y() >> levelNdx), depth);
+
+				// Mix nearly constant levels, where results can be accepted quickly, with noise.
+				for (int z = 0; z < levels[ndx].getDepth(); z++)
+				for (int y = 0; y < levels[ndx].getHeight(); y++)
+				for (int x = 0; x < levels[ndx].getWidth(); x++)
+					levels[ndx].getAccess().setPixel(isFlat ? base + tcu::Vec4(rnd.getFloat(0.0f, 0.01f))
+															: tcu::Vec4(rnd.getFloat(minValue, 1.0f), rnd.getFloat(minValue, 1.0f), rnd.getFloat(minValue, 1.0f), rnd.getFloat(minValue, 1.0f)), x, y, z);
+
+				levelAccess[ndx] = levels[ndx].getAccess();
+			}
+
+			{
+				const tcu::ConstPixelBufferAccess*	faceLevels[tcu::CUBEFACE_LAST];
+
+				for (int faceNdx = 0; faceNdx < tcu::CUBEFACE_LAST; faceNdx++)
+					faceLevels[faceNdx] = &levelAccess[(isCube ? faceNdx : 0)*numLevels];
+
+				{
+					const tcu::Texture1DView			view1D		(numLevels, &levelAccess[0]);
+					const tcu::Texture2DView			view2D		(numLevels, &levelAccess[0]);
+					const tcu::TextureCubeView			viewCube	(numLevels, faceLevels);
+					const tcu::Texture2DArrayView		view2DArray	(numLevels, &levelAccess[0]);
+					const tcu::Texture3DView			view3D		(numLevels, &levelAccess[0]);
+					const tcu::TextureMinMaxPyramid		minMax		= m_textureType == TEXTURETYPE_1D		? tcu::TextureMinMaxPyramid(view1D)
+																	: m_textureType == TEXTURETYPE_2D		? tcu::TextureMinMaxPyramid(view2D)
+																	: m_textureType == TEXTURETYPE_CUBE		? tcu::TextureMinMaxPyramid(viewCube)
+																	: m_textureType == TEXTURETYPE_2D_ARRAY	? tcu::TextureMinMaxPyramid(view2DArray)
+																											: tcu::TextureMinMaxPyramid(view3D);
+
+					for (int lookupNdx = 0; lookupNdx < numLookups; lookupNdx++)
+					{
+						const tcu::Vec3				coord		= isCube ? tcu::Vec3(rnd.getFloat(-1.0f, 1.0f), rnd.getFloat(-1.0f, 1.0f), rnd.getFloat(-1.0f, 1.0f))
+																		 : tcu::Vec3(rnd.getFloat(-0.3f, 1.3f), rnd.getFloat(-0.3f, 1.3f), m_textureType == TEXTURETYPE_2D_ARRAY ? rnd.getFloat(-1.0f, float(size.z())) : rnd.getFloat(-0.3f, 1.3f));
+						const float					lod			= rnd.getFloat(-1.0f, float(numLevels));
+						const tcu::Vec2				lodBounds	(lod, lod + rnd.getFloat(0.0f, 0.5f));
+						const tcu::Vec4				noise		(rnd.getFloat(-0.06f, 0.06f), rnd.getFloat(-0.06f, 0.06f), rnd.getFloat(-0.06f, 0.06f), rnd.getFloat(-0.06f, 0.06f));
+						const bool					useSample	= rnd.getBool();
+						tcu::Vec4					result;
+						bool						isValid;
+						bool						isValidMinMax;
+						tcu::QuickLookupResult		quick;
+
+						switch (m_textureType)
+						{
+							case TEXTURETYPE_1D:
+								result			= useSample ? view1D.sample(sampler, coord.x(), lod) + noise : noise + tcu::Vec4(0.5f);
+								quick			= tcu::quickCheckLookupResult(view1D, minMax, sampler, prec, coord.x(), lodBounds, result);
+								isValid			= tcu::isLookupResultValid(view1D, sampler, prec, coord.x(), lodBounds, result);
+								isValidMinMax	= tcu::isLookupResultValid(view1D, minMax, sampler, prec, coord.x(), lodBounds, result);
+								break;
+
+							case TEXTURETYPE_2D:
+								result			= useSample ? view2D.sample(sampler, coord.x(), coord.y(), lod) + noise : noise + tcu::Vec4(0.5f);
+								quick			= tcu::quickCheckLookupResult(view2D, minMax, sampler, prec, coord.swizzle(0, 1), lodBounds, result);
+								isValid			= tcu::isLookupResultValid(view2D, sampler, prec, coord.swizzle(0, 1), lodBounds, result);
+								isValidMinMax	= tcu::isLookupResultValid(view2D, minMax, sampler, prec, coord.swizzle(0, 1), lodBounds, result);
+								break;
+
+							case TEXTURETYPE_CUBE:
+								result			= useSample ? viewCube.sample(sampler, coord.x(), coord.y(), coord.z(), lod) + noise : noise + tcu::Vec4(0.5f);
+								quick			= tcu::quickCheckLookupResult(viewCube, minMax, sampler, prec, coord, lodBounds, result);
+								isValid			= tcu::isLookupResultValid(viewCube, sampler, prec, coord, lodBounds, result);
+								isValidMinMax	= tcu::isLookupResultValid(viewCube, minMax, sampler, prec, coord, lodBounds, result);
+								break;
+
+							case TEXTURETYPE_2D_ARRAY:
+								result			= useSample ? view2DArray.sample(sampler, coord.x(), coord.y(), coord.z(), lod) + noise : noise + tcu::Vec4(0.5f);
+								quick			= tcu::quickCheckLookupResult(view2DArray, minMax, sampler, prec, coord, lodBounds, result);
+								isValid			= tcu::isLookupResultValid(view2DArray, sampler, prec, coord, lodBounds, result);
+								isValidMinMax	= tcu::isLookupResultValid(view2DArray, minMax, sampler, prec, coord, lodBounds, result);
+								break;
+
+							default:
+								DE_ASSERT(m_textureType == TEXTURETYPE_3D);
+								result			= useSample ? view3D.sample(sampler, coord.x(), coord.y(), coord.z(), lod) + noise : noise + tcu::Vec4(0.5f);
+								quick			= tcu::quickCheckLookupResult(view3D, minMax, sampler, prec, coord, lodBounds, result);
+								isValid			= tcu::isLookupResultValid(view3D, sampler, prec, coord, lodBounds, result);
+								isValidMinMax	= tcu::isLookupResultValid(view3D, minMax, sampler, prec, coord, lodBounds, result);
+								break;
+						}
+
+						numQuick[quick] += 1;
+
+						// Every early decision must agree with the exhaustive search.
+						if ((quick == tcu::QUICK_LOOKUP_ACCEPT && !isValid) || (quick == tcu::QUICK_LOOKUP_REJECT && isValid) || isValid != isValidMinMax)
+						{
+							if (numMismatches < 10)
+								log << TestLog::Message << "ERROR: Texture " << texNdx << " (" << format << "), lookup " << lookupNdx << ": exhaustive search gives " << (isValid ? "valid" : "invalid")
+														<< ", min/max pyramid gives " << (isValidMinMax ? "valid" : "invalid")
+														<< (quick == tcu::QUICK_LOOKUP_ACCEPT ? " (early accept)" : quick == tcu::QUICK_LOOKUP_REJECT ? " (early reject)" : "")
+									<< TestLog::EndMessage;
+
+							numMismatches += 1;
+						}
+
+						if (isValid)
+							numValid += 1;
+					}
+				}
+			}
+		}
+
+		log << TestLog::Message << numValid << " / " << numTextures*numLookups << " lookup results valid, " << numMismatches << " mismatches" << TestLog::EndMessage
+			<< TestLog::Message << numQuick[tcu::QUICK_LOOKUP_ACCEPT] << " early accepts, " << numQuick[tcu::QUICK_LOOKUP_REJECT] << " early rejects, "
+								<< numQuick[tcu::QUICK_LOOKUP_UNKNOWN] << " exhaustive searches" << TestLog::EndMessage;
+
+		if (numMismatches != 0)
+			m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Min/max pyramid changed lookup verification result");
+		else if (numQuick[tcu::QUICK_LOOKUP_ACCEPT] == 0 || numQuick[tcu::QUICK_LOOKUP_REJECT] == 0)
+			m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Early accept and reject were not both exercised");
+		else
+			m_testCtx.setTestResult(QP_TEST_RESULT_PASS, "Pass");
+
+		return STOP;
+	}
+
+private:
+	const TextureType	m_textureType;
+};
+
+//! Texture lookup verification over a whole image, with error mask written to given access.
+class LookupDiffFunc
+{
+public:
+	virtual			~LookupDiffFunc	(void) {}
+	virtual int		compute			(const tcu::PixelBufferAccess& errorMask) const = 0;
+};
+
+template<typename TextureViewType>
+class LookupDiff : public LookupDiffFunc
+{
+public:
+	LookupDiff (const tcu::ConstPixelBufferAccess&					result,
+				const tcu::ConstPixelBufferAccess&					reference,
+				const TextureViewType&								view,
+				const float*										texCoord,
+				const glu::TextureTestUtil::ReferenceParams&		params,
+				const tcu::LookupPrecision&							lookupPrec,
+				const tcu::LodPrecision&							lodPrec)
+		: m_result		(result)
+		, m_reference	(reference)
+		, m_view		(view)
+		, m_texCoord	(texCoord)
+		, m_params		(params)
+		, m_lookupPrec	(lookupPrec)
+		, m_lodPrec		(lodPrec)
+	{
+	}
+
+	int compute (const tcu::PixelBufferAccess& errorMask) const
+	{
+		return glu::TextureTestUtil::computeTextureLookupDiff(m_result, m_reference, errorMask, m_view, m_texCoord, m_params, m_lookupPrec, m_lodPrec, DE_NULL);
+	}
+
+private:
+	const tcu::ConstPixelBufferAccess				m_result;
+	const tcu::ConstPixelBufferAccess				m_reference;
+	const TextureViewType							m_view;
+	const float* const								m_texCoord;
+	const glu::TextureTestUtil::ReferenceParams&	m_params;
+	const tcu::LookupPrecision&						m_lookupPrec;
+	const tcu::LodPrecision&						m_lodPrec;
+};
+
+//! Runs verification on a worker thread, where tcu::executeBatches() executes all batches serially in order.
+class SerialLookupDiffTask : public tcu::WorkerPool::Task
+{
+public:
+	SerialLookupDiffTask (const LookupDiffFunc& func, const tcu::PixelBufferAccess& errorMask, de::Semaphore& done)
+		: m_func		(func)
+		, m_errorMask	(errorMask)
+		, m_done		(done)
+		, m_numFailed	(-1)
+	{
+	}
+
+	void execute (void)
+	{
+		DE_ASSERT(tcu::WorkerPool::isWorkerThread());
+
+		try
+		{
+			m_numFailed = m_func.compute(m_errorMask);
+		}
+		catch (...)
+		{
+			m_error.capture();
+		}
+
+		m_done.increment();
+	}
+
+	int getNumFailed (void) const
+	{
+		m_error.rethrow();
+		return m_numFailed;
+	}
+
+private:
+	const LookupDiffFunc&		m_func;
+	const tcu::PixelBufferAccess	m_errorMask;
+	de::Semaphore&				m_done;
+	int							m_numFailed;
+	tcu::CapturedException		m_error;
+};
+
+class TexLookupDiffParallelCase : public tcu::TestCase
+{
+public:
+	TexLookupDiffParallelCase (tcu::TestContext& testCtx, const char* name, glu::TextureTestUtil::TextureType textureType)
+		: tcu::TestCase		(testCtx, name, "Compare parallel texture lookup verification to serial verification")
+		, m_textureType		(textureType)
+	{
+		DE_ASSERT(textureType == glu::TextureTestUtil::TEXTURETYPE_2D || textureType == glu::TextureTestUtil::TEXTURETYPE_CUBE);
+	}
+
+	IterateResult iterate (void)
+	{
+		static const tcu::Sampler::WrapMode		wrapModes[]		=
+		{
+			tcu::Sampler::CLAMP_TO_EDGE,
+			tcu::Sampler::REPEAT_GL,
+			tcu::Sampler::MIRRORED_REPEAT_GL
+		};
+		static const tcu::Sampler::FilterMode	minFilters[]	=
+		{
+			tcu::Sampler::NEAREST,
+			tcu::Sampler::LINEAR,
+			tcu::Sampler::NEAREST_MIPMAP_NEAREST,
+			tcu::Sampler::LINEAR_MIPMAP_LINEAR
+		};
+
+		TestLog&					log				= m_testCtx.getLog();
+		de::Random					rnd				(deStringHash(getName()));
+		const tcu::TextureFormat	format			(tcu::TextureFormat::RGBA, tcu::TextureFormat::UNORM_INT8);
+		const tcu::PixelFormat		pixelFormat		(8, 8, 8, 8);
+		// Height is not a multiple of the band height, so the last band is partial.
+		const int					width			= 48;
+		const int					height			= 39;
+		const int					numIterations	= 6;
+		tcu::WorkerPool				serialPool		(1);
+		int							numMismatches	= 0;
+		int							numFailed		= 0;
+
+		log << TestLog::Message << "Shared worker pool has " << tcu::getSharedWorkerPool().getNumThreads() << " thread(s)" << TestLog::EndMessage;
+
+		for (int iterNdx = 0; iterNdx < numIterations; iterNdx++)
+		{
+			const int									size		= rnd.getInt(4, 64);
+			const int									numLevels	= deLog2Floor32(size) + 1;
+			tcu::Sampler								sampler		(wrapModes[rnd.getInt(0, DE_LENGTH_OF_ARRAY(wrapModes)-1)],
+																	 wrapModes[rnd.getInt(0, DE_LENGTH_OF_ARRAY(wrapModes)-1)],
+																	 wrapModes[rnd.getInt(0, DE_LENGTH_OF_ARRAY(wrapModes)-1)],
+																	 minFilters[rnd.getInt(0, DE_LENGTH_OF_ARRAY(minFilters)-1)],
+																	 rnd.getBool() ? tcu::Sampler::LINEAR : tcu::Sampler::NEAREST);
+			const glu::TextureTestUtil::ReferenceParams	params		(m_textureType, sampler);
+			tcu::Texture2D								tex2D		(format, size, size);
+			tcu::TextureCube							texCube		(format, size);
+			vector<float>								texCoord;
+			tcu::Surface								reference	(width, height);
+			tcu::Surface								result		(width, height);
+			tcu::Surface								maskParallel(width, height);
+			tcu::Surface								maskSerial	(width, height);
+			tcu::LookupPrecision						lookupPrec;
+			tcu::LodPrecision							lodPrec		(18, 6);
+			de::MovePtr<LookupDiffFunc>					diff;
+
+			lookupPrec.coordBits		= tcu::IVec3(20);
+			lookupPrec.uvwBits			= tcu::IVec3(7);
+			lookupPrec.colorThreshold	= tcu::Vec4(2.0f / 255.0f);
+			lookupPrec.colorMask		= tcu::BVec4(true);
+
+			for (int levelNdx = 0; levelNdx < numLevels; levelNdx++)
+			{
+				if (m_textureType == glu::TextureTestUtil::TEXTURETYPE_2D)
+				{
+					tex2D.allocLevel(levelNdx);
+					fillRandom(rnd, tex2D.getLevel(levelNdx));
+				}
+				else
+				{
+					for (int face = 0; face < tcu::CUBEFACE_LAST; face++)
+					{
+						texCube.allocLevel(tcu::CubeFace(face), levelNdx);
+						fillRandom(rnd, texCube.getLevelFace(levelNdx, tcu::CubeFace(face)));
+					}
+				}
+			}
+
+			{
+				const tcu::Vec2	bottomLeft	(rnd.getFloat(-1.0f, 0.5f), rnd.getFloat(-1.0f, 0.5f));
+				const tcu::Vec2	topRight	(rnd.getFloat(0.5f, 2.0f), rnd.getFloat(0.5f, 2.0f));
+
+				if (m_textureType == glu::TextureTestUtil::TEXTURETYPE_2D)
+				{
+					glu::TextureTestUtil::computeQuadTexCoord2D(texCoord, bottomLeft, topRight);
+					glu::TextureTestUtil::sampleTexture(tcu::SurfaceAccess(reference, pixelFormat), tex2D, &texCoord[0], params);
+					diff = de::MovePtr<LookupDiffFunc>(new LookupDiff<tcu::Texture2DView>(result.getAccess(), reference.getAccess(), tex2D, &texCoord[0], params, lookupPrec, lodPrec));
+				}
+				else
+				{
+					glu::TextureTestUtil::computeQuadTexCoordCube(texCoord, tcu::CubeFace(rnd.getInt(0, tcu::CUBEFACE_LAST-1)), bottomLeft * 0.5f, topRight * 0.5f);
+					glu::TextureTestUtil::sampleTexture(tcu::SurfaceAccess(reference, pixelFormat), texCube, &texCoord[0], params);
+					diff = de::MovePtr<LookupDiffFunc>(new LookupDiff<tcu::TextureCubeView>(result.getAccess(), reference.getAccess(), texCube, &texCoord[0], params, lookupPrec, lodPrec));
+				}
+			}
+
+			// Result is the reference with some pixels replaced, so that both valid and invalid lookups are verified.
+			for (int y = 0; y < height; y++)
+			for (int x = 0; x < width; x++)
+				result.setPixel(x, y, rnd.getInt(0, 9) == 0 ? tcu::RGBA(rnd.getUint32()) : reference.getPixel(x, y));
+
+			{
+				const int			numFailedParallel	= diff->compute(maskParallel.getAccess());
+				de::Semaphore		done				(0);
+				SerialLookupDiffTask	serialTask		(*diff, maskSerial.getAccess(), done);
+
+				serialPool.submit(&serialTask);
+				done.decrement();
+
+				{
+					const int numFailedSerial = serialTask.getNumFailed();
+
+					if (numFailedParallel != numFailedSerial)
+					{
+						log << TestLog::Message << "ERROR: Iteration " << iterNdx << ": parallel verification failed " << numFailedParallel
+												<< " pixels, serial verification " << numFailedSerial << TestLog::EndMessage;
+						numMismatches += 1;
+					}
+				}
+
+				if (!tcu::intThresholdCompare(log, ("ErrorMask" + de::toString(iterNdx)).c_str(), "Parallel and serial error masks", maskSerial.getAccess(), maskParallel.getAccess(), tcu::UVec4(0), tcu::COMPARE_LOG_ON_ERROR))
+					numMismatches += 1;
+
+				numFailed += numFailedParallel;
+			}
+		}
+
+		log << TestLog::Message << numFailed << " invalid lookups found in " << numIterations << " images, " << numMismatches << " mismatches" << TestLog::EndMessage;
+
+		if (numMismatches == 0 && numFailed > 0)
+			m_testCtx.setTestResult(QP_TEST_RESULT_PASS, "Pass");
+		else if (numMismatches != 0)
+			m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Parallel verification differs from serial verification");
+		else
+			m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "No invalid lookups were detected");
+
+		return STOP;
+	}
+
+private:
+	static void fillRandom (de::Random& rnd, const tcu::PixelBufferAccess& access)
+	{
+		for (int y = 0; y < access.getHeight(); y++)
+		for (int x = 0; x < access.getWidth(); x++)
+			access.setPixel(tcu::Vec4(rnd.getFloat(), rnd.getFloat(), rnd.getFloat(), rnd.getFloat()), x, y);
+	}
+
+	const glu::TextureTestUtil::TextureType	m_textureType;
+};
+
+//! Throws exception of given type from one batch.
+class ThrowingBatchFunc : public tcu::BatchFunc
+{
+public:
+	enum ExceptionType
+	{
+		EXCEPTION_TEST_ERROR = 0,
+		EXCEPTION_NOT_SUPPORTED,
+		EXCEPTION_RESOURCE_ERROR,
+		EXCEPTION_BAD_ALLOC,
+
+		EXCEPTION_LAST
+	};
+
+	ThrowingBatchFunc (ExceptionType type, int throwingBatchNdx)
+		: m_type				(type)
+		, m_throwingBatchNdx	(throwingBatchNdx)
+	{
+	}
+
+	void operator() (int batchNdx, int, int) const
+	{
+		if (batchNdx != m_throwingBatchNdx)
+			return;
+
+		switch (m_type)
+		{
+			case EXCEPTION_TEST_ERROR:			throw tcu::TestError("Batch failed");
+			case EXCEPTION_NOT_SUPPORTED:		throw tcu::NotSupportedError("Batch not supported");
+			case EXCEPTION_RESOURCE_ERROR:		throw tcu::ResourceError("Batch out of resources");
+			case EXCEPTION_BAD_ALLOC:			throw std::bad_alloc();
+			default:
+				DE_ASSERT(false);
+		}
+	}
+
+private:
+	const ExceptionType	m_type;
+	const int			m_throwingBatchNdx;
+};
+
+class BatchExceptionCase : public tcu::TestCase
+{
+public:
+	BatchExceptionCase (tcu::TestContext& testCtx, const char* name)
+		: tcu::TestCase(testCtx, name, "Exception type thrown from a batch is preserved by tcu::executeBatches()")
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		static const char* const	typeNames[]	=
+		{
+			"tcu::TestError",
+			"tcu::NotSupportedError",
+			"tcu::ResourceError",
+			"std::bad_alloc"
+		};
+		DE_STATIC_ASSERT(DE_LENGTH_OF_ARRAY(typeNames) == ThrowingBatchFunc::EXCEPTION_LAST);
+
+		TestLog&	log			= m_testCtx.getLog();
+		const int	numItems	= 256;
+		const int	batchSize	= 4;
+		bool		allOk		= true;
+
+		for (int typeNdx = 0; typeNdx < ThrowingBatchFunc::EXCEPTION_LAST; typeNdx++)
+		{
+			const ThrowingBatchFunc	func		((ThrowingBatchFunc::ExceptionType)typeNdx, tcu::getNumBatches(numItems, batchSize) / 2);
+			int						caughtNdx	= -1;
+
+			// Most derived types first, TestError is a base of none of the others.
+			try
+			{
+				tcu::executeBatches(numItems, batchSize, func, DE_NULL);
+			}
+			catch (const tcu::NotSupportedError&)	{ caughtNdx = ThrowingBatchFunc::EXCEPTION_NOT_SUPPORTED;	}
+			catch (const tcu::ResourceError&)		{ caughtNdx = ThrowingBatchFunc::EXCEPTION_RESOURCE_ERROR;	}
+			catch (const tcu::TestError&)			{ caughtNdx = ThrowingBatchFunc::EXCEPTION_TEST_ERROR;		}
+			catch (const std::bad_alloc&)			{ caughtNdx = ThrowingBatchFunc::EXCEPTION_BAD_ALLOC;		}
+			catch (const std::exception&)			{}
+
+			log << TestLog::Message << "Threw " << typeNames[typeNdx] << ", caught " << (caughtNdx >= 0 ? typeNames[caughtNdx] : "other exception type") << TestLog::EndMessage;
+
+			if (caughtNdx != typeNdx)
+				allOk = false;
+		}
+
+		m_testCtx.setTestResult(allOk ? QP_TEST_RESULT_PASS : QP_TEST_RESULT_FAIL, allOk ? "Pass" : "Exception type was not preserved");
+		return STOP;
+	}
+};
+
+class TexPacketSampleCase : public tcu::TestCase
+{
+public:
+	TexPacketSampleCase (tcu::TestContext& testCtx, const char* name)
+		: tcu::TestCase(testCtx, name, "Compare Texture2DView packet sampling to single lookups")
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		static const tcu::TextureFormat			formats[]		=
+		{
+			tcu::TextureFormat(tcu::TextureFormat::RGBA,	tcu::TextureFormat::UNORM_INT8),
+			tcu::TextureFormat(tcu::TextureFormat::sRGBA,	tcu::TextureFormat::UNORM_INT8),
+			tcu::TextureFormat(tcu::TextureFormat::RGBA,	tcu::TextureFormat::HALF_FLOAT),
+			tcu::TextureFormat(tcu::TextureFormat::RGBA,	tcu::TextureFormat::FLOAT),
+			tcu::TextureFormat(tcu::TextureFormat::RG,		tcu::TextureFormat::UNORM_INT16),
+			tcu::TextureFormat(tcu::TextureFormat::D,		tcu::TextureFormat::UNORM_INT16),
+			tcu::TextureFormat(tcu::TextureFormat::D,		tcu::TextureFormat::FLOAT)
+		};
+		static const tcu::Sampler::WrapMode		wrapModes[]		=
+		{
+			tcu::Sampler::CLAMP_TO_EDGE,
+			tcu::Sampler::CLAMP_TO_BORDER,
+			tcu::Sampler::REPEAT_GL,
+			tcu::Sampler::MIRRORED_REPEAT_GL,
+			tcu::Sampler::MIRRORED_REPEAT_CL
+		};
+		static const tcu::Sampler::FilterMode	minFilters[]	=
+		{
+			tcu::Sampler::NEAREST,
+			tcu::Sampler::LINEAR,
+			tcu::Sampler::NEAREST_MIPMAP_NEAREST,
+			tcu::Sampler::LINEAR_MIPMAP_NEAREST,
+			tcu::Sampler::NEAREST_MIPMAP_LINEAR,
+			tcu::Sampler::LINEAR_MIPMAP_LINEAR
+		};
+
+		TestLog&	log				= m_testCtx.getLog();
+		de::Random	rnd				(deStringHash(getName()));
+		const int	numIterations	= 20;
+		const int	numSamples		= 37;
+		int			numMismatches	= 0;
+
+		for (int formatNdx = 0; formatNdx < DE_LENGTH_OF_ARRAY(formats); formatNdx++)
+		for (int iterNdx = 0; iterNdx < numIterations; iterNdx++)
+		{
+			const tcu::TextureFormat			format		= formats[formatNdx];
+			const tcu::IVec2					size		(rnd.getInt(1, 40), rnd.getInt(1, 40));
+			const int							numLevels	= deLog2Floor32(de::max(size.x(), size.y())) + 1;
+			vector<tcu::TextureLevel>			levels		(numLevels);
+			vector<tcu::ConstPixelBufferAccess>	levelAccess	(numLevels);
+			tcu::Sampler						sampler		(wrapModes[rnd.getInt(0, DE_LENGTH_OF_ARRAY(wrapModes)-1)],
+															 wrapModes[rnd.getInt(0, DE_LENGTH_OF_ARRAY(wrapModes)-1)],
+															 tcu::Sampler::CLAMP_TO_EDGE,
+															 minFilters[rnd.getInt(0, DE_LENGTH_OF_ARRAY(minFilters)-1)],
+															 rnd.getBool() ? tcu::Sampler::LINEAR : tcu::Sampler::NEAREST);
+			vector<tcu::Vec2>					coords		(numSamples);
+			vector<float>						lods		(numSamples);
+			vector<tcu::Vec4>					results		(numSamples);
+
+			sampler.borderColor			= tcu::Vec4(rnd.getFloat(), 0.5f, 0.25f, 1.0f);
+			sampler.normalizedCoords	= iterNdx % 4 != 3;
+
+			for (int levelNdx = 0; levelNdx < numLevels; levelNdx++)
+			{
+				levels[levelNdx].setStorage(format, de::max(1, size.x() >> levelNdx), de::max(1, size.y() >> levelNdx));
+
+				for (int y = 0; y < levels[levelNdx].getHeight(); y++)
+				for (int x = 0; x < levels[levelNdx].getWidth(); x++)
+					levels[levelNdx].getAccess().setPixel(tcu::Vec4(rnd.getFloat(), rnd.getFloat(), rnd.getFloat(), rnd.getFloat()), x, y);
+
+				levelAccess[levelNdx] = levels[levelNdx].getAccess();
+			}
+
+			// Most packets share a lod, as in fragment quads; some lanes get their own to exercise the mixed path.
+			{
+				const float		coordScale	= sampler.normalizedCoords ? 1.0f : (float)de::max(size.x(), size.y());
+				float			packetLod	= 0.0f;
+
+				for (int ndx = 0; ndx < numSamples; ndx++)
+				{
+					if (ndx % 4 == 0)
+						packetLod = rnd.getFloat(-1.0f, (float)numLevels);
+
+					coords[ndx]	= tcu::Vec2(rnd.getFloat(-0.3f, 1.3f), rnd.getFloat(-0.3f, 1.3f)) * coordScale;
+					lods[ndx]	= rnd.getInt(0, 9) == 0 ? rnd.getFloat(-1.0f, (float)numLevels) : packetLod;
+				}
+			}
+
+			{
+				const tcu::Texture2DView view (numLevels, &levelAccess[0]);
+
+				view.samplePacket(&results[0], sampler, &coords[0], &lods[0], numSamples);
+
+				for (int ndx = 0; ndx < numSamples; ndx++)
+				{
+					const tcu::Vec4 reference = view.sample(sampler, coords[ndx].x(), coords[ndx].y(), lods[ndx]);
+
+					if (reference != results[ndx])
+					{
+						if (numMismatches < 10)
+							log << TestLog::Message << "ERROR: " << format << ", iteration " << iterNdx << ", sample " << ndx
+													<< ": expected " << reference << ", got " << results[ndx]
+								<< TestLog::EndMessage;
+
+						numMismatches += 1;
+					}
+				}
+			}
+		}
+
+		if (numMismatches == 0)
+			m_testCtx.setTestResult(QP_TEST_RESULT_PASS, "Pass");
+		else
+			m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Packet sampling result differs from single lookup");
+
+		return STOP;
+	}
+};
+
+class TextureCopyConversionCase : public tcu::TestCase
+{
+public:
+	TextureCopyConversionCase (tcu::TestContext& testCtx, const char* name)
+		: tcu::TestCase(testCtx, name, "Compare tcu::copy() and tcu::clear() fast paths to per-pixel conversion")
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		typedef tcu::TextureFormat TF;
+
+		static const struct
+		{
+			TF	src;
+			TF	dst;
+		} copyFormats[] =
+		{
+			{ TF(TF::RGBA,	TF::UNORM_INT8),					TF(TF::BGRA,	TF::UNORM_INT8)		},
+			{ TF(TF::BGRA,	TF::UNORM_INT8),					TF(TF::RGBA,	TF::UNORM_INT8)		},
+			{ TF(TF::RGB,	TF::UNORM_INT8),					TF(TF::RGBA,	TF::UNORM_INT8)		},
+			{ TF(TF::RGBA,	TF::UNORM_INT8),					TF(TF::RGB,		TF::UNORM_INT8)		},
+			{ TF(TF::R,		TF::UNORM_INT8),					TF(TF::R,		TF::FLOAT)			},
+			{ TF(TF::RGBA,	TF::UNORM_INT8),					TF(TF::RGBA,	TF::FLOAT)			},
+			{ TF(TF::RG,	TF::HALF_FLOAT),					TF(TF::RG,		TF::FLOAT)			},
+			{ TF(TF::RGBA,	TF::HALF_FLOAT),					TF(TF::RGBA,	TF::FLOAT)			},
+			{ TF(TF::DS,	TF::FLOAT_UNSIGNED_INT_24_8_REV),	TF(TF::D,		TF::FLOAT)			},
+			{ TF(TF::DS,	TF::FLOAT_UNSIGNED_INT_24_8_REV),	TF(TF::S,		TF::UNSIGNED_INT8)	},
+			{ TF(TF::DS,	TF::UNSIGNED_INT_24_8),				TF(TF::S,		TF::UNSIGNED_INT8)	},
+			{ TF(TF::DS,	TF::UNSIGNED_INT_24_8_REV),			TF(TF::S,		TF::UNSIGNED_INT8)	},
+		};
+		static const TF clearFormats[] =
+		{
+			TF(TF::R,		TF::UNORM_INT8),
+			TF(TF::RGB,		TF::UNORM_INT8),
+			TF(TF::RGBA,	TF::UNORM_INT8),
+			TF(TF::RGBA,	TF::HALF_FLOAT),
+			TF(TF::RGB,		TF::FLOAT),
+			TF(TF::RGBA,	TF::FLOAT),
+		};
+
+		TestLog&	log				= m_testCtx.getLog();
+		de::Random	rnd				(deStringHash(getName()));
+		int			numFailures		= 0;
+
+		for (int formatNdx = 0; formatNdx < DE_LENGTH_OF_ARRAY(copyFormats); formatNdx++)
+		{
+			const TF				srcFormat	= copyFormats[formatNdx].src;
+			const TF				dstFormat	= copyFormats[formatNdx].dst;
+			const int				width		= rnd.getInt(1, 67);
+			const int				height		= rnd.getInt(1, 9);
+			tcu::TextureLevel		src			(srcFormat, width, height);
+			tcu::TextureLevel		result		(dstFormat, width, height);
+			tcu::TextureLevel		reference	(dstFormat, width, height);
+			const int				dstDataSize	= width*height*dstFormat.getPixelSize();
+
+			// Random bit patterns include denormals, infinities and NaNs.
+			for (int ndx = 0; ndx < width*height*srcFormat.getPixelSize(); ndx++)
+				((deUint8*)src.getAccess().getDataPtr())[ndx] = rnd.getUint8();
+
+			for (int y = 0; y < height; y++)
+			for (int x = 0; x < width; x++)
+			{
+				if (dstFormat.order == TF::D)
+					reference.getAccess().setPixDepth(src.getAccess().getPixDepth(x, y), x, y);
+				else if (dstFormat.order == TF::S)
+					reference.getAccess().setPixStencil(src.getAccess().getPixStencil(x, y), x, y);
+				else
+					reference.getAccess().setPixel(src.getAccess().getPixel(x, y), x, y);
+			}
+
+			tcu::copy(result.getAccess(), src.getAccess());
+
+			if (deMemCmp(result.getAccess().getDataPtr(), reference.getAccess().getDataPtr(), dstDataSize) != 0)
+			{
+				log << TestLog::Message << "ERROR: copy from " << srcFormat << " to " << dstFormat << " differs from per-pixel conversion" << TestLog::EndMessage;
+				numFailures += 1;
+			}
+		}
+
+		for (int formatNdx = 0; formatNdx < DE_LENGTH_OF_ARRAY(clearFormats); formatNdx++)
+		{
+			const TF				format		= clearFormats[formatNdx];
+			const int				width		= rnd.getInt(16, 67);
+			const int				height		= rnd.getInt(8, 16);
+			const tcu::Vec4			color		(rnd.getFloat(), rnd.getFloat(), rnd.getFloat(), rnd.getFloat());
+			tcu::TextureLevel		result		(format, width, height);
+			tcu::TextureLevel		reference	(format, width, height);
+
+			for (int y = 0; y < height; y++)
+			for (int x = 0; x < width; x++)
+				reference.getAccess().setPixel(color, x, y);
+
+			tcu::clear(result.getAccess(), color);
+
+			if (deMemCmp(result.getAccess().getDataPtr(), reference.getAccess().getDataPtr(), width*height*format.getPixelSize()) != 0)
+			{
+				log << TestLog::Message << "ERROR: clear of " << format << " differs from per-pixel clear" << TestLog::EndMessage;
+				numFailures += 1;
+			}
+		}
+
+		if (numFailures == 0)
+			m_testCtx.setTestResult(QP_TEST_RESULT_PASS, "Pass");
+		else
+			m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Fast path result differs from per-pixel conversion");
+
+		return STOP;
+	}
+};
+
 inline deUint32 ulpDiff (float a, float b)
 {
 	const deUint32 ab = tcu::Float32(a).bits();
@@ -880,6 +2024,635 @@ protected:
 	vector<SubCase>::const_iterator	m_caseIter;
 };
 
+//! Passes position and color attributes through unmodified.
+class VertexColorShader : public sglr::ShaderProgram
+{
+public:
+	VertexColorShader (void)
+		: sglr::ShaderProgram(sglr::pdec::ShaderProgramDeclaration()
+								<< sglr::pdec::VertexAttribute("a_position", rr::GENERICVECTYPE_FLOAT)
+								<< sglr::pdec::VertexAttribute("a_color", rr::GENERICVECTYPE_FLOAT)
+								<< sglr::pdec::VertexToFragmentVarying(rr::GENERICVECTYPE_FLOAT)
+								<< sglr::pdec::FragmentOutput(rr::GENERICVECTYPE_FLOAT)
+								<< sglr::pdec::VertexSource("")
+								<< sglr::pdec::FragmentSource(""))
+	{
+	}
+
+	void shadeVertices (const rr::VertexAttrib* inputs, rr::VertexPacket* const* packets, const int numPackets) const
+	{
+		for (int packetNdx = 0; packetNdx < numPackets; packetNdx++)
+		{
+			rr::VertexPacket& packet = *packets[packetNdx];
+
+			packet.position		= rr::readVertexAttribFloat(inputs[0], packet.instanceNdx, packet.vertexNdx);
+			packet.outputs[0]	= rr::readVertexAttribFloat(inputs[1], packet.instanceNdx, packet.vertexNdx);
+		}
+	}
+
+	void shadeFragments (rr::FragmentPacket* packets, const int numPackets, const rr::FragmentShadingContext& context) const
+	{
+		for (int packetNdx = 0; packetNdx < numPackets; packetNdx++)
+		{
+			for (int fragNdx = 0; fragNdx < rr::NUM_FRAGMENTS_PER_PACKET; fragNdx++)
+				rr::writeFragmentOutput(context, packetNdx, fragNdx, 0, rr::readVarying<float>(packets[packetNdx], context, 0, fragNdx));
+		}
+	}
+};
+
+class DrawBatchingCase : public tcu::TestCase
+{
+public:
+	DrawBatchingCase (tcu::TestContext& testCtx)
+		: tcu::TestCase(testCtx, "draw_batching", "sglr::ReferenceContext draw batching matches unbatched rendering")
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		const int		width			= 64;
+		const int		height			= 64;
+		tcu::Surface	unbatched		(width, height);
+		tcu::Surface	batched			(width, height);
+		vector<float>	unbatchedDepth;
+		vector<float>	batchedDepth;
+
+		render(false, unbatched, unbatchedDepth);
+		render(true, batched, batchedDepth);
+
+		if (!tcu::intThresholdCompare(m_testCtx.getLog(), "Result", "Batched vs. unbatched rendering", unbatched.getAccess(), batched.getAccess(), tcu::UVec4(0u), tcu::COMPARE_LOG_RESULT))
+			m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Batched rendering differs");
+		else if (unbatchedDepth != batchedDepth)
+			m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Batched depth buffer differs");
+		else
+			m_testCtx.setTestResult(QP_TEST_RESULT_PASS, "Pass");
+
+		return STOP;
+	}
+
+private:
+	void render (bool batching, tcu::Surface& dst, vector<float>& depth) const
+	{
+		const int						numVertices	= 300;
+		sglr::ReferenceContextLimits	limits;
+		sglr::ReferenceContextBuffers	buffers		(tcu::PixelFormat(8, 8, 8, 8), 24, 0, dst.getWidth(), dst.getHeight());
+		sglr::ReferenceContext			ctx			(limits, buffers.getColorbuffer(), buffers.getDepthbuffer(), buffers.getStencilbuffer());
+		VertexColorShader				shader;
+		vector<tcu::Vec4>				vertices;
+		de::Random						rnd			(0x7a3c91);
+		deUint32						buffer		= 0;
+
+		// Interleaved position and color; translucent colors make the result depend on draw order.
+		for (int vtxNdx = 0; vtxNdx < numVertices; vtxNdx++)
+		{
+			vertices.push_back(tcu::Vec4(rnd.getFloat(-1.2f, 1.2f), rnd.getFloat(-1.2f, 1.2f), rnd.getFloat(-1.0f, 1.0f), 1.0f));
+			vertices.push_back(tcu::Vec4(rnd.getFloat(), rnd.getFloat(), rnd.getFloat(), rnd.getFloat(0.2f, 0.8f)));
+		}
+
+		ctx.setDrawBatchingEnabled(batching);
+
+		{
+			const deUint32	program		= ctx.createProgram(&shader);
+			const int		positionLoc	= ctx.getAttribLocation(program, "a_position");
+			const int		colorLoc	= ctx.getAttribLocation(program, "a_color");
+
+			ctx.genBuffers(1, &buffer);
+			ctx.bindBuffer(GL_ARRAY_BUFFER, buffer);
+			ctx.bufferData(GL_ARRAY_BUFFER, (deIntptr)(vertices.size() * sizeof(tcu::Vec4)), &vertices[0], GL_STATIC_DRAW);
+
+			ctx.useProgram(program);
+			ctx.enableVertexAttribArray(positionLoc);
+			ctx.vertexAttribPointer(positionLoc, 4, GL_FLOAT, GL_FALSE, 2 * sizeof(tcu::Vec4), DE_NULL);
+			ctx.enableVertexAttribArray(colorLoc);
+			ctx.vertexAttribPointer(colorLoc, 4, GL_FLOAT, GL_FALSE, 2 * sizeof(tcu::Vec4), (const void*)sizeof(tcu::Vec4));
+
+			ctx.clearColor(0.0f, 0.0f, 0.0f, 1.0f);
+			ctx.clearDepthf(1.0f);
+			ctx.clear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+			ctx.enable(GL_BLEND);
+			ctx.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+			// Consecutive ranges are merged
+			for (int first = 0; first < 90; first += 3)
+				ctx.drawArrays(GL_TRIANGLES, first, 3);
+
+			// Range restarting from the beginning is not
+			ctx.drawArrays(GL_TRIANGLES, 0, 6);
+
+			// Trailing partial primitive must not combine with next draw
+			ctx.drawArrays(GL_TRIANGLES, 90, 4);
+			ctx.drawArrays(GL_TRIANGLES, 94, 3);
+			ctx.drawArrays(GL_TRIANGLES, 97, 5);
+
+			// State change between draws
+			ctx.enable(GL_DEPTH_TEST);
+			ctx.depthFunc(GL_LESS);
+
+			for (int first = 102; first < 180; first += 6)
+				ctx.drawArrays(GL_TRIANGLES, first, 6);
+
+			ctx.blendFunc(GL_ONE, GL_ONE);
+
+			for (int first = 180; first < 240; first += 2)
+				ctx.drawArrays(GL_LINES, first, 2);
+
+			ctx.drawArrays(GL_POINTS, 240, 30);
+			ctx.drawArrays(GL_POINTS, 270, 30);
+
+			// Strips are not batched but must still be ordered after deferred draws
+			ctx.drawArrays(GL_TRIANGLES, 0, 3);
+			ctx.drawArrays(GL_TRIANGLE_STRIP, 3, 5);
+
+			ctx.readPixels(dst, 0, 0, dst.getWidth(), dst.getHeight());
+
+			ctx.disableVertexAttribArray(positionLoc);
+			ctx.disableVertexAttribArray(colorLoc);
+			ctx.useProgram(0);
+			ctx.deleteProgram(program);
+			ctx.deleteBuffers(1, &buffer);
+			ctx.finish();
+		}
+
+		{
+			const tcu::ConstPixelBufferAccess depthAccess = rr::getSubregion(buffers.getDepthbuffer(), 0, 0, dst.getWidth(), dst.getHeight()).toSinglesampleAccess();
+
+			depth.clear();
+
+			for (int y = 0; y < dst.getHeight(); y++)
+			for (int x = 0; x < dst.getWidth(); x++)
+				depth.push_back(depthAccess.getPixDepth(x, y));
+		}
+	}
+};
+
+//! Renders the same command sequence to reference contexts serially, and concurrently with sglr::ContextWrapper::ScopedThreadContext.
+class ThreadContextRenderCase : public tcu::TestCase, private sglr::ContextWrapper
+{
+public:
+	ThreadContextRenderCase (tcu::TestContext& testCtx)
+		: tcu::TestCase(testCtx, "thread_context_render", "Rendering on a separate thread with ScopedThreadContext matches serial rendering")
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		const int				width		= 64;
+		const int				height		= 64;
+		TestLog&				log			= m_testCtx.getLog();
+		tcu::Surface			serial		(width, height);
+		tcu::Surface			threaded	(width, height);
+		tcu::Surface			concurrent	(width, height);
+
+		// Serial: both images rendered on the calling thread one after another.
+		renderReference(serial);
+
+		// Threaded: one image is rendered on a separate thread while the calling thread renders the other
+		// through the context set with setContext(), as FboTestCase does.
+		{
+			sglr::ReferenceContextLimits	limits;
+			sglr::ReferenceContextBuffers	buffers		(tcu::PixelFormat(8, 8, 8, 8), 24, 8, width, height);
+			sglr::ReferenceContext			context		(limits, buffers.getColorbuffer(), buffers.getDepthbuffer(), buffers.getStencilbuffer());
+			RenderThread					thread		(*this, threaded);
+
+			thread.start();
+
+			setContext(&context);
+			render(concurrent);
+			setContext(DE_NULL);
+
+			thread.join();
+			thread.checkError();
+		}
+
+		{
+			const bool threadedOk	= tcu::intThresholdCompare(log, "Threaded", "Serial vs. separate thread rendering", serial.getAccess(), threaded.getAccess(), tcu::UVec4(0u), tcu::COMPARE_LOG_RESULT);
+			const bool concurrentOk	= tcu::intThresholdCompare(log, "Concurrent", "Serial vs. calling thread rendering", serial.getAccess(), concurrent.getAccess(), tcu::UVec4(0u), tcu::COMPARE_LOG_RESULT);
+
+			m_testCtx.setTestResult(threadedOk && concurrentOk ? QP_TEST_RESULT_PASS : QP_TEST_RESULT_FAIL,
+									threadedOk && concurrentOk ? "Pass" : "Concurrent rendering differs from serial rendering");
+		}
+
+		return STOP;
+	}
+
+private:
+	class RenderThread : public de::Thread
+	{
+	public:
+		RenderThread (ThreadContextRenderCase& testCase, tcu::Surface& dst)
+			: m_testCase	(testCase)
+			, m_dst			(dst)
+		{
+		}
+
+		~RenderThread (void)
+		{
+			if (isStarted())
+				join();
+		}
+
+		void run (void)
+		{
+			try
+			{
+				m_testCase.renderReference(m_dst);
+			}
+			catch (...)
+			{
+				m_error.capture();
+			}
+		}
+
+		void checkError (void) const
+		{
+			m_error.rethrow();
+		}
+
+	private:
+		ThreadContextRenderCase&		m_testCase;
+		tcu::Surface&					m_dst;
+		tcu::CapturedException			m_error;
+	};
+
+	void renderReference (tcu::Surface& dst)
+	{
+		sglr::ReferenceContextLimits	limits;
+		sglr::ReferenceContextBuffers	buffers			(tcu::PixelFormat(8, 8, 8, 8), 24, 8, dst.getWidth(), dst.getHeight());
+		sglr::ReferenceContext			context			(limits, buffers.getColorbuffer(), buffers.getDepthbuffer(), buffers.getStencilbuffer());
+		const ScopedThreadContext		threadContext	(*this, &context);
+
+		render(dst);
+	}
+
+	//! Draws blended triangles into a texture-backed framebuffer and blits it to the default framebuffer.
+	void render (tcu::Surface& dst)
+	{
+		const int			fboSize		= 32;
+		const int			numVertices	= 60;
+		VertexColorShader	shader;
+		vector<tcu::Vec4>	vertices;
+		de::Random			rnd			(0x1c5e07);
+		deUint32			buffer		= 0;
+		deUint32			texture		= 0;
+		deUint32			framebuffer	= 0;
+
+		for (int vtxNdx = 0; vtxNdx < numVertices; vtxNdx++)
+		{
+			vertices.push_back(tcu::Vec4(rnd.getFloat(-1.2f, 1.2f), rnd.getFloat(-1.2f, 1.2f), rnd.getFloat(-1.0f, 1.0f), 1.0f));
+			vertices.push_back(tcu::Vec4(rnd.getFloat(), rnd.getFloat(), rnd.getFloat(), rnd.getFloat(0.2f, 0.8f)));
+		}
+
+		{
+			sglr::Context&	ctx			= *getCurrentContext();
+			const deUint32	program		= ctx.createProgram(&shader);
+			const int		positionLoc	= ctx.getAttribLocation(program, "a_position");
+			const int		colorLoc	= ctx.getAttribLocation(program, "a_color");
+
+			glGenBuffers(1, &buffer);
+			glBindBuffer(GL_ARRAY_BUFFER, buffer);
+			glBufferData(GL_ARRAY_BUFFER, (deIntptr)(vertices.size() * sizeof(tcu::Vec4)), &vertices[0], GL_STATIC_DRAW);
+
+			glGenTextures(1, &texture);
+			glBindTexture(GL_TEXTURE_2D, texture);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, fboSize, fboSize, 0, GL_RGBA, GL_UNSIGNED_BYTE, DE_NULL);
+
+			glGenFramebuffers(1, &framebuffer);
+			glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+			TCU_CHECK(glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE);
+
+			glViewport(0, 0, fboSize, fboSize);
+			glClearColor(0.1f, 0.2f, 0.3f, 1.0f);
+			glClear(GL_COLOR_BUFFER_BIT);
+
+			glUseProgram(program);
+			ctx.enableVertexAttribArray(positionLoc);
+			ctx.vertexAttribPointer(positionLoc, 4, GL_FLOAT, GL_FALSE, 2 * sizeof(tcu::Vec4), DE_NULL);
+			ctx.enableVertexAttribArray(colorLoc);
+			ctx.vertexAttribPointer(colorLoc, 4, GL_FLOAT, GL_FALSE, 2 * sizeof(tcu::Vec4), (const void*)sizeof(tcu::Vec4));
+
+			glEnable(GL_BLEND);
+			glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+			ctx.drawArrays(GL_TRIANGLES, 0, numVertices / 2);
+
+			glBindFramebuffer(GL_FRAMEBUFFER, 0);
+			glViewport(0, 0, dst.getWidth(), dst.getHeight());
+			glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+			glClear(GL_COLOR_BUFFER_BIT);
+			ctx.drawArrays(GL_TRIANGLES, numVertices / 2, numVertices / 2);
+
+			glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+			glBlitFramebuffer(0, 0, fboSize, fboSize, 8, 8, 8 + fboSize, 8 + fboSize, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+			glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+
+			ctx.readPixels(dst, 0, 0, dst.getWidth(), dst.getHeight());
+
+			glUseProgram(0);
+			ctx.deleteProgram(program);
+			glDeleteFramebuffers(1, &framebuffer);
+			glDeleteTextures(1, &texture);
+			glDeleteBuffers(1, &buffer);
+		}
+	}
+};
+
+// Minimal GL implementation for exercising glu::ProgramBinaryCache through glu::ShaderProgram.
+
+struct FakeProgramBinaryGL
+{
+	int			numCompiles;
+	int			numLinks;
+	int			numBinaryLoads;
+	bool		rejectBinaries;
+	glw::GLuint	lastObject;
+	glw::GLint	linkStatus;
+
+	FakeProgramBinaryGL (void) : numCompiles(0), numLinks(0), numBinaryLoads(0), rejectBinaries(false), lastObject(0), linkStatus(GL_FALSE) {}
+};
+
+enum
+{
+	FAKE_BINARY_FORMAT	= 0x1234
+};
+
+const char				s_fakeBinary[]	= "dit fake program binary";
+FakeProgramBinaryGL		s_fakeGL;
+
+GLW_APICALL glw::GLuint GLW_APIENTRY fakeCreateObject (void)
+{
+	return ++s_fakeGL.lastObject;
+}
+
+GLW_APICALL glw::GLuint GLW_APIENTRY fakeCreateShader (glw::GLenum)
+{
+	return ++s_fakeGL.lastObject;
+}
+
+GLW_APICALL void GLW_APIENTRY fakeDeleteObject (glw::GLuint)
+{
+}
+
+GLW_APICALL void GLW_APIENTRY fakeAttachDetach (glw::GLuint, glw::GLuint)
+{
+}
+
+GLW_APICALL void GLW_APIENTRY fakeShaderSource (glw::GLuint, glw::GLsizei, const glw::GLchar* const*, const glw::GLint*)
+{
+}
+
+GLW_APICALL void GLW_APIENTRY fakeCompileShader (glw::GLuint)
+{
+	s_fakeGL.numCompiles += 1;
+}
+
+GLW_APICALL void GLW_APIENTRY fakeGetShaderiv (glw::GLuint, glw::GLenum pname, glw::GLint* params)
+{
+	*params = (pname == GL_COMPILE_STATUS) ? GL_TRUE : 0;
+}
+
+GLW_APICALL void GLW_APIENTRY fakeLinkProgram (glw::GLuint)
+{
+	s_fakeGL.numLinks	+= 1;
+	s_fakeGL.linkStatus	= GL_TRUE;
+}
+
+GLW_APICALL void GLW_APIENTRY fakeGetProgramiv (glw::GLuint, glw::GLenum pname, glw::GLint* params)
+{
+	if (pname == GL_LINK_STATUS)
+		*params = s_fakeGL.linkStatus;
+	else if (pname == GL_PROGRAM_BINARY_LENGTH)
+		*params = (glw::GLint)sizeof(s_fakeBinary);
+	else
+		*params = 0;
+}
+
+GLW_APICALL void GLW_APIENTRY fakeGetProgramBinary (glw::GLuint, glw::GLsizei bufSize, glw::GLsizei* length, glw::GLenum* binaryFormat, void* binary)
+{
+	DE_ASSERT(bufSize >= (glw::GLsizei)sizeof(s_fakeBinary));
+	DE_UNREF(bufSize);
+
+	deMemcpy(binary, s_fakeBinary, sizeof(s_fakeBinary));
+	*length			= (glw::GLsizei)sizeof(s_fakeBinary);
+	*binaryFormat	= FAKE_BINARY_FORMAT;
+}
+
+GLW_APICALL void GLW_APIENTRY fakeProgramBinary (glw::GLuint, glw::GLenum binaryFormat, const void* binary, glw::GLsizei length)
+{
+	const bool matches = binaryFormat == FAKE_BINARY_FORMAT && length == (glw::GLsizei)sizeof(s_fakeBinary) && deMemCmp(binary, s_fakeBinary, sizeof(s_fakeBinary)) == 0;
+
+	s_fakeGL.numBinaryLoads	+= 1;
+	s_fakeGL.linkStatus		= (matches && !s_fakeGL.rejectBinaries) ? GL_TRUE : GL_FALSE;
+}
+
+GLW_APICALL glw::GLenum GLW_APIENTRY fakeGetError (void)
+{
+	return GL_NO_ERROR;
+}
+
+GLW_APICALL void GLW_APIENTRY fakeGetIntegerv (glw::GLenum pname, glw::GLint* params)
+{
+	*params = (pname == GL_NUM_PROGRAM_BINARY_FORMATS) ? 1 : 0;
+}
+
+GLW_APICALL const glw::GLubyte* GLW_APIENTRY fakeGetString (glw::GLenum)
+{
+	return (const glw::GLubyte*)"dit";
+}
+
+class FakeProgramBinaryContext : public glu::RenderContext
+{
+public:
+	FakeProgramBinaryContext (void)
+		: m_renderTarget(1, 1, tcu::PixelFormat(8, 8, 8, 8), 0, 0, 0)
+	{
+		m_gl.createShader		= fakeCreateShader;
+		m_gl.createProgram		= fakeCreateObject;
+		m_gl.deleteShader		= fakeDeleteObject;
+		m_gl.deleteProgram		= fakeDeleteObject;
+		m_gl.attachShader		= fakeAttachDetach;
+		m_gl.detachShader		= fakeAttachDetach;
+		m_gl.shaderSource		= fakeShaderSource;
+		m_gl.compileShader		= fakeCompileShader;
+		m_gl.getShaderiv		= fakeGetShaderiv;
+		m_gl.linkProgram		= fakeLinkProgram;
+		m_gl.getProgramiv		= fakeGetProgramiv;
+		m_gl.getProgramBinary	= fakeGetProgramBinary;
+		m_gl.programBinary		= fakeProgramBinary;
+		m_gl.getError			= fakeGetError;
+		m_gl.getIntegerv		= fakeGetIntegerv;
+		m_gl.getString			= fakeGetString;
+	}
+
+	glu::ContextType			getType				(void) const	{ return glu::ContextType(glu::ApiType::es(3, 0));	}
+	const glw::Functions&		getFunctions		(void) const	{ return m_gl;										}
+	const tcu::RenderTarget&	getRenderTarget		(void) const	{ return m_renderTarget;								}
+	void						postIterate			(void)			{}
+
+private:
+	glw::Functions				m_gl;
+	tcu::RenderTarget			m_renderTarget;
+};
+
+class FakeProgramBinaryContextInfo : public glu::ContextInfo
+{
+public:
+	FakeProgramBinaryContextInfo (const glu::RenderContext& renderCtx)
+		: glu::ContextInfo(renderCtx)
+	{
+	}
+};
+
+class ProgramBinaryCacheCase : public tcu::TestCase
+{
+public:
+	ProgramBinaryCacheCase (tcu::TestContext& testCtx)
+		: tcu::TestCase(testCtx, "program_binary_cache", "glu::ProgramBinaryCache store, reload and fallback")
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		const char* const	filename	= "dit-program-binary-cache.bin";
+
+		deDeleteFile(filename);
+
+		try
+		{
+			run(filename);
+		}
+		catch (...)
+		{
+			glu::setCurrentThreadProgramBinaryCache(DE_NULL);
+			deDeleteFile(filename);
+			throw;
+		}
+
+		deDeleteFile(filename);
+
+		m_testCtx.setTestResult(QP_TEST_RESULT_PASS, "Pass");
+		return STOP;
+	}
+
+private:
+	static glu::ProgramSources getSources (int variant)
+	{
+		const std::string fragment = "void main (void) { gl_FragColor = vec4(" + de::toString(variant) + ".0); }\n";
+
+		return glu::makeVtxFragSources("void main (void) { gl_Position = vec4(0.0); }\n", fragment);
+	}
+
+	static void checkStatistics (const glu::ProgramBinaryCache& cache, int numHits, int numMisses, int numRejected, int numStored)
+	{
+		const glu::ProgramBinaryCache::Statistics stats = cache.getStatistics();
+
+		TCU_CHECK_MSG(stats.numHits		== numHits,		"Unexpected number of cache hits");
+		TCU_CHECK_MSG(stats.numMisses	== numMisses,	"Unexpected number of cache misses");
+		TCU_CHECK_MSG(stats.numRejected	== numRejected,	"Unexpected number of rejected binaries");
+		TCU_CHECK_MSG(stats.numStored	== numStored,	"Unexpected number of stored binaries");
+	}
+
+	//! Build program with the cache installed for the current thread.
+	static void buildProgram (const glu::RenderContext& renderCtx, glu::ProgramBinaryCache& cache, const glu::ProgramSources& sources)
+	{
+		glu::setCurrentThreadProgramBinaryCache(&cache);
+
+		{
+			const glu::ShaderProgram program (renderCtx.getFunctions(), sources);
+
+			glu::setCurrentThreadProgramBinaryCache(DE_NULL);
+			TCU_CHECK_MSG(program.isOk(), "Program build failed");
+		}
+	}
+
+	void run (const char* filename)
+	{
+		const FakeProgramBinaryContext		renderCtx;
+		const FakeProgramBinaryContextInfo	contextInfo	(renderCtx);
+		const glu::ProgramSources			sources		= getSources(0);
+
+		s_fakeGL = FakeProgramBinaryGL();
+
+		// First build compiles from sources and stores the binary.
+		{
+			glu::ProgramBinaryCache cache (renderCtx, contextInfo, filename);
+
+			TCU_CHECK_MSG(cache.isSupported(), "Cache is not active");
+
+			buildProgram(renderCtx, cache, sources);
+			checkStatistics(cache, 0, 1, 0, 1);
+			TCU_CHECK(s_fakeGL.numCompiles == 2 && s_fakeGL.numLinks == 1 && s_fakeGL.numBinaryLoads == 0);
+		}
+
+		// Cache reloaded from file restores the program without compiling or linking.
+		{
+			glu::ProgramBinaryCache cache (renderCtx, contextInfo, filename);
+
+			buildProgram(renderCtx, cache, sources);
+			checkStatistics(cache, 1, 0, 0, 0);
+			TCU_CHECK(s_fakeGL.numCompiles == 2 && s_fakeGL.numLinks == 1 && s_fakeGL.numBinaryLoads == 1);
+		}
+
+		// Rejected binary falls back to building from sources and replaces the entry.
+		{
+			glu::ProgramBinaryCache cache (renderCtx, contextInfo, filename);
+
+			s_fakeGL.rejectBinaries = true;
+			buildProgram(renderCtx, cache, sources);
+			s_fakeGL.rejectBinaries = false;
+
+			checkStatistics(cache, 0, 1, 1, 1);
+			TCU_CHECK(s_fakeGL.numCompiles == 4 && s_fakeGL.numLinks == 2 && s_fakeGL.numBinaryLoads == 2);
+		}
+
+		// Caches sharing a file, as parallel processes do, keep valid offsets for their own chunks.
+		{
+			glu::ProgramBinaryCache		first		(renderCtx, contextInfo, filename);
+			glu::ProgramBinaryCache		second		(renderCtx, contextInfo, filename);
+			const std::string			keys[]		= { first.computeKey(getSources(1)), first.computeKey(getSources(2)), first.computeKey(getSources(3)) };
+			const std::vector<deUint8>	binary		(s_fakeBinary, s_fakeBinary + sizeof(s_fakeBinary));
+			deUint32					format		= 0;
+			std::vector<deUint8>		loaded;
+
+			first.store(keys[0], FAKE_BINARY_FORMAT, binary);
+			second.store(keys[1], FAKE_BINARY_FORMAT, binary);
+			first.store(keys[2], FAKE_BINARY_FORMAT, binary);
+
+			TCU_CHECK_MSG(first.load(keys[2], &format, &loaded) && loaded == binary, "Chunk stored after another writer was not found");
+			TCU_CHECK_MSG(second.load(keys[1], &format, &loaded) && loaded == binary, "Chunk stored between other writes was not found");
+
+			{
+				glu::ProgramBinaryCache reloaded (renderCtx, contextInfo, filename);
+
+				for (int keyNdx = 0; keyNdx < DE_LENGTH_OF_ARRAY(keys); keyNdx++)
+				{
+					TCU_CHECK_MSG(reloaded.load(keys[keyNdx], &format, &loaded) && loaded == binary, "Chunk missing after reload");
+					TCU_CHECK(format == FAKE_BINARY_FORMAT);
+				}
+
+				buildProgram(renderCtx, reloaded, sources);
+				checkStatistics(reloaded, 4, 0, 0, 0);
+			}
+		}
+	}
+};
+
+class OpenGLFrameworkTests : public tcu::TestCaseGroup
+{
+public:
+	OpenGLFrameworkTests (tcu::TestContext& testCtx)
+		: tcu::TestCaseGroup(testCtx, "opengl", "Tests for the OpenGL utility framework")
+	{
+	}
+
+	void init (void)
+	{
+		addChild(new ProgramBinaryCacheCase(m_testCtx));
+	}
+};
+
 class CommonFrameworkTests : public tcu::TestCaseGroup
 {
 public:
@@ -894,6 +2667,18 @@ public:
 								   tcu::FloatFormat_selfTest));
 		addChild(new SelfCheckCase(m_testCtx, "either","tcu::Either_selfTest()",
 								   tcu::Either_selfTest));
+		addChild(new SelfCheckCase(m_testCtx, "string_template","tcu::StringTemplate_selfTest()",
+								   tcu::StringTemplate_selfTest));
+		addChild(new TexLookupMinMaxCase(m_testCtx, "tex_lookup_min_max_1d",		TexLookupMinMaxCase::TEXTURETYPE_1D));
+		addChild(new TexLookupMinMaxCase(m_testCtx, "tex_lookup_min_max_2d",		TexLookupMinMaxCase::TEXTURETYPE_2D));
+		addChild(new TexLookupMinMaxCase(m_testCtx, "tex_lookup_min_max_cube",		TexLookupMinMaxCase::TEXTURETYPE_CUBE));
+		addChild(new TexLookupMinMaxCase(m_testCtx, "tex_lookup_min_max_2d_array",	TexLookupMinMaxCase::TEXTURETYPE_2D_ARRAY));
+		addChild(new TexLookupMinMaxCase(m_testCtx, "tex_lookup_min_max_3d",		TexLookupMinMaxCase::TEXTURETYPE_3D));
+		addChild(new TexPacketSampleCase(m_testCtx, "tex_packet_sample_2d"));
+		addChild(new TexLookupDiffParallelCase(m_testCtx, "tex_lookup_diff_parallel_2d",	glu::TextureTestUtil::TEXTURETYPE_2D));
+		addChild(new TexLookupDiffParallelCase(m_testCtx, "tex_lookup_diff_parallel_cube",	glu::TextureTestUtil::TEXTURETYPE_CUBE));
+		addChild(new BatchExceptionCase(m_testCtx, "batch_exception_type"));
+		addChild(new TextureCopyConversionCase(m_testCtx, "texture_copy_conversion"));
 	}
 };
 
@@ -908,6 +2693,8 @@ public:
 	void init (void)
 	{
 		addChild(new ConstantInterpolationTest(m_testCtx));
+		addChild(new DrawBatchingCase(m_testCtx));
+		addChild(new ThreadContextRenderCase(m_testCtx));
 	}
 };
 
@@ -926,7 +2713,10 @@ void FrameworkTests::init (void)
 {
 	addChild(new CommonFrameworkTests	(m_testCtx));
 	addChild(new CaseListParserTests	(m_testCtx));
+	addChild(new LazyChildTests			(m_testCtx));
+	addChild(new CaseIndexTests			(m_testCtx));
 	addChild(new ReferenceRendererTests	(m_testCtx));
+	addChild(new OpenGLFrameworkTests	(m_testCtx));
 	addChild(createTextureFormatTests	(m_testCtx));
 	addChild(createAstcTests			(m_testCtx));
 	addChild(createVulkanTests			(m_testCtx));
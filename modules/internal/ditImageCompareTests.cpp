@@ -154,6 +154,65 @@ private:
 	const bool				m_expectedResult;
 };
 
+class ThresholdCompareCase : public tcu::TestCase
+{
+public:
+	enum CompareFunc
+	{
+		COMPAREFUNC_INT = 0,
+		COMPAREFUNC_FLOAT,
+		COMPAREFUNC_FLOAT_ULP,
+		COMPAREFUNC_FLOAT_COLOR,
+
+		COMPAREFUNC_LAST
+	};
+
+	ThresholdCompareCase (tcu::TestContext& testCtx, const char* name, CompareFunc compareFunc, int numFailingPixels)
+		: tcu::TestCase			(testCtx, name, "")
+		, m_compareFunc			(compareFunc)
+		, m_numFailingPixels	(numFailingPixels)
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		const tcu::TextureFormat	format		(tcu::TextureFormat::RGBA, tcu::TextureFormat::UNORM_INT8);
+		const tcu::Vec4				color		(0.25f, 0.5f, 0.75f, 1.0f);
+		tcu::TextureLevel			refImg		(format, 128, 128);
+		tcu::TextureLevel			cmpImg		(format, 128, 128);
+		bool						result		= false;
+
+		tcu::clear(refImg.getAccess(), color);
+		tcu::clear(cmpImg.getAccess(), color);
+
+		// Failing pixels are clustered so that only a small region of the images is logged.
+		for (int ndx = 0; ndx < m_numFailingPixels; ndx++)
+			cmpImg.getAccess().setPixel(tcu::Vec4(1.0f, 0.0f, 0.0f, 1.0f), 80 + ndx % 4, 20 + ndx / 4);
+
+		switch (m_compareFunc)
+		{
+			case COMPAREFUNC_INT:			result = tcu::intThresholdCompare(m_testCtx.getLog(), "CompareResult", "Image comparison result", refImg, cmpImg, tcu::UVec4(1), tcu::COMPARE_LOG_RESULT);				break;
+			case COMPAREFUNC_FLOAT:			result = tcu::floatThresholdCompare(m_testCtx.getLog(), "CompareResult", "Image comparison result", refImg, cmpImg, tcu::Vec4(0.01f), tcu::COMPARE_LOG_RESULT);			break;
+			case COMPAREFUNC_FLOAT_ULP:		result = tcu::floatUlpThresholdCompare(m_testCtx.getLog(), "CompareResult", "Image comparison result", refImg, cmpImg, tcu::UVec4(1024), tcu::COMPARE_LOG_RESULT);		break;
+			case COMPAREFUNC_FLOAT_COLOR:	result = tcu::floatThresholdCompare(m_testCtx.getLog(), "CompareResult", "Image comparison result", color, cmpImg, tcu::Vec4(0.01f), tcu::COMPARE_LOG_RESULT);			break;
+			default:
+				DE_ASSERT(false);
+		}
+
+		{
+			const bool isOk = result == (m_numFailingPixels == 0);
+			m_testCtx.setTestResult(isOk ? QP_TEST_RESULT_PASS	: QP_TEST_RESULT_FAIL,
+									isOk ? "Pass"				: "Wrong comparison result");
+		}
+
+		return STOP;
+	}
+
+private:
+	const CompareFunc	m_compareFunc;
+	const int			m_numFailingPixels;
+};
+
 class FuzzyComparisonMetricTests : public tcu::TestCaseGroup
 {
 public:
@@ -217,6 +276,27 @@ public:
 	}
 };
 
+class ThresholdCompareTests : public tcu::TestCaseGroup
+{
+public:
+	ThresholdCompareTests (tcu::TestContext& testCtx)
+		: tcu::TestCaseGroup(testCtx, "threshold_compare", "Threshold Image Comparison Tests")
+	{
+	}
+
+	void init (void)
+	{
+		addChild(new ThresholdCompareCase(m_testCtx, "int_identical",			ThresholdCompareCase::COMPAREFUNC_INT,			0));
+		addChild(new ThresholdCompareCase(m_testCtx, "int_failing",				ThresholdCompareCase::COMPAREFUNC_INT,			10));
+		addChild(new ThresholdCompareCase(m_testCtx, "float_identical",			ThresholdCompareCase::COMPAREFUNC_FLOAT,		0));
+		addChild(new ThresholdCompareCase(m_testCtx, "float_failing",			ThresholdCompareCase::COMPAREFUNC_FLOAT,		10));
+		addChild(new ThresholdCompareCase(m_testCtx, "float_ulp_identical",		ThresholdCompareCase::COMPAREFUNC_FLOAT_ULP,	0));
+		addChild(new ThresholdCompareCase(m_testCtx, "float_ulp_failing",		ThresholdCompareCase::COMPAREFUNC_FLOAT_ULP,	10));
+		addChild(new ThresholdCompareCase(m_testCtx, "float_color_identical",	ThresholdCompareCase::COMPAREFUNC_FLOAT_COLOR,	0));
+		addChild(new ThresholdCompareCase(m_testCtx, "float_color_failing",		ThresholdCompareCase::COMPAREFUNC_FLOAT_COLOR,	10));
+	}
+};
+
 ImageCompareTests::ImageCompareTests (tcu::TestContext& testCtx)
 	: tcu::TestCaseGroup(testCtx, "image_compare", "Image comparison tests")
 {
@@ -230,6 +310,7 @@ void ImageCompareTests::init (void)
 {
 	addChild(new FuzzyComparisonMetricTests	(m_testCtx));
 	addChild(new BilinearCompareTests		(m_testCtx));
+	addChild(new ThresholdCompareTests		(m_testCtx));
 }
 
 } // dit
@@ -23,8 +23,20 @@
 
 #include "ditTestLogTests.hpp"
 #include "tcuTestLog.hpp"
+#include "tcuMemPoolUtil.hpp"
+#include "xeXMLParser.hpp"
+#include "xeTestLogParser.hpp"
+#include "xeTestResultParser.hpp"
+#include "xeTestLogWriter.hpp"
+#include "deStringUtil.hpp"
+#include "deString.h"
+#include "deFile.h"
 
 #include <limits>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
 
 namespace dit
 {
@@ -69,6 +81,209 @@ public:
 	}
 };
 
+class XmlAttributePoolCase : public tcu::TestCase
+{
+public:
+	XmlAttributePoolCase (tcu::TestContext& testCtx)
+		: TestCase(testCtx, "xml_attribute_pool", "Executor XML parser reuses attribute pool pages between elements and test cases")
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		const int			numCases		= 8;
+		const int			numValues		= 500;
+		TestLog&			log				= m_testCtx.getLog();
+		xe::xml::Parser		parser;
+		int					pagesAfterFirst	= 0;
+
+		for (int caseNdx = 0; caseNdx < numCases; caseNdx++)
+		{
+			const std::string	caseLog			= generateCaseLog(caseNdx, numValues);
+			int					numValuesFound	= 0;
+			bool				resultFound		= false;
+
+			// Same parser is reused for every case, as xe::TestResultParser does.
+			parser.clear();
+			parser.feed((const deUint8*)caseLog.c_str(), (int)caseLog.size()+1);
+
+			for (;;)
+			{
+				const xe::xml::Element element = parser.getElement();
+
+				if (element == xe::xml::ELEMENT_INCOMPLETE || element == xe::xml::ELEMENT_END_OF_STRING)
+					break;
+
+				if (element == xe::xml::ELEMENT_START && deStringEqual(parser.getElementName(), "Number"))
+				{
+					const std::string expectedName = "Value" + de::toString(numValuesFound);
+
+					TCU_CHECK_MSG(parser.hasAttribute("Name") && expectedName == parser.getAttribute("Name"), "Wrong Name attribute");
+					TCU_CHECK_MSG(parser.hasAttribute("Unit") && deStringEqual(parser.getAttribute("Unit"), "us"), "Wrong Unit attribute");
+					TCU_CHECK_MSG(!parser.hasAttribute("CasePath"), "Attribute of previous element still visible");
+
+					numValuesFound += 1;
+				}
+				else if (element == xe::xml::ELEMENT_START && deStringEqual(parser.getElementName(), "TestCaseResult"))
+					TCU_CHECK_MSG(parser.getAttribute("CasePath") == "dit.case" + de::toString(caseNdx), "Wrong CasePath attribute");
+				else if (element == xe::xml::ELEMENT_START && deStringEqual(parser.getElementName(), "Result"))
+					resultFound = deStringEqual(parser.getAttribute("StatusCode"), "Pass") == DE_TRUE;
+
+				parser.advance();
+			}
+
+			TCU_CHECK_MSG(numValuesFound == numValues && resultFound, "Test case log was not fully parsed");
+
+			if (caseNdx == 0)
+				pagesAfterFirst = parser.getAttributeStats().numPagesCreated;
+		}
+
+		{
+			const deMemPoolStats stats = parser.getAttributeStats();
+
+			tcu::logMemPoolStats(log, "AttributePool", "Attribute pool of xe::xml::Parser", stats);
+
+			if (stats.numPagesCreated != pagesAfterFirst)
+				m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Attribute pool allocated new pages after first test case");
+			else if (stats.numPagesReused == 0)
+				m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Attribute pool pages were not reused");
+			else
+				m_testCtx.setTestResult(QP_TEST_RESULT_PASS, "Pass");
+		}
+
+		return STOP;
+	}
+
+private:
+	static std::string generateCaseLog (int caseNdx, int numValues)
+	{
+		std::string str = "<?xml version=\"1.0\"?>\n<TestCaseResult Version=\"0.3.4\" CasePath=\"dit.case" + de::toString(caseNdx) + "\" CaseType=\"SelfValidate\">\n";
+
+		for (int valueNdx = 0; valueNdx < numValues; valueNdx++)
+			str += "<Number Name=\"Value" + de::toString(valueNdx) + "\" Description=\"Generated value\" Tag=\"Time\" Unit=\"us\">" + de::toString(valueNdx) + "</Number>\n";
+
+		str += "<Result StatusCode=\"Pass\">Pass</Result>\n</TestCaseResult>\n";
+
+		return str;
+	}
+};
+
+class TimingRoundTripCase : public tcu::TestCase
+{
+public:
+	TimingRoundTripCase (tcu::TestContext& testCtx)
+		: TestCase(testCtx, "timing_round_trip", "<Timing> elements survive qpTestLog write, xe parse, xe write and parse again")
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		const char* const			filename	= "dit-timing.qpa";
+		TestLog&					log			= m_testCtx.getLog();
+		xe::TestResultParser		parser;
+		xe::TestCaseResult			parsed;
+		xe::TestCaseResult			reparsed;
+
+		deDeleteFile(filename);
+
+		{
+			TestLog caseLog (filename);
+
+			caseLog.startCase("dit.timing", QP_TEST_CASE_TYPE_SELF_VALIDATE);
+			caseLog.writeTiming("dit::timingA", 3, 1500);
+			caseLog.writeTiming("dit::timingB", 1, 0);
+			caseLog.endCase(QP_TEST_RESULT_PASS, "Pass");
+		}
+
+		{
+			const std::vector<deUint8>	fileData	= readFile(filename);
+			CaseCollector				collector;
+			xe::TestLogParser			logParser	(&collector);
+
+			deDeleteFile(filename);
+
+			logParser.parse(fileData.empty() ? DE_NULL : &fileData[0], fileData.size());
+
+			TCU_CHECK_MSG(collector.cases.size() == 1, "Expected exactly one test case in log");
+			xe::parseTestCaseResultFromData(&parser, &parsed, *collector.cases[0]);
+		}
+
+		{
+			std::ostringstream str;
+
+			xe::writeTestResult(parsed, str);
+
+			log << TestLog::Message << "Written by xe::writeTestResult():\n" << str.str() << TestLog::EndMessage;
+
+			parser.init(&reparsed);
+			// Terminating null marks end of data.
+			TCU_CHECK_MSG(parser.parse((const deUint8*)str.str().c_str(), (int)str.str().size()+1) == xe::TestResultParser::PARSERESULT_COMPLETE, "Failed to parse written test case result");
+		}
+
+		if (checkTimings(log, "parsed", parsed) && checkTimings(log, "reparsed", reparsed))
+			m_testCtx.setTestResult(QP_TEST_RESULT_PASS, "Pass");
+		else
+			m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Timing items changed in round trip");
+
+		return STOP;
+	}
+
+private:
+	struct CaseCollector : public xe::TestLogHandler
+	{
+		std::vector<xe::TestCaseResultPtr>	cases;
+
+		void					setSessionInfo			(const xe::SessionInfo&)					{}
+		xe::TestCaseResultPtr	startTestCaseResult		(const char* casePath)						{ return xe::TestCaseResultPtr(new xe::TestCaseResultData(casePath));	}
+		void					testCaseResultUpdated	(const xe::TestCaseResultPtr&)				{}
+		void					testCaseResultComplete	(const xe::TestCaseResultPtr& resultData)	{ cases.push_back(resultData);											}
+	};
+
+	static std::vector<deUint8> readFile (const char* filename)
+	{
+		std::ifstream			in		(filename, std::ifstream::binary|std::ifstream::in);
+		std::vector<deUint8>	data;
+		char					buf		[1024];
+
+		TCU_CHECK_MSG(in.good(), "Failed to open test log file");
+
+		while (in.read(buf, DE_LENGTH_OF_ARRAY(buf)) || in.gcount() > 0)
+			data.insert(data.end(), (const deUint8*)&buf[0], (const deUint8*)&buf[0] + in.gcount());
+
+		return data;
+	}
+
+	static bool checkTimings (TestLog& log, const char* stage, const xe::TestCaseResult& result)
+	{
+		std::vector<const xe::ri::Timing*> timings;
+
+		for (int itemNdx = 0; itemNdx < result.resultItems.getNumItems(); itemNdx++)
+		{
+			if (result.resultItems.getItem(itemNdx).getType() == xe::ri::TYPE_TIMING)
+				timings.push_back(static_cast<const xe::ri::Timing*>(&result.resultItems.getItem(itemNdx)));
+		}
+
+		if (timings.size() != 2 ||
+			!isTiming(*timings[0], "dit::timingA", 3, 1500) ||
+			!isTiming(*timings[1], "dit::timingB", 1, 0))
+		{
+			log << TestLog::Message << "ERROR: Unexpected timing items in " << stage << " result, got " << timings.size() << " items" << TestLog::EndMessage;
+			return false;
+		}
+
+		return true;
+	}
+
+	static bool isTiming (const xe::ri::Timing& timing, const char* name, int count, deInt64 durationUs)
+	{
+		return timing.name == name &&
+			   timing.count == count &&
+			   timing.unit == "us" &&
+			   timing.value.getType() == xe::ri::NumericValue::TYPE_INT64 &&
+			   timing.value.getInt64() == durationUs;
+	}
+};
+
 TestLogTests::TestLogTests (tcu::TestContext& testCtx)
 	: TestCaseGroup(testCtx, "testlog", "Test Log Tests")
 {
@@ -81,6 +296,8 @@ TestLogTests::~TestLogTests (void)
 void TestLogTests::init (void)
 {
 	addChild(new BasicSampleListCase(m_testCtx));
+	addChild(new XmlAttributePoolCase(m_testCtx));
+	addChild(new TimingRoundTripCase(m_testCtx));
 }
 
 } // dit
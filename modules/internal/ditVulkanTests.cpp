@@ -25,17 +25,523 @@
 #include "ditTestCase.hpp"
 
 #include "vkImageUtil.hpp"
+#include "vkCompileServer.hpp"
+#include "vkCmdUtil.hpp"
+#include "vkDeviceUtil.hpp"
+#include "vkQueryUtil.hpp"
+#include "vkRefUtil.hpp"
+#include "vkMemUtil.hpp"
+#include "vkBufferWithMemory.hpp"
+#include "vkImageWithMemory.hpp"
+#include "vkReadbackQueue.hpp"
+#include "vkTypeUtil.hpp"
+#include "vkPlatform.hpp"
+
+#include "tcuPlatform.hpp"
+#include "tcuCommandLine.hpp"
+#include "tcuTestLog.hpp"
+#include "tcuTextureUtil.hpp"
+#include "tcuImageCompare.hpp"
 
 #include "deUniquePtr.hpp"
+#include "deSharedPtr.hpp"
+#include "deThread.hpp"
 
 namespace dit
 {
 
+namespace
+{
+
+using namespace vk;
+
+//! Minimal device with one universal queue, created from the Vulkan platform of the test context.
+class DeviceEnvironment
+{
+public:
+	DeviceEnvironment (tcu::TestContext& testCtx)
+		: m_library			(testCtx.getPlatform().getVulkanPlatform().createLibrary())
+		, m_instance		(createDefaultInstance(m_library->getPlatformInterface(), VK_API_VERSION_1_0))
+		, m_vki				(m_library->getPlatformInterface(), *m_instance)
+		, m_physicalDevice	(chooseDevice(m_vki, *m_instance, testCtx.getCommandLine()))
+		, m_queueFamilyIndex(findUniversalQueueFamily(m_vki, m_physicalDevice))
+		, m_device			(createUniversalDevice(m_library->getPlatformInterface(), *m_instance, m_vki, m_physicalDevice, m_queueFamilyIndex))
+		, m_vkd				(m_library->getPlatformInterface(), *m_instance, *m_device)
+		, m_queue			(getDeviceQueue(m_vkd, *m_device, m_queueFamilyIndex, 0u))
+		, m_allocator		(m_vkd, *m_device, getPhysicalDeviceMemoryProperties(m_vki, m_physicalDevice))
+	{
+	}
+
+	const DeviceInterface&		getDeviceInterface		(void) const	{ return m_vkd;					}
+	VkDevice					getDevice				(void) const	{ return *m_device;				}
+	VkQueue						getQueue				(void) const	{ return m_queue;				}
+	deUint32					getQueueFamilyIndex		(void) const	{ return m_queueFamilyIndex;	}
+	Allocator&					getAllocator			(void)			{ return m_allocator;			}
+
+private:
+	static deUint32 findUniversalQueueFamily (const InstanceInterface& vki, VkPhysicalDevice physicalDevice)
+	{
+		const std::vector<VkQueueFamilyProperties>	queueProps	= getPhysicalDeviceQueueFamilyProperties(vki, physicalDevice);
+		const VkQueueFlags							requiredCaps	= VK_QUEUE_GRAPHICS_BIT|VK_QUEUE_COMPUTE_BIT;
+
+		for (size_t queueNdx = 0; queueNdx < queueProps.size(); queueNdx++)
+		{
+			if ((queueProps[queueNdx].queueFlags & requiredCaps) == requiredCaps)
+				return (deUint32)queueNdx;
+		}
+
+		TCU_THROW(NotSupportedError, "No matching queue found");
+	}
+
+	static Move<VkDevice> createUniversalDevice (const PlatformInterface& vkp, VkInstance instance, const InstanceInterface& vki, VkPhysicalDevice physicalDevice, deUint32 queueFamilyIndex)
+	{
+		const float						queuePriority	= 1.0f;
+		const VkDeviceQueueCreateInfo	queueInfo		=
+		{
+			VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
+			DE_NULL,
+			(VkDeviceQueueCreateFlags)0,
+			queueFamilyIndex,
+			1u,
+			&queuePriority,
+		};
+		const VkDeviceCreateInfo		deviceInfo		=
+		{
+			VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
+			DE_NULL,
+			(VkDeviceCreateFlags)0,
+			1u,
+			&queueInfo,
+			0u,
+			DE_NULL,
+			0u,
+			DE_NULL,
+			DE_NULL,
+		};
+
+		return createDevice(vkp, instance, vki, physicalDevice, &deviceInfo);
+	}
+
+	const de::UniquePtr<Library>	m_library;
+	const Unique<VkInstance>		m_instance;
+	const InstanceDriver			m_vki;
+	const VkPhysicalDevice			m_physicalDevice;
+	const deUint32					m_queueFamilyIndex;
+	const Unique<VkDevice>			m_device;
+	const DeviceDriver				m_vkd;
+	const VkQueue					m_queue;
+	SimpleAllocator					m_allocator;
+};
+
+//! Host-visible buffer of numRegions regions of REGION_SIZE words each, filled by transfer commands.
+class FillBuffer
+{
+public:
+	enum { REGION_SIZE = 64 };
+
+	FillBuffer (DeviceEnvironment& env, deUint32 numRegions)
+		: m_env		(env)
+		, m_buffer	(env.getDeviceInterface(), env.getDevice(), env.getAllocator(), makeCreateInfo(numRegions), MemoryRequirement::HostVisible)
+	{
+	}
+
+	//! Fill region and make the write visible to host reads after the submission completes.
+	void recordFill (VkCommandBuffer cmdBuffer, deUint32 regionNdx, deUint32 value) const
+	{
+		const DeviceInterface&	vk			= m_env.getDeviceInterface();
+		const VkMemoryBarrier	barrier		=
+		{
+			VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+			DE_NULL,
+			VK_ACCESS_TRANSFER_WRITE_BIT,
+			VK_ACCESS_HOST_READ_BIT,
+		};
+
+		vk.cmdFillBuffer(cmdBuffer, *m_buffer, regionNdx * REGION_SIZE * sizeof(deUint32), REGION_SIZE * sizeof(deUint32), value);
+		vk.cmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, (VkDependencyFlags)0, 1u, &barrier, 0u, DE_NULL, 0u, DE_NULL);
+	}
+
+	void checkFill (deUint32 regionNdx, deUint32 value) const
+	{
+		const Allocation&	alloc	= m_buffer.getAllocation();
+		const deUint32*		words	= static_cast<const deUint32*>(alloc.getHostPtr()) + regionNdx * REGION_SIZE;
+
+		invalidateAlloc(m_env.getDeviceInterface(), m_env.getDevice(), alloc);
+
+		for (int wordNdx = 0; wordNdx < REGION_SIZE; wordNdx++)
+		{
+			if (words[wordNdx] != value)
+				TCU_FAIL(("Region " + de::toString(regionNdx) + " was not filled by its command buffer").c_str());
+		}
+	}
+
+private:
+	static VkBufferCreateInfo makeCreateInfo (deUint32 numRegions)
+	{
+		const VkBufferCreateInfo createInfo =
+		{
+			VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+			DE_NULL,
+			(VkBufferCreateFlags)0,
+			numRegions * REGION_SIZE * sizeof(deUint32),
+			VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+			VK_SHARING_MODE_EXCLUSIVE,
+			0u,
+			DE_NULL,
+		};
+		return createInfo;
+	}
+
+	DeviceEnvironment&		m_env;
+	const BufferWithMemory	m_buffer;
+};
+
+void checkStatistics (const SubmissionPool& pool, int numFences, int numCommandPools, int numCommandBuffers)
+{
+	const SubmissionPool::Statistics stats = pool.getStatistics();
+
+	if (stats.numFences != numFences)
+		TCU_FAIL(("Expected " + de::toString(numFences) + " fence(s) to be created, got " + de::toString(stats.numFences)).c_str());
+
+	if (stats.numCommandPools != numCommandPools)
+		TCU_FAIL(("Expected " + de::toString(numCommandPools) + " command pool(s) to be created, got " + de::toString(stats.numCommandPools)).c_str());
+
+	if (stats.numCommandBuffers != numCommandBuffers)
+		TCU_FAIL(("Expected " + de::toString(numCommandBuffers) + " command buffer(s) to be allocated, got " + de::toString(stats.numCommandBuffers)).c_str());
+}
+
+//! Records and submits batches on a separate thread, for checking that batches do not block each other.
+class BatchThread : public de::Thread
+{
+public:
+	enum { NUM_BATCHES = 16 };
+
+	BatchThread (DeviceEnvironment& env, const FillBuffer& buffer, deUint32 regionNdx)
+		: m_env			(env)
+		, m_buffer		(buffer)
+		, m_regionNdx	(regionNdx)
+	{
+	}
+
+	void run (void)
+	{
+		try
+		{
+			for (deUint32 batchNdx = 0; batchNdx < NUM_BATCHES; batchNdx++)
+			{
+				SubmissionBatch batch (m_env.getDeviceInterface(), m_env.getDevice(), m_env.getQueue(), m_env.getQueueFamilyIndex());
+
+				m_buffer.recordFill(batch.record(), m_regionNdx, batchNdx);
+				batch.submitAndWait();
+				m_buffer.checkFill(m_regionNdx, batchNdx);
+			}
+		}
+		catch (const std::exception& e)
+		{
+			m_error = e.what();
+		}
+	}
+
+	const std::string& getError (void) const { return m_error; }
+
+private:
+	DeviceEnvironment&	m_env;
+	const FillBuffer&	m_buffer;
+	const deUint32		m_regionNdx;
+	std::string			m_error;
+};
+
+class SubmissionPoolCase : public tcu::TestCase
+{
+public:
+	SubmissionPoolCase (tcu::TestContext& testCtx)
+		: tcu::TestCase(testCtx, "submission_pool", "SubmissionPool fence and command buffer recycling")
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		DeviceEnvironment		env			(m_testCtx);
+		const DeviceInterface&	vk			= env.getDeviceInterface();
+		const VkDevice			device		= env.getDevice();
+		const VkQueue			queue		= env.getQueue();
+		const deUint32			queueFamily	= env.getQueueFamilyIndex();
+		const deUint32			batchSize	= 3u;
+		FillBuffer				buffer		(env, batchSize);
+		SubmissionPool			pool		(vk, device, queue, queueFamily);
+
+		// Batches reuse the same fence, command pool and command buffers.
+		for (deUint32 iterNdx = 0; iterNdx < 4u; iterNdx++)
+		{
+			SubmissionBatch batch (vk, device, queue, queueFamily);
+
+			for (deUint32 regionNdx = 0; regionNdx < batchSize; regionNdx++)
+				buffer.recordFill(batch.record(), regionNdx, iterNdx * batchSize + regionNdx);
+
+			TCU_CHECK(batch.getNumCommandBuffers() == batchSize);
+			batch.submitAndWait();
+			TCU_CHECK(batch.getNumCommandBuffers() == 0u);
+
+			for (deUint32 regionNdx = 0; regionNdx < batchSize; regionNdx++)
+				buffer.checkFill(regionNdx, iterNdx * batchSize + regionNdx);
+
+			checkStatistics(pool, 1, 1, (int)batchSize);
+		}
+
+		// submitCommandsAndWait() takes its fence from the pool.
+		{
+			const Unique<VkCommandPool>		cmdPool		(createCommandPool(vk, device, (VkCommandPoolCreateFlags)0, queueFamily));
+			const Unique<VkCommandBuffer>	cmdBuffer	(allocateCommandBuffer(vk, device, *cmdPool, VK_COMMAND_BUFFER_LEVEL_PRIMARY));
+
+			beginCommandBuffer(vk, *cmdBuffer, 0u);
+			buffer.recordFill(*cmdBuffer, 0u, 0xabcdu);
+			endCommandBuffer(vk, *cmdBuffer);
+
+			submitCommandsAndWait(vk, device, queue, *cmdBuffer);
+			submitCommandsAndWait(vk, device, queue, *cmdBuffer);
+			buffer.checkFill(0u, 0xabcdu);
+
+			checkStatistics(pool, 1, 1, (int)batchSize);
+		}
+
+		// Command buffer abandoned without submission is reset and reused.
+		{
+			{
+				PooledCommandBuffer abandoned (vk, device, queue, queueFamily);
+				buffer.recordFill(*abandoned, 1u, 0x1234u);
+			}
+
+			PooledCommandBuffer cmdBuffer (vk, device, queue, queueFamily);
+			buffer.recordFill(*cmdBuffer, 1u, 0x5678u);
+			cmdBuffer.submitAndWait();
+			buffer.checkFill(1u, 0x5678u);
+
+			checkStatistics(pool, 1, 1, (int)batchSize);
+		}
+
+		// Batches recording at the same time get command pools of their own.
+		{
+			SubmissionBatch first	(vk, device, queue, queueFamily);
+			SubmissionBatch second	(vk, device, queue, queueFamily);
+
+			buffer.recordFill(first.record(), 0u, 0x1111u);
+			buffer.recordFill(second.record(), 1u, 0x2222u);
+
+			second.submitAndWait();
+			first.submitAndWait();
+
+			buffer.checkFill(0u, 0x1111u);
+			buffer.checkFill(1u, 0x2222u);
+
+			checkStatistics(pool, 1, 2, (int)batchSize + 1);
+		}
+
+		// Threads record and submit concurrently.
+		{
+			BatchThread	thread0	(env, buffer, 0u);
+			BatchThread	thread1	(env, buffer, 1u);
+
+			thread0.start();
+			thread1.start();
+			thread0.join();
+			thread1.join();
+
+			if (!thread0.getError().empty())
+				TCU_FAIL(thread0.getError().c_str());
+			if (!thread1.getError().empty())
+				TCU_FAIL(thread1.getError().c_str());
+
+			const SubmissionPool::Statistics stats = pool.getStatistics();
+
+			if (stats.numCommandPools > 2 || stats.numFences > 2)
+				TCU_FAIL("Concurrent batches did not recycle command pools and fences");
+		}
+
+		m_testCtx.setTestResult(QP_TEST_RESULT_PASS, "Pass");
+		return STOP;
+	}
+};
+
+//! Clear color image, leaving it in VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL.
+void clearColorImage (DeviceEnvironment& env, VkImage image, const tcu::Vec4& color)
+{
+	const VkDevice					device			= env.getDevice();
+	const DeviceInterface&			vk				= env.getDeviceInterface();
+	const Unique<VkCommandPool>		cmdPool			(createCommandPool(vk, device, 0u, env.getQueueFamilyIndex()));
+	const Unique<VkCommandBuffer>	cmdBuf			(allocateCommandBuffer(vk, device, *cmdPool, VK_COMMAND_BUFFER_LEVEL_PRIMARY));
+	const VkClearColorValue			clearValue		= makeClearValueColor(color).color;
+	const VkImageSubresourceRange	range			= makeImageSubresourceRange(VK_IMAGE_ASPECT_COLOR_BIT, 0u, 1u, 0u, 1u);
+	const VkImageMemoryBarrier		imageBarrier	=
+	{
+		VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,		// sType
+		DE_NULL,									// pNext
+		0u,											// srcAccessMask
+		VK_ACCESS_TRANSFER_WRITE_BIT,				// dstAccessMask
+		VK_IMAGE_LAYOUT_UNDEFINED,					// oldLayout
+		VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,		// newLayout
+		VK_QUEUE_FAMILY_IGNORED,					// srcQueueFamilyIndex
+		VK_QUEUE_FAMILY_IGNORED,					// dstQueueFamilyIndex
+		image,										// image
+		range										// subresourceRange
+	};
+
+	beginCommandBuffer(vk, *cmdBuf);
+	vk.cmdPipelineBarrier(*cmdBuf, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0u, 0u, DE_NULL, 0u, DE_NULL, 1u, &imageBarrier);
+	vk.cmdClearColorImage(*cmdBuf, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &clearValue, 1u, &range);
+	endCommandBuffer(vk, *cmdBuf);
+
+	submitCommandsAndWait(vk, device, env.getQueue(), *cmdBuf);
+}
+
+//! Wait for readback. Returns false if the staging buffer of the request has already been reused or released.
+bool waitReadback (ReadbackQueue& readback, const ReadbackQueue::Request& request, tcu::ConstPixelBufferAccess* result)
+{
+	try
+	{
+		*result = readback.wait(request);
+		return true;
+	}
+	catch (const tcu::InternalError&)
+	{
+		return false;
+	}
+}
+
+bool verifyReadback (tcu::TestLog& log, ReadbackQueue& readback, const ReadbackQueue::Request& request, const tcu::Vec4& color)
+{
+	tcu::ConstPixelBufferAccess	result;
+
+	if (!waitReadback(readback, request, &result))
+	{
+		log << tcu::TestLog::Message << "Valid readback request was rejected" << tcu::TestLog::EndMessage;
+		return false;
+	}
+
+	{
+		tcu::TextureLevel	refImage	(result.getFormat(), result.getWidth(), result.getHeight());
+
+		tcu::clear(refImage.getAccess(), color);
+
+		return tcu::intThresholdCompare(log, "ComparisonResult", "Image comparison result", refImage.getAccess(), result, tcu::UVec4(1u), tcu::COMPARE_LOG_ON_ERROR);
+	}
+}
+
+bool isReadbackRejected (ReadbackQueue& readback, const ReadbackQueue::Request& request)
+{
+	tcu::ConstPixelBufferAccess	result;
+
+	return !waitReadback(readback, request, &result);
+}
+
+class ReadbackQueueCase : public tcu::TestCase
+{
+public:
+	ReadbackQueueCase (tcu::TestContext& testCtx)
+		: tcu::TestCase(testCtx, "readback_queue", "ReadbackQueue staging buffer reuse and release")
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		typedef de::SharedPtr<ImageWithMemory>	ImageSp;
+
+		DeviceEnvironment				env				(m_testCtx);
+		const VkDevice					device			= env.getDevice();
+		const DeviceInterface&			vk				= env.getDeviceInterface();
+		tcu::TestLog&					log				= m_testCtx.getLog();
+		const VkFormat					colorFormat		= VK_FORMAT_R8G8B8A8_UNORM;
+		const int						smallSize		= 16;
+		const int						largeSize		= 64;
+		const int						numImages		= 6;
+		const int						largeImageNdx	= 4;
+		const VkImageSubresourceLayers	subresource		= makeImageSubresourceLayers(VK_IMAGE_ASPECT_COLOR_BIT, 0u, 0u, 1u);
+		// Two small images fit in one staging buffer, large image requires growing it.
+		const VkDeviceSize				stagingSize		= (VkDeviceSize)(2 * smallSize * smallSize * mapVkFormat(colorFormat).getPixelSize());
+		ReadbackQueue					readback		(vk, device, env.getQueue(), env.getQueueFamilyIndex(), env.getAllocator(), stagingSize, 2u);
+		std::vector<ImageSp>			images;
+		std::vector<VkExtent3D>			extents;
+		std::vector<tcu::Vec4>			colors;
+		std::vector<ReadbackQueue::Request>	requests	(numImages);
+		bool							allOk			= true;
+
+		for (int imageNdx = 0; imageNdx < numImages; imageNdx++)
+		{
+			const int				size		= imageNdx == largeImageNdx ? largeSize : smallSize;
+			const VkImageCreateInfo	imageParams	=
+			{
+				VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,									// sType
+				DE_NULL,																// pNext
+				0u,																		// flags
+				VK_IMAGE_TYPE_2D,														// imageType
+				colorFormat,															// format
+				makeExtent3D((deUint32)size, (deUint32)size, 1u),						// extent
+				1u,																		// mipLevels
+				1u,																		// arraySize
+				VK_SAMPLE_COUNT_1_BIT,													// samples
+				VK_IMAGE_TILING_OPTIMAL,												// tiling
+				VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT,		// usage
+				VK_SHARING_MODE_EXCLUSIVE,												// sharingMode
+				0u,																		// queueFamilyIndexCount
+				DE_NULL,																// pQueueFamilyIndices
+				VK_IMAGE_LAYOUT_UNDEFINED,												// initialLayout
+			};
+
+			images.push_back(ImageSp(new ImageWithMemory(vk, device, env.getAllocator(), imageParams, MemoryRequirement::Any)));
+			extents.push_back(imageParams.extent);
+			colors.push_back(tcu::Vec4((float)imageNdx / 8.0f, 0.25f, 1.0f - (float)imageNdx / 8.0f, 1.0f));
+
+			clearColorImage(env, **images.back(), colors.back());
+		}
+
+		// Images 0 and 1 share the first staging buffer, 2 and 3 are in the second one.
+		for (int imageNdx = 0; imageNdx < 4; imageNdx++)
+			requests[imageNdx] = readback.enqueue(**images[imageNdx], colorFormat, extents[imageNdx], subresource, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_ACCESS_TRANSFER_WRITE_BIT);
+
+		if (readback.isReady(requests[3]))
+			TCU_FAIL("Copy was reported ready before it was submitted");
+
+		// Results are read out of order.
+		{
+			const int waitOrder[] = { 3, 0, 2, 1 };
+
+			for (int orderNdx = 0; orderNdx < DE_LENGTH_OF_ARRAY(waitOrder); orderNdx++)
+				allOk = verifyReadback(log, readback, requests[waitOrder[orderNdx]], colors[waitOrder[orderNdx]]) && allOk;
+		}
+
+		// Large image reuses and grows the first staging buffer.
+		requests[largeImageNdx] = readback.enqueue(**images[largeImageNdx], colorFormat, extents[largeImageNdx], subresource, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_ACCESS_TRANSFER_WRITE_BIT);
+
+		allOk = verifyReadback(log, readback, requests[largeImageNdx], colors[largeImageNdx]) && allOk;
+		allOk = verifyReadback(log, readback, requests[2], colors[2]) && allOk;
+
+		if (!isReadbackRejected(readback, requests[0]) || !isReadbackRejected(readback, requests[1]))
+			TCU_FAIL("Request to reused staging buffer was not rejected");
+
+		readback.release();
+
+		if (!isReadbackRejected(readback, requests[2]) || !isReadbackRejected(readback, requests[largeImageNdx]))
+			TCU_FAIL("Request to released staging buffer was not rejected");
+
+		// Queue can still be used after release().
+		requests[5] = readback.enqueue(**images[5], colorFormat, extents[5], subresource, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_ACCESS_TRANSFER_WRITE_BIT);
+
+		allOk = verifyReadback(log, readback, requests[5], colors[5]) && allOk;
+
+		m_testCtx.setTestResult(allOk ? QP_TEST_RESULT_PASS : QP_TEST_RESULT_FAIL, allOk ? "Pass" : "Image comparison failed");
+		return STOP;
+	}
+};
+
+} // anonymous
+
 tcu::TestCaseGroup* createVulkanTests (tcu::TestContext& testCtx)
 {
 	de::MovePtr<tcu::TestCaseGroup>	group	(new tcu::TestCaseGroup(testCtx, "vulkan", "Vulkan Framework Tests"));
 
 	group->addChild(new SelfCheckCase(testCtx, "image_util", "ImageUtil self-check tests", vk::imageUtilSelfTest));
+	group->addChild(new SelfCheckCase(testCtx, "compile_server", "Compile server protocol self-check tests", vk::compileServerSelfTest));
+	group->addChild(new SubmissionPoolCase(testCtx));
+	group->addChild(new ReadbackQueueCase(testCtx));
 
 	return group.release();
 }
@@ -0,0 +1,154 @@
+# -*- coding: utf-8 -*-
+
+#-------------------------------------------------------------------------
+# drawElements Quality Program utilities
+# --------------------------------------
+#
+# Copyright 2015 The Android Open Source Project
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+#-------------------------------------------------------------------------
+
+# Updates duration estimates and result tags of a test case index (written
+# with --deqp-runmode=case-index) from a qpa log. Each case that has a
+# result in the log gets TestDuration as duration estimate and a single
+# "last-<status code>" tag, e.g. last-NotSupported, which can be used with
+# --deqp-case-tags. Index layout is documented in
+# framework/common/tcuCaseIndex.hpp.
+
+import sys
+import struct
+import xml.sax
+import xml.sax.handler
+from log_parser import BatchResultParser
+
+INDEX_MAGIC		= b"dQCI"
+INDEX_VERSION	= 2
+HEADER_FORMAT	= "<4sIIII"
+NODE_FORMAT		= "<IIIB3xQII"
+TAG_REF_FORMAT	= "<I"
+RESULT_TAG_PREFIX	= "last-"
+
+class DurationHandler(xml.sax.handler.ContentHandler):
+	def __init__ (self):
+		self.casePath	= None
+		self.inDuration	= False
+		self.durations	= {}
+
+	def startElement (self, name, attrs):
+		if name == "TestCaseResult":
+			self.casePath = attrs.getValue("CasePath")
+		elif name == "Number" and attrs.getValue("Name") == "TestDuration":
+			self.inDuration = True
+
+	def characters (self, content):
+		if self.inDuration and self.casePath != None:
+			self.durations[self.casePath] = int(content)
+			self.inDuration = False
+
+class IgnoreErrorHandler(xml.sax.handler.ErrorHandler):
+	def error (self, err):
+		pass
+
+	def fatalError (self, err):
+		pass
+
+	def warning (self, warn):
+		pass
+
+def readResults (logFilename):
+	parser		= BatchResultParser()
+	handler		= DurationHandler()
+	statusCodes	= {}
+
+	for result in parser.parseFile(logFilename):
+		statusCodes[result.name] = result.statusCode
+
+		# Crashed and timed out cases have truncated logs and no duration.
+		handler.casePath = None
+		xml.sax.parseString(result.log, handler, IgnoreErrorHandler())
+
+	return handler.durations, statusCodes
+
+def updateIndex (indexFilename, durations, statusCodes):
+	data = bytes(open(indexFilename, "rb").read())
+
+	magic, version, numNodes, numTagRefs, stringTableSize = struct.unpack_from(HEADER_FORMAT, data, 0)
+	if magic != INDEX_MAGIC or version != INDEX_VERSION:
+		raise Exception("%s is not a supported test case index" % indexFilename)
+
+	headerSize		= struct.calcsize(HEADER_FORMAT)
+	nodeSize		= struct.calcsize(NODE_FORMAT)
+	tagRefSize		= struct.calcsize(TAG_REF_FORMAT)
+	tagRefsOffset	= headerSize + numNodes*nodeSize
+	stringTable		= bytearray(data[tagRefsOffset + numTagRefs*tagRefSize:])
+	nodes			= [list(struct.unpack_from(NODE_FORMAT, data, headerSize + ndx*nodeSize)) for ndx in range(numNodes)]
+	tagRefs			= [struct.unpack_from(TAG_REF_FORMAT, data, tagRefsOffset + ndx*tagRefSize)[0] for ndx in range(numTagRefs)]
+	stringOffsets	= {}
+	numUpdated		= 0
+
+	def getString (offset):
+		return bytes(stringTable[offset:stringTable.index(b"\0", offset)]).decode("utf-8")
+
+	def addString (string):
+		if not string in stringOffsets:
+			stringOffsets[string] = len(stringTable)
+			stringTable.extend(string.encode("utf-8") + b"\0")
+		return stringOffsets[string]
+
+	for offset in tagRefs:
+		stringOffsets[getString(offset)] = offset
+
+	# Nodes are in breadth-first order, so parent paths are always known before children.
+	paths	= [getString(nodes[0][0])] + [None] * (numNodes - 1)
+	newRefs	= []
+	for ndx, node in enumerate(nodes):
+		nameOffset, firstChild, numChildren, nodeType, durationUs, firstTag, numTags = node
+		tags = [getString(offset) for offset in tagRefs[firstTag:firstTag + numTags]]
+
+		for childNdx in range(firstChild, firstChild + numChildren):
+			paths[childNdx] = paths[ndx] + "." + getString(nodes[childNdx][0])
+
+		if numChildren == 0 and (paths[ndx] in durations or paths[ndx] in statusCodes):
+			if paths[ndx] in durations:
+				node[4] = durations[paths[ndx]]
+
+			if paths[ndx] in statusCodes:
+				tags = [tag for tag in tags if not tag.startswith(RESULT_TAG_PREFIX)] + [RESULT_TAG_PREFIX + statusCodes[paths[ndx]]]
+
+			numUpdated += 1
+
+		node[5]	= len(newRefs)
+		node[6]	= len(tags)
+		newRefs += [addString(tag) for tag in tags]
+
+	# Existing strings are kept in place, so node name offsets stay valid. Unused tag names are left in the table.
+	out = bytearray(struct.pack(HEADER_FORMAT, INDEX_MAGIC, INDEX_VERSION, numNodes, len(newRefs), len(stringTable)))
+	for node in nodes:
+		out += struct.pack(NODE_FORMAT, *node)
+	for ref in newRefs:
+		out += struct.pack(TAG_REF_FORMAT, ref)
+	out += stringTable
+
+	open(indexFilename, "wb").write(out)
+	return numUpdated
+
+if __name__ == "__main__":
+	if len(sys.argv) != 3:
+		print("%s: [case index] [qpa log]" % sys.argv[0])
+		sys.exit(-1)
+
+	durations, statusCodes	= readResults(sys.argv[2])
+	numUpdated				= updateIndex(sys.argv[1], durations, statusCodes)
+	print("Updated durations and tags of %d test cases" % numUpdated)